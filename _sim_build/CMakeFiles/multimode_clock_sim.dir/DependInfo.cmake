@@ -0,0 +1,68 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/button_handler.c" "CMakeFiles/multimode_clock_sim.dir/button_handler.c.o" "gcc" "CMakeFiles/multimode_clock_sim.dir/button_handler.c.o.d"
+  "/root/repo/byte_ring.c" "CMakeFiles/multimode_clock_sim.dir/byte_ring.c.o" "gcc" "CMakeFiles/multimode_clock_sim.dir/byte_ring.c.o.d"
+  "/root/repo/clock_cache.c" "CMakeFiles/multimode_clock_sim.dir/clock_cache.c.o" "gcc" "CMakeFiles/multimode_clock_sim.dir/clock_cache.c.o.d"
+  "/root/repo/clock_core.c" "CMakeFiles/multimode_clock_sim.dir/clock_core.c.o" "gcc" "CMakeFiles/multimode_clock_sim.dir/clock_core.c.o.d"
+  "/root/repo/clock_generator.c" "CMakeFiles/multimode_clock_sim.dir/clock_generator.c.o" "gcc" "CMakeFiles/multimode_clock_sim.dir/clock_generator.c.o.d"
+  "/root/repo/_sim_build/clock_tables.c" "CMakeFiles/multimode_clock_sim.dir/clock_tables.c.o" "gcc" "CMakeFiles/multimode_clock_sim.dir/clock_tables.c.o.d"
+  "/root/repo/command_table.c" "CMakeFiles/multimode_clock_sim.dir/command_table.c.o" "gcc" "CMakeFiles/multimode_clock_sim.dir/command_table.c.o.d"
+  "/root/repo/control_arbiter.c" "CMakeFiles/multimode_clock_sim.dir/control_arbiter.c.o" "gcc" "CMakeFiles/multimode_clock_sim.dir/control_arbiter.c.o.d"
+  "/root/repo/control_frame.c" "CMakeFiles/multimode_clock_sim.dir/control_frame.c.o" "gcc" "CMakeFiles/multimode_clock_sim.dir/control_frame.c.o.d"
+  "/root/repo/control_port.c" "CMakeFiles/multimode_clock_sim.dir/control_port.c.o" "gcc" "CMakeFiles/multimode_clock_sim.dir/control_port.c.o.d"
+  "/root/repo/control_protocol.c" "CMakeFiles/multimode_clock_sim.dir/control_protocol.c.o" "gcc" "CMakeFiles/multimode_clock_sim.dir/control_protocol.c.o.d"
+  "/root/repo/debounce.c" "CMakeFiles/multimode_clock_sim.dir/debounce.c.o" "gcc" "CMakeFiles/multimode_clock_sim.dir/debounce.c.o.d"
+  "/root/repo/discipline.c" "CMakeFiles/multimode_clock_sim.dir/discipline.c.o" "gcc" "CMakeFiles/multimode_clock_sim.dir/discipline.c.o.d"
+  "/root/repo/discipline_loop.c" "CMakeFiles/multimode_clock_sim.dir/discipline_loop.c.o" "gcc" "CMakeFiles/multimode_clock_sim.dir/discipline_loop.c.o.d"
+  "/root/repo/duty_cycle.c" "CMakeFiles/multimode_clock_sim.dir/duty_cycle.c.o" "gcc" "CMakeFiles/multimode_clock_sim.dir/duty_cycle.c.o.d"
+  "/root/repo/freq_counter.c" "CMakeFiles/multimode_clock_sim.dir/freq_counter.c.o" "gcc" "CMakeFiles/multimode_clock_sim.dir/freq_counter.c.o.d"
+  "/root/repo/freq_range.c" "CMakeFiles/multimode_clock_sim.dir/freq_range.c.o" "gcc" "CMakeFiles/multimode_clock_sim.dir/freq_range.c.o.d"
+  "/root/repo/hardware_init.c" "CMakeFiles/multimode_clock_sim.dir/hardware_init.c.o" "gcc" "CMakeFiles/multimode_clock_sim.dir/hardware_init.c.o.d"
+  "/root/repo/line_assembler.c" "CMakeFiles/multimode_clock_sim.dir/line_assembler.c.o" "gcc" "CMakeFiles/multimode_clock_sim.dir/line_assembler.c.o.d"
+  "/root/repo/main.c" "CMakeFiles/multimode_clock_sim.dir/main.c.o" "gcc" "CMakeFiles/multimode_clock_sim.dir/main.c.o.d"
+  "/root/repo/output_trace.c" "CMakeFiles/multimode_clock_sim.dir/output_trace.c.o" "gcc" "CMakeFiles/multimode_clock_sim.dir/output_trace.c.o.d"
+  "/root/repo/pio_clock.c" "CMakeFiles/multimode_clock_sim.dir/pio_clock.c.o" "gcc" "CMakeFiles/multimode_clock_sim.dir/pio_clock.c.o.d"
+  "/root/repo/pio_counter.c" "CMakeFiles/multimode_clock_sim.dir/pio_counter.c.o" "gcc" "CMakeFiles/multimode_clock_sim.dir/pio_counter.c.o.d"
+  "/root/repo/pio_phase.c" "CMakeFiles/multimode_clock_sim.dir/pio_phase.c.o" "gcc" "CMakeFiles/multimode_clock_sim.dir/pio_phase.c.o.d"
+  "/root/repo/pio_reset.c" "CMakeFiles/multimode_clock_sim.dir/pio_reset.c.o" "gcc" "CMakeFiles/multimode_clock_sim.dir/pio_reset.c.o.d"
+  "/root/repo/pot_filter.c" "CMakeFiles/multimode_clock_sim.dir/pot_filter.c.o" "gcc" "CMakeFiles/multimode_clock_sim.dir/pot_filter.c.o.d"
+  "/root/repo/pot_sampler.c" "CMakeFiles/multimode_clock_sim.dir/pot_sampler.c.o" "gcc" "CMakeFiles/multimode_clock_sim.dir/pot_sampler.c.o.d"
+  "/root/repo/power_control.c" "CMakeFiles/multimode_clock_sim.dir/power_control.c.o" "gcc" "CMakeFiles/multimode_clock_sim.dir/power_control.c.o.d"
+  "/root/repo/pwm_clock.c" "CMakeFiles/multimode_clock_sim.dir/pwm_clock.c.o" "gcc" "CMakeFiles/multimode_clock_sim.dir/pwm_clock.c.o.d"
+  "/root/repo/pwm_solver.c" "CMakeFiles/multimode_clock_sim.dir/pwm_solver.c.o" "gcc" "CMakeFiles/multimode_clock_sim.dir/pwm_solver.c.o.d"
+  "/root/repo/reset_control.c" "CMakeFiles/multimode_clock_sim.dir/reset_control.c.o" "gcc" "CMakeFiles/multimode_clock_sim.dir/reset_control.c.o.d"
+  "/root/repo/scheduler.c" "CMakeFiles/multimode_clock_sim.dir/scheduler.c.o" "gcc" "CMakeFiles/multimode_clock_sim.dir/scheduler.c.o.d"
+  "/root/repo/sim/sim_adc.c" "CMakeFiles/multimode_clock_sim.dir/sim/sim_adc.c.o" "gcc" "CMakeFiles/multimode_clock_sim.dir/sim/sim_adc.c.o.d"
+  "/root/repo/sim/sim_core.c" "CMakeFiles/multimode_clock_sim.dir/sim/sim_core.c.o" "gcc" "CMakeFiles/multimode_clock_sim.dir/sim/sim_core.c.o.d"
+  "/root/repo/sim/sim_dma.c" "CMakeFiles/multimode_clock_sim.dir/sim/sim_dma.c.o" "gcc" "CMakeFiles/multimode_clock_sim.dir/sim/sim_dma.c.o.d"
+  "/root/repo/sim/sim_gpio.c" "CMakeFiles/multimode_clock_sim.dir/sim/sim_gpio.c.o" "gcc" "CMakeFiles/multimode_clock_sim.dir/sim/sim_gpio.c.o.d"
+  "/root/repo/sim/sim_main.c" "CMakeFiles/multimode_clock_sim.dir/sim/sim_main.c.o" "gcc" "CMakeFiles/multimode_clock_sim.dir/sim/sim_main.c.o.d"
+  "/root/repo/sim/sim_pio.c" "CMakeFiles/multimode_clock_sim.dir/sim/sim_pio.c.o" "gcc" "CMakeFiles/multimode_clock_sim.dir/sim/sim_pio.c.o.d"
+  "/root/repo/sim/sim_pwm.c" "CMakeFiles/multimode_clock_sim.dir/sim/sim_pwm.c.o" "gcc" "CMakeFiles/multimode_clock_sim.dir/sim/sim_pwm.c.o.d"
+  "/root/repo/sim/sim_trace.c" "CMakeFiles/multimode_clock_sim.dir/sim/sim_trace.c.o" "gcc" "CMakeFiles/multimode_clock_sim.dir/sim/sim_trace.c.o.d"
+  "/root/repo/sim/sim_uart.c" "CMakeFiles/multimode_clock_sim.dir/sim/sim_uart.c.o" "gcc" "CMakeFiles/multimode_clock_sim.dir/sim/sim_uart.c.o.d"
+  "/root/repo/spsc_queue.c" "CMakeFiles/multimode_clock_sim.dir/spsc_queue.c.o" "gcc" "CMakeFiles/multimode_clock_sim.dir/spsc_queue.c.o.d"
+  "/root/repo/status_display.c" "CMakeFiles/multimode_clock_sim.dir/status_display.c.o" "gcc" "CMakeFiles/multimode_clock_sim.dir/status_display.c.o.d"
+  "/root/repo/sweep.c" "CMakeFiles/multimode_clock_sim.dir/sweep.c.o" "gcc" "CMakeFiles/multimode_clock_sim.dir/sweep.c.o.d"
+  "/root/repo/sweep_plan.c" "CMakeFiles/multimode_clock_sim.dir/sweep_plan.c.o" "gcc" "CMakeFiles/multimode_clock_sim.dir/sweep_plan.c.o.d"
+  "/root/repo/sys_clock.c" "CMakeFiles/multimode_clock_sim.dir/sys_clock.c.o" "gcc" "CMakeFiles/multimode_clock_sim.dir/sys_clock.c.o.d"
+  "/root/repo/trace_recorder.c" "CMakeFiles/multimode_clock_sim.dir/trace_recorder.c.o" "gcc" "CMakeFiles/multimode_clock_sim.dir/trace_recorder.c.o.d"
+  "/root/repo/uart_control.c" "CMakeFiles/multimode_clock_sim.dir/uart_control.c.o" "gcc" "CMakeFiles/multimode_clock_sim.dir/uart_control.c.o.d"
+  "/root/repo/uart_rx.c" "CMakeFiles/multimode_clock_sim.dir/uart_rx.c.o" "gcc" "CMakeFiles/multimode_clock_sim.dir/uart_rx.c.o.d"
+  "/root/repo/uart_tx.c" "CMakeFiles/multimode_clock_sim.dir/uart_tx.c.o" "gcc" "CMakeFiles/multimode_clock_sim.dir/uart_tx.c.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
@@ -0,0 +1,110 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/multimode_clock_sim.dir/button_handler.c.o"
+  "CMakeFiles/multimode_clock_sim.dir/button_handler.c.o.d"
+  "CMakeFiles/multimode_clock_sim.dir/byte_ring.c.o"
+  "CMakeFiles/multimode_clock_sim.dir/byte_ring.c.o.d"
+  "CMakeFiles/multimode_clock_sim.dir/clock_cache.c.o"
+  "CMakeFiles/multimode_clock_sim.dir/clock_cache.c.o.d"
+  "CMakeFiles/multimode_clock_sim.dir/clock_core.c.o"
+  "CMakeFiles/multimode_clock_sim.dir/clock_core.c.o.d"
+  "CMakeFiles/multimode_clock_sim.dir/clock_generator.c.o"
+  "CMakeFiles/multimode_clock_sim.dir/clock_generator.c.o.d"
+  "CMakeFiles/multimode_clock_sim.dir/clock_tables.c.o"
+  "CMakeFiles/multimode_clock_sim.dir/clock_tables.c.o.d"
+  "CMakeFiles/multimode_clock_sim.dir/command_table.c.o"
+  "CMakeFiles/multimode_clock_sim.dir/command_table.c.o.d"
+  "CMakeFiles/multimode_clock_sim.dir/control_arbiter.c.o"
+  "CMakeFiles/multimode_clock_sim.dir/control_arbiter.c.o.d"
+  "CMakeFiles/multimode_clock_sim.dir/control_frame.c.o"
+  "CMakeFiles/multimode_clock_sim.dir/control_frame.c.o.d"
+  "CMakeFiles/multimode_clock_sim.dir/control_port.c.o"
+  "CMakeFiles/multimode_clock_sim.dir/control_port.c.o.d"
+  "CMakeFiles/multimode_clock_sim.dir/control_protocol.c.o"
+  "CMakeFiles/multimode_clock_sim.dir/control_protocol.c.o.d"
+  "CMakeFiles/multimode_clock_sim.dir/debounce.c.o"
+  "CMakeFiles/multimode_clock_sim.dir/debounce.c.o.d"
+  "CMakeFiles/multimode_clock_sim.dir/discipline.c.o"
+  "CMakeFiles/multimode_clock_sim.dir/discipline.c.o.d"
+  "CMakeFiles/multimode_clock_sim.dir/discipline_loop.c.o"
+  "CMakeFiles/multimode_clock_sim.dir/discipline_loop.c.o.d"
+  "CMakeFiles/multimode_clock_sim.dir/duty_cycle.c.o"
+  "CMakeFiles/multimode_clock_sim.dir/duty_cycle.c.o.d"
+  "CMakeFiles/multimode_clock_sim.dir/freq_counter.c.o"
+  "CMakeFiles/multimode_clock_sim.dir/freq_counter.c.o.d"
+  "CMakeFiles/multimode_clock_sim.dir/freq_range.c.o"
+  "CMakeFiles/multimode_clock_sim.dir/freq_range.c.o.d"
+  "CMakeFiles/multimode_clock_sim.dir/hardware_init.c.o"
+  "CMakeFiles/multimode_clock_sim.dir/hardware_init.c.o.d"
+  "CMakeFiles/multimode_clock_sim.dir/line_assembler.c.o"
+  "CMakeFiles/multimode_clock_sim.dir/line_assembler.c.o.d"
+  "CMakeFiles/multimode_clock_sim.dir/main.c.o"
+  "CMakeFiles/multimode_clock_sim.dir/main.c.o.d"
+  "CMakeFiles/multimode_clock_sim.dir/output_trace.c.o"
+  "CMakeFiles/multimode_clock_sim.dir/output_trace.c.o.d"
+  "CMakeFiles/multimode_clock_sim.dir/pio_clock.c.o"
+  "CMakeFiles/multimode_clock_sim.dir/pio_clock.c.o.d"
+  "CMakeFiles/multimode_clock_sim.dir/pio_counter.c.o"
+  "CMakeFiles/multimode_clock_sim.dir/pio_counter.c.o.d"
+  "CMakeFiles/multimode_clock_sim.dir/pio_phase.c.o"
+  "CMakeFiles/multimode_clock_sim.dir/pio_phase.c.o.d"
+  "CMakeFiles/multimode_clock_sim.dir/pio_reset.c.o"
+  "CMakeFiles/multimode_clock_sim.dir/pio_reset.c.o.d"
+  "CMakeFiles/multimode_clock_sim.dir/pot_filter.c.o"
+  "CMakeFiles/multimode_clock_sim.dir/pot_filter.c.o.d"
+  "CMakeFiles/multimode_clock_sim.dir/pot_sampler.c.o"
+  "CMakeFiles/multimode_clock_sim.dir/pot_sampler.c.o.d"
+  "CMakeFiles/multimode_clock_sim.dir/power_control.c.o"
+  "CMakeFiles/multimode_clock_sim.dir/power_control.c.o.d"
+  "CMakeFiles/multimode_clock_sim.dir/pwm_clock.c.o"
+  "CMakeFiles/multimode_clock_sim.dir/pwm_clock.c.o.d"
+  "CMakeFiles/multimode_clock_sim.dir/pwm_solver.c.o"
+  "CMakeFiles/multimode_clock_sim.dir/pwm_solver.c.o.d"
+  "CMakeFiles/multimode_clock_sim.dir/reset_control.c.o"
+  "CMakeFiles/multimode_clock_sim.dir/reset_control.c.o.d"
+  "CMakeFiles/multimode_clock_sim.dir/scheduler.c.o"
+  "CMakeFiles/multimode_clock_sim.dir/scheduler.c.o.d"
+  "CMakeFiles/multimode_clock_sim.dir/sim/sim_adc.c.o"
+  "CMakeFiles/multimode_clock_sim.dir/sim/sim_adc.c.o.d"
+  "CMakeFiles/multimode_clock_sim.dir/sim/sim_core.c.o"
+  "CMakeFiles/multimode_clock_sim.dir/sim/sim_core.c.o.d"
+  "CMakeFiles/multimode_clock_sim.dir/sim/sim_dma.c.o"
+  "CMakeFiles/multimode_clock_sim.dir/sim/sim_dma.c.o.d"
+  "CMakeFiles/multimode_clock_sim.dir/sim/sim_gpio.c.o"
+  "CMakeFiles/multimode_clock_sim.dir/sim/sim_gpio.c.o.d"
+  "CMakeFiles/multimode_clock_sim.dir/sim/sim_main.c.o"
+  "CMakeFiles/multimode_clock_sim.dir/sim/sim_main.c.o.d"
+  "CMakeFiles/multimode_clock_sim.dir/sim/sim_pio.c.o"
+  "CMakeFiles/multimode_clock_sim.dir/sim/sim_pio.c.o.d"
+  "CMakeFiles/multimode_clock_sim.dir/sim/sim_pwm.c.o"
+  "CMakeFiles/multimode_clock_sim.dir/sim/sim_pwm.c.o.d"
+  "CMakeFiles/multimode_clock_sim.dir/sim/sim_trace.c.o"
+  "CMakeFiles/multimode_clock_sim.dir/sim/sim_trace.c.o.d"
+  "CMakeFiles/multimode_clock_sim.dir/sim/sim_uart.c.o"
+  "CMakeFiles/multimode_clock_sim.dir/sim/sim_uart.c.o.d"
+  "CMakeFiles/multimode_clock_sim.dir/spsc_queue.c.o"
+  "CMakeFiles/multimode_clock_sim.dir/spsc_queue.c.o.d"
+  "CMakeFiles/multimode_clock_sim.dir/status_display.c.o"
+  "CMakeFiles/multimode_clock_sim.dir/status_display.c.o.d"
+  "CMakeFiles/multimode_clock_sim.dir/sweep.c.o"
+  "CMakeFiles/multimode_clock_sim.dir/sweep.c.o.d"
+  "CMakeFiles/multimode_clock_sim.dir/sweep_plan.c.o"
+  "CMakeFiles/multimode_clock_sim.dir/sweep_plan.c.o.d"
+  "CMakeFiles/multimode_clock_sim.dir/sys_clock.c.o"
+  "CMakeFiles/multimode_clock_sim.dir/sys_clock.c.o.d"
+  "CMakeFiles/multimode_clock_sim.dir/trace_recorder.c.o"
+  "CMakeFiles/multimode_clock_sim.dir/trace_recorder.c.o.d"
+  "CMakeFiles/multimode_clock_sim.dir/uart_control.c.o"
+  "CMakeFiles/multimode_clock_sim.dir/uart_control.c.o.d"
+  "CMakeFiles/multimode_clock_sim.dir/uart_rx.c.o"
+  "CMakeFiles/multimode_clock_sim.dir/uart_rx.c.o.d"
+  "CMakeFiles/multimode_clock_sim.dir/uart_tx.c.o"
+  "CMakeFiles/multimode_clock_sim.dir/uart_tx.c.o.d"
+  "clock_tables.c"
+  "multimode_clock_sim"
+  "multimode_clock_sim.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang C)
+  include(CMakeFiles/multimode_clock_sim.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,1173 @@
+/**
+ * Precomputed clock tables - generated by gen_clock_tables.py, do not edit
+ */
+
+#include "clock_cache.h"
+
+const uint32_t clock_cache_adc_millihz[CLOCK_CACHE_ADC_ENTRIES] = {
+    1000u, 1003u, 1006u, 1008u, 1011u, 1014u, 1017u, 1020u,
+    1023u, 1026u, 1029u, 1031u, 1034u, 1037u, 1040u, 1043u,
+    1046u, 1049u, 1052u, 1055u, 1058u, 1061u, 1064u, 1067u,
+    1070u, 1073u, 1076u, 1079u, 1082u, 1085u, 1088u, 1091u,
+    1094u, 1097u, 1100u, 1103u, 1107u, 1110u, 1113u, 1116u,
+    1119u, 1122u, 1125u, 1129u, 1132u, 1135u, 1138u, 1141u,
+    1144u, 1148u, 1151u, 1154u, 1157u, 1161u, 1164u, 1167u,
+    1171u, 1174u, 1177u, 1180u, 1184u, 1187u, 1190u, 1194u,
+    1197u, 1201u, 1204u, 1207u, 1211u, 1214u, 1218u, 1221u,
+    1224u, 1228u, 1231u, 1235u, 1238u, 1242u, 1245u, 1249u,
+    1252u, 1256u, 1259u, 1263u, 1266u, 1270u, 1274u, 1277u,
+    1281u, 1284u, 1288u, 1292u, 1295u, 1299u, 1302u, 1306u,
+    1310u, 1314u, 1317u, 1321u, 1325u, 1328u, 1332u, 1336u,
+    1340u, 1343u, 1347u, 1351u, 1355u, 1359u, 1362u, 1366u,
+    1370u, 1374u, 1378u, 1382u, 1386u, 1389u, 1393u, 1397u,
+    1401u, 1405u, 1409u, 1413u, 1417u, 1421u, 1425u, 1429u,
+    1433u, 1437u, 1441u, 1445u, 1449u, 1453u, 1458u, 1462u,
+    1466u, 1470u, 1474u, 1478u, 1482u, 1486u, 1491u, 1495u,
+    1499u, 1503u, 1508u, 1512u, 1516u, 1520u, 1525u, 1529u,
+    1533u, 1537u, 1542u, 1546u, 1551u, 1555u, 1559u, 1564u,
+    1568u, 1572u, 1577u, 1581u, 1586u, 1590u, 1595u, 1599u,
+    1604u, 1608u, 1613u, 1617u, 1622u, 1626u, 1631u, 1636u,
+    1640u, 1645u, 1649u, 1654u, 1659u, 1663u, 1668u, 1673u,
+    1678u, 1682u, 1687u, 1692u, 1696u, 1701u, 1706u, 1711u,
+    1716u, 1720u, 1725u, 1730u, 1735u, 1740u, 1745u, 1750u,
+    1755u, 1760u, 1765u, 1770u, 1775u, 1780u, 1785u, 1790u,
+    1795u, 1800u, 1805u, 1810u, 1815u, 1820u, 1825u, 1830u,
+    1835u, 1841u, 1846u, 1851u, 1856u, 1861u, 1867u, 1872u,
+    1877u, 1882u, 1888u, 1893u, 1898u, 1904u, 1909u, 1914u,
+    1920u, 1925u, 1931u, 1936u, 1942u, 1947u, 1953u, 1958u,
+    1964u, 1969u, 1975u, 1980u, 1986u, 1991u, 1997u, 2003u,
+    2008u, 2014u, 2020u, 2025u, 2031u, 2037u, 2042u, 2048u,
+    2054u, 2060u, 2065u, 2071u, 2077u, 2083u, 2089u, 2095u,
+    2101u, 2107u, 2112u, 2118u, 2124u, 2130u, 2136u, 2142u,
+    2148u, 2154u, 2161u, 2167u, 2173u, 2179u, 2185u, 2191u,
+    2197u, 2203u, 2210u, 2216u, 2222u, 2228u, 2235u, 2241u,
+    2247u, 2254u, 2260u, 2266u, 2273u, 2279u, 2285u, 2292u,
+    2298u, 2305u, 2311u, 2318u, 2324u, 2331u, 2337u, 2344u,
+    2351u, 2357u, 2364u, 2371u, 2377u, 2384u, 2391u, 2397u,
+    2404u, 2411u, 2418u, 2424u, 2431u, 2438u, 2445u, 2452u,
+    2459u, 2466u, 2473u, 2480u, 2487u, 2494u, 2501u, 2508u,
+    2515u, 2522u, 2529u, 2536u, 2543u, 2550u, 2557u, 2565u,
+    2572u, 2579u, 2586u, 2594u, 2601u, 2608u, 2616u, 2623u,
+    2630u, 2638u, 2645u, 2653u, 2660u, 2668u, 2675u, 2683u,
+    2690u, 2698u, 2705u, 2713u, 2721u, 2728u, 2736u, 2744u,
+    2751u, 2759u, 2767u, 2775u, 2783u, 2790u, 2798u, 2806u,
+    2814u, 2822u, 2830u, 2838u, 2846u, 2854u, 2862u, 2870u,
+    2878u, 2886u, 2894u, 2902u, 2911u, 2919u, 2927u, 2935u,
+    2944u, 2952u, 2960u, 2968u, 2977u, 2985u, 2994u, 3002u,
+    3010u, 3019u, 3027u, 3036u, 3045u, 3053u, 3062u, 3070u,
+    3079u, 3088u, 3096u, 3105u, 3114u, 3123u, 3131u, 3140u,
+    3149u, 3158u, 3167u, 3176u, 3185u, 3194u, 3203u, 3212u,
+    3221u, 3230u, 3239u, 3248u, 3257u, 3266u, 3275u, 3285u,
+    3294u, 3303u, 3312u, 3322u, 3331u, 3340u, 3350u, 3359u,
+    3369u, 3378u, 3388u, 3397u, 3407u, 3416u, 3426u, 3436u,
+    3445u, 3455u, 3465u, 3475u, 3484u, 3494u, 3504u, 3514u,
+    3524u, 3534u, 3544u, 3554u, 3564u, 3574u, 3584u, 3594u,
+    3604u, 3614u, 3624u, 3634u, 3645u, 3655u, 3665u, 3676u,
+    3686u, 3696u, 3707u, 3717u, 3728u, 3738u, 3749u, 3759u,
+    3770u, 3780u, 3791u, 3802u, 3812u, 3823u, 3834u, 3845u,
+    3855u, 3866u, 3877u, 3888u, 3899u, 3910u, 3921u, 3932u,
+    3943u, 3954u, 3965u, 3977u, 3988u, 3999u, 4010u, 4022u,
+    4033u, 4044u, 4056u, 4067u, 4079u, 4090u, 4101u, 4113u,
+    4125u, 4136u, 4148u, 4160u, 4171u, 4183u, 4195u, 4207u,
+    4218u, 4230u, 4242u, 4254u, 4266u, 4278u, 4290u, 4302u,
+    4314u, 4327u, 4339u, 4351u, 4363u, 4375u, 4388u, 4400u,
+    4413u, 4425u, 4437u, 4450u, 4462u, 4475u, 4488u, 4500u,
+    4513u, 4526u, 4538u, 4551u, 4564u, 4577u, 4590u, 4603u,
+    4616u, 4629u, 4642u, 4655u, 4668u, 4681u, 4694u, 4707u,
+    4721u, 4734u, 4747u, 4761u, 4774u, 4787u, 4801u, 4814u,
+    4828u, 4842u, 4855u, 4869u, 4883u, 4896u, 4910u, 4924u,
+    4938u, 4952u, 4966u, 4980u, 4994u, 5008u, 5022u, 5036u,
+    5050u, 5064u, 5079u, 5093u, 5107u, 5122u, 5136u, 5150u,
+    5165u, 5179u, 5194u, 5209u, 5223u, 5238u, 5253u, 5268u,
+    5282u, 5297u, 5312u, 5327u, 5342u, 5357u, 5372u, 5387u,
+    5403u, 5418u, 5433u, 5448u, 5464u, 5479u, 5494u, 5510u,
+    5525u, 5541u, 5557u, 5572u, 5588u, 5604u, 5619u, 5635u,
+    5651u, 5667u, 5683u, 5699u, 5715u, 5731u, 5747u, 5763u,
+    5780u, 5796u, 5812u, 5829u, 5845u, 5862u, 5878u, 5895u,
+    5911u, 5928u, 5944u, 5961u, 5978u, 5995u, 6012u, 6029u,
+    6046u, 6063u, 6080u, 6097u, 6114u, 6131u, 6148u, 6166u,
+    6183u, 6201u, 6218u, 6236u, 6253u, 6271u, 6288u, 6306u,
+    6324u, 6342u, 6359u, 6377u, 6395u, 6413u, 6431u, 6449u,
+    6468u, 6486u, 6504u, 6522u, 6541u, 6559u, 6578u, 6596u,
+    6615u, 6633u, 6652u, 6671u, 6690u, 6708u, 6727u, 6746u,
+    6765u, 6784u, 6803u, 6823u, 6842u, 6861u, 6880u, 6900u,
+    6919u, 6939u, 6958u, 6978u, 6997u, 7017u, 7037u, 7057u,
+    7076u, 7096u, 7116u, 7136u, 7157u, 7177u, 7197u, 7217u,
+    7237u, 7258u, 7278u, 7299u, 7319u, 7340u, 7361u, 7381u,
+    7402u, 7423u, 7444u, 7465u, 7486u, 7507u, 7528u, 7549u,
+    7570u, 7592u, 7613u, 7635u, 7656u, 7678u, 7699u, 7721u,
+    7743u, 7764u, 7786u, 7808u, 7830u, 7852u, 7874u, 7897u,
+    7919u, 7941u, 7963u, 7986u, 8008u, 8031u, 8053u, 8076u,
+    8099u, 8122u, 8145u, 8167u, 8190u, 8214u, 8237u, 8260u,
+    8283u, 8306u, 8330u, 8353u, 8377u, 8400u, 8424u, 8448u,
+    8472u, 8495u, 8519u, 8543u, 8567u, 8591u, 8616u, 8640u,
+    8664u, 8689u, 8713u, 8738u, 8762u, 8787u, 8812u, 8836u,
+    8861u, 8886u, 8911u, 8936u, 8962u, 8987u, 9012u, 9037u,
+    9063u, 9088u, 9114u, 9140u, 9165u, 9191u, 9217u, 9243u,
+    9269u, 9295u, 9321u, 9348u, 9374u, 9400u, 9427u, 9453u,
+    9480u, 9507u, 9533u, 9560u, 9587u, 9614u, 9641u, 9668u,
+    9695u, 9723u, 9750u, 9778u, 9805u, 9833u, 9860u, 9888u,
+    9916u, 9944u, 9972u, 10000u, 10028u, 10056u, 10085u, 10113u,
+    10142u, 10170u, 10199u, 10227u, 10256u, 10285u, 10314u, 10343u,
+    10372u, 10401u, 10431u, 10460u, 10490u, 10519u, 10549u, 10578u,
+    10608u, 10638u, 10668u, 10698u, 10728u, 10758u, 10789u, 10819u,
+    10849u, 10880u, 10911u, 10941u, 10972u, 11003u, 11034u, 11065u,
+    11096u, 11128u, 11159u, 11190u, 11222u, 11253u, 11285u, 11317u,
+    11349u, 11381u, 11413u, 11445u, 11477u, 11509u, 11542u, 11574u,
+    11607u, 11639u, 11672u, 11705u, 11738u, 11771u, 11804u, 11838u,
+    11871u, 11904u, 11938u, 11971u, 12005u, 12039u, 12073u, 12107u,
+    12141u, 12175u, 12209u, 12244u, 12278u, 12313u, 12347u, 12382u,
+    12417u, 12452u, 12487u, 12522u, 12557u, 12593u, 12628u, 12664u,
+    12699u, 12735u, 12771u, 12807u, 12843u, 12879u, 12915u, 12952u,
+    12988u, 13025u, 13062u, 13098u, 13135u, 13172u, 13209u, 13246u,
+    13284u, 13321u, 13359u, 13396u, 13434u, 13472u, 13510u, 13548u,
+    13586u, 13624u, 13663u, 13701u, 13740u, 13778u, 13817u, 13856u,
+    13895u, 13934u, 13973u, 14013u, 14052u, 14092u, 14131u, 14171u,
+    14211u, 14251u, 14291u, 14331u, 14372u, 14412u, 14453u, 14493u,
+    14534u, 14575u, 14616u, 14657u, 14699u, 14740u, 14782u, 14823u,
+    14865u, 14907u, 14949u, 14991u, 15033u, 15075u, 15118u, 15160u,
+    15203u, 15246u, 15289u, 15332u, 15375u, 15418u, 15462u, 15505u,
+    15549u, 15593u, 15636u, 15681u, 15725u, 15769u, 15813u, 15858u,
+    15902u, 15947u, 15992u, 16037u, 16082u, 16128u, 16173u, 16219u,
+    16264u, 16310u, 16356u, 16402u, 16448u, 16494u, 16541u, 16587u,
+    16634u, 16681u, 16728u, 16775u, 16822u, 16870u, 16917u, 16965u,
+    17013u, 17060u, 17108u, 17157u, 17205u, 17253u, 17302u, 17351u,
+    17400u, 17449u, 17498u, 17547u, 17596u, 17646u, 17696u, 17745u,
+    17795u, 17845u, 17896u, 17946u, 17997u, 18047u, 18098u, 18149u,
+    18200u, 18251u, 18303u, 18354u, 18406u, 18458u, 18510u, 18562u,
+    18614u, 18666u, 18719u, 18772u, 18825u, 18878u, 18931u, 18984u,
+    19037u, 19091u, 19145u, 19199u, 19253u, 19307u, 19361u, 19416u,
+    19471u, 19525u, 19580u, 19635u, 19691u, 19746u, 19802u, 19857u,
+    19913u, 19969u, 20026u, 20082u, 20139u, 20195u, 20252u, 20309u,
+    20366u, 20424u, 20481u, 20539u, 20597u, 20655u, 20713u, 20771u,
+    20830u, 20888u, 20947u, 21006u, 21065u, 21124u, 21184u, 21244u,
+    21303u, 21363u, 21424u, 21484u, 21544u, 21605u, 21666u, 21727u,
+    21788u, 21849u, 21911u, 21973u, 22034u, 22096u, 22159u, 22221u,
+    22284u, 22346u, 22409u, 22472u, 22536u, 22599u, 22663u, 22726u,
+    22790u, 22855u, 22919u, 22984u, 23048u, 23113u, 23178u, 23243u,
+    23309u, 23375u, 23440u, 23506u, 23572u, 23639u, 23705u, 23772u,
+    23839u, 23906u, 23973u, 24041u, 24109u, 24177u, 24245u, 24313u,
+    24381u, 24450u, 24519u, 24588u, 24657u, 24726u, 24796u, 24866u,
+    24936u, 25006u, 25077u, 25147u, 25218u, 25289u, 25360u, 25432u,
+    25503u, 25575u, 25647u, 25719u, 25792u, 25864u, 25937u, 26010u,
+    26083u, 26157u, 26230u, 26304u, 26378u, 26452u, 26527u, 26602u,
+    26677u, 26752u, 26827u, 26902u, 26978u, 27054u, 27130u, 27207u,
+    27283u, 27360u, 27437u, 27514u, 27592u, 27670u, 27747u, 27826u,
+    27904u, 27982u, 28061u, 28140u, 28220u, 28299u, 28379u, 28459u,
+    28539u, 28619u, 28700u, 28780u, 28861u, 28943u, 29024u, 29106u,
+    29188u, 29270u, 29352u, 29435u, 29518u, 29601u, 29684u, 29768u,
+    29852u, 29936u, 30020u, 30105u, 30189u, 30274u, 30360u, 30445u,
+    30531u, 30617u, 30703u, 30789u, 30876u, 30963u, 31050u, 31138u,
+    31225u, 31313u, 31401u, 31490u, 31578u, 31667u, 31756u, 31846u,
+    31935u, 32025u, 32116u, 32206u, 32297u, 32388u, 32479u, 32570u,
+    32662u, 32754u, 32846u, 32939u, 33031u, 33124u, 33218u, 33311u,
+    33405u, 33499u, 33593u, 33688u, 33783u, 33878u, 33973u, 34069u,
+    34165u, 34261u, 34357u, 34454u, 34551u, 34648u, 34746u, 34844u,
+    34942u, 35040u, 35139u, 35238u, 35337u, 35436u, 35536u, 35636u,
+    35737u, 35837u, 35938u, 36039u, 36141u, 36243u, 36345u, 36447u,
+    36550u, 36652u, 36756u, 36859u, 36963u, 37067u, 37171u, 37276u,
+    37381u, 37486u, 37592u, 37698u, 37804u, 37910u, 38017u, 38124u,
+    38231u, 38339u, 38447u, 38555u, 38664u, 38772u, 38882u, 38991u,
+    39101u, 39211u, 39321u, 39432u, 39543u, 39654u, 39766u, 39878u,
+    39990u, 40103u, 40216u, 40329u, 40442u, 40556u, 40671u, 40785u,
+    40900u, 41015u, 41130u, 41246u, 41362u, 41479u, 41596u, 41713u,
+    41830u, 41948u, 42066u, 42184u, 42303u, 42422u, 42542u, 42662u,
+    42782u, 42902u, 43023u, 43144u, 43265u, 43387u, 43509u, 43632u,
+    43755u, 43878u, 44002u, 44125u, 44250u, 44374u, 44499u, 44624u,
+    44750u, 44876u, 45002u, 45129u, 45256u, 45384u, 45511u, 45639u,
+    45768u, 45897u, 46026u, 46156u, 46286u, 46416u, 46547u, 46678u,
+    46809u, 46941u, 47073u, 47206u, 47338u, 47472u, 47605u, 47739u,
+    47874u, 48009u, 48144u, 48279u, 48415u, 48552u, 48688u, 48825u,
+    48963u, 49101u, 49239u, 49377u, 49516u, 49656u, 49796u, 49936u,
+    50076u, 50217u, 50359u, 50501u, 50643u, 50785u, 50928u, 51072u,
+    51216u, 51360u, 51504u, 51649u, 51795u, 51941u, 52087u, 52233u,
+    52381u, 52528u, 52676u, 52824u, 52973u, 53122u, 53272u, 53422u,
+    53572u, 53723u, 53874u, 54026u, 54178u, 54330u, 54483u, 54637u,
+    54791u, 54945u, 55100u, 55255u, 55410u, 55566u, 55723u, 55880u,
+    56037u, 56195u, 56353u, 56511u, 56671u, 56830u, 56990u, 57151u,
+    57311u, 57473u, 57635u, 57797u, 57960u, 58123u, 58286u, 58451u,
+    58615u, 58780u, 58946u, 59112u, 59278u, 59445u, 59612u, 59780u,
+    59948u, 60117u, 60286u, 60456u, 60626u, 60797u, 60968u, 61140u,
+    61312u, 61485u, 61658u, 61831u, 62005u, 62180u, 62355u, 62531u,
+    62707u, 62883u, 63060u, 63238u, 63416u, 63594u, 63773u, 63953u,
+    64133u, 64314u, 64495u, 64676u, 64858u, 65041u, 65224u, 65408u,
+    65592u, 65777u, 65962u, 66147u, 66334u, 66520u, 66708u, 66895u,
+    67084u, 67273u, 67462u, 67652u, 67842u, 68034u, 68225u, 68417u,
+    68610u, 68803u, 68997u, 69191u, 69386u, 69581u, 69777u, 69973u,
+    70170u, 70368u, 70566u, 70765u, 70964u, 71164u, 71364u, 71565u,
+    71767u, 71969u, 72171u, 72374u, 72578u, 72782u, 72987u, 73193u,
+    73399u, 73606u, 73813u, 74021u, 74229u, 74438u, 74648u, 74858u,
+    75069u, 75280u, 75492u, 75704u, 75917u, 76131u, 76346u, 76561u,
+    76776u, 76992u, 77209u, 77426u, 77644u, 77863u, 78082u, 78302u,
+    78522u, 78744u, 78965u, 79188u, 79410u, 79634u, 79858u, 80083u,
+    80309u, 80535u, 80761u, 80989u, 81217u, 81445u, 81675u, 81905u,
+    82135u, 82367u, 82598u, 82831u, 83064u, 83298u, 83533u, 83768u,
+    84004u, 84240u, 84477u, 84715u, 84954u, 85193u, 85433u, 85673u,
+    85914u, 86156u, 86399u, 86642u, 86886u, 87131u, 87376u, 87622u,
+    87869u, 88116u, 88364u, 88613u, 88862u, 89113u, 89363u, 89615u,
+    89867u, 90120u, 90374u, 90629u, 90884u, 91140u, 91396u, 91653u,
+    91912u, 92170u, 92430u, 92690u, 92951u, 93213u, 93475u, 93738u,
+    94002u, 94267u, 94532u, 94798u, 95065u, 95333u, 95601u, 95870u,
+    96140u, 96411u, 96683u, 96955u, 97228u, 97501u, 97776u, 98051u,
+    98327u, 98604u, 98882u, 99160u, 99439u, 99719u, 100000u, 100282u,
+    100564u, 100847u, 101131u, 101416u, 101701u, 101988u, 102275u, 102563u,
+    102851u, 103141u, 103431u, 103723u, 104015u, 104307u, 104601u, 104896u,
+    105191u, 105487u, 105784u, 106082u, 106380u, 106680u, 106980u, 107282u,
+    107584u, 107886u, 108190u, 108495u, 108800u, 109107u, 109414u, 109722u,
+    110031u, 110341u, 110651u, 110963u, 111275u, 111588u, 111903u, 112218u,
+    112534u, 112850u, 113168u, 113487u, 113806u, 114127u, 114448u, 114770u,
+    115093u, 115417u, 115742u, 116068u, 116395u, 116723u, 117051u, 117381u,
+    117711u, 118043u, 118375u, 118708u, 119043u, 119378u, 119714u, 120051u,
+    120389u, 120728u, 121068u, 121408u, 121750u, 122093u, 122437u, 122782u,
+    123127u, 123474u, 123822u, 124170u, 124520u, 124870u, 125222u, 125574u,
+    125928u, 126282u, 126638u, 126995u, 127352u, 127711u, 128070u, 128431u,
+    128792u, 129155u, 129519u, 129883u, 130249u, 130616u, 130983u, 131352u,
+    131722u, 132093u, 132465u, 132838u, 133212u, 133587u, 133963u, 134340u,
+    134718u, 135097u, 135478u, 135859u, 136242u, 136625u, 137010u, 137396u,
+    137783u, 138170u, 138559u, 138950u, 139341u, 139733u, 140126u, 140521u,
+    140917u, 141313u, 141711u, 142110u, 142510u, 142911u, 143314u, 143717u,
+    144122u, 144528u, 144935u, 145343u, 145752u, 146162u, 146574u, 146986u,
+    147400u, 147815u, 148231u, 148649u, 149067u, 149487u, 149908u, 150330u,
+    150753u, 151178u, 151603u, 152030u, 152458u, 152887u, 153318u, 153749u,
+    154182u, 154616u, 155052u, 155488u, 155926u, 156365u, 156805u, 157247u,
+    157689u, 158133u, 158578u, 159025u, 159473u, 159922u, 160372u, 160823u,
+    161276u, 161730u, 162186u, 162642u, 163100u, 163559u, 164020u, 164482u,
+    164945u, 165409u, 165875u, 166342u, 166810u, 167280u, 167751u, 168223u,
+    168697u, 169172u, 169648u, 170125u, 170604u, 171085u, 171566u, 172049u,
+    172534u, 173020u, 173507u, 173995u, 174485u, 174976u, 175469u, 175963u,
+    176458u, 176955u, 177453u, 177953u, 178454u, 178956u, 179460u, 179965u,
+    180472u, 180980u, 181490u, 182001u, 182513u, 183027u, 183542u, 184059u,
+    184577u, 185097u, 185618u, 186141u, 186665u, 187190u, 187717u, 188246u,
+    188776u, 189307u, 189840u, 190375u, 190911u, 191448u, 191987u, 192528u,
+    193070u, 193613u, 194158u, 194705u, 195253u, 195803u, 196354u, 196907u,
+    197461u, 198017u, 198575u, 199134u, 199695u, 200257u, 200821u, 201386u,
+    201953u, 202522u, 203092u, 203664u, 204237u, 204812u, 205389u, 205967u,
+    206547u, 207128u, 207711u, 208296u, 208883u, 209471u, 210060u, 210652u,
+    211245u, 211840u, 212436u, 213034u, 213634u, 214235u, 214839u, 215443u,
+    216050u, 216658u, 217268u, 217880u, 218493u, 219109u, 219725u, 220344u,
+    220964u, 221587u, 222210u, 222836u, 223463u, 224093u, 224723u, 225356u,
+    225991u, 226627u, 227265u, 227905u, 228546u, 229190u, 229835u, 230482u,
+    231131u, 231782u, 232434u, 233089u, 233745u, 234403u, 235063u, 235725u,
+    236389u, 237054u, 237721u, 238391u, 239062u, 239735u, 240410u, 241087u,
+    241766u, 242446u, 243129u, 243813u, 244500u, 245188u, 245878u, 246571u,
+    247265u, 247961u, 248659u, 249359u, 250061u, 250765u, 251471u, 252179u,
+    252889u, 253601u, 254315u, 255031u, 255749u, 256469u, 257191u, 257915u,
+    258642u, 259370u, 260100u, 260832u, 261567u, 262303u, 263042u, 263782u,
+    264525u, 265270u, 266016u, 266765u, 267516u, 268270u, 269025u, 269782u,
+    270542u, 271304u, 272067u, 272833u, 273601u, 274372u, 275144u, 275919u,
+    276696u, 277475u, 278256u, 279039u, 279825u, 280613u, 281403u, 282195u,
+    282990u, 283786u, 284585u, 285387u, 286190u, 286996u, 287804u, 288614u,
+    289427u, 290241u, 291059u, 291878u, 292700u, 293524u, 294350u, 295179u,
+    296010u, 296843u, 297679u, 298517u, 299358u, 300201u, 301046u, 301893u,
+    302743u, 303596u, 304450u, 305308u, 306167u, 307029u, 307893u, 308760u,
+    309630u, 310501u, 311376u, 312252u, 313131u, 314013u, 314897u, 315784u,
+    316673u, 317564u, 318458u, 319355u, 320254u, 321156u, 322060u, 322967u,
+    323876u, 324788u, 325702u, 326619u, 327539u, 328461u, 329386u, 330313u,
+    331243u, 332175u, 333111u, 334048u, 334989u, 335932u, 336878u, 337826u,
+    338777u, 339731u, 340688u, 341647u, 342609u, 343573u, 344541u, 345511u,
+    346483u, 347459u, 348437u, 349418u, 350402u, 351389u, 352378u, 353370u,
+    354365u, 355362u, 356363u, 357366u, 358372u, 359381u, 360393u, 361408u,
+    362425u, 363446u, 364469u, 365495u, 366524u, 367556u, 368591u, 369629u,
+    370669u, 371713u, 372759u, 373809u, 374861u, 375917u, 376975u, 378036u,
+    379101u, 380168u, 381238u, 382312u, 383388u, 384467u, 385550u, 386635u,
+    387724u, 388816u, 389910u, 391008u, 392109u, 393213u, 394320u, 395430u,
+    396543u, 397660u, 398779u, 399902u, 401028u, 402157u, 403289u, 404425u,
+    405563u, 406705u, 407850u, 408998u, 410150u, 411305u, 412463u, 413624u,
+    414788u, 415956u, 417127u, 418302u, 419479u, 420660u, 421845u, 423032u,
+    424223u, 425418u, 426615u, 427817u, 429021u, 430229u, 431440u, 432655u,
+    433873u, 435095u, 436320u, 437548u, 438780u, 440015u, 441254u, 442496u,
+    443742u, 444991u, 446244u, 447501u, 448761u, 450024u, 451291u, 452562u,
+    453836u, 455113u, 456395u, 457680u, 458968u, 460260u, 461556u, 462856u,
+    464159u, 465466u, 466776u, 468090u, 469408u, 470730u, 472055u, 473384u,
+    474717u, 476053u, 477394u, 478738u, 480086u, 481437u, 482793u, 484152u,
+    485515u, 486882u, 488253u, 489627u, 491006u, 492388u, 493775u, 495165u,
+    496559u, 497957u, 499359u, 500765u, 502175u, 503588u, 505006u, 506428u,
+    507854u, 509284u, 510717u, 512155u, 513597u, 515043u, 516493u, 517947u,
+    519406u, 520868u, 522335u, 523805u, 525280u, 526759u, 528242u, 529729u,
+    531220u, 532716u, 534216u, 535720u, 537228u, 538741u, 540257u, 541778u,
+    543304u, 544833u, 546367u, 547906u, 549448u, 550995u, 552546u, 554102u,
+    555662u, 557226u, 558795u, 560369u, 561946u, 563528u, 565115u, 566706u,
+    568301u, 569901u, 571506u, 573115u, 574729u, 576347u, 577969u, 579597u,
+    581228u, 582865u, 584506u, 586151u, 587802u, 589457u, 591116u, 592780u,
+    594449u, 596123u, 597801u, 599484u, 601172u, 602865u, 604562u, 606264u,
+    607971u, 609683u, 611399u, 613120u, 614847u, 616578u, 618314u, 620054u,
+    621800u, 623551u, 625306u, 627067u, 628832u, 630603u, 632378u, 634158u,
+    635944u, 637734u, 639530u, 641330u, 643136u, 644947u, 646762u, 648583u,
+    650409u, 652241u, 654077u, 655918u, 657765u, 659617u, 661474u, 663336u,
+    665204u, 667077u, 668955u, 670838u, 672727u, 674621u, 676520u, 678425u,
+    680335u, 682250u, 684171u, 686097u, 688029u, 689966u, 691909u, 693857u,
+    695810u, 697769u, 699734u, 701704u, 703679u, 705661u, 707647u, 709640u,
+    711638u, 713641u, 715650u, 717665u, 719686u, 721712u, 723744u, 725781u,
+    727825u, 729874u, 731929u, 733990u, 736056u, 738128u, 740206u, 742290u,
+    744380u, 746476u, 748578u, 750685u, 752799u, 754918u, 757044u, 759175u,
+    761312u, 763456u, 765605u, 767761u, 769922u, 772090u, 774264u, 776444u,
+    778630u, 780822u, 783020u, 785225u, 787435u, 789652u, 791875u, 794105u,
+    796341u, 798583u, 800831u, 803086u, 805347u, 807614u, 809888u, 812168u,
+    814455u, 816748u, 819047u, 821353u, 823666u, 825985u, 828310u, 830642u,
+    832981u, 835326u, 837678u, 840036u, 842401u, 844773u, 847151u, 849536u,
+    851928u, 854327u, 856732u, 859144u, 861563u, 863988u, 866421u, 868860u,
+    871306u, 873760u, 876220u, 878686u, 881160u, 883641u, 886129u, 888624u,
+    891126u, 893635u, 896151u, 898674u, 901204u, 903741u, 906285u, 908837u,
+    911396u, 913962u, 916535u, 919115u, 921703u, 924298u, 926900u, 929510u,
+    932127u, 934751u, 937383u, 940022u, 942668u, 945322u, 947984u, 950653u,
+    953329u, 956013u, 958705u, 961404u, 964111u, 966825u, 969547u, 972277u,
+    975014u, 977759u, 980512u, 983273u, 986041u, 988817u, 991601u, 994393u,
+    997192u, 1000000u, 1002815u, 1005639u, 1008470u, 1011309u, 1014157u, 1017012u,
+    1019875u, 1022747u, 1025626u, 1028514u, 1031409u, 1034313u, 1037225u, 1040145u,
+    1043074u, 1046010u, 1048955u, 1051909u, 1054870u, 1057840u, 1060818u, 1063805u,
+    1066800u, 1069804u, 1072815u, 1075836u, 1078865u, 1081902u, 1084948u, 1088003u,
+    1091066u, 1094138u, 1097218u, 1100307u, 1103405u, 1106512u, 1109627u, 1112751u,
+    1115884u, 1119026u, 1122176u, 1125336u, 1128504u, 1131681u, 1134867u, 1138062u,
+    1141266u, 1144480u, 1147702u, 1150933u, 1154173u, 1157423u, 1160682u, 1163949u,
+    1167226u, 1170513u, 1173808u, 1177113u, 1180427u, 1183750u, 1187083u, 1190425u,
+    1193777u, 1197138u, 1200508u, 1203888u, 1207277u, 1210676u, 1214085u, 1217503u,
+    1220931u, 1224368u, 1227815u, 1231272u, 1234739u, 1238215u, 1241701u, 1245197u,
+    1248703u, 1252218u, 1255744u, 1259279u, 1262825u, 1266380u, 1269946u, 1273521u,
+    1277106u, 1280702u, 1284308u, 1287924u, 1291550u, 1295186u, 1298832u, 1302489u,
+    1306156u, 1309834u, 1313521u, 1317219u, 1320928u, 1324647u, 1328376u, 1332116u,
+    1335867u, 1339628u, 1343399u, 1347182u, 1350974u, 1354778u, 1358592u, 1362417u,
+    1366253u, 1370100u, 1373957u, 1377825u, 1381704u, 1385594u, 1389495u, 1393408u,
+    1397331u, 1401265u, 1405210u, 1409166u, 1413133u, 1417112u, 1421102u, 1425103u,
+    1429115u, 1433138u, 1437173u, 1441220u, 1445277u, 1449346u, 1453427u, 1457519u,
+    1461622u, 1465737u, 1469864u, 1474002u, 1478152u, 1482314u, 1486487u, 1490672u,
+    1494869u, 1499078u, 1503298u, 1507531u, 1511775u, 1516031u, 1520300u, 1524580u,
+    1528872u, 1533177u, 1537493u, 1541822u, 1546163u, 1550516u, 1554881u, 1559259u,
+    1563649u, 1568051u, 1572466u, 1576893u, 1581333u, 1585785u, 1590249u, 1594726u,
+    1599216u, 1603719u, 1608234u, 1612762u, 1617302u, 1621856u, 1626422u, 1631001u,
+    1635593u, 1640198u, 1644816u, 1649446u, 1654090u, 1658747u, 1663417u, 1668101u,
+    1672797u, 1677507u, 1682229u, 1686966u, 1691715u, 1696478u, 1701254u, 1706044u,
+    1710847u, 1715664u, 1720494u, 1725338u, 1730196u, 1735067u, 1739952u, 1744851u,
+    1749763u, 1754689u, 1759630u, 1764584u, 1769552u, 1774534u, 1779530u, 1784540u,
+    1789564u, 1794602u, 1799655u, 1804722u, 1809803u, 1814898u, 1820008u, 1825132u,
+    1830270u, 1835423u, 1840591u, 1845773u, 1850970u, 1856181u, 1861407u, 1866647u,
+    1871903u, 1877173u, 1882458u, 1887758u, 1893073u, 1898402u, 1903747u, 1909107u,
+    1914482u, 1919872u, 1925277u, 1930698u, 1936133u, 1941584u, 1947051u, 1952533u,
+    1958030u, 1963542u, 1969071u, 1974614u, 1980174u, 1985749u, 1991339u, 1996946u,
+    2002568u, 2008206u, 2013860u, 2019530u, 2025216u, 2030918u, 2036635u, 2042369u,
+    2048120u, 2053886u, 2059668u, 2065467u, 2071282u, 2077114u, 2082962u, 2088826u,
+    2094707u, 2100605u, 2106519u, 2112449u, 2118397u, 2124361u, 2130342u, 2136340u,
+    2142354u, 2148386u, 2154435u, 2160500u, 2166583u, 2172683u, 2178800u, 2184934u,
+    2191086u, 2197254u, 2203441u, 2209644u, 2215865u, 2222104u, 2228360u, 2234634u,
+    2240925u, 2247234u, 2253561u, 2259906u, 2266268u, 2272649u, 2279047u, 2285464u,
+    2291898u, 2298351u, 2304822u, 2311311u, 2317818u, 2324344u, 2330888u, 2337450u,
+    2344031u, 2350631u, 2357249u, 2363885u, 2370540u, 2377215u, 2383907u, 2390619u,
+    2397350u, 2404099u, 2410868u, 2417655u, 2424462u, 2431288u, 2438133u, 2444997u,
+    2451881u, 2458784u, 2465707u, 2472649u, 2479610u, 2486591u, 2493592u, 2500613u,
+    2507653u, 2514713u, 2521793u, 2528893u, 2536013u, 2543153u, 2550313u, 2557493u,
+    2564693u, 2571914u, 2579155u, 2586416u, 2593698u, 2601000u, 2608323u, 2615667u,
+    2623031u, 2630416u, 2637822u, 2645248u, 2652696u, 2660164u, 2667654u, 2675164u,
+    2682696u, 2690249u, 2697823u, 2705418u, 2713035u, 2720674u, 2728333u, 2736015u,
+    2743718u, 2751442u, 2759189u, 2766957u, 2774747u, 2782559u, 2790393u, 2798250u,
+    2806128u, 2814028u, 2821951u, 2829896u, 2837863u, 2845853u, 2853865u, 2861900u,
+    2869957u, 2878038u, 2886140u, 2894266u, 2902415u, 2910586u, 2918781u, 2926998u,
+    2935239u, 2943503u, 2951790u, 2960101u, 2968435u, 2976792u, 2985173u, 2993577u,
+    3002005u, 3010457u, 3018933u, 3027433u, 3035956u, 3044504u, 3053075u, 3061671u,
+    3070291u, 3078935u, 3087603u, 3096296u, 3105013u, 3113755u, 3122522u, 3131313u,
+    3140129u, 3148970u, 3157835u, 3166726u, 3175642u, 3184582u, 3193548u, 3202540u,
+    3211556u, 3220598u, 3229665u, 3238758u, 3247877u, 3257021u, 3266191u, 3275386u,
+    3284608u, 3293855u, 3303129u, 3312429u, 3321754u, 3331107u, 3340485u, 3349890u,
+    3359321u, 3368779u, 3378264u, 3387775u, 3397313u, 3406878u, 3416469u, 3426088u,
+    3435734u, 3445407u, 3455107u, 3464835u, 3474590u, 3484372u, 3494182u, 3504020u,
+    3513885u, 3523778u, 3533699u, 3543648u, 3553625u, 3563630u, 3573663u, 3583724u,
+    3593814u, 3603932u, 3614078u, 3624253u, 3634457u, 3644690u, 3654951u, 3665241u,
+    3675560u, 3685909u, 3696286u, 3706693u, 3717128u, 3727594u, 3738088u, 3748613u,
+    3759167u, 3769750u, 3780364u, 3791007u, 3801680u, 3812383u, 3823117u, 3833881u,
+    3844675u, 3855499u, 3866354u, 3877239u, 3888155u, 3899102u, 3910080u, 3921088u,
+    3932128u, 3943198u, 3954300u, 3965433u, 3976597u, 3987793u, 3999020u, 4010279u,
+    4021570u, 4032892u, 4044246u, 4055633u, 4067051u, 4078501u, 4089984u, 4101499u,
+    4113046u, 4124626u, 4136239u, 4147884u, 4159562u, 4171273u, 4183017u, 4194794u,
+    4206604u, 4218447u, 4230324u, 4242234u, 4254178u, 4266155u, 4278166u, 4290211u,
+    4302290u, 4314402u, 4326549u, 4338730u, 4350945u, 4363195u, 4375479u, 4387798u,
+    4400152u, 4412540u, 4424963u, 4437421u, 4449914u, 4462443u, 4475006u, 4487605u,
+    4500240u, 4512910u, 4525616u, 4538357u, 4551134u, 4563948u, 4576797u, 4589683u,
+    4602605u, 4615563u, 4628558u, 4641589u, 4654657u, 4667762u, 4680903u, 4694082u,
+    4707298u, 4720551u, 4733841u, 4747169u, 4760534u, 4773937u, 4787378u, 4800856u,
+    4814372u, 4827927u, 4841519u, 4855150u, 4868820u, 4882527u, 4896274u, 4910059u,
+    4923883u, 4937745u, 4951647u, 4965588u, 4979568u, 4993588u, 5007647u, 5021746u,
+    5035884u, 5050062u, 5064280u, 5078538u, 5092836u, 5107175u, 5121553u, 5135973u,
+    5150433u, 5164933u, 5179475u, 5194057u, 5208680u, 5223345u, 5238051u, 5252798u,
+    5267587u, 5282417u, 5297290u, 5312204u, 5327160u, 5342158u, 5357198u, 5372281u,
+    5387406u, 5402574u, 5417785u, 5433038u, 5448334u, 5463673u, 5479056u, 5494482u,
+    5509951u, 5525464u, 5541020u, 5556621u, 5572265u, 5587953u, 5603685u, 5619462u,
+    5635283u, 5651149u, 5667059u, 5683014u, 5699014u, 5715060u, 5731150u, 5747285u,
+    5763466u, 5779693u, 5795965u, 5812283u, 5828647u, 5845057u, 5861513u, 5878016u,
+    5894565u, 5911161u, 5927803u, 5944492u, 5961229u, 5978012u, 5994843u, 6011720u,
+    6028646u, 6045619u, 6062640u, 6079709u, 6096826u, 6113991u, 6131204u, 6148466u,
+    6165777u, 6183136u, 6200544u, 6218001u, 6235507u, 6253063u, 6270668u, 6288322u,
+    6306027u, 6323781u, 6341585u, 6359439u, 6377343u, 6395298u, 6413304u, 6431360u,
+    6449467u, 6467625u, 6485834u, 6504094u, 6522406u, 6540769u, 6559184u, 6577651u,
+    6596170u, 6614741u, 6633364u, 6652040u, 6670768u, 6689549u, 6708383u, 6727270u,
+    6746210u, 6765203u, 6784250u, 6803350u, 6822505u, 6841713u, 6860975u, 6880291u,
+    6899662u, 6919088u, 6938568u, 6958103u, 6977693u, 6997338u, 7017038u, 7036794u,
+    7056606u, 7076473u, 7096396u, 7116375u, 7136411u, 7156503u, 7176651u, 7196857u,
+    7217119u, 7237438u, 7257814u, 7278248u, 7298739u, 7319288u, 7339895u, 7360560u,
+    7381283u, 7402065u, 7422904u, 7443803u, 7464760u, 7485777u, 7506852u, 7527987u,
+    7549182u, 7570436u, 7591750u, 7613124u, 7634558u, 7656052u, 7677607u, 7699223u,
+    7720899u, 7742637u, 7764436u, 7786296u, 7808217u, 7830201u, 7852246u, 7874353u,
+    7896523u, 7918755u, 7941049u, 7963407u, 7985827u, 8008311u, 8030857u, 8053467u,
+    8076141u, 8098879u, 8121681u, 8144547u, 8167477u, 8190472u, 8213531u, 8236656u,
+    8259845u, 8283100u, 8306421u, 8329807u, 8353259u, 8376776u, 8400361u, 8424011u,
+    8447728u, 8471512u, 8495363u, 8519281u, 8543266u, 8567319u, 8591439u, 8615628u,
+    8639884u, 8664209u, 8688603u, 8713065u, 8737596u, 8762196u, 8786865u, 8811603u,
+    8836412u, 8861290u, 8886238u, 8911257u, 8936345u, 8961505u, 8986735u, 9012037u,
+    9037409u, 9062853u, 9088369u, 9113957u, 9139616u, 9165348u, 9191152u, 9217029u,
+    9242979u, 9269002u, 9295098u, 9321267u, 9347511u, 9373828u, 9400219u, 9426685u,
+    9453225u, 9479839u, 9506529u, 9533294u, 9560134u, 9587050u, 9614041u, 9641109u,
+    9668253u, 9695473u, 9722769u, 9750143u, 9777594u, 9805122u, 9832727u, 9860410u,
+    9888172u, 9916011u, 9943929u, 9971925u, 10000000u, 10028154u, 10056388u, 10084700u,
+    10113093u, 10141566u, 10170118u, 10198751u, 10227465u, 10256260u, 10285135u, 10314092u,
+    10343131u, 10372251u, 10401453u, 10430738u, 10460104u, 10489554u, 10519086u, 10548702u,
+    10578401u, 10608184u, 10638050u, 10668001u, 10698035u, 10728155u, 10758359u, 10788648u,
+    10819023u, 10849483u, 10880029u, 10910660u, 10941378u, 10972183u, 11003074u, 11034052u,
+    11065118u, 11096271u, 11127511u, 11158840u, 11190257u, 11221762u, 11253356u, 11285039u,
+    11316811u, 11348672u, 11380624u, 11412665u, 11444796u, 11477018u, 11509330u, 11541734u,
+    11574229u, 11606815u, 11639493u, 11672263u, 11705125u, 11738080u, 11771128u, 11804268u,
+    11837502u, 11870830u, 11904251u, 11937766u, 11971376u, 12005081u, 12038880u, 12072774u,
+    12106764u, 12140850u, 12175031u, 12209309u, 12243683u, 12278154u, 12312722u, 12347388u,
+    12382151u, 12417012u, 12451971u, 12487028u, 12522184u, 12557440u, 12592794u, 12628248u,
+    12663802u, 12699456u, 12735210u, 12771065u, 12807021u, 12843078u, 12879236u, 12915497u,
+    12951859u, 12988324u, 13024892u, 13061562u, 13098336u, 13135213u, 13172194u, 13209279u,
+    13246469u, 13283763u, 13321162u, 13358667u, 13396277u, 13433993u, 13471816u, 13509744u,
+    13547780u, 13585923u, 13624173u, 13662530u, 13700996u, 13739570u, 13778252u, 13817044u,
+    13855945u, 13894955u, 13934075u, 13973305u, 14012646u, 14052097u, 14091660u, 14131334u,
+    14171119u, 14211017u, 14251027u, 14291149u, 14331385u, 14371734u, 14412196u, 14452772u,
+    14493463u, 14534268u, 14575188u, 14616223u, 14657374u, 14698640u, 14740023u, 14781523u,
+    14823139u, 14864872u, 14906723u, 14948691u, 14990778u, 15032983u, 15075307u, 15117751u,
+    15160313u, 15202996u, 15245799u, 15288722u, 15331766u, 15374931u, 15418218u, 15461627u,
+    15505158u, 15548811u, 15592588u, 15636487u, 15680510u, 15724658u, 15768929u, 15813325u,
+    15857846u, 15902493u, 15947265u, 15992163u, 16037187u, 16082339u, 16127617u, 16173023u,
+    16218557u, 16264219u, 16310009u, 16355929u, 16401978u, 16448156u, 16494464u, 16540903u,
+    16587473u, 16634173u, 16681005u, 16727969u, 16775066u, 16822294u, 16869656u, 16917151u,
+    16964780u, 17012543u, 17060440u, 17108472u, 17156640u, 17204943u, 17253382u, 17301957u,
+    17350670u, 17399519u, 17448506u, 17497631u, 17546894u, 17596295u, 17645836u, 17695517u,
+    17745337u, 17795297u, 17845399u, 17895641u, 17946024u, 17996550u, 18047218u, 18098028u,
+    18148982u, 18200078u, 18251319u, 18302704u, 18354234u, 18405909u, 18457729u, 18509695u,
+    18561808u, 18614067u, 18666473u, 18719027u, 18771729u, 18824579u, 18877578u, 18930726u,
+    18984024u, 19037472u, 19091070u, 19144820u, 19198720u, 19252773u, 19306977u, 19361334u,
+    19415845u, 19470508u, 19525326u, 19580298u, 19635424u, 19690706u, 19746144u, 19801737u,
+    19857488u, 19913395u, 19969459u, 20025681u, 20082062u, 20138601u, 20195300u, 20252158u,
+    20309176u, 20366355u, 20423695u, 20481196u, 20538859u, 20596684u, 20654673u, 20712824u,
+    20771139u, 20829619u, 20888263u, 20947072u, 21006046u, 21065187u, 21124494u, 21183969u,
+    21243610u, 21303420u, 21363398u, 21423545u, 21483861u, 21544347u, 21605003u, 21665830u,
+    21726829u, 21787999u, 21849341u, 21910856u, 21972544u, 22034406u, 22096442u, 22158652u,
+    22221038u, 22283600u, 22346337u, 22409251u, 22472343u, 22535612u, 22599059u, 22662685u,
+    22726489u, 22790474u, 22854639u, 22918984u, 22983510u, 23048219u, 23113109u, 23178182u,
+    23243438u, 23308878u, 23374502u, 23440311u, 23506305u, 23572485u, 23638852u, 23705405u,
+    23772145u, 23839074u, 23906191u, 23973496u, 24040992u, 24108677u, 24176553u, 24244620u,
+    24312879u, 24381330u, 24449973u, 24518810u, 24587841u, 24657066u, 24726486u, 24796101u,
+    24865912u, 24935920u, 25006125u, 25076528u, 25147128u, 25217928u, 25288927u, 25360126u,
+    25431525u, 25503125u, 25574927u, 25646931u, 25719138u, 25791548u, 25864162u, 25936980u,
+    26010004u, 26083233u, 26156668u, 26230310u, 26304159u, 26378216u, 26452482u, 26526956u,
+    26601641u, 26676535u, 26751641u, 26826958u, 26902487u, 26978229u, 27054184u, 27130352u,
+    27206736u, 27283334u, 27360148u, 27437178u, 27514425u, 27591889u, 27669572u, 27747473u,
+    27825594u, 27903935u, 27982496u, 28061278u, 28140282u, 28219509u, 28298958u, 28378632u,
+    28458529u, 28538652u, 28619000u, 28699574u, 28780376u, 28861404u, 28942661u, 29024147u,
+    29105862u, 29187807u, 29269983u, 29352390u, 29435029u, 29517901u, 29601006u, 29684345u,
+    29767919u, 29851728u, 29935773u, 30020055u, 30104573u, 30189330u, 30274326u, 30359561u,
+    30445035u, 30530751u, 30616708u, 30702906u, 30789348u, 30876033u, 30962961u, 31050135u,
+    31137554u, 31225219u, 31313131u, 31401291u, 31489698u, 31578355u, 31667261u, 31756417u,
+    31845825u, 31935484u, 32025396u, 32115561u, 32205979u, 32296652u, 32387581u, 32478765u,
+    32570207u, 32661905u, 32753862u, 32846078u, 32938553u, 33031289u, 33124286u, 33217544u,
+    33311065u, 33404850u, 33498898u, 33593212u, 33687790u, 33782636u, 33877748u, 33973128u,
+    34068776u, 34164694u, 34260882u, 34357340u, 34454070u, 34551073u, 34648349u, 34745898u,
+    34843722u, 34941822u, 35040197u, 35138850u, 35237781u, 35336990u, 35436478u, 35536246u,
+    35636296u, 35736626u, 35837240u, 35938137u, 36039317u, 36140783u, 36242534u, 36344572u,
+    36446897u, 36549510u, 36652412u, 36755604u, 36859086u, 36962860u, 37066926u, 37171285u,
+    37275937u, 37380884u, 37486127u, 37591666u, 37697502u, 37803636u, 37910069u, 38016802u,
+    38123835u, 38231169u, 38338806u, 38446746u, 38554989u, 38663538u, 38772391u, 38881552u,
+    38991020u, 39100795u, 39210880u, 39321275u, 39431981u, 39542998u, 39654328u, 39765972u,
+    39877929u, 39990202u, 40102791u, 40215697u, 40328921u, 40442464u, 40556326u, 40670509u,
+    40785014u, 40899840u, 41014990u, 41130464u, 41246264u, 41362389u, 41478841u, 41595622u,
+    41712731u, 41830169u, 41947939u, 42066039u, 42184473u, 42303240u, 42422341u, 42541777u,
+    42661550u, 42781660u, 42902108u, 43022895u, 43144023u, 43265491u, 43387301u, 43509455u,
+    43631952u, 43754794u, 43877982u, 44001516u, 44125399u, 44249630u, 44374211u, 44499143u,
+    44624427u, 44750063u, 44876053u, 45002398u, 45129098u, 45256155u, 45383570u, 45511344u,
+    45639477u, 45767971u, 45896827u, 46026046u, 46155628u, 46285575u, 46415888u, 46546568u,
+    46677616u, 46809033u, 46940820u, 47072978u, 47205508u, 47338411u, 47471688u, 47605341u,
+    47739369u, 47873776u, 48008560u, 48143724u, 48279269u, 48415195u, 48551504u, 48688196u,
+    48825274u, 48962737u, 49100588u, 49238826u, 49377454u, 49516472u, 49655882u, 49795683u,
+    49935879u, 50076469u, 50217455u, 50358838u, 50500619u, 50642799u, 50785380u, 50928362u,
+    51071746u, 51215534u, 51359727u, 51504326u, 51649332u, 51794747u, 51940571u, 52086805u,
+    52233451u, 52380510u, 52527982u, 52675871u, 52824175u, 52972897u, 53122038u, 53271598u,
+    53421580u, 53571984u, 53722811u, 53874063u, 54025741u, 54177846u, 54330379u, 54483342u,
+    54636735u, 54790560u, 54944818u, 55099511u, 55254639u, 55410203u, 55566206u, 55722648u,
+    55879530u, 56036854u, 56194621u, 56352833u, 56511489u, 56670593u, 56830144u, 56990144u,
+    57150595u, 57311498u, 57472853u, 57634663u, 57796929u, 57959651u, 58122832u, 58286472u,
+    58450572u, 58615135u, 58780161u, 58945651u, 59111608u, 59278031u, 59444924u, 59612286u,
+    59780119u, 59948425u, 60117205u, 60286460u, 60456191u, 60626400u, 60797089u, 60968258u,
+    61139909u, 61312043u, 61484662u, 61657767u, 61831359u, 62005440u, 62180011u, 62355073u,
+    62530629u, 62706679u, 62883224u, 63060266u, 63237807u, 63415848u, 63594390u, 63773434u,
+    63952983u, 64133037u, 64313598u, 64494668u, 64676247u, 64858337u, 65040941u, 65224058u,
+    65407691u, 65591840u, 65776509u, 65961697u, 66147406u, 66333639u, 66520396u, 66707678u,
+    66895488u, 67083826u, 67272695u, 67462096u, 67652030u, 67842498u, 68033503u, 68225045u,
+    68417127u, 68609750u, 68802915u, 68996624u, 69190878u, 69385679u, 69581028u, 69776928u,
+    69973379u, 70170383u, 70367942u, 70566057u, 70764729u, 70963961u, 71163754u, 71364110u,
+    71565030u, 71766515u, 71968567u, 72171189u, 72374381u, 72578144u, 72782482u, 72987395u,
+    73192885u, 73398953u, 73605602u, 73812832u, 74020646u, 74229045u, 74438030u, 74647604u,
+    74857768u, 75068524u, 75279873u, 75491817u, 75704358u, 75917497u, 76131236u, 76345577u,
+    76560522u, 76776071u, 76992228u, 77208993u, 77426368u, 77644356u, 77862957u, 78082173u,
+    78302007u, 78522460u, 78743533u, 78965229u, 79187549u, 79410494u, 79634068u, 79858271u,
+    80083105u, 80308572u, 80534674u, 80761413u, 80988790u, 81216807u, 81445466u, 81674768u,
+    81904717u, 82135313u, 82366558u, 82598454u, 82831003u, 83064206u, 83298066u, 83532585u,
+    83767764u, 84003605u, 84240110u, 84477281u, 84715120u, 84953628u, 85192807u, 85432661u,
+    85673189u, 85914395u, 86156279u, 86398845u, 86642094u, 86886027u, 87130647u, 87375956u,
+    87621956u, 87868648u, 88116035u, 88364118u, 88612900u, 88862382u, 89112566u, 89363455u,
+    89615050u, 89867354u, 90120368u, 90374094u, 90628534u, 90883691u, 91139567u, 91396162u,
+    91653481u, 91911523u, 92170292u, 92429790u, 92690018u, 92950979u, 93212675u, 93475107u,
+    93738278u, 94002190u, 94266846u, 94532246u, 94798393u, 95065290u, 95332938u, 95601340u,
+    95870498u, 96140413u, 96411088u, 96682525u, 96954727u, 97227695u, 97501431u, 97775938u,
+    98051218u, 98327273u, 98604105u, 98881716u, 99160109u, 99439286u, 99719249u, 100000000u,
+};
+
+const uint32_t clock_cache_adc_period[CLOCK_CACHE_ADC_ENTRIES] = {
+    125000000u, 124626122u, 124254473u, 124007937u, 123639960u, 123274162u, 122910521u, 122549020u,
+    122189638u, 121832359u, 121477162u, 121241513u, 120889749u, 120540019u, 120192308u, 119846596u,
+    119502868u, 119161106u, 118821293u, 118483412u, 118147448u, 117813384u, 117481203u, 117150890u,
+    116822430u, 116495806u, 116171004u, 115848007u, 115526802u, 115207373u, 114889706u, 114573786u,
+    114259598u, 113947129u, 113636364u, 113327289u, 112917796u, 112612613u, 112309075u, 112007168u,
+    111706881u, 111408200u, 111111111u, 110717449u, 110424028u, 110132159u, 109841828u, 109553024u,
+    109265734u, 108885017u, 108601216u, 108318891u, 108038029u, 107665805u, 107388316u, 107112254u,
+    106746371u, 106473595u, 106202209u, 105932203u, 105574324u, 105307498u, 105042017u, 104690117u,
+    104427736u, 104079933u, 103820598u, 103562552u, 103220479u, 102965404u, 102627258u, 102375102u,
+    102124183u, 101791531u, 101543461u, 101214575u, 100969305u, 100644122u, 100401606u, 100080064u,
+    99840256u, 99522293u, 99285147u, 98970705u, 98736177u, 98425197u, 98116170u, 97885670u,
+    97580016u, 97352025u, 97049689u, 96749226u, 96525097u, 96227868u, 96006144u, 95712098u,
+    95419847u, 95129376u, 94912680u, 94625284u, 94339623u, 94126506u, 93843844u, 93562874u,
+    93283582u, 93075205u, 92798812u, 92524056u, 92250923u, 91979397u, 91776799u, 91508053u,
+    91240876u, 90975255u, 90711176u, 90448625u, 90187590u, 89992801u, 89734386u, 89477452u,
+    89221984u, 88967972u, 88715401u, 88464260u, 88214538u, 87966221u, 87719298u, 87473758u,
+    87229588u, 86986778u, 86745316u, 86505190u, 86266391u, 86028906u, 85733882u, 85499316u,
+    85266030u, 85034014u, 84803256u, 84573748u, 84345479u, 84118439u, 83836351u, 83612040u,
+    83388926u, 83166999u, 82891247u, 82671958u, 82453826u, 82236842u, 81967213u, 81752780u,
+    81539465u, 81327261u, 81063554u, 80853816u, 80593166u, 80385852u, 80179602u, 79923274u,
+    79719388u, 79516539u, 79264426u, 79063884u, 78814628u, 78616352u, 78369906u, 78173859u,
+    77930175u, 77736318u, 77495350u, 77303649u, 77065351u, 76875769u, 76640098u, 76405868u,
+    76219512u, 75987842u, 75803517u, 75574365u, 75346594u, 75165364u, 74940048u, 74716079u,
+    74493445u, 74316290u, 74096028u, 73877069u, 73702830u, 73486185u, 73270809u, 73056692u,
+    72843823u, 72674419u, 72463768u, 72254335u, 72046110u, 71839080u, 71633238u, 71428571u,
+    71225071u, 71022727u, 70821530u, 70621469u, 70422535u, 70224719u, 70028011u, 69832402u,
+    69637883u, 69444444u, 69252078u, 69060773u, 68870523u, 68681319u, 68493151u, 68306011u,
+    68119891u, 67897882u, 67713976u, 67531064u, 67349138u, 67168189u, 66952330u, 66773504u,
+    66595631u, 66418704u, 66207627u, 66032752u, 65858799u, 65651261u, 65479309u, 65308255u,
+    65104167u, 64935065u, 64733299u, 64566116u, 64366632u, 64201335u, 64004096u, 63840654u,
+    63645621u, 63484002u, 63291139u, 63131313u, 62940584u, 62782521u, 62593891u, 62406390u,
+    62250996u, 62065541u, 61881188u, 61728395u, 61546036u, 61364752u, 61214496u, 61035156u,
+    60856865u, 60679612u, 60532688u, 60357315u, 60182956u, 60009602u, 59837243u, 59665871u,
+    59495478u, 59326056u, 59185606u, 59017941u, 58851224u, 58685446u, 58520599u, 58356676u,
+    58193669u, 58031569u, 57843591u, 57683433u, 57524160u, 57365764u, 57208238u, 57051575u,
+    56895767u, 56740808u, 56561086u, 56407942u, 56255626u, 56104129u, 55928412u, 55778670u,
+    55629729u, 55456965u, 55309735u, 55163283u, 54993401u, 54848618u, 54704595u, 54537522u,
+    54395126u, 54229935u, 54089139u, 53925798u, 53786575u, 53625054u, 53487377u, 53327645u,
+    53168864u, 53033517u, 52876481u, 52720371u, 52587295u, 52432886u, 52279381u, 52148519u,
+    51996672u, 51845707u, 51695616u, 51567657u, 51419169u, 51271534u, 51124744u, 50978793u,
+    50833672u, 50689376u, 50545896u, 50403226u, 50261359u, 50120289u, 49980008u, 49840510u,
+    49701789u, 49563838u, 49426651u, 49290221u, 49154542u, 49019608u, 48885413u, 48732943u,
+    48600311u, 48468399u, 48337200u, 48188126u, 48058439u, 47929448u, 47782875u, 47655356u,
+    47528517u, 47384382u, 47258979u, 47116472u, 46992481u, 46851574u, 46728972u, 46589638u,
+    46468401u, 46330615u, 46210721u, 46074456u, 45938993u, 45821114u, 45687135u, 45553936u,
+    45438023u, 45306270u, 45175280u, 45045045u, 44915559u, 44802867u, 44674768u, 44547398u,
+    44420753u, 44294826u, 44169611u, 44045102u, 43921293u, 43798178u, 43675751u, 43554007u,
+    43432940u, 43312543u, 43192813u, 43073742u, 42940570u, 42822885u, 42705842u, 42589438u,
+    42459239u, 42344173u, 42229730u, 42115903u, 41988579u, 41876047u, 41750167u, 41638907u,
+    41528239u, 41404439u, 41295012u, 41172596u, 41050903u, 40943334u, 40822992u, 40716612u,
+    40597597u, 40479275u, 40374677u, 40257649u, 40141297u, 40025616u, 39923347u, 39808917u,
+    39695141u, 39582014u, 39469530u, 39357683u, 39246468u, 39135880u, 39025913u, 38916563u,
+    38807824u, 38699690u, 38592158u, 38485222u, 38378876u, 38273117u, 38167939u, 38051750u,
+    37947784u, 37844384u, 37741546u, 37627935u, 37526268u, 37425150u, 37313433u, 37213456u,
+    37102998u, 37004144u, 36894923u, 36797174u, 36689169u, 36592506u, 36485698u, 36379511u,
+    36284470u, 36179450u, 36075036u, 35971223u, 35878301u, 35775615u, 35673516u, 35571998u,
+    35471056u, 35370685u, 35270880u, 35171638u, 35072952u, 34974818u, 34877232u, 34780189u,
+    34683685u, 34587714u, 34492274u, 34397358u, 34293553u, 34199726u, 34106412u, 34004353u,
+    33912100u, 33820346u, 33719989u, 33629271u, 33530043u, 33440342u, 33342225u, 33253525u,
+    33156499u, 33068783u, 32972830u, 32877433u, 32791186u, 32696835u, 32603026u, 32509753u,
+    32425422u, 32333161u, 32241424u, 32150206u, 32059502u, 31969309u, 31879623u, 31790437u,
+    31701750u, 31613556u, 31525851u, 31430727u, 31344032u, 31257814u, 31172070u, 31079065u,
+    30994297u, 30909990u, 30818540u, 30735186u, 30644766u, 30562347u, 30480371u, 30391442u,
+    30303030u, 30222437u, 30135005u, 30048077u, 29968832u, 29882859u, 29797378u, 29712384u,
+    29634898u, 29550827u, 29467232u, 29384109u, 29301453u, 29219261u, 29137529u, 29056253u,
+    28975429u, 28888375u, 28808481u, 28729028u, 28650011u, 28571429u, 28486782u, 28409091u,
+    28325402u, 28248588u, 28172188u, 28089888u, 28014343u, 27932961u, 27852050u, 27777778u,
+    27697762u, 27618206u, 27545174u, 27466491u, 27388256u, 27310465u, 27233115u, 27156202u,
+    27079723u, 27003672u, 26928048u, 26852846u, 26778063u, 26703696u, 26629740u, 26556193u,
+    26477441u, 26404732u, 26332420u, 26254988u, 26183494u, 26112388u, 26036242u, 25965933u,
+    25890638u, 25815779u, 25746653u, 25672623u, 25599017u, 25531046u, 25458248u, 25385865u,
+    25313892u, 25242326u, 25171164u, 25100402u, 25030036u, 24960064u, 24890482u, 24821287u,
+    24752475u, 24684044u, 24611144u, 24543491u, 24476209u, 24404529u, 24338006u, 24271845u,
+    24201355u, 24135934u, 24066230u, 23996928u, 23932606u, 23864070u, 23795926u, 23728170u,
+    23665278u, 23598263u, 23531627u, 23465365u, 23399476u, 23333956u, 23268801u, 23204010u,
+    23135295u, 23071244u, 23007546u, 22944200u, 22877013u, 22814382u, 22752093u, 22686025u,
+    22624434u, 22559105u, 22494152u, 22433597u, 22369363u, 22305496u, 22245951u, 22182786u,
+    22119979u, 22057526u, 21995425u, 21933673u, 21872266u, 21811202u, 21750479u, 21690092u,
+    21626298u, 21566598u, 21507226u, 21444502u, 21385800u, 21323780u, 21265737u, 21204411u,
+    21147014u, 21086370u, 21029610u, 20969636u, 20910003u, 20850709u, 20791750u, 20733123u,
+    20674826u, 20616856u, 20559211u, 20501886u, 20444881u, 20388191u, 20331815u, 20272462u,
+    20216723u, 20158039u, 20102927u, 20044901u, 19990405u, 19933025u, 19879135u, 19822391u,
+    19765971u, 19709871u, 19657179u, 19601694u, 19546521u, 19491658u, 19437102u, 19382850u,
+    19325912u, 19272279u, 19218942u, 19165900u, 19110228u, 19057783u, 19002736u, 18950879u,
+    18896447u, 18845168u, 18791341u, 18737820u, 18684604u, 18634466u, 18581834u, 18529499u,
+    18477458u, 18425708u, 18374247u, 18320387u, 18269512u, 18218919u, 18168605u, 18115942u,
+    18066195u, 18014123u, 17964932u, 17913442u, 17864799u, 17813881u, 17763251u, 17712909u,
+    17665348u, 17615558u, 17566048u, 17516816u, 17465418u, 17416748u, 17368348u, 17320216u,
+    17272350u, 17222375u, 17175048u, 17125634u, 17078836u, 17029973u, 16981388u, 16935375u,
+    16887328u, 16839553u, 16792047u, 16744809u, 16697836u, 16651126u, 16604676u, 16558485u,
+    16512550u, 16464700u, 16419283u, 16371971u, 16327064u, 16280281u, 16235875u, 16189613u,
+    16143614u, 16099948u, 16054457u, 16009221u, 15964240u, 15919511u, 15875032u, 15828796u,
+    15784821u, 15741091u, 15697601u, 15652392u, 15609391u, 15564687u, 15522166u, 15477959u,
+    15434004u, 15390298u, 15346839u, 15305498u, 15262515u, 15217921u, 15175428u, 15133172u,
+    15091151u, 15049362u, 15006002u, 14964683u, 14921810u, 14880952u, 14838557u, 14796402u,
+    14754485u, 14714538u, 14673084u, 14631862u, 14590872u, 14550111u, 14507892u, 14467593u,
+    14427516u, 14386005u, 14346379u, 14305333u, 14266149u, 14225560u, 14185202u, 14146673u,
+    14106760u, 14067072u, 14027606u, 13988362u, 13947780u, 13908980u, 13870395u, 13832024u,
+    13792342u, 13754401u, 13715163u, 13676149u, 13638843u, 13600261u, 13561896u, 13523748u,
+    13485813u, 13448090u, 13410578u, 13371844u, 13334756u, 13297872u, 13259786u, 13223315u,
+    13185654u, 13148207u, 13112347u, 13075314u, 13038490u, 13001872u, 12965460u, 12929251u,
+    12893244u, 12856114u, 12820513u, 12783800u, 12748598u, 12712295u, 12677485u, 12641586u,
+    12605889u, 12570394u, 12535098u, 12500000u, 12465098u, 12430390u, 12394646u, 12360328u,
+    12324985u, 12291052u, 12256104u, 12222548u, 12187988u, 12153622u, 12119449u, 12085468u,
+    12051678u, 12018075u, 11983511u, 11950287u, 11916111u, 11883259u, 11849464u, 11816979u,
+    11783560u, 11750329u, 11717285u, 11684427u, 11651752u, 11619260u, 11585875u, 11553748u,
+    11521799u, 11488971u, 11456328u, 11424915u, 11392636u, 11360538u, 11328621u, 11296882u,
+    11265321u, 11232926u, 11201721u, 11170688u, 11138834u, 11108149u, 11076650u, 11045330u,
+    11014186u, 10983218u, 10952423u, 10921800u, 10891348u, 10861065u, 10830012u, 10800069u,
+    10769363u, 10739754u, 10709390u, 10679197u, 10649174u, 10619319u, 10589631u, 10559216u,
+    10529863u, 10500672u, 10470766u, 10441901u, 10412328u, 10382922u, 10353682u, 10324606u,
+    10295692u, 10266940u, 10238349u, 10209082u, 10180811u, 10151872u, 10123917u, 10095300u,
+    10066844u, 10038548u, 10010411u, 9982431u, 9954607u, 9926149u, 9898638u, 9870499u,
+    9843295u, 9815469u, 9787800u, 9760287u, 9732928u, 9705722u, 9678668u, 9651019u,
+    9624269u, 9596929u, 9569744u, 9543442u, 9516559u, 9489827u, 9463245u, 9436811u,
+    9409816u, 9383680u, 9356988u, 9331144u, 9304749u, 9278504u, 9252406u, 9226454u,
+    9200648u, 9174985u, 9148796u, 9123422u, 9097525u, 9072434u, 9046826u, 9021363u,
+    8996042u, 8970863u, 8945824u, 8920288u, 8895531u, 8870281u, 8845800u, 8820831u,
+    8796003u, 8771314u, 8746764u, 8722350u, 8697467u, 8673328u, 8648723u, 8624853u,
+    8600523u, 8576329u, 8552271u, 8528348u, 8503980u, 8480326u, 8456231u, 8432841u,
+    8409014u, 8385322u, 8361763u, 8338336u, 8315040u, 8291874u, 8268289u, 8245383u,
+    8222061u, 8198872u, 8175813u, 8152883u, 8130081u, 8107407u, 8084336u, 8061916u,
+    8039102u, 8016418u, 7994372u, 7971430u, 7949126u, 7926945u, 7904888u, 7882457u,
+    7860646u, 7838465u, 7816408u, 7794475u, 7772665u, 7750496u, 7728931u, 7707010u,
+    7685686u, 7664010u, 7642455u, 7621022u, 7599708u, 7578513u, 7556980u, 7536022u,
+    7514729u, 7493556u, 7472501u, 7451565u, 7430745u, 7409603u, 7389017u, 7368111u,
+    7347323u, 7327081u, 7306523u, 7285656u, 7265330u, 7245117u, 7224598u, 7204196u,
+    7183908u, 7163734u, 7143674u, 7123725u, 7103887u, 7083758u, 7063743u, 7044238u,
+    7024445u, 7004763u, 6984801u, 6965340u, 6945602u, 6926359u, 6906841u, 6887432u,
+    6868132u, 6848940u, 6829482u, 6810505u, 6791264u, 6772131u, 6753106u, 6734188u,
+    6715376u, 6696668u, 6677707u, 6658854u, 6640106u, 6621464u, 6602926u, 6584492u,
+    6566161u, 6547588u, 6529120u, 6510756u, 6492495u, 6474336u, 6456278u, 6437989u,
+    6419804u, 6402049u, 6384065u, 6366183u, 6348078u, 6330396u, 6312494u, 6295009u,
+    6277306u, 6259703u, 6241886u, 6224480u, 6206862u, 6189651u, 6172230u, 6154907u,
+    6137680u, 6120251u, 6103218u, 6085983u, 6068845u, 6051803u, 6034857u, 6018006u,
+    6000960u, 5984297u, 5967442u, 5950681u, 5934014u, 5917440u, 5900680u, 5884014u,
+    5867718u, 5851238u, 5834578u, 5818283u, 5802079u, 5785698u, 5769408u, 5753210u,
+    5737103u, 5721086u, 5704897u, 5688800u, 5673051u, 5657133u, 5641049u, 5625309u,
+    5609406u, 5593842u, 5578116u, 5562478u, 5546681u, 5531218u, 5515598u, 5500308u,
+    5484862u, 5469263u, 5453990u, 5438566u, 5423464u, 5408212u, 5393045u, 5377963u,
+    5362735u, 5347594u, 5332765u, 5317791u, 5302902u, 5287872u, 5273149u, 5258287u,
+    5243509u, 5228813u, 5214199u, 5199451u, 5184786u, 5170203u, 5155702u, 5141282u,
+    5126943u, 5112474u, 5098087u, 5083781u, 5069554u, 5055407u, 5041136u, 5026944u,
+    5012833u, 4998800u, 4984647u, 4970772u, 4956777u, 4942861u, 4929022u, 4915068u,
+    4901384u, 4887586u, 4873864u, 4860220u, 4846464u, 4832972u, 4819370u, 4805844u,
+    4792394u, 4778835u, 4765536u, 4752129u, 4738797u, 4725541u, 4712180u, 4698895u,
+    4685684u, 4672548u, 4659485u, 4646495u, 4633405u, 4620389u, 4607446u, 4594406u,
+    4581608u, 4568713u, 4555892u, 4543142u, 4530299u, 4517528u, 4504992u, 4492202u,
+    4479644u, 4467157u, 4454581u, 4442075u, 4429483u, 4417117u, 4404665u, 4392284u,
+    4379971u, 4367728u, 4355401u, 4343294u, 4331104u, 4318834u, 4306781u, 4294647u,
+    4282582u, 4270584u, 4258654u, 4246645u, 4234704u, 4222830u, 4211023u, 4199140u,
+    4187324u, 4175575u, 4163891u, 4152134u, 4140581u, 4128956u, 4117260u, 4105764u,
+    4094199u, 4082699u, 4071263u, 4059892u, 4048452u, 4037077u, 4025765u, 4014388u,
+    4003203u, 3991952u, 3980765u, 3969514u, 3958452u, 3947327u, 3936264u, 3925140u,
+    3914201u, 3903201u, 3892141u, 3881264u, 3870329u, 3859454u, 3848641u, 3837888u,
+    3827077u, 3816328u, 3805638u, 3794894u, 3784324u, 3773699u, 3763020u, 3752514u,
+    3741955u, 3731455u, 3721013u, 3710520u, 3700086u, 3689710u, 3679392u, 3669025u,
+    3658715u, 3648463u, 3638269u, 3628026u, 3617840u, 3607712u, 3597536u, 3587418u,
+    3577357u, 3567352u, 3557301u, 3547307u, 3537369u, 3527486u, 3517560u, 3507689u,
+    3497775u, 3488015u, 3478212u, 3468465u, 3458676u, 3448942u, 3439263u, 3429638u,
+    3419973u, 3410455u, 3400805u, 3391302u, 3381760u, 3372272u, 3362837u, 3353364u,
+    3343945u, 3334578u, 3325176u, 3315826u, 3306528u, 3297283u, 3288003u, 3278775u,
+    3269598u, 3260388u, 3251229u, 3242122u, 3232982u, 3223976u, 3214855u, 3205868u,
+    3196849u, 3187881u, 3178963u, 3170014u, 3161116u, 3152267u, 3143389u, 3134560u,
+    3125781u, 3116974u, 3108216u, 3099507u, 3090846u, 3082158u, 3073443u, 3064852u,
+    3056235u, 3047665u, 3039144u, 3030597u, 3022098u, 3013573u, 3005097u, 2996668u,
+    2988286u, 2979880u, 2971521u, 2963209u, 2954873u, 2946584u, 2938273u, 2930008u,
+    2921790u, 2913617u, 2905423u, 2897274u, 2889171u, 2881047u, 2872969u, 2864870u,
+    2856816u, 2848808u, 2840780u, 2832861u, 2824859u, 2816965u, 2809052u, 2801183u,
+    2793296u, 2785453u, 2777654u, 2769838u, 2762065u, 2754275u, 2746589u, 2738886u,
+    2731166u, 2723490u, 2715856u, 2708207u, 2700601u, 2693037u, 2685458u, 2677921u,
+    2670427u, 2662917u, 2655450u, 2647968u, 2640585u, 2633131u, 2625775u, 2618404u,
+    2611021u, 2603678u, 2596378u, 2589117u, 2581844u, 2574559u, 2567368u, 2560164u,
+    2552948u, 2545773u, 2538638u, 2531543u, 2524437u, 2517319u, 2510242u, 2503204u,
+    2496206u, 2489197u, 2482178u, 2475199u, 2468258u, 2461357u, 2454445u, 2447525u,
+    2440644u, 2433801u, 2426996u, 2420182u, 2413360u, 2406577u, 2399831u, 2393123u,
+    2386361u, 2379683u, 2372997u, 2366349u, 2359693u, 2353074u, 2346448u, 2339860u,
+    2333308u, 2326750u, 2320229u, 2313701u, 2307210u, 2300755u, 2294294u, 2287827u,
+    2281397u, 2275002u, 2268603u, 2262239u, 2255910u, 2249577u, 2243239u, 2236936u,
+    2230669u, 2224397u, 2218161u, 2211959u, 2205714u, 2199542u, 2193367u, 2187188u,
+    2181082u, 2174934u, 2168821u, 2162742u, 2156660u, 2150612u, 2144597u, 2138543u,
+    2132560u, 2126574u, 2120585u, 2114630u, 2108708u, 2102784u, 2096893u, 2091000u,
+    2085140u, 2079279u, 2073450u, 2067619u, 2061822u, 2056023u, 2050256u, 2044488u,
+    2038753u, 2033016u, 2027312u, 2021640u, 2015966u, 2010293u, 2004651u, 1999008u,
+    1993398u, 1987819u, 1982239u, 1976660u, 1971111u, 1965594u, 1960077u, 1954560u,
+    1949075u, 1943589u, 1938135u, 1932711u, 1927287u, 1921865u, 1916472u, 1911081u,
+    1905720u, 1900360u, 1895030u, 1889730u, 1884403u, 1879134u, 1873838u, 1868600u,
+    1863336u, 1858101u, 1852895u, 1847691u, 1842516u, 1837317u, 1832173u, 1827031u,
+    1821892u, 1816781u, 1811673u, 1806593u, 1801516u, 1796467u, 1791421u, 1786403u,
+    1781388u, 1776376u, 1771391u, 1766410u, 1761457u, 1756506u, 1751583u, 1746664u,
+    1741748u, 1736859u, 1731998u, 1727140u, 1722285u, 1717458u, 1712634u, 1707814u,
+    1703020u, 1698231u, 1693469u, 1688710u, 1683978u, 1679250u, 1674526u, 1669828u,
+    1665135u, 1660468u, 1655805u, 1651168u, 1646535u, 1641907u, 1637283u, 1632685u,
+    1628113u, 1623545u, 1618982u, 1614445u, 1609912u, 1605384u, 1600881u, 1596383u,
+    1591911u, 1587423u, 1582980u, 1578522u, 1574109u, 1569681u, 1565278u, 1560881u,
+    1556488u, 1552120u, 1547777u, 1543419u, 1539087u, 1534778u, 1530456u, 1526158u,
+    1521885u, 1517598u, 1513354u, 1509097u, 1504864u, 1500636u, 1496415u, 1492217u,
+    1488024u, 1483856u, 1479693u, 1475536u, 1471385u, 1467257u, 1463135u, 1459036u,
+    1454943u, 1450857u, 1446776u, 1442718u, 1438667u, 1434621u, 1430599u, 1426582u,
+    1422572u, 1418585u, 1414603u, 1410628u, 1406676u, 1402713u, 1398789u, 1394856u,
+    1390944u, 1387040u, 1383141u, 1379249u, 1375380u, 1371516u, 1367675u, 1363840u,
+    1359997u, 1356190u, 1352375u, 1348581u, 1344795u, 1341015u, 1337256u, 1333504u,
+    1329759u, 1326021u, 1322304u, 1318593u, 1314890u, 1311193u, 1307518u, 1303849u,
+    1300187u, 1296533u, 1292885u, 1289258u, 1285638u, 1282038u, 1278432u, 1274847u,
+    1271268u, 1267697u, 1264133u, 1260589u, 1257052u, 1253522u, 1250000u, 1246485u,
+    1242990u, 1239501u, 1236021u, 1232547u, 1229093u, 1225634u, 1222195u, 1218763u,
+    1215350u, 1211933u, 1208535u, 1205133u, 1201750u, 1198386u, 1195017u, 1191656u,
+    1188315u, 1184980u, 1181653u, 1178334u, 1175033u, 1171729u, 1168443u, 1165154u,
+    1161883u, 1158630u, 1155375u, 1152127u, 1148897u, 1145664u, 1142450u, 1139243u,
+    1136043u, 1132852u, 1129678u, 1126502u, 1123343u, 1120192u, 1117039u, 1113903u,
+    1110775u, 1107665u, 1104553u, 1101448u, 1098360u, 1095271u, 1092199u, 1089135u,
+    1086078u, 1083029u, 1079988u, 1076955u, 1073929u, 1070911u, 1067911u, 1064908u,
+    1061923u, 1058936u, 1055966u, 1053004u, 1050041u, 1047094u, 1044155u, 1041224u,
+    1038301u, 1035385u, 1032478u, 1029586u, 1026694u, 1023810u, 1020933u, 1018065u,
+    1015212u, 1012359u, 1009514u, 1006684u, 1003855u, 1001041u, 998227u, 995429u,
+    992631u, 989848u, 987065u, 984291u, 981532u, 978772u, 976029u, 973285u,
+    970557u, 967829u, 965109u, 962405u, 959700u, 957004u, 954322u, 951641u,
+    948968u, 946303u, 943645u, 940996u, 938354u, 935720u, 933093u, 930475u,
+    927864u, 925261u, 922659u, 920072u, 917485u, 914913u, 912342u, 909779u,
+    907224u, 904683u, 902143u, 899604u, 897080u, 894563u, 892054u, 889547u,
+    887047u, 884561u, 882077u, 879600u, 877131u, 874670u, 872211u, 869765u,
+    867321u, 864884u, 862456u, 860035u, 857621u, 855215u, 852812u, 850421u,
+    848033u, 845652u, 843278u, 840907u, 838549u, 836193u, 833845u, 831504u,
+    829171u, 826840u, 824522u, 822206u, 819898u, 817597u, 815299u, 813013u,
+    810730u, 808454u, 806181u, 803921u, 801662u, 799412u, 797168u, 794928u,
+    792700u, 790474u, 788256u, 786040u, 783832u, 781631u, 779438u, 777252u,
+    775069u, 772893u, 770720u, 768559u, 766401u, 764250u, 762102u, 759962u,
+    757828u, 755703u, 753580u, 751464u, 749356u, 747250u, 745152u, 743061u,
+    740973u, 738893u, 736820u, 734754u, 732691u, 730631u, 728583u, 726537u,
+    724495u, 722460u, 720432u, 718411u, 716394u, 714384u, 712377u, 710377u,
+    708384u, 706394u, 704412u, 702433u, 700461u, 698496u, 696534u, 694580u,
+    692628u, 690684u, 688743u, 686809u, 684883u, 682959u, 681043u, 679130u,
+    677224u, 675322u, 673426u, 671534u, 669649u, 667771u, 665896u, 664025u,
+    662160u, 660303u, 658449u, 656599u, 654755u, 652919u, 651086u, 649256u,
+    647434u, 645618u, 643806u, 641997u, 640195u, 638397u, 636605u, 634817u,
+    633036u, 631259u, 629485u, 627718u, 625955u, 624198u, 622445u, 620699u,
+    618956u, 617217u, 615485u, 613756u, 612034u, 610316u, 608601u, 606893u,
+    605189u, 603492u, 601798u, 600108u, 598421u, 596741u, 595068u, 593396u,
+    591730u, 590068u, 588413u, 586761u, 585113u, 583471u, 581831u, 580200u,
+    578570u, 576946u, 575326u, 573710u, 572101u, 570492u, 568893u, 567295u,
+    565703u, 564113u, 562531u, 560951u, 559377u, 557804u, 556240u, 554678u,
+    553119u, 551567u, 550019u, 548474u, 546936u, 545399u, 543868u, 542342u,
+    540819u, 539300u, 537787u, 536276u, 534771u, 533270u, 531772u, 530279u,
+    528789u, 527306u, 525826u, 524349u, 522877u, 521409u, 519945u, 518485u,
+    517029u, 515579u, 514130u, 512688u, 511247u, 509813u, 508382u, 506953u,
+    505531u, 504112u, 502696u, 501285u, 499878u, 498475u, 497075u, 495680u,
+    494288u, 492900u, 491516u, 490136u, 488760u, 487388u, 486020u, 484656u,
+    483294u, 481937u, 480584u, 479236u, 477889u, 476548u, 475209u, 473876u,
+    472545u, 471218u, 469897u, 468577u, 467262u, 465948u, 464641u, 463337u,
+    462035u, 460738u, 459446u, 458156u, 456870u, 455586u, 454308u, 453032u,
+    451759u, 450491u, 449227u, 447966u, 446708u, 445453u, 444203u, 442956u,
+    441712u, 440473u, 439236u, 438002u, 436773u, 435546u, 434323u, 433104u,
+    431888u, 430677u, 429466u, 428261u, 427058u, 425860u, 424665u, 423472u,
+    422283u, 421098u, 419915u, 418737u, 417560u, 416388u, 415219u, 414054u,
+    412891u, 411731u, 410576u, 409423u, 408274u, 407128u, 405985u, 404845u,
+    403708u, 402575u, 401444u, 400318u, 399194u, 398073u, 396955u, 395840u,
+    394729u, 393621u, 392516u, 391414u, 390315u, 389219u, 388126u, 387036u,
+    385950u, 384866u, 383786u, 382709u, 381634u, 380563u, 379494u, 378429u,
+    377366u, 376308u, 375250u, 374198u, 373147u, 372099u, 371054u, 370013u,
+    368974u, 367938u, 366905u, 365875u, 364847u, 363824u, 362802u, 361783u,
+    360768u, 359755u, 358745u, 357738u, 356733u, 355731u, 354733u, 353737u,
+    352744u, 351754u, 350766u, 349781u, 348800u, 347820u, 346844u, 345869u,
+    344899u, 343930u, 342965u, 342002u, 341042u, 340084u, 339129u, 338177u,
+    337228u, 336281u, 335337u, 334395u, 333457u, 332520u, 331587u, 330656u,
+    329727u, 328802u, 327879u, 326958u, 326040u, 325125u, 324212u, 323302u,
+    322394u, 321489u, 320587u, 319687u, 318789u, 317894u, 317001u, 316112u,
+    315224u, 314339u, 313457u, 312577u, 311699u, 310824u, 309951u, 309081u,
+    308214u, 307348u, 306485u, 305625u, 304767u, 303911u, 303057u, 302207u,
+    301359u, 300513u, 299669u, 298827u, 297989u, 297152u, 296317u, 295486u,
+    294656u, 293829u, 293004u, 292181u, 291361u, 290543u, 289727u, 288914u,
+    288103u, 287294u, 286487u, 285683u, 284881u, 284081u, 283284u, 282488u,
+    281695u, 280905u, 280116u, 279329u, 278545u, 277763u, 276983u, 276205u,
+    275430u, 274657u, 273886u, 273117u, 272350u, 271586u, 270823u, 270062u,
+    269304u, 268548u, 267794u, 267043u, 266293u, 265545u, 264800u, 264056u,
+    263315u, 262576u, 261838u, 261103u, 260370u, 259639u, 258910u, 258183u,
+    257459u, 256736u, 256015u, 255296u, 254579u, 253865u, 253152u, 252441u,
+    251732u, 251026u, 250321u, 249618u, 248917u, 248219u, 247522u, 246827u,
+    246134u, 245443u, 244754u, 244067u, 243381u, 242698u, 242017u, 241337u,
+    240660u, 239984u, 239310u, 238638u, 237968u, 237300u, 236634u, 235970u,
+    235307u, 234647u, 233988u, 233331u, 232676u, 232022u, 231371u, 230722u,
+    230074u, 229428u, 228784u, 228141u, 227501u, 226862u, 226226u, 225590u,
+    224957u, 224325u, 223696u, 223067u, 222441u, 221817u, 221194u, 220573u,
+    219954u, 219336u, 218720u, 218106u, 217494u, 216883u, 216275u, 215667u,
+    215062u, 214458u, 213856u, 213256u, 212657u, 212060u, 211464u, 210871u,
+    210279u, 209688u, 209100u, 208513u, 207927u, 207343u, 206761u, 206181u,
+    205602u, 205025u, 204449u, 203875u, 203303u, 202732u, 202163u, 201595u,
+    201029u, 200465u, 199902u, 199341u, 198781u, 198223u, 197667u, 197112u,
+    196558u, 196006u, 195456u, 194907u, 194360u, 193814u, 193270u, 192728u,
+    192187u, 191647u, 191109u, 190573u, 190037u, 189504u, 188972u, 188441u,
+    187912u, 187385u, 186859u, 186334u, 185811u, 185289u, 184769u, 184250u,
+    183733u, 183217u, 182703u, 182190u, 181678u, 181168u, 180660u, 180152u,
+    179647u, 179142u, 178639u, 178138u, 177638u, 177139u, 176642u, 176146u,
+    175651u, 175158u, 174666u, 174176u, 173687u, 173199u, 172713u, 172228u,
+    171745u, 171262u, 170782u, 170302u, 169824u, 169347u, 168872u, 168398u,
+    167925u, 167453u, 166983u, 166515u, 166047u, 165581u, 165116u, 164652u,
+    164190u, 163729u, 163270u, 162811u, 162354u, 161898u, 161444u, 160990u,
+    160538u, 160088u, 159638u, 159190u, 158743u, 158298u, 157853u, 157410u,
+    156968u, 156527u, 156088u, 155650u, 155213u, 154777u, 154342u, 153909u,
+    153477u, 153046u, 152616u, 152188u, 151761u, 151334u, 150910u, 150486u,
+    150063u, 149642u, 149222u, 148803u, 148385u, 147969u, 147553u, 147139u,
+    146726u, 146314u, 145903u, 145494u, 145085u, 144678u, 144272u, 143867u,
+    143463u, 143060u, 142658u, 142258u, 141858u, 141460u, 141063u, 140667u,
+    140272u, 139878u, 139485u, 139094u, 138703u, 138314u, 137926u, 137538u,
+    137152u, 136767u, 136383u, 136000u, 135619u, 135238u, 134858u, 134479u,
+    134102u, 133725u, 133350u, 132976u, 132602u, 132230u, 131859u, 131489u,
+    131119u, 130751u, 130384u, 130018u, 129653u, 129289u, 128926u, 128564u,
+    128203u, 127843u, 127484u, 127126u, 126770u, 126414u, 126059u, 125705u,
+    125352u, 125000u, 124649u, 124299u, 123950u, 123602u, 123255u, 122909u,
+    122564u, 122220u, 121877u, 121535u, 121193u, 120853u, 120514u, 120176u,
+    119838u, 119502u, 119166u, 118832u, 118498u, 118165u, 117834u, 117503u,
+    117173u, 116844u, 116516u, 116189u, 115863u, 115537u, 115213u, 114889u,
+    114567u, 114245u, 113924u, 113605u, 113286u, 112968u, 112650u, 112334u,
+    112019u, 111704u, 111391u, 111078u, 110766u, 110455u, 110145u, 109836u,
+    109527u, 109220u, 108913u, 108608u, 108303u, 107999u, 107695u, 107393u,
+    107092u, 106791u, 106491u, 106192u, 105894u, 105597u, 105300u, 105005u,
+    104710u, 104416u, 104123u, 103830u, 103539u, 103248u, 102958u, 102669u,
+    102381u, 102093u, 101807u, 101521u, 101236u, 100952u, 100668u, 100386u,
+    100104u, 99823u, 99543u, 99263u, 98984u, 98707u, 98429u, 98153u,
+    97878u, 97603u, 97329u, 97055u, 96783u, 96511u, 96240u, 95970u,
+    95701u, 95432u, 95164u, 94897u, 94630u, 94365u, 94100u, 93836u,
+    93572u, 93309u, 93048u, 92786u, 92526u, 92266u, 92007u, 91749u,
+    91491u, 91234u, 90978u, 90723u, 90468u, 90214u, 89961u, 89708u,
+    89456u, 89205u, 88955u, 88705u, 88456u, 88208u, 87960u, 87713u,
+    87467u, 87221u, 86976u, 86732u, 86489u, 86246u, 86004u, 85762u,
+    85521u, 85281u, 85042u, 84803u, 84565u, 84328u, 84091u, 83855u,
+    83619u, 83385u, 83151u, 82917u, 82684u, 82452u, 82221u, 81990u,
+    81760u, 81530u, 81301u, 81073u, 80845u, 80618u, 80392u, 80166u,
+    79941u, 79717u, 79493u, 79270u, 79047u, 78825u, 78604u, 78383u,
+    78163u, 77944u, 77725u, 77507u, 77289u, 77072u, 76856u, 76640u,
+    76425u, 76210u, 75996u, 75783u, 75570u, 75358u, 75147u, 74936u,
+    74725u, 74515u, 74306u, 74098u, 73890u, 73682u, 73475u, 73269u,
+    73063u, 72858u, 72654u, 72450u, 72246u, 72043u, 71841u, 71639u,
+    71438u, 71238u, 71038u, 70838u, 70639u, 70441u, 70243u, 70046u,
+    69849u, 69653u, 69458u, 69263u, 69068u, 68874u, 68681u, 68488u,
+    68296u, 68104u, 67913u, 67722u, 67532u, 67343u, 67154u, 66965u,
+    66777u, 66589u, 66403u, 66216u, 66030u, 65845u, 65660u, 65476u,
+    65292u, 65109u, 64926u, 64743u, 64562u, 64380u, 64200u, 64019u,
+    63840u, 63660u, 63482u, 63304u, 63126u, 62949u, 62772u, 62596u,
+    62420u, 62245u, 62070u, 61896u, 61722u, 61549u, 61376u, 61203u,
+    61032u, 60860u, 60689u, 60519u, 60349u, 60180u, 60011u, 59842u,
+    59674u, 59507u, 59340u, 59173u, 59007u, 58841u, 58676u, 58511u,
+    58347u, 58183u, 58020u, 57857u, 57695u, 57533u, 57371u, 57210u,
+    57049u, 56889u, 56729u, 56570u, 56411u, 56253u, 56095u, 55938u,
+    55781u, 55624u, 55468u, 55312u, 55157u, 55002u, 54847u, 54693u,
+    54540u, 54387u, 54234u, 54082u, 53930u, 53779u, 53628u, 53477u,
+    53327u, 53177u, 53028u, 52879u, 52731u, 52583u, 52435u, 52288u,
+    52141u, 51995u, 51849u, 51703u, 51558u, 51413u, 51269u, 51125u,
+    50981u, 50838u, 50695u, 50553u, 50411u, 50270u, 50128u, 49988u,
+    49847u, 49707u, 49568u, 49429u, 49290u, 49152u, 49014u, 48876u,
+    48739u, 48602u, 48465u, 48329u, 48194u, 48058u, 47924u, 47789u,
+    47655u, 47521u, 47388u, 47255u, 47122u, 46990u, 46858u, 46726u,
+    46595u, 46464u, 46334u, 46204u, 46074u, 45944u, 45816u, 45687u,
+    45559u, 45431u, 45303u, 45176u, 45049u, 44923u, 44797u, 44671u,
+    44545u, 44420u, 44296u, 44171u, 44047u, 43924u, 43800u, 43677u,
+    43555u, 43432u, 43310u, 43189u, 43068u, 42947u, 42826u, 42706u,
+    42586u, 42466u, 42347u, 42228u, 42110u, 41992u, 41874u, 41756u,
+    41639u, 41522u, 41405u, 41289u, 41173u, 41058u, 40942u, 40827u,
+    40713u, 40598u, 40484u, 40371u, 40257u, 40144u, 40032u, 39919u,
+    39807u, 39696u, 39584u, 39473u, 39362u, 39252u, 39141u, 39032u,
+    38922u, 38813u, 38704u, 38595u, 38487u, 38379u, 38271u, 38163u,
+    38056u, 37949u, 37843u, 37737u, 37631u, 37525u, 37420u, 37315u,
+    37210u, 37105u, 37001u, 36897u, 36794u, 36690u, 36587u, 36485u,
+    36382u, 36280u, 36178u, 36077u, 35975u, 35874u, 35774u, 35673u,
+    35573u, 35473u, 35374u, 35274u, 35175u, 35077u, 34978u, 34880u,
+    34782u, 34684u, 34587u, 34490u, 34393u, 34296u, 34200u, 34104u,
+    34008u, 33913u, 33818u, 33723u, 33628u, 33534u, 33440u, 33346u,
+    33252u, 33159u, 33066u, 32973u, 32880u, 32788u, 32696u, 32604u,
+    32513u, 32421u, 32330u, 32239u, 32149u, 32059u, 31969u, 31879u,
+    31789u, 31700u, 31611u, 31522u, 31434u, 31346u, 31258u, 31170u,
+    31082u, 30995u, 30908u, 30821u, 30735u, 30649u, 30562u, 30477u,
+    30391u, 30306u, 30221u, 30136u, 30051u, 29967u, 29883u, 29799u,
+    29715u, 29632u, 29549u, 29466u, 29383u, 29300u, 29218u, 29136u,
+    29054u, 28973u, 28891u, 28810u, 28729u, 28649u, 28568u, 28488u,
+    28408u, 28328u, 28249u, 28170u, 28090u, 28012u, 27933u, 27855u,
+    27776u, 27698u, 27621u, 27543u, 27466u, 27389u, 27312u, 27235u,
+    27159u, 27082u, 27006u, 26930u, 26855u, 26779u, 26704u, 26629u,
+    26555u, 26480u, 26406u, 26331u, 26258u, 26184u, 26110u, 26037u,
+    25964u, 25891u, 25818u, 25746u, 25674u, 25601u, 25530u, 25458u,
+    25386u, 25315u, 25244u, 25173u, 25103u, 25032u, 24962u, 24892u,
+    24822u, 24752u, 24683u, 24613u, 24544u, 24475u, 24407u, 24338u,
+    24270u, 24202u, 24134u, 24066u, 23998u, 23931u, 23864u, 23797u,
+    23730u, 23663u, 23597u, 23531u, 23465u, 23399u, 23333u, 23268u,
+    23202u, 23137u, 23072u, 23007u, 22943u, 22878u, 22814u, 22750u,
+    22686u, 22623u, 22559u, 22496u, 22433u, 22370u, 22307u, 22244u,
+    22182u, 22119u, 22057u, 21995u, 21934u, 21872u, 21811u, 21749u,
+    21688u, 21627u, 21567u, 21506u, 21446u, 21386u, 21326u, 21266u,
+    21206u, 21146u, 21087u, 21028u, 20969u, 20910u, 20851u, 20793u,
+    20734u, 20676u, 20618u, 20560u, 20502u, 20445u, 20388u, 20330u,
+    20273u, 20216u, 20160u, 20103u, 20046u, 19990u, 19934u, 19878u,
+    19822u, 19767u, 19711u, 19656u, 19601u, 19546u, 19491u, 19436u,
+    19381u, 19327u, 19273u, 19219u, 19165u, 19111u, 19057u, 19004u,
+    18950u, 18897u, 18844u, 18791u, 18738u, 18686u, 18633u, 18581u,
+    18529u, 18477u, 18425u, 18373u, 18322u, 18270u, 18219u, 18168u,
+    18117u, 18066u, 18015u, 17965u, 17914u, 17864u, 17814u, 17764u,
+    17714u, 17664u, 17615u, 17565u, 17516u, 17467u, 17418u, 17369u,
+    17320u, 17271u, 17223u, 17174u, 17126u, 17078u, 17030u, 16982u,
+    16935u, 16887u, 16840u, 16792u, 16745u, 16698u, 16651u, 16605u,
+    16558u, 16512u, 16465u, 16419u, 16373u, 16327u, 16281u, 16235u,
+    16190u, 16144u, 16099u, 16054u, 16009u, 15964u, 15919u, 15874u,
+    15830u, 15785u, 15741u, 15697u, 15653u, 15609u, 15565u, 15521u,
+    15478u, 15434u, 15391u, 15348u, 15305u, 15262u, 15219u, 15176u,
+    15133u, 15091u, 15049u, 15006u, 14964u, 14922u, 14880u, 14839u,
+    14797u, 14755u, 14714u, 14673u, 14631u, 14590u, 14549u, 14509u,
+    14468u, 14427u, 14387u, 14346u, 14306u, 14266u, 14226u, 14186u,
+    14146u, 14106u, 14067u, 14027u, 13988u, 13949u, 13909u, 13870u,
+    13831u, 13793u, 13754u, 13715u, 13677u, 13638u, 13600u, 13562u,
+    13524u, 13486u, 13448u, 13410u, 13373u, 13335u, 13298u, 13260u,
+    13223u, 13186u, 13149u, 13112u, 13075u, 13038u, 13002u, 12965u,
+    12929u, 12893u, 12856u, 12820u, 12784u, 12748u, 12713u, 12677u,
+    12641u, 12606u, 12570u, 12535u, 12500u, 12465u, 12430u, 12395u,
+    12360u, 12326u, 12291u, 12256u, 12222u, 12188u, 12153u, 12119u,
+    12085u, 12051u, 12018u, 11984u, 11950u, 11917u, 11883u, 11850u,
+    11817u, 11783u, 11750u, 11717u, 11684u, 11652u, 11619u, 11586u,
+    11554u, 11521u, 11489u, 11457u, 11425u, 11392u, 11360u, 11329u,
+    11297u, 11265u, 11233u, 11202u, 11170u, 11139u, 11108u, 11077u,
+    11046u, 11015u, 10984u, 10953u, 10922u, 10891u, 10861u, 10830u,
+    10800u, 10770u, 10739u, 10709u, 10679u, 10649u, 10619u, 10589u,
+    10560u, 10530u, 10500u, 10471u, 10442u, 10412u, 10383u, 10354u,
+    10325u, 10296u, 10267u, 10238u, 10209u, 10181u, 10152u, 10124u,
+    10095u, 10067u, 10039u, 10010u, 9982u, 9954u, 9926u, 9898u,
+    9871u, 9843u, 9815u, 9788u, 9760u, 9733u, 9706u, 9678u,
+    9651u, 9624u, 9597u, 9570u, 9543u, 9516u, 9490u, 9463u,
+    9436u, 9410u, 9384u, 9357u, 9331u, 9305u, 9279u, 9253u,
+    9227u, 9201u, 9175u, 9149u, 9123u, 9098u, 9072u, 9047u,
+    9021u, 8996u, 8971u, 8946u, 8921u, 8895u, 8870u, 8846u,
+    8821u, 8796u, 8771u, 8747u, 8722u, 8698u, 8673u, 8649u,
+    8625u, 8600u, 8576u, 8552u, 8528u, 8504u, 8480u, 8457u,
+    8433u, 8409u, 8385u, 8362u, 8338u, 8315u, 8292u, 8268u,
+    8245u, 8222u, 8199u, 8176u, 8153u, 8130u, 8107u, 8085u,
+    8062u, 8039u, 8017u, 7994u, 7972u, 7949u, 7927u, 7905u,
+    7883u, 7860u, 7838u, 7816u, 7794u, 7773u, 7751u, 7729u,
+    7707u, 7686u, 7664u, 7642u, 7621u, 7600u, 7578u, 7557u,
+    7536u, 7515u, 7494u, 7473u, 7452u, 7431u, 7410u, 7389u,
+    7368u, 7348u, 7327u, 7306u, 7286u, 7265u, 7245u, 7225u,
+    7204u, 7184u, 7164u, 7144u, 7124u, 7104u, 7084u, 7064u,
+    7044u, 7024u, 7005u, 6985u, 6965u, 6946u, 6926u, 6907u,
+    6887u, 6868u, 6849u, 6830u, 6810u, 6791u, 6772u, 6753u,
+    6734u, 6715u, 6696u, 6678u, 6659u, 6640u, 6622u, 6603u,
+    6584u, 6566u, 6548u, 6529u, 6511u, 6493u, 6474u, 6456u,
+    6438u, 6420u, 6402u, 6384u, 6366u, 6348u, 6330u, 6313u,
+    6295u, 6277u, 6260u, 6242u, 6224u, 6207u, 6190u, 6172u,
+    6155u, 6138u, 6120u, 6103u, 6086u, 6069u, 6052u, 6035u,
+    6018u, 6001u, 5984u, 5967u, 5951u, 5934u, 5917u, 5901u,
+    5884u, 5868u, 5851u, 5835u, 5818u, 5802u, 5786u, 5769u,
+    5753u, 5737u, 5721u, 5705u, 5689u, 5673u, 5657u, 5641u,
+    5625u, 5610u, 5594u, 5578u, 5562u, 5547u, 5531u, 5516u,
+    5500u, 5485u, 5469u, 5454u, 5439u, 5423u, 5408u, 5393u,
+    5378u, 5363u, 5348u, 5333u, 5318u, 5303u, 5288u, 5273u,
+    5258u, 5243u, 5229u, 5214u, 5199u, 5185u, 5170u, 5156u,
+    5141u, 5127u, 5112u, 5098u, 5084u, 5070u, 5055u, 5041u,
+    5027u, 5013u, 4999u, 4985u, 4971u, 4957u, 4943u, 4929u,
+    4915u, 4901u, 4888u, 4874u, 4860u, 4847u, 4833u, 4819u,
+    4806u, 4792u, 4779u, 4765u, 4752u, 4739u, 4725u, 4712u,
+    4699u, 4686u, 4673u, 4659u, 4646u, 4633u, 4620u, 4607u,
+    4594u, 4582u, 4569u, 4556u, 4543u, 4530u, 4518u, 4505u,
+    4492u, 4480u, 4467u, 4455u, 4442u, 4430u, 4417u, 4405u,
+    4392u, 4380u, 4368u, 4355u, 4343u, 4331u, 4319u, 4307u,
+    4295u, 4283u, 4271u, 4259u, 4247u, 4235u, 4223u, 4211u,
+    4199u, 4187u, 4176u, 4164u, 4152u, 4141u, 4129u, 4117u,
+    4106u, 4094u, 4083u, 4071u, 4060u, 4048u, 4037u, 4026u,
+    4014u, 4003u, 3992u, 3981u, 3970u, 3958u, 3947u, 3936u,
+    3925u, 3914u, 3903u, 3892u, 3881u, 3870u, 3860u, 3849u,
+    3838u, 3827u, 3816u, 3806u, 3795u, 3784u, 3774u, 3763u,
+    3753u, 3742u, 3731u, 3721u, 3711u, 3700u, 3690u, 3679u,
+    3669u, 3659u, 3648u, 3638u, 3628u, 3618u, 3608u, 3598u,
+    3587u, 3577u, 3567u, 3557u, 3547u, 3537u, 3527u, 3518u,
+    3508u, 3498u, 3488u, 3478u, 3468u, 3459u, 3449u, 3439u,
+    3430u, 3420u, 3410u, 3401u, 3391u, 3382u, 3372u, 3363u,
+    3353u, 3344u, 3335u, 3325u, 3316u, 3307u, 3297u, 3288u,
+    3279u, 3270u, 3260u, 3251u, 3242u, 3233u, 3224u, 3215u,
+    3206u, 3197u, 3188u, 3179u, 3170u, 3161u, 3152u, 3143u,
+    3135u, 3126u, 3117u, 3108u, 3100u, 3091u, 3082u, 3073u,
+    3065u, 3056u, 3048u, 3039u, 3031u, 3022u, 3014u, 3005u,
+    2997u, 2988u, 2980u, 2972u, 2963u, 2955u, 2947u, 2938u,
+    2930u, 2922u, 2914u, 2905u, 2897u, 2889u, 2881u, 2873u,
+    2865u, 2857u, 2849u, 2841u, 2833u, 2825u, 2817u, 2809u,
+    2801u, 2793u, 2785u, 2778u, 2770u, 2762u, 2754u, 2747u,
+    2739u, 2731u, 2723u, 2716u, 2708u, 2701u, 2693u, 2685u,
+    2678u, 2670u, 2663u, 2655u, 2648u, 2641u, 2633u, 2626u,
+    2618u, 2611u, 2604u, 2596u, 2589u, 2582u, 2575u, 2567u,
+    2560u, 2553u, 2546u, 2539u, 2532u, 2524u, 2517u, 2510u,
+    2503u, 2496u, 2489u, 2482u, 2475u, 2468u, 2461u, 2454u,
+    2448u, 2441u, 2434u, 2427u, 2420u, 2413u, 2407u, 2400u,
+    2393u, 2386u, 2380u, 2373u, 2366u, 2360u, 2353u, 2346u,
+    2340u, 2333u, 2327u, 2320u, 2314u, 2307u, 2301u, 2294u,
+    2288u, 2281u, 2275u, 2269u, 2262u, 2256u, 2250u, 2243u,
+    2237u, 2231u, 2224u, 2218u, 2212u, 2206u, 2200u, 2193u,
+    2187u, 2181u, 2175u, 2169u, 2163u, 2157u, 2151u, 2145u,
+    2139u, 2133u, 2127u, 2121u, 2115u, 2109u, 2103u, 2097u,
+    2091u, 2085u, 2079u, 2073u, 2068u, 2062u, 2056u, 2050u,
+    2044u, 2039u, 2033u, 2027u, 2022u, 2016u, 2010u, 2005u,
+    1999u, 1993u, 1988u, 1982u, 1977u, 1971u, 1966u, 1960u,
+    1955u, 1949u, 1944u, 1938u, 1933u, 1927u, 1922u, 1916u,
+    1911u, 1906u, 1900u, 1895u, 1890u, 1884u, 1879u, 1874u,
+    1869u, 1863u, 1858u, 1853u, 1848u, 1843u, 1837u, 1832u,
+    1827u, 1822u, 1817u, 1812u, 1807u, 1802u, 1796u, 1791u,
+    1786u, 1781u, 1776u, 1771u, 1766u, 1761u, 1757u, 1752u,
+    1747u, 1742u, 1737u, 1732u, 1727u, 1722u, 1717u, 1713u,
+    1708u, 1703u, 1698u, 1693u, 1689u, 1684u, 1679u, 1675u,
+    1670u, 1665u, 1660u, 1656u, 1651u, 1647u, 1642u, 1637u,
+    1633u, 1628u, 1624u, 1619u, 1614u, 1610u, 1605u, 1601u,
+    1596u, 1592u, 1587u, 1583u, 1579u, 1574u, 1570u, 1565u,
+    1561u, 1556u, 1552u, 1548u, 1543u, 1539u, 1535u, 1530u,
+    1526u, 1522u, 1518u, 1513u, 1509u, 1505u, 1501u, 1496u,
+    1492u, 1488u, 1484u, 1480u, 1476u, 1471u, 1467u, 1463u,
+    1459u, 1455u, 1451u, 1447u, 1443u, 1439u, 1435u, 1431u,
+    1427u, 1423u, 1419u, 1415u, 1411u, 1407u, 1403u, 1399u,
+    1395u, 1391u, 1387u, 1383u, 1379u, 1375u, 1372u, 1368u,
+    1364u, 1360u, 1356u, 1352u, 1349u, 1345u, 1341u, 1337u,
+    1334u, 1330u, 1326u, 1322u, 1319u, 1315u, 1311u, 1308u,
+    1304u, 1300u, 1297u, 1293u, 1289u, 1286u, 1282u, 1278u,
+    1275u, 1271u, 1268u, 1264u, 1261u, 1257u, 1254u, 1250u,
+};
+
+const clock_cache_pwm_entry_t clock_cache_pwm_grid[CLOCK_CACHE_GRID_ENTRIES] = {
+    {8u, 250, 0, 62499, 31250},
+    {9u, 250, 15, 55347, 27674},
+    {10u, 195, 5, 63999, 32000},
+    {11u, 216, 2, 52578, 26289},
+    {12u, 246, 7, 42268, 21134},
+    {13u, 182, 14, 52578, 26289},
+    {14u, 169, 13, 52578, 26289},
+    {15u, 178, 9, 46668, 23334},
+    {17u, 149, 9, 49162, 24581},
+    {18u, 146, 2, 47523, 23762},
+    {19u, 125, 2, 52578, 26289},
+    {21u, 178, 9, 33334, 16667},
+    {22u, 108, 1, 52578, 26289},
+    {24u, 95, 6, 54608, 27304},
+    {25u, 78, 2, 63999, 32000},
+    {27u, 75, 1, 61676, 30838},
+    {29u, 82, 15, 51970, 25985},
+    {32u, 62, 8, 62499, 31250},
+    {34u, 98, 6, 37371, 18686},
+    {37u, 85, 12, 39397, 19699},
+    {39u, 53, 15, 59422, 29711},
+    {42u, 54, 8, 54608, 27304},
+    {45u, 50, 3, 55347, 27674},
+    {49u, 64, 12, 39397, 19699},
+    {52u, 41, 6, 58098, 29049},
+    {56u, 40, 14, 54608, 27304},
+    {60u, 50, 3, 41510, 20755},
+    {65u, 111, 7, 17256, 8628},
+    {70u, 69, 15, 25532, 12766},
+    {75u, 83, 5, 20004, 10002},
+    {81u, 38, 15, 39632, 19816},
+    {87u, 54, 3, 26514, 13257},
+    {93u, 67, 3, 20004, 10002},
+    {100u, 20, 0, 62499, 31250},
+    {107u, 19, 13, 58963, 29482},
+    {115u, 17, 12, 61236, 30618},
+    {124u, 50, 9, 19936, 9968},
+    {133u, 17, 14, 52578, 26289},
+    {143u, 16, 10, 52578, 26289},
+    {154u, 15, 7, 52578, 26289},
+    {165u, 12, 10, 60005, 30003},
+    {178u, 90, 7, 7764, 3882},
+    {191u, 34, 7, 19003, 9502},
+    {205u, 29, 9, 20625, 10313},
+    {221u, 16, 15, 33393, 16697},
+    {237u, 22, 1, 23905, 11953},
+    {255u, 30, 13, 15908, 7954},
+    {274u, 9, 2, 49994, 24997},
+    {294u, 7, 2, 59672, 29836},
+    {316u, 32, 5, 12241, 6121},
+    {340u, 6, 2, 60023, 30012},
+    {365u, 6, 3, 55347, 27674},
+    {392u, 16, 3, 19698, 9849},
+    {422u, 16, 1, 18440, 9220},
+    {453u, 27, 5, 10102, 5051},
+    {487u, 4, 11, 54756, 27378},
+    {523u, 4, 3, 57075, 28538},
+    {562u, 9, 13, 22666, 11333},
+    {604u, 5, 6, 38502, 19251},
+    {649u, 4, 0, 48150, 24075},
+    {698u, 2, 13, 63673, 31837},
+    {750u, 4, 3, 39800, 19900},
+    {806u, 2, 13, 55141, 27571},
+    {866u, 3, 9, 40516, 20258},
+    {931u, 2, 4, 59672, 29836},
+    {1000u, 2, 0, 62499, 31250},
+    {1075u, 1, 15, 60014, 30007},
+    {1155u, 4, 15, 21918, 10959},
+    {1241u, 38, 9, 2611, 1306},
+    {1334u, 1, 9, 59969, 29985},
+    {1433u, 8, 3, 10653, 5327},
+    {1540u, 5, 3, 15646, 7823},
+    {1655u, 1, 13, 41670, 20835},
+    {1778u, 1, 4, 56242, 28121},
+    {1911u, 1, 1, 61562, 30781},
+    {2054u, 1, 2, 54094, 27047},
+    {2207u, 1, 0, 56637, 28319},
+    {2371u, 2, 5, 22797, 11399},
+    {2548u, 3, 5, 14809, 7405},
+    {2738u, 1, 4, 36522, 18261},
+    {2943u, 2, 5, 18366, 9183},
+    {3162u, 2, 1, 19166, 9583},
+    {3398u, 1, 2, 32698, 16349},
+    {3652u, 2, 3, 15646, 7823},
+    {3924u, 1, 12, 18202, 9101},
+    {4217u, 3, 1, 9678, 4839},
+    {4532u, 1, 2, 24516, 12258},
+    {4870u, 31, 3, 822, 411},
+    {5233u, 1, 7, 16616, 8308},
+    {5623u, 3, 5, 6710, 3355},
+    {6043u, 1, 3, 17418, 8709},
+    {6494u, 15, 11, 1226, 613},
+    {6978u, 1, 3, 15084, 7542},
+    {7499u, 1, 3, 14036, 7018},
+    {8058u, 1, 1, 14599, 7300},
+    {8660u, 9, 13, 1470, 735},
+    {9306u, 3, 5, 4054, 2027},
+    {10000u, 1, 0, 12499, 6250},
+    {10746u, 1, 1, 10947, 5474},
+    {11548u, 1, 7, 7529, 3765},
+    {12409u, 3, 5, 3040, 1520},
+    {13335u, 5, 3, 1806, 903},
+    {14330u, 14, 9, 598, 299},
+    {15399u, 1, 1, 7639, 3820},
+    {16548u, 2, 7, 3098, 1549},
+    {17783u, 3, 5, 2121, 1061},
+    {19110u, 1, 0, 6540, 3270},
+    {20535u, 2, 11, 2264, 1132},
+    {22067u, 1, 5, 4315, 2158},
+    {23714u, 1, 1, 4960, 2480},
+    {25483u, 1, 12, 2802, 1401},
+    {27384u, 1, 11, 2704, 1352},
+    {29427u, 1, 7, 2954, 1477},
+    {31623u, 2, 3, 1806, 903},
+    {33982u, 4, 15, 744, 372},
+    {36517u, 8, 15, 382, 191},
+    {39242u, 1, 1, 2997, 1499},
+    {42170u, 4, 7, 667, 334},
+    {45316u, 2, 3, 1260, 630},
+    {48697u, 1, 14, 1368, 684},
+    {52330u, 6, 1, 393, 197},
+    {56234u, 148, 3, 14, 7},
+    {60430u, 1, 5, 1575, 788},
+    {64938u, 1, 3, 1620, 810},
+    {69783u, 1, 4, 1432, 716},
+    {74989u, 9, 5, 178, 89},
+    {80584u, 1, 1, 1459, 730},
+    {86596u, 180, 7, 7, 4},
+    {93057u, 1, 2, 1193, 597},
+    {100000u, 1, 0, 1249, 625},
+    {107461u, 2, 5, 502, 251},
+    {115478u, 1, 7, 752, 376},
+    {124094u, 4, 7, 226, 113},
+};
+
+const uint32_t clock_cache_pwm_grid_length = 133;
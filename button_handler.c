@@ -4,63 +4,159 @@
 
 #include "button_handler.h"
 #include "config.h"
+#include "control_arbiter.h"
+#include "debounce.h"
+#include "spsc_queue.h"
+#include "hardware/irq.h"
+#include "hardware/sync.h"
 
-// Static variables for button debouncing
-static uint32_t last_button_time[5] = {0, 0, 0, 0, 0}; // Added reset and power buttons
+// Button pins in button_index_t order
+static const uint button_pins[BUTTON_COUNT] = {
+    BUTTON_SINGLE_STEP, BUTTON_LOW_FREQ, BUTTON_HIGH_FREQ, BUTTON_RESET, BUTTON_POWER
+};
+
+// Edges captured by the GPIO interrupt (type: button index, aux: pressed,
+// arg: time in microseconds), consumed by update_button_state()
+static spsc_queue_t edge_queue;
+static uint32_t edges_dropped_seen = 0;
+
+// Debounce state and presses seen by the latest update_button_state()
+static debounce_t debouncers[BUTTON_COUNT];
+static bool press_pending[BUTTON_COUNT];
 
 // Mode state variables
 static clock_mode_t current_mode = MODE_SINGLE_STEP;
 static clock_mode_t previous_mode = MODE_SINGLE_STEP;
 
-// Forward declaration of external functions
-extern void set_mode(clock_mode_t mode);
-extern void toggle_clock_output(void);
-extern void set_single_step_active(bool active);
+static void button_gpio_irq(void) {
+    uint32_t now = time_us_32();
+    bool captured = false;
+    
+    for (uint i = 0; i < BUTTON_COUNT; i++) {
+        uint32_t events = gpio_get_irq_event_mask(button_pins[i]) & (GPIO_IRQ_EDGE_FALL | GPIO_IRQ_EDGE_RISE);
+        if (events) {
+            gpio_acknowledge_irq(button_pins[i], events);
+            // Record the level now; if both edges latched, this is the later one
+            spsc_msg_t edge = { .type = (uint8_t)i, .aux = !gpio_get(button_pins[i]), .arg = now };
+            spsc_queue_push(&edge_queue, &edge);
+            captured = true;
+        }
+    }
+    
+    // Wake the main loop if it is about to wait for an event
+    if (captured) {
+        __sev();
+    }
+}
 
 void button_handler_init(void) {
-    // Initialize button debounce times
-    for (int i = 0; i < 5; i++) {
-        last_button_time[i] = 0;
+    uint32_t now = time_us_32();
+    uint32_t pin_mask = 0;
+    
+    spsc_queue_init(&edge_queue);
+    edges_dropped_seen = 0;
+    for (uint i = 0; i < BUTTON_COUNT; i++) {
+        debounce_init(&debouncers[i], !gpio_get(button_pins[i]), now, DEBOUNCE_DELAY_MS * 1000u);
+        press_pending[i] = false;
+        pin_mask |= 1u << button_pins[i];
     }
+    
+    // Capture both edges of every button (active low with pull-up)
+    gpio_add_raw_irq_handler_masked(pin_mask, button_gpio_irq);
+    for (uint i = 0; i < BUTTON_COUNT; i++) {
+        gpio_set_irq_enabled(button_pins[i], GPIO_IRQ_EDGE_FALL | GPIO_IRQ_EDGE_RISE, true);
+    }
+    irq_set_enabled(IO_IRQ_BANK0, true);
 }
 
-bool button_pressed(uint pin, uint button_index) {
-    bool pressed = !gpio_get(pin); // Active low with pull-up
-    uint32_t current_time = to_ms_since_boot(get_absolute_time());
+void update_button_state(void) {
+    spsc_msg_t edge;
     
-    if (pressed && (current_time - last_button_time[button_index] > DEBOUNCE_DELAY_MS)) {
-        last_button_time[button_index] = current_time;
-        return true;
+    // Presses not handled in the previous pass are dropped
+    for (uint i = 0; i < BUTTON_COUNT; i++) {
+        press_pending[i] = false;
+    }
+    
+    while (spsc_queue_pop(&edge_queue, &edge)) {
+        // Edges may have waited well past the hold-off while core0 was busy,
+        // so each one settles the state before it and is always recorded
+        if (debounce_feed(&debouncers[edge.type], edge.aux, edge.arg) == DEBOUNCE_PRESS) {
+            press_pending[edge.type] = true;
+        }
     }
     
+    // Edges were lost while the queue was full: resynchronize from the pins
+    if (edge_queue.dropped != edges_dropped_seen) {
+        edges_dropped_seen = edge_queue.dropped;
+        for (uint i = 0; i < BUTTON_COUNT; i++) {
+            if (debounce_feed(&debouncers[i], !gpio_get(button_pins[i]), time_us_32()) == DEBOUNCE_PRESS) {
+                press_pending[i] = true;
+            }
+        }
+    }
+    
+    uint32_t now = time_us_32();
+    for (uint i = 0; i < BUTTON_COUNT; i++) {
+        if (debounce_poll(&debouncers[i], now) == DEBOUNCE_PRESS) {
+            press_pending[i] = true;
+        }
+    }
+}
+
+bool get_button_settle_deadline(uint64_t *deadline_us) {
+    uint64_t now = time_us_64();
+    bool pending = false;
+    
+    for (uint i = 0; i < BUTTON_COUNT; i++) {
+        uint32_t settle;
+        if (debounce_settle_time(&debouncers[i], &settle)) {
+            // Debounce times are 32-bit; extend relative to now
+            int32_t remaining = (int32_t)(settle - (uint32_t)now);
+            uint64_t deadline = remaining > 0 ? now + (uint32_t)remaining : now;
+            if (!pending || deadline < *deadline_us) {
+                *deadline_us = deadline;
+            }
+            pending = true;
+        }
+    }
+    return pending;
+}
+
+bool button_pressed(button_index_t button) {
+    if (press_pending[button]) {
+        press_pending[button] = false;
+        return true;
+    }
     return false;
 }
 
 void handle_buttons(void) {
-    if (button_pressed(BUTTON_SINGLE_STEP, 0)) {
-        if (current_mode == MODE_SINGLE_STEP) {
-            // Toggle clock in single step mode
-            toggle_clock_output();
-            set_single_step_active(true);
-        } else {
-            // Switch to single step mode
-            set_mode(MODE_SINGLE_STEP);
-        }
+    // Front-panel requests go through the arbiter like remote ones, which
+    // also holds remote changes off for a moment afterwards
+    if (button_pressed(BUTTON_INDEX_SINGLE_STEP)) {
+        // Toggles the clock in single step mode, otherwise switches to it
+        control_arbiter_step(CONTROL_SOURCE_PANEL);
     }
     
-    if (button_pressed(BUTTON_LOW_FREQ, 1)) {
-        set_mode(MODE_LOW_FREQ);
+    if (button_pressed(BUTTON_INDEX_LOW_FREQ)) {
+        control_arbiter_mode(CONTROL_SOURCE_PANEL, MODE_LOW_FREQ);
     }
     
-    if (button_pressed(BUTTON_HIGH_FREQ, 2)) {
-        set_mode(MODE_HIGH_FREQ);
+    if (button_pressed(BUTTON_INDEX_HIGH_FREQ)) {
+        control_arbiter_mode(CONTROL_SOURCE_PANEL, MODE_HIGH_FREQ);
     }
 }
 
 bool any_button_pressed(void) {
-    return !gpio_get(BUTTON_SINGLE_STEP) ||
-           !gpio_get(BUTTON_LOW_FREQ) ||
-           !gpio_get(BUTTON_HIGH_FREQ);
+    return debouncers[BUTTON_INDEX_SINGLE_STEP].pressed ||
+           debouncers[BUTTON_INDEX_LOW_FREQ].pressed ||
+           debouncers[BUTTON_INDEX_HIGH_FREQ].pressed;
+}
+
+bool any_button_press_pending(void) {
+    return press_pending[BUTTON_INDEX_SINGLE_STEP] ||
+           press_pending[BUTTON_INDEX_LOW_FREQ] ||
+           press_pending[BUTTON_INDEX_HIGH_FREQ];
 }
 
 clock_mode_t get_current_mode(void) {
@@ -74,4 +170,4 @@ void set_current_mode(clock_mode_t mode) {
 
 clock_mode_t get_previous_mode(void) {
     return previous_mode;
-}
\ No newline at end of file
+}
@@ -3,6 +3,8 @@
  * 
  * This module handles button debouncing and mode switching logic.
  * Provides a clean interface for button handling that can be reused in other projects.
+ * Button edges are captured and timestamped by the GPIO interrupt and
+ * debounced by update_button_state() (see debounce.h).
  */
 
 #ifndef BUTTON_HANDLER_H
@@ -19,18 +21,40 @@ typedef enum {
     MODE_UART_CONTROL
 } clock_mode_t;
 
+// Buttons handled by this module
+typedef enum {
+    BUTTON_INDEX_SINGLE_STEP,
+    BUTTON_INDEX_LOW_FREQ,
+    BUTTON_INDEX_HIGH_FREQ,
+    BUTTON_INDEX_RESET,
+    BUTTON_INDEX_POWER,
+    BUTTON_COUNT
+} button_index_t;
+
 /**
- * Initialize button handler module
+ * Initialize button handler module (enables the button edge interrupt)
  */
 void button_handler_init(void);
 
 /**
- * Check if a button is pressed with debouncing
- * @param pin GPIO pin number
- * @param button_index Index for debounce timing (0-4)
- * @return true if button was pressed (debounced)
+ * Debounce captured button edges (call once per main loop pass)
+ * Presses not consumed by button_pressed() before the next call are dropped.
+ */
+void update_button_state(void);
+
+/**
+ * Get the time at which update_button_state() next has work without a new edge
+ * @param deadline_us Receives the absolute time in microseconds
+ * @return true if a debounced state change is pending
  */
-bool button_pressed(uint pin, uint button_index);
+bool get_button_settle_deadline(uint64_t *deadline_us);
+
+/**
+ * Check for a debounced press seen by the latest update_button_state()
+ * @param button Button to check
+ * @return true once per press
+ */
+bool button_pressed(button_index_t button);
 
 /**
  * Handle mode switching button presses
@@ -40,10 +64,16 @@ void handle_buttons(void);
 
 /**
  * Check if any button is currently pressed (for UART mode entry)
- * @return true if any mode button is currently pressed
+ * @return true if any mode button is currently held down (debounced)
  */
 bool any_button_pressed(void);
 
+/**
+ * Check for a new mode button press (for UART mode exit)
+ * @return true if a mode button was pressed since the last update_button_state()
+ */
+bool any_button_press_pending(void);
+
 /**
  * Get current mode
  * @return current clock mode
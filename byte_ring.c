@@ -0,0 +1,92 @@
+/**
+ * Byte Ring Module for Multimode Clock Source
+ */
+
+#include "byte_ring.h"
+#include <string.h>
+
+// head and tail are free-running counters, as in spsc_queue.c; the byte
+// index is the counter modulo the size. The producer publishes bytes with a
+// release store of head after copying them in, and the consumer frees them
+// with a release store of tail once it is done with them.
+
+void byte_ring_init(byte_ring_t *r, uint8_t *buffer, uint32_t size) {
+    r->buffer = buffer;
+    r->size = size;
+    atomic_store_explicit(&r->head, 0, memory_order_relaxed);
+    atomic_store_explicit(&r->tail, 0, memory_order_relaxed);
+    r->dropped = 0;
+    r->dropped_writes = 0;
+}
+
+// Copy in up to two pieces around the end of the buffer, then publish
+static void append(byte_ring_t *r, unsigned head, const void *data, uint32_t length) {
+    uint32_t index = head & (r->size - 1);
+    uint32_t first = r->size - index;
+    if (first > length) first = length;
+    memcpy(&r->buffer[index], data, first);
+    memcpy(r->buffer, (const uint8_t *)data + first, length - first);
+
+    atomic_store_explicit(&r->head, head + length, memory_order_release);
+}
+
+bool byte_ring_write(byte_ring_t *r, const void *data, uint32_t length) {
+    unsigned head = atomic_load_explicit(&r->head, memory_order_relaxed);
+    unsigned tail = atomic_load_explicit(&r->tail, memory_order_acquire);
+
+    if (length > r->size - (head - tail)) {
+        r->dropped += length;
+        r->dropped_writes++;
+        return false;
+    }
+    append(r, head, data, length);
+    return true;
+}
+
+uint32_t byte_ring_write_some(byte_ring_t *r, const void *data, uint32_t length) {
+    unsigned head = atomic_load_explicit(&r->head, memory_order_relaxed);
+    unsigned tail = atomic_load_explicit(&r->tail, memory_order_acquire);
+
+    uint32_t room = r->size - (head - tail);
+    uint32_t taken = length < room ? length : room;
+    if (taken < length) {
+        r->dropped += length - taken;
+        r->dropped_writes++;
+    }
+    if (taken) append(r, head, data, taken);
+    return taken;
+}
+
+uint32_t byte_ring_peek(byte_ring_t *r, const uint8_t **data) {
+    return byte_ring_peek_from(r, 0, data);
+}
+
+uint32_t byte_ring_peek_from(byte_ring_t *r, uint32_t offset, const uint8_t **data) {
+    unsigned tail = atomic_load_explicit(&r->tail, memory_order_relaxed);
+    unsigned head = atomic_load_explicit(&r->head, memory_order_acquire);
+
+    uint32_t queued = head - tail;
+    if (offset >= queued) return 0;
+
+    uint32_t index = (tail + offset) & (r->size - 1);
+    uint32_t length = queued - offset;
+    if (length > r->size - index) length = r->size - index;
+
+    *data = &r->buffer[index];
+    return length;
+}
+
+void byte_ring_consume(byte_ring_t *r, uint32_t length) {
+    unsigned tail = atomic_load_explicit(&r->tail, memory_order_relaxed);
+    atomic_store_explicit(&r->tail, tail + length, memory_order_release);
+}
+
+uint32_t byte_ring_used(byte_ring_t *r) {
+    unsigned head = atomic_load_explicit(&r->head, memory_order_acquire);
+    unsigned tail = atomic_load_explicit(&r->tail, memory_order_acquire);
+    return head - tail;
+}
+
+uint32_t byte_ring_free(byte_ring_t *r) {
+    return r->size - byte_ring_used(r);
+}
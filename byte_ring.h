@@ -0,0 +1,93 @@
+/**
+ * Byte Ring Module for Multimode Clock Source
+ *
+ * Lock-free single-producer/single-consumer ring of bytes for serial
+ * streams. Writes are all or nothing and never block: a write that does not
+ * fit is dropped whole and counted, so a message is never cut short; a
+ * stream with no message boundaries can keep what fits instead. The
+ * consumer reads in place, one contiguous block at a time, which suits a
+ * DMA channel draining the ring or a parser working on slices.
+ */
+
+#ifndef BYTE_RING_H
+#define BYTE_RING_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdatomic.h>
+
+typedef struct {
+    uint8_t *buffer;
+    uint32_t size;          // Capacity in bytes (a power of two)
+    atomic_uint head;       // Bytes ever written (written by producer only)
+    atomic_uint tail;       // Bytes ever consumed (written by consumer only)
+    uint32_t dropped;       // Bytes rejected because the ring was full
+    uint32_t dropped_writes; // Writes rejected, or cut short, because the ring was full
+} byte_ring_t;
+
+/**
+ * Initialize an empty ring
+ * @param r Ring
+ * @param buffer Storage
+ * @param size Size of buffer in bytes (must be a power of two)
+ */
+void byte_ring_init(byte_ring_t *r, uint8_t *buffer, uint32_t size);
+
+/**
+ * Append bytes (producer side, never blocks)
+ * @param r Ring
+ * @param data Bytes to copy into the ring
+ * @param length Number of bytes
+ * @return true if all bytes were queued, false if none were (ring full)
+ */
+bool byte_ring_write(byte_ring_t *r, const void *data, uint32_t length);
+
+/**
+ * Append as many bytes as fit (producer side, never blocks)
+ * The bytes that do not fit are dropped and counted, as one rejected write.
+ * @param r Ring
+ * @param data Bytes to copy into the ring
+ * @param length Number of bytes
+ * @return Number of bytes queued, from the start of data
+ */
+uint32_t byte_ring_write_some(byte_ring_t *r, const void *data, uint32_t length);
+
+/**
+ * Get the oldest contiguous block of queued bytes (consumer side)
+ * @param r Ring
+ * @param data Receives a pointer to the block
+ * @return Length of the block (0 if the ring is empty)
+ */
+uint32_t byte_ring_peek(byte_ring_t *r, const uint8_t **data);
+
+/**
+ * Get a contiguous block of queued bytes further into the ring (consumer side)
+ * @param r Ring
+ * @param offset Bytes to skip past the oldest one
+ * @param data Receives a pointer to the block
+ * @return Length of the block (0 if no bytes are queued past offset)
+ */
+uint32_t byte_ring_peek_from(byte_ring_t *r, uint32_t offset, const uint8_t **data);
+
+/**
+ * Release bytes returned by byte_ring_peek() (consumer side)
+ * @param r Ring
+ * @param length Number of bytes consumed
+ */
+void byte_ring_consume(byte_ring_t *r, uint32_t length);
+
+/**
+ * Get the number of queued bytes
+ * @param r Ring
+ * @return Bytes waiting to be consumed
+ */
+uint32_t byte_ring_used(byte_ring_t *r);
+
+/**
+ * Get the space left
+ * @param r Ring
+ * @return Largest write that would currently succeed
+ */
+uint32_t byte_ring_free(byte_ring_t *r);
+
+#endif // BYTE_RING_H
@@ -0,0 +1,73 @@
+/**
+ * Clock Configuration Cache Module for Multimode Clock Source
+ */
+
+#include "clock_cache.h"
+#include "pio_clock.h"
+#include "sys_clock.h"
+#include "hardware/clocks.h"
+
+_Static_assert(sizeof(clock_cache_adc_millihz) + sizeof(clock_cache_adc_period) + sizeof(clock_cache_pwm_grid) <= CLOCK_CACHE_FLASH_BUDGET,
+               "Precomputed clock tables exceed CLOCK_CACHE_FLASH_BUDGET");
+
+bool clock_cache_valid(void) {
+    // A trimmed clock is solved afresh
+    return sys_clock_get_hz() == CLOCK_CACHE_SYS_HZ;
+}
+
+// Linear interpolation between adjacent entries of a pot table
+static uint32_t pot_interpolate(const uint32_t *table, uint16_t position) {
+    uint32_t index = (position / CLOCK_CACHE_POT_SUBSTEPS) & (CLOCK_CACHE_ADC_ENTRIES - 1);
+    uint32_t frac = position % CLOCK_CACHE_POT_SUBSTEPS;
+    if (frac == 0 || index == CLOCK_CACHE_ADC_ENTRIES - 1) {
+        return table[index];
+    }
+    
+    int64_t step = (int64_t)table[index + 1] - (int64_t)table[index];
+    return (uint32_t)((int64_t)table[index] + step * (int64_t)frac / CLOCK_CACHE_POT_SUBSTEPS);
+}
+
+uint32_t clock_cache_pot_millihz(uint16_t position) {
+    // Frequencies do not depend on the system clock, so this table is always valid
+    return pot_interpolate(clock_cache_adc_millihz, position);
+}
+
+uint32_t clock_cache_pot_period(uint16_t position) {
+    if (clock_cache_valid()) {
+        return pot_interpolate(clock_cache_adc_period, position);
+    }
+    
+    return pio_clock_period_millihz(sys_clock_get_hz(), clock_cache_pot_millihz(position));
+}
+
+bool clock_cache_lookup_pwm(uint32_t frequency, pwm_solution_t *out) {
+    if (!clock_cache_valid()) return false;
+    
+    // Binary search over the ascending grid
+    uint32_t lo = 0;
+    uint32_t hi = clock_cache_pwm_grid_length;
+    while (lo < hi) {
+        uint32_t mid = (lo + hi) / 2;
+        if (clock_cache_pwm_grid[mid].frequency < frequency) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+    
+    if (lo == clock_cache_pwm_grid_length || clock_cache_pwm_grid[lo].frequency != frequency) {
+        return false;
+    }
+    
+    const clock_cache_pwm_entry_t *entry = &clock_cache_pwm_grid[lo];
+    uint64_t source = 16ull * CLOCK_CACHE_SYS_HZ;
+    uint64_t ticks = (uint64_t)((entry->div_int << 4) | entry->div_frac) * (entry->wrap + 1u);
+    
+    out->div_int = entry->div_int;
+    out->div_frac = entry->div_frac;
+    out->wrap = entry->wrap;
+    out->level = entry->level;
+    out->achieved_millihz = (source * 1000ull + ticks / 2) / ticks;
+    out->error_ppb = pwm_solver_error_ppb(source, ticks, frequency);
+    return true;
+}
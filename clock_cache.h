@@ -0,0 +1,71 @@
+/**
+ * Clock Configuration Cache Module for Multimode Clock Source
+ *
+ * This module serves precomputed clock configurations from flash so that
+ * retuning is a table lookup plus register writes. The tables are generated
+ * at build time by gen_clock_tables.py for a nominal system clock; when the
+ * system clock differs the lookups fall back to computing at runtime.
+ */
+
+#ifndef CLOCK_CACHE_H
+#define CLOCK_CACHE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "pwm_solver.h"
+
+// Table generation parameters (also read by gen_clock_tables.py)
+#define CLOCK_CACHE_SYS_HZ          125000000u  // System clock the tables assume
+#define CLOCK_CACHE_ADC_ENTRIES     4096        // One frequency and PIO period per 12-bit ADC value
+#define CLOCK_CACHE_POT_SUBSTEPS    4           // Positions interpolated between ADC values
+#define CLOCK_CACHE_GRID_PER_DECADE 32          // Log-spaced PWM grid density
+#define CLOCK_CACHE_GRID_MAX_HZ     1000000     // Grid top; higher frequencies are solved at runtime
+#define CLOCK_CACHE_GRID_ENTRIES    193         // Grid capacity (6 decades + 1)
+
+// Flash budget for all tables together
+#define CLOCK_CACHE_FLASH_BUDGET    (40 * 1024)
+
+typedef struct {
+    uint32_t frequency;     // Grid frequency in Hz
+    uint8_t div_int;        // Integer part of the clock divider
+    uint8_t div_frac;       // Fractional part of the clock divider (1/16 steps)
+    uint16_t wrap;          // Counter wrap (TOP) value
+    uint16_t level;         // Compare level for a 50% duty cycle
+} clock_cache_pwm_entry_t;
+
+// Generated tables (clock_tables.c)
+extern const uint32_t clock_cache_adc_millihz[CLOCK_CACHE_ADC_ENTRIES];
+extern const uint32_t clock_cache_adc_period[CLOCK_CACHE_ADC_ENTRIES];
+extern const clock_cache_pwm_entry_t clock_cache_pwm_grid[CLOCK_CACHE_GRID_ENTRIES];
+extern const uint32_t clock_cache_pwm_grid_length;
+
+/**
+ * Check whether the tables match the running system clock
+ * @return true if lookups are served from flash
+ */
+bool clock_cache_valid(void);
+
+/**
+ * Get the frequency for a potentiometer position
+ * Entries between ADC values are interpolated; no division is involved.
+ * @param position Knob position (0 to CLOCK_CACHE_ADC_ENTRIES * CLOCK_CACHE_POT_SUBSTEPS - 1)
+ * @return Frequency in millihertz, following the POT_TAPER selected in config.h
+ */
+uint32_t clock_cache_pot_millihz(uint16_t position);
+
+/**
+ * Get the PIO clock period for a potentiometer position
+ * @param position Knob position (0 to CLOCK_CACHE_ADC_ENTRIES * CLOCK_CACHE_POT_SUBSTEPS - 1)
+ * @return Period in system clock cycles for pio_clock_set_period()
+ */
+uint32_t clock_cache_pot_period(uint16_t position);
+
+/**
+ * Look up a PWM configuration on the precomputed frequency grid
+ * @param frequency Requested frequency in Hz
+ * @param out Solution (only written on a hit)
+ * @return true if the frequency is a grid point and the tables are valid
+ */
+bool clock_cache_lookup_pwm(uint32_t frequency, pwm_solution_t *out);
+
+#endif // CLOCK_CACHE_H
@@ -0,0 +1,487 @@
+/**
+ * Clock Core Module for Multimode Clock Source
+ */
+
+#include "clock_core.h"
+#include "config.h"
+#include "spsc_queue.h"
+#include "clock_generator.h"
+#include "uart_control.h"
+#include "reset_control.h"
+#include "pio_phase.h"
+#include "sys_clock.h"
+#include "sweep.h"
+#include "freq_counter.h"
+#include "discipline.h"
+#include "status_display.h"
+#include "scheduler.h"
+#include "pico/multicore.h"
+#include "hardware/sync.h"
+#include <stdio.h>
+
+static spsc_queue_t command_queue;      // core0 -> core1
+static spsc_queue_t telemetry_queue;    // core1 -> core0
+
+// Command fence: core0 counts posts, core1 counts completed commands
+static uint32_t commands_posted = 0;
+static atomic_uint commands_executed;
+static atomic_bool core1_ready;
+
+// Latest-value commands skip the queue: a newer post replaces one core1
+// has not run yet, so posting them never waits
+typedef enum {
+    MAILBOX_MODE,               // CORE_CMD_SET_MODE
+    MAILBOX_UART_FREQ,          // CORE_CMD_UART_FREQ
+    MAILBOX_HIGH_FREQ,          // CORE_CMD_HIGH_FREQ
+    MAILBOX_COUNT
+} mailbox_t;
+
+typedef struct {
+    atomic_uint sequence;       // Bumped by core0 per post, odd while it rewrites the slot
+    atomic_uint applied;        // Last sequence core1 ran
+    atomic_uint arg;            // Command argument
+    atomic_uint after;          // Queued commands posted before this one
+    atomic_uint order;          // Post order across the slots
+} mailbox_slot_t;
+
+static const clock_core_cmd_t mailbox_command[MAILBOX_COUNT] = {
+    CORE_CMD_SET_MODE, CORE_CMD_UART_FREQ, CORE_CMD_HIGH_FREQ
+};
+
+static mailbox_slot_t mailbox[MAILBOX_COUNT];
+static uint32_t mailbox_posts = 0;      // core0
+
+// Core1 timers
+typedef enum {
+    CORE1_TIMER_POT_POLL,       // Potentiometer poll in low-frequency mode
+    CORE1_TIMER_RESET,          // Reset pulse end or reset LED expiry
+    CORE1_TIMER_SWEEP,          // Next sweep step
+    CORE1_TIMER_COUNTER,        // Frequency counter gate end or poll
+    CORE1_TIMER_DISCIPLINE,     // Reference reading poll
+    CORE1_TIMER_HANDOVER        // Engine stop finishing, or start waiting for CLOCK_OUTPUT
+} core1_timer_t;
+
+static scheduler_t core1_timers;
+static uint32_t burst_frequency = 0;    // Set by CORE_CMD_BURST_FREQ
+static sweep_plan_t sweep_plan;         // Set by CORE_CMD_SWEEP_FROM, _TO and _SHAPE
+static uint32_t sweep_dwell_us = 0;     // Set by CORE_CMD_SWEEP_DWELL
+
+// Retune the running clock in place for a new trim; a burst or sweep
+// keeps the one it started with
+static void retrim_engines(void) {
+    switch (get_engine_mode()) {
+        case MODE_LOW_FREQ:
+            update_low_frequency();
+            break;
+            
+        case MODE_HIGH_FREQ:
+            start_high_frequency();
+            break;
+            
+        case MODE_UART_CONTROL:
+            retune_uart_frequency();
+            break;
+            
+        default:
+            break;
+    }
+}
+
+static void execute_command(const spsc_msg_t *msg) {
+    switch ((clock_core_cmd_t)msg->type) {
+        case CORE_CMD_SET_MODE:
+            // A pulse counting the old mode's edges ends with it
+            release_reset_pulse();
+            
+            // Stop a UART-controlled clock too before switching engines
+            stop_uart_frequency();
+            clock_generator_apply_mode((clock_mode_t)msg->arg);
+            break;
+            
+        case CORE_CMD_STEP:
+            toggle_clock_output();
+            set_single_step_active(true);
+            break;
+            
+        case CORE_CMD_UART_FREQ:
+            start_uart_frequency(msg->arg);
+            break;
+            
+        case CORE_CMD_UART_STOP:
+            stop_uart_frequency();
+            set_clock_output(false);
+            break;
+            
+        case CORE_CMD_UART_TOGGLE:
+            stop_uart_frequency();
+            toggle_clock_output();
+            break;
+            
+        case CORE_CMD_RESET_PULSE:
+            if (!get_reset_active()) {
+                start_reset_pulse(msg->arg);
+            }
+            break;
+            
+        case CORE_CMD_RESET_RELEASE:
+            release_reset_pulse();
+            break;
+            
+        case CORE_CMD_BURST_FREQ:
+            burst_frequency = msg->arg;
+            break;
+            
+        case CORE_CMD_BURST:
+            start_uart_burst(burst_frequency, msg->arg);
+            break;
+            
+        case CORE_CMD_DEAD_TIME:
+            pio_phase_set_dead_time(msg->arg);
+            break;
+            
+        case CORE_CMD_HIGH_FREQ:
+            set_high_frequency(msg->arg);
+            break;
+            
+        case CORE_CMD_SYS_CLOCK:
+            // Every engine is solved against clk_sys, so start the mode afresh
+            stop_uart_frequency();
+            stop_all_clock_generation();
+            sys_clock_set_khz(msg->arg);
+            clock_generator_apply_mode(get_engine_mode());
+            break;
+            
+        case CORE_CMD_DUTY:
+            set_clock_duty(DUTY_CYCLE_RATIO, msg->arg);
+            break;
+            
+        case CORE_CMD_PULSE_WIDTH:
+            set_clock_duty(DUTY_CYCLE_WIDTH, msg->arg);
+            break;
+            
+        case CORE_CMD_SWEEP_FROM:
+            sweep_plan.from = msg->arg;
+            break;
+            
+        case CORE_CMD_SWEEP_TO:
+            sweep_plan.to = msg->arg;
+            break;
+            
+        case CORE_CMD_SWEEP_SHAPE:
+            sweep_plan.shape = (sweep_shape_t)msg->arg;
+            break;
+            
+        case CORE_CMD_SWEEP_DWELL:
+            sweep_dwell_us = msg->arg;
+            break;
+            
+        case CORE_CMD_SWEEP:
+            sweep_plan.steps = msg->arg;
+            start_uart_sweep(&sweep_plan, sweep_dwell_us);
+            break;
+            
+        case CORE_CMD_WAIT:
+            set_clock_wait(msg->arg != 0);
+            break;
+            
+        case CORE_CMD_COUNT:
+            freq_counter_select((freq_counter_input_t)msg->arg);
+            break;
+            
+        case CORE_CMD_REFERENCE:
+            if (discipline_select(msg->arg)) {
+                retrim_engines();
+            }
+            break;
+    }
+}
+
+// Run the latest-value commands that are due once `executed` queued
+// commands have run, in the order core0 posted them
+static void run_mailbox(unsigned executed) {
+    while (true) {
+        int next = -1;
+        uint32_t next_arg = 0;
+        unsigned next_order = 0;
+        unsigned next_sequence = 0;
+        
+        for (int i = 0; i < MAILBOX_COUNT; i++) {
+            mailbox_slot_t *slot = &mailbox[i];
+            unsigned sequence = atomic_load_explicit(&slot->sequence, memory_order_acquire);
+            
+            // Core0 wakes us again once a slot it is rewriting is complete
+            if ((sequence & 1u) || sequence == atomic_load_explicit(&slot->applied, memory_order_relaxed)) {
+                continue;
+            }
+            uint32_t arg = atomic_load_explicit(&slot->arg, memory_order_relaxed);
+            unsigned after = atomic_load_explicit(&slot->after, memory_order_relaxed);
+            unsigned order = atomic_load_explicit(&slot->order, memory_order_relaxed);
+            atomic_thread_fence(memory_order_acquire);
+            if (atomic_load_explicit(&slot->sequence, memory_order_relaxed) != sequence) {
+                continue;
+            }
+            
+            // Commands queued before it run first
+            if ((int)(after - executed) > 0) {
+                continue;
+            }
+            if (next < 0 || (int)(order - next_order) < 0) {
+                next = i;
+                next_arg = arg;
+                next_order = order;
+                next_sequence = sequence;
+            }
+        }
+        if (next < 0) {
+            return;
+        }
+        
+        spsc_msg_t msg = { .type = (uint8_t)mailbox_command[next], .aux = 0, .arg = next_arg };
+        execute_command(&msg);
+        update_reset_state();
+        atomic_store_explicit(&mailbox[next].applied, next_sequence, memory_order_release);
+        __sev();
+    }
+}
+
+static void core1_entry(void) {
+    // Engines are initialized here so their interrupts are taken on core1
+    clock_generator_init();
+    reset_control_init();
+    sweep_init();
+    freq_counter_init();
+    discipline_init();
+    scheduler_init(&core1_timers);
+    atomic_store_explicit(&core1_ready, true, memory_order_release);
+    __sev();
+    
+    while (true) {
+        uint64_t now = time_us_64();
+        uint8_t timer;
+        bool pot_due = false;
+        
+        while (scheduler_pop_expired(&core1_timers, now, &timer)) {
+            if (timer == CORE1_TIMER_POT_POLL) {
+                pot_due = true;
+            }
+            // The other timers only need the updates below
+        }
+        
+        spsc_msg_t msg;
+        unsigned done = atomic_load_explicit(&commands_executed, memory_order_relaxed);
+        while (spsc_queue_pop(&command_queue, &msg)) {
+            // A mailbox command posted before this one runs first
+            run_mailbox(done);
+            execute_command(&msg);
+            update_reset_state(); // Count single-step edges as they happen
+            
+            atomic_store_explicit(&commands_executed, ++done, memory_order_release);
+            __sev();
+        }
+        run_mailbox(done);
+        
+        // The potentiometer is only polled in low-frequency mode
+        if (get_engine_mode() == MODE_LOW_FREQ) {
+            if (pot_due || !scheduler_is_armed(&core1_timers, CORE1_TIMER_POT_POLL)) {
+                update_low_frequency();
+                scheduler_arm(&core1_timers, CORE1_TIMER_POT_POLL, now + CORE1_POLL_INTERVAL_US);
+            }
+        } else {
+            scheduler_cancel(&core1_timers, CORE1_TIMER_POT_POLL);
+        }
+        
+        update_clock_handover();
+        update_reset_state();
+        update_reset_leds();
+        update_uart_burst();
+        sweep_update();
+        freq_counter_update();
+        if (discipline_update()) {
+            retrim_engines();
+        }
+        
+        uint32_t reset_deadline_ms;
+        if (get_reset_deadline_ms(&reset_deadline_ms)) {
+            scheduler_arm(&core1_timers, CORE1_TIMER_RESET, (uint64_t)reset_deadline_ms * 1000u);
+        } else {
+            scheduler_cancel(&core1_timers, CORE1_TIMER_RESET);
+        }
+        
+        uint64_t sweep_deadline_us;
+        if (sweep_next_deadline(&sweep_deadline_us)) {
+            scheduler_arm(&core1_timers, CORE1_TIMER_SWEEP, sweep_deadline_us);
+        } else {
+            scheduler_cancel(&core1_timers, CORE1_TIMER_SWEEP);
+        }
+        
+        uint64_t counter_deadline_us;
+        if (freq_counter_next_deadline(&counter_deadline_us)) {
+            scheduler_arm(&core1_timers, CORE1_TIMER_COUNTER, counter_deadline_us);
+        } else {
+            scheduler_cancel(&core1_timers, CORE1_TIMER_COUNTER);
+        }
+        
+        uint64_t discipline_deadline_us;
+        if (discipline_next_deadline(&discipline_deadline_us)) {
+            scheduler_arm(&core1_timers, CORE1_TIMER_DISCIPLINE, discipline_deadline_us);
+        } else {
+            scheduler_cancel(&core1_timers, CORE1_TIMER_DISCIPLINE);
+        }
+        
+        uint64_t handover_deadline_us;
+        if (get_clock_handover_deadline(&handover_deadline_us)) {
+            scheduler_arm(&core1_timers, CORE1_TIMER_HANDOVER, handover_deadline_us);
+        } else {
+            scheduler_cancel(&core1_timers, CORE1_TIMER_HANDOVER);
+        }
+        
+        // Sleep until the next deadline, or until core0 posts a command
+        uint64_t deadline;
+        if (scheduler_next_deadline(&core1_timers, &deadline)) {
+            best_effort_wfe_or_timeout(from_us_since_boot(deadline));
+        } else {
+            __wfe();
+        }
+    }
+}
+
+void clock_core_launch(void) {
+    spsc_queue_init(&command_queue);
+    spsc_queue_init(&telemetry_queue);
+    commands_posted = 0;
+    atomic_store_explicit(&commands_executed, 0, memory_order_relaxed);
+    mailbox_posts = 0;
+    for (int i = 0; i < MAILBOX_COUNT; i++) {
+        atomic_store_explicit(&mailbox[i].sequence, 0, memory_order_relaxed);
+        atomic_store_explicit(&mailbox[i].applied, 0, memory_order_relaxed);
+    }
+    atomic_store_explicit(&core1_ready, false, memory_order_relaxed);
+    
+    multicore_launch_core1(core1_entry);
+    while (!atomic_load_explicit(&core1_ready, memory_order_acquire)) {
+        __wfe();
+    }
+}
+
+// Replace a mailbox slot's command; core1 never sees a half-written slot
+static void post_mailbox(mailbox_slot_t *slot, uint32_t arg) {
+    unsigned sequence = atomic_load_explicit(&slot->sequence, memory_order_relaxed);
+    atomic_store_explicit(&slot->sequence, sequence + 1, memory_order_relaxed);
+    atomic_thread_fence(memory_order_release);
+    atomic_store_explicit(&slot->arg, arg, memory_order_relaxed);
+    atomic_store_explicit(&slot->after, commands_posted, memory_order_relaxed);
+    atomic_store_explicit(&slot->order, ++mailbox_posts, memory_order_relaxed);
+    atomic_store_explicit(&slot->sequence, sequence + 2, memory_order_release);
+    __sev();
+}
+
+void clock_core_post(clock_core_cmd_t cmd, uint32_t arg) {
+    for (int i = 0; i < MAILBOX_COUNT; i++) {
+        if (mailbox_command[i] == cmd) {
+            post_mailbox(&mailbox[i], arg);
+            return;
+        }
+    }
+    
+    spsc_msg_t msg = { .type = (uint8_t)cmd, .aux = 0, .arg = arg };
+    
+    // Core1 drains the queue between commands; wait for room rather than
+    // retrying the push, since a command that waits is not a dropped one
+    while (!spsc_queue_has_room(&command_queue)) {
+        __sev();
+        tight_loop_contents();
+    }
+    spsc_queue_push(&command_queue, &msg);
+    commands_posted++;
+    __sev();
+}
+
+bool clock_core_caught_up(void) {
+    if (atomic_load_explicit(&commands_executed, memory_order_acquire) != commands_posted) {
+        return false;
+    }
+    for (int i = 0; i < MAILBOX_COUNT; i++) {
+        if (atomic_load_explicit(&mailbox[i].applied, memory_order_acquire) !=
+            atomic_load_explicit(&mailbox[i].sequence, memory_order_relaxed)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void clock_core_sync(void) {
+    while (!clock_core_caught_up()) {
+        __wfe();
+    }
+}
+
+void clock_core_service(void) {
+    static uint32_t reset_cycles = RESET_CYCLES;
+    spsc_msg_t msg;
+    while (spsc_queue_pop(&telemetry_queue, &msg)) {
+        switch ((clock_core_tlm_t)msg.type) {
+            case CORE_TLM_RESET_STARTED:
+                reset_cycles = msg.arg;
+                printf("Reset pulse started, mode: %d, %lu cycles\n", msg.aux + 1, msg.arg);
+                break;
+                
+            case CORE_TLM_RESET_CYCLE:
+                printf("Reset cycle %lu/%lu (Mode 1)\n", msg.arg, reset_cycles);
+                break;
+                
+            case CORE_TLM_RESET_COMPLETE:
+                if (msg.aux == MODE_SINGLE_STEP) {
+                    printf("Reset pulse complete (Mode 1)\n");
+                } else {
+                    printf("Reset pulse complete (Mode %d, %lu cycles, %lums)\n", msg.aux + 1, reset_cycles, msg.arg);
+                }
+                break;
+                
+            case CORE_TLM_RESET_RELEASED:
+                printf("Reset pulse released early (Mode %d, %lums)\n", msg.aux + 1, msg.arg);
+                break;
+                
+            case CORE_TLM_BURST_COMPLETE:
+                printf("Burst complete (%llu cycles)\n", (uint64_t)msg.arg + 1);
+                break;
+                
+            case CORE_TLM_BURST_ABORTED:
+                printf("Burst of %llu cycles aborted\n", (uint64_t)msg.arg + 1);
+                break;
+                
+            case CORE_TLM_SYS_CLOCK:
+                printf("System clock now %lu.%03lu MHz\n", msg.arg / 1000, msg.arg % 1000);
+                break;
+                
+            case CORE_TLM_SWEEP_COMPLETE:
+                printf("Sweep complete, holding %lu Hz\n", msg.arg);
+                break;
+                
+            case CORE_TLM_SWEEP_ABORTED:
+                printf("Sweep aborted %sat %lu Hz\n", msg.aux == SWEEP_ABORT_FAULT ? "by fault input " : "", msg.arg);
+                break;
+                
+            case CORE_TLM_COUNT:
+                // Streamed to UART1 as well; a later reading may already
+                // have replaced this one
+                print_count_reading(msg.arg);
+                break;
+                
+            case CORE_TLM_DISCIPLINE:
+                // The state may have moved on again; the latest is printed
+                print_discipline_state();
+                break;
+        }
+    }
+}
+
+void clock_core_telemetry(clock_core_tlm_t tlm, uint8_t aux, uint32_t arg) {
+    spsc_msg_t msg = { .type = (uint8_t)tlm, .aux = aux, .arg = arg };
+    if (spsc_queue_push(&telemetry_queue, &msg)) {
+        __sev(); // Wake core0 to print it
+    }
+}
+
+uint32_t clock_core_telemetry_dropped(void) {
+    return telemetry_queue.dropped;
+}
@@ -0,0 +1,107 @@
+/**
+ * Clock Core Module for Multimode Clock Source
+ *
+ * This module runs the clock engine (clock_generator) and reset engine
+ * (reset_control) on core1. Core0 keeps the buttons, UART and status output
+ * and talks to core1 through two lock-free SPSC queues: commands from core0
+ * to core1 and telemetry from core1 back to core0.
+ */
+
+#ifndef CLOCK_CORE_H
+#define CLOCK_CORE_H
+
+#include "pico/stdlib.h"
+#include "button_handler.h"
+
+// Commands (core0 -> core1)
+typedef enum {
+    CORE_CMD_SET_MODE,          // arg: clock_mode_t to switch clock generation to
+    CORE_CMD_STEP,              // Single step: toggle clock and mark step active
+    CORE_CMD_UART_FREQ,         // arg: UART-controlled frequency in Hz
+    CORE_CMD_UART_STOP,         // Stop the UART-controlled clock, output LOW
+    CORE_CMD_UART_TOGGLE,       // Stop the UART-controlled clock and toggle once
+    CORE_CMD_RESET_PULSE,       // arg: clock cycles; start a reset pulse if none is active
+    CORE_CMD_RESET_RELEASE,     // Release the active reset pulse early
+    CORE_CMD_BURST_FREQ,        // arg: frequency in Hz for the next CORE_CMD_BURST
+    CORE_CMD_BURST,             // arg: cycles - 1; start a burst, stopping the UART-controlled clock
+    CORE_CMD_DEAD_TIME,         // arg: phi1/phi2 dead time in system clock cycles
+    CORE_CMD_HIGH_FREQ,         // arg: High Frequency mode output in Hz
+    CORE_CMD_SYS_CLOCK,         // arg: system clock in kHz; stops the engines and restarts the mode
+    CORE_CMD_DUTY,              // arg: duty cycle in 1/DUTY_CYCLE_SCALE for every engine
+    CORE_CMD_PULSE_WIDTH,       // arg: HIGH pulse width in ns for every engine
+    CORE_CMD_SWEEP_FROM,        // arg: first frequency in Hz for the next CORE_CMD_SWEEP
+    CORE_CMD_SWEEP_TO,          // arg: last frequency in Hz for the next CORE_CMD_SWEEP
+    CORE_CMD_SWEEP_SHAPE,       // arg: sweep_shape_t for the next CORE_CMD_SWEEP
+    CORE_CMD_SWEEP_DWELL,       // arg: microseconds per step for the next CORE_CMD_SWEEP
+    CORE_CMD_SWEEP,             // arg: steps; start a sweep, stopping the UART-controlled clock
+    CORE_CMD_WAIT,              // arg: 1 to let WAIT_INPUT stretch the clock, 0 to ignore it
+    CORE_CMD_COUNT,             // arg: freq_counter_input_t to measure, or FREQ_COUNTER_OFF
+    CORE_CMD_REFERENCE          // arg: reference frequency in Hz to discipline to, 0 for off
+} clock_core_cmd_t;
+
+// Telemetry (core1 -> core0)
+typedef enum {
+    CORE_TLM_RESET_STARTED,     // aux: mode, arg: clock cycles requested
+    CORE_TLM_RESET_CYCLE,       // arg: cycles counted so far (Mode 1)
+    CORE_TLM_RESET_COMPLETE,    // aux: mode, arg: elapsed milliseconds
+    CORE_TLM_RESET_RELEASED,    // aux: mode, arg: elapsed milliseconds; ended before its last edge
+    CORE_TLM_BURST_COMPLETE,    // arg: cycles - 1, all emitted
+    CORE_TLM_BURST_ABORTED,     // arg: cycles - 1 requested; stopped by another command
+    CORE_TLM_SYS_CLOCK,         // arg: new system clock in kHz
+    CORE_TLM_SWEEP_COMPLETE,    // arg: last frequency in Hz, now held
+    CORE_TLM_SWEEP_ABORTED,     // aux: sweep_abort_t, arg: frequency in Hz when it stopped
+    CORE_TLM_COUNT,             // arg: sequence of a new frequency counter reading
+    CORE_TLM_DISCIPLINE         // aux: new discipline_state_t
+} clock_core_tlm_t;
+
+/**
+ * Launch core1 and wait until its engines are initialized (core0)
+ */
+void clock_core_launch(void);
+
+/**
+ * Post a command to core1 (core0)
+ * CORE_CMD_SET_MODE, CORE_CMD_UART_FREQ and CORE_CMD_HIGH_FREQ go to a
+ * mailbox slot and never wait: a newer post of the same command replaces
+ * one core1 has not run yet, and each still runs after the commands
+ * posted before it. Other commands wait only if the queue is full, for
+ * core1 to finish the one it is running; they are never dropped.
+ * @param cmd Command type
+ * @param arg Command argument
+ */
+void clock_core_post(clock_core_cmd_t cmd, uint32_t arg);
+
+/**
+ * Check whether core1 has executed every command posted so far (core0)
+ * Never blocks; core1 signals an event as each command completes.
+ * @return true if no posted command is waiting
+ */
+bool clock_core_caught_up(void);
+
+/**
+ * Wait until core1 has executed every command posted so far (core0)
+ * Use before reading engine state that a command changes.
+ */
+void clock_core_sync(void);
+
+/**
+ * Print pending telemetry from core1 (core0, call from the main loop)
+ */
+void clock_core_service(void);
+
+/**
+ * Send telemetry to core0 (core1)
+ * Never blocks; the message is dropped and counted if the queue is full.
+ * @param tlm Telemetry type
+ * @param aux Small auxiliary value
+ * @param arg Telemetry argument
+ */
+void clock_core_telemetry(clock_core_tlm_t tlm, uint8_t aux, uint32_t arg);
+
+/**
+ * Get number of telemetry messages dropped because core0 fell behind
+ * @return Dropped message count
+ */
+uint32_t clock_core_telemetry_dropped(void);
+
+#endif // CLOCK_CORE_H
@@ -5,121 +5,192 @@
 #include "clock_generator.h"
 #include "config.h"
 #include "hardware/gpio.h"
+#include "pio_clock.h"
+#include "pio_phase.h"
+#include "clock_cache.h"
+#include "pwm_clock.h"
+#include "pwm_solver.h"
+#include "duty_cycle.h"
+#include "sys_clock.h"
+#include "output_trace.h"
+#include "pot_sampler.h"
+#include "pot_filter.h"
+#include "hardware/clocks.h"
 
-// Static variables for clock generation
-static bool clock_state = false;
-static uint32_t current_frequency = 0;
-static bool single_step_active = false;
-
-// Timer for low frequency mode
-static struct repeating_timer low_freq_timer;
-static bool timer_active = false;
+// Static variables for clock generation (owned by core1, read by core0)
+static volatile bool clock_state = false;
+static volatile uint32_t current_frequency = 0;
+static volatile uint32_t current_millihz = 0;
+static volatile bool single_step_active = false;
+static volatile clock_mode_t engine_mode = MODE_SINGLE_STEP;
+static volatile uint32_t high_frequency = HIGH_FREQ_OUTPUT;
+static volatile duty_cycle_kind_t duty_kind = DUTY_CYCLE_RATIO;
+static volatile uint32_t duty_value = DUTY_CYCLE_DEFAULT;
+static volatile uint32_t achieved_ratio = DUTY_CYCLE_DEFAULT;
+static volatile uint32_t achieved_width_ns = 0;
+static volatile uint32_t achieved_steps = 0;
+static pot_filter_t pot_filter;
 
 void clock_generator_init(void) {
     clock_state = false;
     current_frequency = 0;
     single_step_active = false;
-    timer_active = false;
+    engine_mode = MODE_SINGLE_STEP;
+    high_frequency = HIGH_FREQ_OUTPUT;
+    duty_kind = DUTY_CYCLE_RATIO;
+    duty_value = DUTY_CYCLE_DEFAULT;
+    pio_clock_init();
+    pwm_clock_init();
+    pio_phase_init(); // Phases follow CLOCK_OUTPUT whichever engine drives it
 }
 
 void toggle_clock_output(void) {
     clock_state = !clock_state;
     gpio_put(CLOCK_OUTPUT, clock_state);
+    output_trace_edge(OUTPUT_TRACE_CLOCK, clock_state);
     gpio_put(LED_CLOCK_ACTIVITY, clock_state);
 }
 
 void set_clock_output(bool state) {
     clock_state = state;
     gpio_put(CLOCK_OUTPUT, state);
+    output_trace_edge(OUTPUT_TRACE_CLOCK, state);
     gpio_put(LED_CLOCK_ACTIVITY, state);
 }
 
 bool get_clock_state(void) {
+    // While the PIO engine drives the pin, report the actual pad level
+    if (pio_clock_is_running()) {
+        return gpio_get(CLOCK_OUTPUT);
+    }
     return clock_state;
 }
 
+_Static_assert((1u << POT_FILTER_BITS) == CLOCK_CACHE_ADC_ENTRIES * CLOCK_CACHE_POT_SUBSTEPS,
+               "Filtered pot positions must cover the interpolated frequency table");
+
 void update_low_frequency(void) {
-    // Read potentiometer value
-    uint16_t adc_value = adc_read();
-    uint32_t new_frequency = calculate_frequency_from_pot(adc_value);
+    // The ADC free-runs into a DMA ring; the filtered knob position only
+    // moves on a real turn, so noise never retunes the clock
+    pot_filter_update(&pot_filter, pot_sampler_sum(), POT_SAMPLE_COUNT);
+    uint16_t position = pot_filter_value(&pot_filter);
+    current_millihz = clock_cache_pot_millihz(position);
+    current_frequency = (current_millihz + 500) / 1000;
     
-    if (new_frequency != current_frequency) {
-        current_frequency = new_frequency;
-        
-        // Stop existing timer if active
-        if (timer_active) {
-            cancel_repeating_timer(&low_freq_timer);
-            timer_active = false;
-        }
-        
-        // Start new timer with calculated period
-        if (current_frequency > 0) {
-            uint32_t period_us = 1000000 / (current_frequency * 2); // Divide by 2 for 50% duty cycle
-            if (add_repeating_timer_us(-period_us, low_freq_timer_callback, NULL, &low_freq_timer)) {
-                timer_active = true;
-            }
-        }
+    // The PIO engine generates every edge in hardware; this only hands it a
+    // precomputed period split by the duty cycle (a no-op if unchanged,
+    // retried here if its FIFO was full)
+    if (current_millihz > 0) {
+        uint32_t period = clock_cache_pot_period(position);
+        duty_cycle_achieved_t achieved;
+        uint32_t high = clock_duty_split(period, PIO_CLOCK_HIGH_OVERHEAD, PIO_CLOCK_LOW_OVERHEAD,
+                                         sys_clock_get_hz(), 1, &achieved);
+        pio_clock_set_period(period, high);
+        set_achieved_duty(&achieved);
     }
 }
 
 uint32_t calculate_frequency_from_pot(uint16_t adc_value) {
-    // Scale ADC value (0-4095) to frequency range
-    // First 20% of pot range: 1Hz to 100Hz
-    // Remaining 80% of pot range: 100Hz to 100kHz
+    // The taper lives in the table generated from config.h (POT_TAPER)
+    return (clock_cache_pot_millihz((uint16_t)(adc_value * CLOCK_CACHE_POT_SUBSTEPS)) + 500) / 1000;
+}
+
+void start_high_frequency(void) {
+    // A new system clock needs the slice stopped; otherwise a running slice
+    // is retuned in place at a cycle boundary
+    uint32_t khz;
+    if (sys_clock_retune_for(high_frequency, PWM_SOLVER_PERIOD_MIN, &khz)) {
+        stop_high_frequency();
+        sys_clock_set_khz(khz);
+    }
     
-    if (adc_value <= 819) { // First 20% (4095 * 0.2 = 819)
-        // Linear scaling from 1Hz to 100Hz
-        return MIN_LOW_FREQ + ((adc_value * (MAX_LOW_FREQ_RANGE1 - MIN_LOW_FREQ)) / 819);
-    } else {
-        // Linear scaling from 100Hz to 100kHz
-        uint16_t scaled_adc = adc_value - 819; // 0 to 3276
-        return MAX_LOW_FREQ_RANGE1 + ((scaled_adc * (MAX_LOW_FREQ_RANGE2 - MAX_LOW_FREQ_RANGE1)) / 3276);
+    // Set up PWM solved against the trimmed system clock (divider 1, wrap
+    // 124 for 1MHz at 125MHz), up to sys_clk/2, then split for the duty cycle
+    pwm_solution_t solution;
+    if (pwm_solve(sys_clock_get_hz(), high_frequency, &solution)) {
+        duty_cycle_achieved_t achieved;
+        clock_duty_pwm(&solution, &achieved);
+        pwm_clock_start(&solution);
+        set_achieved_duty(&achieved);
     }
 }
 
-bool low_freq_timer_callback(struct repeating_timer *t) {
-    toggle_clock_output();
-    return true; // Continue timer
+void set_high_frequency(uint32_t frequency) {
+    high_frequency = frequency;
+    if (engine_mode == MODE_HIGH_FREQ) {
+        set_current_frequency(frequency);
+        start_high_frequency();
+    }
 }
 
-void start_high_frequency(void) {
-    // Set up PWM for 1MHz output with 50% duty cycle
-    uint slice_num = pwm_gpio_to_slice_num(CLOCK_OUTPUT);
-    
-    // Configure PWM
-    pwm_config config = pwm_get_default_config();
-    
-    // Calculate divider for 1MHz output
-    // System clock is typically 125MHz, so we need divider of 125 for 1MHz
-    pwm_config_set_clkdiv(&config, 125.0f);
-    pwm_config_set_wrap(&config, 1); // Wrap at 1 for 50% duty cycle
-    
-    pwm_init(slice_num, &config, true);
+uint32_t get_high_frequency(void) {
+    return high_frequency;
+}
+
+void set_clock_duty(duty_cycle_kind_t kind, uint32_t value) {
+    duty_kind = kind;
+    duty_value = value;
     
-    // Set 50% duty cycle
-    pwm_set_gpio_level(CLOCK_OUTPUT, 1);
+    // Running engines are retuned in place at their next cycle boundary;
+    // UART Control Mode is restarted by its owner
+    if (engine_mode == MODE_HIGH_FREQ) {
+        start_high_frequency();
+    } else if (engine_mode == MODE_LOW_FREQ) {
+        update_low_frequency();
+    }
+}
+
+duty_cycle_t get_clock_duty(void) {
+    duty_cycle_t duty = { .kind = duty_kind, .value = duty_value };
+    return duty;
+}
+
+void set_clock_wait(bool enabled) {
+    pio_clock_set_wait(enabled);
     
-    // Set function to PWM
-    gpio_set_function(CLOCK_OUTPUT, GPIO_FUNC_PWM);
+    // The PIO engine restarts itself, at a LOW level, to reload its program
+    if (engine_mode == MODE_LOW_FREQ) {
+        update_low_frequency();
+    }
+}
+
+uint32_t clock_duty_split(uint32_t period, uint32_t min_high, uint32_t min_low,
+                          uint64_t source_hz, uint32_t divider, duty_cycle_achieved_t *achieved) {
+    duty_cycle_t duty = get_clock_duty();
+    uint32_t high = duty_cycle_high_ticks(&duty, period, min_high, min_low, source_hz, divider);
+    duty_cycle_achieved(high, period, source_hz, divider, achieved);
+    return high;
+}
+
+void clock_duty_pwm(pwm_solution_t *solution, duty_cycle_achieved_t *achieved) {
+    // The output is HIGH while the counter is below the level, so one count
+    // each side keeps an edge in every period
+    uint32_t div16 = ((uint32_t)solution->div_int << 4) | solution->div_frac;
+    solution->level = (uint16_t)clock_duty_split(solution->wrap + 1u, 1, 1,
+                                                 16ull * sys_clock_get_hz(), div16, achieved);
+}
+
+void set_achieved_duty(const duty_cycle_achieved_t *achieved) {
+    achieved_ratio = achieved->ratio;
+    achieved_width_ns = achieved->width_ns;
+    achieved_steps = achieved->steps;
+}
+
+void get_achieved_duty(duty_cycle_achieved_t *out) {
+    out->ratio = achieved_ratio;
+    out->width_ns = achieved_width_ns;
+    out->steps = achieved_steps;
 }
 
 void stop_high_frequency(void) {
-    // Stop PWM and return GPIO to normal function
-    uint slice_num = pwm_gpio_to_slice_num(CLOCK_OUTPUT);
-    pwm_set_enabled(slice_num, false);
-    
-    // Return GPIO to normal output function
-    gpio_set_function(CLOCK_OUTPUT, GPIO_FUNC_SIO);
-    gpio_set_dir(CLOCK_OUTPUT, GPIO_OUT);
+    // Stop PWM at a LOW level and return GPIO to normal function
+    pwm_clock_stop();
     set_clock_output(false);
 }
 
 void stop_all_clock_generation(void) {
-    // Stop timer if active
-    if (timer_active) {
-        cancel_repeating_timer(&low_freq_timer);
-        timer_active = false;
-    }
+    // Stop PIO clock engine if active
+    pio_clock_stop();
     
     // Stop high frequency PWM
     stop_high_frequency();
@@ -128,12 +199,73 @@ void stop_all_clock_generation(void) {
     set_clock_output(false);
 }
 
+void update_clock_handover(void) {
+    pio_clock_update();
+    pwm_clock_update();
+}
+
+bool get_clock_handover_deadline(uint64_t *deadline_us) {
+    uint64_t pio_deadline;
+    uint64_t pwm_deadline;
+    bool pio_due = pio_clock_next_deadline(&pio_deadline);
+    bool pwm_due = pwm_clock_next_deadline(&pwm_deadline);
+    if (!pio_due && !pwm_due) return false;
+    
+    if (!pwm_due || (pio_due && pio_deadline < pwm_deadline)) {
+        *deadline_us = pio_deadline;
+    } else {
+        *deadline_us = pwm_deadline;
+    }
+    return true;
+}
+
+void clock_generator_apply_mode(clock_mode_t mode) {
+    // Stop all active clock generation
+    stop_all_clock_generation();
+    
+    set_single_step_active(false);
+    set_clock_output(false);
+    engine_mode = mode;
+    
+    switch (mode) {
+        case MODE_SINGLE_STEP:
+            set_current_frequency(0);
+            break;
+            
+        case MODE_LOW_FREQ:
+            // Start from the knob's current position rather than gliding there
+            pot_filter_init(&pot_filter, pot_sampler_sum(), POT_SAMPLE_COUNT,
+                            POT_FILTER_IIR_SHIFT, POT_HYSTERESIS);
+            update_low_frequency();
+            break;
+            
+        case MODE_HIGH_FREQ:
+            set_current_frequency(high_frequency);
+            start_high_frequency();
+            break;
+            
+        case MODE_UART_CONTROL:
+            // Started by UART commands
+            set_current_frequency(0);
+            break;
+    }
+}
+
+clock_mode_t get_engine_mode(void) {
+    return engine_mode;
+}
+
 uint32_t get_current_frequency(void) {
     return current_frequency;
 }
 
+uint32_t get_current_millihz(void) {
+    return current_millihz;
+}
+
 void set_current_frequency(uint32_t frequency) {
     current_frequency = frequency;
+    current_millihz = frequency * 1000u;
 }
 
 bool get_single_step_active(void) {
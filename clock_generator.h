@@ -4,6 +4,7 @@
  * This module handles all clock generation modes including single step,
  * low frequency, and high frequency modes. Provides a clean interface
  * for clock generation that can be reused in other projects.
+ * Runs on core1 (see clock_core.h); core0 only reads its state.
  */
 
 #ifndef CLOCK_GENERATOR_H
@@ -13,6 +14,9 @@
 #include "hardware/timer.h"
 #include "hardware/pwm.h"
 #include "hardware/adc.h"
+#include "button_handler.h"
+#include "duty_cycle.h"
+#include "pwm_solver.h"
 
 /**
  * Initialize clock generator module
@@ -44,21 +48,83 @@ void update_low_frequency(void);
 /**
  * Calculate frequency from potentiometer ADC value
  * @param adc_value Raw ADC reading (0-4095)
- * @return Calculated frequency in Hz
+ * @return Frequency in Hz for the POT_TAPER selected in config.h (rounded)
  */
 uint32_t calculate_frequency_from_pot(uint16_t adc_value);
 
 /**
- * Timer callback for low frequency mode
- * @param t Pointer to repeating timer structure
- * @return true to continue timer, false to stop
+ * Start high frequency PWM output at the frequency set for the mode
+ * With retuning on, the system clock is re-planned first if needed.
  */
-bool low_freq_timer_callback(struct repeating_timer *t);
+void start_high_frequency(void);
 
 /**
- * Start high frequency (1MHz) PWM output
+ * Set the High Frequency mode output, retuning it now if in that mode (core1)
+ * @param frequency Frequency in Hz (MIN_HIGH_FREQ up to sys_clk/2)
  */
-void start_high_frequency(void);
+void set_high_frequency(uint32_t frequency);
+
+/**
+ * Get the High Frequency mode output
+ * @return Frequency in Hz
+ */
+uint32_t get_high_frequency(void);
+
+/**
+ * Set the duty cycle or pulse width of every clock engine (core1)
+ * High Frequency and Low Frequency outputs are retuned now, at their next
+ * cycle boundary; other engines take it when they next start.
+ * @param kind DUTY_CYCLE_RATIO or DUTY_CYCLE_WIDTH
+ * @param value Duty in 1/DUTY_CYCLE_SCALE, or HIGH time in ns
+ */
+void set_clock_duty(duty_cycle_kind_t kind, uint32_t value);
+
+/**
+ * Get the duty cycle or pulse width the engines are asked for
+ * @return Duty cycle setting
+ */
+duty_cycle_t get_clock_duty(void);
+
+/**
+ * Set whether WAIT_INPUT can stretch the clock (core1)
+ * Only the PIO engine can hold the clock, so with WAIT on the UART clock
+ * runs on it too. Low Frequency output is restarted now to take it; other
+ * engines take it when they next start.
+ * @param enabled true to hold the clock HIGH while WAIT_INPUT is LOW
+ */
+void set_clock_wait(bool enabled);
+
+/**
+ * Split an engine's period by the duty cycle setting
+ * @param period Counter ticks per output period
+ * @param min_high Fewest ticks the engine can hold HIGH
+ * @param min_low Fewest ticks the engine can hold LOW
+ * @param source_hz Counter source frequency in Hz
+ * @param divider Source cycles per counter tick
+ * @param achieved Receives the duty cycle the split gives
+ * @return HIGH ticks
+ */
+uint32_t clock_duty_split(uint32_t period, uint32_t min_high, uint32_t min_low,
+                          uint64_t source_hz, uint32_t divider, duty_cycle_achieved_t *achieved);
+
+/**
+ * Set a PWM solution's compare level for the duty cycle setting
+ * @param solution Solution from pwm_solve() or the clock cache
+ * @param achieved Receives the duty cycle the level gives
+ */
+void clock_duty_pwm(pwm_solution_t *solution, duty_cycle_achieved_t *achieved);
+
+/**
+ * Record the duty cycle of the engine just started or retuned (core1)
+ * @param achieved From clock_duty_split() or clock_duty_pwm()
+ */
+void set_achieved_duty(const duty_cycle_achieved_t *achieved);
+
+/**
+ * Get the duty cycle of the engine last started or retuned
+ * @param out Achieved duty cycle
+ */
+void get_achieved_duty(duty_cycle_achieved_t *out);
 
 /**
  * Stop high frequency PWM output
@@ -70,12 +136,45 @@ void stop_high_frequency(void);
  */
 void stop_all_clock_generation(void);
 
+/**
+ * Finish engine handovers on CLOCK_OUTPUT (core1, call from the main loop)
+ * An engine stopped in a HIGH half lets it end before freeing the pin, and
+ * an engine started meanwhile waits for it; neither blocks the caller.
+ */
+void update_clock_handover(void);
+
+/**
+ * Get when update_clock_handover() next has work to do
+ * @param deadline_us Receives the time in microseconds
+ * @return true while a handover is in progress
+ */
+bool get_clock_handover_deadline(uint64_t *deadline_us);
+
+/**
+ * Stop the current clock engine and start the one for a mode (core1)
+ * @param mode Clock mode to generate
+ */
+void clock_generator_apply_mode(clock_mode_t mode);
+
+/**
+ * Get the mode the clock engines are currently generating
+ * Trails get_current_mode() until core1 has applied a mode change.
+ * @return Clock mode applied by clock_generator_apply_mode()
+ */
+clock_mode_t get_engine_mode(void);
+
 /**
  * Get current frequency
  * @return Current frequency in Hz (0 if stopped)
  */
 uint32_t get_current_frequency(void);
 
+/**
+ * Get current frequency with sub-hertz resolution
+ * @return Current frequency in millihertz (0 if stopped)
+ */
+uint32_t get_current_millihz(void);
+
 /**
  * Set current frequency (for display purposes)
  * @param frequency Frequency in Hz
@@ -0,0 +1,186 @@
+/**
+ * Command Table Module for Multimode Clock Source
+ */
+
+#include "command_table.h"
+#include <stddef.h>
+
+// FNV-1a over the name, folded into the index
+static uint32_t hash_name(const char *name, uint32_t length) {
+    uint32_t h = 2166136261u;
+    for (uint32_t i = 0; i < length; i++) {
+        h ^= (uint8_t)name[i];
+        h *= 16777619u;
+    }
+    return (h ^ (h >> 16)) & (COMMAND_TABLE_SLOTS - 1);
+}
+
+static uint32_t name_length(const char *name) {
+    uint32_t n = 0;
+    while (name[n]) n++;
+    return n;
+}
+
+static bool name_equals(const char *name, const char *s, uint32_t length) {
+    for (uint32_t i = 0; i < length; i++) {
+        if (name[i] != s[i]) return false;   // Also stops at the name's end
+    }
+    return name[length] == '\0';
+}
+
+void command_table_init(command_table_t *t, const command_t *commands, uint32_t count) {
+    t->commands = commands;
+    t->count = count;
+    for (uint32_t i = 0; i < COMMAND_TABLE_SLOTS; i++) {
+        t->slots[i] = 0;
+    }
+
+    // Linear probing; the table is at most half full so probes stay short
+    for (uint32_t i = 0; i < count && i < COMMAND_TABLE_SLOTS / 2; i++) {
+        uint32_t slot = hash_name(commands[i].name, name_length(commands[i].name));
+        while (t->slots[slot]) {
+            slot = (slot + 1) & (COMMAND_TABLE_SLOTS - 1);
+        }
+        t->slots[slot] = (uint8_t)(i + 1);
+    }
+}
+
+const command_t *command_table_find(const command_table_t *t, const char *name, uint32_t length) {
+    uint32_t slot = hash_name(name, length);
+    while (t->slots[slot]) {
+        const command_t *command = &t->commands[t->slots[slot] - 1];
+        if (name_equals(command->name, name, length)) return command;
+        slot = (slot + 1) & (COMMAND_TABLE_SLOTS - 1);
+    }
+    return NULL;
+}
+
+bool command_parse_number(const char *s, uint32_t length, uint32_t decimals, uint64_t *value) {
+    uint64_t mantissa = 0;
+    int32_t exponent = (int32_t)decimals;
+    uint32_t digits = 0;
+    bool saturated = false;
+    bool point = false;
+    uint32_t i = 0;
+
+    // Collect the digits as one integer and a power of ten
+    for (; i < length; i++) {
+        char c = s[i];
+        if (c >= '0' && c <= '9') {
+            digits++;
+            if (mantissa <= (UINT64_MAX - 9) / 10) {
+                mantissa = mantissa * 10 + (uint64_t)(c - '0');
+                if (point) exponent--;
+            } else if (!point) {
+                saturated = true;
+            } else if (c != '0' && !saturated) {
+                return false;       // More precision than can be kept
+            }
+        } else if (c == '.' && !point) {
+            point = true;
+        } else {
+            break;
+        }
+    }
+    if (digits == 0) return false;
+
+    if (i < length) {
+        switch (s[i]) {
+            case 'k': case 'K': exponent += 3; break;
+            case 'M':           exponent += 6; break;
+            case 'G':           exponent += 9; break;
+            default:            return false;
+        }
+        if (++i < length) return false;
+    }
+
+    // Digits below the requested precision must all be zero
+    for (; exponent < 0 && !saturated; exponent++) {
+        if (mantissa % 10 != 0) return false;
+        mantissa /= 10;
+    }
+    for (; exponent > 0 && !saturated; exponent--) {
+        if (mantissa > UINT64_MAX / 10) saturated = true;
+        mantissa *= 10;
+    }
+    *value = saturated ? UINT64_MAX : mantissa;
+    return true;
+}
+
+// Next space-separated word at or after *pos
+static bool next_word(const char *line, uint32_t length, uint32_t *pos,
+                      const char **word, uint32_t *word_length) {
+    uint32_t i = *pos;
+    while (i < length && line[i] == ' ') i++;
+    if (i == length) return false;
+
+    uint32_t start = i;
+    while (i < length && line[i] != ' ') i++;
+    *word = &line[start];
+    *word_length = i - start;
+    *pos = i;
+    return true;
+}
+
+static command_result_t parse_arg(const command_arg_t *arg, const char *word, uint32_t length,
+                                  uint64_t *value) {
+    if (arg->type == COMMAND_ARG_KEYWORD) {
+        for (uint32_t k = 0; arg->keywords[k]; k++) {
+            if (name_equals(arg->keywords[k], word, length)) {
+                *value = k;
+                return COMMAND_OK;
+            }
+        }
+        return COMMAND_BAD_ARG;
+    }
+
+    uint64_t n;
+    if (!command_parse_number(word, length, arg->decimals, &n)) return COMMAND_BAD_ARG;
+    if (n < arg->min || n > arg->max) return COMMAND_OUT_OF_RANGE;
+    *value = n;
+    return COMMAND_OK;
+}
+
+command_result_t command_table_parse(const command_table_t *t, const char *line, uint32_t length,
+                                     const command_t **command, uint64_t values[COMMAND_MAX_ARGS],
+                                     uint32_t *arg_index) {
+    uint32_t pos = 0;
+    const char *word;
+    uint32_t word_length;
+
+    if (!next_word(line, length, &pos, &word, &word_length)) return COMMAND_UNKNOWN;
+    const command_t *c = command_table_find(t, word, word_length);
+    if (!c) return COMMAND_UNKNOWN;
+
+    // Split out every word first: a line with more than the command takes
+    // is not that command at all
+    const char *arg_words[COMMAND_MAX_ARGS];
+    uint32_t arg_lengths[COMMAND_MAX_ARGS];
+    uint32_t given = 0;
+    while (next_word(line, length, &pos, &word, &word_length)) {
+        if (given == COMMAND_MAX_ARGS || c->args[given].type == COMMAND_ARG_NONE) return COMMAND_UNKNOWN;
+        arg_words[given] = word;
+        arg_lengths[given] = word_length;
+        given++;
+    }
+    *command = c;
+
+    for (uint32_t i = 0; i < COMMAND_MAX_ARGS; i++) {
+        const command_arg_t *arg = &c->args[i];
+        values[i] = 0;
+        if (arg->type == COMMAND_ARG_NONE) continue;
+
+        command_result_t result;
+        if (i < given) {
+            result = parse_arg(arg, arg_words[i], arg_lengths[i], &values[i]);
+        } else {
+            result = arg->optional ? COMMAND_OK : COMMAND_MISSING_ARG;
+            values[i] = arg->default_value;
+        }
+        if (result != COMMAND_OK) {
+            *arg_index = i;
+            return result;
+        }
+    }
+    return COMMAND_OK;
+}
@@ -0,0 +1,112 @@
+/**
+ * Command Table Module for Multimode Clock Source
+ *
+ * Static registry of text commands: name, argument schema, handler and
+ * help text in one table, from which both the dispatcher and the help menu
+ * are driven. Names are found through a small open-addressed hash index
+ * built once at startup, so lookup cost does not grow with the number of
+ * commands. Arguments are parsed by one locale-free routine that accepts
+ * an optional fraction and SI suffix ("250k", "1.5M").
+ *
+ * This module has no hardware access, so it can run anywhere.
+ */
+
+#ifndef COMMAND_TABLE_H
+#define COMMAND_TABLE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// Hash index size (a power of two, more than twice the command count)
+#define COMMAND_TABLE_SLOTS 64
+
+// Most arguments a command takes
+#define COMMAND_MAX_ARGS 4
+
+typedef enum {
+    COMMAND_ARG_NONE,       // No argument
+    COMMAND_ARG_NUMBER,     // Number to a fixed precision, SI suffix allowed ("1.5k" but not "1.2345k")
+    COMMAND_ARG_KEYWORD     // One of a list of words; the value is its index
+} command_arg_type_t;
+
+typedef struct {
+    command_arg_type_t type;
+    bool optional;                  // Missing argument takes default_value (last ones only)
+    uint8_t decimals;               // NUMBER: decimal places kept; value, min and max are in 10^-decimals
+    uint64_t min;                   // NUMBER: smallest value accepted
+    uint64_t max;                   // NUMBER: largest value accepted
+    uint64_t default_value;
+    const char *const *keywords;    // KEYWORD: NULL-terminated list
+    const char *what;               // Argument name for messages ("frequency")
+    const char *unit;               // NUMBER: unit for messages ("Hz")
+} command_arg_t;
+
+typedef struct {
+    const char *name;
+    const char *usage;              // Argument part of the menu line ("<Hz>"), or NULL
+    const char *help;
+    command_arg_t args[COMMAND_MAX_ARGS];   // In order; unused ones are COMMAND_ARG_NONE
+    void (*handler)(const uint64_t *values);
+} command_t;
+
+typedef struct {
+    const command_t *commands;
+    uint32_t count;
+    uint8_t slots[COMMAND_TABLE_SLOTS];    // Command index + 1, 0 if empty
+} command_table_t;
+
+typedef enum {
+    COMMAND_OK,
+    COMMAND_UNKNOWN,        // No such command (or more arguments than it takes)
+    COMMAND_MISSING_ARG,
+    COMMAND_BAD_ARG,        // Not a number, or not one of the keywords
+    COMMAND_OUT_OF_RANGE
+} command_result_t;
+
+/**
+ * Build the lookup index for a command table
+ * @param t Table
+ * @param commands Commands, in menu order (names must be unique)
+ * @param count Number of commands (less than COMMAND_TABLE_SLOTS / 2)
+ */
+void command_table_init(command_table_t *t, const command_t *commands, uint32_t count);
+
+/**
+ * Find a command by name
+ * @param t Table
+ * @param name Name (need not be null-terminated)
+ * @param length Length of name
+ * @return Command, or NULL if there is none by that name
+ */
+const command_t *command_table_find(const command_table_t *t, const char *name, uint32_t length);
+
+/**
+ * Parse a command line against the table
+ * Leading, trailing and repeated spaces are ignored.
+ * @param t Table
+ * @param line Command line (need not be null-terminated)
+ * @param length Length of line
+ * @param command Receives the command (set unless COMMAND_UNKNOWN)
+ * @param values Receives the argument values, 0 for those the command does
+ *               not take (set if COMMAND_OK)
+ * @param arg_index Receives the index of the argument at fault (set if
+ *                  COMMAND_MISSING_ARG, COMMAND_BAD_ARG or COMMAND_OUT_OF_RANGE)
+ * @return COMMAND_OK, or why the line was rejected
+ */
+command_result_t command_table_parse(const command_table_t *t, const char *line, uint32_t length,
+                                     const command_t **command, uint64_t values[COMMAND_MAX_ARGS],
+                                     uint32_t *arg_index);
+
+/**
+ * Parse a number with optional fraction and SI suffix (k, M, G)
+ * Only ASCII digits, one '.' and the suffix are accepted, whatever the
+ * C library locale, so "1.5M" is 1500000 and "250k" is 250000.
+ * @param s Text (need not be null-terminated)
+ * @param length Length of text
+ * @param decimals Decimal places kept (value is in units of 10^-decimals)
+ * @param value Receives the value (saturates at UINT64_MAX)
+ * @return true if the text is a number with no more than that precision
+ */
+bool command_parse_number(const char *s, uint32_t length, uint32_t decimals, uint64_t *value);
+
+#endif // COMMAND_TABLE_H
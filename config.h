@@ -26,44 +26,121 @@
 #define CLOCK_OUTPUT        9   // Main clock output pin
 #define RESET_OUTPUT        14  // Reset pulse output pin (high when not resetting, low during reset)
 #define POWER_OUTPUT        1   // Power control output (LOW = power ON, HIGH = power OFF)
+#define PHI1_OUTPUT         18  // Phase 1 output (HIGH while the clock is HIGH, minus dead time)
+#define PHI2_OUTPUT         19  // Phase 2 output (HIGH while the clock is LOW, minus dead time)
+#define PHI0_N_OUTPUT       20  // Inverted clock output
+#define SWEEP_FAULT_INPUT   21  // Sweep abort input (active LOW, internal pull-up)
+#define WAIT_INPUT          22  // Clock stretch input (active LOW, internal pull-up; holds the clock HIGH)
 #define POTENTIOMETER_PIN   26  // ADC0 - Potentiometer input (GPIO 26)
+#define FREQ_COUNTER_INPUT  27  // Frequency counter input (PWM slice 5 B; internal pull-down)
+#define REFERENCE_INPUT     28  // External reference input, 1PPS to 10MHz (internal pull-down)
 
 // Timing Configuration
 #define DEBOUNCE_DELAY_MS   50      // Button debounce delay in milliseconds
-#define UPDATE_INTERVAL_MS  10      // Main loop update interval
-#define RESET_CYCLES        6       // Number of clock cycles for reset pulse
+#define UART_HOLD_TIME_MS   3000    // Button hold time to enter UART Control Mode
+#define CORE1_POLL_INTERVAL_US 1000 // Core1 engine poll interval (potentiometer, reset, counter)
+#define RESET_CYCLES        6       // Default number of clock cycles for reset pulse
+#define MAX_RESET_CYCLES    1000000 // Largest reset pulse requested via UART
 #define RESET_HIGH_LED_MS   250     // Duration for reset high LED indicator
+#define RESET_STALL_MS      1000    // Release a reset pulse left waiting this long on a stopped UART clock
+
+// Two-Phase Clock Configuration
+#define PHI_DEAD_TIME_TICKS 4       // Default phi1/phi2 dead time in system clock cycles (32ns)
+#define PHI_DEAD_TIME_MIN   3       // Shortest dead time the phase program can time (24ns)
+#define PHI_DEAD_TIME_MAX   10000   // Longest dead time accepted (80us)
+
+// System Clock Configuration
+#define SYS_CLOCK_NOMINAL_KHZ 125000    // Boot system clock; retuning stays as close to it as it can
+#define SYS_CLOCK_MIN_KHZ   100000      // Slowest system clock a retune may choose
+#define SYS_CLOCK_MAX_KHZ   133000      // Fastest system clock (rated at the default core voltage)
 
 // Frequency Configuration
 #define MIN_LOW_FREQ        1       // Minimum frequency in Hz for low freq mode
 #define MAX_LOW_FREQ_RANGE1 100     // Maximum frequency for first 20% of pot range
 #define MAX_LOW_FREQ_RANGE2 100000  // Maximum frequency for remaining 80% of pot range
-#define HIGH_FREQ_OUTPUT    1000000 // Fixed high frequency output (1MHz)
+#define HIGH_FREQ_OUTPUT    1000000 // Default high frequency output (1MHz, changed with 'hfreq')
+#define MIN_HIGH_FREQ       1000    // Lowest high frequency output (1kHz)
 
-// Potentiometer Range Configuration
-#define POT_RANGE1_PERCENT  0.2f    // First range covers 20% of pot rotation
+// Potentiometer Range Configuration (POT_TAPER_LINEAR only, read by gen_clock_tables.py)
+#define POT_RANGE1_PERCENT  0.2f    // First range covers 20% of pot rotation (ADC 0-819)
 #define POT_RANGE2_PERCENT  0.8f    // Second range covers remaining 80%
 
-// PWM Configuration for High Frequency Mode
+// Potentiometer Taper (the pot-to-frequency table is generated at build time)
+#define POT_TAPER_LINEAR    0       // 1Hz-100Hz over 20%, then 100Hz-100kHz, in whole hertz
+#define POT_TAPER_LOG       1       // 1Hz-100kHz with the same ratio for every step
+#ifndef POT_TAPER
+#define POT_TAPER           POT_TAPER_LINEAR
+#endif
+
+// Potentiometer Sampling Configuration
+#define POT_ADC_SAMPLE_HZ   64000   // Free-running ADC sample rate
+#define POT_SAMPLE_RING_BITS 7      // DMA ring size as a power of two in bytes (64 samples, 1ms)
+#define POT_FILTER_IIR_SHIFT 3      // Ring sums are smoothed over about 2^3 polls
+#define POT_HYSTERESIS      16      // Knob movement in 14-bit steps that retunes the clock
+
+// PWM Configuration for the original fixed 1MHz output (main_original.c only;
+// High Frequency Mode now solves the divider for HIGH_FREQ_OUTPUT)
 #define PWM_CLOCK_DIVIDER   125.0f  // Clock divider for 1MHz output
 #define PWM_WRAP_VALUE      1       // PWM wrap value
 #define PWM_DUTY_CYCLE      1       // 50% duty cycle (1 out of 2)
 
-// PWM Configuration for UART Control Mode
-#define UART_PWM_DUTY_CYCLE_PERCENT 50  // 50% duty cycle for UART PWM mode
+// Duty Cycle Configuration (every running mode; 'duty' and 'width' change it)
+#define DUTY_CYCLE_DEFAULT  5000    // Boot duty cycle in hundredths of a percent (50%)
+#define DUTY_CYCLE_MIN      1       // 0.01%; every period still keeps at least one tick HIGH
+#define DUTY_CYCLE_MAX      9999    // 99.99%; and at least one tick LOW
+#define PULSE_WIDTH_MIN_NS  1       // Shortest fixed HIGH time asked for (rounded to a tick)
+#define PULSE_WIDTH_MAX_NS  1000000000 // Longest fixed HIGH time (1s)
+
+// Sweep Configuration ('sweep' ramps the clock, 'dwell' sets the step time)
+#define SWEEP_MAX_STEPS     256     // Steps solved ahead of a sweep (12 bytes each)
+#define SWEEP_DWELL_DEFAULT_MS 10   // Boot time per step
+#define SWEEP_DWELL_MAX_MS  60000   // Longest time per step (1 minute)
+#define SWEEP_DURATION_MIN_MS 2     // Shortest sweep (two steps of 1ms)
+#define SWEEP_DURATION_MAX_MS 3600000 // Longest sweep (1 hour)
+
+// Frequency Counter Configuration ('count' measures FREQ_COUNTER_INPUT or CLOCK_OUTPUT)
+#define FREQ_COUNTER_RESOLUTION_PPB 1000    // Gate time is chosen to resolve at least 1 ppm of a reading
+#define FREQ_COUNTER_GATES_MS { 10, 100, 1000 } // Gate times to choose from, shortest first
+#define FREQ_COUNTER_GATED_DIVISOR 12       // Gated counting above sys_clk/12...
+#define FREQ_COUNTER_RECIPROCAL_DIVISOR 16  // ...reciprocal below sys_clk/16, either in between
+#define FREQ_COUNTER_PROBE_MS 10            // First gated look at an unknown signal
+#define FREQ_COUNTER_TIMEOUT_MS 2500        // No reading for this long is no signal (two edges: slowest 0.8Hz)
+#define FREQ_COUNTER_TIMEBASE_SLICE 7       // PWM slice timing the gate (runs without a pin)
+
+// Reference Discipline Configuration ('ref' trims the system clock to REFERENCE_INPUT)
+#define DISCIPLINE_REF_MAX_HZ   10000000    // Fastest reference (sys_clk/10 at SYS_CLOCK_MIN_KHZ)
+#define DISCIPLINE_GATE_MS      1000        // Reference time each reading spans (one period of a 1PPS)
+#define DISCIPLINE_TIME_CONSTANT_S 16       // Loop time constant; averages reference jitter over about this long
+#define DISCIPLINE_LOCK_NS      200         // Phase error within this for DISCIPLINE_LOCK_READINGS is locked
+#define DISCIPLINE_LOCK_READINGS 8
+#define DISCIPLINE_SLIP_NS      10000       // Phase error beyond this starts acquiring again
+#define DISCIPLINE_MAX_PPM      200         // Larger offsets mean the reference is not the frequency set
+#define DISCIPLINE_TIMEOUT_MS   2500        // No reading for this long is a lost reference (holdover)
 
 // UART Configuration
 #define UART_BAUD_RATE      115200  // UART baud rate for status output
+#define UART_TX_BUFFER_SIZE 2048    // Transmit ring per UART in bytes (power of two)
+#define UART_RX_BUFFER_SIZE 1024    // Receive ring per UART in bytes (power of two)
 
 // UART Control Mode Configuration
-#define UART_MENU_TIMEOUT_MS    30000   // Menu timeout in milliseconds (30 seconds)
 #define UART_CMD_BUFFER_SIZE    32      // Command buffer size
 #define MIN_UART_FREQ           1       // Minimum frequency for UART mode (1Hz)
-#define MAX_UART_FREQ           1000000 // Maximum frequency for UART mode (1MHz)
+#define MAX_UART_FREQ           (SYS_CLOCK_MAX_KHZ * 500u) // sys_clk/2 at the fastest system clock (checked at the running one)
+#define MAX_BURST_CYCLES        4294967296ull // Longest burst (the PIO counts N - 1 in 32 bits)
+
+// Remote Control Configuration
+#define CONTROL_PANEL_HOLDOFF_MS 2000   // Remote changes refused after a front-panel action
+#define USB_RX_BUFFER_SIZE      1024    // Receive ring for commands over USB CDC (power of two)
 
 // Second UART Configuration
 #define UART1_TX_PIN        16      // UART1 TX pin (GPIO 16)
 #define UART1_RX_PIN        17      // UART1 RX pin (GPIO 17)
 #define UART1_BAUD_RATE     115200  // Second UART baud rate
 
+// Output Trace Configuration
+#define TRACE_EDGES         65536   // Edges held before the oldest are dropped
+#define TRACE_EDGE_MAX_US   (1u << 19)  // Longest gap between edges that still fits (about 0.5s)
+#define TRACE_EDGE_BYTES    3       // Worst-case entry for such an edge: varint of (delta << 2) | channel
+#define TRACE_BUFFER_SIZE   (TRACE_EDGES * TRACE_EDGE_BYTES)    // Trace RAM in bytes (192KB)
+
 #endif // CONFIG_H
\ No newline at end of file
@@ -0,0 +1,208 @@
+/**
+ * Control Arbiter Module for Multimode Clock Source
+ */
+
+#include "control_arbiter.h"
+#include "config.h"
+#include "clock_core.h"
+#include "uart_control.h"
+#include "sys_clock.h"
+
+static control_source_t last_source = CONTROL_SOURCE_PANEL;
+static uint64_t panel_holdoff_until = 0;   // Microseconds since boot
+
+static const char *const source_names[CONTROL_SOURCE_COUNT] = { "panel", "uart0", "uart1", "usb" };
+
+// External function declarations
+extern void set_mode(clock_mode_t mode);
+extern bool get_reset_active(void);
+extern void set_power_state(bool state);
+extern bool get_power_state(void);
+
+void control_arbiter_init(void) {
+    last_source = CONTROL_SOURCE_PANEL;
+    panel_holdoff_until = 0;
+}
+
+// Decide whether a request may change the outputs, and note who made it
+static control_arbiter_result_t admit(control_source_t source) {
+    uint64_t now = time_us_64();
+
+    if (source == CONTROL_SOURCE_PANEL) {
+        panel_holdoff_until = now + CONTROL_PANEL_HOLDOFF_MS * 1000ull;
+    } else if (any_button_pressed() || now < panel_holdoff_until) {
+        return CONTROL_ARBITER_PANEL_IN_USE;
+    }
+    last_source = source;
+    return CONTROL_ARBITER_OK;
+}
+
+// Clock commands act in UART Control Mode, which they select themselves
+static void select_uart_mode(void) {
+    if (get_current_mode() != MODE_UART_CONTROL) {
+        set_mode(MODE_UART_CONTROL);
+    }
+}
+
+control_arbiter_result_t control_arbiter_mode(control_source_t source, clock_mode_t mode) {
+    control_arbiter_result_t result = admit(source);
+    if (result != CONTROL_ARBITER_OK) return result;
+
+    // Selecting the current mode again restarts it, as its button always did
+    set_mode(mode);
+    return CONTROL_ARBITER_OK;
+}
+
+control_arbiter_result_t control_arbiter_step(control_source_t source) {
+    control_arbiter_result_t result = admit(source);
+    if (result != CONTROL_ARBITER_OK) return result;
+
+    if (get_current_mode() == MODE_SINGLE_STEP) {
+        // Toggle clock in single step mode (on core1)
+        clock_core_post(CORE_CMD_STEP, 0);
+    } else {
+        set_mode(MODE_SINGLE_STEP);
+    }
+    return CONTROL_ARBITER_OK;
+}
+
+control_arbiter_result_t control_arbiter_freq(control_source_t source, uint32_t frequency) {
+    control_arbiter_result_t result = admit(source);
+    if (result != CONTROL_ARBITER_OK) return result;
+
+    select_uart_mode();
+    uart_control_freq(frequency);
+    return CONTROL_ARBITER_OK;
+}
+
+control_arbiter_result_t control_arbiter_burst(control_source_t source, uint64_t cycles, uint32_t frequency) {
+    control_arbiter_result_t result = admit(source);
+    if (result != CONTROL_ARBITER_OK) return result;
+
+    select_uart_mode();
+    uart_control_burst(cycles, frequency);
+    return CONTROL_ARBITER_OK;
+}
+
+control_arbiter_result_t control_arbiter_sweep(control_source_t source, const sweep_plan_t *plan, uint32_t dwell_us) {
+    control_arbiter_result_t result = admit(source);
+    if (result != CONTROL_ARBITER_OK) return result;
+
+    select_uart_mode();
+    uart_control_sweep(plan, dwell_us);
+    return CONTROL_ARBITER_OK;
+}
+
+control_arbiter_result_t control_arbiter_stop(control_source_t source) {
+    control_arbiter_result_t result = admit(source);
+    if (result != CONTROL_ARBITER_OK) return result;
+
+    select_uart_mode();
+    uart_control_stop();
+    return CONTROL_ARBITER_OK;
+}
+
+control_arbiter_result_t control_arbiter_toggle(control_source_t source, bool *level) {
+    control_arbiter_result_t result = admit(source);
+    if (result != CONTROL_ARBITER_OK) return result;
+
+    select_uart_mode();
+    *level = uart_control_toggle();
+    return CONTROL_ARBITER_OK;
+}
+
+control_arbiter_result_t control_arbiter_reset(control_source_t source, uint32_t cycles, bool *released) {
+    control_arbiter_result_t result = admit(source);
+    if (result != CONTROL_ARBITER_OK) return result;
+
+    // The pulse itself is generated on core1; waiting for it to start lets
+    // the very next request see it and release it
+    *released = get_reset_active();
+    clock_core_post(*released ? CORE_CMD_RESET_RELEASE : CORE_CMD_RESET_PULSE, cycles);
+    clock_core_sync();
+    return CONTROL_ARBITER_OK;
+}
+
+control_arbiter_result_t control_arbiter_power(control_source_t source, bool on, bool *switched_mode) {
+    control_arbiter_result_t result = admit(source);
+    if (result != CONTROL_ARBITER_OK) return result;
+
+    bool old_power_state = get_power_state();
+    set_power_state(on);
+
+    // If power just turned ON (OFF->ON transition), switch to Mode 1
+    *switched_mode = on && !old_power_state && get_power_state();
+    if (*switched_mode) {
+        set_mode(MODE_SINGLE_STEP);
+    }
+    return CONTROL_ARBITER_OK;
+}
+
+control_arbiter_result_t control_arbiter_dead_time(control_source_t source, uint32_t ticks) {
+    control_arbiter_result_t result = admit(source);
+    if (result != CONTROL_ARBITER_OK) return result;
+
+    // The phases follow the clock in every mode, so no mode change
+    clock_core_post(CORE_CMD_DEAD_TIME, ticks);
+    clock_core_sync();
+    return CONTROL_ARBITER_OK;
+}
+
+control_arbiter_result_t control_arbiter_high_freq(control_source_t source, uint32_t frequency) {
+    control_arbiter_result_t result = admit(source);
+    if (result != CONTROL_ARBITER_OK) return result;
+
+    // A setting for the mode; it only changes the output while in the mode
+    clock_core_post(CORE_CMD_HIGH_FREQ, frequency);
+    clock_core_sync();
+    return CONTROL_ARBITER_OK;
+}
+
+// Core1 applies a setting to the mode's own engines; a clock run by
+// command starts again at the frequency it was asked for
+static void restart_uart_clock(void) {
+    if (get_current_mode() == MODE_UART_CONTROL && get_uart_clock_running()) {
+        uart_control_freq(get_uart_set_frequency());
+    } else {
+        clock_core_sync();
+    }
+}
+
+control_arbiter_result_t control_arbiter_sys_clock(control_source_t source, uint32_t khz) {
+    control_arbiter_result_t result = admit(source);
+    if (result != CONTROL_ARBITER_OK) return result;
+
+    // A clock chosen by hand stays until changed by hand
+    sys_clock_set_retune(false);
+    clock_core_post(CORE_CMD_SYS_CLOCK, khz);
+    restart_uart_clock();
+    return CONTROL_ARBITER_OK;
+}
+
+control_arbiter_result_t control_arbiter_duty(control_source_t source, duty_cycle_kind_t kind, uint32_t value) {
+    control_arbiter_result_t result = admit(source);
+    if (result != CONTROL_ARBITER_OK) return result;
+
+    // A setting for every mode, so no mode change
+    clock_core_post(kind == DUTY_CYCLE_WIDTH ? CORE_CMD_PULSE_WIDTH : CORE_CMD_DUTY, value);
+    restart_uart_clock();
+    return CONTROL_ARBITER_OK;
+}
+
+control_arbiter_result_t control_arbiter_wait(control_source_t source, bool on) {
+    control_arbiter_result_t result = admit(source);
+    if (result != CONTROL_ARBITER_OK) return result;
+
+    // A setting for every mode; the clock moves onto the PIO engine with it
+    clock_core_post(CORE_CMD_WAIT, on);
+    restart_uart_clock();
+    return CONTROL_ARBITER_OK;
+}
+
+control_source_t control_arbiter_last_source(void) {
+    return last_source;
+}
+
+const char *control_arbiter_source_name(control_source_t source) {
+    return source < CONTROL_SOURCE_COUNT ? source_names[source] : "?";
+}
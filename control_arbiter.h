@@ -0,0 +1,180 @@
+/**
+ * Control Arbiter Module for Multimode Clock Source
+ *
+ * The one entry point for every change of mode, clock, reset or power,
+ * whether it comes from the front panel or from a remote command on UART0,
+ * UART1 or USB. Requests run one at a time on core0, each to completion
+ * (core1 has applied it before the next starts), and a person at the bench
+ * wins over a script: while a mode button is held, and for
+ * CONTROL_PANEL_HOLDOFF_MS after any front-panel action, remote requests
+ * that would change the outputs are refused.
+ *
+ * Remote clock commands (freq, burst, sweep, stop, toggle) select UART Control
+ * Mode by themselves; there is no menu to enter first and no inactivity
+ * timeout.
+ */
+
+#ifndef CONTROL_ARBITER_H
+#define CONTROL_ARBITER_H
+
+#include "pico/stdlib.h"
+#include "button_handler.h"
+#include "duty_cycle.h"
+#include "sweep_plan.h"
+
+typedef enum {
+    CONTROL_SOURCE_PANEL,   // Front-panel buttons
+    CONTROL_SOURCE_UART0,
+    CONTROL_SOURCE_UART1,
+    CONTROL_SOURCE_USB,
+    CONTROL_SOURCE_COUNT
+} control_source_t;
+
+typedef enum {
+    CONTROL_ARBITER_OK,
+    CONTROL_ARBITER_PANEL_IN_USE    // Refused: the front panel has control
+} control_arbiter_result_t;
+
+/**
+ * Initialize the arbiter
+ */
+void control_arbiter_init(void);
+
+/**
+ * Switch mode
+ * @param source Requester
+ * @param mode New mode (no change if already in it)
+ * @return CONTROL_ARBITER_OK, or why the request was refused
+ */
+control_arbiter_result_t control_arbiter_mode(control_source_t source, clock_mode_t mode);
+
+/**
+ * Front-panel step: toggle the clock in Single Step mode, or switch to it
+ * @param source Requester
+ * @return CONTROL_ARBITER_OK, or why the request was refused
+ */
+control_arbiter_result_t control_arbiter_step(control_source_t source);
+
+/**
+ * Run the clock at a frequency in UART Control Mode
+ * @param source Requester
+ * @param frequency Frequency in Hz (MIN_UART_FREQ to MAX_UART_FREQ)
+ * @return CONTROL_ARBITER_OK, or why the request was refused
+ */
+control_arbiter_result_t control_arbiter_freq(control_source_t source, uint32_t frequency);
+
+/**
+ * Run exactly N clock cycles in UART Control Mode, then stop LOW
+ * Returns once the burst has started; completion is reported later.
+ * @param source Requester
+ * @param cycles Number of cycles (1 to MAX_BURST_CYCLES)
+ * @param frequency Frequency in Hz (MIN_UART_FREQ to MAX_UART_FREQ)
+ * @return CONTROL_ARBITER_OK, or why the request was refused
+ */
+control_arbiter_result_t control_arbiter_burst(control_source_t source, uint64_t cycles, uint32_t frequency);
+
+/**
+ * Ramp the clock between two frequencies in UART Control Mode
+ * Returns once the sweep has started; completion is reported later.
+ * @param source Requester
+ * @param plan Sweep plan (limits on one engine, see sweep_engine_for())
+ * @param dwell_us Time each step runs for in microseconds
+ * @return CONTROL_ARBITER_OK, or why the request was refused
+ */
+control_arbiter_result_t control_arbiter_sweep(control_source_t source, const sweep_plan_t *plan, uint32_t dwell_us);
+
+/**
+ * Stop the clock in UART Control Mode
+ * @param source Requester
+ * @return CONTROL_ARBITER_OK, or why the request was refused
+ */
+control_arbiter_result_t control_arbiter_stop(control_source_t source);
+
+/**
+ * Toggle the clock once in UART Control Mode (stops a running clock)
+ * @param source Requester
+ * @param level Receives the new clock level
+ * @return CONTROL_ARBITER_OK, or why the request was refused
+ */
+control_arbiter_result_t control_arbiter_toggle(control_source_t source, bool *level);
+
+/**
+ * Start a reset pulse, or release the one in progress
+ * @param source Requester
+ * @param cycles Pulse length in clock cycles (1 to MAX_RESET_CYCLES)
+ * @param released Receives true if a pulse was in progress and is now released
+ * @return CONTROL_ARBITER_OK, or why the request was refused
+ */
+control_arbiter_result_t control_arbiter_reset(control_source_t source, uint32_t cycles, bool *released);
+
+/**
+ * Switch the target's power; turning it on selects Single Step mode
+ * @param source Requester
+ * @param on true to turn power ON
+ * @param switched_mode Receives true if the mode switched to Single Step
+ * @return CONTROL_ARBITER_OK, or why the request was refused
+ */
+control_arbiter_result_t control_arbiter_power(control_source_t source, bool on, bool *switched_mode);
+
+/**
+ * Set the dead time between the phi1 and phi2 outputs, in any mode
+ * @param source Requester
+ * @param ticks Dead time in system clock cycles (PHI_DEAD_TIME_MIN to PHI_DEAD_TIME_MAX)
+ * @return CONTROL_ARBITER_OK, or why the request was refused
+ */
+control_arbiter_result_t control_arbiter_dead_time(control_source_t source, uint32_t ticks);
+
+/**
+ * Set the frequency High Frequency mode runs at; retunes it now if in that mode
+ * @param source Requester
+ * @param frequency Frequency in Hz (MIN_HIGH_FREQ up to sys_clk/2)
+ * @return CONTROL_ARBITER_OK, or why the request was refused
+ */
+control_arbiter_result_t control_arbiter_high_freq(control_source_t source, uint32_t frequency);
+
+/**
+ * Set the system clock by hand, which turns retuning off
+ * The engines stop and the current mode starts again on the new clock.
+ * @param source Requester
+ * @param khz System clock in kHz (sys_clock_valid())
+ * @return CONTROL_ARBITER_OK, or why the request was refused
+ */
+control_arbiter_result_t control_arbiter_sys_clock(control_source_t source, uint32_t khz);
+
+/**
+ * Set the duty cycle or HIGH pulse width of the clock, in any mode
+ * A running clock takes it at its next cycle boundary; a burst in progress
+ * keeps its own until it ends.
+ * @param source Requester
+ * @param kind DUTY_CYCLE_RATIO or DUTY_CYCLE_WIDTH
+ * @param value Duty (DUTY_CYCLE_MIN to DUTY_CYCLE_MAX) or width in ns
+ *              (PULSE_WIDTH_MIN_NS to PULSE_WIDTH_MAX_NS)
+ * @return CONTROL_ARBITER_OK, or why the request was refused
+ */
+control_arbiter_result_t control_arbiter_duty(control_source_t source, duty_cycle_kind_t kind, uint32_t value);
+
+/**
+ * Let WAIT_INPUT stretch the clock, or ignore it, in any mode
+ * With WAIT on, clocks run on the PIO engine (up to sys_clk/PIO_CLOCK_PERIOD_MIN);
+ * High Frequency mode stays on the PWM slice and is never stretched. A burst
+ * or sweep in progress keeps its setting until it ends.
+ * @param source Requester
+ * @param on true to hold the clock HIGH while WAIT_INPUT is LOW
+ * @return CONTROL_ARBITER_OK, or why the request was refused
+ */
+control_arbiter_result_t control_arbiter_wait(control_source_t source, bool on);
+
+/**
+ * Get the source of the last accepted request
+ * @return Source
+ */
+control_source_t control_arbiter_last_source(void);
+
+/**
+ * Get a source's name for messages
+ * @param source Source
+ * @return "panel", "uart0", "uart1" or "usb"
+ */
+const char *control_arbiter_source_name(control_source_t source);
+
+#endif // CONTROL_ARBITER_H
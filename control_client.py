@@ -0,0 +1,335 @@
+#!/usr/bin/env python3
+"""
+Binary control protocol client for Multimode Clock Source
+
+Reference host-side implementation of the frame format in control_frame.h:
+
+    0x00, COBS(seq, opcode, payload..., crc16 low, crc16 high), 0x00
+
+with CRC-16/CCITT-FALSE over seq, opcode and payload. Replies carry the
+request's sequence number, the opcode with 0x80 set and a status byte
+first in the payload. Text from the menu may arrive between frames and is
+passed through separately.
+
+Usage:
+  control_client.py PORT COMMAND [ARG...]   Send one command over a serial
+                                            port (needs pyserial)
+  control_client.py encode COMMAND [ARG...] Print a request frame as hex
+  control_client.py decode HEX              Decode frames from a hex dump
+
+Commands: ping, freq <Hz>, burst <cycles> <Hz>, stop, toggle, reset [cycles],
+power <on|off>, status, mode <step|low|high|uart>, deadtime <ticks>,
+hfreq <Hz>, sysclk [kHz], retune <on|off>, duty <percent>, width <ns>
+(duty and width share one opcode), sweep <Hz> <Hz> <ms> [dwell ms] [lin|log],
+wait <on|off>, count [on|off|loop], ref [Hz] (0 for off).
+"""
+
+import argparse
+import struct
+import sys
+
+DELIMITER = 0x00
+REPLY = 0x80
+MAX_PAYLOAD = 20
+
+OPCODES = {
+    'ping': 0x00,
+    'freq': 0x01,
+    'stop': 0x02,
+    'toggle': 0x03,
+    'reset': 0x04,
+    'power': 0x05,
+    'status': 0x06,
+    'mode': 0x07,
+    'burst': 0x08,
+    'deadtime': 0x09,
+    'hfreq': 0x0A,
+    'sysclk': 0x0B,
+    'retune': 0x0C,
+    'duty': 0x0D,
+    'sweep': 0x0E,
+    'wait': 0x0F,
+    'count': 0x10,
+    'ref': 0x11,
+}
+OPCODE_NAMES = {value: name for name, value in OPCODES.items()}
+
+STATUS_NAMES = {
+    0: 'ok',
+    1: 'unknown opcode',
+    2: 'bad length',
+    3: 'out of range',
+    4: 'front panel in use',
+}
+
+MODE_NAMES = {0: 'single step', 1: 'low frequency', 2: 'high frequency', 3: 'uart control'}
+MODE_ARGS = ['step', 'low', 'high', 'uart']
+COUNT_ARGS = ['off', 'on', 'loop']
+COUNT_INPUTS = {0: 'off', 1: 'counter input', 2: 'loopback'}
+COUNT_ENGINES = {0: 'gated', 1: 'reciprocal'}
+REFERENCE_STATES = {0: 'off', 1: 'no reference', 2: 'acquiring', 3: 'locked', 4: 'holdover',
+                    5: 'not at the frequency set'}
+
+FLAG_NAMES = [(0x01, 'clock high'), (0x02, 'power on'), (0x04, 'running'),
+              (0x08, 'reset active'), (0x10, 'pwm'), (0x20, 'burst'), (0x40, 'sweep'),
+              (0x80, 'wait')]
+
+
+def crc16(data, crc=0xFFFF):
+    """CRC-16/CCITT-FALSE."""
+    for byte in data:
+        crc ^= byte << 8
+        for _ in range(8):
+            crc = ((crc << 1) ^ 0x1021) if crc & 0x8000 else (crc << 1)
+            crc &= 0xFFFF
+    return crc
+
+
+def cobs_encode(data):
+    out = bytearray([0])
+    code_index = 0
+    code = 1
+    for byte in data:
+        if byte == 0:
+            out[code_index] = code
+            code_index = len(out)
+            out.append(0)
+            code = 1
+        else:
+            out.append(byte)
+            code += 1
+            if code == 0xFF:
+                out[code_index] = code
+                code_index = len(out)
+                out.append(0)
+                code = 1
+    out[code_index] = code
+    return bytes(out)
+
+
+def cobs_decode(data):
+    out = bytearray()
+    i = 0
+    while i < len(data):
+        code = data[i]
+        i += 1
+        if code == 0 or i + code - 1 > len(data):
+            raise ValueError('bad COBS block')
+        out += data[i:i + code - 1]
+        i += code - 1
+        if code < 0xFF and i < len(data):
+            out.append(0)
+    return bytes(out)
+
+
+def encode_frame(seq, opcode, payload=b''):
+    """Frame bytes, both delimiters included."""
+    if len(payload) > MAX_PAYLOAD:
+        raise ValueError('payload too long')
+    body = bytes([seq & 0xFF, opcode]) + bytes(payload)
+    body += struct.pack('<H', crc16(body))
+    return bytes([DELIMITER]) + cobs_encode(body) + bytes([DELIMITER])
+
+
+def decode_frame(encoded):
+    """Decode the bytes between two delimiters into (seq, opcode, payload)."""
+    body = cobs_decode(encoded)
+    if len(body) < 4:
+        raise ValueError('frame too short')
+    (crc,) = struct.unpack('<H', body[-2:])
+    if crc16(body[:-2]) != crc:
+        raise ValueError('bad CRC')
+    return body[0], body[1], body[2:-2]
+
+
+class StreamDecoder:
+    """Split a received byte stream into text and frames.
+
+    feed() returns a list of ('text', bytes) and ('frame', seq, opcode,
+    payload) items; corrupt frames are returned as ('error', reason).
+    """
+
+    def __init__(self):
+        self.in_frame = False
+        self.pending = bytearray()
+
+    def feed(self, data):
+        items = []
+        for byte in data:
+            if byte == DELIMITER:
+                if self.in_frame and self.pending:
+                    try:
+                        items.append(('frame',) + decode_frame(bytes(self.pending)))
+                    except ValueError as e:
+                        items.append(('error', str(e)))
+                    self.in_frame = False
+                else:
+                    if self.pending:
+                        items.append(('text', bytes(self.pending)))
+                    self.in_frame = True
+                self.pending.clear()
+            else:
+                self.pending.append(byte)
+        if not self.in_frame and self.pending:
+            items.append(('text', bytes(self.pending)))
+            self.pending.clear()
+        return items
+
+
+SWEEP_DWELL_DEFAULT_MS = 10
+SWEEP_SHAPES = ['lin', 'log']
+
+
+def request_payload(command, arg=None, arg2=None, more=()):
+    """Opcode and payload for a command name and optional arguments."""
+    if command == 'width':
+        return OPCODES['duty'], struct.pack('<BI', 1, int(arg))
+    opcode = OPCODES[command]
+    if command == 'duty':
+        return opcode, struct.pack('<BI', 0, round(float(arg) * 100))
+    if command == 'freq':
+        return opcode, struct.pack('<I', int(arg))
+    if command in ('deadtime', 'hfreq'):
+        return opcode, struct.pack('<I', int(arg))
+    if command == 'sysclk' and arg is not None:
+        return opcode, struct.pack('<I', int(arg))
+    if command in ('retune', 'wait'):
+        return opcode, bytes([1 if arg == 'on' else 0])
+    if command == 'burst':
+        return opcode, struct.pack('<QI', int(arg), int(arg2))
+    if command == 'sweep':
+        shape = more[-1] if more and more[-1] in SWEEP_SHAPES else 'lin'
+        numbers = [word for word in more if word not in SWEEP_SHAPES]
+        dwell = int(numbers[1]) if len(numbers) > 1 else SWEEP_DWELL_DEFAULT_MS
+        return opcode, struct.pack('<IIIIB', int(arg), int(arg2), int(numbers[0]), dwell,
+                                   SWEEP_SHAPES.index(shape))
+    if command == 'reset' and arg is not None:
+        return opcode, struct.pack('<I', int(arg))
+    if command == 'power':
+        return opcode, bytes([1 if arg == 'on' else 0])
+    if command == 'mode':
+        return opcode, bytes([MODE_ARGS.index(arg)])
+    if command == 'count' and arg is not None:
+        return opcode, bytes([COUNT_ARGS.index(arg)])
+    if command == 'ref' and arg is not None:
+        return opcode, struct.pack('<I', int(arg))
+    return opcode, b''
+
+
+def describe_reply(opcode, payload):
+    """Human-readable form of a reply."""
+    name = OPCODE_NAMES.get(opcode & ~REPLY, hex(opcode))
+    status = STATUS_NAMES.get(payload[0], str(payload[0])) if payload else 'empty'
+    text = f'{name}: {status}'
+    if not payload or payload[0] != 0:
+        return text
+    data = payload[1:]
+    if name in ('freq', 'burst'):
+        millihz, ppb = struct.unpack('<Qi', data)
+        text += f', achieved {millihz // 1000}.{millihz % 1000:03d} Hz, error {ppb / 1000:+.3f} ppm'
+    elif name == 'sysclk':
+        hz, retune = struct.unpack('<IB', data)
+        text += f', system clock {hz / 1e6:.3f} MHz, retune ' + ('on' if retune else 'off')
+    elif name == 'duty':
+        ratio, width_ns, steps = struct.unpack('<III', data)
+        text += f', duty {ratio // 100}.{ratio % 100:02d}%, HIGH {width_ns} ns, {steps} steps per period'
+    elif name == 'sweep':
+        steps, dwell_us = struct.unpack('<II', data)
+        text += f', {steps} steps of {dwell_us / 1000:.3f} ms'
+    elif name == 'wait':
+        text += f', {struct.unpack("<I", data)[0]} cycles stretched'
+    elif name == 'count':
+        source, state, engine, millihz, span_us, ppb = struct.unpack('<BBBQII', data)
+        text += ', ' + COUNT_INPUTS.get(source, str(source))
+        if source and state == 0:
+            text += ', measuring'
+        elif source and state == 1:
+            text += ', no signal'
+        elif source:
+            text += (f', {millihz // 1000}.{millihz % 1000:03d} Hz ({COUNT_ENGINES.get(engine, engine)}, '
+                     f'gate {span_us / 1000:.3f} ms, resolution {ppb / 1000:.3f} ppm)')
+    elif name == 'ref':
+        state, ref_hz, trim_ppb, phase_ns = struct.unpack('<BIii', data)
+        text += ', ' + REFERENCE_STATES.get(state, str(state))
+        if state:
+            text += f', {ref_hz} Hz reference'
+        if state in (2, 3, 4):
+            text += f', crystal {trim_ppb / 1000:+.3f} ppm'
+        if state in (2, 3):
+            text += f', phase {phase_ns:+d} ns'
+    elif name == 'toggle':
+        text += ', clock ' + ('HIGH' if data[0] else 'LOW')
+    elif name == 'reset':
+        text += ', released' if data[0] else ', started'
+    elif name == 'status':
+        mode, flags, hz, millihz = struct.unpack('<BBII', data)
+        names = [flag_name for bit, flag_name in FLAG_NAMES if flags & bit]
+        text += (f', mode {MODE_NAMES.get(mode, mode)}, {hz} Hz '
+                 f'({millihz // 1000}.{millihz % 1000:03d} Hz), ' + (', '.join(names) or 'idle'))
+    return text
+
+
+class Client:
+    """Request/reply over a serial port (pyserial)."""
+
+    def __init__(self, port, baudrate=115200, timeout=1.0):
+        import serial
+        self.serial = serial.Serial(port, baudrate, timeout=timeout)
+        self.decoder = StreamDecoder()
+        self.seq = 0
+
+    def request(self, opcode, payload=b''):
+        """Send a request and return the reply payload (status byte first)."""
+        self.seq = (self.seq + 1) & 0xFF
+        self.serial.write(encode_frame(self.seq, opcode, payload))
+        while True:
+            data = self.serial.read(1) + self.serial.read(self.serial.in_waiting)
+            if not data:
+                raise TimeoutError('no reply')
+            for item in self.decoder.feed(data):
+                if item[0] == 'frame' and item[1] == self.seq and item[2] == opcode | REPLY:
+                    return item[3]
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Binary control protocol client')
+    parser.add_argument('target', help='serial port, "encode" or "decode"')
+    parser.add_argument('command')
+    parser.add_argument('arg', nargs='?')
+    parser.add_argument('arg2', nargs='?', help='frequency for burst, end frequency for sweep')
+    parser.add_argument('more', nargs='*', help='sweep duration ms, then optional dwell ms and lin|log')
+    parser.add_argument('--baud', type=int, default=115200)
+    parser.add_argument('--seq', type=int, default=1, help='sequence number for encode')
+    args = parser.parse_args()
+
+    if args.target == 'decode':
+        for item in StreamDecoder().feed(bytes.fromhex(args.command)):
+            if item[0] == 'frame':
+                print(f'seq {item[1]}: ' + describe_reply(item[2], item[3]))
+            elif item[0] == 'error':
+                print('corrupt frame: ' + item[1])
+        return 0
+
+    if args.command not in OPCODES and args.command != 'width':
+        parser.error('unknown command ' + args.command)
+    if args.command == 'mode' and args.arg not in MODE_ARGS:
+        parser.error('mode is one of ' + ', '.join(MODE_ARGS))
+    if args.command == 'count' and args.arg is not None and args.arg not in COUNT_ARGS:
+        parser.error('count takes ' + ', '.join(COUNT_ARGS) + ', or nothing to read')
+    if args.command == 'burst' and args.arg2 is None:
+        parser.error('burst takes a cycle count and a frequency')
+    if args.command == 'sweep' and (args.arg2 is None or not args.more or args.more[0] in SWEEP_SHAPES):
+        parser.error('sweep takes two frequencies and a duration in ms')
+    opcode, payload = request_payload(args.command, args.arg, args.arg2, args.more)
+
+    if args.target == 'encode':
+        print(encode_frame(args.seq, opcode, payload).hex())
+        return 0
+
+    client = Client(args.target, args.baud)
+    print(describe_reply(opcode | REPLY, client.request(opcode, payload)))
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
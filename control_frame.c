@@ -0,0 +1,85 @@
+/**
+ * Control Frame Module for Multimode Clock Source
+ */
+
+#include "control_frame.h"
+
+uint16_t control_frame_crc16(uint16_t crc, const uint8_t *data, uint32_t length) {
+    // Byte-wise form of the 0x1021 polynomial, no table needed
+    for (uint32_t i = 0; i < length; i++) {
+        crc = (uint16_t)((crc >> 8) | (crc << 8));
+        crc ^= data[i];
+        crc ^= (crc & 0xff) >> 4;
+        crc ^= (uint16_t)(crc << 12);
+        crc ^= (uint16_t)((crc & 0xff) << 5);
+    }
+    return crc;
+}
+
+uint32_t control_frame_encode(const control_frame_t *frame, uint8_t *out) {
+    uint8_t body[CONTROL_FRAME_MAX_BODY];
+    uint32_t body_length = 0;
+
+    body[body_length++] = frame->seq;
+    body[body_length++] = frame->opcode;
+    for (uint32_t i = 0; i < frame->length; i++) {
+        body[body_length++] = frame->payload[i];
+    }
+    uint16_t crc = control_frame_crc16(0xFFFF, body, body_length);
+    body[body_length++] = (uint8_t)crc;
+    body[body_length++] = (uint8_t)(crc >> 8);
+
+    // COBS: each code byte gives the distance to the next zero (or the end
+    // of a run of 254 non-zero bytes); the body is far shorter than that
+    uint32_t n = 0;
+    out[n++] = CONTROL_FRAME_DELIMITER;
+    uint32_t code_index = n++;
+    uint8_t code = 1;
+    for (uint32_t i = 0; i < body_length; i++) {
+        if (body[i] == 0) {
+            out[code_index] = code;
+            code_index = n++;
+            code = 1;
+        } else {
+            out[n++] = body[i];
+            code++;
+        }
+    }
+    out[code_index] = code;
+    out[n++] = CONTROL_FRAME_DELIMITER;
+    return n;
+}
+
+control_frame_result_t control_frame_decode(const uint8_t *data, uint32_t length, control_frame_t *frame) {
+    uint8_t body[CONTROL_FRAME_MAX_BODY];
+    uint32_t body_length = 0;
+    uint32_t i = 0;
+
+    while (i < length) {
+        uint8_t code = data[i++];
+        if (code == 0 || i + code - 1 > length) return CONTROL_FRAME_BAD_COBS;
+
+        for (uint8_t j = 1; j < code; j++) {
+            if (body_length == sizeof(body)) return CONTROL_FRAME_BAD_LENGTH;
+            body[body_length++] = data[i++];
+        }
+        // A short block stands for a zero, except at the very end
+        if (code < 0xFF && i < length) {
+            if (body_length == sizeof(body)) return CONTROL_FRAME_BAD_LENGTH;
+            body[body_length++] = 0;
+        }
+    }
+
+    if (body_length < 4) return CONTROL_FRAME_BAD_LENGTH;
+
+    uint16_t crc = (uint16_t)(body[body_length - 2] | (body[body_length - 1] << 8));
+    if (control_frame_crc16(0xFFFF, body, body_length - 2) != crc) return CONTROL_FRAME_BAD_CRC;
+
+    frame->seq = body[0];
+    frame->opcode = body[1];
+    frame->length = (uint8_t)(body_length - 4);
+    for (uint32_t k = 0; k < frame->length; k++) {
+        frame->payload[k] = body[2 + k];
+    }
+    return CONTROL_FRAME_OK;
+}
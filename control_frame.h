@@ -0,0 +1,140 @@
+/**
+ * Control Frame Module for Multimode Clock Source
+ *
+ * Framing for the binary control protocol that shares UART0 with the text
+ * menu. A frame is
+ *
+ *     0x00, COBS(seq, opcode, payload..., crc16 low, crc16 high), 0x00
+ *
+ * COBS removes every zero byte from the body, so a zero only ever marks a
+ * frame boundary, and text never contains one. A receiver that sees a zero
+ * where a text line would start knows a frame follows. The CRC is
+ * CRC-16/CCITT-FALSE (polynomial 0x1021, initial value 0xFFFF) over seq,
+ * opcode and payload. Multi-byte payload fields are little-endian.
+ *
+ * A reply carries the request's sequence number and opcode with
+ * CONTROL_REPLY set, and its first payload byte is a control_status_t.
+ *
+ * This module has no hardware access; control_client.py is the host-side
+ * implementation of the same format.
+ */
+
+#ifndef CONTROL_FRAME_H
+#define CONTROL_FRAME_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#define CONTROL_FRAME_DELIMITER     0x00
+#define CONTROL_FRAME_MAX_PAYLOAD   20
+
+// Decoded body: seq, opcode, payload, CRC
+#define CONTROL_FRAME_MAX_BODY      (2 + CONTROL_FRAME_MAX_PAYLOAD + 2)
+
+// COBS adds one byte per 254 (one here), plus both delimiters
+#define CONTROL_FRAME_MAX_ENCODED   (CONTROL_FRAME_MAX_BODY + 1 + 2)
+
+#define CONTROL_REPLY               0x80    // Set in a reply's opcode
+
+typedef enum {
+    CONTROL_OP_PING   = 0x00,   // No payload; replies OK
+    CONTROL_OP_FREQ   = 0x01,   // uint32 Hz; replies uint64 achieved mHz, int32 error ppb
+    CONTROL_OP_STOP   = 0x02,   // No payload
+    CONTROL_OP_TOGGLE = 0x03,   // No payload; replies uint8 clock level
+    CONTROL_OP_RESET  = 0x04,   // Optional uint32 cycles (default RESET_CYCLES); replies uint8 1 if it
+                                // released a pulse in progress instead of starting one
+    CONTROL_OP_POWER  = 0x05,   // uint8 0 = off, 1 = on
+    CONTROL_OP_STATUS = 0x06,   // No payload; replies a control_status_reply
+    CONTROL_OP_MODE   = 0x07,   // uint8 mode (clock_mode_t order)
+    CONTROL_OP_BURST  = 0x08,   // uint64 cycles, uint32 Hz; replies like FREQ, completion is printed
+    CONTROL_OP_DEAD_TIME = 0x09, // uint32 phi1/phi2 dead time in system clock cycles
+    CONTROL_OP_HIGH_FREQ = 0x0A, // uint32 Hz for High Frequency mode
+    CONTROL_OP_SYS_CLOCK = 0x0B, // Optional uint32 kHz (turns retune off); replies uint32 sys_clk Hz, uint8 retune
+    CONTROL_OP_RETUNE    = 0x0C, // uint8 0 = off, 1 = on
+    CONTROL_OP_DUTY      = 0x0D, // uint8 0 = duty in 0.01%, 1 = HIGH width in ns, uint32 value;
+                                 // replies uint32 achieved duty in 0.01%, uint32 HIGH ns, uint32 steps
+    CONTROL_OP_SWEEP     = 0x0E, // uint32 from Hz, uint32 to Hz, uint32 duration ms, uint32 dwell ms,
+                                 // uint8 0 = linear, 1 = log; replies uint32 steps, uint32 dwell us;
+                                 // completion or abort is printed
+    CONTROL_OP_WAIT      = 0x0F, // uint8 0 = off, 1 = on; replies uint32 stretched cycles
+    CONTROL_OP_COUNT     = 0x10, // Optional uint8 0 = off, 1 = counter input, 2 = loopback;
+                                 // replies a control_count_reply
+    CONTROL_OP_REFERENCE = 0x11  // Optional uint32 reference Hz, 0 = off; replies a
+                                 // control_reference_reply
+} control_opcode_t;
+
+typedef enum {
+    CONTROL_OK = 0,
+    CONTROL_ERR_OPCODE = 1,     // Unknown opcode
+    CONTROL_ERR_LENGTH = 2,     // Payload length wrong for the opcode
+    CONTROL_ERR_RANGE = 3,      // Argument out of range
+    CONTROL_ERR_PANEL = 4       // Refused: the front panel has control
+} control_status_t;
+
+// STATUS reply payload after the status byte:
+//   uint8 mode, uint8 flags (CONTROL_FLAG_*), uint32 frequency Hz,
+//   uint32 frequency mHz (low 32 bits)
+#define CONTROL_FLAG_CLOCK_HIGH     0x01
+#define CONTROL_FLAG_POWER_ON       0x02
+#define CONTROL_FLAG_RUNNING        0x04
+#define CONTROL_FLAG_RESET_ACTIVE   0x08
+#define CONTROL_FLAG_PWM            0x10
+#define CONTROL_FLAG_BURST          0x20
+#define CONTROL_FLAG_SWEEP          0x40
+#define CONTROL_FLAG_WAIT           0x80    // WAIT_INPUT can stretch the clock
+
+// COUNT reply payload after the status byte:
+//   uint8 input (0 = off, 1 = counter input, 2 = loopback),
+//   uint8 state (CONTROL_COUNT_*), uint8 engine (0 = gated, 1 = reciprocal),
+//   uint64 frequency mHz, uint32 time the reading spans in us,
+//   uint32 resolution in ppb
+#define CONTROL_COUNT_MEASURING     0       // No reading yet
+#define CONTROL_COUNT_NO_SIGNAL     1
+#define CONTROL_COUNT_READING       2
+
+// REFERENCE reply payload after the status byte:
+//   uint8 state (discipline_state_t order: off, no reference, acquiring,
+//   locked, holdover, mismatch), uint32 reference Hz, int32 crystal offset
+//   (trim) in ppb, int32 phase in ns
+
+typedef struct {
+    uint8_t seq;
+    uint8_t opcode;
+    uint8_t length;                             // Payload bytes
+    uint8_t payload[CONTROL_FRAME_MAX_PAYLOAD];
+} control_frame_t;
+
+typedef enum {
+    CONTROL_FRAME_OK,
+    CONTROL_FRAME_BAD_COBS,     // Body is not valid COBS
+    CONTROL_FRAME_BAD_LENGTH,   // Too short, or payload too long
+    CONTROL_FRAME_BAD_CRC
+} control_frame_result_t;
+
+/**
+ * CRC-16/CCITT-FALSE
+ * @param crc Running value (0xFFFF to start)
+ * @param data Bytes to add
+ * @param length Number of bytes
+ * @return Updated CRC
+ */
+uint16_t control_frame_crc16(uint16_t crc, const uint8_t *data, uint32_t length);
+
+/**
+ * Encode a frame with both delimiters
+ * @param frame Frame (length at most CONTROL_FRAME_MAX_PAYLOAD)
+ * @param out Buffer of at least CONTROL_FRAME_MAX_ENCODED bytes
+ * @return Number of bytes written
+ */
+uint32_t control_frame_encode(const control_frame_t *frame, uint8_t *out);
+
+/**
+ * Decode the bytes between two delimiters
+ * @param data COBS-encoded body (no zero bytes)
+ * @param length Number of bytes
+ * @param frame Receives the frame
+ * @return CONTROL_FRAME_OK or the reason the frame was rejected
+ */
+control_frame_result_t control_frame_decode(const uint8_t *data, uint32_t length, control_frame_t *frame);
+
+#endif // CONTROL_FRAME_H
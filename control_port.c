@@ -0,0 +1,118 @@
+/**
+ * Control Port Module for Multimode Clock Source
+ */
+
+#include "control_port.h"
+#include "config.h"
+#include "uart_control.h"
+#include "uart_rx.h"
+#include "uart_tx.h"
+#include "line_assembler.h"
+#include "control_protocol.h"
+#include "pico/stdio_usb.h"
+#include "pico/stdio/driver.h"
+
+_Static_assert((USB_RX_BUFFER_SIZE & (USB_RX_BUFFER_SIZE - 1)) == 0,
+               "USB_RX_BUFFER_SIZE must be a power of two");
+
+typedef struct {
+    control_source_t source;
+    uart_inst_t *uart;                  // NULL for USB
+    byte_ring_t *ring;
+    line_assembler_t lines;
+    char line_buffer[UART_CMD_BUFFER_SIZE];    // Only for edited or wrapped lines
+} control_port_t;
+
+static control_port_t ports[3];
+
+// USB CDC bytes are read into a ring of their own, as the UARTs' are by
+// their receive interrupts
+static byte_ring_t usb_ring;
+static uint8_t usb_buffer[USB_RX_BUFFER_SIZE];
+
+static control_port_t *port_for(control_source_t source) {
+    return &ports[source - CONTROL_SOURCE_UART0];
+}
+
+void control_port_init(void) {
+    byte_ring_init(&usb_ring, usb_buffer, sizeof(usb_buffer));
+
+    const control_source_t sources[3] = { CONTROL_SOURCE_UART0, CONTROL_SOURCE_UART1, CONTROL_SOURCE_USB };
+    for (uint i = 0; i < 3; i++) {
+        control_port_t *port = &ports[i];
+        port->source = sources[i];
+        port->uart = i == 0 ? uart0 : i == 1 ? uart1 : NULL;
+        port->ring = port->uart ? uart_rx_ring(port->uart) : &usb_ring;
+        line_assembler_init(&port->lines, port->line_buffer, sizeof(port->line_buffer));
+    }
+}
+
+bool control_port_write(control_source_t source, const void *data, uint32_t length) {
+    control_port_t *port = port_for(source);
+    if (port->uart) return uart_tx_write(port->uart, data, length);
+
+    // Straight to the CDC driver: no CRLF translation, so frames pass intact
+    stdio_usb.out_chars((const char *)data, (int)length);
+    return true;
+}
+
+uint32_t control_port_tx_free(control_source_t source) {
+    control_port_t *port = port_for(source);
+    return port->uart ? uart_tx_free(port->uart) : UINT32_MAX;
+}
+
+static void receive_usb(void) {
+    // Take only what fits, so a fast host is held off by USB flow control
+    // instead of losing bytes
+    char chunk[64];
+    uint32_t room;
+    while ((room = byte_ring_free(&usb_ring)) > 0) {
+        int n = stdio_usb.in_chars(chunk, room < sizeof(chunk) ? (int)room : (int)sizeof(chunk));
+        if (n <= 0) break;
+        byte_ring_write(&usb_ring, chunk, (uint32_t)n);
+    }
+}
+
+static void echo_input(void *context, const char *text, uint32_t length) {
+    const control_port_t *port = context;
+    control_port_write(port->source, text, length);
+}
+
+static void run_line(control_port_t *port, const char *line, uint32_t length) {
+    control_port_write(port->source, "\n", 1);   // New line after command
+
+    // stdout already reaches USB and UART0; copy it to UART1 for its commands
+    stdio_driver_t *mirror = port->uart == uart1 ? uart_tx_stdio_driver(uart1) : NULL;
+    if (mirror) stdio_set_driver_enabled(mirror, true);
+    process_uart_command(port->source, line, length);
+    if (mirror) stdio_set_driver_enabled(mirror, false);
+}
+
+static void poll_port(control_port_t *port) {
+    // Commands are handled straight from the receive ring, one line or
+    // binary frame at a time
+    const char *line;
+    uint32_t length;
+    while (true) {
+        if (line_assembler_idle(&port->lines)) {
+            control_protocol_result_t frame = control_protocol_poll(port->ring, port->source);
+            if (frame == CONTROL_PROTOCOL_DONE) continue;
+            if (frame == CONTROL_PROTOCOL_WAIT) break;
+        }
+        if (!line_assembler_next(&port->lines, port->ring, echo_input, port, &line, &length)) break;
+
+        if (length > 0) {
+            run_line(port, line, length);
+        } else {
+            control_port_write(port->source, "Cmd> ", 5); // Show prompt for empty commands
+        }
+        line_assembler_release(&port->lines, port->ring);
+    }
+}
+
+void control_port_poll(void) {
+    receive_usb();
+    for (uint i = 0; i < 3; i++) {
+        poll_port(&ports[i]);
+    }
+}
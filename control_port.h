@@ -0,0 +1,49 @@
+/**
+ * Control Port Module for Multimode Clock Source
+ *
+ * Takes commands from UART0, UART1 and USB CDC in every mode. Each port
+ * has its own receive ring and line assembler, so text commands and binary
+ * control frames from the three hosts never mix. Echo and binary replies
+ * go back only to the port the command came from; text printed while a
+ * command runs goes to stdout (USB and UART0) and, for a UART1 command, to
+ * UART1 as well.
+ *
+ * Every command is carried out through the control arbiter with its port
+ * as the source.
+ */
+
+#ifndef CONTROL_PORT_H
+#define CONTROL_PORT_H
+
+#include "pico/stdlib.h"
+#include "control_arbiter.h"
+
+/**
+ * Initialize the ports (call after stdio_init_all() and uart_rx_init())
+ */
+void control_port_init(void);
+
+/**
+ * Run the commands received on every port (call on every main loop pass)
+ * UART input wakes the loop through its receive interrupt, USB input
+ * through the USB interrupt.
+ */
+void control_port_poll(void);
+
+/**
+ * Send bytes to a port
+ * @param source Port (not CONTROL_SOURCE_PANEL)
+ * @param data Bytes to send
+ * @param length Number of bytes
+ * @return true if sent or queued, false if dropped
+ */
+bool control_port_write(control_source_t source, const void *data, uint32_t length);
+
+/**
+ * Get the largest write a port takes without dropping it
+ * @param source Port (not CONTROL_SOURCE_PANEL)
+ * @return Free space in bytes (UINT32_MAX for USB, which waits for the host)
+ */
+uint32_t control_port_tx_free(control_source_t source);
+
+#endif // CONTROL_PORT_H
@@ -0,0 +1,345 @@
+/**
+ * Control Protocol Module for Multimode Clock Source
+ */
+
+#include "control_protocol.h"
+#include "control_frame.h"
+#include "config.h"
+#include "button_handler.h"
+#include "uart_control.h"
+#include "control_port.h"
+#include "sys_clock.h"
+#include "pwm_solver.h"
+#include "pio_clock.h"
+#include "duty_cycle.h"
+#include "sweep.h"
+#include "freq_counter.h"
+#include "discipline.h"
+#include "pio_counter.h"
+#include "hardware/clocks.h"
+
+static uint32_t frame_errors = 0;
+
+// External function declarations
+extern clock_mode_t get_current_mode(void);
+extern uint32_t get_current_frequency(void);
+extern uint32_t get_current_millihz(void);
+extern bool get_clock_state(void);
+extern bool get_power_state(void);
+extern bool get_reset_active(void);
+extern void get_achieved_duty(duty_cycle_achieved_t *out);
+
+static uint32_t get_u32(const uint8_t *p) {
+    return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+static uint64_t get_u64(const uint8_t *p) {
+    return (uint64_t)get_u32(p) | ((uint64_t)get_u32(p + 4) << 32);
+}
+
+static void put_u32(control_frame_t *f, uint32_t value) {
+    for (uint i = 0; i < 4; i++) {
+        f->payload[f->length++] = (uint8_t)(value >> (8 * i));
+    }
+}
+
+static void put_u64(control_frame_t *f, uint64_t value) {
+    put_u32(f, (uint32_t)value);
+    put_u32(f, (uint32_t)(value >> 32));
+}
+
+static control_status_t arbiter_status(control_arbiter_result_t result) {
+    switch (result) {
+        case CONTROL_ARBITER_OK:           return CONTROL_OK;
+        case CONTROL_ARBITER_PANEL_IN_USE: return CONTROL_ERR_PANEL;
+    }
+    return CONTROL_ERR_PANEL;
+}
+
+static control_status_t run_command(control_source_t source, const control_frame_t *request,
+                                    control_frame_t *reply) {
+    const uint8_t *arg = request->payload;
+    control_arbiter_result_t result;
+    
+    switch ((control_opcode_t)request->opcode) {
+        case CONTROL_OP_PING:
+            return request->length == 0 ? CONTROL_OK : CONTROL_ERR_LENGTH;
+            
+        case CONTROL_OP_FREQ: {
+            if (request->length != 4) return CONTROL_ERR_LENGTH;
+            uint32_t frequency = get_u32(arg);
+            if (frequency < MIN_UART_FREQ || frequency > sys_clock_max_frequency(get_uart_freq_min_ratio())) {
+                return CONTROL_ERR_RANGE;
+            }
+            result = control_arbiter_freq(source, frequency);
+            if (result != CONTROL_ARBITER_OK) return arbiter_status(result);
+            put_u64(reply, get_uart_achieved_millihz());
+            put_u32(reply, (uint32_t)get_uart_error_ppb());
+            return CONTROL_OK;
+        }
+            
+        case CONTROL_OP_BURST: {
+            if (request->length != 12) return CONTROL_ERR_LENGTH;
+            uint64_t cycles = get_u64(arg);
+            uint32_t frequency = get_u32(arg + 8);
+            if (cycles < 1 || cycles > MAX_BURST_CYCLES) return CONTROL_ERR_RANGE;
+            if (frequency < MIN_UART_FREQ || frequency > sys_clock_max_frequency(2 * PIO_BURST_HALF_OVERHEAD)) {
+                return CONTROL_ERR_RANGE;
+            }
+            result = control_arbiter_burst(source, cycles, frequency);
+            if (result != CONTROL_ARBITER_OK) return arbiter_status(result);
+            put_u64(reply, get_uart_achieved_millihz());
+            put_u32(reply, (uint32_t)get_uart_error_ppb());
+            return CONTROL_OK;
+        }
+            
+        case CONTROL_OP_SWEEP: {
+            if (request->length != 17) return CONTROL_ERR_LENGTH;
+            sweep_plan_t plan = { .from = get_u32(arg), .to = get_u32(arg + 4) };
+            uint32_t duration_ms = get_u32(arg + 8);
+            uint32_t dwell_ms = get_u32(arg + 12);
+            if (plan.from < MIN_UART_FREQ || plan.to < MIN_UART_FREQ || plan.from == plan.to ||
+                sweep_engine_for(clock_get_hz(clk_sys), plan.from, plan.to) == SWEEP_ENGINE_NONE) {
+                return CONTROL_ERR_RANGE;
+            }
+            if (duration_ms < SWEEP_DURATION_MIN_MS || duration_ms > SWEEP_DURATION_MAX_MS ||
+                dwell_ms < 1 || dwell_ms > SWEEP_DWELL_MAX_MS || arg[16] > SWEEP_LOG) {
+                return CONTROL_ERR_RANGE;
+            }
+            plan.shape = (sweep_shape_t)arg[16];
+            plan.steps = sweep_plan_steps(duration_ms, dwell_ms, SWEEP_MAX_STEPS);
+            uint32_t dwell_us = sweep_plan_dwell_us(duration_ms, plan.steps);
+            result = control_arbiter_sweep(source, &plan, dwell_us);
+            if (result != CONTROL_ARBITER_OK) return arbiter_status(result);
+            put_u32(reply, plan.steps);
+            put_u32(reply, dwell_us);
+            return CONTROL_OK;
+        }
+            
+        case CONTROL_OP_STOP:
+            if (request->length != 0) return CONTROL_ERR_LENGTH;
+            return arbiter_status(control_arbiter_stop(source));
+            
+        case CONTROL_OP_TOGGLE: {
+            if (request->length != 0) return CONTROL_ERR_LENGTH;
+            bool level;
+            result = control_arbiter_toggle(source, &level);
+            if (result != CONTROL_ARBITER_OK) return arbiter_status(result);
+            reply->payload[reply->length++] = level;
+            return CONTROL_OK;
+        }
+            
+        case CONTROL_OP_RESET: {
+            if (request->length != 0 && request->length != 4) return CONTROL_ERR_LENGTH;
+            uint32_t cycles = request->length ? get_u32(arg) : RESET_CYCLES;
+            if (cycles < 1 || cycles > MAX_RESET_CYCLES) return CONTROL_ERR_RANGE;
+            bool released;
+            control_arbiter_result_t result = control_arbiter_reset(source, cycles, &released);
+            if (result != CONTROL_ARBITER_OK) return arbiter_status(result);
+            reply->payload[reply->length++] = released;
+            return CONTROL_OK;
+        }
+            
+        case CONTROL_OP_POWER: {
+            if (request->length != 1) return CONTROL_ERR_LENGTH;
+            if (arg[0] > 1) return CONTROL_ERR_RANGE;
+            bool switched_mode;
+            return arbiter_status(control_arbiter_power(source, arg[0] == 1, &switched_mode));
+        }
+            
+        case CONTROL_OP_MODE:
+            if (request->length != 1) return CONTROL_ERR_LENGTH;
+            if (arg[0] > MODE_UART_CONTROL) return CONTROL_ERR_RANGE;
+            return arbiter_status(control_arbiter_mode(source, (clock_mode_t)arg[0]));
+            
+        case CONTROL_OP_DEAD_TIME: {
+            if (request->length != 4) return CONTROL_ERR_LENGTH;
+            uint32_t ticks = get_u32(arg);
+            if (ticks < PHI_DEAD_TIME_MIN || ticks > PHI_DEAD_TIME_MAX) return CONTROL_ERR_RANGE;
+            return arbiter_status(control_arbiter_dead_time(source, ticks));
+        }
+            
+        case CONTROL_OP_HIGH_FREQ: {
+            if (request->length != 4) return CONTROL_ERR_LENGTH;
+            uint32_t frequency = get_u32(arg);
+            if (frequency < MIN_HIGH_FREQ || frequency > sys_clock_max_frequency(PWM_SOLVER_PERIOD_MIN)) return CONTROL_ERR_RANGE;
+            return arbiter_status(control_arbiter_high_freq(source, frequency));
+        }
+            
+        case CONTROL_OP_SYS_CLOCK: {
+            if (request->length != 0 && request->length != 4) return CONTROL_ERR_LENGTH;
+            if (request->length) {
+                uint32_t khz = get_u32(arg);
+                if (!sys_clock_valid(khz)) return CONTROL_ERR_RANGE;
+                result = control_arbiter_sys_clock(source, khz);
+                if (result != CONTROL_ARBITER_OK) return arbiter_status(result);
+            }
+            put_u32(reply, clock_get_hz(clk_sys));
+            reply->payload[reply->length++] = sys_clock_get_retune();
+            return CONTROL_OK;
+        }
+            
+        case CONTROL_OP_RETUNE:
+            if (request->length != 1) return CONTROL_ERR_LENGTH;
+            if (arg[0] > 1) return CONTROL_ERR_RANGE;
+            sys_clock_set_retune(arg[0] == 1);
+            return CONTROL_OK;
+            
+        case CONTROL_OP_DUTY: {
+            if (request->length != 5) return CONTROL_ERR_LENGTH;
+            uint32_t value = get_u32(arg + 1);
+            if (arg[0] == DUTY_CYCLE_RATIO) {
+                if (value < DUTY_CYCLE_MIN || value > DUTY_CYCLE_MAX) return CONTROL_ERR_RANGE;
+            } else if (arg[0] == DUTY_CYCLE_WIDTH) {
+                if (value < PULSE_WIDTH_MIN_NS || value > PULSE_WIDTH_MAX_NS) return CONTROL_ERR_RANGE;
+            } else {
+                return CONTROL_ERR_RANGE;
+            }
+            result = control_arbiter_duty(source, (duty_cycle_kind_t)arg[0], value);
+            if (result != CONTROL_ARBITER_OK) return arbiter_status(result);
+            duty_cycle_achieved_t achieved;
+            get_achieved_duty(&achieved);
+            put_u32(reply, achieved.ratio);
+            put_u32(reply, achieved.width_ns);
+            put_u32(reply, achieved.steps);
+            return CONTROL_OK;
+        }
+            
+        case CONTROL_OP_WAIT:
+            if (request->length != 1) return CONTROL_ERR_LENGTH;
+            if (arg[0] > 1) return CONTROL_ERR_RANGE;
+            result = control_arbiter_wait(source, arg[0] == 1);
+            if (result != CONTROL_ARBITER_OK) return arbiter_status(result);
+            put_u32(reply, pio_clock_get_stretched_cycles());
+            return CONTROL_OK;
+            
+        case CONTROL_OP_COUNT: {
+            if (request->length > 1) return CONTROL_ERR_LENGTH;
+            if (request->length == 1) {
+                if (arg[0] > FREQ_COUNTER_LOOPBACK) return CONTROL_ERR_RANGE;
+                uart_control_count((freq_counter_input_t)arg[0]);
+            }
+            freq_counter_reading_t reading;
+            bool have = freq_counter_get_reading(&reading);
+            reply->payload[reply->length++] = (uint8_t)freq_counter_get_input();
+            reply->payload[reply->length++] = !have ? CONTROL_COUNT_MEASURING :
+                                              reading.signal ? CONTROL_COUNT_READING : CONTROL_COUNT_NO_SIGNAL;
+            reply->payload[reply->length++] = (uint8_t)reading.engine;
+            put_u64(reply, have ? reading.millihz : 0);
+            put_u32(reply, have ? reading.gate_us : 0);
+            put_u32(reply, have ? reading.resolution_ppb : 0);
+            return CONTROL_OK;
+        }
+            
+        case CONTROL_OP_REFERENCE: {
+            if (request->length != 0 && request->length != 4) return CONTROL_ERR_LENGTH;
+            if (request->length == 4) {
+                uint32_t ref_hz = get_u32(arg);
+                if (ref_hz > DISCIPLINE_REF_MAX_HZ || ref_hz > clock_get_hz(clk_sys) / PIO_COUNTER_PERIOD_MIN) {
+                    return CONTROL_ERR_RANGE;
+                }
+                uart_control_reference(ref_hz);
+            }
+            discipline_status_t status;
+            discipline_get_status(&status);
+            reply->payload[reply->length++] = (uint8_t)status.state;
+            put_u32(reply, status.ref_hz);
+            put_u32(reply, (uint32_t)status.trim_ppb);
+            put_u32(reply, (uint32_t)status.phase_ns);
+            return CONTROL_OK;
+        }
+            
+        case CONTROL_OP_STATUS: {
+            if (request->length != 0) return CONTROL_ERR_LENGTH;
+            clock_mode_t mode = get_current_mode();
+            bool uart_mode = mode == MODE_UART_CONTROL;
+            uint8_t flags = 0;
+            if (get_clock_state()) flags |= CONTROL_FLAG_CLOCK_HIGH;
+            if (get_power_state()) flags |= CONTROL_FLAG_POWER_ON;
+            if (uart_mode && get_uart_clock_running()) flags |= CONTROL_FLAG_RUNNING;
+            if (get_reset_active()) flags |= CONTROL_FLAG_RESET_ACTIVE;
+            if ((uart_mode && get_uart_pwm_active()) || mode == MODE_HIGH_FREQ) flags |= CONTROL_FLAG_PWM;
+            if (uart_mode && get_uart_burst_active()) flags |= CONTROL_FLAG_BURST;
+            if (uart_mode && get_uart_sweep_active()) flags |= CONTROL_FLAG_SWEEP;
+            if (pio_clock_get_wait()) flags |= CONTROL_FLAG_WAIT;
+            reply->payload[reply->length++] = (uint8_t)mode;
+            reply->payload[reply->length++] = flags;
+            if (uart_mode && sweep_get_steps() > 0) {
+                put_u32(reply, sweep_get_frequency());
+                put_u32(reply, sweep_get_frequency() * 1000u);
+            } else if (uart_mode) {
+                bool running = get_uart_clock_running();
+                put_u32(reply, running ? get_uart_set_frequency() : 0);
+                put_u32(reply, running ? (uint32_t)get_uart_achieved_millihz() : 0);
+            } else {
+                put_u32(reply, get_current_frequency());
+                put_u32(reply, get_current_millihz());
+            }
+            return CONTROL_OK;
+        }
+    }
+    return CONTROL_ERR_OPCODE;
+}
+
+static void handle_frame(const uint8_t *encoded, uint32_t length, control_source_t source) {
+    control_frame_t request;
+    if (control_frame_decode(encoded, length, &request) != CONTROL_FRAME_OK) {
+        // No reply: the sequence number cannot be trusted, the host retries
+        frame_errors++;
+        return;
+    }
+    
+    control_frame_t reply = { .seq = request.seq, .opcode = request.opcode | CONTROL_REPLY, .length = 1 };
+    reply.payload[0] = (uint8_t)run_command(source, &request, &reply);
+    if (reply.payload[0] != CONTROL_OK) reply.length = 1;
+    
+    // A reply is never dropped: wait for room, which also paces a host
+    // that sends faster than the replies can leave
+    uint8_t out[CONTROL_FRAME_MAX_ENCODED];
+    uint32_t out_length = control_frame_encode(&reply, out);
+    while (control_port_tx_free(source) < out_length) {
+        tight_loop_contents();
+    }
+    control_port_write(source, out, out_length);
+}
+
+control_protocol_result_t control_protocol_poll(byte_ring_t *ring, control_source_t source) {
+    const uint8_t *data;
+    if (byte_ring_peek(ring, &data) == 0 || data[0] != CONTROL_FRAME_DELIMITER) {
+        return CONTROL_PROTOCOL_NONE;
+    }
+    
+    // Copy the body out up to the closing delimiter; frames are a few bytes
+    // and may wrap around the ring
+    uint8_t encoded[CONTROL_FRAME_MAX_ENCODED - 2];
+    uint32_t length = 0;
+    uint32_t offset = 1;
+    uint32_t block;
+    while ((block = byte_ring_peek_from(ring, offset, &data)) > 0) {
+        for (uint32_t i = 0; i < block; i++) {
+            if (data[i] == CONTROL_FRAME_DELIMITER) {
+                if (length == 0) {
+                    // Two delimiters in a row: the first opens nothing
+                    byte_ring_consume(ring, 1);
+                } else {
+                    handle_frame(encoded, length, source);
+                    byte_ring_consume(ring, offset + i + 1);
+                }
+                return CONTROL_PROTOCOL_DONE;
+            }
+            if (length == sizeof(encoded)) {
+                // Too long for a frame: drop the delimiter, the rest is text
+                frame_errors++;
+                byte_ring_consume(ring, 1);
+                return CONTROL_PROTOCOL_DONE;
+            }
+            encoded[length++] = data[i];
+        }
+        offset += block;
+    }
+    return CONTROL_PROTOCOL_WAIT;
+}
+
+uint32_t control_protocol_errors(void) {
+    return frame_errors;
+}
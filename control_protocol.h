@@ -0,0 +1,40 @@
+/**
+ * Control Protocol Module for Multimode Clock Source
+ *
+ * This module runs the binary control protocol (see control_frame.h) on
+ * every control port, next to the text menu. A frame is recognised by the
+ * zero byte it starts with, which text never contains, so a host can mix
+ * both on the same port. Frames are only looked for between text lines.
+ * Replies are binary frames on the same port and nothing else is printed
+ * for them, so a script can issue commands back to back.
+ */
+
+#ifndef CONTROL_PROTOCOL_H
+#define CONTROL_PROTOCOL_H
+
+#include "pico/stdlib.h"
+#include "byte_ring.h"
+#include "control_arbiter.h"
+
+typedef enum {
+    CONTROL_PROTOCOL_NONE,      // No frame at the head of the ring
+    CONTROL_PROTOCOL_WAIT,      // A frame is still arriving
+    CONTROL_PROTOCOL_DONE       // A frame (or stray delimiter) was consumed
+} control_protocol_result_t;
+
+/**
+ * Handle a frame at the head of a receive ring
+ * Call only between text lines, as the ring's consumer.
+ * @param ring Receive ring
+ * @param source Port the ring belongs to, which the reply is sent on
+ * @return What was found at the head of the ring
+ */
+control_protocol_result_t control_protocol_poll(byte_ring_t *ring, control_source_t source);
+
+/**
+ * Get the number of frames rejected for bad framing, length or CRC
+ * @return Frames rejected since boot
+ */
+uint32_t control_protocol_errors(void);
+
+#endif // CONTROL_PROTOCOL_H
@@ -0,0 +1,54 @@
+/**
+ * Debounce Module for Multimode Clock Source
+ */
+
+#include "debounce.h"
+
+// Times are free-running 32-bit microsecond counters; differences are taken
+// with unsigned arithmetic so the state machine is unaffected by wrap-around.
+
+static bool quiet_since_last_edge(const debounce_t *d, uint32_t now_us) {
+    return (uint32_t)(now_us - d->last_edge_us) >= d->holdoff_us;
+}
+
+void debounce_init(debounce_t *d, bool raw_pressed, uint32_t now_us, uint32_t holdoff_us) {
+    d->pressed = raw_pressed;
+    d->raw_pressed = raw_pressed;
+    d->last_edge_us = now_us - holdoff_us; // Settled
+    d->holdoff_us = holdoff_us;
+}
+
+debounce_event_t debounce_edge(debounce_t *d, bool raw_pressed, uint32_t time_us) {
+    debounce_event_t event = DEBOUNCE_NONE;
+    
+    // Leading edge of a press on a quiet line
+    if (raw_pressed && !d->pressed && quiet_since_last_edge(d, time_us)) {
+        d->pressed = true;
+        event = DEBOUNCE_PRESS;
+    }
+    
+    d->raw_pressed = raw_pressed;
+    d->last_edge_us = time_us;
+    return event;
+}
+
+debounce_event_t debounce_poll(debounce_t *d, uint32_t now_us) {
+    // Releases, and presses that began during a bounce, are taken once quiet
+    if (d->raw_pressed != d->pressed && quiet_since_last_edge(d, now_us)) {
+        d->pressed = d->raw_pressed;
+        return d->pressed ? DEBOUNCE_PRESS : DEBOUNCE_RELEASE;
+    }
+    return DEBOUNCE_NONE;
+}
+
+debounce_event_t debounce_feed(debounce_t *d, bool raw_pressed, uint32_t time_us) {
+    debounce_event_t settled = debounce_poll(d, time_us);
+    debounce_event_t edge = debounce_edge(d, raw_pressed, time_us);
+    return edge == DEBOUNCE_PRESS ? DEBOUNCE_PRESS : settled;
+}
+
+bool debounce_settle_time(const debounce_t *d, uint32_t *settle_us) {
+    if (d->raw_pressed == d->pressed) return false;
+    *settle_us = d->last_edge_us + d->holdoff_us;
+    return true;
+}
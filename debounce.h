@@ -0,0 +1,83 @@
+/**
+ * Debounce Module for Multimode Clock Source
+ *
+ * Edge-driven button debounce state machine. It is fed timestamped edges
+ * (from the GPIO interrupt on the device, or a recorded bounce trace on a
+ * host) and has no hardware access, so it can run anywhere.
+ *
+ * A press is accepted on the first edge after the line has been quiet for
+ * the hold-off time, so it is reported with no added latency; the bounce
+ * that follows is ignored. Any other change of state is accepted once the
+ * line has been quiet for the hold-off time.
+ */
+
+#ifndef DEBOUNCE_H
+#define DEBOUNCE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+typedef enum {
+    DEBOUNCE_NONE,
+    DEBOUNCE_PRESS,
+    DEBOUNCE_RELEASE
+} debounce_event_t;
+
+typedef struct {
+    bool pressed;           // Debounced state
+    bool raw_pressed;       // Line state after the most recent edge
+    uint32_t last_edge_us;  // Time of the most recent edge
+    uint32_t holdoff_us;    // Quiet time that ends a bounce
+} debounce_t;
+
+/**
+ * Initialize a debouncer to a settled state
+ * @param d Debouncer
+ * @param raw_pressed Current line state (true if pressed)
+ * @param now_us Current time in microseconds
+ * @param holdoff_us Quiet time that ends a bounce in microseconds
+ */
+void debounce_init(debounce_t *d, bool raw_pressed, uint32_t now_us, uint32_t holdoff_us);
+
+/**
+ * Feed an edge
+ * Call debounce_poll() with the edge time first so a state that settled
+ * before the edge is reported in order (debounce_feed() does both).
+ * @param d Debouncer
+ * @param raw_pressed Line state after the edge (true if pressed)
+ * @param time_us Edge time in microseconds
+ * @return DEBOUNCE_PRESS if the edge starts a press, DEBOUNCE_NONE otherwise
+ */
+debounce_event_t debounce_edge(debounce_t *d, bool raw_pressed, uint32_t time_us);
+
+/**
+ * Feed an edge, settling the debouncer at the edge time first
+ * Does debounce_poll() then debounce_edge(), both always, so the line state
+ * is recorded even when a change settles at the edge. Use this when edges
+ * are handled in batches, long after they happened.
+ * @param d Debouncer
+ * @param raw_pressed Line state after the edge (true if pressed)
+ * @param time_us Edge time in microseconds
+ * @return DEBOUNCE_PRESS if a press settled before the edge or the edge
+ *         starts one, DEBOUNCE_RELEASE if a release settled before it,
+ *         DEBOUNCE_NONE otherwise
+ */
+debounce_event_t debounce_feed(debounce_t *d, bool raw_pressed, uint32_t time_us);
+
+/**
+ * Settle the debouncer at a point in time
+ * @param d Debouncer
+ * @param now_us Current time in microseconds (not earlier than the last edge)
+ * @return DEBOUNCE_PRESS or DEBOUNCE_RELEASE if the state settled, DEBOUNCE_NONE otherwise
+ */
+debounce_event_t debounce_poll(debounce_t *d, uint32_t now_us);
+
+/**
+ * Get the time at which a pending state change settles
+ * @param d Debouncer
+ * @param settle_us Receives the time debounce_poll() will report the change
+ * @return true if a state change is pending
+ */
+bool debounce_settle_time(const debounce_t *d, uint32_t *settle_us);
+
+#endif // DEBOUNCE_H
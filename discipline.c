@@ -0,0 +1,181 @@
+/**
+ * Reference Discipline Module for Multimode Clock Source
+ */
+
+#include "discipline.h"
+#include "config.h"
+#include "clock_core.h"
+#include "discipline_loop.h"
+#include "pio_counter.h"
+#include "sys_clock.h"
+#include "hardware/gpio.h"
+#include "hardware/clocks.h"
+#include <stdatomic.h>
+
+// Readings come a gate apart and the receive FIFO holds four, so the FIFO
+// is looked at far less often than the other core1 work
+#define POLL_INTERVAL_US 10000
+
+// Discipline state (owned by core1)
+static pio_counter_t reference_counter;
+static discipline_loop_t loop;
+static discipline_state_t state = DISCIPLINE_OFF;
+static uint32_t reference_hz = 0;
+static uint64_t poll_us = 0;
+static uint64_t last_reading_us = 0;    // For the lost-reference timeout
+static uint32_t measure_sys_hz = 0;     // System clock the running count is in
+static uint32_t seen_overruns = 0;
+static int32_t last_offset_ppb = 0;
+static uint32_t reading_count = 0;
+
+// Status for core0; the sequence is odd while it is being written
+static volatile discipline_status_t latest;
+static atomic_uint latest_sequence;
+
+static void publish(void) {
+    discipline_status_t status = {
+        .state = state,
+        .ref_hz = reference_hz,
+        .trim_ppb = sys_clock_get_trim_ppb(),
+        .offset_ppb = last_offset_ppb,
+        .phase_ns = (int32_t)(loop.phase_ps / 1000),
+        .readings = reading_count,
+    };
+    unsigned sequence = atomic_load_explicit(&latest_sequence, memory_order_relaxed);
+    atomic_store_explicit(&latest_sequence, sequence + 1, memory_order_relaxed);
+    atomic_thread_fence(memory_order_release);
+    latest = status;
+    atomic_store_explicit(&latest_sequence, sequence + 2, memory_order_release);
+}
+
+// Publish the latest figures; a new state is announced as well
+static void set_state(discipline_state_t next) {
+    bool changed = next != state;
+    state = next;
+    publish();
+    if (changed) {
+        clock_core_telemetry(CORE_TLM_DISCIPLINE, (uint8_t)next, 0);
+    }
+}
+
+// Count from the next reference edge; the phase is lost across the gap
+static void start_timing(void) {
+    uint64_t edges = (uint64_t)reference_hz * DISCIPLINE_GATE_MS / 1000u;
+    uint64_t now = time_us_64();
+    measure_sys_hz = clock_get_hz(clk_sys);
+    pio_counter_start(&reference_counter, edges > 0 ? (uint32_t)edges : 1u);
+    seen_overruns = reference_counter.overruns;
+    discipline_loop_restart(&loop);
+    last_reading_us = now;
+    poll_us = now + POLL_INTERVAL_US;
+}
+
+// Hand the loop's trim over every reading, so the loop sees exactly what
+// it asked for; the engines only change when the clock they solve
+// against moves by a hertz
+static bool apply_trim(void) {
+    uint32_t before = sys_clock_get_hz();
+    sys_clock_set_trim_ppb(discipline_loop_trim_ppb(&loop));
+    return sys_clock_get_hz() != before;
+}
+
+static bool take_reading(uint64_t cycles) {
+    // Counts taken across a system clock change mean nothing; the trim is
+    // a ratio of the crystal, so it still holds
+    if (clock_get_hz(clk_sys) != measure_sys_hz) {
+        start_timing();
+        return false;
+    }
+
+    uint32_t edges = reference_counter.edges;
+    int64_t offset_ppt = discipline_loop_offset_ppt(measure_sys_hz, reference_hz, edges, cycles);
+    uint64_t span_ns = (uint64_t)edges * 1000000000ull / reference_hz;
+    discipline_loop_result_t result = discipline_loop_update(&loop, offset_ppt, span_ns, sys_clock_get_trim_ppb());
+    last_offset_ppb = (int32_t)(offset_ppt / 1000);
+    reading_count++;
+
+    if (result == DISCIPLINE_LOOP_OUT_OF_RANGE) {
+        set_state(DISCIPLINE_MISMATCH);
+        return false;
+    }
+    bool changed = apply_trim();
+    set_state(discipline_loop_locked(&loop) ? DISCIPLINE_LOCKED : DISCIPLINE_ACQUIRING);
+    return changed;
+}
+
+void discipline_init(void) {
+    state = DISCIPLINE_OFF;
+    reference_hz = 0;
+    reading_count = 0;
+    last_offset_ppb = 0;
+    discipline_loop_init(&loop);
+    atomic_store_explicit(&latest_sequence, 0, memory_order_relaxed);
+    publish();
+
+    // Pulled down, so an open input reads as no reference
+    gpio_init(REFERENCE_INPUT);
+    gpio_set_dir(REFERENCE_INPUT, GPIO_IN);
+    gpio_pull_down(REFERENCE_INPUT);
+    pio_counter_init(&reference_counter, REFERENCE_INPUT);
+}
+
+bool discipline_select(uint32_t ref_hz) {
+    pio_counter_stop(&reference_counter);
+    discipline_loop_init(&loop);
+    reference_hz = ref_hz;
+    last_offset_ppb = 0;
+    reading_count = 0;
+
+    if (ref_hz == 0) {
+        // Back to trusting the crystal
+        bool changed = sys_clock_get_trim_ppb() != 0;
+        sys_clock_set_trim_ppb(0);
+        state = DISCIPLINE_OFF;
+        publish();
+        return changed;
+    }
+
+    // The trim stays as it is until the new reference gives a reading
+    state = DISCIPLINE_NO_REFERENCE;
+    start_timing();
+    publish();
+    return false;
+}
+
+bool discipline_update(void) {
+    if (state == DISCIPLINE_OFF) return false;
+    uint64_t now = time_us_64();
+    if (now < poll_us) return false;
+    poll_us = now + POLL_INTERVAL_US;
+
+    uint64_t cycles;
+    if (pio_counter_read(&reference_counter, &cycles)) {
+        last_reading_us = now;
+        return take_reading(cycles);
+    }
+    if (reference_counter.overruns != seen_overruns) {
+        // Readings come faster than the reference set allows
+        set_state(DISCIPLINE_MISMATCH);
+        start_timing();
+    } else if (now - last_reading_us >= DISCIPLINE_TIMEOUT_MS * 1000ull) {
+        set_state(loop.running ? DISCIPLINE_HOLDOVER : DISCIPLINE_NO_REFERENCE);
+        start_timing();
+    }
+    return false;
+}
+
+bool discipline_next_deadline(uint64_t *deadline_us) {
+    if (state == DISCIPLINE_OFF) return false;
+    *deadline_us = poll_us;
+    return true;
+}
+
+void discipline_get_status(discipline_status_t *out) {
+    unsigned before, after;
+    do {
+        before = atomic_load_explicit(&latest_sequence, memory_order_acquire);
+        *out = latest;
+        atomic_thread_fence(memory_order_acquire);
+        after = atomic_load_explicit(&latest_sequence, memory_order_relaxed);
+    } while ((before & 1u) || before != after);
+}
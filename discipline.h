@@ -0,0 +1,77 @@
+/**
+ * Reference Discipline Module for Multimode Clock Source
+ *
+ * This module measures an external reference on REFERENCE_INPUT, from a
+ * 1PPS up to DISCIPLINE_REF_MAX_HZ, and trims the system clock the engines
+ * solve against (sys_clock_get_hz()) so that their output tracks it rather
+ * than the crystal. A PIO reciprocal counter (pio_counter.h) times whole
+ * reference periods, one reading per DISCIPLINE_GATE_MS with no gap between
+ * readings, and a software PLL (discipline_loop.h) turns the readings into
+ * the trim.
+ *
+ * The running clock is retuned in place whenever the trimmed system clock
+ * moves by a hertz (8 ppb at 125 MHz); how closely it then follows the
+ * reference is set by the engine's divider steps, as reported by 'freq'.
+ * If the reference goes away the last trim is held.
+ *
+ * The discipline runs on core1 (see clock_core.h), from its timers.
+ */
+
+#ifndef DISCIPLINE_H
+#define DISCIPLINE_H
+
+#include "pico/stdlib.h"
+
+typedef enum {
+    DISCIPLINE_OFF,
+    DISCIPLINE_NO_REFERENCE,    // No reading yet; the trim is as it was
+    DISCIPLINE_ACQUIRING,       // Trimmed, phase still settling
+    DISCIPLINE_LOCKED,          // Phase within DISCIPLINE_LOCK_NS
+    DISCIPLINE_HOLDOVER,        // Reference lost; the last trim is held
+    DISCIPLINE_MISMATCH         // Reference is not at the frequency set
+} discipline_state_t;
+
+typedef struct {
+    discipline_state_t state;
+    uint32_t ref_hz;            // Reference frequency set, 0 when off
+    int32_t trim_ppb;           // Trim the engines run on (crystal offset)
+    int32_t offset_ppb;         // Offset the latest reading measured
+    int32_t phase_ns;           // Time the trimmed clock has gained on the reference
+    uint32_t readings;
+} discipline_status_t;
+
+/**
+ * Initialize the discipline and REFERENCE_INPUT (core1)
+ * The discipline starts off, with no trim.
+ */
+void discipline_init(void);
+
+/**
+ * Discipline to a reference, or stop (core1)
+ * Stopping clears the trim.
+ * @param ref_hz Reference frequency in Hz, 0 for off
+ * @return true if the trim changed, so the running clock needs retuning
+ */
+bool discipline_select(uint32_t ref_hz);
+
+/**
+ * Take a reading and update the trim (core1, call from the main loop)
+ * Changes of state are reported as CORE_TLM_DISCIPLINE telemetry.
+ * @return true if the trim changed, so the running clock needs retuning
+ */
+bool discipline_update(void);
+
+/**
+ * Get the time discipline_update() next has work
+ * @param deadline_us Receives the time in microseconds since boot
+ * @return true while a reference is selected
+ */
+bool discipline_next_deadline(uint64_t *deadline_us);
+
+/**
+ * Get the state of the discipline (any core)
+ * @param out Receives the state
+ */
+void discipline_get_status(discipline_status_t *out);
+
+#endif // DISCIPLINE_H
@@ -0,0 +1,85 @@
+/**
+ * Discipline Loop Module for Multimode Clock Source
+ */
+
+#include "discipline_loop.h"
+#include "config.h"
+
+#define PS_PER_NS 1000
+#define PPT_PER_PPB 1000
+
+// Integrating gain 1 / (4 tau^2) against the proportional 1 / tau: critically damped
+#define INTEGRAL_DIVISOR (4ll * DISCIPLINE_TIME_CONSTANT_S * DISCIPLINE_TIME_CONSTANT_S)
+
+static int64_t magnitude(int64_t value) {
+    return value < 0 ? -value : value;
+}
+
+static void start(discipline_loop_t *loop, int64_t offset_ppt) {
+    loop->running = true;
+    loop->phase_ps = 0;
+    loop->frequency_ppt = offset_ppt;
+    loop->quiet = 0;
+}
+
+void discipline_loop_init(discipline_loop_t *loop) {
+    loop->running = false;
+    loop->phase_ps = 0;
+    loop->frequency_ppt = 0;
+    loop->quiet = 0;
+}
+
+void discipline_loop_restart(discipline_loop_t *loop) {
+    loop->phase_ps = 0;
+    loop->quiet = 0;
+}
+
+int64_t discipline_loop_offset_ppt(uint32_t sys_hz, uint32_t ref_hz, uint32_t edges, uint64_t cycles) {
+    if (sys_hz == 0 || edges == 0) return 0;
+
+    // cycles * ref_hz / edges is the system clock the reference saw
+    double ratio = (double)cycles * (double)ref_hz / ((double)edges * (double)sys_hz);
+    return (int64_t)((ratio - 1.0) * 1e12 + (ratio >= 1.0 ? 0.5 : -0.5));
+}
+
+discipline_loop_result_t discipline_loop_update(discipline_loop_t *loop, int64_t offset_ppt,
+                                                uint64_t span_ns, int32_t applied_ppb) {
+    if (magnitude(offset_ppt) > DISCIPLINE_MAX_PPM * 1000000ll) {
+        return DISCIPLINE_LOOP_OUT_OF_RANGE;
+    }
+    if (!loop->running) {
+        start(loop, offset_ppt);
+        return DISCIPLINE_LOOP_STARTED;
+    }
+
+    // The engines believed the clock was off by the applied trim; the rest
+    // of the offset became phase over the span (ppt times ns is 1e-9 ps)
+    int64_t residual_ppt = offset_ppt - (int64_t)applied_ppb * PPT_PER_PPB;
+    loop->phase_ps += residual_ppt * (int64_t)span_ns / 1000000000ll;
+
+    // Too far out to pull in smoothly: this reading is the best estimate
+    if (magnitude(loop->phase_ps) > DISCIPLINE_SLIP_NS * (int64_t)PS_PER_NS) {
+        start(loop, offset_ppt);
+        return DISCIPLINE_LOOP_STARTED;
+    }
+
+    // Picoseconds of phase per second of span are ppt of frequency
+    loop->frequency_ppt += loop->phase_ps * (int64_t)span_ns / (INTEGRAL_DIVISOR * 1000000000ll);
+    if (magnitude(loop->phase_ps) <= DISCIPLINE_LOCK_NS * (int64_t)PS_PER_NS) {
+        if (loop->quiet < DISCIPLINE_LOCK_READINGS) loop->quiet++;
+    } else {
+        loop->quiet = 0;
+    }
+    return DISCIPLINE_LOOP_TRACKING;
+}
+
+int32_t discipline_loop_trim_ppb(const discipline_loop_t *loop) {
+    if (!loop->running) return 0;
+
+    int64_t trim_ppt = loop->frequency_ppt + loop->phase_ps / DISCIPLINE_TIME_CONSTANT_S;
+    return (int32_t)((trim_ppt + (trim_ppt >= 0 ? PPT_PER_PPB / 2 : -PPT_PER_PPB / 2)) / PPT_PER_PPB);
+}
+
+bool discipline_loop_locked(const discipline_loop_t *loop) {
+    return loop->running && loop->quiet >= DISCIPLINE_LOCK_READINGS;
+}
@@ -0,0 +1,86 @@
+/**
+ * Discipline Loop Module for Multimode Clock Source
+ *
+ * This module is the software PLL behind the reference discipline. Each
+ * reading of the reference gives the offset of the crystal, and so of
+ * clk_sys, from its nominal frequency. The loop turns those readings into
+ * a trim: the offset the clock engines should solve against, so that a
+ * second of their time is a second of the reference's.
+ *
+ * The loop is second order. The phase is the time the trimmed clock has
+ * gained on the reference; a proportional path steers it back to zero in
+ * about DISCIPLINE_TIME_CONSTANT_S, and an integrating path learns the
+ * frequency offset, critically damped. The first reading sets the
+ * frequency directly, so the loop starts close and only has phase to pull
+ * in. It is a pure computation with no hardware access so it can run
+ * anywhere.
+ */
+
+#ifndef DISCIPLINE_LOOP_H
+#define DISCIPLINE_LOOP_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+typedef struct {
+    bool running;               // Has a frequency estimate
+    int64_t phase_ps;           // Time the trimmed clock has gained on the reference
+    int64_t frequency_ppt;      // Integrator: offset estimate in parts per trillion
+    uint32_t quiet;             // Readings in a row with the phase within DISCIPLINE_LOCK_NS
+} discipline_loop_t;
+
+typedef enum {
+    DISCIPLINE_LOOP_TRACKING,
+    DISCIPLINE_LOOP_STARTED,    // First reading, or a phase slip: started over from this one
+    DISCIPLINE_LOOP_OUT_OF_RANGE // Offset beyond DISCIPLINE_MAX_PPM; the reading was ignored
+} discipline_loop_result_t;
+
+/**
+ * Initialize a loop with no estimate
+ * @param loop Loop state
+ */
+void discipline_loop_init(discipline_loop_t *loop);
+
+/**
+ * Start the phase afresh, keeping the frequency learnt so far
+ * Use after a gap in the readings, which loses track of the phase.
+ * @param loop Loop state
+ */
+void discipline_loop_restart(discipline_loop_t *loop);
+
+/**
+ * Get the offset of the system clock one reading measured
+ * @param sys_hz Nominal system clock in Hz
+ * @param ref_hz Reference frequency in Hz
+ * @param edges Reference periods timed
+ * @param cycles System clock cycles they took
+ * @return Offset in parts per trillion (positive: the clock runs fast)
+ */
+int64_t discipline_loop_offset_ppt(uint32_t sys_hz, uint32_t ref_hz, uint32_t edges, uint64_t cycles);
+
+/**
+ * Feed one reading to the loop
+ * @param loop Loop state
+ * @param offset_ppt Offset the reading measured (discipline_loop_offset_ppt())
+ * @param span_ns Reference time the reading spans, in ns
+ * @param applied_ppb Trim the engines ran on during the reading
+ * @return DISCIPLINE_LOOP_TRACKING, or what happened to the reading
+ */
+discipline_loop_result_t discipline_loop_update(discipline_loop_t *loop, int64_t offset_ppt,
+                                                uint64_t span_ns, int32_t applied_ppb);
+
+/**
+ * Get the trim the loop asks for
+ * @param loop Loop state
+ * @return Offset for the engines to solve against, in ppb (0 with no estimate)
+ */
+int32_t discipline_loop_trim_ppb(const discipline_loop_t *loop);
+
+/**
+ * Check whether the loop has settled
+ * @param loop Loop state
+ * @return true after DISCIPLINE_LOCK_READINGS readings in a row within DISCIPLINE_LOCK_NS
+ */
+bool discipline_loop_locked(const discipline_loop_t *loop);
+
+#endif // DISCIPLINE_LOOP_H
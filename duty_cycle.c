@@ -0,0 +1,30 @@
+/**
+ * Duty Cycle Module for Multimode Clock Source
+ */
+
+#include "duty_cycle.h"
+
+uint32_t duty_cycle_high_ticks(const duty_cycle_t *duty, uint32_t period, uint32_t min_high, uint32_t min_low,
+                               uint64_t source_hz, uint32_t divider) {
+    uint64_t high;
+    if (duty->kind == DUTY_CYCLE_WIDTH) {
+        // Round width * source_hz / (divider * 1e9); a width of at most
+        // 4.3s times a source of at most 2^32 Hz cannot overflow
+        uint64_t den = (uint64_t)divider * 1000000000ull;
+        high = ((uint64_t)duty->value * source_hz + den / 2) / den;
+    } else {
+        // Round down, so an odd tick at 50% goes to the LOW part as it always has
+        high = ((uint64_t)period * duty->value) / DUTY_CYCLE_SCALE;
+    }
+
+    if (high + min_low > period) high = period - min_low;
+    if (high < min_high) high = min_high;
+    return (uint32_t)high;
+}
+
+void duty_cycle_achieved(uint32_t high, uint32_t period, uint64_t source_hz, uint32_t divider,
+                         duty_cycle_achieved_t *out) {
+    out->ratio = period ? (uint32_t)(((uint64_t)high * DUTY_CYCLE_SCALE + period / 2) / period) : 0;
+    out->width_ns = source_hz ? (uint32_t)(((uint64_t)high * divider * 1000000000ull + source_hz / 2) / source_hz) : 0;
+    out->steps = period;
+}
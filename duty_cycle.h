@@ -0,0 +1,63 @@
+/**
+ * Duty Cycle Module for Multimode Clock Source
+ *
+ * This module splits an output period into its HIGH and LOW parts, either
+ * as a fraction of the period or as a fixed HIGH pulse width. Every clock
+ * engine counts a period in whole ticks of its own counter, so the split is
+ * expressed in those ticks and the achieved duty cycle is reported back. It
+ * is a pure computation with no hardware access so it can run anywhere.
+ */
+
+#ifndef DUTY_CYCLE_H
+#define DUTY_CYCLE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// Duty cycles are in hundredths of a percent (5000 is 50%)
+#define DUTY_CYCLE_SCALE    10000u
+
+typedef enum {
+    DUTY_CYCLE_RATIO,       // HIGH for a fraction of every period
+    DUTY_CYCLE_WIDTH        // HIGH for a fixed time, whatever the period
+} duty_cycle_kind_t;
+
+typedef struct {
+    duty_cycle_kind_t kind;
+    uint32_t value;         // RATIO: HIGH fraction in 1/DUTY_CYCLE_SCALE; WIDTH: HIGH time in ns
+} duty_cycle_t;
+
+typedef struct {
+    uint32_t ratio;         // HIGH fraction in 1/DUTY_CYCLE_SCALE (rounded)
+    uint32_t width_ns;      // HIGH time in ns (rounded)
+    uint32_t steps;         // Counter ticks per period, the duty cycle resolution
+} duty_cycle_achieved_t;
+
+/**
+ * Get the HIGH part of a period
+ * The counter ticks at source_hz / divider, so the PWM slice passes
+ * (16 * sys_hz, div16) and the PIO engine (sys_hz, 1). A pulse width that
+ * does not fit leaves the shortest LOW part the engine allows.
+ * @param duty Requested duty cycle or pulse width
+ * @param period Counter ticks per output period
+ * @param min_high Fewest ticks the engine can hold HIGH
+ * @param min_low Fewest ticks the engine can hold LOW
+ * @param source_hz Counter source frequency in Hz
+ * @param divider Source cycles per counter tick
+ * @return HIGH ticks, from min_high to period - min_low
+ */
+uint32_t duty_cycle_high_ticks(const duty_cycle_t *duty, uint32_t period, uint32_t min_high, uint32_t min_low,
+                               uint64_t source_hz, uint32_t divider);
+
+/**
+ * Describe the duty cycle a split produces
+ * @param high HIGH ticks
+ * @param period Counter ticks per output period
+ * @param source_hz Counter source frequency in Hz
+ * @param divider Source cycles per counter tick
+ * @param out Achieved duty cycle
+ */
+void duty_cycle_achieved(uint32_t high, uint32_t period, uint64_t source_hz, uint32_t divider,
+                         duty_cycle_achieved_t *out);
+
+#endif // DUTY_CYCLE_H
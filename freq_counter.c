@@ -0,0 +1,342 @@
+/**
+ * Frequency Counter Module for Multimode Clock Source
+ */
+
+#include "freq_counter.h"
+#include "config.h"
+#include "clock_core.h"
+#include "pio_counter.h"
+#include "sys_clock.h"
+#include "hardware/gpio.h"
+#include "hardware/pwm.h"
+#include "hardware/irq.h"
+#include "hardware/sync.h"
+#include "hardware/clocks.h"
+#include <stdatomic.h>
+
+_Static_assert((FREQ_COUNTER_INPUT & 1) == PWM_CHAN_B, "The gated engine counts on a PWM B pin");
+
+// Readings escalate the edges they span by this much while the receive
+// FIFO overflows (loopback only; the pin is probed with a gate instead)
+#define EDGES_ESCALATION 64u
+#define EDGES_MAX (1u << 30)
+
+typedef enum {
+    COUNTER_IDLE,
+    COUNTER_PROBING,            // Short gate on a signal of unknown range
+    COUNTER_GATING,             // Gated reading in progress
+    COUNTER_TIMING              // Reciprocal readings in progress
+} counter_state_t;
+
+// Counter state (owned by core1)
+static volatile freq_counter_input_t counter_input = FREQ_COUNTER_OFF;
+static counter_state_t counter_state = COUNTER_IDLE;
+static uint edge_slice = 0;
+static pio_counter_t period_counter;
+static uint64_t gate_end_us = 0;        // Probing and gating
+static uint64_t poll_us = 0;            // Timing: next look at the receive FIFO
+static uint64_t last_reading_us = 0;    // Timing: for the no-signal timeout
+static uint32_t span_ms = 0;            // Timing: time a reading should take
+static uint32_t measure_sys_hz = 0;     // System clock the running counts are in
+static uint32_t seen_overruns = 0;
+static uint32_t reading_count = 0;
+static bool reported_no_signal = false;
+
+// Wraps of the two slices during a gate, counted by the wrap interrupt
+static volatile uint32_t edge_wraps = 0;
+static volatile uint32_t timebase_wraps = 0;
+
+// Latest reading for core0; the sequence is odd while it is being written
+static volatile freq_counter_reading_t latest;
+static atomic_uint latest_sequence;
+
+static void counter_wrap_irq(void) {
+    uint32_t status = pwm_get_irq_status_mask();
+    if (status & (1u << edge_slice)) {
+        pwm_clear_irq(edge_slice);
+        edge_wraps++;
+    }
+    if (status & (1u << FREQ_COUNTER_TIMEBASE_SLICE)) {
+        pwm_clear_irq(FREQ_COUNTER_TIMEBASE_SLICE);
+        timebase_wraps++;
+    }
+}
+
+static void store_reading(const freq_counter_reading_t *reading) {
+    unsigned sequence = atomic_load_explicit(&latest_sequence, memory_order_relaxed);
+    atomic_store_explicit(&latest_sequence, sequence + 1, memory_order_relaxed);
+    atomic_thread_fence(memory_order_release);
+    latest = *reading;
+    atomic_store_explicit(&latest_sequence, sequence + 2, memory_order_release);
+}
+
+static void publish(freq_engine_t engine, uint64_t millihz, uint64_t edges, uint64_t cycles) {
+    freq_counter_reading_t reading = {
+        .sequence = ++reading_count,
+        .input = counter_input,
+        .signal = true,
+        .engine = engine,
+        .millihz = millihz,
+        .gate_us = (uint32_t)(cycles * 1000000u / measure_sys_hz),
+        .resolution_ppb = freq_range_resolution_ppb(engine, edges, cycles),
+    };
+    store_reading(&reading);
+    reported_no_signal = false;
+    clock_core_telemetry(CORE_TLM_COUNT, 0, reading.sequence);
+}
+
+static void publish_no_signal(void) {
+    freq_counter_reading_t reading = {
+        .sequence = ++reading_count,
+        .input = counter_input,
+        .signal = false,
+    };
+    store_reading(&reading);
+    reported_no_signal = true;
+    clock_core_telemetry(CORE_TLM_COUNT, 0, reading.sequence);
+}
+
+// The edge and timebase slices as bits of the PWM EN register
+static uint32_t gate_mask(void) {
+    return (1u << edge_slice) | (1u << FREQ_COUNTER_TIMEBASE_SLICE);
+}
+
+static void start_gate(counter_state_t state, uint32_t gate_ms) {
+    measure_sys_hz = clock_get_hz(clk_sys);
+
+    // One write to EN starts both slices on the same system clock cycle and
+    // another stops them, so they count over exactly the same gate. Every
+    // slice is switched from core1, so nothing changes EN between the read
+    // and the write.
+    uint32_t irq_state = save_and_disable_interrupts();
+    pwm_set_counter(edge_slice, 0);
+    pwm_set_counter(FREQ_COUNTER_TIMEBASE_SLICE, 0);
+    pwm_clear_irq(edge_slice);
+    pwm_clear_irq(FREQ_COUNTER_TIMEBASE_SLICE);
+    edge_wraps = 0;
+    timebase_wraps = 0;
+    pwm_set_mask_enabled(pwm_hw->en | gate_mask());
+    restore_interrupts(irq_state);
+
+    gate_end_us = time_us_64() + gate_ms * 1000ull;
+    counter_state = state;
+}
+
+static void stop_gate(uint64_t *edges, uint64_t *cycles) {
+    uint32_t irq_state = save_and_disable_interrupts();
+    pwm_set_mask_enabled(pwm_hw->en & ~gate_mask());
+
+    // A wrap just before the end is still waiting for its interrupt
+    uint32_t status = pwm_get_irq_status_mask();
+    if (status & (1u << edge_slice)) {
+        pwm_clear_irq(edge_slice);
+        edge_wraps++;
+    }
+    if (status & (1u << FREQ_COUNTER_TIMEBASE_SLICE)) {
+        pwm_clear_irq(FREQ_COUNTER_TIMEBASE_SLICE);
+        timebase_wraps++;
+    }
+    *edges = ((uint64_t)edge_wraps << 16) + pwm_get_counter(edge_slice);
+    *cycles = ((uint64_t)timebase_wraps << 16) + pwm_get_counter(FREQ_COUNTER_TIMEBASE_SLICE);
+    restore_interrupts(irq_state);
+}
+
+static void start_timing(uint32_t edges, uint32_t expected_ms) {
+    uint64_t now = time_us_64();
+    measure_sys_hz = clock_get_hz(clk_sys);
+    pio_counter_start(&period_counter, edges);
+    seen_overruns = period_counter.overruns;
+    span_ms = expected_ms;
+    last_reading_us = now;
+    poll_us = now + CORE1_POLL_INTERVAL_US;
+    counter_state = COUNTER_TIMING;
+}
+
+// Look at a new signal: the pin is probed with a short gate, the loopback
+// starts timing single periods and escalates from there
+static void start_search(void) {
+    if (counter_input == FREQ_COUNTER_PIN) {
+        start_gate(COUNTER_PROBING, FREQ_COUNTER_PROBE_MS);
+    } else {
+        start_timing(1, FREQ_COUNTER_TIMEOUT_MS);
+    }
+}
+
+static void stop_engines(void) {
+    pwm_set_mask_enabled(pwm_hw->en & ~gate_mask());
+    pio_counter_stop(&period_counter);
+    counter_state = COUNTER_IDLE;
+}
+
+// Set up the next reading for the frequency just measured
+static void next_range(freq_engine_t current, uint64_t millihz) {
+    uint32_t sys_hz = clock_get_hz(clk_sys);
+    freq_engine_t engine = counter_input == FREQ_COUNTER_LOOPBACK
+        ? FREQ_ENGINE_RECIPROCAL : freq_range_engine(sys_hz, millihz, current);
+    uint32_t gate_ms = freq_range_gate_ms(sys_hz, millihz, engine);
+
+    if (engine == FREQ_ENGINE_GATED) {
+        start_gate(COUNTER_GATING, gate_ms);
+        return;
+    }
+
+    // Timing carries on without a gap unless its span is far off the gate
+    uint32_t edges = freq_range_edges(millihz, gate_ms);
+    if (counter_state == COUNTER_TIMING && edges >= period_counter.edges / 2 && edges <= period_counter.edges * 2ull) {
+        return;
+    }
+    start_timing(edges, gate_ms);
+}
+
+static void finish_gate(void) {
+    uint64_t edges, cycles;
+    stop_gate(&edges, &cycles);
+    bool probing = counter_state == COUNTER_PROBING;
+
+    // Counts taken across a system clock change mean nothing
+    if (clock_get_hz(clk_sys) != measure_sys_hz) {
+        start_search();
+        return;
+    }
+
+    // Too slow for a gate, or nothing there: time single periods and let
+    // the timeout tell which
+    if (edges == 0) {
+        start_timing(1, FREQ_COUNTER_TIMEOUT_MS);
+        return;
+    }
+
+    uint64_t millihz = freq_range_millihz(sys_clock_get_hz(), edges, cycles);
+    if (!probing) {
+        publish(FREQ_ENGINE_GATED, millihz, edges, cycles);
+    }
+    next_range(FREQ_ENGINE_GATED, millihz);
+}
+
+static void poll_timing(uint64_t now) {
+    uint64_t cycles;
+    poll_us = now + CORE1_POLL_INTERVAL_US;
+    if (pio_counter_read(&period_counter, &cycles)) {
+        last_reading_us = now;
+        if (clock_get_hz(clk_sys) != measure_sys_hz) {
+            start_timing(period_counter.edges, span_ms);
+            return;
+        }
+        uint64_t millihz = freq_range_millihz(sys_clock_get_hz(), period_counter.edges, cycles);
+        publish(FREQ_ENGINE_RECIPROCAL, millihz, period_counter.edges, cycles);
+        next_range(FREQ_ENGINE_RECIPROCAL, millihz);
+    } else if (period_counter.overruns != seen_overruns) {
+        // Readings come faster than their span expects: the signal sped up
+        if (counter_input == FREQ_COUNTER_PIN) {
+            start_gate(COUNTER_PROBING, FREQ_COUNTER_PROBE_MS);
+        } else {
+            uint32_t edges = period_counter.edges;
+            start_timing(edges < EDGES_MAX / EDGES_ESCALATION ? edges * EDGES_ESCALATION : EDGES_MAX,
+                         FREQ_COUNTER_TIMEOUT_MS);
+        }
+    } else if (period_counter.edges > 1 && now - last_reading_us >= span_ms * 3000ull) {
+        // Readings come slower than their span expects: the signal slowed
+        // down, or stopped; look again before calling it gone
+        start_search();
+    } else if (now - last_reading_us >= FREQ_COUNTER_TIMEOUT_MS * 1000ull) {
+        if (!reported_no_signal) {
+            publish_no_signal();
+        }
+        start_search();
+    }
+}
+
+void freq_counter_init(void) {
+    counter_input = FREQ_COUNTER_OFF;
+    counter_state = COUNTER_IDLE;
+    reading_count = 0;
+    reported_no_signal = false;
+    atomic_store_explicit(&latest_sequence, 0, memory_order_relaxed);
+    latest = (freq_counter_reading_t){ .sequence = 0 };
+
+    // Pulled down, so an open input reads as no signal
+    edge_slice = pwm_gpio_to_slice_num(FREQ_COUNTER_INPUT);
+    gpio_set_function(FREQ_COUNTER_INPUT, GPIO_FUNC_PWM);
+    gpio_pull_down(FREQ_COUNTER_INPUT);
+
+    pwm_config c = pwm_get_default_config();
+    pwm_config_set_clkdiv_int_frac(&c, 1, 0);
+    pwm_config_set_wrap(&c, 0xFFFF);
+    pwm_init(FREQ_COUNTER_TIMEBASE_SLICE, &c, false);
+    pwm_config_set_clkdiv_mode(&c, PWM_DIV_B_RISING);
+    pwm_init(edge_slice, &c, false);
+
+    pwm_clear_irq(edge_slice);
+    pwm_clear_irq(FREQ_COUNTER_TIMEBASE_SLICE);
+    pwm_set_irq_enabled(edge_slice, true);
+    pwm_set_irq_enabled(FREQ_COUNTER_TIMEBASE_SLICE, true);
+    irq_add_shared_handler(PWM_IRQ_WRAP, counter_wrap_irq, PICO_SHARED_IRQ_HANDLER_DEFAULT_ORDER_PRIORITY);
+    irq_set_enabled(PWM_IRQ_WRAP, true);
+
+    pio_counter_init(&period_counter, FREQ_COUNTER_INPUT);
+}
+
+void freq_counter_select(freq_counter_input_t input) {
+    stop_engines();
+    counter_input = input;
+    reported_no_signal = false;
+
+    // Readings of the previous input no longer apply
+    freq_counter_reading_t none = { .sequence = 0, .input = input };
+    store_reading(&none);
+
+    if (input == FREQ_COUNTER_OFF) return;
+    pio_counter_set_pin(&period_counter, input == FREQ_COUNTER_LOOPBACK ? CLOCK_OUTPUT : FREQ_COUNTER_INPUT);
+    start_search();
+}
+
+void freq_counter_update(void) {
+    uint64_t now = time_us_64();
+
+    switch (counter_state) {
+        case COUNTER_PROBING:
+        case COUNTER_GATING:
+            if (now >= gate_end_us) {
+                finish_gate();
+            }
+            break;
+
+        case COUNTER_TIMING:
+            poll_timing(now);
+            break;
+
+        case COUNTER_IDLE:
+            break;
+    }
+}
+
+bool freq_counter_next_deadline(uint64_t *deadline_us) {
+    switch (counter_state) {
+        case COUNTER_PROBING:
+        case COUNTER_GATING:
+            *deadline_us = gate_end_us;
+            return true;
+
+        case COUNTER_TIMING:
+            *deadline_us = poll_us;
+            return true;
+
+        default:
+            return false;
+    }
+}
+
+freq_counter_input_t freq_counter_get_input(void) {
+    return counter_input;
+}
+
+bool freq_counter_get_reading(freq_counter_reading_t *out) {
+    unsigned before, after;
+    do {
+        before = atomic_load_explicit(&latest_sequence, memory_order_acquire);
+        *out = latest;
+        atomic_thread_fence(memory_order_acquire);
+        after = atomic_load_explicit(&latest_sequence, memory_order_relaxed);
+    } while ((before & 1u) || before != after);
+    return out->sequence != 0;
+}
@@ -0,0 +1,92 @@
+/**
+ * Frequency Counter Module for Multimode Clock Source
+ *
+ * This module measures the frequency of FREQ_COUNTER_INPUT against the
+ * system clock, or of CLOCK_OUTPUT itself as a loopback check of the clock
+ * engines. A new signal is first counted in a short gate to find its range;
+ * from then on it is measured by whichever engine resolves it better (see
+ * freq_range.h):
+ *
+ *   Gated        a PWM slice counts input edges while a second, free-running
+ *                slice times the gate in system clock cycles; both start and
+ *                stop with one write to the PWM EN register, so the gate is
+ *                exact to a cycle.
+ *                Used near the top of the range, up to sys_clk/2.
+ *   Reciprocal   a PIO state machine times whole input periods (pio_counter.h).
+ *                Used below sys_clk/FREQ_COUNTER_RECIPROCAL_DIVISOR, down to
+ *                two edges per FREQ_COUNTER_TIMEOUT_MS.
+ *
+ * The gate time follows each reading, so every reading resolves at least
+ * FREQ_COUNTER_RESOLUTION_PPB. Reciprocal readings follow one another
+ * without a gap, gates with only a few cycles between them; each is sent to
+ * core0 as it completes. The loopback can only use the
+ * reciprocal engine (CLOCK_OUTPUT is its own PWM slice's output); a faster
+ * clock needs a wire from CLOCK_OUTPUT to FREQ_COUNTER_INPUT. Readings are
+ * taken against the trimmed system clock (sys_clock_get_hz()), so under
+ * reference discipline they are as accurate as the reference.
+ *
+ * The counter runs on core1 (see clock_core.h), from its timers.
+ */
+
+#ifndef FREQ_COUNTER_H
+#define FREQ_COUNTER_H
+
+#include "pico/stdlib.h"
+#include "freq_range.h"
+
+typedef enum {
+    FREQ_COUNTER_OFF,
+    FREQ_COUNTER_PIN,           // FREQ_COUNTER_INPUT
+    FREQ_COUNTER_LOOPBACK       // CLOCK_OUTPUT, whatever engine drives it
+} freq_counter_input_t;
+
+typedef struct {
+    uint32_t sequence;          // Counts readings; 0 before the first
+    freq_counter_input_t input;
+    bool signal;                // false: no reading for FREQ_COUNTER_TIMEOUT_MS
+    freq_engine_t engine;
+    uint64_t millihz;
+    uint32_t gate_us;           // Time the reading spans
+    uint32_t resolution_ppb;
+} freq_counter_reading_t;
+
+/**
+ * Initialize the counter and FREQ_COUNTER_INPUT (core1)
+ * The wrap interrupt is taken on the calling core. The counter starts off.
+ */
+void freq_counter_init(void);
+
+/**
+ * Measure an input, or stop measuring (core1)
+ * @param input FREQ_COUNTER_OFF, FREQ_COUNTER_PIN or FREQ_COUNTER_LOOPBACK
+ */
+void freq_counter_select(freq_counter_input_t input);
+
+/**
+ * End a gate, collect a reading and choose the next range (core1, call from
+ * the main loop)
+ * Each completed reading is reported as CORE_TLM_COUNT telemetry.
+ */
+void freq_counter_update(void);
+
+/**
+ * Get the time freq_counter_update() next has work
+ * @param deadline_us Receives the time in microseconds since boot
+ * @return true while an input is being measured
+ */
+bool freq_counter_next_deadline(uint64_t *deadline_us);
+
+/**
+ * Get the input being measured
+ * @return Input, FREQ_COUNTER_OFF when stopped
+ */
+freq_counter_input_t freq_counter_get_input(void);
+
+/**
+ * Get the latest reading (any core)
+ * @param out Receives the reading
+ * @return false if there has been none since the input was selected
+ */
+bool freq_counter_get_reading(freq_counter_reading_t *out);
+
+#endif // FREQ_COUNTER_H
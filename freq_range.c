@@ -0,0 +1,50 @@
+/**
+ * Frequency Range Module for Multimode Clock Source
+ */
+
+#include "freq_range.h"
+#include "config.h"
+
+static const uint32_t gates_ms[] = FREQ_COUNTER_GATES_MS;
+#define GATE_COUNT (sizeof(gates_ms) / sizeof(gates_ms[0]))
+
+freq_engine_t freq_range_engine(uint32_t sys_hz, uint64_t millihz, freq_engine_t current) {
+    if (millihz > (uint64_t)(sys_hz / FREQ_COUNTER_GATED_DIVISOR) * 1000u) return FREQ_ENGINE_GATED;
+    if (millihz < (uint64_t)(sys_hz / FREQ_COUNTER_RECIPROCAL_DIVISOR) * 1000u) return FREQ_ENGINE_RECIPROCAL;
+    return current;
+}
+
+uint32_t freq_range_gate_ms(uint32_t sys_hz, uint64_t millihz, freq_engine_t engine) {
+    for (uint32_t i = 0; i < GATE_COUNT; i++) {
+        uint64_t cycles = (uint64_t)sys_hz * gates_ms[i] / 1000u;
+        uint64_t edges = millihz * gates_ms[i] / 1000000u;
+        if (freq_range_resolution_ppb(engine, edges, cycles) <= FREQ_COUNTER_RESOLUTION_PPB) {
+            return gates_ms[i];
+        }
+    }
+    return gates_ms[GATE_COUNT - 1];
+}
+
+uint32_t freq_range_edges(uint64_t millihz, uint32_t gate_ms) {
+    uint64_t edges = millihz * gate_ms / 1000000u;
+    if (edges < 1) return 1;
+    return edges > UINT32_MAX ? UINT32_MAX : (uint32_t)edges;
+}
+
+uint64_t freq_range_millihz(uint32_t sys_hz, uint64_t edges, uint64_t cycles) {
+    if (cycles == 0) return 0;
+    uint64_t scale = (uint64_t)sys_hz * 1000u;
+
+    // Exact in 64 bits up to gates of about a second at the top of the range
+    if (edges <= UINT64_MAX / scale - 1) {
+        return (edges * scale + cycles / 2) / cycles;
+    }
+    return (uint64_t)((double)edges * (double)scale / (double)cycles + 0.5);
+}
+
+uint32_t freq_range_resolution_ppb(freq_engine_t engine, uint64_t edges, uint64_t cycles) {
+    // One edge more or less in a gate, or a few cycles either end of a period
+    uint64_t count = engine == FREQ_ENGINE_GATED ? edges : cycles / FREQ_RANGE_RECIPROCAL_CYCLES;
+    if (count == 0) return UINT32_MAX;
+    return (uint32_t)((1000000000ull + count - 1) / count);
+}
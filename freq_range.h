@@ -0,0 +1,81 @@
+/**
+ * Frequency Range Module for Multimode Clock Source
+ *
+ * This module picks how the frequency counter measures a signal: which
+ * engine counts it, how long each gate runs for and how many edges a
+ * reading spans, and turns the raw counts into a frequency and the
+ * resolution it was measured to. It is a pure computation with no hardware
+ * access so it can run anywhere.
+ *
+ * Gated counting counts input edges for a gate timed in system clock
+ * cycles, so a reading is good to one edge in all of them; reciprocal
+ * counting times whole input periods in system clock cycles, good to
+ * FREQ_RANGE_RECIPROCAL_CYCLES whatever the input frequency. Reciprocal
+ * wins everywhere it can follow the input; gated counting takes over near
+ * the top, where only the PWM edge counter keeps up.
+ */
+
+#ifndef FREQ_RANGE_H
+#define FREQ_RANGE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// System clock cycles a reciprocal reading is uncertain by
+#define FREQ_RANGE_RECIPROCAL_CYCLES 2
+
+typedef enum {
+    FREQ_ENGINE_GATED,          // PWM slice counting edges for a gate time
+    FREQ_ENGINE_RECIPROCAL      // PIO timing whole input periods
+} freq_engine_t;
+
+/**
+ * Choose the engine for a frequency, with hysteresis
+ * @param sys_hz System clock frequency in Hz
+ * @param millihz Last reading in millihertz
+ * @param current Engine the reading came from
+ * @return FREQ_ENGINE_GATED above sys_clk/FREQ_COUNTER_GATED_DIVISOR,
+ *         FREQ_ENGINE_RECIPROCAL below sys_clk/FREQ_COUNTER_RECIPROCAL_DIVISOR,
+ *         current in between
+ */
+freq_engine_t freq_range_engine(uint32_t sys_hz, uint64_t millihz, freq_engine_t current);
+
+/**
+ * Choose the gate time
+ * The shortest of FREQ_COUNTER_GATES_MS that resolves FREQ_COUNTER_RESOLUTION_PPB,
+ * or the longest if none does.
+ * @param sys_hz System clock frequency in Hz
+ * @param millihz Expected frequency in millihertz
+ * @param engine Engine measuring it
+ * @return Gate time in milliseconds
+ */
+uint32_t freq_range_gate_ms(uint32_t sys_hz, uint64_t millihz, freq_engine_t engine);
+
+/**
+ * Get the rising edges a reciprocal reading spans
+ * A signal slower than the gate time is read every period.
+ * @param millihz Expected frequency in millihertz
+ * @param gate_ms Gate time in milliseconds
+ * @return Edges, at least 1
+ */
+uint32_t freq_range_edges(uint64_t millihz, uint32_t gate_ms);
+
+/**
+ * Get a frequency from counts
+ * @param sys_hz System clock frequency in Hz
+ * @param edges Input periods counted
+ * @param cycles System clock cycles they took (gated: the gate time)
+ * @return Frequency in millihertz, rounded
+ */
+uint64_t freq_range_millihz(uint32_t sys_hz, uint64_t edges, uint64_t cycles);
+
+/**
+ * Get the resolution of a reading
+ * @param engine Engine that took it
+ * @param edges Input periods counted
+ * @param cycles System clock cycles they took
+ * @return Resolution in parts per billion of the reading
+ */
+uint32_t freq_range_resolution_ppb(freq_engine_t engine, uint64_t edges, uint64_t cycles);
+
+#endif // FREQ_RANGE_H
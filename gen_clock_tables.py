@@ -0,0 +1,185 @@
+#!/usr/bin/env python3
+"""
+Clock table generator for Multimode Clock Source
+
+Generates clock_tables.c at build time with the precomputed configurations
+used by clock_cache.c:
+
+  - clock_cache_adc_millihz[]: frequency in millihertz for every 12-bit ADC
+    value, following the taper selected by POT_TAPER in config.h
+  - clock_cache_adc_period[]: PIO clock period for every 12-bit ADC value
+  - clock_cache_pwm_grid[]: PWM divider/wrap/level on a log-spaced grid
+
+The arithmetic mirrors pwm_solve() in pwm_solver.c and pio_clock_period_millihz()
+in pio_clock.c exactly, so a table entry is bit-identical to what the runtime
+code would compute for the same system clock.
+"""
+
+import argparse
+import os
+import re
+
+DIV16_MIN = 16
+DIV16_MAX = 4095
+PERIOD_MIN = 2
+PERIOD_MAX = 65536
+
+
+def read_defines(path, defines=None):
+    """Collect simple integer and float #defines from a header (a define
+    naming an earlier one takes its value)."""
+    defines = {} if defines is None else defines
+    pattern = re.compile(r'^\s*#define\s+(\w+)\s+\(?\s*(\d+\.\d*[fF]?|\d+|[A-Za-z_]\w*)[uU]?\s*\)?')
+    with open(path) as f:
+        for line in f:
+            m = pattern.match(line)
+            if m:
+                value = m.group(2)
+                if value.isdigit():
+                    defines[m.group(1)] = int(value)
+                elif value[0].isdigit():
+                    defines[m.group(1)] = float(value.rstrip('fF'))
+                elif value in defines:
+                    defines[m.group(1)] = defines[value]
+    return defines
+
+
+def linear_millihz(adc_value, cfg, entries):
+    """Two linear segments: MIN_LOW_FREQ-MAX_LOW_FREQ_RANGE1 over the first
+    POT_RANGE1_PERCENT of the pot range, then up to MAX_LOW_FREQ_RANGE2 over
+    the next POT_RANGE2_PERCENT (whole hertz, as the original integer
+    mapping)."""
+    range1 = int(round((entries - 1) * cfg['POT_RANGE1_PERCENT']))
+    range2 = int(round((entries - 1) * cfg['POT_RANGE2_PERCENT']))
+    if adc_value <= range1:
+        hz = cfg['MIN_LOW_FREQ'] + (adc_value * (cfg['MAX_LOW_FREQ_RANGE1'] - cfg['MIN_LOW_FREQ'])) // range1
+    else:
+        scaled_adc = adc_value - range1
+        hz = cfg['MAX_LOW_FREQ_RANGE1'] + (scaled_adc * (cfg['MAX_LOW_FREQ_RANGE2'] - cfg['MAX_LOW_FREQ_RANGE1'])) // range2
+    return 1000 * hz
+
+
+def log_millihz(adc_value, cfg, entries):
+    """Exponential sweep from MIN_LOW_FREQ to MAX_LOW_FREQ_RANGE2: every ADC
+    step is the same ratio (about 0.28% for 1Hz-100kHz)."""
+    low = cfg['MIN_LOW_FREQ']
+    high = cfg['MAX_LOW_FREQ_RANGE2']
+    return int(round(1000 * low * (high / low) ** (adc_value / (entries - 1))))
+
+
+def pio_period_millihz(sys_hz, millihz, period_min):
+    """Mirror of pio_clock_period_millihz() in pio_clock.c."""
+    if millihz == 0:
+        return period_min
+    period = (1000 * sys_hz + millihz // 2) // millihz
+    return min(max(period, period_min), 0xFFFFFFFF)
+
+
+def pwm_solve(sys_hz, frequency):
+    """Mirror of pwm_solve() in pwm_solver.c. Returns (div16, period) or None."""
+    source = 16 * sys_hz
+    div_lo = max(DIV16_MIN, -(-source // (frequency * PERIOD_MAX)))
+    div_hi = min(DIV16_MAX, source // (frequency * PERIOD_MIN))
+    if div_lo > div_hi:
+        return None
+    div_lo = max(DIV16_MIN, div_lo - 1)
+    div_hi = min(DIV16_MAX, div_hi + 1)
+
+    best = None
+    for div16 in range(div_lo, div_hi + 1):
+        step = frequency * div16
+        period = source // step
+        for candidate in (period, period + 1):
+            candidate = min(max(candidate, PERIOD_MIN), PERIOD_MAX)
+            num = abs(step * candidate - source)
+            den = div16 * candidate
+            if best is None or num * best[3] < best[2] * den:
+                best = (div16, candidate, num, den)
+        if best[2] == 0:
+            break
+
+    return None if best is None else (best[0], best[1])
+
+
+def grid_frequencies(min_hz, max_hz, per_decade):
+    """Log-spaced integer frequencies, per_decade points per decade."""
+    freqs = []
+    step = 0
+    while True:
+        f = int(round(10 ** (step / per_decade)))
+        step += 1
+        if f > max_hz:
+            break
+        if f >= min_hz and (not freqs or f != freqs[-1]):
+            freqs.append(f)
+    return freqs
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.strip().splitlines()[0])
+    parser.add_argument('--source-dir', required=True)
+    parser.add_argument('--output', required=True)
+    parser.add_argument('--pot-taper', choices=('linear', 'log'),
+                        help='taper to generate instead of POT_TAPER in config.h')
+    args = parser.parse_args()
+
+    cfg = {}
+    for header in ('config.h', 'pio_clock.h', 'clock_cache.h'):
+        read_defines(os.path.join(args.source_dir, header), cfg)
+    sys_hz = cfg['CLOCK_CACHE_SYS_HZ']
+    period_min = cfg['PIO_CLOCK_PERIOD_MIN']
+    entries = cfg['CLOCK_CACHE_ADC_ENTRIES']
+    if args.pot_taper:
+        cfg['POT_TAPER'] = cfg['POT_TAPER_LOG' if args.pot_taper == 'log' else 'POT_TAPER_LINEAR']
+
+    if cfg['POT_TAPER'] == cfg['POT_TAPER_LOG']:
+        adc_millihz = [log_millihz(v, cfg, entries) for v in range(entries)]
+    elif cfg['POT_TAPER'] == cfg['POT_TAPER_LINEAR']:
+        adc_millihz = [linear_millihz(v, cfg, entries) for v in range(entries)]
+    else:
+        raise SystemExit('Unknown POT_TAPER %d' % cfg['POT_TAPER'])
+    adc_periods = [pio_period_millihz(sys_hz, mhz, period_min) for mhz in adc_millihz]
+
+    grid = []
+    for f in grid_frequencies(cfg['MIN_UART_FREQ'], cfg['CLOCK_CACHE_GRID_MAX_HZ'],
+                              cfg['CLOCK_CACHE_GRID_PER_DECADE']):
+        solution = pwm_solve(sys_hz, f)
+        if solution is not None:
+            div16, period = solution
+            grid.append((f, div16 >> 4, div16 & 0xF, period - 1, period // 2))
+
+    if len(grid) > cfg['CLOCK_CACHE_GRID_ENTRIES']:
+        raise SystemExit('PWM grid needs %d entries, CLOCK_CACHE_GRID_ENTRIES is %d'
+                         % (len(grid), cfg['CLOCK_CACHE_GRID_ENTRIES']))
+
+    out = []
+    out.append('/**')
+    out.append(' * Precomputed clock tables - generated by gen_clock_tables.py, do not edit')
+    out.append(' */')
+    out.append('')
+    out.append('#include "clock_cache.h"')
+    out.append('')
+    out.append('const uint32_t clock_cache_adc_millihz[CLOCK_CACHE_ADC_ENTRIES] = {')
+    for i in range(0, len(adc_millihz), 8):
+        out.append('    ' + ' '.join('%du,' % m for m in adc_millihz[i:i + 8]))
+    out.append('};')
+    out.append('')
+    out.append('const uint32_t clock_cache_adc_period[CLOCK_CACHE_ADC_ENTRIES] = {')
+    for i in range(0, len(adc_periods), 8):
+        out.append('    ' + ' '.join('%du,' % p for p in adc_periods[i:i + 8]))
+    out.append('};')
+    out.append('')
+    out.append('const clock_cache_pwm_entry_t clock_cache_pwm_grid[CLOCK_CACHE_GRID_ENTRIES] = {')
+    for f, div_int, div_frac, wrap, level in grid:
+        out.append('    {%du, %d, %d, %d, %d},' % (f, div_int, div_frac, wrap, level))
+    out.append('};')
+    out.append('')
+    out.append('const uint32_t clock_cache_pwm_grid_length = %d;' % len(grid))
+    out.append('')
+
+    with open(args.output, 'w') as f:
+        f.write('\n'.join(out))
+
+
+if __name__ == '__main__':
+    main()
@@ -4,6 +4,10 @@
 
 #include "hardware_init.h"
 #include "config.h"
+#include "pot_sampler.h"
+#include "uart_tx.h"
+#include "uart_rx.h"
+#include "sys_clock.h"
 
 void init_gpio(void) {
     // Initialize buttons as inputs with pull-up
@@ -78,11 +82,16 @@ void init_adc(void) {
     adc_init();
     adc_gpio_init(POTENTIOMETER_PIN);
     adc_select_input(0); // ADC0 corresponds to GPIO 26
+    
+    // Only ADC0 is used, so the free-running ADC needs no round robin
+    pot_sampler_init();
 }
 
 void init_uart(void) {
-    // Primary UART is initialized by stdio_init_all()
-    // This function is kept for consistency and future expansion
+    // Primary UART carries stdout through the DMA transmit ring. GPIO 0/1
+    // belong to the power LED and output, so its pins stay unrouted.
+    uart_init(uart0, UART_BAUD_RATE);
+    uart_set_format(uart0, 8, 1, UART_PARITY_NONE);
 }
 
 void init_second_uart(void) {
@@ -96,14 +105,18 @@ void init_second_uart(void) {
     // Set UART format (8 data bits, 1 stop bit, no parity)
     uart_set_format(uart1, 8, 1, UART_PARITY_NONE);
     
-    // Turn off FIFO - we want to do this byte by byte
-    uart_set_fifo_enabled(uart1, false);
+    // Keep the FIFO on so the transmit DMA moves bytes in bursts
+    uart_set_fifo_enabled(uart1, true);
 }
 
 void init_all_hardware(void) {
+    // Before any UART is set up, so baud rates survive system clock changes
+    sys_clock_init();
     stdio_init_all();
     init_gpio();
     init_adc();
     init_uart();
     init_second_uart();
+    uart_tx_init();
+    uart_rx_init();
 }
\ No newline at end of file
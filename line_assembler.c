@@ -0,0 +1,151 @@
+/**
+ * Line Assembler Module for Multimode Clock Source
+ */
+
+#include "line_assembler.h"
+
+static bool is_terminator(uint8_t c) {
+    return c == '\r' || c == '\n';
+}
+
+static bool is_erase(uint8_t c) {
+    return c == '\b' || c == 127;
+}
+
+static bool is_printable(uint8_t c) {
+    return c >= 32 && c < 127;
+}
+
+static void start_line(line_assembler_t *a) {
+    a->scanned = 0;
+    a->length = 0;
+    a->line_end = 0;
+    a->rebuild = false;
+}
+
+void line_assembler_init(line_assembler_t *a, char *buffer, uint32_t size) {
+    a->buffer = buffer;
+    a->size = size;
+    a->discarding = false;
+    a->after_cr = false;
+    start_line(a);
+}
+
+// Replay the raw bytes of the ready line into the scratch buffer
+static void rebuild_line(line_assembler_t *a, byte_ring_t *ring) {
+    uint32_t offset = 0;
+    uint32_t length = 0;
+    uint32_t raw = a->line_end - 1;
+
+    while (offset < raw) {
+        const uint8_t *data;
+        uint32_t block = byte_ring_peek_from(ring, offset, &data);
+        if (block > raw - offset) block = raw - offset;
+
+        for (uint32_t i = 0; i < block; i++) {
+            if (is_erase(data[i])) {
+                if (length > 0) length--;
+            } else if (is_printable(data[i]) && length < a->size) {
+                a->buffer[length++] = (char)data[i];
+            }
+        }
+        offset += block;
+    }
+}
+
+// Drop raw bytes of an overlong line up to and including its terminator
+static bool discard_line(line_assembler_t *a, byte_ring_t *ring) {
+    const uint8_t *data;
+    uint32_t block;
+
+    while ((block = byte_ring_peek(ring, &data)) > 0) {
+        for (uint32_t i = 0; i < block; i++) {
+            if (is_terminator(data[i])) {
+                byte_ring_consume(ring, i + 1);
+                a->discarding = false;
+                a->after_cr = data[i] == '\r';
+                return true;
+            }
+        }
+        byte_ring_consume(ring, block);
+    }
+    return false;
+}
+
+bool line_assembler_next(line_assembler_t *a, byte_ring_t *ring, line_echo_t echo, void *context,
+                         const char **line, uint32_t *length) {
+    while (true) {
+        if (a->discarding && !discard_line(a, ring)) return false;
+
+        const uint8_t *data;
+        uint32_t block = byte_ring_peek_from(ring, a->scanned, &data);
+        if (block == 0) return false;
+
+        // Accepted characters are echoed in runs rather than one at a time
+        uint32_t run = 0;
+        uint32_t i;
+        for (i = 0; i < block; i++) {
+            uint8_t c = data[i];
+
+            if (is_printable(c) && a->length < a->size) {
+                a->length++;
+                run++;
+                a->after_cr = false;
+                continue;
+            }
+
+            if (echo && run) echo(context, (const char *)&data[i - run], run);
+            run = 0;
+
+            if (is_terminator(c)) {
+                // The LF of a CR LF pair is not a second, empty line
+                if (c == '\n' && a->after_cr && a->scanned + i == 0) {
+                    byte_ring_consume(ring, 1);
+                    a->after_cr = false;
+                    break;
+                }
+                a->after_cr = c == '\r';
+                a->line_end = a->scanned + i + 1;
+
+                // Hand the line over in place unless it was edited or wraps
+                const uint8_t *start;
+                if (a->rebuild || byte_ring_peek(ring, &start) < a->length) {
+                    rebuild_line(a, ring);
+                    *line = a->buffer;
+                } else {
+                    *line = (const char *)start;
+                }
+                *length = a->length;
+                return true;
+            }
+
+            a->after_cr = false;
+            a->rebuild = true;
+            if (is_erase(c) && a->length > 0) {
+                a->length--;
+                if (echo) echo(context, "\b \b", 3);
+            }
+        }
+
+        if (i < block) continue;    // Swallowed an LF; rescan from the new tail
+
+        if (echo && run) echo(context, (const char *)&data[block - run], run);
+        a->scanned += block;
+
+        if (a->scanned > ring->size / 2) {
+            // No terminator in sight: drop the line before it fills the ring
+            byte_ring_consume(ring, a->scanned);
+            start_line(a);
+            a->discarding = true;
+        }
+    }
+}
+
+bool line_assembler_idle(const line_assembler_t *a) {
+    return a->scanned == 0 && !a->discarding;
+}
+
+void line_assembler_release(line_assembler_t *a, byte_ring_t *ring) {
+    byte_ring_consume(ring, a->line_end);
+    start_line(a);
+}
@@ -0,0 +1,79 @@
+/**
+ * Line Assembler Module for Multimode Clock Source
+ *
+ * Splits the bytes queued in a receive ring into command lines without
+ * copying them out. A complete line is handed over as a slice pointing into
+ * the ring, and its bytes stay queued until the caller releases it. Only a
+ * line that wraps around the end of the ring or was edited with backspace
+ * is rebuilt in a small scratch buffer. Typed characters are echoed as they
+ * are scanned, so an interactive terminal behaves as before.
+ *
+ * CR, LF and CR LF all end a line. Printable ASCII is kept, backspace and
+ * DEL erase, other control characters are ignored, and characters past the
+ * scratch buffer size are dropped. A line that grows past half the ring
+ * without a terminator is discarded so the ring cannot fill up with it.
+ */
+
+#ifndef LINE_ASSEMBLER_H
+#define LINE_ASSEMBLER_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "byte_ring.h"
+
+/**
+ * Echo callback
+ * @param context Caller's context
+ * @param text Characters to echo (accepted input, or "\b \b" to erase one)
+ * @param length Number of characters
+ */
+typedef void (*line_echo_t)(void *context, const char *text, uint32_t length);
+
+typedef struct {
+    char *buffer;           // Scratch space for rebuilt lines
+    uint32_t size;          // Longest line kept, in characters
+    uint32_t scanned;       // Raw bytes of the current line already examined
+    uint32_t length;        // Characters in the current line after editing
+    uint32_t line_end;      // Raw bytes to release with a ready line
+    bool rebuild;           // Raw bytes differ from the line (edited or dropped)
+    bool discarding;        // Dropping an overlong line up to its terminator
+    bool after_cr;          // Previous byte ended a line with CR
+} line_assembler_t;
+
+/**
+ * Initialize an assembler
+ * @param a Assembler
+ * @param buffer Scratch space for lines that cannot be handed over in place
+ * @param size Size of buffer, which is also the longest line kept
+ */
+void line_assembler_init(line_assembler_t *a, char *buffer, uint32_t size);
+
+/**
+ * Scan newly received bytes for a complete line
+ * Call line_assembler_release() once done with a line before asking again.
+ * @param a Assembler
+ * @param ring Receive ring (the assembler is its consumer)
+ * @param echo Called with characters to echo (may be NULL)
+ * @param context Passed to echo
+ * @param line Receives the start of the line (not null-terminated)
+ * @param length Receives the line length (0 for an empty line)
+ * @return true if a line is ready, false if more input is needed
+ */
+bool line_assembler_next(line_assembler_t *a, byte_ring_t *ring, line_echo_t echo, void *context,
+                         const char **line, uint32_t *length);
+
+/**
+ * Check whether the assembler is between lines
+ * @param a Assembler
+ * @return true if no byte of a new line has been scanned yet
+ */
+bool line_assembler_idle(const line_assembler_t *a);
+
+/**
+ * Release the line returned by line_assembler_next() and its terminator
+ * @param a Assembler
+ * @param ring Receive ring
+ */
+void line_assembler_release(line_assembler_t *a, byte_ring_t *ring);
+
+#endif // LINE_ASSEMBLER_H
@@ -3,9 +3,9 @@
  * 
  * Features:
  * - Single Step Mode: Manual clock toggle with button
- * - Low-Frequency Mode: 1Hz-100Hz (20% pot) and 100Hz-100kHz (80% pot)  
- * - High-Frequency Mode: Fixed 1MHz output
- * - UART Control Mode: UART-controlled frequency from 10Hz to 1MHz
+ * - Low-Frequency Mode: 1Hz-100kHz over two linear pot ranges (or a logarithmic taper)
+ * - High-Frequency Mode: 1MHz output by default, settable up to sys_clk/2
+ * - UART Control Mode: UART-controlled frequency from 1Hz to sys_clk/2
  * - LED indicators for each mode
  * - UART output for status display
  * 
@@ -27,115 +27,148 @@
 #include "reset_control.h"
 #include "power_control.h"
 #include "status_display.h"
+#include "clock_core.h"
+#include "scheduler.h"
+#include "output_trace.h"
+#include "uart_tx.h"
+#include "control_arbiter.h"
+#include "control_port.h"
+#include "hardware/sync.h"
+
+// Main loop timers
+typedef enum {
+    MAIN_TIMER_BUTTON_HOLD,     // Hold-to-enter-UART detection
+    MAIN_TIMER_BUTTON_SETTLE    // Debounced button state change
+} main_timer_t;
+
+static scheduler_t main_timers;
+
+// Status waiting for core1 to switch engines to a new mode
+static bool status_pending = false;
 
 // Global mode management
 void set_mode(clock_mode_t mode);
+static void schedule_main_timers(void);
 
 int main() {
     // Initialize all hardware components
     init_all_hardware();
     
+    // Record output edges from here on
+    output_trace_init();
+    
     // Initialize all modules
+    scheduler_init(&main_timers);
     button_handler_init();
-    clock_generator_init();
     uart_control_init();
-    reset_control_init();
+    control_arbiter_init();
+    control_port_init();
     power_control_init();
     status_display_init();
     
+    // Clock and reset engines run on core1
+    clock_core_launch();
+    
     // Set initial mode
     set_mode(MODE_SINGLE_STEP);
     
     printf("Multimode Clock Source Starting...\n");
-    uart_puts(uart1, "Multimode Clock Source Starting...\n");
+    uart_tx_puts(uart1, "Multimode Clock Source Starting...\n");
     printf("Press and hold any button for 3 seconds to enter UART Control Mode\n");
-    print_status();
-    
-    uint32_t button_hold_start = 0;
-    bool button_held = false;
+    printf("Commands are taken on UART0, UART1 and USB in every mode\n");
     
     while (true) {
-        clock_mode_t current_mode = get_current_mode();
+        // Debounce button edges captured by the GPIO interrupt
+        update_button_state();
         
-        // Check for button hold to enter UART mode (only if not in UART mode)
-        if (current_mode != MODE_UART_CONTROL) {
-            if (any_button_pressed()) {
-                if (!button_held) {
-                    button_hold_start = to_ms_since_boot(get_absolute_time());
-                    button_held = true;
+        // Handle timers that expired while sleeping
+        uint8_t timer;
+        while (scheduler_pop_expired(&main_timers, time_us_64(), &timer)) {
+            if (timer == MAIN_TIMER_BUTTON_HOLD &&
+                get_current_mode() != MODE_UART_CONTROL && any_button_pressed()) {
+                printf("Entering UART Control Mode\n");
+                if (control_arbiter_mode(CONTROL_SOURCE_PANEL, MODE_UART_CONTROL) == CONTROL_ARBITER_OK) {
+                    show_uart_menu();
                 }
-                
-                // Check if held for 3 seconds
-                if (to_ms_since_boot(get_absolute_time()) - button_hold_start > 3000) {
-                    printf("Entering UART Control Mode\n");
-                    set_mode(MODE_UART_CONTROL);
-                    button_held = false;
-                }
-            } else {
-                button_held = false;
             }
+            // Other timers only need the pass below
+        }
+        
+        clock_mode_t current_mode = get_current_mode();
+        
+        // Time a button hold to enter UART mode (only if not in UART mode)
+        if (current_mode != MODE_UART_CONTROL && any_button_pressed()) {
+            if (!scheduler_is_armed(&main_timers, MAIN_TIMER_BUTTON_HOLD)) {
+                scheduler_arm(&main_timers, MAIN_TIMER_BUTTON_HOLD, time_us_64() + UART_HOLD_TIME_MS * 1000ull);
+            }
+        } else {
+            scheduler_cancel(&main_timers, MAIN_TIMER_BUTTON_HOLD);
         }
         
-        // Handle mode-specific processing
+        // Handle mode-specific processing (the potentiometer is followed on core1)
         if (current_mode == MODE_UART_CONTROL) {
             handle_uart_control();
-        } else if (current_mode == MODE_LOW_FREQ) {
-            update_low_frequency();
-        } else if (current_mode != MODE_UART_CONTROL && !button_held) {
-            // Only handle normal button presses when not holding for UART mode
+        } else {
+            // Presses act on their leading edge; a 3-second hold then enters UART mode
             handle_buttons();
         }
         
+        // Run commands received on UART0, UART1 and USB (their interrupts
+        // wake the loop)
+        control_port_poll();
+        
         // Handle reset functionality (independent of mode)
         handle_reset_button();
-        update_reset_state();
-        update_reset_leds();
+        
+        // Print reset progress reported by core1
+        clock_core_service();
+        
+        // Report a new mode once core1 has switched to it
+        if (status_pending && clock_core_caught_up()) {
+            status_pending = false;
+            update_leds();
+            print_status();
+        }
         
         // Handle power functionality (independent of mode)
         handle_power_button();
         update_power_led();
         
-        sleep_ms(UPDATE_INTERVAL_MS); // Small delay to prevent excessive polling
+        schedule_main_timers();
+        
+        // Sleep until the next deadline, or until a button edge or core1 wakes us
+        uint64_t deadline;
+        if (scheduler_next_deadline(&main_timers, &deadline)) {
+            best_effort_wfe_or_timeout(from_us_since_boot(deadline));
+        } else {
+            __wfe();
+        }
     }
     
     return 0;
 }
 
-void set_mode(clock_mode_t mode) {
-    // Stop all active clock generation
-    stop_all_clock_generation();
+static void schedule_main_timers(void) {
+    uint64_t deadline;
     
+    // Wake when a bouncing button settles, even if no further edge arrives
+    if (get_button_settle_deadline(&deadline)) {
+        scheduler_arm(&main_timers, MAIN_TIMER_BUTTON_SETTLE, deadline);
+    } else {
+        scheduler_cancel(&main_timers, MAIN_TIMER_BUTTON_SETTLE);
+    }
+}
+
+void set_mode(clock_mode_t mode) {
     // Reset UART control state when leaving UART mode
     if (get_current_mode() == MODE_UART_CONTROL && mode != MODE_UART_CONTROL) {
         reset_uart_control_state();
     }
     
-    // Update mode state
+    // Update mode state and have core1 switch the clock engines
     set_current_mode(mode);
-    set_single_step_active(false);
-    set_clock_output(false);
-    
-    switch (mode) {
-        case MODE_SINGLE_STEP:
-            set_current_frequency(0);
-            break;
-            
-        case MODE_LOW_FREQ:
-            update_low_frequency();
-            break;
-            
-        case MODE_HIGH_FREQ:
-            set_current_frequency(HIGH_FREQ_OUTPUT); // 1MHz
-            start_high_frequency();
-            break;
-            
-        case MODE_UART_CONTROL:
-            set_current_frequency(0);
-            set_uart_menu_timeout(UART_MENU_TIMEOUT_MS);
-            show_uart_menu();
-            break;
-    }
+    clock_core_post(CORE_CMD_SET_MODE, mode);
     
-    update_leds();
-    print_status();
+    // The main loop reports the new engine state once core1 has it
+    status_pending = true;
 }
\ No newline at end of file
@@ -0,0 +1,83 @@
+/**
+ * Output Trace Module for Multimode Clock Source
+ */
+
+#include "output_trace.h"
+#include "config.h"
+#include "trace_recorder.h"
+#include "uart_tx.h"
+#include "pico/critical_section.h"
+#include <stdio.h>
+#include <string.h>
+
+// Signal names in output_trace_channel_t order
+static const char *const trace_names[OUTPUT_TRACE_CHANNEL_COUNT] = {
+    "clock", "reset", "power"
+};
+
+// An edge within TRACE_EDGE_MAX_US of the last is one varint of
+// (delta << 2) | channel, 7 bits per byte, so TRACE_EDGES of them fit
+_Static_assert(((uint64_t)TRACE_EDGE_MAX_US << 2) <= (1ull << (7 * TRACE_EDGE_BYTES)),
+               "TRACE_EDGE_MAX_US needs more than TRACE_EDGE_BYTES per edge");
+
+static uint8_t trace_buffer[TRACE_BUFFER_SIZE];
+static trace_recorder_t recorder;
+static critical_section_t trace_lock;
+static volatile bool trace_recording = false;
+
+static uint8_t read_output_levels(void) {
+    return (uint8_t)((gpio_get(CLOCK_OUTPUT) << OUTPUT_TRACE_CLOCK) |
+                     (gpio_get(RESET_OUTPUT) << OUTPUT_TRACE_RESET) |
+                     (gpio_get(POWER_OUTPUT) << OUTPUT_TRACE_POWER));
+}
+
+static void restart_trace(void) {
+    critical_section_enter_blocking(&trace_lock);
+    trace_recorder_init(&recorder, trace_buffer, sizeof(trace_buffer), time_us_64(), read_output_levels());
+    trace_recording = true;
+    critical_section_exit(&trace_lock);
+}
+
+static void print_vcd_text(void *context, const char *text) {
+    (void)context;
+    // The dump is far larger than the UART transmit ring, so wait for room
+    // instead of dropping lines (twice the length covers CRLF expansion)
+    while (uart_tx_free(uart0) < 2 * strlen(text)) {
+        tight_loop_contents();
+    }
+    printf("%s", text);
+}
+
+void output_trace_init(void) {
+    critical_section_init(&trace_lock);
+    restart_trace();
+}
+
+void output_trace_edge(output_trace_channel_t channel, bool level) {
+    if (!trace_recording) return;
+    
+    // Both cores drive outputs; the timestamp is taken under the lock so
+    // edges are stored in time order
+    critical_section_enter_blocking(&trace_lock);
+    if (trace_recording) {
+        trace_recorder_edge(&recorder, (uint8_t)channel, level, time_us_64());
+    }
+    critical_section_exit(&trace_lock);
+}
+
+void output_trace_dump(void) {
+    // Printing takes far longer than a critical section may; stop recording
+    // instead, so the recorder is only read here
+    critical_section_enter_blocking(&trace_lock);
+    trace_recording = false;
+    critical_section_exit(&trace_lock);
+    
+    trace_vcd_format_t format = {
+        .names = trace_names,
+        .channel_count = OUTPUT_TRACE_CHANNEL_COUNT,
+        .tick_ps = 1000000, // time_us_64() ticks
+    };
+    trace_recorder_write_vcd(&recorder, &format, print_vcd_text, NULL);
+    
+    restart_trace();
+}
@@ -0,0 +1,42 @@
+/**
+ * Output Trace Module for Multimode Clock Source
+ *
+ * This module keeps a RAM trace of the CLOCK, RESET and POWER outputs for
+ * inspection in GTKWave. Edges are recorded by the output setters with a
+ * microsecond timestamp, so levels driven by the CPU are captured exactly;
+ * free-running PIO and PWM clocks are not traced edge by edge (use the host
+ * simulator for those).
+ */
+
+#ifndef OUTPUT_TRACE_H
+#define OUTPUT_TRACE_H
+
+#include "pico/stdlib.h"
+
+typedef enum {
+    OUTPUT_TRACE_CLOCK = 0,
+    OUTPUT_TRACE_RESET,
+    OUTPUT_TRACE_POWER,
+    OUTPUT_TRACE_CHANNEL_COUNT
+} output_trace_channel_t;
+
+/**
+ * Initialize output trace and start recording from the current pin levels
+ * Call after the output GPIOs are configured.
+ */
+void output_trace_init(void);
+
+/**
+ * Record the level of a traced output (callable from either core)
+ * @param channel Output being driven
+ * @param level Level now on the pin
+ */
+void output_trace_edge(output_trace_channel_t channel, bool level);
+
+/**
+ * Print the trace as a VCD file and start a new trace
+ * Edges during the dump itself are not recorded.
+ */
+void output_trace_dump(void);
+
+#endif // OUTPUT_TRACE_H
@@ -0,0 +1,452 @@
+/**
+ * PIO Clock Engine Module for Multimode Clock Source
+ */
+
+#include "pio_clock.h"
+#include "config.h"
+#include "sys_clock.h"
+#include "hardware/gpio.h"
+#include "hardware/clocks.h"
+#include "hardware/irq.h"
+#include "hardware/sync.h"
+
+// One program serves both the free-running clock and bursts (addresses
+// relative to the load offset):
+//
+//   0: pull block        side 0  ; burst: OSR <- cycles - 1
+//   1: mov x, osr        side 0
+//   2: pull block        side 0  ; clock starts here: OSR <- HIGH word
+//   3: mov isr, osr      side 0  ; ISR keeps it
+//   4: pull block        side 0  ; OSR <- LOW word, queued with its HIGH word
+//   5: mov y, status     side 0  ; Y = all ones when the TX FIFO is empty
+//   6: jmp !y, 2         side 0  ; another pair queued: skip to the newest one
+//   7: mov y, osr        side 0  ; LOW half
+//   8: jmp y--, 8        side 0
+//   9: set pins, 1       side 1  ; rising edge
+//  10: mov y, isr        side 1
+//  11: jmp pin, 14       side 1  ; WAIT_INPUT HIGH (or WAIT off: jmp 14)
+//  12: irq set 0 rel     side 1  ; count a stretched cycle
+//  13: wait 1 gpio WAIT  side 1  ; hold HIGH while WAIT_INPUT is LOW
+//  14: jmp y--, 14       side 1
+//  15: set pins, 0       side 0  ; falling edge
+//  16: mov y, status     side 0  ; clock: Y = all ones when the TX FIFO is empty
+//  17: jmp y--, 7        side 0  ; clock: nothing queued, next LOW half; else wraps to 2
+//
+// The HIGH half takes its word + PIO_CLOCK_HIGH_OVERHEAD cycles and the LOW
+// half its word + PIO_CLOCK_LOW_OVERHEAD, so the period is any whole number
+// of cycles split anywhere. Words always come in HIGH/LOW pairs, and the
+// LOW word is pulled blocking, so a pair is never split. A new pair is only
+// picked up at a falling edge, which lengthens the LOW half that follows by
+// the few cycles of the load; a full cycle always uses a single pair.
+//
+// Every start enters at a load and runs a LOW half before its first rising
+// edge, so the LOW half spanning a handover from a stopped engine is never
+// shorter than the new one without the CPU holding the pin. A lone word
+// queued on its own parks the clock LOW at the next falling edge: the load
+// stalls on the missing LOW word, which is how a stop lets a HIGH half end.
+//
+// WAIT_INPUT is sampled two cycles after each rising edge. While it is LOW
+// the HIGH half is held at that point, and it runs its full length once the
+// input goes HIGH again, a couple of cycles later (input synchronizer plus
+// the wait). The jmp at 11 takes the cycle the delay slot used to, so an
+// unstretched cycle is timed exactly as before. With WAIT off, 11 jumps
+// unconditionally; the program is reloaded with the other form whenever the
+// engine starts after pio_clock_set_wait() changed it.
+//
+// A burst enters at 0 and loads the program's burst form, in which 16 and
+// 17 count cycles instead of watching the FIFO:
+//
+//  16: jmp x--, 7        side 0  ; cycles left: next LOW half
+//  17: push noblock      side 0  ; report completion, wraps to 2 and idles LOW
+//
+// so both of its halves take word + PIO_BURST_HALF_OVERHEAD cycles. The
+// cycle count lives in X, so a burst of up to 2^32 cycles ends on the Nth
+// falling edge without the CPU looking at a single edge; clearing X ends it
+// at the next one. The side-set pin mirrors the clock on LED_CLOCK_ACTIVITY.
+//
+// The program is assembled with the SDK encoders rather than pioasm so the
+// exact same instruction words are available to host-side models.
+#define PIO_CLOCK_PROGRAM_LENGTH 18
+#define PIO_CLOCK_ENTRY          2
+#define PIO_CLOCK_WRAP_TARGET    2
+#define PIO_CLOCK_WAIT_GATE      11
+#define PIO_CLOCK_WAIT_HOLD      13
+
+_Static_assert(PIO_CLOCK_PERIOD_MIN == PIO_CLOCK_HIGH_OVERHEAD + PIO_CLOCK_LOW_OVERHEAD,
+               "PIO_CLOCK_PERIOD_MIN must be the sum of both half overheads");
+
+static uint16_t pio_clock_instructions[PIO_CLOCK_PROGRAM_LENGTH];
+
+static const pio_program_t pio_clock_program = {
+    .instructions = pio_clock_instructions,
+    .length = PIO_CLOCK_PROGRAM_LENGTH,
+    .origin = -1,
+};
+
+// Engine state
+static PIO clock_pio = pio0;
+static uint clock_sm = 0;
+static uint clock_offset = 0;
+static bool engine_running = false;            // Clock or burst set up, started or waiting to start
+static bool start_pending = false;             // Waiting for CLOCK_OUTPUT to be free
+static bool sm_active = false;                 // The state machine owns CLOCK_OUTPUT
+static bool stopping = false;                  // Finishing a HIGH half before it lets go
+static uint64_t stop_deadline_us = 0;
+static uint32_t stop_high = 0;                 // HIGH half being finished
+static uint32_t engine_period = 0;             // System clock cycles per output cycle
+static uint32_t engine_high = 0;               // System clock cycles HIGH
+static bool engine_burst = false;              // Running a burst
+static uint32_t burst_last_cycle = 0;
+static volatile bool burst_active = false;
+static volatile bool burst_complete = false;
+static volatile bool wait_enabled = false;     // Wanted at the next start
+static bool wait_loaded = false;               // Forms of the loaded program
+static bool burst_loaded = false;
+static volatile uint32_t stretched_cycles = 0;
+
+static void build_program(bool wait, bool burst) {
+    uint side0 = pio_encode_sideset(1, 0);
+    uint side1 = pio_encode_sideset(1, 1);
+    uint gate = wait ? pio_encode_jmp_pin(14) : pio_encode_jmp(14);
+
+    pio_clock_instructions[0] = pio_encode_pull(false, true) | side0;
+    pio_clock_instructions[1] = pio_encode_mov(pio_x, pio_osr) | side0;
+    pio_clock_instructions[2] = pio_encode_pull(false, true) | side0;
+    pio_clock_instructions[3] = pio_encode_mov(pio_isr, pio_osr) | side0;
+    pio_clock_instructions[4] = pio_encode_pull(false, true) | side0;
+    pio_clock_instructions[5] = pio_encode_mov(pio_y, pio_status) | side0;
+    pio_clock_instructions[6] = pio_encode_jmp_not_y(2) | side0;
+    pio_clock_instructions[7] = pio_encode_mov(pio_y, pio_osr) | side0;
+    pio_clock_instructions[8] = pio_encode_jmp_y_dec(8) | side0;
+    pio_clock_instructions[9] = pio_encode_set(pio_pins, 1) | side1;
+    pio_clock_instructions[10] = pio_encode_mov(pio_y, pio_isr) | side1;
+    pio_clock_instructions[PIO_CLOCK_WAIT_GATE] = gate | side1;
+    pio_clock_instructions[12] = pio_encode_irq_set(true, 0) | side1;
+    pio_clock_instructions[PIO_CLOCK_WAIT_HOLD] = pio_encode_wait_gpio(true, WAIT_INPUT) | side1;
+    pio_clock_instructions[14] = pio_encode_jmp_y_dec(14) | side1;
+    pio_clock_instructions[15] = pio_encode_set(pio_pins, 0) | side0;
+    if (burst) {
+        pio_clock_instructions[16] = pio_encode_jmp_x_dec(7) | side0;
+        pio_clock_instructions[17] = pio_encode_push(false, false) | side0;
+    } else {
+        pio_clock_instructions[16] = pio_encode_mov(pio_y, pio_status) | side0;
+        pio_clock_instructions[17] = pio_encode_jmp_y_dec(7) | side0;
+    }
+}
+
+static void pio_burst_irq(void) {
+    if (pio_sm_is_rx_fifo_empty(clock_pio, clock_sm)) return;
+
+    while (!pio_sm_is_rx_fifo_empty(clock_pio, clock_sm)) {
+        pio_sm_get(clock_pio, clock_sm);
+    }
+
+    // A burst cut short by a stop pushes too, at the falling edge it parks on
+    if (burst_active && !stopping) {
+        burst_active = false;
+        burst_complete = true;
+    }
+    __sev(); // Wake the clock engine's core
+}
+
+static void pio_wait_irq(void) {
+    uint flag = clock_sm; // Set relative to the state machine
+    if (!pio_interrupt_get(clock_pio, flag)) return;
+
+    pio_interrupt_clear(clock_pio, flag);
+    stretched_cycles++;
+}
+
+void pio_clock_init(void) {
+    wait_enabled = false;
+    wait_loaded = false;
+    burst_loaded = false;
+    stretched_cycles = 0;
+    build_program(wait_loaded, burst_loaded);
+    clock_offset = pio_add_program(clock_pio, &pio_clock_program);
+    clock_sm = (uint)pio_claim_unused_sm(clock_pio, true);
+    engine_running = false;
+    start_pending = false;
+    sm_active = false;
+    stopping = false;
+    engine_period = 0;
+    engine_high = 0;
+    engine_burst = false;
+    burst_active = false;
+    burst_complete = false;
+
+    // Active LOW with a pull-up, so an unconnected input never stretches
+    gpio_init(WAIT_INPUT);
+    gpio_set_dir(WAIT_INPUT, GPIO_IN);
+    gpio_pull_up(WAIT_INPUT);
+
+    // Only a burst ever pushes, and only a stretch raises the flag
+    pio_set_irq1_source_enabled(clock_pio, (enum pio_interrupt_source)(pis_sm0_rx_fifo_not_empty + clock_sm), true);
+    pio_set_irq1_source_enabled(clock_pio, (enum pio_interrupt_source)(pis_interrupt0 + clock_sm), true);
+    irq_add_shared_handler(PIO0_IRQ_1, pio_burst_irq, PICO_SHARED_IRQ_HANDLER_DEFAULT_ORDER_PRIORITY);
+    irq_add_shared_handler(PIO0_IRQ_1, pio_wait_irq, PICO_SHARED_IRQ_HANDLER_DEFAULT_ORDER_PRIORITY);
+    irq_set_enabled(PIO0_IRQ_1, true);
+}
+
+uint32_t pio_clock_period(uint32_t sys_hz, uint32_t frequency) {
+    if (frequency == 0) return PIO_CLOCK_PERIOD_MIN;
+
+    // Round sys_hz / frequency to the nearest whole cycle
+    uint32_t period = (uint32_t)(((uint64_t)sys_hz + frequency / 2) / frequency);
+    return period < PIO_CLOCK_PERIOD_MIN ? PIO_CLOCK_PERIOD_MIN : period;
+}
+
+uint32_t pio_clock_period_millihz(uint32_t sys_hz, uint64_t millihz) {
+    if (millihz == 0) return PIO_CLOCK_PERIOD_MIN;
+
+    // Round 1000 * sys_hz / millihz to the nearest whole cycle
+    uint64_t period = (1000ull * sys_hz + millihz / 2) / millihz;
+    if (period < PIO_CLOCK_PERIOD_MIN) return PIO_CLOCK_PERIOD_MIN;
+    return period > UINT32_MAX ? UINT32_MAX : (uint32_t)period;
+}
+
+uint32_t pio_clock_burst_period(uint32_t sys_hz, uint32_t frequency) {
+    if (frequency == 0) return 2 * PIO_BURST_HALF_OVERHEAD;
+
+    // Round sys_hz / frequency to the nearest whole cycle
+    uint32_t period = (uint32_t)(((uint64_t)sys_hz + frequency / 2) / frequency);
+    return period < 2 * PIO_BURST_HALF_OVERHEAD ? 2 * PIO_BURST_HALF_OVERHEAD : period;
+}
+
+uint64_t pio_clock_burst_millihz(uint32_t sys_hz, uint32_t period) {
+    return (1000ull * sys_hz) / period;
+}
+
+static void start_program(uint entry, bool burst) {
+    // The state machine is stopped, so the program can be swapped in place
+    if (wait_loaded != wait_enabled || burst_loaded != burst) {
+        pio_remove_program(clock_pio, &pio_clock_program, clock_offset);
+        wait_loaded = wait_enabled;
+        burst_loaded = burst;
+        build_program(wait_loaded, burst_loaded);
+        pio_add_program_at_offset(clock_pio, &pio_clock_program, clock_offset);
+    }
+
+    pio_sm_config c = pio_get_default_sm_config();
+    sm_config_set_wrap(&c, clock_offset + PIO_CLOCK_WRAP_TARGET, clock_offset + PIO_CLOCK_PROGRAM_LENGTH - 1);
+    sm_config_set_set_pins(&c, CLOCK_OUTPUT, 1);
+    sm_config_set_sideset(&c, 1, false, false);
+    sm_config_set_sideset_pins(&c, LED_CLOCK_ACTIVITY);
+    sm_config_set_mov_status(&c, STATUS_TX_LESSTHAN, 1);
+    sm_config_set_jmp_pin(&c, WAIT_INPUT);
+    sm_config_set_clkdiv_int_frac(&c, 1, 0);
+
+    // Take over from SIO at the LOW level the program starts with
+    uint32_t pin_mask = (1u << CLOCK_OUTPUT) | (1u << LED_CLOCK_ACTIVITY);
+    pio_sm_set_pins_with_mask(clock_pio, clock_sm, 0, pin_mask);
+    pio_sm_set_pindirs_with_mask(clock_pio, clock_sm, pin_mask, pin_mask);
+    pio_gpio_init(clock_pio, CLOCK_OUTPUT);
+    pio_gpio_init(clock_pio, LED_CLOCK_ACTIVITY);
+
+    pio_sm_init(clock_pio, clock_sm, clock_offset + entry, &c);
+}
+
+// Keep both halves of a period within what the program can time
+static uint32_t clamp_high(uint32_t period, uint32_t high, uint32_t high_overhead, uint32_t low_overhead) {
+    if (high < high_overhead) return high_overhead;
+    if (high > period - low_overhead) return period - low_overhead;
+    return high;
+}
+
+static void put_pair(uint32_t period, uint32_t high, uint32_t high_overhead, uint32_t low_overhead) {
+    // Back to back, so the program's blocking pull of the LOW word never
+    // stretches a LOW half by more than a few cycles
+    uint32_t irq_state = save_and_disable_interrupts();
+    pio_sm_put(clock_pio, clock_sm, high - high_overhead);
+    pio_sm_put(clock_pio, clock_sm, period - high - low_overhead);
+    restore_interrupts(irq_state);
+}
+
+// True while an engine, this one or the other, drives CLOCK_OUTPUT
+static bool output_held(void) {
+    enum gpio_function function = gpio_get_function(CLOCK_OUTPUT);
+    return function == GPIO_FUNC_PIO0 || function == GPIO_FUNC_PWM;
+}
+
+// Start a clock or burst that has been set up, once no engine holds
+// CLOCK_OUTPUT: one never takes the pin while another is still letting go
+static void start_if_free(void) {
+    if (!start_pending || output_held()) return;
+
+    if (engine_burst) {
+        // All three words fit in the FIFO, so the burst starts as soon as it is enabled
+        start_program(0, true);
+        pio_sm_put(clock_pio, clock_sm, burst_last_cycle);
+        put_pair(engine_period, engine_high, PIO_BURST_HALF_OVERHEAD, PIO_BURST_HALF_OVERHEAD);
+    } else {
+        start_program(PIO_CLOCK_ENTRY, false);
+        put_pair(engine_period, engine_high, PIO_CLOCK_HIGH_OVERHEAD, PIO_CLOCK_LOW_OVERHEAD);
+    }
+    pio_sm_set_enabled(clock_pio, clock_sm, true);
+    start_pending = false;
+    sm_active = true;
+}
+
+void pio_clock_set_period(uint32_t period, uint32_t high) {
+    if (period < PIO_CLOCK_PERIOD_MIN) period = PIO_CLOCK_PERIOD_MIN;
+    high = clamp_high(period, high, PIO_CLOCK_HIGH_OVERHEAD, PIO_CLOCK_LOW_OVERHEAD);
+
+    // Switch over from a burst, or reload the WAIT gate: the restart runs a
+    // LOW half of the new setting before its first rising edge
+    if (engine_running && (engine_burst || wait_loaded != wait_enabled)) {
+        pio_clock_stop();
+    }
+
+    if (!engine_running) {
+        engine_running = true;
+        engine_burst = false;
+        start_pending = true;
+    } else if (period == engine_period && high == engine_high) {
+        return;
+    } else if (!start_pending) {
+        // Stale queued pairs are skipped by the program itself. Without room
+        // for a pair nothing is recorded, so the caller's next update retries.
+        if (pio_sm_get_tx_fifo_level(clock_pio, clock_sm) > 2) return;
+        put_pair(period, high, PIO_CLOCK_HIGH_OVERHEAD, PIO_CLOCK_LOW_OVERHEAD);
+    }
+    engine_period = period;
+    engine_high = high;
+    start_if_free();
+}
+
+// True while the pin is HIGH with the state machine paused at this address:
+// the rising edge at 9 has been made and the falling edge at 15 not yet
+static bool pio_clock_pc_high(uint pc) {
+    return pc >= 10 && pc <= 15;
+}
+
+// Hand CLOCK_OUTPUT back to SIO; the state machine is paused in a LOW half
+static void release_pins(void) {
+    pio_sm_clear_fifos(clock_pio, clock_sm);
+    pio_sm_restart(clock_pio, clock_sm);
+    gpio_set_dir(CLOCK_OUTPUT, GPIO_OUT);
+    gpio_set_function(CLOCK_OUTPUT, GPIO_FUNC_SIO);
+    gpio_set_dir(LED_CLOCK_ACTIVITY, GPIO_OUT);
+    gpio_set_function(LED_CLOCK_ACTIVITY, GPIO_FUNC_SIO);
+    sm_active = false;
+    stopping = false;
+}
+
+static uint64_t high_half_us(uint32_t high) {
+    uint32_t sys_mhz = clock_get_hz(clk_sys) / 1000000;
+    return (high + 1) / (sys_mhz ? sys_mhz : 1) + 1;
+}
+
+void pio_clock_stop(void) {
+    bool burst = engine_burst;
+    uint32_t high = engine_high;
+    engine_running = false;
+    start_pending = false;
+    engine_period = 0;
+    engine_high = 0;
+    engine_burst = false;
+    burst_active = false;
+    if (!sm_active || stopping) return;
+
+    // SIO takes over driving LOW whenever the state machine lets go
+    gpio_put(CLOCK_OUTPUT, 0);
+    gpio_put(LED_CLOCK_ACTIVITY, 0);
+
+    // Paused in a LOW half the state machine stops at once; the LOW half
+    // simply extends. Paused in a HIGH half it is told to park at its
+    // falling edge, so stopping never leaves a runt pulse, and is let go by
+    // pio_clock_update() once the half has ended.
+    pio_sm_set_enabled(clock_pio, clock_sm, false);
+    if (!pio_clock_pc_high(pio_sm_get_pc(clock_pio, clock_sm) - clock_offset)) {
+        release_pins();
+        return;
+    }
+    pio_sm_clear_fifos(clock_pio, clock_sm);
+    if (burst) {
+        pio_sm_exec(clock_pio, clock_sm, pio_encode_set(pio_x, 0));
+    } else {
+        pio_sm_put(clock_pio, clock_sm, 0);
+    }
+    stopping = true;
+    stop_high = high;
+    stop_deadline_us = time_us_64() + high_half_us(stop_high);
+    pio_sm_set_enabled(clock_pio, clock_sm, true);
+}
+
+void pio_clock_update(void) {
+    if (stopping && time_us_64() >= stop_deadline_us) {
+        pio_sm_set_enabled(clock_pio, clock_sm, false);
+        uint pc = pio_sm_get_pc(clock_pio, clock_sm) - clock_offset;
+        if (!pio_clock_pc_high(pc) || pc == PIO_CLOCK_WAIT_HOLD) {
+            // Parked, or held by WAIT_INPUT past the deadline: cut short
+            release_pins();
+        } else {
+            // Still HIGH on a slower system clock; look again a half later
+            stop_deadline_us = time_us_64() + high_half_us(stop_high);
+            pio_sm_set_enabled(clock_pio, clock_sm, true);
+        }
+    }
+    start_if_free();
+}
+
+bool pio_clock_next_deadline(uint64_t *deadline_us) {
+    if (stopping) {
+        *deadline_us = stop_deadline_us;
+        return true;
+    }
+    if (start_pending && !output_held()) {
+        *deadline_us = time_us_64();
+        return true;
+    }
+    return false;
+}
+
+void pio_clock_burst(uint32_t period, uint32_t high, uint32_t last_cycle) {
+    pio_clock_stop();
+    if (period < 2 * PIO_BURST_HALF_OVERHEAD) period = 2 * PIO_BURST_HALF_OVERHEAD;
+    high = clamp_high(period, high, PIO_BURST_HALF_OVERHEAD, PIO_BURST_HALF_OVERHEAD);
+
+    burst_last_cycle = last_cycle;
+    burst_complete = false;
+    burst_active = true;
+    engine_running = true;
+    engine_period = period;
+    engine_high = high;
+    engine_burst = true;
+    start_pending = true;
+    start_if_free();
+}
+
+void pio_clock_set_wait(bool enabled) {
+    wait_enabled = enabled;
+}
+
+bool pio_clock_get_wait(void) {
+    return wait_enabled;
+}
+
+uint32_t pio_clock_get_stretched_cycles(void) {
+    return stretched_cycles;
+}
+
+bool pio_clock_take_burst_complete(void) {
+    uint32_t irq_state = save_and_disable_interrupts();
+    bool complete = burst_complete;
+    burst_complete = false;
+    restore_interrupts(irq_state);
+    return complete;
+}
+
+bool pio_clock_burst_active(void) {
+    return burst_active;
+}
+
+bool pio_clock_is_running(void) {
+    return engine_running;
+}
+
+uint64_t pio_clock_get_achieved_millihz(void) {
+    if (!engine_running) return 0;
+
+    return ((uint64_t)sys_clock_get_hz() * 1000ull) / engine_period;
+}
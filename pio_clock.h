@@ -0,0 +1,164 @@
+/**
+ * PIO Clock Engine Module for Multimode Clock Source
+ *
+ * This module generates the clock on CLOCK_OUTPUT entirely in a PIO state
+ * machine. The CPU only writes a pair of HIGH and LOW words into the TX FIFO
+ * when the frequency or duty cycle changes; no per-edge interrupts or timers
+ * are involved.
+ *
+ * The same state machine also runs bursts: exactly N cycles counted in the
+ * state machine, after which the clock stays LOW and an interrupt reports
+ * completion.
+ *
+ * With WAIT on, both hold the clock HIGH while WAIT_INPUT is LOW: the input
+ * is sampled just after each rising edge, and the HIGH half runs on from
+ * there once it goes HIGH again. Every cycle held this way is counted.
+ */
+
+#ifndef PIO_CLOCK_H
+#define PIO_CLOCK_H
+
+#include "pico/stdlib.h"
+#include "hardware/pio.h"
+
+// Fixed PIO cycles spent per half period outside the delay loops
+#define PIO_CLOCK_HIGH_OVERHEAD 4
+#define PIO_CLOCK_LOW_OVERHEAD  5
+#define PIO_BURST_HALF_OVERHEAD 4
+
+// Shortest free-running period in system clock cycles (both overheads)
+#define PIO_CLOCK_PERIOD_MIN    9
+
+/**
+ * Initialize PIO clock engine (loads the program, claims a state machine
+ * and installs the burst completion interrupt)
+ * The interrupt is taken on the calling core.
+ */
+void pio_clock_init(void);
+
+/**
+ * Convert a frequency to a free-running period
+ * @param sys_hz System clock frequency in Hz
+ * @param frequency Requested output frequency in Hz
+ * @return Period in system clock cycles (at least PIO_CLOCK_PERIOD_MIN)
+ */
+uint32_t pio_clock_period(uint32_t sys_hz, uint32_t frequency);
+
+/**
+ * Convert a frequency in millihertz to a free-running period
+ * @param sys_hz System clock frequency in Hz
+ * @param millihz Requested output frequency in millihertz
+ * @return Period in system clock cycles (at least PIO_CLOCK_PERIOD_MIN)
+ */
+uint32_t pio_clock_period_millihz(uint32_t sys_hz, uint64_t millihz);
+
+/**
+ * Start the engine or retune it if already running
+ * A running clock takes the new period at its next falling edge. If the TX
+ * FIFO has no room for the pair of words the call has no effect and should
+ * be repeated on the next update. A burst in progress is stopped first (as
+ * is a running clock when the WAIT gate changed). A start runs a LOW half
+ * of the new setting before its first rising edge, and waits for
+ * pio_clock_update() while CLOCK_OUTPUT is still held by a stopping engine.
+ * @param period Period in system clock cycles (see pio_clock_period())
+ * @param high HIGH time in system clock cycles, clamped to
+ *             PIO_CLOCK_HIGH_OVERHEAD to period - PIO_CLOCK_LOW_OVERHEAD
+ */
+void pio_clock_set_period(uint32_t period, uint32_t high);
+
+/**
+ * Stop the engine and return CLOCK_OUTPUT to software control (LOW)
+ * Never waits: stopped in a HIGH half, the state machine parks itself at
+ * the falling edge and keeps the pin until pio_clock_update() lets it go.
+ */
+void pio_clock_stop(void);
+
+/**
+ * Finish a stop whose HIGH half has ended, then make a start that was
+ * waiting for CLOCK_OUTPUT (call on the engine's core)
+ */
+void pio_clock_update(void);
+
+/**
+ * Get when pio_clock_update() next has work to do
+ * @param deadline_us Receives the time in microseconds
+ * @return true while a stop is finishing or a start can be made
+ */
+bool pio_clock_next_deadline(uint64_t *deadline_us);
+
+/**
+ * Convert a frequency to the period of a burst
+ * A burst may be shorter than PIO_CLOCK_PERIOD_MIN; both halves run the burst overhead.
+ * @param sys_hz System clock frequency in Hz
+ * @param frequency Requested output frequency in Hz
+ * @return Period in system clock cycles (at least 2 * PIO_BURST_HALF_OVERHEAD)
+ */
+uint32_t pio_clock_burst_period(uint32_t sys_hz, uint32_t frequency);
+
+/**
+ * Get the frequency a burst runs at
+ * @param sys_hz System clock frequency in Hz
+ * @param period Period as returned by pio_clock_burst_period()
+ * @return Burst frequency in millihertz
+ */
+uint64_t pio_clock_burst_millihz(uint32_t sys_hz, uint32_t period);
+
+/**
+ * Emit exactly last_cycle + 1 clock cycles, then hold CLOCK_OUTPUT LOW
+ * Stops a free-running clock first (see pio_clock_stop()) and starts, as
+ * pio_clock_set_period() does, with a LOW half. The burst ends on the last
+ * falling edge, counted by the state machine, and is reported through
+ * pio_clock_take_burst_complete(). The engine stays claimed, LOW, until
+ * pio_clock_stop() or the next start.
+ * @param period Period as returned by pio_clock_burst_period()
+ * @param high HIGH time in system clock cycles, clamped to
+ *             PIO_BURST_HALF_OVERHEAD to period - PIO_BURST_HALF_OVERHEAD
+ * @param last_cycle Number of cycles minus one (so 2^32 cycles fit)
+ */
+void pio_clock_burst(uint32_t period, uint32_t high, uint32_t last_cycle);
+
+/**
+ * Set whether WAIT_INPUT can stretch the clock
+ * Takes effect when the engine next starts; pio_clock_set_period() restarts
+ * a running clock (at a LOW level) to apply it, a burst keeps its setting.
+ * @param enabled true to hold the clock HIGH while WAIT_INPUT is LOW
+ */
+void pio_clock_set_wait(bool enabled);
+
+/**
+ * Get whether WAIT_INPUT can stretch the clock
+ * @return true if WAIT is on
+ */
+bool pio_clock_get_wait(void);
+
+/**
+ * Get the number of clock cycles WAIT_INPUT has held since boot
+ * @return Stretched cycles (wraps at 2^32)
+ */
+uint32_t pio_clock_get_stretched_cycles(void);
+
+/**
+ * Check for a finished burst
+ * @return true once for each burst the state machine has completed
+ */
+bool pio_clock_take_burst_complete(void);
+
+/**
+ * Get burst state
+ * @return true while a burst is emitting cycles
+ */
+bool pio_clock_burst_active(void);
+
+/**
+ * Get PIO clock engine running state
+ * @return true if the state machine is driving CLOCK_OUTPUT, or waiting to
+ */
+bool pio_clock_is_running(void);
+
+/**
+ * Get the frequency actually produced by the engine
+ * @return Achieved frequency in millihertz (0 if stopped)
+ */
+uint64_t pio_clock_get_achieved_millihz(void);
+
+#endif // PIO_CLOCK_H
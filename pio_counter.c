@@ -0,0 +1,133 @@
+/**
+ * PIO Reciprocal Counter Module for Multimode Clock Source
+ */
+
+#include "pio_counter.h"
+
+// Program layout (addresses relative to the load offset). The jump pin is
+// the input; X counts down from all ones, two cycles per decrement:
+//
+//   0: pull block          ; OSR <- edges per reading - 1
+//   1: mov x, ~null
+//   2: mov y, osr
+//   3: jmp x--, 4          ; input HIGH: count
+//   4: jmp pin, 3          ; still HIGH
+//   5: jmp pin, 8          ; input LOW: rising edge?
+//   6: jmp x--, 5          ; no: count
+//   7: jmp 5               ; X passed zero: one cycle lost in 2^32
+//   8: jmp y--, 3          ; rising edge: more to come in this reading
+//   9: mov isr, ~x         ; decrements so far
+//  10: push noblock
+//  11: mov y, osr          ; wraps to 3
+//
+// Each edge costs two cycles beside the loops and the push three more, so
+// N edges between two pushes whose counts differ by D took 2D + 2N + 3
+// cycles. Edges are seen on a two-cycle sampling grid, which leaves at most
+// two cycles of uncertainty per reading; the pushes have no dead time
+// between them, so consecutive readings lose no edges.
+#define PIO_COUNTER_PROGRAM_LENGTH 12
+#define PIO_COUNTER_WRAP_TARGET 3
+
+static uint16_t pio_counter_instructions[PIO_COUNTER_PROGRAM_LENGTH];
+
+static const pio_program_t pio_counter_program = {
+    .instructions = pio_counter_instructions,
+    .length = PIO_COUNTER_PROGRAM_LENGTH,
+    .origin = -1,
+};
+
+// One copy of the program on pio1 serves every counter
+static PIO counter_pio = pio1;
+static uint counter_offset = 0;
+static bool program_loaded = false;
+
+static void build_program(void) {
+    pio_counter_instructions[0] = pio_encode_pull(false, true);
+    pio_counter_instructions[1] = pio_encode_mov_not(pio_x, pio_null);
+    pio_counter_instructions[2] = pio_encode_mov(pio_y, pio_osr);
+    pio_counter_instructions[3] = pio_encode_jmp_x_dec(4);
+    pio_counter_instructions[4] = pio_encode_jmp_pin(3);
+    pio_counter_instructions[5] = pio_encode_jmp_pin(8);
+    pio_counter_instructions[6] = pio_encode_jmp_x_dec(5);
+    pio_counter_instructions[7] = pio_encode_jmp(5);
+    pio_counter_instructions[8] = pio_encode_jmp_y_dec(3);
+    pio_counter_instructions[9] = pio_encode_mov_not(pio_isr, pio_x);
+    pio_counter_instructions[10] = pio_encode_push(false, false);
+    pio_counter_instructions[11] = pio_encode_mov(pio_y, pio_osr);
+}
+
+static void configure(pio_counter_t *counter) {
+    // Readings come a gate time apart, so the four-deep receive FIFO leaves
+    // core1 plenty of slack between polls
+    pio_sm_config c = pio_get_default_sm_config();
+    sm_config_set_wrap(&c, counter_offset + PIO_COUNTER_WRAP_TARGET, counter_offset + PIO_COUNTER_PROGRAM_LENGTH - 1);
+    sm_config_set_jmp_pin(&c, counter->pin);
+    sm_config_set_clkdiv_int_frac(&c, 1, 0);
+    pio_sm_init(counter->pio, counter->sm, counter_offset, &c);
+}
+
+void pio_counter_init(pio_counter_t *counter, uint pin) {
+    if (!program_loaded) {
+        build_program();
+        counter_offset = pio_add_program(counter_pio, &pio_counter_program);
+        program_loaded = true;
+    }
+    counter->pio = counter_pio;
+    counter->sm = (uint)pio_claim_unused_sm(counter_pio, true);
+    counter->pin = pin;
+    counter->edges = 0;
+    counter->have_baseline = false;
+    counter->last_count = 0;
+    counter->overruns = 0;
+    configure(counter);
+}
+
+void pio_counter_set_pin(pio_counter_t *counter, uint pin) {
+    pio_counter_stop(counter);
+    counter->pin = pin;
+    configure(counter);
+}
+
+void pio_counter_start(pio_counter_t *counter, uint32_t edges) {
+    if (edges == 0) edges = 1;
+
+    pio_sm_set_enabled(counter->pio, counter->sm, false);
+    pio_sm_clear_fifos(counter->pio, counter->sm);
+    pio_sm_restart(counter->pio, counter->sm);
+    pio_sm_exec(counter->pio, counter->sm, pio_encode_jmp(counter_offset));
+    counter->edges = edges;
+    counter->have_baseline = false;
+    pio_sm_put(counter->pio, counter->sm, edges - 1);
+    pio_sm_set_enabled(counter->pio, counter->sm, true);
+}
+
+void pio_counter_stop(pio_counter_t *counter) {
+    pio_sm_set_enabled(counter->pio, counter->sm, false);
+    pio_sm_clear_fifos(counter->pio, counter->sm);
+    counter->edges = 0;
+    counter->have_baseline = false;
+}
+
+bool pio_counter_read(pio_counter_t *counter, uint64_t *cycles) {
+    if (counter->edges == 0) return false;
+
+    if (pio_sm_is_rx_fifo_full(counter->pio, counter->sm)) {
+        pio_sm_clear_fifos(counter->pio, counter->sm);
+        counter->have_baseline = false;
+        counter->overruns++;
+        return false;
+    }
+
+    while (!pio_sm_is_rx_fifo_empty(counter->pio, counter->sm)) {
+        uint32_t count = pio_sm_get(counter->pio, counter->sm);
+        bool had_baseline = counter->have_baseline;
+        uint32_t delta = count - counter->last_count;
+        counter->last_count = count;
+        counter->have_baseline = true;
+        if (had_baseline) {
+            *cycles = 2ull * delta + 2ull * counter->edges + 3u;
+            return true;
+        }
+    }
+    return false;
+}
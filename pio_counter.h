@@ -0,0 +1,80 @@
+/**
+ * PIO Reciprocal Counter Module for Multimode Clock Source
+ *
+ * This module times an input's rising edges in a PIO state machine: the
+ * program counts system clock cycles while it follows the pin, and after
+ * every N rising edges pushes the running count. The difference between two
+ * pushes gives the time N periods took to within two system clock cycles,
+ * so the resolution of a reading depends on how long it runs for, not on
+ * the input frequency. This is what makes low frequencies measurable to
+ * 1 ppm in one period, where counting edges in a gate could not.
+ *
+ * Inputs up to sys_clk/PIO_COUNTER_PERIOD_MIN can be followed; each counter
+ * is an instance on pio1, all sharing one copy of the program, so several
+ * inputs (or CLOCK_OUTPUT itself) can be timed at once.
+ */
+
+#ifndef PIO_COUNTER_H
+#define PIO_COUNTER_H
+
+#include "pico/stdlib.h"
+#include "hardware/pio.h"
+
+// Fewest system clock cycles per input period the program follows without
+// missing an edge (each half must also last at least PIO_COUNTER_HALF_MIN)
+#define PIO_COUNTER_PERIOD_MIN 10
+#define PIO_COUNTER_HALF_MIN 3
+
+typedef struct {
+    PIO pio;
+    uint sm;
+    uint pin;                   // Input, read through the jump pin
+    uint32_t edges;             // Rising edges per reading, 0 while stopped
+    bool have_baseline;         // A count has been pushed since the start
+    uint32_t last_count;
+    uint32_t overruns;          // Times the receive FIFO was found full
+} pio_counter_t;
+
+/**
+ * Initialize a counter (loads the program on first use, claims a state machine)
+ * The counter stays stopped; the pin's function is left as it is, since a
+ * PIO reads any pad.
+ * @param counter Counter instance
+ * @param pin GPIO to time
+ */
+void pio_counter_init(pio_counter_t *counter, uint pin);
+
+/**
+ * Time another pin (stops the counter)
+ * @param counter Counter instance
+ * @param pin GPIO to time
+ */
+void pio_counter_set_pin(pio_counter_t *counter, uint pin);
+
+/**
+ * Start timing from the next rising edge, or restart with another N
+ * The first reading follows N rising edges after the first push, which only
+ * sets the baseline.
+ * @param counter Counter instance
+ * @param edges Rising edges per reading (at least 1)
+ */
+void pio_counter_start(pio_counter_t *counter, uint32_t edges);
+
+/**
+ * Stop timing
+ * @param counter Counter instance
+ */
+void pio_counter_stop(pio_counter_t *counter);
+
+/**
+ * Take the next reading, if one is complete
+ * A receive FIFO found full may have dropped pushes, so it is emptied,
+ * counted in counter->overruns, and timing starts again from a new baseline;
+ * a full FIFO means the input runs faster than the edges per reading expect.
+ * @param counter Counter instance
+ * @param cycles Receives the system clock cycles counter->edges periods took
+ * @return true if a reading was taken
+ */
+bool pio_counter_read(pio_counter_t *counter, uint64_t *cycles);
+
+#endif // PIO_COUNTER_H
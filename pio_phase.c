@@ -0,0 +1,129 @@
+/**
+ * PIO Phase Engine Module for Multimode Clock Source
+ */
+
+#include "pio_phase.h"
+#include "config.h"
+
+// Program layout (addresses relative to the load offset). Side-set drives
+// PHI1, PHI2 and PHI0_N (bits 0, 1 and 2); the jump pin is CLOCK_OUTPUT:
+//
+//   0: pull block                  side 0b000      ; OSR <- (dead time - 3) / 2
+//   1: mov x, osr                  side 0b000
+//   2: wait 0 gpio CLOCK_OUTPUT    side 0b000      ; start from a LOW clock
+//   3: mov y, x                    side 0b100 [d]  ; clock fell: phi1 falls
+//   4: jmp pin, 7                  side 0b100      ; clock HIGH again: skip phi2
+//   5: jmp y--, 4                  side 0b100
+//   6: wait 1 gpio CLOCK_OUTPUT    side 0b110      ; phi2 HIGH while clock LOW
+//   7: mov y, x                    side 0b000 [d]  ; clock rose: phi2 falls
+//   8: jmp pin, 10                 side 0b000
+//   9: jmp 3                       side 0b100      ; clock LOW again: skip phi1
+//  10: jmp y--, 8                  side 0b000
+//  11: wait 0 gpio CLOCK_OUTPUT    side 0b001      ; phi1 HIGH while clock HIGH,
+//                                                  ; wraps to 3
+//
+// The countdown checks the clock every other cycle, with d the odd cycle
+// left over, so each phase rises exactly the dead time after the other
+// fell, and only if the clock is still at that phase's level by then. A
+// clock half that ends during the countdown leaves its phase LOW for that
+// cycle and still moves /phi0, at most one cycle late; only a half within
+// the input synchronizer's two cycles of the dead time can give a short
+// pulse.
+#define PIO_PHASE_PROGRAM_LENGTH 12
+#define PIO_PHASE_WRAP_TARGET 3
+
+#define SIDE_PHI1   0x1u
+#define SIDE_PHI2   0x2u
+#define SIDE_PHI0_N 0x4u
+
+_Static_assert(PHI2_OUTPUT == PHI1_OUTPUT + 1 && PHI0_N_OUTPUT == PHI1_OUTPUT + 2,
+               "Phase outputs must be consecutive pins for side-set");
+_Static_assert(PHI_DEAD_TIME_MIN >= 3, "The dead time path takes at least three cycles");
+
+static uint16_t pio_phase_instructions[PIO_PHASE_PROGRAM_LENGTH];
+
+static const pio_program_t pio_phase_program = {
+    .instructions = pio_phase_instructions,
+    .length = PIO_PHASE_PROGRAM_LENGTH,
+    .origin = -1,
+};
+
+// Engine state
+static PIO phase_pio = pio1;
+static uint phase_sm = 0;
+static uint phase_offset = 0;
+static volatile uint32_t dead_time = PHI_DEAD_TIME_TICKS;  // Owned by core1, read by core0
+
+// The odd cycle of a dead time goes in the delay of the two mov y, x
+static void build_program(uint32_t ticks) {
+    uint side_none = pio_encode_sideset(3, 0);
+    uint side_phi0_n = pio_encode_sideset(3, SIDE_PHI0_N);
+    uint odd = pio_encode_delay((ticks - 3) & 1u);
+
+    pio_phase_instructions[0] = pio_encode_pull(false, true) | side_none;
+    pio_phase_instructions[1] = pio_encode_mov(pio_x, pio_osr) | side_none;
+    pio_phase_instructions[2] = pio_encode_wait_gpio(false, CLOCK_OUTPUT) | side_none;
+    pio_phase_instructions[3] = pio_encode_mov(pio_y, pio_x) | side_phi0_n | odd;
+    pio_phase_instructions[4] = pio_encode_jmp_pin(7) | side_phi0_n;
+    pio_phase_instructions[5] = pio_encode_jmp_y_dec(4) | side_phi0_n;
+    pio_phase_instructions[6] = pio_encode_wait_gpio(true, CLOCK_OUTPUT) | pio_encode_sideset(3, SIDE_PHI2 | SIDE_PHI0_N);
+    pio_phase_instructions[7] = pio_encode_mov(pio_y, pio_x) | side_none | odd;
+    pio_phase_instructions[8] = pio_encode_jmp_pin(10) | side_none;
+    pio_phase_instructions[9] = pio_encode_jmp(3) | side_phi0_n;
+    pio_phase_instructions[10] = pio_encode_jmp_y_dec(8) | side_none;
+    pio_phase_instructions[11] = pio_encode_wait_gpio(false, CLOCK_OUTPUT) | pio_encode_sideset(3, SIDE_PHI1);
+}
+
+static void start_engine(void) {
+    pio_sm_config c = pio_get_default_sm_config();
+    sm_config_set_wrap(&c, phase_offset + PIO_PHASE_WRAP_TARGET, phase_offset + PIO_PHASE_PROGRAM_LENGTH - 1);
+    sm_config_set_sideset(&c, 3, false, false);
+    sm_config_set_sideset_pins(&c, PHI1_OUTPUT);
+    sm_config_set_jmp_pin(&c, CLOCK_OUTPUT);
+    sm_config_set_clkdiv_int_frac(&c, 1, 0);
+
+    // Both phases LOW until the program has seen the clock
+    uint32_t pin_mask = (1u << PHI1_OUTPUT) | (1u << PHI2_OUTPUT) | (1u << PHI0_N_OUTPUT);
+    pio_sm_set_pins_with_mask(phase_pio, phase_sm, 0, pin_mask);
+    pio_sm_set_pindirs_with_mask(phase_pio, phase_sm, pin_mask, pin_mask);
+    pio_gpio_init(phase_pio, PHI1_OUTPUT);
+    pio_gpio_init(phase_pio, PHI2_OUTPUT);
+    pio_gpio_init(phase_pio, PHI0_N_OUTPUT);
+
+    pio_sm_init(phase_pio, phase_sm, phase_offset, &c);
+    pio_sm_put(phase_pio, phase_sm, (dead_time - 3) >> 1);
+    pio_sm_set_enabled(phase_pio, phase_sm, true);
+}
+
+void pio_phase_init(void) {
+    build_program(PHI_DEAD_TIME_TICKS);
+    phase_offset = pio_add_program(phase_pio, &pio_phase_program);
+    phase_sm = (uint)pio_claim_unused_sm(phase_pio, true);
+    dead_time = PHI_DEAD_TIME_TICKS;
+    start_engine();
+}
+
+bool pio_phase_set_dead_time(uint32_t ticks) {
+    if (ticks < PHI_DEAD_TIME_MIN || ticks > PHI_DEAD_TIME_MAX) return false;
+
+    // Restart from the top: both phases drop, and the program waits for a
+    // LOW clock and a full dead time before raising phi2 again, so nothing
+    // overlaps on the way
+    pio_sm_set_enabled(phase_pio, phase_sm, false);
+    pio_sm_clear_fifos(phase_pio, phase_sm);
+    pio_sm_restart(phase_pio, phase_sm);
+    pio_sm_exec(phase_pio, phase_sm, pio_encode_jmp(phase_offset) | pio_encode_sideset(3, 0));
+
+    // The state machine is stopped, so the program can be swapped in place
+    pio_remove_program(phase_pio, &pio_phase_program, phase_offset);
+    build_program(ticks);
+    pio_add_program_at_offset(phase_pio, &pio_phase_program, phase_offset);
+    dead_time = ticks;
+    pio_sm_put(phase_pio, phase_sm, (dead_time - 3) >> 1);
+    pio_sm_set_enabled(phase_pio, phase_sm, true);
+    return true;
+}
+
+uint32_t pio_phase_get_dead_time(void) {
+    return dead_time;
+}
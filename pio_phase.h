@@ -0,0 +1,52 @@
+/**
+ * PIO Phase Engine Module for Multimode Clock Source
+ *
+ * This module derives two non-overlapping phases from CLOCK_OUTPUT in a
+ * PIO state machine, for CPUs such as the 6502, 6800 and Z8000 that need
+ * phi1/phi2 rather than a single clock:
+ *
+ *   PHI1_OUTPUT     HIGH while CLOCK_OUTPUT is HIGH, minus the dead time
+ *   PHI2_OUTPUT     HIGH while CLOCK_OUTPUT is LOW, minus the dead time
+ *   PHI0_N_OUTPUT   CLOCK_OUTPUT inverted
+ *
+ * CLOCK_OUTPUT itself serves as phi0. Because the phases follow the clock
+ * pin, they step together with every clock engine (single step, PIO, PWM,
+ * burst), and a reset pulse counts the same cycles. Each phase only rises
+ * a programmable dead time after the other has fallen, so the two never
+ * overlap at any clock frequency. A phase is HIGH for its clock half minus
+ * the dead time; a half too short for that leaves it LOW for the cycle,
+ * while PHI0_N_OUTPUT still follows every clock edge.
+ */
+
+#ifndef PIO_PHASE_H
+#define PIO_PHASE_H
+
+#include "pico/stdlib.h"
+#include "hardware/pio.h"
+
+// System clock cycles from a CLOCK_OUTPUT edge to the phase outputs
+// (input synchronizer plus one instruction; one more if the edge comes
+// during a dead time countdown)
+#define PIO_PHASE_LATENCY 3
+
+/**
+ * Initialize PIO phase engine (loads the program, claims a state machine
+ * and starts following CLOCK_OUTPUT with PHI_DEAD_TIME_TICKS)
+ */
+void pio_phase_init(void);
+
+/**
+ * Set the dead time between one phase falling and the other rising
+ * Takes effect at once; both phases are LOW until the clock next falls.
+ * @param ticks Dead time in system clock cycles (PHI_DEAD_TIME_MIN to PHI_DEAD_TIME_MAX)
+ * @return false if ticks is out of range
+ */
+bool pio_phase_set_dead_time(uint32_t ticks);
+
+/**
+ * Get the dead time
+ * @return Dead time in system clock cycles
+ */
+uint32_t pio_phase_get_dead_time(void);
+
+#endif // PIO_PHASE_H
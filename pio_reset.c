@@ -0,0 +1,125 @@
+/**
+ * PIO Reset Engine Module for Multimode Clock Source
+ */
+
+#include "pio_reset.h"
+#include "config.h"
+#include "hardware/irq.h"
+#include "hardware/sync.h"
+
+// Program layout (addresses relative to the load offset):
+//
+//   0: pull block                  ; OSR <- edges - 1, idle here with reset HIGH
+//   1: mov x, osr
+//   2: set pins, 0                 ; assert reset
+//   3: wait 0 gpio CLOCK_OUTPUT    ; only count full LOW-to-HIGH transitions
+//   4: wait 1 gpio CLOCK_OUTPUT    ; rising edge
+//   5: jmp x--, 3
+//   6: set pins, 1                 ; release on the Nth rising edge
+//   7: push noblock                ; report completion, wraps to 0
+//
+// Reset is released a few system clock cycles after the Nth rising edge
+// (input synchronizer plus two instructions). Each counted cycle takes at
+// least three instructions, so clocks up to sys_clk / 3 are counted exactly.
+#define PIO_RESET_PROGRAM_LENGTH 8
+
+static uint16_t pio_reset_instructions[PIO_RESET_PROGRAM_LENGTH];
+
+static const pio_program_t pio_reset_program = {
+    .instructions = pio_reset_instructions,
+    .length = PIO_RESET_PROGRAM_LENGTH,
+    .origin = -1,
+};
+
+// Engine state
+static PIO reset_pio = pio0;
+static uint reset_sm = 0;
+static uint reset_offset = 0;
+static volatile bool pulse_active = false;
+static volatile bool pulse_complete = false;
+
+static void build_program(void) {
+    pio_reset_instructions[0] = pio_encode_pull(false, true);
+    pio_reset_instructions[1] = pio_encode_mov(pio_x, pio_osr);
+    pio_reset_instructions[2] = pio_encode_set(pio_pins, 0);
+    pio_reset_instructions[3] = pio_encode_wait_gpio(false, CLOCK_OUTPUT);
+    pio_reset_instructions[4] = pio_encode_wait_gpio(true, CLOCK_OUTPUT);
+    pio_reset_instructions[5] = pio_encode_jmp_x_dec(3);
+    pio_reset_instructions[6] = pio_encode_set(pio_pins, 1);
+    pio_reset_instructions[7] = pio_encode_push(false, false);
+}
+
+static void pio_reset_irq(void) {
+    if (pio_sm_is_rx_fifo_empty(reset_pio, reset_sm)) return;
+    
+    while (!pio_sm_is_rx_fifo_empty(reset_pio, reset_sm)) {
+        pio_sm_get(reset_pio, reset_sm);
+    }
+    pulse_active = false;
+    pulse_complete = true;
+    __sev(); // Wake the reset engine's core
+}
+
+static void start_engine(void) {
+    pio_sm_config c = pio_get_default_sm_config();
+    sm_config_set_wrap(&c, reset_offset, reset_offset + PIO_RESET_PROGRAM_LENGTH - 1);
+    sm_config_set_set_pins(&c, RESET_OUTPUT, 1);
+    sm_config_set_clkdiv_int_frac(&c, 1, 0);
+    
+    // Reset output is normally high
+    uint32_t pin_mask = 1u << RESET_OUTPUT;
+    pio_sm_set_pins_with_mask(reset_pio, reset_sm, pin_mask, pin_mask);
+    pio_sm_set_pindirs_with_mask(reset_pio, reset_sm, pin_mask, pin_mask);
+    pio_gpio_init(reset_pio, RESET_OUTPUT);
+    
+    pio_sm_init(reset_pio, reset_sm, reset_offset, &c);
+    pio_sm_set_enabled(reset_pio, reset_sm, true);
+}
+
+void pio_reset_init(void) {
+    build_program();
+    reset_offset = pio_add_program(reset_pio, &pio_reset_program);
+    reset_sm = (uint)pio_claim_unused_sm(reset_pio, true);
+    pulse_active = false;
+    pulse_complete = false;
+    
+    pio_set_irq1_source_enabled(reset_pio, (enum pio_interrupt_source)(pis_sm0_rx_fifo_not_empty + reset_sm), true);
+    irq_add_shared_handler(PIO0_IRQ_1, pio_reset_irq, PICO_SHARED_IRQ_HANDLER_DEFAULT_ORDER_PRIORITY);
+    irq_set_enabled(PIO0_IRQ_1, true);
+    
+    start_engine();
+}
+
+bool pio_reset_start(uint32_t cycles) {
+    if (pulse_active || cycles == 0) return false;
+    
+    pulse_active = true;
+    pulse_complete = false;
+    pio_sm_put(reset_pio, reset_sm, cycles - 1);
+    return true;
+}
+
+void pio_reset_force(bool state) {
+    // Restart the program so it idles at the pull, then drive the pin
+    pio_sm_set_enabled(reset_pio, reset_sm, false);
+    pio_sm_clear_fifos(reset_pio, reset_sm);
+    pio_sm_restart(reset_pio, reset_sm);
+    pio_sm_exec(reset_pio, reset_sm, pio_encode_jmp(reset_offset));
+    pio_sm_exec(reset_pio, reset_sm, pio_encode_set(pio_pins, state ? 1 : 0));
+    pio_sm_set_enabled(reset_pio, reset_sm, true);
+    
+    pulse_active = false;
+    pulse_complete = false;
+}
+
+bool pio_reset_take_complete(void) {
+    uint32_t irq_state = save_and_disable_interrupts();
+    bool complete = pulse_complete;
+    pulse_complete = false;
+    restore_interrupts(irq_state);
+    return complete;
+}
+
+bool pio_reset_is_active(void) {
+    return pulse_active;
+}
@@ -0,0 +1,47 @@
+/**
+ * PIO Reset Engine Module for Multimode Clock Source
+ *
+ * This module drives RESET_OUTPUT from a PIO state machine that counts
+ * rising edges on CLOCK_OUTPUT. A pulse is released on the Nth rising edge
+ * itself, whichever engine (software, PIO or PWM) is driving the clock.
+ */
+
+#ifndef PIO_RESET_H
+#define PIO_RESET_H
+
+#include "pico/stdlib.h"
+#include "hardware/pio.h"
+
+/**
+ * Initialize PIO reset engine (loads the program, claims a state machine,
+ * takes over RESET_OUTPUT at HIGH and installs the completion interrupt)
+ * The interrupt is taken on the calling core.
+ */
+void pio_reset_init(void);
+
+/**
+ * Assert RESET_OUTPUT (LOW) until the given number of rising clock edges
+ * @param cycles Rising edges to hold reset for (at least 1)
+ * @return false if a pulse is already in progress or cycles is 0
+ */
+bool pio_reset_start(uint32_t cycles);
+
+/**
+ * Force RESET_OUTPUT, abandoning any pulse in progress
+ * @param state true for HIGH (not resetting), false for LOW (resetting)
+ */
+void pio_reset_force(bool state);
+
+/**
+ * Check for a finished pulse
+ * @return true once for each pulse released by the state machine
+ */
+bool pio_reset_take_complete(void);
+
+/**
+ * Get PIO reset engine state
+ * @return true while a pulse is waiting for clock edges
+ */
+bool pio_reset_is_active(void);
+
+#endif // PIO_RESET_H
@@ -0,0 +1,54 @@
+/**
+ * Potentiometer Filter Module for Multimode Clock Source
+ */
+
+#include "pot_filter.h"
+
+// Block mean of 12-bit samples as a 14-bit value << 8
+static uint32_t block_mean(uint32_t sum, uint32_t count) {
+    if (count == 0) count = 1;
+    return (uint32_t)((((uint64_t)sum << 10) + count / 2) / count);
+}
+
+// Filtered position; within the band of either end stop it is the end
+// itself, so the full range stays reachable despite the hysteresis
+static uint16_t filtered_value(const pot_filter_t *f) {
+    uint32_t value = (f->average + 128u) >> 8;
+    if (value <= f->hysteresis) return 0;
+    if (value >= POT_FILTER_MAX - f->hysteresis) return POT_FILTER_MAX;
+    return (uint16_t)value;
+}
+
+void pot_filter_init(pot_filter_t *f, uint32_t sum, uint32_t count, uint8_t iir_shift, uint16_t hysteresis) {
+    f->average = block_mean(sum, count);
+    f->iir_shift = iir_shift;
+    f->hysteresis = hysteresis;
+    f->value = filtered_value(f);
+}
+
+bool pot_filter_update(pot_filter_t *f, uint32_t sum, uint32_t count) {
+    // average += (mean - average) / 2^iir_shift, rounded toward the mean
+    int32_t step = (int32_t)(block_mean(sum, count) - f->average);
+    if (step >= 0) {
+        f->average += ((uint32_t)step + (1u << f->iir_shift) - 1u) >> f->iir_shift;
+    } else {
+        f->average -= ((uint32_t)-step + (1u << f->iir_shift) - 1u) >> f->iir_shift;
+    }
+    
+    // Follow the knob only once it has left the band around the output. An
+    // end stop is snapped to from a band away, so it is only left a band
+    // beyond that; otherwise clipped noise at the stop flaps across the snap
+    uint16_t filtered = filtered_value(f);
+    uint32_t band = f->hysteresis;
+    if (f->value == 0 || f->value == POT_FILTER_MAX) band += f->hysteresis;
+    bool at_end = (filtered == 0 || filtered == POT_FILTER_MAX) && filtered != f->value;
+    if (at_end || filtered > f->value + band || filtered + band < f->value) {
+        f->value = filtered;
+        return true;
+    }
+    return false;
+}
+
+uint16_t pot_filter_value(const pot_filter_t *f) {
+    return f->value;
+}
@@ -0,0 +1,55 @@
+/**
+ * Potentiometer Filter Module for Multimode Clock Source
+ *
+ * Turns blocks of raw 12-bit ADC samples into a steady 14-bit knob position.
+ * Each block is averaged (boxcar), the block means are smoothed by a
+ * first-order IIR filter, and the output only moves when the filtered value
+ * leaves a hysteresis band around it, so noise never reaches the clock
+ * engine as a stream of small retunes. It has no hardware access and is fed
+ * from the DMA sample ring on the device.
+ */
+
+#ifndef POT_FILTER_H
+#define POT_FILTER_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// Output range: 14 bits, four steps per ADC count
+#define POT_FILTER_BITS 14
+#define POT_FILTER_MAX ((1u << POT_FILTER_BITS) - 1)
+
+typedef struct {
+    uint32_t average;       // IIR state, 14-bit value << 8
+    uint16_t value;         // Output position (0 to POT_FILTER_MAX)
+    uint8_t iir_shift;      // IIR weight of a new block is 2^-iir_shift
+    uint16_t hysteresis;    // Change in 14-bit steps needed to move the output
+} pot_filter_t;
+
+/**
+ * Initialize a filter settled at a block of samples
+ * @param f Filter
+ * @param sum Sum of the samples
+ * @param count Number of samples (at least 1)
+ * @param iir_shift IIR weight of each new block is 2^-iir_shift (0 disables the IIR)
+ * @param hysteresis Change in 14-bit steps needed to move the output
+ */
+void pot_filter_init(pot_filter_t *f, uint32_t sum, uint32_t count, uint8_t iir_shift, uint16_t hysteresis);
+
+/**
+ * Feed a block of samples
+ * @param f Filter
+ * @param sum Sum of the 12-bit samples
+ * @param count Number of samples (at least 1)
+ * @return true if the output position moved
+ */
+bool pot_filter_update(pot_filter_t *f, uint32_t sum, uint32_t count);
+
+/**
+ * Get the output position
+ * @param f Filter
+ * @return Knob position (0 to POT_FILTER_MAX)
+ */
+uint16_t pot_filter_value(const pot_filter_t *f);
+
+#endif // POT_FILTER_H
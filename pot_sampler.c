@@ -0,0 +1,51 @@
+/**
+ * Potentiometer Sampler Module for Multimode Clock Source
+ */
+
+#include "pot_sampler.h"
+#include "hardware/adc.h"
+#include "hardware/dma.h"
+
+// Ring of conversion results; the DMA ring wraps on the address bits, so
+// the buffer must be aligned to its size
+static volatile uint16_t pot_samples[POT_SAMPLE_COUNT] __attribute__((aligned(1u << POT_SAMPLE_RING_BITS)));
+static int pot_dma_channel = -1;
+
+static void start_transfer(void) {
+    // The longest transfer lasts over 18 hours at 64kHz; pot_sampler_sum()
+    // restarts it when it runs out
+    dma_channel_set_trans_count((uint)pot_dma_channel, 0xffffffffu, true);
+}
+
+void pot_sampler_init(void) {
+    for (uint i = 0; i < POT_SAMPLE_COUNT; i++) {
+        pot_samples[i] = adc_read();
+    }
+    
+    // Free-running conversions into the FIFO, one DMA request per result
+    adc_fifo_setup(true, true, 1, false, false);
+    adc_set_clkdiv(48000000.0f / POT_ADC_SAMPLE_HZ - 1.0f);
+    
+    pot_dma_channel = dma_claim_unused_channel(true);
+    dma_channel_config config = dma_channel_get_default_config((uint)pot_dma_channel);
+    channel_config_set_transfer_data_size(&config, DMA_SIZE_16);
+    channel_config_set_read_increment(&config, false);
+    channel_config_set_write_increment(&config, true);
+    channel_config_set_ring(&config, true, POT_SAMPLE_RING_BITS);
+    channel_config_set_dreq(&config, DREQ_ADC);
+    dma_channel_configure((uint)pot_dma_channel, &config, pot_samples, &adc_hw->fifo, 0xffffffffu, true);
+    
+    adc_run(true);
+}
+
+uint32_t pot_sampler_sum(void) {
+    if (!dma_channel_is_busy((uint)pot_dma_channel)) {
+        start_transfer();
+    }
+    
+    uint32_t sum = 0;
+    for (uint i = 0; i < POT_SAMPLE_COUNT; i++) {
+        sum += pot_samples[i];
+    }
+    return sum;
+}
@@ -0,0 +1,31 @@
+/**
+ * Potentiometer Sampler Module for Multimode Clock Source
+ *
+ * This module runs the ADC free on the potentiometer input and has a DMA
+ * channel copy every conversion into a small ring buffer, so the CPU never
+ * waits for a conversion. Readers sum the ring, which always holds the most
+ * recent POT_SAMPLE_COUNT samples.
+ */
+
+#ifndef POT_SAMPLER_H
+#define POT_SAMPLER_H
+
+#include "pico/stdlib.h"
+#include "config.h"
+
+// Samples held in the ring (16-bit each)
+#define POT_SAMPLE_COUNT ((1u << POT_SAMPLE_RING_BITS) / sizeof(uint16_t))
+
+/**
+ * Initialize the sampler (claims a DMA channel and starts the ADC)
+ * Call after init_adc().
+ */
+void pot_sampler_init(void);
+
+/**
+ * Sum the most recent samples
+ * @return Sum of the last POT_SAMPLE_COUNT 12-bit samples
+ */
+uint32_t pot_sampler_sum(void);
+
+#endif // POT_SAMPLER_H
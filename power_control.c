@@ -4,30 +4,29 @@
 
 #include "power_control.h"
 #include "config.h"
+#include "button_handler.h"
+#include "output_trace.h"
+#include "control_arbiter.h"
 #include <stdio.h>
 
 // Power control state variables
 static bool power_state = false; // false = OFF (default), true = ON
 
-// Button debouncing for power button
-static uint32_t last_power_button_time = 0;
-
 // External function declaration
 extern void set_mode(clock_mode_t mode);
 
 void power_control_init(void) {
     power_state = false;
-    last_power_button_time = 0;
 }
 
 void handle_power_button(void) {
-    // Check for power button press (positive edge triggered, active low with pull-up)
-    bool pressed = !gpio_get(BUTTON_POWER);
-    uint32_t current_time = to_ms_since_boot(get_absolute_time());
-    
-    if (pressed && (current_time - last_power_button_time > DEBOUNCE_DELAY_MS)) {
-        last_power_button_time = current_time;
-        toggle_power_state();
+    // Check for power button press (debounced edge from button_handler)
+    if (button_pressed(BUTTON_INDEX_POWER)) {
+        bool switched_mode;
+        control_arbiter_power(CONTROL_SOURCE_PANEL, !power_state, &switched_mode);
+        if (switched_mode) {
+            printf("Power ON - automatically switched to Mode 1 (Single Step)\n");
+        }
         printf("Power %s\n", power_state ? "ON" : "OFF");
     }
 }
@@ -47,6 +46,7 @@ void set_power_state(bool state) {
     power_state = state;
     // Power control is inverted: LOW = power ON, HIGH = power OFF
     gpio_put(POWER_OUTPUT, !state);
+    output_trace_edge(OUTPUT_TRACE_POWER, !state);
     update_power_led();
 }
 
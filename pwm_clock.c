@@ -0,0 +1,233 @@
+/**
+ * PWM Clock Engine Module for Multimode Clock Source
+ */
+
+#include "pwm_clock.h"
+#include "config.h"
+#include "hardware/gpio.h"
+#include "hardware/irq.h"
+#include "hardware/sync.h"
+
+// TOP and CC are double-buffered and latch at the counter wrap, but the
+// clock divider takes effect immediately. A retune is therefore applied in
+// up to two steps from the wrap interrupt:
+//
+// - New divider not faster than the current one: write DIV, TOP and CC at
+//   the start of a period. That period runs the old TOP/CC on a slower (or
+//   equal) count, so both halves can only get longer; the next period is new.
+// - New divider faster: write TOP and CC first and let them latch, then
+//   write DIV at the start of the following period. That period runs the new
+//   TOP/CC and starts on the old, slower count, so it is never shorter than
+//   the new halves.
+//
+// TOP and CC are separate registers. If a wrap falls between the two writes,
+// one period mixes old and new values. Writing TOP first when it grows and CC
+// first when it shrinks keeps that mixed period's halves within bounds too.
+
+typedef enum {
+    RETUNE_IDLE,
+    RETUNE_ALL_AT_WRAP,     // Write DIV, TOP and CC at the next wrap
+    RETUNE_COUNT_FIRST,     // Write TOP and CC at the next wrap, then DIV
+    RETUNE_DIV_AT_WRAP      // TOP and CC latched, write DIV at the next wrap
+} retune_stage_t;
+
+typedef struct {
+    uint16_t div16;         // Divider in 1/16 steps (8.4 fixed point)
+    uint16_t wrap;
+    uint16_t level;
+} pwm_clock_setting_t;
+
+static uint clock_slice = 0;
+static uint clock_channel = 0;
+static bool engine_running = false;         // Started or waiting to start
+static bool start_pending = false;          // Waiting for CLOCK_OUTPUT to be free
+static bool slice_active = false;           // The slice owns CLOCK_OUTPUT
+static volatile bool stopping = false;      // Finishing a period before it lets go
+
+// Settings last written to the slice and settings waiting to be applied
+static pwm_clock_setting_t applied;
+static pwm_clock_setting_t pending;
+static volatile retune_stage_t retune_stage = RETUNE_IDLE;
+
+static void write_div(uint16_t div16) {
+    pwm_set_clkdiv_int_frac(clock_slice, (uint8_t)(div16 >> 4), (uint8_t)(div16 & 0xF));
+    applied.div16 = div16;
+}
+
+static void write_count(uint16_t wrap, uint16_t level) {
+    if (wrap >= applied.wrap) {
+        pwm_set_wrap(clock_slice, wrap);
+        pwm_set_chan_level(clock_slice, clock_channel, level);
+    } else {
+        pwm_set_chan_level(clock_slice, clock_channel, level);
+        pwm_set_wrap(clock_slice, wrap);
+    }
+    applied.wrap = wrap;
+    applied.level = level;
+}
+
+// Hand CLOCK_OUTPUT back to SIO; the pin is LOW for good
+static void release_pin(void) {
+    pwm_set_enabled(clock_slice, false);
+    gpio_set_dir(CLOCK_OUTPUT, GPIO_OUT);
+    gpio_set_function(CLOCK_OUTPUT, GPIO_FUNC_SIO);
+    slice_active = false;
+    stopping = false;
+}
+
+static void pwm_clock_wrap_irq(void) {
+    if (!(pwm_get_irq_status_mask() & (1u << clock_slice))) return;
+
+    if (stopping) {
+        // The compare level of 0 latched at this wrap
+        pwm_clear_irq(clock_slice);
+        pwm_set_irq_enabled(clock_slice, false);
+        release_pin();
+        __sev(); // Wake the clock engine's core for a start that waits
+        return;
+    }
+
+    switch (retune_stage) {
+        case RETUNE_ALL_AT_WRAP:
+            write_div(pending.div16);
+            write_count(pending.wrap, pending.level);
+            retune_stage = RETUNE_IDLE;
+            break;
+
+        case RETUNE_COUNT_FIRST:
+            write_count(pending.wrap, pending.level);
+            retune_stage = RETUNE_DIV_AT_WRAP;
+            break;
+
+        case RETUNE_DIV_AT_WRAP:
+            write_div(pending.div16);
+            retune_stage = RETUNE_IDLE;
+            break;
+
+        case RETUNE_IDLE:
+            break;
+    }
+
+    // Cleared only after the writes: a wrap while they were made must not
+    // count as the one that latched them, or the faster divider could be
+    // written before TOP and CC take effect. The next wrap has latched them.
+    pwm_clear_irq(clock_slice);
+
+    if (retune_stage == RETUNE_IDLE) {
+        pwm_set_irq_enabled(clock_slice, false);
+    }
+}
+
+void pwm_clock_init(void) {
+    clock_slice = pwm_gpio_to_slice_num(CLOCK_OUTPUT);
+    clock_channel = pwm_gpio_to_channel(CLOCK_OUTPUT);
+    engine_running = false;
+    start_pending = false;
+    slice_active = false;
+    stopping = false;
+    retune_stage = RETUNE_IDLE;
+
+    irq_add_shared_handler(PWM_IRQ_WRAP, pwm_clock_wrap_irq, PICO_SHARED_IRQ_HANDLER_DEFAULT_ORDER_PRIORITY);
+    irq_set_enabled(PWM_IRQ_WRAP, true);
+}
+
+// True while an engine, this one or the other, drives CLOCK_OUTPUT
+static bool output_held(void) {
+    enum gpio_function function = gpio_get_function(CLOCK_OUTPUT);
+    return function == GPIO_FUNC_PIO0 || function == GPIO_FUNC_PWM;
+}
+
+// Start a slice that has been set up, once no engine holds
+// CLOCK_OUTPUT: one never takes the pin while another is still letting go
+static void start_if_free(void) {
+    if (!start_pending || output_held()) return;
+
+    // Configure while disabled, with the counter at the level so the first
+    // period begins with a full LOW half
+    pwm_set_enabled(clock_slice, false);
+    write_div(pending.div16);
+    pwm_set_wrap(clock_slice, pending.wrap);
+    pwm_set_chan_level(clock_slice, clock_channel, pending.level);
+    applied.wrap = pending.wrap;
+    applied.level = pending.level;
+    pwm_set_counter(clock_slice, pending.level);
+
+    gpio_set_function(CLOCK_OUTPUT, GPIO_FUNC_PWM);
+    pwm_set_enabled(clock_slice, true);
+    start_pending = false;
+    slice_active = true;
+}
+
+void pwm_clock_start(const pwm_solution_t *solution) {
+    pwm_clock_setting_t setting = {
+        .div16 = (uint16_t)((solution->div_int << 4) | solution->div_frac),
+        .wrap = solution->wrap,
+        .level = solution->level,
+    };
+
+    if (engine_running && !start_pending) {
+        // Hand the new settings to the wrap interrupt
+        uint32_t irq_state = save_and_disable_interrupts();
+        pending = setting;
+        retune_stage = (setting.div16 >= applied.div16) ? RETUNE_ALL_AT_WRAP : RETUNE_COUNT_FIRST;
+        pwm_clear_irq(clock_slice);
+        pwm_set_irq_enabled(clock_slice, true);
+        restore_interrupts(irq_state);
+        return;
+    }
+
+    pending = setting;
+    engine_running = true;
+    start_pending = true;
+    start_if_free();
+}
+
+void pwm_clock_stop(void) {
+    engine_running = false;
+    start_pending = false;
+    if (!slice_active || stopping) return;
+
+    // Drop any retune still in flight
+    uint32_t irq_state = save_and_disable_interrupts();
+    retune_stage = RETUNE_IDLE;
+    pwm_set_irq_enabled(clock_slice, false);
+    restore_interrupts(irq_state);
+
+    // SIO takes over driving LOW whenever the slice lets go
+    gpio_put(CLOCK_OUTPUT, 0);
+
+    // A compare level of 0 latches at the next wrap, so after this period
+    // the pin stays LOW even if the LOW part is too short to catch. Seen
+    // LOW now, it can no longer rise and the slice stops at once; in a HIGH
+    // part the wrap interrupt lets it go once the period has ended, so
+    // stopping never leaves a runt pulse and the LOW part simply extends.
+    pwm_set_chan_level(clock_slice, clock_channel, 0);
+    if (!gpio_get(CLOCK_OUTPUT)) {
+        release_pin();
+        return;
+    }
+    irq_state = save_and_disable_interrupts();
+    stopping = true;
+    pwm_clear_irq(clock_slice);
+    pwm_set_irq_enabled(clock_slice, true);
+    restore_interrupts(irq_state);
+}
+
+void pwm_clock_update(void) {
+    start_if_free();
+}
+
+bool pwm_clock_next_deadline(uint64_t *deadline_us) {
+    if (!start_pending || output_held()) return false;
+
+    *deadline_us = time_us_64();
+    return true;
+}
+
+bool pwm_clock_is_running(void) {
+    return engine_running;
+}
+
+bool pwm_clock_retune_pending(void) {
+    return retune_stage != RETUNE_IDLE;
+}
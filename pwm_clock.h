@@ -0,0 +1,63 @@
+/**
+ * PWM Clock Engine Module for Multimode Clock Source
+ *
+ * This module drives CLOCK_OUTPUT from its PWM slice. Retuning a running
+ * slice is phase-continuous: new settings are applied from the wrap interrupt
+ * so they take effect on a cycle boundary, and the output is never disabled
+ * or re-muxed while running.
+ */
+
+#ifndef PWM_CLOCK_H
+#define PWM_CLOCK_H
+
+#include "pico/stdlib.h"
+#include "hardware/pwm.h"
+#include "pwm_solver.h"
+
+/**
+ * Initialize PWM clock engine (installs the shared wrap interrupt handler)
+ */
+void pwm_clock_init(void);
+
+/**
+ * Start the PWM clock, or retune it glitch-free if already running
+ * No half period during a retune is shorter than the shorter of the old and
+ * new half periods. A start runs a LOW half before its first rising edge,
+ * and waits for pwm_clock_update() while CLOCK_OUTPUT is still held by a
+ * stopping engine.
+ * @param solution Divider/wrap/level settings (e.g. from pwm_solve())
+ */
+void pwm_clock_start(const pwm_solution_t *solution);
+
+/**
+ * Stop the PWM clock at the end of a HIGH half and leave CLOCK_OUTPUT LOW
+ * Never waits: stopped in a HIGH half, the slice keeps the pin until the
+ * period ends and its wrap interrupt lets it go.
+ */
+void pwm_clock_stop(void);
+
+/**
+ * Make a start that was waiting for CLOCK_OUTPUT (call on the engine's core)
+ */
+void pwm_clock_update(void);
+
+/**
+ * Get when pwm_clock_update() next has work to do
+ * @param deadline_us Receives the time in microseconds
+ * @return true while a start waits on a pin that is now free
+ */
+bool pwm_clock_next_deadline(uint64_t *deadline_us);
+
+/**
+ * Get PWM clock running state
+ * @return true if the slice is driving CLOCK_OUTPUT, or waiting to
+ */
+bool pwm_clock_is_running(void);
+
+/**
+ * Check for a retune still waiting for a cycle boundary
+ * @return true if new settings have not been fully applied yet
+ */
+bool pwm_clock_retune_pending(void);
+
+#endif // PWM_CLOCK_H
@@ -0,0 +1,88 @@
+/**
+ * PWM Solver Module for Multimode Clock Source
+ */
+
+#include "pwm_solver.h"
+
+// Output frequency is (16 * sys_hz) / (div16 * period) where div16 is the
+// 8.4 fixed point divider and period = wrap + 1. For a fixed divider the best
+// period is either side of the exact quotient, so only two candidates per
+// divider step need to be checked.
+
+int32_t pwm_solver_error_ppb(uint64_t source_hz, uint64_t period_ticks, uint32_t frequency) {
+    if (frequency == 0 || period_ticks == 0) return 0;
+
+    uint64_t produced = (uint64_t)frequency * period_ticks;
+    int64_t diff = (int64_t)source_hz - (int64_t)produced;
+    int64_t ppb = (diff * 1000000000ll) / (int64_t)produced;
+
+    if (ppb > INT32_MAX) return INT32_MAX;
+    if (ppb < INT32_MIN) return INT32_MIN;
+    return (int32_t)ppb;
+}
+
+// Compare |num_a| / den_a against |num_b| / den_b without division
+static bool error_less(uint64_t num_a, uint64_t den_a, uint64_t num_b, uint64_t den_b) {
+    return num_a * den_b < num_b * den_a;
+}
+
+bool pwm_solve(uint32_t sys_hz, uint32_t frequency, pwm_solution_t *out) {
+    if (frequency == 0 || sys_hz == 0) return false;
+
+    uint64_t source = 16ull * sys_hz;
+
+    // Divider range that keeps the period within 2..65536 counts
+    uint64_t div_lo = (source + (uint64_t)frequency * PWM_SOLVER_PERIOD_MAX - 1) /
+                      ((uint64_t)frequency * PWM_SOLVER_PERIOD_MAX);
+    uint64_t div_hi = source / ((uint64_t)frequency * PWM_SOLVER_PERIOD_MIN);
+    if (div_lo < PWM_SOLVER_DIV16_MIN) div_lo = PWM_SOLVER_DIV16_MIN;
+    if (div_hi > PWM_SOLVER_DIV16_MAX) div_hi = PWM_SOLVER_DIV16_MAX;
+    if (div_lo > div_hi) return false;
+
+    // The closest pair can lie one divider step outside that range, with its
+    // period at a limit
+    if (div_lo > PWM_SOLVER_DIV16_MIN) div_lo--;
+    if (div_hi < PWM_SOLVER_DIV16_MAX) div_hi++;
+
+    uint32_t best_div = 0;
+    uint32_t best_period = 0;
+    uint64_t best_num = UINT64_MAX;
+    uint64_t best_den = 1;
+
+    // Ascending divider order visits the largest periods first, so a strict
+    // comparison keeps the finest duty resolution among equal errors
+    for (uint32_t div16 = (uint32_t)div_lo; div16 <= (uint32_t)div_hi; div16++) {
+        uint64_t step = (uint64_t)frequency * div16;
+        uint64_t quotient = source / step;
+
+        for (uint64_t candidate = 0; candidate < 2; candidate++) {
+            uint64_t period = quotient + candidate;
+            if (period < PWM_SOLVER_PERIOD_MIN) period = PWM_SOLVER_PERIOD_MIN;
+            if (period > PWM_SOLVER_PERIOD_MAX) period = PWM_SOLVER_PERIOD_MAX;
+
+            uint64_t produced = step * period;
+            uint64_t num = produced > source ? produced - source : source - produced;
+            uint64_t den = (uint64_t)div16 * period;
+
+            if (best_div == 0 || error_less(num, den, best_num, best_den)) {
+                best_div = div16;
+                best_period = (uint32_t)period;
+                best_num = num;
+                best_den = den;
+            }
+        }
+
+        if (best_num == 0) break; // Exact match
+    }
+
+    if (best_div == 0) return false;
+
+    uint64_t ticks = (uint64_t)best_div * best_period;
+    out->div_int = (uint8_t)(best_div >> 4);
+    out->div_frac = (uint8_t)(best_div & 0xF);
+    out->wrap = (uint16_t)(best_period - 1);
+    out->level = (uint16_t)(best_period / 2);
+    out->achieved_millihz = (source * 1000ull + ticks / 2) / ticks;
+    out->error_ppb = pwm_solver_error_ppb(source, ticks, frequency);
+    return true;
+}
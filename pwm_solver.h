@@ -0,0 +1,51 @@
+/**
+ * PWM Solver Module for Multimode Clock Source
+ *
+ * This module finds the RP2040 PWM divider (8.4 fixed point) and wrap value
+ * that produce a requested frequency with the lowest error. It is a pure
+ * computation with no hardware access so it can run anywhere.
+ */
+
+#ifndef PWM_SOLVER_H
+#define PWM_SOLVER_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// Divider limits in 1/16 steps (1.0 to 255 + 15/16)
+#define PWM_SOLVER_DIV16_MIN    16
+#define PWM_SOLVER_DIV16_MAX    4095
+
+// Counter period limits (wrap + 1); 2 is the minimum for a 50% duty cycle
+#define PWM_SOLVER_PERIOD_MIN   2
+#define PWM_SOLVER_PERIOD_MAX   65536
+
+typedef struct {
+    uint8_t div_int;            // Integer part of the clock divider (1-255)
+    uint8_t div_frac;           // Fractional part of the clock divider (0-15)
+    uint16_t wrap;              // Counter wrap (TOP) value
+    uint16_t level;             // Compare level for a 50% duty cycle
+    uint64_t achieved_millihz;  // Frequency actually produced
+    int32_t error_ppb;          // (achieved - requested) / requested, in ppb
+} pwm_solution_t;
+
+/**
+ * Find the divider/wrap pair closest to a requested frequency
+ * Ties are resolved towards the largest wrap for best duty resolution.
+ * @param sys_hz System clock frequency in Hz (e.g. clock_get_hz(clk_sys))
+ * @param frequency Requested frequency in Hz
+ * @param out Solution (only written when a solution exists)
+ * @return true if the frequency is reachable by a PWM slice
+ */
+bool pwm_solve(uint32_t sys_hz, uint32_t frequency, pwm_solution_t *out);
+
+/**
+ * Relative error of a clock derived as source_hz / period_ticks
+ * @param source_hz Counter source frequency in Hz
+ * @param period_ticks Source ticks per output period
+ * @param frequency Requested frequency in Hz
+ * @return Signed error in parts per billion (saturated to int32 range)
+ */
+int32_t pwm_solver_error_ppb(uint64_t source_hz, uint64_t period_ticks, uint32_t frequency);
+
+#endif // PWM_SOLVER_H
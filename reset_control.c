@@ -4,112 +4,130 @@
 
 #include "reset_control.h"
 #include "config.h"
+#include "button_handler.h"
+#include "clock_core.h"
+#include "pio_reset.h"
+#include "output_trace.h"
+#include "control_arbiter.h"
+#include "uart_control.h"
 #include <stdio.h>
 
-// Reset control state variables
-static bool reset_active = false;
-static bool reset_output_state = true; // Reset output is normally high
+// Reset control state variables (owned by core1, read by core0)
+static volatile bool reset_active = false;
+static volatile bool reset_output_state = true; // Reset output is normally high
+static uint32_t reset_cycles_requested = 0;
 static uint32_t reset_cycle_count = 0;
 static uint32_t reset_start_time = 0;
+static bool reset_stalled = false;      // Clock seen stopped during the pulse
+static uint32_t reset_stall_time = 0;   // When it was first seen stopped
 static uint32_t reset_high_led_timer = 0;
-static bool reset_waiting_for_edge = false; // For Mode 1 edge detection
 static bool last_clock_state_for_reset = false;
 
-// Button debouncing for reset button
-static uint32_t last_reset_button_time = 0;
-
 // External function declarations
-extern clock_mode_t get_current_mode(void);
+extern clock_mode_t get_engine_mode(void);
 extern bool get_clock_state(void);
-extern uint32_t get_current_frequency(void);
-extern uint32_t get_uart_set_frequency(void);
 
 void reset_control_init(void) {
     reset_active = false;
     reset_output_state = true;
+    reset_cycles_requested = 0;
     reset_cycle_count = 0;
     reset_start_time = 0;
+    reset_stalled = false;
+    reset_stall_time = 0;
     reset_high_led_timer = 0;
-    reset_waiting_for_edge = false;
     last_clock_state_for_reset = false;
-    last_reset_button_time = 0;
+    pio_reset_init();
 }
 
 void handle_reset_button(void) {
-    // Check for reset button press (positive edge triggered, active low with pull-up)
-    bool pressed = !gpio_get(BUTTON_RESET);
-    uint32_t current_time = to_ms_since_boot(get_absolute_time());
-    
-    if (pressed && (current_time - last_reset_button_time > DEBOUNCE_DELAY_MS)) {
-        last_reset_button_time = current_time;
-        if (!reset_active) {
-            start_reset_pulse();
-            printf("Reset pulse initiated\n");
+    // Check for reset button press (debounced edge from button_handler);
+    // a press during a pulse releases it
+    if (button_pressed(BUTTON_INDEX_RESET)) {
+        bool released;
+        if (control_arbiter_reset(CONTROL_SOURCE_PANEL, RESET_CYCLES, &released) == CONTROL_ARBITER_OK) {
+            printf(released ? "Reset pulse released\n" : "Reset pulse initiated\n");
         }
     }
 }
 
-void start_reset_pulse(void) {
+// Only a UART-controlled clock can stop with no one stepping it; Single
+// Step edges come from the operator however long they take
+static bool clock_stopped(clock_mode_t mode) {
+    return mode == MODE_UART_CONTROL && !get_uart_clock_running() &&
+           !get_uart_burst_active() && !get_uart_sweep_active();
+}
+
+// Reset is HIGH again: light LED_RESET_HIGH and report how the pulse ended
+static void end_pulse(clock_core_tlm_t report, clock_mode_t mode) {
+    uint32_t now = to_ms_since_boot(get_absolute_time());
+    reset_active = false;
+    reset_output_state = true;
+    reset_stalled = false;
+    reset_high_led_timer = now;
+    clock_core_telemetry(report, (uint8_t)mode, now - reset_start_time);
+}
+
+static void abandon_pulse(void) {
+    set_reset_output(true);
+    end_pulse(CORE_TLM_RESET_RELEASED, get_engine_mode());
+}
+
+void start_reset_pulse(uint32_t cycles) {
+    if (cycles == 0) cycles = RESET_CYCLES;
+    if (!pio_reset_start(cycles)) return;
+    output_trace_edge(OUTPUT_TRACE_RESET, false);
+    
+    // The state machine releases reset on the Nth rising edge of
+    // CLOCK_OUTPUT in every mode; the CPU only reports progress
     reset_active = true;
+    reset_output_state = false;
+    reset_cycles_requested = cycles;
     reset_cycle_count = 0;
     reset_start_time = to_ms_since_boot(get_absolute_time());
-    reset_waiting_for_edge = (get_current_mode() == MODE_SINGLE_STEP); // Mode 1 needs edge detection
+    reset_stalled = false;
     last_clock_state_for_reset = get_clock_state();
-    set_reset_output(false); // Start reset pulse (low)
-    printf("Reset pulse started, mode: %d\n", get_current_mode() + 1);
+    clock_core_telemetry(CORE_TLM_RESET_STARTED, (uint8_t)get_engine_mode(), cycles);
 }
 
 void update_reset_state(void) {
     if (!reset_active) return;
     
-    clock_mode_t current_mode = get_current_mode();
+    clock_mode_t current_mode = get_engine_mode();
     
     if (current_mode == MODE_SINGLE_STEP) {
-        // Mode 1: Track clock low-to-high transitions
+        // Mode 1: Report each clock low-to-high transition
         bool current_clock_state = get_clock_state();
-        if (reset_waiting_for_edge && !last_clock_state_for_reset && current_clock_state) {
-            // Detected low-to-high transition
+        if (!last_clock_state_for_reset && current_clock_state &&
+            reset_cycle_count < reset_cycles_requested) {
             reset_cycle_count++;
-            printf("Reset cycle %d/6 (Mode 1)\n", reset_cycle_count);
-            
-            if (reset_cycle_count >= RESET_CYCLES) {
-                set_reset_output(true); // End reset pulse
-                reset_active = false;
-                reset_high_led_timer = to_ms_since_boot(get_absolute_time());
-                printf("Reset pulse complete (Mode 1)\n");
-            }
+            clock_core_telemetry(CORE_TLM_RESET_CYCLE, 0, reset_cycle_count);
         }
         last_clock_state_for_reset = current_clock_state;
-    } else {
-        // Modes 2, 3, 4: Count actual clock cycles using timing
-        uint32_t elapsed_ms = to_ms_since_boot(get_absolute_time()) - reset_start_time;
-        uint32_t required_ms = 0;
-        
-        // Calculate required time based on current frequency
-        if (current_mode == MODE_LOW_FREQ && get_current_frequency() > 0) {
-            // For low frequency mode, use current frequency
-            required_ms = (RESET_CYCLES * 1000) / get_current_frequency();
-        } else if (current_mode == MODE_HIGH_FREQ) {
-            // For high frequency mode, use fixed 1MHz
-            required_ms = (RESET_CYCLES * 1000) / HIGH_FREQ_OUTPUT;
-            if (required_ms == 0) required_ms = 1; // Minimum 1ms for visibility
-        } else if (current_mode == MODE_UART_CONTROL && get_uart_set_frequency() > 0) {
-            // For UART control mode, use set frequency
-            required_ms = (RESET_CYCLES * 1000) / get_uart_set_frequency();
-        } else {
-            // Fallback for any undefined states
-            required_ms = 60; // Default 60ms (approximately 100Hz for 6 cycles)
-        }
-        
-        // Ensure minimum time for visibility (at least 10ms)
-        if (required_ms < 10) required_ms = 10;
-        
-        if (elapsed_ms >= required_ms) {
-            set_reset_output(true); // End reset pulse
-            reset_active = false;
-            reset_high_led_timer = to_ms_since_boot(get_absolute_time());
-            printf("Reset pulse complete (Mode %d, %dms)\n", current_mode + 1, elapsed_ms);
-        }
+    }
+    
+    if (pio_reset_take_complete()) {
+        // Traced when seen here, after the actual release by the state machine
+        output_trace_edge(OUTPUT_TRACE_RESET, true);
+        end_pulse(CORE_TLM_RESET_COMPLETE, current_mode);
+        return;
+    }
+    
+    // A stopped clock has no edges left to count
+    if (!clock_stopped(current_mode)) {
+        reset_stalled = false;
+    } else if (!reset_stalled) {
+        reset_stalled = true;
+        reset_stall_time = to_ms_since_boot(get_absolute_time());
+    } else if (to_ms_since_boot(get_absolute_time()) - reset_stall_time >= RESET_STALL_MS) {
+        abandon_pulse();
+    }
+}
+
+void release_reset_pulse(void) {
+    update_reset_state();
+    if (reset_active) {
+        abandon_pulse();
     }
 }
 
@@ -131,9 +149,34 @@ void update_reset_leds(void) {
     }
 }
 
+bool get_reset_deadline_ms(uint32_t *deadline_ms) {
+    // A stalled pulse giving up, or LED_RESET_HIGH turning off; a counted
+    // pulse ends in hardware
+    bool pending = false;
+    if (reset_active && reset_stalled) {
+        *deadline_ms = reset_stall_time + RESET_STALL_MS;
+        pending = true;
+    }
+    if (reset_high_led_timer > 0) {
+        uint32_t led_off_ms = reset_high_led_timer + RESET_HIGH_LED_MS;
+        if (!pending || (int32_t)(led_off_ms - *deadline_ms) < 0) {
+            *deadline_ms = led_off_ms;
+        }
+        pending = true;
+    }
+    return pending;
+}
+
 void set_reset_output(bool state) {
+    // RESET_OUTPUT belongs to the PIO engine; this abandons any pulse
+    pio_reset_force(state);
+    output_trace_edge(OUTPUT_TRACE_RESET, state);
+    reset_active = false;
     reset_output_state = state;
-    gpio_put(RESET_OUTPUT, state);
+}
+
+uint32_t get_reset_cycles_requested(void) {
+    return reset_cycles_requested;
 }
 
 bool get_reset_active(void) {
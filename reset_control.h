@@ -2,7 +2,11 @@
  * Reset Control Module for Multimode Clock Source
  * 
  * This module handles reset pulse generation and LED management.
+ * The pulse length is counted in clock cycles by a PIO state machine
+ * (see pio_reset.h), so it is exact at every frequency.
  * Provides a clean interface for reset control that can be reused in other projects.
+ * The reset engine runs on core1 (see clock_core.h); handle_reset_button()
+ * runs on core0 and posts the pulse request.
  */
 
 #ifndef RESET_CONTROL_H
@@ -22,12 +26,21 @@ void reset_control_init(void);
 void handle_reset_button(void);
 
 /**
- * Start a reset pulse sequence
+ * Start a reset pulse sequence (no effect if a pulse is already active)
+ * @param cycles Rising clock edges to hold reset for (0 for RESET_CYCLES)
  */
-void start_reset_pulse(void);
+void start_reset_pulse(uint32_t cycles);
+
+/**
+ * Release the active reset pulse before its last edge (no effect if none)
+ * A pulse that has just completed is reported as complete instead.
+ */
+void release_reset_pulse(void);
 
 /**
  * Update reset state machine (call regularly from main loop)
+ * A pulse waiting on a stopped UART-controlled clock is released after
+ * RESET_STALL_MS.
  */
 void update_reset_state(void);
 
@@ -37,7 +50,14 @@ void update_reset_state(void);
 void update_reset_leds(void);
 
 /**
- * Set reset output pin state
+ * Get the next time update_reset_state() or update_reset_leds() has work
+ * @param deadline_ms Receives the time in milliseconds since boot
+ * @return true if a stall release or LED change is pending
+ */
+bool get_reset_deadline_ms(uint32_t *deadline_ms);
+
+/**
+ * Set reset output pin state, abandoning any pulse in progress
  * @param state true for HIGH (not resetting), false for LOW (resetting)
  */
 void set_reset_output(bool state);
@@ -54,4 +74,10 @@ bool get_reset_active(void);
  */
 bool get_reset_output_state(void);
 
+/**
+ * Get length of the current or last reset pulse
+ * @return Rising clock edges requested for the pulse
+ */
+uint32_t get_reset_cycles_requested(void);
+
 #endif // RESET_CONTROL_H
\ No newline at end of file
@@ -0,0 +1,101 @@
+/**
+ * Scheduler Module for Multimode Clock Source
+ */
+
+#include "scheduler.h"
+
+// Binary min-heap of timer ids keyed on deadline_us. position[] tracks where
+// each id sits in the heap so a timer can be moved or cancelled in O(log n).
+
+static bool earlier(const scheduler_t *s, uint8_t a, uint8_t b) {
+    return s->deadline_us[s->heap[a]] < s->deadline_us[s->heap[b]];
+}
+
+static void swap_entries(scheduler_t *s, uint8_t a, uint8_t b) {
+    uint8_t id_a = s->heap[a];
+    uint8_t id_b = s->heap[b];
+    s->heap[a] = id_b;
+    s->heap[b] = id_a;
+    s->position[id_b] = (int8_t)a;
+    s->position[id_a] = (int8_t)b;
+}
+
+static void sift_up(scheduler_t *s, uint8_t index) {
+    while (index > 0) {
+        uint8_t parent = (uint8_t)((index - 1) / 2);
+        if (!earlier(s, index, parent)) break;
+        swap_entries(s, index, parent);
+        index = parent;
+    }
+}
+
+static void sift_down(scheduler_t *s, uint8_t index) {
+    while (true) {
+        uint8_t left = (uint8_t)(2 * index + 1);
+        uint8_t right = (uint8_t)(left + 1);
+        uint8_t smallest = index;
+        
+        if (left < s->count && earlier(s, left, smallest)) smallest = left;
+        if (right < s->count && earlier(s, right, smallest)) smallest = right;
+        if (smallest == index) break;
+        
+        swap_entries(s, index, smallest);
+        index = smallest;
+    }
+}
+
+void scheduler_init(scheduler_t *s) {
+    s->count = 0;
+    for (uint8_t id = 0; id < SCHEDULER_MAX_TIMERS; id++) {
+        s->deadline_us[id] = 0;
+        s->position[id] = -1;
+    }
+}
+
+void scheduler_arm(scheduler_t *s, uint8_t id, uint64_t deadline_us) {
+    if (id >= SCHEDULER_MAX_TIMERS) return;
+    
+    if (s->position[id] < 0) {
+        s->heap[s->count] = id;
+        s->position[id] = (int8_t)s->count;
+        s->count++;
+    }
+    s->deadline_us[id] = deadline_us;
+    
+    // The moved entry only needs to travel in one direction
+    sift_up(s, (uint8_t)s->position[id]);
+    sift_down(s, (uint8_t)s->position[id]);
+}
+
+void scheduler_cancel(scheduler_t *s, uint8_t id) {
+    if (id >= SCHEDULER_MAX_TIMERS || s->position[id] < 0) return;
+    
+    uint8_t index = (uint8_t)s->position[id];
+    uint8_t last = (uint8_t)(s->count - 1);
+    
+    swap_entries(s, index, last);
+    s->count--;
+    s->position[id] = -1;
+    
+    if (index < s->count) {
+        sift_up(s, index);
+        sift_down(s, index);
+    }
+}
+
+bool scheduler_is_armed(const scheduler_t *s, uint8_t id) {
+    return id < SCHEDULER_MAX_TIMERS && s->position[id] >= 0;
+}
+
+bool scheduler_next_deadline(const scheduler_t *s, uint64_t *deadline_us) {
+    if (s->count == 0) return false;
+    *deadline_us = s->deadline_us[s->heap[0]];
+    return true;
+}
+
+bool scheduler_pop_expired(scheduler_t *s, uint64_t now_us, uint8_t *id) {
+    if (s->count == 0 || s->deadline_us[s->heap[0]] > now_us) return false;
+    *id = s->heap[0];
+    scheduler_cancel(s, *id);
+    return true;
+}
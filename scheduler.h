@@ -0,0 +1,74 @@
+/**
+ * Scheduler Module for Multimode Clock Source
+ *
+ * Min-heap of timed deadlines for a tickless main loop. Each timer is
+ * identified by a small id and has at most one pending deadline; arming an
+ * armed timer moves it. The caller passes the current time to every call,
+ * so the scheduler has no hardware access and runs deterministically on a
+ * host against a simulated clock.
+ */
+
+#ifndef SCHEDULER_H
+#define SCHEDULER_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// Number of timer ids per scheduler (ids 0 to SCHEDULER_MAX_TIMERS - 1)
+#define SCHEDULER_MAX_TIMERS 8
+
+typedef struct {
+    uint64_t deadline_us[SCHEDULER_MAX_TIMERS];  // Deadline by timer id
+    uint8_t heap[SCHEDULER_MAX_TIMERS];          // Armed timer ids, earliest first
+    int8_t position[SCHEDULER_MAX_TIMERS];       // Heap index by timer id, -1 if not armed
+    uint8_t count;                               // Armed timers
+} scheduler_t;
+
+/**
+ * Initialize a scheduler with no timers armed
+ * @param s Scheduler
+ */
+void scheduler_init(scheduler_t *s);
+
+/**
+ * Arm a timer, or move its deadline if already armed
+ * @param s Scheduler
+ * @param id Timer id
+ * @param deadline_us Absolute deadline in microseconds
+ */
+void scheduler_arm(scheduler_t *s, uint8_t id, uint64_t deadline_us);
+
+/**
+ * Disarm a timer (no effect if not armed)
+ * @param s Scheduler
+ * @param id Timer id
+ */
+void scheduler_cancel(scheduler_t *s, uint8_t id);
+
+/**
+ * Check whether a timer is armed
+ * @param s Scheduler
+ * @param id Timer id
+ * @return true if the timer has a pending deadline
+ */
+bool scheduler_is_armed(const scheduler_t *s, uint8_t id);
+
+/**
+ * Get the earliest pending deadline
+ * @param s Scheduler
+ * @param deadline_us Receives the deadline if any timer is armed
+ * @return true if any timer is armed
+ */
+bool scheduler_next_deadline(const scheduler_t *s, uint64_t *deadline_us);
+
+/**
+ * Disarm and return the earliest timer that has expired
+ * Call repeatedly until it returns false to collect every expired timer.
+ * @param s Scheduler
+ * @param now_us Current time in microseconds
+ * @param id Receives the expired timer id
+ * @return true if a timer expired at or before now_us
+ */
+bool scheduler_pop_expired(scheduler_t *s, uint64_t now_us, uint8_t *id);
+
+#endif // SCHEDULER_H
@@ -0,0 +1,48 @@
+# Host simulator build (cmake -DMULTIMODE_HOST_SIM=ON)
+#
+# Compiles the unchanged firmware sources against the SDK shims in
+# sim/include and links them with the simulated cores and peripherals.
+# Firmware and models form a library, so host tests can drive the same
+# code from their own main().
+
+set(SIM_DIR ${CMAKE_CURRENT_SOURCE_DIR}/sim)
+
+# Optimized by default: fast clocks are simulated edge by edge
+if (NOT CMAKE_BUILD_TYPE)
+    set(CMAKE_BUILD_TYPE RelWithDebInfo)
+endif()
+
+add_library(multimode_sim STATIC
+        ${MULTIMODE_SOURCES}
+        ${SIM_DIR}/sim_core.c
+        ${SIM_DIR}/sim_gpio.c
+        ${SIM_DIR}/sim_pwm.c
+        ${SIM_DIR}/sim_pio.c
+        ${SIM_DIR}/sim_adc.c
+        ${SIM_DIR}/sim_dma.c
+        ${SIM_DIR}/sim_uart.c
+        ${SIM_DIR}/sim_trace.c
+        )
+
+target_include_directories(multimode_sim PUBLIC
+        ${SIM_DIR}/include
+        ${SIM_DIR}
+        ${CMAKE_CURRENT_SOURCE_DIR}
+        )
+
+# The firmware's main() becomes core0's entry point
+set_source_files_properties(main.c PROPERTIES COMPILE_DEFINITIONS main=firmware_main)
+
+target_link_libraries(multimode_sim PUBLIC m)
+
+set_target_properties(multimode_sim PROPERTIES C_STANDARD 11 C_EXTENSIONS ON)
+
+# uint32_t is unsigned long on the Pico, so the firmware's %lu formats are
+# only correct there
+target_compile_options(multimode_sim PUBLIC -Wall -Wno-format)
+
+add_executable(multimode_clock_sim ${SIM_DIR}/sim_main.c)
+target_link_libraries(multimode_clock_sim PRIVATE multimode_sim)
+set_target_properties(multimode_clock_sim PROPERTIES C_STANDARD 11 C_EXTENSIONS ON)
+
+include(${CMAKE_CURRENT_SOURCE_DIR}/tests/tests.cmake)
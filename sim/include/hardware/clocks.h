@@ -0,0 +1,41 @@
+/**
+ * Host simulator shim for hardware/clocks.h
+ */
+
+#ifndef SIM_HARDWARE_CLOCKS_H
+#define SIM_HARDWARE_CLOCKS_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+enum clock_index {
+    clk_gpout0 = 0,
+    clk_gpout1,
+    clk_gpout2,
+    clk_gpout3,
+    clk_ref,
+    clk_sys,
+    clk_peri,
+    clk_usb,
+    clk_adc,
+    clk_rtc,
+    CLK_COUNT
+};
+
+// Clock source selectors (values as in the RP2040 register headers)
+#define CLOCKS_CLK_SYS_CTRL_SRC_VALUE_CLKSRC_CLK_SYS_AUX    0x1u
+#define CLOCKS_CLK_SYS_CTRL_AUXSRC_VALUE_CLKSRC_PLL_SYS     0x0u
+#define CLOCKS_CLK_SYS_CTRL_AUXSRC_VALUE_CLKSRC_PLL_USB     0x1u
+#define CLOCKS_CLK_PERI_CTRL_AUXSRC_VALUE_CLK_SYS           0x0u
+#define CLOCKS_CLK_PERI_CTRL_AUXSRC_VALUE_CLKSRC_PLL_SYS    0x1u
+#define CLOCKS_CLK_PERI_CTRL_AUXSRC_VALUE_CLKSRC_PLL_USB    0x2u
+
+uint32_t clock_get_hz(enum clock_index clk_index);
+
+/**
+ * Select a clock's source and divide it down (the simulator only records
+ * the frequency; a new clk_sys frequency changes the simulated core clock)
+ */
+bool clock_configure(enum clock_index clk_index, uint32_t src, uint32_t auxsrc, uint32_t src_freq, uint32_t freq);
+
+#endif // SIM_HARDWARE_CLOCKS_H
@@ -0,0 +1,93 @@
+/**
+ * Host simulator shim for hardware/dma.h
+ */
+
+#ifndef SIM_HARDWARE_DMA_H
+#define SIM_HARDWARE_DMA_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+typedef unsigned int uint;
+
+#define NUM_DMA_CHANNELS 12
+
+// Transfer request signals (RP2040 numbering)
+#define DREQ_UART0_TX   20
+#define DREQ_UART0_RX   21
+#define DREQ_UART1_TX   22
+#define DREQ_UART1_RX   23
+#define DREQ_ADC        36
+#define DREQ_FORCE      0x3f
+
+enum dma_channel_transfer_size {
+    DMA_SIZE_8 = 0,
+    DMA_SIZE_16 = 1,
+    DMA_SIZE_32 = 2
+};
+
+// CTRL register layout
+#define DMA_CH0_CTRL_TRIG_EN_BITS           0x00000001u
+#define DMA_CH0_CTRL_TRIG_DATA_SIZE_LSB     2
+#define DMA_CH0_CTRL_TRIG_DATA_SIZE_BITS    0x0000000cu
+#define DMA_CH0_CTRL_TRIG_INCR_READ_BITS    0x00000010u
+#define DMA_CH0_CTRL_TRIG_INCR_WRITE_BITS   0x00000020u
+#define DMA_CH0_CTRL_TRIG_RING_SIZE_LSB     6
+#define DMA_CH0_CTRL_TRIG_RING_SIZE_BITS    0x000003c0u
+#define DMA_CH0_CTRL_TRIG_RING_SEL_BITS     0x00000400u
+#define DMA_CH0_CTRL_TRIG_CHAIN_TO_LSB      11
+#define DMA_CH0_CTRL_TRIG_CHAIN_TO_BITS     0x00007800u
+#define DMA_CH0_CTRL_TRIG_TREQ_SEL_LSB      15
+#define DMA_CH0_CTRL_TRIG_TREQ_SEL_BITS     0x001f8000u
+
+typedef struct {
+    uint32_t ctrl;
+} dma_channel_config;
+
+int dma_claim_unused_channel(bool required);
+void dma_channel_unclaim(uint channel);
+dma_channel_config dma_channel_get_default_config(uint channel);
+
+static inline void channel_config_set_transfer_data_size(dma_channel_config *c, enum dma_channel_transfer_size size) {
+    c->ctrl = (c->ctrl & ~DMA_CH0_CTRL_TRIG_DATA_SIZE_BITS) | ((uint32_t)size << DMA_CH0_CTRL_TRIG_DATA_SIZE_LSB);
+}
+
+static inline void channel_config_set_read_increment(dma_channel_config *c, bool incr) {
+    c->ctrl = incr ? (c->ctrl | DMA_CH0_CTRL_TRIG_INCR_READ_BITS) : (c->ctrl & ~DMA_CH0_CTRL_TRIG_INCR_READ_BITS);
+}
+
+static inline void channel_config_set_write_increment(dma_channel_config *c, bool incr) {
+    c->ctrl = incr ? (c->ctrl | DMA_CH0_CTRL_TRIG_INCR_WRITE_BITS) : (c->ctrl & ~DMA_CH0_CTRL_TRIG_INCR_WRITE_BITS);
+}
+
+static inline void channel_config_set_ring(dma_channel_config *c, bool write, uint size_bits) {
+    c->ctrl = (c->ctrl & ~(DMA_CH0_CTRL_TRIG_RING_SIZE_BITS | DMA_CH0_CTRL_TRIG_RING_SEL_BITS)) |
+              ((uint32_t)size_bits << DMA_CH0_CTRL_TRIG_RING_SIZE_LSB) |
+              (write ? DMA_CH0_CTRL_TRIG_RING_SEL_BITS : 0u);
+}
+
+static inline void channel_config_set_dreq(dma_channel_config *c, uint dreq) {
+    c->ctrl = (c->ctrl & ~DMA_CH0_CTRL_TRIG_TREQ_SEL_BITS) | ((uint32_t)dreq << DMA_CH0_CTRL_TRIG_TREQ_SEL_LSB);
+}
+
+static inline void channel_config_set_chain_to(dma_channel_config *c, uint chain_to) {
+    c->ctrl = (c->ctrl & ~DMA_CH0_CTRL_TRIG_CHAIN_TO_BITS) | ((uint32_t)chain_to << DMA_CH0_CTRL_TRIG_CHAIN_TO_LSB);
+}
+
+static inline void channel_config_set_enable(dma_channel_config *c, bool enable) {
+    c->ctrl = enable ? (c->ctrl | DMA_CH0_CTRL_TRIG_EN_BITS) : (c->ctrl & ~DMA_CH0_CTRL_TRIG_EN_BITS);
+}
+
+void dma_channel_configure(uint channel, const dma_channel_config *config, volatile void *write_addr,
+                           const volatile void *read_addr, uint transfer_count, bool trigger);
+void dma_channel_set_read_addr(uint channel, const volatile void *read_addr, bool trigger);
+void dma_channel_set_write_addr(uint channel, volatile void *write_addr, bool trigger);
+void dma_channel_set_trans_count(uint channel, uint32_t trans_count, bool trigger);
+void dma_channel_start(uint channel);
+void dma_channel_abort(uint channel);
+bool dma_channel_is_busy(uint channel);
+void dma_channel_set_irq0_enabled(uint channel, bool enabled);
+bool dma_channel_get_irq0_status(uint channel);
+void dma_channel_acknowledge_irq0(uint channel);
+
+#endif // SIM_HARDWARE_DMA_H
@@ -0,0 +1,251 @@
+/**
+ * Host simulator shim for hardware/pio.h
+ *
+ * State machine configuration uses the hardware register layouts, so the
+ * sm_config_* helpers behave exactly as in the SDK and the simulator decodes
+ * the same fields the hardware does.
+ */
+
+#ifndef SIM_HARDWARE_PIO_H
+#define SIM_HARDWARE_PIO_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "hardware/pio_instructions.h"
+#include "hardware/gpio.h"
+
+typedef unsigned int uint;
+
+#define NUM_PIOS 2
+#define NUM_PIO_STATE_MACHINES 4
+#define PIO_INSTRUCTION_COUNT 32
+
+typedef struct pio_inst pio_hw_t;
+typedef pio_hw_t *PIO;
+extern pio_hw_t sim_pio0_inst, sim_pio1_inst;
+#define pio0 (&sim_pio0_inst)
+#define pio1 (&sim_pio1_inst)
+
+typedef struct {
+    uint32_t clkdiv;
+    uint32_t execctrl;
+    uint32_t shiftctrl;
+    uint32_t pinctrl;
+} pio_sm_config;
+
+typedef struct {
+    const uint16_t *instructions;
+    uint8_t length;
+    int8_t origin; // required instruction memory origin or -1
+} pio_program_t;
+
+enum pio_fifo_join {
+    PIO_FIFO_JOIN_NONE = 0,
+    PIO_FIFO_JOIN_TX = 1,
+    PIO_FIFO_JOIN_RX = 2,
+};
+
+enum pio_mov_status_type {
+    STATUS_TX_LESSTHAN = 0,
+    STATUS_RX_LESSTHAN = 1
+};
+
+enum pio_interrupt_source {
+    pis_interrupt0 = 8,
+    pis_interrupt1 = 9,
+    pis_interrupt2 = 10,
+    pis_interrupt3 = 11,
+    pis_sm0_tx_fifo_not_full = 4,
+    pis_sm1_tx_fifo_not_full = 5,
+    pis_sm2_tx_fifo_not_full = 6,
+    pis_sm3_tx_fifo_not_full = 7,
+    pis_sm0_rx_fifo_not_empty = 0,
+    pis_sm1_rx_fifo_not_empty = 1,
+    pis_sm2_rx_fifo_not_empty = 2,
+    pis_sm3_rx_fifo_not_empty = 3,
+};
+
+// Register field layouts (RP2040 datasheet, PIO SMx_* registers)
+#define PIO_SM0_CLKDIV_INT_LSB              16
+#define PIO_SM0_CLKDIV_FRAC_LSB             8
+#define PIO_SM0_EXECCTRL_SIDE_EN_BITS       0x40000000u
+#define PIO_SM0_EXECCTRL_SIDE_PINDIR_BITS   0x20000000u
+#define PIO_SM0_EXECCTRL_JMP_PIN_LSB        24
+#define PIO_SM0_EXECCTRL_JMP_PIN_BITS       0x1f000000u
+#define PIO_SM0_EXECCTRL_OUT_EN_SEL_LSB     19
+#define PIO_SM0_EXECCTRL_OUT_EN_SEL_BITS    0x00f80000u
+#define PIO_SM0_EXECCTRL_INLINE_OUT_EN_BITS 0x00040000u
+#define PIO_SM0_EXECCTRL_OUT_STICKY_BITS    0x00020000u
+#define PIO_SM0_EXECCTRL_WRAP_TOP_LSB       12
+#define PIO_SM0_EXECCTRL_WRAP_TOP_BITS      0x0001f000u
+#define PIO_SM0_EXECCTRL_WRAP_BOTTOM_LSB    7
+#define PIO_SM0_EXECCTRL_WRAP_BOTTOM_BITS   0x00000f80u
+#define PIO_SM0_EXECCTRL_STATUS_SEL_LSB     4
+#define PIO_SM0_EXECCTRL_STATUS_SEL_BITS    0x00000010u
+#define PIO_SM0_EXECCTRL_STATUS_N_LSB       0
+#define PIO_SM0_EXECCTRL_STATUS_N_BITS      0x0000000fu
+#define PIO_SM0_SHIFTCTRL_FJOIN_RX_BITS     0x80000000u
+#define PIO_SM0_SHIFTCTRL_FJOIN_TX_BITS     0x40000000u
+#define PIO_SM0_SHIFTCTRL_PULL_THRESH_LSB   25
+#define PIO_SM0_SHIFTCTRL_PULL_THRESH_BITS  0x3e000000u
+#define PIO_SM0_SHIFTCTRL_PUSH_THRESH_LSB   20
+#define PIO_SM0_SHIFTCTRL_PUSH_THRESH_BITS  0x01f00000u
+#define PIO_SM0_SHIFTCTRL_OUT_SHIFTDIR_BITS 0x00080000u
+#define PIO_SM0_SHIFTCTRL_IN_SHIFTDIR_BITS  0x00040000u
+#define PIO_SM0_SHIFTCTRL_AUTOPULL_BITS     0x00020000u
+#define PIO_SM0_SHIFTCTRL_AUTOPUSH_BITS     0x00010000u
+#define PIO_SM0_PINCTRL_SIDESET_COUNT_LSB   29
+#define PIO_SM0_PINCTRL_SIDESET_COUNT_BITS  0xe0000000u
+#define PIO_SM0_PINCTRL_SET_COUNT_LSB       26
+#define PIO_SM0_PINCTRL_SET_COUNT_BITS      0x1c000000u
+#define PIO_SM0_PINCTRL_OUT_COUNT_LSB       20
+#define PIO_SM0_PINCTRL_OUT_COUNT_BITS      0x03f00000u
+#define PIO_SM0_PINCTRL_IN_BASE_LSB         15
+#define PIO_SM0_PINCTRL_IN_BASE_BITS        0x000f8000u
+#define PIO_SM0_PINCTRL_SIDESET_BASE_LSB    10
+#define PIO_SM0_PINCTRL_SIDESET_BASE_BITS   0x00007c00u
+#define PIO_SM0_PINCTRL_SET_BASE_LSB        5
+#define PIO_SM0_PINCTRL_SET_BASE_BITS       0x000003e0u
+#define PIO_SM0_PINCTRL_OUT_BASE_LSB        0
+#define PIO_SM0_PINCTRL_OUT_BASE_BITS       0x0000001fu
+
+static inline uint32_t sim_pio_set_field(uint32_t reg, uint32_t bits, uint lsb, uint32_t value) {
+    return (reg & ~bits) | ((value << lsb) & bits);
+}
+
+static inline void sm_config_set_out_pins(pio_sm_config *c, uint out_base, uint out_count) {
+    c->pinctrl = sim_pio_set_field(c->pinctrl, PIO_SM0_PINCTRL_OUT_BASE_BITS, PIO_SM0_PINCTRL_OUT_BASE_LSB, out_base);
+    c->pinctrl = sim_pio_set_field(c->pinctrl, PIO_SM0_PINCTRL_OUT_COUNT_BITS, PIO_SM0_PINCTRL_OUT_COUNT_LSB, out_count);
+}
+
+static inline void sm_config_set_set_pins(pio_sm_config *c, uint set_base, uint set_count) {
+    c->pinctrl = sim_pio_set_field(c->pinctrl, PIO_SM0_PINCTRL_SET_BASE_BITS, PIO_SM0_PINCTRL_SET_BASE_LSB, set_base);
+    c->pinctrl = sim_pio_set_field(c->pinctrl, PIO_SM0_PINCTRL_SET_COUNT_BITS, PIO_SM0_PINCTRL_SET_COUNT_LSB, set_count);
+}
+
+static inline void sm_config_set_in_pins(pio_sm_config *c, uint in_base) {
+    c->pinctrl = sim_pio_set_field(c->pinctrl, PIO_SM0_PINCTRL_IN_BASE_BITS, PIO_SM0_PINCTRL_IN_BASE_LSB, in_base);
+}
+
+static inline void sm_config_set_sideset_pins(pio_sm_config *c, uint sideset_base) {
+    c->pinctrl = sim_pio_set_field(c->pinctrl, PIO_SM0_PINCTRL_SIDESET_BASE_BITS, PIO_SM0_PINCTRL_SIDESET_BASE_LSB, sideset_base);
+}
+
+static inline void sm_config_set_sideset(pio_sm_config *c, uint bit_count, bool optional, bool pindirs) {
+    c->pinctrl = sim_pio_set_field(c->pinctrl, PIO_SM0_PINCTRL_SIDESET_COUNT_BITS, PIO_SM0_PINCTRL_SIDESET_COUNT_LSB, bit_count);
+    c->execctrl = (c->execctrl & ~(PIO_SM0_EXECCTRL_SIDE_EN_BITS | PIO_SM0_EXECCTRL_SIDE_PINDIR_BITS)) |
+                  (optional ? PIO_SM0_EXECCTRL_SIDE_EN_BITS : 0u) |
+                  (pindirs ? PIO_SM0_EXECCTRL_SIDE_PINDIR_BITS : 0u);
+}
+
+static inline void sm_config_set_clkdiv_int_frac(pio_sm_config *c, uint16_t div_int, uint8_t div_frac) {
+    c->clkdiv = ((uint32_t)div_frac << PIO_SM0_CLKDIV_FRAC_LSB) | ((uint32_t)div_int << PIO_SM0_CLKDIV_INT_LSB);
+}
+
+static inline void sm_config_set_clkdiv(pio_sm_config *c, float div) {
+    uint16_t div_int = (uint16_t)div;
+    uint8_t div_frac = div_int ? (uint8_t)((div - (float)div_int) * 256.0f) : 0;
+    sm_config_set_clkdiv_int_frac(c, div_int, div_frac);
+}
+
+static inline void sm_config_set_wrap(pio_sm_config *c, uint wrap_target, uint wrap) {
+    c->execctrl = sim_pio_set_field(c->execctrl, PIO_SM0_EXECCTRL_WRAP_TOP_BITS, PIO_SM0_EXECCTRL_WRAP_TOP_LSB, wrap);
+    c->execctrl = sim_pio_set_field(c->execctrl, PIO_SM0_EXECCTRL_WRAP_BOTTOM_BITS, PIO_SM0_EXECCTRL_WRAP_BOTTOM_LSB, wrap_target);
+}
+
+static inline void sm_config_set_jmp_pin(pio_sm_config *c, uint pin) {
+    c->execctrl = sim_pio_set_field(c->execctrl, PIO_SM0_EXECCTRL_JMP_PIN_BITS, PIO_SM0_EXECCTRL_JMP_PIN_LSB, pin);
+}
+
+static inline void sm_config_set_in_shift(pio_sm_config *c, bool shift_right, bool autopush, uint push_threshold) {
+    c->shiftctrl = (c->shiftctrl & ~(PIO_SM0_SHIFTCTRL_IN_SHIFTDIR_BITS | PIO_SM0_SHIFTCTRL_AUTOPUSH_BITS)) |
+                   (shift_right ? PIO_SM0_SHIFTCTRL_IN_SHIFTDIR_BITS : 0u) |
+                   (autopush ? PIO_SM0_SHIFTCTRL_AUTOPUSH_BITS : 0u);
+    c->shiftctrl = sim_pio_set_field(c->shiftctrl, PIO_SM0_SHIFTCTRL_PUSH_THRESH_BITS, PIO_SM0_SHIFTCTRL_PUSH_THRESH_LSB, push_threshold & 0x1fu);
+}
+
+static inline void sm_config_set_out_shift(pio_sm_config *c, bool shift_right, bool autopull, uint pull_threshold) {
+    c->shiftctrl = (c->shiftctrl & ~(PIO_SM0_SHIFTCTRL_OUT_SHIFTDIR_BITS | PIO_SM0_SHIFTCTRL_AUTOPULL_BITS)) |
+                   (shift_right ? PIO_SM0_SHIFTCTRL_OUT_SHIFTDIR_BITS : 0u) |
+                   (autopull ? PIO_SM0_SHIFTCTRL_AUTOPULL_BITS : 0u);
+    c->shiftctrl = sim_pio_set_field(c->shiftctrl, PIO_SM0_SHIFTCTRL_PULL_THRESH_BITS, PIO_SM0_SHIFTCTRL_PULL_THRESH_LSB, pull_threshold & 0x1fu);
+}
+
+static inline void sm_config_set_fifo_join(pio_sm_config *c, enum pio_fifo_join join) {
+    c->shiftctrl = (c->shiftctrl & ~(PIO_SM0_SHIFTCTRL_FJOIN_TX_BITS | PIO_SM0_SHIFTCTRL_FJOIN_RX_BITS)) |
+                   (join == PIO_FIFO_JOIN_TX ? PIO_SM0_SHIFTCTRL_FJOIN_TX_BITS : 0u) |
+                   (join == PIO_FIFO_JOIN_RX ? PIO_SM0_SHIFTCTRL_FJOIN_RX_BITS : 0u);
+}
+
+static inline void sm_config_set_out_special(pio_sm_config *c, bool sticky, bool has_enable_pin, uint enable_pin_index) {
+    c->execctrl = (c->execctrl & ~(PIO_SM0_EXECCTRL_OUT_STICKY_BITS | PIO_SM0_EXECCTRL_INLINE_OUT_EN_BITS)) |
+                  (sticky ? PIO_SM0_EXECCTRL_OUT_STICKY_BITS : 0u) |
+                  (has_enable_pin ? PIO_SM0_EXECCTRL_INLINE_OUT_EN_BITS : 0u);
+    c->execctrl = sim_pio_set_field(c->execctrl, PIO_SM0_EXECCTRL_OUT_EN_SEL_BITS, PIO_SM0_EXECCTRL_OUT_EN_SEL_LSB, enable_pin_index);
+}
+
+static inline void sm_config_set_mov_status(pio_sm_config *c, enum pio_mov_status_type status_sel, uint status_n) {
+    c->execctrl = sim_pio_set_field(c->execctrl, PIO_SM0_EXECCTRL_STATUS_SEL_BITS, PIO_SM0_EXECCTRL_STATUS_SEL_LSB, status_sel);
+    c->execctrl = sim_pio_set_field(c->execctrl, PIO_SM0_EXECCTRL_STATUS_N_BITS, PIO_SM0_EXECCTRL_STATUS_N_LSB, status_n);
+}
+
+static inline pio_sm_config pio_get_default_sm_config(void) {
+    pio_sm_config c = {0, 0, 0, 0};
+    sm_config_set_clkdiv_int_frac(&c, 1, 0);
+    sm_config_set_wrap(&c, 0, 31);
+    sm_config_set_in_shift(&c, true, false, 32);
+    sm_config_set_out_shift(&c, true, false, 32);
+    return c;
+}
+
+uint pio_get_index(PIO pio);
+bool pio_can_add_program(PIO pio, const pio_program_t *program);
+uint pio_add_program(PIO pio, const pio_program_t *program);
+void pio_add_program_at_offset(PIO pio, const pio_program_t *program, uint offset);
+void pio_remove_program(PIO pio, const pio_program_t *program, uint loaded_offset);
+void pio_clear_instruction_memory(PIO pio);
+
+void pio_sm_claim(PIO pio, uint sm);
+int pio_claim_unused_sm(PIO pio, bool required);
+void pio_sm_unclaim(PIO pio, uint sm);
+bool pio_sm_is_claimed(PIO pio, uint sm);
+
+void pio_gpio_init(PIO pio, uint pin);
+void pio_sm_init(PIO pio, uint sm, uint initial_pc, const pio_sm_config *config);
+void pio_sm_set_config(PIO pio, uint sm, const pio_sm_config *config);
+void pio_sm_set_enabled(PIO pio, uint sm, bool enabled);
+void pio_set_sm_mask_enabled(PIO pio, uint32_t mask, bool enabled);
+void pio_sm_restart(PIO pio, uint sm);
+void pio_sm_clkdiv_restart(PIO pio, uint sm);
+void pio_sm_set_clkdiv_int_frac(PIO pio, uint sm, uint16_t div_int, uint8_t div_frac);
+void pio_sm_set_clkdiv(PIO pio, uint sm, float div);
+void pio_sm_set_wrap(PIO pio, uint sm, uint wrap_target, uint wrap);
+void pio_sm_exec(PIO pio, uint sm, uint instr);
+bool pio_sm_is_exec_stalled(PIO pio, uint sm);
+uint8_t pio_sm_get_pc(PIO pio, uint sm);
+
+void pio_sm_set_pins(PIO pio, uint sm, uint32_t pin_values);
+void pio_sm_set_pins_with_mask(PIO pio, uint sm, uint32_t pin_values, uint32_t pin_mask);
+void pio_sm_set_pindirs_with_mask(PIO pio, uint sm, uint32_t pin_dirs, uint32_t pin_mask);
+int pio_sm_set_consecutive_pindirs(PIO pio, uint sm, uint pin_base, uint pin_count, bool is_out);
+
+void pio_sm_put(PIO pio, uint sm, uint32_t data);
+void pio_sm_put_blocking(PIO pio, uint sm, uint32_t data);
+uint32_t pio_sm_get(PIO pio, uint sm);
+uint32_t pio_sm_get_blocking(PIO pio, uint sm);
+bool pio_sm_is_rx_fifo_full(PIO pio, uint sm);
+bool pio_sm_is_rx_fifo_empty(PIO pio, uint sm);
+uint pio_sm_get_rx_fifo_level(PIO pio, uint sm);
+bool pio_sm_is_tx_fifo_full(PIO pio, uint sm);
+bool pio_sm_is_tx_fifo_empty(PIO pio, uint sm);
+uint pio_sm_get_tx_fifo_level(PIO pio, uint sm);
+void pio_sm_clear_fifos(PIO pio, uint sm);
+void pio_sm_drain_tx_fifo(PIO pio, uint sm);
+
+void pio_set_irq0_source_enabled(PIO pio, enum pio_interrupt_source source, bool enabled);
+void pio_set_irq1_source_enabled(PIO pio, enum pio_interrupt_source source, bool enabled);
+void pio_set_irqn_source_enabled(PIO pio, uint irq_index, enum pio_interrupt_source source, bool enabled);
+bool pio_interrupt_get(PIO pio, uint pio_interrupt_num);
+void pio_interrupt_clear(PIO pio, uint pio_interrupt_num);
+
+#endif // SIM_HARDWARE_PIO_H
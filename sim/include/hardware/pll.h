@@ -0,0 +1,18 @@
+/**
+ * Host simulator shim for hardware/pll.h
+ */
+
+#ifndef SIM_HARDWARE_PLL_H
+#define SIM_HARDWARE_PLL_H
+
+#include "pico/stdlib.h"
+
+typedef struct pll_hw pll_hw_t;
+typedef pll_hw_t *PLL;
+
+#define pll_sys ((PLL)1)
+#define pll_usb ((PLL)2)
+
+void pll_init(PLL pll, uint ref_div, uint vco_freq, uint post_div1, uint post_div2);
+
+#endif // SIM_HARDWARE_PLL_H
@@ -0,0 +1,13 @@
+/**
+ * Host simulator shim for hardware/timer.h
+ */
+
+#ifndef SIM_HARDWARE_TIMER_H
+#define SIM_HARDWARE_TIMER_H
+
+#include <stdint.h>
+
+uint64_t time_us_64(void);
+uint32_t time_us_32(void);
+
+#endif // SIM_HARDWARE_TIMER_H
@@ -0,0 +1,54 @@
+/**
+ * Host simulator shim for hardware/uart.h
+ */
+
+#ifndef SIM_HARDWARE_UART_H
+#define SIM_HARDWARE_UART_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include "hardware/dma.h"
+
+typedef unsigned int uint;
+
+typedef struct uart_inst uart_inst_t;
+extern uart_inst_t sim_uart0_inst, sim_uart1_inst;
+#define uart0 (&sim_uart0_inst)
+#define uart1 (&sim_uart1_inst)
+
+// Register block; only the data register is used, as a DMA target
+typedef struct {
+    volatile uint32_t dr;
+    volatile uint32_t rsr;
+} uart_hw_t;
+
+typedef enum {
+    UART_PARITY_NONE,
+    UART_PARITY_EVEN,
+    UART_PARITY_ODD
+} uart_parity_t;
+
+uint uart_init(uart_inst_t *uart, uint baudrate);
+void uart_deinit(uart_inst_t *uart);
+uint uart_set_baudrate(uart_inst_t *uart, uint baudrate);
+void uart_set_format(uart_inst_t *uart, uint data_bits, uint stop_bits, uart_parity_t parity);
+void uart_set_fifo_enabled(uart_inst_t *uart, bool enabled);
+void uart_set_irq_enables(uart_inst_t *uart, bool rx_has_data, bool tx_needs_data);
+uint uart_get_index(uart_inst_t *uart);
+uart_hw_t *uart_get_hw(uart_inst_t *uart);
+
+static inline uint uart_get_dreq(uart_inst_t *uart, bool is_tx) {
+    return DREQ_UART0_TX + uart_get_index(uart) * 2u + (is_tx ? 0u : 1u);
+}
+
+bool uart_is_writable(uart_inst_t *uart);
+bool uart_is_readable(uart_inst_t *uart);
+void uart_putc_raw(uart_inst_t *uart, char c);
+void uart_putc(uart_inst_t *uart, char c);
+void uart_puts(uart_inst_t *uart, const char *s);
+void uart_write_blocking(uart_inst_t *uart, const uint8_t *src, size_t len);
+char uart_getc(uart_inst_t *uart);
+void uart_read_blocking(uart_inst_t *uart, uint8_t *dst, size_t len);
+
+#endif // SIM_HARDWARE_UART_H
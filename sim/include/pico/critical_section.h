@@ -0,0 +1,30 @@
+/**
+ * Host simulator shim for pico/critical_section.h
+ *
+ * Simulated cores only switch while waiting, so masking interrupts on the
+ * calling core is enough to exclude the other core as well.
+ */
+
+#ifndef SIM_PICO_CRITICAL_SECTION_H
+#define SIM_PICO_CRITICAL_SECTION_H
+
+#include <stdint.h>
+#include "hardware/sync.h"
+
+typedef struct {
+    uint32_t save;
+} critical_section_t;
+
+static inline void critical_section_init(critical_section_t *crit_sec) {
+    crit_sec->save = 0;
+}
+
+static inline void critical_section_enter_blocking(critical_section_t *crit_sec) {
+    crit_sec->save = save_and_disable_interrupts();
+}
+
+static inline void critical_section_exit(critical_section_t *crit_sec) {
+    restore_interrupts(crit_sec->save);
+}
+
+#endif // SIM_PICO_CRITICAL_SECTION_H
@@ -0,0 +1,22 @@
+/**
+ * Host simulator shim for pico/stdio.h
+ *
+ * stdout goes to the host terminal, standing in for USB CDC, and to every
+ * driver the firmware enables. getchar() input arrives through UART0; USB
+ * CDC input is read from the stdio_usb driver.
+ */
+
+#ifndef SIM_PICO_STDIO_H
+#define SIM_PICO_STDIO_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+typedef struct stdio_driver stdio_driver_t;
+
+bool stdio_init_all(void);
+int getchar_timeout_us(uint32_t timeout_us);
+void stdio_set_driver_enabled(stdio_driver_t *driver, bool enabled);
+void stdio_flush(void);
+
+#endif // SIM_PICO_STDIO_H
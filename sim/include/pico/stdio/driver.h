@@ -0,0 +1,21 @@
+/**
+ * Host simulator shim for pico/stdio/driver.h
+ */
+
+#ifndef SIM_PICO_STDIO_DRIVER_H
+#define SIM_PICO_STDIO_DRIVER_H
+
+#include "pico/stdio.h"
+
+// Host line endings; no CR is added
+#define PICO_STDIO_ENABLE_CRLF_SUPPORT 0
+
+struct stdio_driver {
+    void (*out_chars)(const char *buf, int len);
+    void (*out_flush)(void);
+    int (*in_chars)(char *buf, int len);
+    void (*set_chars_available_callback)(void (*fn)(void *), void *param);
+    stdio_driver_t *next;
+};
+
+#endif // SIM_PICO_STDIO_DRIVER_H
@@ -0,0 +1,18 @@
+/**
+ * Host simulator shim for pico/stdio_usb.h
+ *
+ * Output written to the driver goes to the host terminal; input is typed
+ * by the "usb" script action.
+ */
+
+#ifndef SIM_PICO_STDIO_USB_H
+#define SIM_PICO_STDIO_USB_H
+
+#include "pico/stdio.h"
+#include "pico/stdio/driver.h"
+
+extern stdio_driver_t stdio_usb;
+
+bool stdio_usb_connected(void);
+
+#endif // SIM_PICO_STDIO_USB_H
@@ -0,0 +1,84 @@
+/**
+ * Host simulator shim for pico/stdlib.h
+ *
+ * Declares the subset of the Pico SDK used by the firmware; the definitions
+ * live in the simulator (see sim.h). Time is virtual and only advances while
+ * every simulated core is waiting.
+ */
+
+#ifndef SIM_PICO_STDLIB_H
+#define SIM_PICO_STDLIB_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+typedef unsigned int uint;
+
+// Microseconds since boot (a plain integer on the host)
+typedef uint64_t absolute_time_t;
+
+#include "hardware/gpio.h"
+#include "hardware/uart.h"
+#include "hardware/timer.h"
+#include "pico/stdio.h"
+
+typedef int32_t alarm_id_t;
+typedef int64_t (*alarm_callback_t)(alarm_id_t id, void *user_data);
+
+#define PICO_ERROR_TIMEOUT (-1)
+#define PICO_ERROR_NO_DATA (-3)
+
+#define __not_in_flash_func(func_name) func_name
+#define __time_critical_func(func_name) func_name
+
+static inline absolute_time_t get_absolute_time(void) {
+    return time_us_64();
+}
+
+static inline uint32_t to_ms_since_boot(absolute_time_t t) {
+    return (uint32_t)(t / 1000u);
+}
+
+static inline uint64_t to_us_since_boot(absolute_time_t t) {
+    return t;
+}
+
+static inline absolute_time_t from_us_since_boot(uint64_t us) {
+    return us;
+}
+
+static inline absolute_time_t make_timeout_time_us(uint64_t us) {
+    return time_us_64() + us;
+}
+
+static inline absolute_time_t make_timeout_time_ms(uint32_t ms) {
+    return time_us_64() + ms * 1000ull;
+}
+
+void sleep_us(uint64_t us);
+void sleep_ms(uint32_t ms);
+void sleep_until(absolute_time_t target);
+
+/**
+ * Wait for an event or until the timeout
+ * @return true if the timeout was reached
+ */
+bool best_effort_wfe_or_timeout(absolute_time_t timeout_timestamp);
+
+// Busy-wait loop body; lets virtual time advance on the host
+void tight_loop_contents(void);
+
+alarm_id_t add_alarm_in_us(uint64_t us, alarm_callback_t callback, void *user_data, bool fire_if_past);
+alarm_id_t add_alarm_in_ms(uint32_t ms, alarm_callback_t callback, void *user_data, bool fire_if_past);
+bool cancel_alarm(alarm_id_t alarm_id);
+
+uint get_core_num(void);
+
+/**
+ * Find PLL settings for a system clock frequency
+ * @return true if freq_khz can be made exactly from the crystal
+ */
+bool check_sys_clock_khz(uint32_t freq_khz, uint *vco_freq_out, uint *post_div1_out, uint *post_div2_out);
+
+#endif // SIM_PICO_STDLIB_H
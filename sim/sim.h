@@ -0,0 +1,264 @@
+/**
+ * Host Simulator for Multimode Clock Source
+ *
+ * The firmware is compiled unchanged against the SDK shims in sim/include;
+ * this header is the simulator's internal interface between those shims.
+ *
+ * Time is virtual and counted in system clock cycles; when the firmware
+ * retunes clk_sys the count carries on at the new rate. Both cores run as
+ * coroutines: code executes in zero virtual time and time only advances
+ * while every core is waiting (WFE, sleep, busy-wait loops). Peripherals are
+ * event driven "agents" that report the cycle of their next event, so idle
+ * stretches of any length cost nothing on the host.
+ */
+
+#ifndef SIM_H
+#define SIM_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdio.h>
+
+typedef unsigned int uint;
+
+#define SIM_NEVER           UINT64_MAX
+#define SIM_NUM_CORES       2
+#define SIM_NUM_IRQS        32
+#define SIM_NUM_GPIOS       30
+
+// Virtual time
+
+/**
+ * Current virtual time in system clock cycles
+ */
+uint64_t sim_now(void);
+
+/**
+ * System clock frequency in Hz
+ */
+uint32_t sim_sys_hz(void);
+
+/**
+ * Convert microseconds to system clock cycles
+ */
+uint64_t sim_us_to_cycles(uint64_t us);
+
+/**
+ * Convert picoseconds to system clock cycles (rounded up)
+ */
+uint64_t sim_ps_to_cycles(uint64_t ps);
+
+/**
+ * Convert system clock cycles to microseconds (rounded down)
+ */
+uint64_t sim_cycles_to_us(uint64_t cycles);
+
+/**
+ * Convert system clock cycles to picoseconds (rounded down)
+ * Cycles before a system clock change keep the rate they ran at.
+ */
+uint64_t sim_cycles_to_ps(uint64_t cycles);
+
+// Event-driven peripherals
+
+typedef struct {
+    const char *name;
+    uint64_t (*next_event)(void);   // Cycle of the next event, or SIM_NEVER
+    void (*run_event)(uint64_t now); // Handle every event due at or before now
+} sim_agent_t;
+
+/**
+ * Register a peripheral model with the event loop
+ */
+void sim_register_agent(const sim_agent_t *agent);
+
+/**
+ * Register the level of an interrupt line
+ * @param irq Interrupt number (hardware/irq.h)
+ * @param asserted Returns true while the line is asserted towards a core
+ */
+void sim_register_irq_source(uint irq, bool (*asserted)(uint core));
+
+// Cores
+
+/**
+ * Run the simulation
+ * @param core0_entry Firmware entry point for core0
+ * @param until Stop once virtual time reaches this cycle
+ * @return Virtual time when the simulation stopped
+ */
+uint64_t sim_core_run(void (*core0_entry)(void), uint64_t until);
+
+/**
+ * Request the event loop to stop after the current event
+ */
+void sim_stop(void);
+
+/**
+ * Wait on the calling core
+ * @param deadline Cycle at which to resume (SIM_NEVER to wait indefinitely)
+ * @param wake_on_event Resume early on SEV or an interrupt (WFE semantics)
+ */
+void sim_core_wait(uint64_t deadline, bool wake_on_event);
+
+/**
+ * Core the caller is running on (0 when called from the event loop)
+ */
+uint sim_core_current(void);
+
+// GPIO pads
+
+/**
+ * Current pad level
+ */
+bool sim_gpio_level(uint gpio);
+
+/**
+ * Recompute a pad after its driver changed and report edges
+ */
+void sim_gpio_refresh(uint gpio);
+
+/**
+ * Recompute every pad in a mask
+ */
+void sim_gpio_refresh_mask(uint32_t mask);
+
+/**
+ * Drive a pad from outside the chip
+ * @param level 0 or 1, or -1 to release the pad
+ */
+void sim_gpio_drive(uint gpio, int level);
+
+/**
+ * Keep a pad's edges exact even when nothing on chip watches it
+ */
+void sim_gpio_watch(uint gpio, bool watch);
+
+/**
+ * Check whether a pad's edges must be produced as they happen
+ * (traced, interrupt enabled, or a PIO state machine waits on it)
+ */
+bool sim_gpio_watched(uint gpio);
+
+typedef void (*sim_edge_hook_t)(uint gpio, bool level, uint64_t now);
+
+/**
+ * Call a hook on every edge of a watched pad
+ */
+void sim_gpio_add_edge_hook(sim_edge_hook_t hook);
+
+// Pad drivers, queried by the GPIO model
+
+bool sim_pwm_pad_output(uint gpio, bool *level);
+void sim_pwm_gpio_edge(uint gpio, bool level);
+bool sim_pio_pad_output(uint pio_index, uint gpio, bool *level);
+uint32_t sim_pio_wait_mask(void);
+void sim_pio_gpio_changed(uint gpio);
+
+// External stimulus
+
+/**
+ * Set the voltage seen by an ADC input, as a 12-bit conversion result
+ */
+void sim_adc_set(uint input, uint16_t value);
+
+/**
+ * Add Gaussian noise to an ADC input
+ * @param sigma Standard deviation in ADC counts (0 for none)
+ */
+void sim_adc_set_noise(uint input, float sigma);
+
+// ADC as a DMA source
+
+/**
+ * Conversions completed by the free-running ADC so far
+ */
+uint64_t sim_adc_conversions(void);
+
+/**
+ * Keep the conversions completed so far before the system clock changes
+ */
+void sim_adc_clock_change(void);
+
+/**
+ * Result of the next conversion (advances the round robin)
+ */
+uint16_t sim_adc_take(void);
+
+/**
+ * Discard conversions nobody will see
+ */
+void sim_adc_skip(uint64_t count);
+
+/**
+ * Queue bytes on a UART receiver, arriving at the programmed baud rate
+ */
+void sim_uart_inject(uint index, const char *data, uint32_t length);
+
+/**
+ * Characters lost because a UART receive FIFO was full
+ */
+uint32_t sim_uart_overruns(uint index);
+
+/**
+ * Queue bytes from the USB host (they arrive at once, with a USB interrupt)
+ */
+void sim_usb_inject(const char *data, uint32_t length);
+
+/**
+ * Bytes from the USB host lost because the firmware did not read them
+ */
+uint32_t sim_usb_overruns(void);
+
+/**
+ * Copy a UART's transmissions to the console
+ */
+void sim_uart_set_echo(uint index, bool echo);
+
+/**
+ * Write a UART's transmissions, unaltered, to a file (NULL to stop)
+ */
+void sim_uart_set_capture(uint index, FILE *file);
+
+// UART transmitter as a DMA target
+
+/**
+ * System clock cycles one character takes on the line
+ */
+uint64_t sim_uart_char_cycles(uint index);
+
+/**
+ * Put a character on a UART's line
+ */
+void sim_uart_transmit(uint index, uint8_t c);
+
+/**
+ * The host terminal. Firmware stdout is copied here (standing in for USB
+ * CDC) and to the stdio drivers the firmware enables; simulator reports
+ * write here directly so they never reach a simulated UART.
+ */
+extern FILE *sim_console;
+
+/**
+ * Record the clock, reset and power outputs from now on
+ * @param path VCD file written by sim_trace_finish()
+ */
+void sim_trace_start(const char *path);
+
+/**
+ * Write the recorded trace, if any
+ */
+void sim_trace_finish(void);
+
+/**
+ * Initialize the peripheral models
+ */
+void sim_peripherals_init(void);
+
+void sim_gpio_init(void);
+void sim_pwm_init(void);
+void sim_pio_init(void);
+void sim_dma_init(void);
+void sim_uart_init(void);
+
+#endif // SIM_H
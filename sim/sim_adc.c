@@ -0,0 +1,153 @@
+/**
+ * Host Simulator: ADC
+ *
+ * Conversions are computed on demand: a one-shot adc_read() returns at
+ * once, and a free-running ADC only counts the conversions it would have
+ * completed, which the DMA model collects when the firmware looks at its
+ * channels. Each input has a scripted value and optional Gaussian noise
+ * from a fixed-seed generator, so noisy runs are repeatable.
+ */
+
+#include "sim.h"
+#include "hardware/adc.h"
+#include <math.h>
+
+#define SIM_ADC_INPUTS 5
+#define SIM_ADC_CLOCK_HZ 48000000u
+#define SIM_ADC_MIN_DIV 96u             // A conversion takes 96 ADC clocks
+
+adc_hw_t sim_adc_hw;
+
+static uint16_t adc_values[SIM_ADC_INPUTS];
+static float adc_noise[SIM_ADC_INPUTS];
+static uint adc_selected = 0;
+static uint adc_round_robin = 0;
+static bool adc_running = false;
+static float adc_div = 0.0f;
+static uint64_t run_start = 0;          // Cycle of the first conversion in this run
+static uint64_t run_base = 0;           // Conversions completed before this run
+static uint64_t rng_state = 0x9e3779b97f4a7c15ull;
+
+static double uniform(void) {
+    // xorshift64*, top 53 bits
+    rng_state ^= rng_state >> 12;
+    rng_state ^= rng_state << 25;
+    rng_state ^= rng_state >> 27;
+    return (double)((rng_state * 0x2545f4914f6cdd1dull) >> 11) / 9007199254740992.0;
+}
+
+static uint16_t convert(uint input) {
+    if (input >= SIM_ADC_INPUTS) return 0;
+    double value = adc_values[input];
+    if (adc_noise[input] > 0.0f) {
+        // Box-Muller
+        double u = uniform();
+        double v = uniform();
+        value += adc_noise[input] * sqrt(-2.0 * log(1.0 - u)) * cos(2.0 * M_PI * v);
+    }
+    long result = lround(value);
+    return (uint16_t)(result < 0 ? 0 : result > 4095 ? 4095 : result);
+}
+
+static void advance_input(void) {
+    if (adc_round_robin == 0) return;
+    do {
+        adc_selected = (adc_selected + 1) % SIM_ADC_INPUTS;
+    } while (!(adc_round_robin & (1u << adc_selected)));
+}
+
+static double conversion_cycles(void) {
+    double adc_clocks = adc_div + 1.0 < SIM_ADC_MIN_DIV ? SIM_ADC_MIN_DIV : adc_div + 1.0;
+    return adc_clocks * sim_sys_hz() / SIM_ADC_CLOCK_HZ;
+}
+
+static uint64_t conversions_this_run(void) {
+    if (!adc_running) return 0;
+    return (uint64_t)((double)(sim_now() - run_start) / conversion_cycles());
+}
+
+void sim_adc_set(uint input, uint16_t value) {
+    if (input < SIM_ADC_INPUTS) adc_values[input] = value & 0xfffu;
+}
+
+void sim_adc_set_noise(uint input, float sigma) {
+    if (input < SIM_ADC_INPUTS) adc_noise[input] = sigma;
+}
+
+uint64_t sim_adc_conversions(void) {
+    return run_base + conversions_this_run();
+}
+
+void sim_adc_clock_change(void) {
+    // The ADC clock is fixed, but conversions are counted in system cycles
+    if (adc_running) {
+        run_base += conversions_this_run();
+        run_start = sim_now();
+    }
+}
+
+uint16_t sim_adc_take(void) {
+    uint16_t result = convert(adc_selected);
+    advance_input();
+    return result;
+}
+
+void sim_adc_skip(uint64_t count) {
+    if (adc_round_robin == 0) return;
+    for (uint64_t i = 0; i < count % SIM_ADC_INPUTS; i++) {
+        advance_input();
+    }
+}
+
+void adc_init(void) {
+    adc_selected = 0;
+    adc_round_robin = 0;
+    adc_running = false;
+    adc_div = 0.0f;
+}
+
+void adc_select_input(uint input) {
+    adc_selected = input;
+}
+
+uint adc_get_selected_input(void) {
+    return adc_selected;
+}
+
+void adc_set_round_robin(uint input_mask) {
+    adc_round_robin = input_mask & ((1u << SIM_ADC_INPUTS) - 1u);
+}
+
+uint16_t adc_read(void) {
+    return convert(adc_selected);
+}
+
+void adc_run(bool run) {
+    if (run == adc_running) return;
+    if (run) {
+        run_start = sim_now();
+    } else {
+        run_base += conversions_this_run();
+    }
+    adc_running = run;
+}
+
+void adc_set_clkdiv(float clkdiv) {
+    // Keep the conversions already completed at the old rate
+    bool running = adc_running;
+    adc_run(false);
+    adc_div = clkdiv;
+    adc_run(running);
+}
+
+void adc_fifo_setup(bool en, bool dreq_en, uint16_t dreq_thresh, bool err_in_fifo, bool byte_shift) {
+    // Results are always 12-bit and handed straight to DMA
+    (void)en;
+    (void)dreq_en;
+    (void)dreq_thresh;
+    (void)err_in_fifo;
+    (void)byte_shift;
+}
+
+void adc_fifo_drain(void) {
+}
@@ -0,0 +1,624 @@
+/**
+ * Host Simulator: cores, interrupts and virtual time
+ */
+
+#define _XOPEN_SOURCE 700
+#include "sim.h"
+#include "pico/stdlib.h"
+#include "pico/multicore.h"
+#include "hardware/sync.h"
+#include "hardware/irq.h"
+#include "hardware/clocks.h"
+#include "hardware/pll.h"
+#include <ucontext.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define SIM_CORE_STACK_SIZE     (1024 * 1024)
+#define SIM_MAX_AGENTS          16
+#define SIM_MAX_SHARED_HANDLERS 8
+#define SIM_MAX_ALARMS          16
+#define SIM_MAX_RATE_SEGMENTS   1024
+
+// Cycles a busy-wait iteration takes, and time reads allowed before a core
+// that never waits is treated as spinning on the clock
+#define SIM_SPIN_CYCLES         8
+#define SIM_SPIN_TIME_READS     2000
+
+// Interrupt deliveries in one go before a line is considered stuck
+#define SIM_IRQ_STORM_LIMIT     100000
+
+typedef enum {
+    CORE_OFF,
+    CORE_READY,
+    CORE_WAITING,
+    CORE_DONE
+} core_state_t;
+
+typedef struct {
+    ucontext_t context;
+    void *stack;
+    void (*entry)(void);
+    core_state_t state;
+    uint64_t deadline;
+    bool wake_on_event;
+    bool event;             // ARM event register (SEV/WFE)
+    bool irq_masked;        // PRIMASK
+    bool in_irq;
+    bool nvic_enabled[SIM_NUM_IRQS];
+    uint32_t time_reads;
+} sim_core_t;
+
+typedef struct {
+    irq_handler_t handler;
+    uint8_t order_priority;
+} shared_handler_t;
+
+typedef struct {
+    bool active;
+    uint64_t deadline_us;
+    alarm_callback_t callback;
+    void *user_data;
+    uint core;
+} sim_alarm_t;
+
+static sim_core_t cores[SIM_NUM_CORES];
+static ucontext_t loop_context;
+static int running_core = -1;
+static bool stop_requested = false;
+
+static uint64_t now_cycles = 0;
+static uint32_t sys_hz = 125000000u;
+
+// Cycles stay continuous when the firmware retunes clk_sys; each change
+// starts a segment that maps cycles to picoseconds at its own rate
+typedef struct {
+    uint64_t cycles;
+    uint64_t ps;
+    uint32_t hz;
+} rate_segment_t;
+
+static rate_segment_t segments[SIM_MAX_RATE_SEGMENTS] = { { 0, 0, 125000000u } };
+static uint segment_count = 1;
+
+// Other clocks as configured by the firmware (clock_configure())
+static uint32_t clock_hz[CLK_COUNT] = {
+    [clk_ref] = 12000000u,
+    [clk_sys] = 125000000u,
+    [clk_peri] = 125000000u,
+    [clk_usb] = 48000000u,
+    [clk_adc] = 48000000u,
+};
+
+static const sim_agent_t *agents[SIM_MAX_AGENTS];
+static uint agent_count = 0;
+
+static bool (*irq_sources[SIM_NUM_IRQS])(uint core);
+static shared_handler_t irq_handlers[SIM_NUM_IRQS][SIM_MAX_SHARED_HANDLERS];
+static uint irq_handler_count[SIM_NUM_IRQS];
+
+static sim_alarm_t alarms[SIM_MAX_ALARMS];
+
+// Virtual time
+
+uint64_t sim_now(void) {
+    return now_cycles;
+}
+
+uint32_t sim_sys_hz(void) {
+    return sys_hz;
+}
+
+uint64_t sim_cycles_to_ps(uint64_t cycles) {
+    uint i = segment_count - 1;
+    while (i > 0 && segments[i].cycles > cycles) i--;
+    const rate_segment_t *s = &segments[i];
+    return s->ps + (uint64_t)(((unsigned __int128)(cycles - s->cycles) * 1000000000000ull) / s->hz);
+}
+
+uint64_t sim_us_to_cycles(uint64_t us) {
+    return sim_ps_to_cycles(us * 1000000u);
+}
+
+uint64_t sim_ps_to_cycles(uint64_t ps) {
+    uint i = segment_count - 1;
+    while (i > 0 && segments[i].ps > ps) i--;
+    const rate_segment_t *s = &segments[i];
+    // Rounded up, so the cycle found is never before the time asked for
+    return s->cycles + (uint64_t)(((unsigned __int128)(ps - s->ps) * s->hz + 999999999999ull) / 1000000000000ull);
+}
+
+uint64_t sim_cycles_to_us(uint64_t cycles) {
+    return sim_cycles_to_ps(cycles) / 1000000u;
+}
+
+static void set_sys_hz(uint32_t hz) {
+    if (hz == sys_hz) return;
+    if (segment_count == SIM_MAX_RATE_SEGMENTS) {
+        fprintf(stderr, "sim: more than %u system clock changes\n", SIM_MAX_RATE_SEGMENTS);
+        exit(1);
+    }
+
+    // A core sleeping until a time keeps that time, not its cycle count
+    for (uint i = 0; i < SIM_NUM_CORES; i++) {
+        if (cores[i].state == CORE_WAITING && cores[i].deadline != SIM_NEVER && cores[i].deadline > now_cycles) {
+            uint64_t left = cores[i].deadline - now_cycles;
+            cores[i].deadline = now_cycles + (uint64_t)(((unsigned __int128)left * hz) / sys_hz);
+        }
+    }
+    sim_adc_clock_change();
+
+    uint64_t ps = sim_cycles_to_ps(now_cycles);
+    segments[segment_count++] = (rate_segment_t){ now_cycles, ps, hz };
+    sys_hz = hz;
+}
+
+static void poll_irqs(void);
+
+uint64_t time_us_64(void) {
+    if (running_core >= 0) {
+        sim_core_t *core = &cores[running_core];
+        if (++core->time_reads > SIM_SPIN_TIME_READS && !core->in_irq) {
+            sim_core_wait(now_cycles + SIM_SPIN_CYCLES, false);
+        }
+        poll_irqs();
+    }
+    return sim_cycles_to_us(now_cycles);
+}
+
+uint32_t time_us_32(void) {
+    return (uint32_t)time_us_64();
+}
+
+uint32_t clock_get_hz(enum clock_index clk_index) {
+    return clk_index < CLK_COUNT ? clock_hz[clk_index] : 0;
+}
+
+bool clock_configure(enum clock_index clk_index, uint32_t src, uint32_t auxsrc, uint32_t src_freq, uint32_t freq) {
+    (void)src;
+    (void)auxsrc;
+    if (clk_index >= CLK_COUNT || freq > src_freq) return false;
+    clock_hz[clk_index] = freq;
+    if (clk_index == clk_sys) set_sys_hz(freq);
+    return true;
+}
+
+void pll_init(PLL pll, uint ref_div, uint vco_freq, uint post_div1, uint post_div2) {
+    // The simulated system clock follows clk_sys, not the PLL
+    (void)pll;
+    (void)ref_div;
+    (void)vco_freq;
+    (void)post_div1;
+    (void)post_div2;
+}
+
+bool check_sys_clock_khz(uint32_t freq_khz, uint *vco_freq_out, uint *post_div1_out, uint *post_div2_out) {
+    // As the SDK searches: highest VCO first, within 750 to 1600 MHz
+    uint reference_khz = clock_hz[clk_ref] / 1000u;
+    for (uint fbdiv = 320; fbdiv >= 16; fbdiv--) {
+        uint vco_khz = fbdiv * reference_khz;
+        if (vco_khz < 750000u || vco_khz > 1600000u) continue;
+        for (uint post_div1 = 7; post_div1 >= 1; post_div1--) {
+            for (uint post_div2 = post_div1; post_div2 >= 1; post_div2--) {
+                if (vco_khz % (post_div1 * post_div2) == 0 && vco_khz / (post_div1 * post_div2) == freq_khz) {
+                    *vco_freq_out = vco_khz * 1000u;
+                    *post_div1_out = post_div1;
+                    *post_div2_out = post_div2;
+                    return true;
+                }
+            }
+        }
+    }
+    return false;
+}
+
+// Interrupts
+
+void sim_register_irq_source(uint irq, bool (*asserted)(uint core)) {
+    irq_sources[irq] = asserted;
+}
+
+static int pending_irq(uint core) {
+    for (uint irq = 0; irq < SIM_NUM_IRQS; irq++) {
+        if (cores[core].nvic_enabled[irq] && irq_sources[irq] && irq_sources[irq](core)) {
+            return (int)irq;
+        }
+    }
+    return -1;
+}
+
+static void service_irqs(uint core_num) {
+    sim_core_t *core = &cores[core_num];
+    uint deliveries = 0;
+
+    while (!core->irq_masked && !core->in_irq) {
+        int irq = pending_irq(core_num);
+        if (irq < 0) break;
+
+        if (irq_handler_count[irq] == 0) {
+            fprintf(stderr, "sim: core%u took IRQ %d with no handler installed\n", core_num, irq);
+            exit(1);
+        }
+        if (++deliveries > SIM_IRQ_STORM_LIMIT) {
+            fprintf(stderr, "sim: IRQ %d on core%u is never cleared by its handlers\n", irq, core_num);
+            exit(1);
+        }
+
+        core->in_irq = true;
+        for (uint i = 0; i < irq_handler_count[irq]; i++) {
+            irq_handlers[irq][i].handler();
+        }
+        core->in_irq = false;
+        core->event = true;
+    }
+}
+
+static void poll_irqs(void) {
+    if (running_core >= 0) {
+        service_irqs((uint)running_core);
+    }
+}
+
+uint32_t save_and_disable_interrupts(void) {
+    if (running_core < 0) return 0;
+    sim_core_t *core = &cores[running_core];
+    uint32_t status = core->irq_masked ? 1u : 0u;
+    core->irq_masked = true;
+    return status;
+}
+
+void restore_interrupts(uint32_t status) {
+    if (running_core < 0) return;
+    cores[running_core].irq_masked = status != 0;
+    poll_irqs();
+}
+
+void irq_set_exclusive_handler(uint num, irq_handler_t handler) {
+    irq_handlers[num][0].handler = handler;
+    irq_handlers[num][0].order_priority = PICO_SHARED_IRQ_HANDLER_DEFAULT_ORDER_PRIORITY;
+    irq_handler_count[num] = 1;
+}
+
+void irq_add_shared_handler(uint num, irq_handler_t handler, uint8_t order_priority) {
+    uint count = irq_handler_count[num];
+    if (count == SIM_MAX_SHARED_HANDLERS) {
+        fprintf(stderr, "sim: too many shared handlers on IRQ %u\n", num);
+        exit(1);
+    }
+
+    // Higher order priority runs first, as in the SDK
+    uint i = count;
+    while (i > 0 && irq_handlers[num][i - 1].order_priority < order_priority) {
+        irq_handlers[num][i] = irq_handlers[num][i - 1];
+        i--;
+    }
+    irq_handlers[num][i].handler = handler;
+    irq_handlers[num][i].order_priority = order_priority;
+    irq_handler_count[num] = count + 1;
+}
+
+void irq_remove_handler(uint num, irq_handler_t handler) {
+    uint count = irq_handler_count[num];
+    for (uint i = 0; i < count; i++) {
+        if (irq_handlers[num][i].handler == handler) {
+            memmove(&irq_handlers[num][i], &irq_handlers[num][i + 1], (count - i - 1) * sizeof(shared_handler_t));
+            irq_handler_count[num] = count - 1;
+            return;
+        }
+    }
+}
+
+void irq_set_enabled(uint num, bool enabled) {
+    cores[sim_core_current()].nvic_enabled[num] = enabled;
+    poll_irqs();
+}
+
+bool irq_is_enabled(uint num) {
+    return cores[sim_core_current()].nvic_enabled[num];
+}
+
+void irq_set_priority(uint num, uint8_t hardware_priority) {
+    (void)num;
+    (void)hardware_priority;
+}
+
+// Events
+
+void __sev(void) {
+    for (uint i = 0; i < SIM_NUM_CORES; i++) {
+        cores[i].event = true;
+    }
+}
+
+void __wfe(void) {
+    sim_core_wait(SIM_NEVER, true);
+}
+
+void __wfi(void) {
+    sim_core_wait(SIM_NEVER, true);
+}
+
+// Cores
+
+uint sim_core_current(void) {
+    return running_core >= 0 ? (uint)running_core : 0u;
+}
+
+uint get_core_num(void) {
+    return sim_core_current();
+}
+
+void sim_core_wait(uint64_t deadline, bool wake_on_event) {
+    if (running_core < 0) return;
+    uint core_num = (uint)running_core;
+    sim_core_t *core = &cores[core_num];
+
+    if (wake_on_event && core->event) {
+        core->event = false;
+        return;
+    }
+
+    core->state = CORE_WAITING;
+    core->deadline = deadline;
+    core->wake_on_event = wake_on_event;
+    running_core = -1;
+    swapcontext(&core->context, &loop_context);
+
+    // Resumed by the event loop
+    core->time_reads = 0;
+    service_irqs(core_num);
+    if (wake_on_event) {
+        core->event = false;
+    }
+}
+
+static bool core_runnable(uint core_num) {
+    sim_core_t *core = &cores[core_num];
+
+    switch (core->state) {
+        case CORE_READY:
+            return true;
+        case CORE_WAITING:
+            return now_cycles >= core->deadline ||
+                   (core->wake_on_event && core->event) ||
+                   (!core->irq_masked && pending_irq(core_num) >= 0);
+        default:
+            return false;
+    }
+}
+
+static void core_trampoline(void) {
+    uint core_num = (uint)running_core;
+    cores[core_num].entry();
+
+    // Returning from a core entry point parks the core for good
+    cores[core_num].state = CORE_DONE;
+    running_core = -1;
+    setcontext(&loop_context);
+}
+
+static void start_core(uint core_num, void (*entry)(void)) {
+    sim_core_t *core = &cores[core_num];
+
+    if (!core->stack) {
+        core->stack = malloc(SIM_CORE_STACK_SIZE);
+        if (!core->stack) {
+            fprintf(stderr, "sim: out of memory for core stacks\n");
+            exit(1);
+        }
+    }
+    getcontext(&core->context);
+    core->context.uc_stack.ss_sp = core->stack;
+    core->context.uc_stack.ss_size = SIM_CORE_STACK_SIZE;
+    core->context.uc_link = NULL;
+    makecontext(&core->context, core_trampoline, 0);
+
+    core->entry = entry;
+    core->state = CORE_READY;
+    core->event = false;
+    core->irq_masked = false;
+    core->in_irq = false;
+    core->time_reads = 0;
+}
+
+static void resume_core(uint core_num) {
+    sim_core_t *core = &cores[core_num];
+    core->state = CORE_READY;
+    running_core = (int)core_num;
+    swapcontext(&loop_context, &core->context);
+    running_core = -1;
+}
+
+void multicore_launch_core1(void (*entry)(void)) {
+    start_core(1, entry);
+}
+
+void sim_register_agent(const sim_agent_t *agent) {
+    if (agent_count == SIM_MAX_AGENTS) {
+        fprintf(stderr, "sim: too many agents\n");
+        exit(1);
+    }
+    agents[agent_count++] = agent;
+}
+
+void sim_stop(void) {
+    stop_requested = true;
+}
+
+static void run_due_agents(void) {
+    bool ran = true;
+    while (ran && !stop_requested) {
+        ran = false;
+        for (uint i = 0; i < agent_count; i++) {
+            if (agents[i]->next_event() <= now_cycles) {
+                agents[i]->run_event(now_cycles);
+                ran = true;
+            }
+        }
+    }
+}
+
+uint64_t sim_core_run(void (*core0_entry)(void), uint64_t until) {
+    uint next_core = 0;
+
+    start_core(0, core0_entry);
+    stop_requested = false;
+
+    while (!stop_requested) {
+        // Run cores round-robin until both wait
+        bool resumed = false;
+        for (uint i = 0; i < SIM_NUM_CORES; i++) {
+            uint core_num = (next_core + i) % SIM_NUM_CORES;
+            if (core_runnable(core_num)) {
+                resume_core(core_num);
+                next_core = (core_num + 1) % SIM_NUM_CORES;
+                resumed = true;
+                break;
+            }
+        }
+        if (resumed) continue;
+
+        // Advance to the next event
+        uint64_t next = SIM_NEVER;
+        bool any_core_alive = false;
+        for (uint i = 0; i < agent_count; i++) {
+            uint64_t t = agents[i]->next_event();
+            if (t < next) next = t;
+        }
+        for (uint i = 0; i < SIM_NUM_CORES; i++) {
+            if (cores[i].state == CORE_WAITING) {
+                any_core_alive = true;
+                if (cores[i].deadline < next) next = cores[i].deadline;
+            }
+        }
+
+        if (!any_core_alive) break;
+        // With nothing scheduled (SIM_NEVER) both cores sleep to the end
+        if (next > until) {
+            now_cycles = until;
+            break;
+        }
+        if (next > now_cycles) now_cycles = next;
+
+        run_due_agents();
+    }
+
+    return now_cycles;
+}
+
+// Sleeping and busy-waiting
+
+void sleep_until(absolute_time_t target) {
+    uint64_t deadline = sim_us_to_cycles(target);
+    while (now_cycles < deadline) {
+        sim_core_wait(deadline, false);
+    }
+}
+
+void sleep_us(uint64_t us) {
+    sleep_until(time_us_64() + us);
+}
+
+void sleep_ms(uint32_t ms) {
+    sleep_us(ms * 1000ull);
+}
+
+bool best_effort_wfe_or_timeout(absolute_time_t timeout_timestamp) {
+    if (sim_cycles_to_us(now_cycles) >= timeout_timestamp) return true;
+    sim_core_wait(sim_us_to_cycles(timeout_timestamp), true);
+    return sim_cycles_to_us(now_cycles) >= timeout_timestamp;
+}
+
+void tight_loop_contents(void) {
+    sim_core_wait(now_cycles + SIM_SPIN_CYCLES, false);
+}
+
+// Alarms (fired from TIMER_IRQ_3 on the core that added them)
+
+static uint64_t alarm_next_event(void) {
+    uint64_t next = SIM_NEVER;
+    for (uint i = 0; i < SIM_MAX_ALARMS; i++) {
+        if (alarms[i].active) {
+            uint64_t t = sim_us_to_cycles(alarms[i].deadline_us);
+            if (t < next) next = t;
+        }
+    }
+    return next;
+}
+
+static void alarm_run_event(uint64_t now) {
+    (void)now; // The interrupt line reflects due alarms directly
+}
+
+static bool alarm_irq_asserted(uint core) {
+    uint64_t now_us = sim_cycles_to_us(now_cycles);
+    for (uint i = 0; i < SIM_MAX_ALARMS; i++) {
+        if (alarms[i].active && alarms[i].core == core && alarms[i].deadline_us <= now_us) {
+            return true;
+        }
+    }
+    return false;
+}
+
+static void alarm_irq(void) {
+    uint core = sim_core_current();
+    uint64_t now_us = sim_cycles_to_us(now_cycles);
+
+    for (uint i = 0; i < SIM_MAX_ALARMS; i++) {
+        sim_alarm_t *alarm = &alarms[i];
+        if (!alarm->active || alarm->core != core || alarm->deadline_us > now_us) continue;
+
+        alarm->active = false;
+        int64_t again = alarm->callback((alarm_id_t)(i + 1), alarm->user_data);
+        if (again > 0) {
+            alarm->deadline_us += (uint64_t)again;
+            alarm->active = true;
+        } else if (again < 0) {
+            alarm->deadline_us = now_us + (uint64_t)(-again);
+            alarm->active = true;
+        }
+    }
+}
+
+static const sim_agent_t alarm_agent = {
+    .name = "alarm",
+    .next_event = alarm_next_event,
+    .run_event = alarm_run_event,
+};
+
+alarm_id_t add_alarm_in_us(uint64_t us, alarm_callback_t callback, void *user_data, bool fire_if_past) {
+    (void)fire_if_past;
+    static bool installed = false;
+    if (!installed) {
+        irq_add_shared_handler(TIMER_IRQ_3, alarm_irq, PICO_SHARED_IRQ_HANDLER_DEFAULT_ORDER_PRIORITY);
+        sim_register_irq_source(TIMER_IRQ_3, alarm_irq_asserted);
+        sim_register_agent(&alarm_agent);
+        installed = true;
+    }
+
+    for (uint i = 0; i < SIM_MAX_ALARMS; i++) {
+        if (!alarms[i].active) {
+            alarms[i] = (sim_alarm_t){
+                .active = true,
+                .deadline_us = sim_cycles_to_us(now_cycles) + us,
+                .callback = callback,
+                .user_data = user_data,
+                .core = sim_core_current(),
+            };
+            cores[sim_core_current()].nvic_enabled[TIMER_IRQ_3] = true;
+            return (alarm_id_t)(i + 1);
+        }
+    }
+    return -1;
+}
+
+alarm_id_t add_alarm_in_ms(uint32_t ms, alarm_callback_t callback, void *user_data, bool fire_if_past) {
+    return add_alarm_in_us(ms * 1000ull, callback, user_data, fire_if_past);
+}
+
+bool cancel_alarm(alarm_id_t alarm_id) {
+    if (alarm_id < 1 || alarm_id > SIM_MAX_ALARMS || !alarms[alarm_id - 1].active) return false;
+    alarms[alarm_id - 1].active = false;
+    return true;
+}
@@ -0,0 +1,292 @@
+/**
+ * Host Simulator: DMA
+ *
+ * Channels paced by a peripheral are brought up to date whenever the
+ * firmware touches the DMA, which is when it is about to look at the
+ * transferred data. Only the paths the firmware uses are modelled: the
+ * free-running ADC into memory, memory to a UART transmitter at one byte
+ * per character time, and unpaced memory copies. A run paced by a UART is
+ * also an event, so its completion interrupt is raised on time.
+ */
+
+#include "sim.h"
+#include "hardware/dma.h"
+#include "hardware/adc.h"
+#include "hardware/uart.h"
+#include "hardware/irq.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+typedef struct {
+    uint32_t ctrl;
+    uintptr_t read_addr;
+    uintptr_t write_addr;
+    uint32_t trans_count;       // Reload value for the next trigger
+    uint32_t remaining;         // Transfers left in the current run
+    bool busy;
+    uint64_t paced_from;        // Peripheral requests already served
+    uint64_t started;           // Cycle of the trigger
+} sim_dma_channel_t;
+
+static sim_dma_channel_t channels[NUM_DMA_CHANNELS];
+static uint32_t claimed = 0;
+static uint32_t irq0_enabled = 0;  // INTE0
+static uint32_t irq_raw = 0;       // Channels that completed a run
+
+static uint ctrl_field(uint32_t ctrl, uint32_t bits, uint lsb) {
+    return (ctrl & bits) >> lsb;
+}
+
+static uint32_t transfer_size(const sim_dma_channel_t *ch) {
+    return 1u << ctrl_field(ch->ctrl, DMA_CH0_CTRL_TRIG_DATA_SIZE_BITS, DMA_CH0_CTRL_TRIG_DATA_SIZE_LSB);
+}
+
+static uint treq(const sim_dma_channel_t *ch) {
+    return ctrl_field(ch->ctrl, DMA_CH0_CTRL_TRIG_TREQ_SEL_BITS, DMA_CH0_CTRL_TRIG_TREQ_SEL_LSB);
+}
+
+// Step an address by a number of transfers, wrapping inside the ring if it
+// applies to this address
+static uintptr_t advance(const sim_dma_channel_t *ch, uintptr_t addr, bool write, uint64_t transfers) {
+    uint32_t incr_bit = write ? DMA_CH0_CTRL_TRIG_INCR_WRITE_BITS : DMA_CH0_CTRL_TRIG_INCR_READ_BITS;
+    if (!(ch->ctrl & incr_bit)) return addr;
+
+    uintptr_t step = (uintptr_t)(transfers * transfer_size(ch));
+    uint ring_bits = ctrl_field(ch->ctrl, DMA_CH0_CTRL_TRIG_RING_SIZE_BITS, DMA_CH0_CTRL_TRIG_RING_SIZE_LSB);
+    bool ring_write = (ch->ctrl & DMA_CH0_CTRL_TRIG_RING_SEL_BITS) != 0;
+    if (ring_bits == 0 || ring_write != write) return addr + step;
+
+    uintptr_t mask = ((uintptr_t)1 << ring_bits) - 1;
+    return (addr & ~mask) | ((addr + step) & mask);
+}
+
+static void store(uintptr_t addr, uint32_t size, uint32_t value) {
+    switch (size) {
+        case 1: *(volatile uint8_t *)addr = (uint8_t)value; break;
+        case 2: *(volatile uint16_t *)addr = (uint16_t)value; break;
+        default: *(volatile uint32_t *)addr = value; break;
+    }
+}
+
+static uint32_t load(uintptr_t addr, uint32_t size) {
+    switch (size) {
+        case 1: return *(volatile uint8_t *)addr;
+        case 2: return *(volatile uint16_t *)addr;
+        default: return *(volatile uint32_t *)addr;
+    }
+}
+
+static void finish_run(sim_dma_channel_t *ch) {
+    ch->busy = false;
+}
+
+static void complete_run(sim_dma_channel_t *ch) {
+    finish_run(ch);
+    irq_raw |= 1u << (uint)(ch - channels);
+}
+
+static bool uart_tx_request(uint dreq, uint *index) {
+    if (dreq != DREQ_UART0_TX && dreq != DREQ_UART1_TX) return false;
+    *index = dreq == DREQ_UART1_TX;
+    return true;
+}
+
+// Cycle at which a UART-paced run has sent its last byte
+static uint64_t uart_run_end(const sim_dma_channel_t *ch, uint index) {
+    return ch->started + (uint64_t)ch->trans_count * sim_uart_char_cycles(index);
+}
+
+static void sync_channel(sim_dma_channel_t *ch) {
+    if (!ch->busy) return;
+    uint uart_index;
+
+    if (treq(ch) == DREQ_ADC && ch->read_addr == (uintptr_t)&adc_hw->fifo) {
+        // One transfer per conversion since the last look
+        uint64_t pending = sim_adc_conversions() - ch->paced_from;
+        if (pending > ch->remaining) pending = ch->remaining;
+        ch->paced_from += pending;
+        ch->remaining -= (uint32_t)pending;
+
+        // Of a long backlog only the last lap of a write ring is visible
+        uint ring_bits = ctrl_field(ch->ctrl, DMA_CH0_CTRL_TRIG_RING_SIZE_BITS, DMA_CH0_CTRL_TRIG_RING_SIZE_LSB);
+        uint64_t lap = ring_bits && (ch->ctrl & DMA_CH0_CTRL_TRIG_RING_SEL_BITS)
+                       ? ((uint64_t)1 << ring_bits) / transfer_size(ch) : pending;
+        if (pending > lap) {
+            ch->write_addr = advance(ch, ch->write_addr, true, pending - lap);
+            sim_adc_skip(pending - lap);
+            pending = lap;
+        }
+        for (uint64_t i = 0; i < pending; i++) {
+            store(ch->write_addr, transfer_size(ch), sim_adc_take());
+            ch->write_addr = advance(ch, ch->write_addr, true, 1);
+        }
+        if (ch->remaining == 0) complete_run(ch);
+    } else if (uart_tx_request(treq(ch), &uart_index)) {
+        if (ch->write_addr != (uintptr_t)&uart_get_hw(uart_index == 0 ? uart0 : uart1)->dr) {
+            fprintf(stderr, "sim: DMA to UART%u must write its data register\n", uart_index);
+            exit(2);
+        }
+        // One byte leaves per character time
+        uint64_t elapsed = (sim_now() - ch->started) / sim_uart_char_cycles(uart_index);
+        uint32_t sent = ch->trans_count - ch->remaining;
+        while (ch->remaining > 0 && sent < elapsed) {
+            sim_uart_transmit(uart_index, (uint8_t)load(ch->read_addr, transfer_size(ch)));
+            ch->read_addr = advance(ch, ch->read_addr, false, 1);
+            ch->remaining--;
+            sent++;
+        }
+        if (ch->remaining == 0) complete_run(ch);
+    } else if (treq(ch) == DREQ_FORCE) {
+        // Unpaced: completes at once
+        while (ch->remaining > 0) {
+            store(ch->write_addr, transfer_size(ch), load(ch->read_addr, transfer_size(ch)));
+            ch->read_addr = advance(ch, ch->read_addr, false, 1);
+            ch->write_addr = advance(ch, ch->write_addr, true, 1);
+            ch->remaining--;
+        }
+        complete_run(ch);
+    } else {
+        fprintf(stderr, "sim: DMA request %u from %p is not modelled\n", treq(ch), (void *)ch->read_addr);
+        exit(2);
+    }
+}
+
+static void sync_all(void) {
+    for (uint i = 0; i < NUM_DMA_CHANNELS; i++) {
+        sync_channel(&channels[i]);
+    }
+}
+
+static void trigger(uint channel) {
+    sim_dma_channel_t *ch = &channels[channel];
+    if (ch->busy || !(ch->ctrl & DMA_CH0_CTRL_TRIG_EN_BITS)) return;
+    ch->remaining = ch->trans_count;
+    ch->busy = ch->remaining > 0;
+    ch->paced_from = sim_adc_conversions();
+    ch->started = sim_now();
+    sync_channel(ch);
+}
+
+static uint64_t dma_next_event(void) {
+    uint64_t next = SIM_NEVER;
+    for (uint i = 0; i < NUM_DMA_CHANNELS; i++) {
+        uint index;
+        if (channels[i].busy && uart_tx_request(treq(&channels[i]), &index)) {
+            uint64_t end = uart_run_end(&channels[i], index);
+            if (end < next) next = end;
+        }
+    }
+    return next;
+}
+
+static void dma_run_event(uint64_t now) {
+    (void)now;
+    sync_all();
+}
+
+static bool dma_irq0_asserted(uint core) {
+    (void)core;
+    return (irq_raw & irq0_enabled) != 0;
+}
+
+static const sim_agent_t dma_agent = {
+    .name = "dma",
+    .next_event = dma_next_event,
+    .run_event = dma_run_event,
+};
+
+void sim_dma_init(void) {
+    sim_register_agent(&dma_agent);
+    sim_register_irq_source(DMA_IRQ_0, dma_irq0_asserted);
+}
+
+int dma_claim_unused_channel(bool required) {
+    for (uint i = 0; i < NUM_DMA_CHANNELS; i++) {
+        if (!(claimed & (1u << i))) {
+            claimed |= 1u << i;
+            return (int)i;
+        }
+    }
+    if (required) {
+        fprintf(stderr, "sim: no free DMA channel\n");
+        exit(2);
+    }
+    return -1;
+}
+
+void dma_channel_unclaim(uint channel) {
+    claimed &= ~(1u << channel);
+}
+
+dma_channel_config dma_channel_get_default_config(uint channel) {
+    dma_channel_config c = { 0 };
+    channel_config_set_read_increment(&c, true);
+    channel_config_set_write_increment(&c, false);
+    channel_config_set_dreq(&c, DREQ_FORCE);
+    channel_config_set_chain_to(&c, channel);
+    channel_config_set_transfer_data_size(&c, DMA_SIZE_32);
+    channel_config_set_enable(&c, true);
+    return c;
+}
+
+void dma_channel_configure(uint channel, const dma_channel_config *config, volatile void *write_addr,
+                           const volatile void *read_addr, uint transfer_count, bool trigger_now) {
+    sync_all();
+    sim_dma_channel_t *ch = &channels[channel];
+    ch->ctrl = config->ctrl;
+    ch->write_addr = (uintptr_t)write_addr;
+    ch->read_addr = (uintptr_t)read_addr;
+    ch->trans_count = transfer_count;
+    if (trigger_now) trigger(channel);
+}
+
+void dma_channel_set_read_addr(uint channel, const volatile void *read_addr, bool trigger_now) {
+    sync_all();
+    channels[channel].read_addr = (uintptr_t)read_addr;
+    if (trigger_now) trigger(channel);
+}
+
+void dma_channel_set_write_addr(uint channel, volatile void *write_addr, bool trigger_now) {
+    sync_all();
+    channels[channel].write_addr = (uintptr_t)write_addr;
+    if (trigger_now) trigger(channel);
+}
+
+void dma_channel_set_trans_count(uint channel, uint32_t trans_count, bool trigger_now) {
+    sync_all();
+    channels[channel].trans_count = trans_count;
+    if (trigger_now) trigger(channel);
+}
+
+void dma_channel_start(uint channel) {
+    sync_all();
+    trigger(channel);
+}
+
+void dma_channel_abort(uint channel) {
+    sync_all();
+    finish_run(&channels[channel]);
+}
+
+bool dma_channel_is_busy(uint channel) {
+    sync_all();
+    return channels[channel].busy;
+}
+
+void dma_channel_set_irq0_enabled(uint channel, bool enabled) {
+    if (enabled) {
+        irq0_enabled |= 1u << channel;
+    } else {
+        irq0_enabled &= ~(1u << channel);
+    }
+}
+
+bool dma_channel_get_irq0_status(uint channel) {
+    sync_all();
+    return (irq_raw & irq0_enabled & (1u << channel)) != 0;
+}
+
+void dma_channel_acknowledge_irq0(uint channel) {
+    irq_raw &= ~(1u << channel);
+}
@@ -0,0 +1,272 @@
+/**
+ * Host Simulator: GPIO pads and GPIO interrupts
+ */
+
+#include "sim.h"
+#include "pico/stdlib.h"
+#include "hardware/gpio.h"
+#include "hardware/irq.h"
+#include "hardware/adc.h"
+#include <stdio.h>
+
+#define SIM_MAX_EDGE_HOOKS 4
+
+#define EDGE_EVENTS (GPIO_IRQ_EDGE_FALL | GPIO_IRQ_EDGE_RISE)
+
+typedef struct {
+    enum gpio_function function;
+    bool sio_out;
+    bool sio_oe;
+    bool pull_up;
+    bool pull_down;
+    int external;           // -1 when not driven from outside
+    bool level;             // Last level seen, for edge detection
+    bool traced;
+    uint32_t intr;          // Latched edge events
+    uint32_t inte[SIM_NUM_CORES];
+} sim_pad_t;
+
+static sim_pad_t pads[SIM_NUM_GPIOS];
+static sim_edge_hook_t edge_hooks[SIM_MAX_EDGE_HOOKS];
+static uint edge_hook_count = 0;
+
+static bool pad_input_level(const sim_pad_t *pad) {
+    if (pad->external >= 0) return pad->external != 0;
+    if (pad->pull_up) return true;
+    return false;
+}
+
+static bool compute_level(uint gpio) {
+    const sim_pad_t *pad = &pads[gpio];
+    bool level;
+
+    switch (pad->function) {
+        case GPIO_FUNC_SIO:
+            if (pad->sio_oe) return pad->sio_out;
+            break;
+        case GPIO_FUNC_PWM:
+            if (sim_pwm_pad_output(gpio, &level)) return level;
+            break;
+        case GPIO_FUNC_PIO0:
+        case GPIO_FUNC_PIO1:
+            if (sim_pio_pad_output(pad->function == GPIO_FUNC_PIO0 ? 0 : 1, gpio, &level)) return level;
+            break;
+        case GPIO_FUNC_UART:
+            // TX pins idle high; characters are not serialized onto the pad
+            if ((gpio & 3u) == 0) return true;
+            break;
+        default:
+            break;
+    }
+    return pad_input_level(pad);
+}
+
+bool sim_gpio_level(uint gpio) {
+    return gpio < SIM_NUM_GPIOS && compute_level(gpio);
+}
+
+void sim_gpio_refresh(uint gpio) {
+    sim_pad_t *pad = &pads[gpio];
+    bool level = compute_level(gpio);
+
+    if (level != pad->level) {
+        pad->level = level;
+        pad->intr |= level ? GPIO_IRQ_EDGE_RISE : GPIO_IRQ_EDGE_FALL;
+        sim_pwm_gpio_edge(gpio, level);
+        if (pad->traced) {
+            for (uint i = 0; i < edge_hook_count; i++) {
+                edge_hooks[i](gpio, level, sim_now());
+            }
+        }
+    }
+
+    // Waiters re-check the pin themselves, so a stale level only costs a retry
+    sim_pio_gpio_changed(gpio);
+}
+
+void sim_gpio_refresh_mask(uint32_t mask) {
+    for (uint gpio = 0; gpio < SIM_NUM_GPIOS; gpio++) {
+        if (mask & (1u << gpio)) sim_gpio_refresh(gpio);
+    }
+}
+
+static void sync_level(uint gpio) {
+    // Adopt the current level without reporting an edge (used when a pad
+    // starts being watched, as its last level may be stale)
+    pads[gpio].level = compute_level(gpio);
+}
+
+void sim_gpio_drive(uint gpio, int level) {
+    pads[gpio].external = level;
+    sim_gpio_refresh(gpio);
+}
+
+void sim_gpio_watch(uint gpio, bool watch) {
+    if (watch && !pads[gpio].traced) sync_level(gpio);
+    pads[gpio].traced = watch;
+}
+
+bool sim_gpio_watched(uint gpio) {
+    const sim_pad_t *pad = &pads[gpio];
+    if (pad->traced) return true;
+    for (uint core = 0; core < SIM_NUM_CORES; core++) {
+        if (pad->inte[core]) return true;
+    }
+    return (sim_pio_wait_mask() >> gpio) & 1u;
+}
+
+void sim_gpio_add_edge_hook(sim_edge_hook_t hook) {
+    if (edge_hook_count < SIM_MAX_EDGE_HOOKS) {
+        edge_hooks[edge_hook_count++] = hook;
+    }
+}
+
+static uint32_t pad_events(uint gpio) {
+    const sim_pad_t *pad = &pads[gpio];
+    bool level = compute_level(gpio);
+    return pad->intr | (level ? GPIO_IRQ_LEVEL_HIGH : GPIO_IRQ_LEVEL_LOW);
+}
+
+static bool gpio_irq_asserted(uint core) {
+    for (uint gpio = 0; gpio < SIM_NUM_GPIOS; gpio++) {
+        if (pads[gpio].inte[core] && (pad_events(gpio) & pads[gpio].inte[core])) return true;
+    }
+    return false;
+}
+
+void sim_gpio_init(void) {
+    for (uint gpio = 0; gpio < SIM_NUM_GPIOS; gpio++) {
+        pads[gpio] = (sim_pad_t){
+            .function = GPIO_FUNC_NULL,
+            .pull_down = true,
+            .external = -1,
+        };
+    }
+    sim_register_irq_source(IO_IRQ_BANK0, gpio_irq_asserted);
+}
+
+// SDK GPIO API
+
+void gpio_init(uint gpio) {
+    pads[gpio].sio_oe = false;
+    pads[gpio].sio_out = false;
+    pads[gpio].function = GPIO_FUNC_SIO;
+    sim_gpio_refresh(gpio);
+}
+
+void gpio_set_function(uint gpio, enum gpio_function fn) {
+    pads[gpio].function = fn;
+    sim_gpio_refresh(gpio);
+}
+
+enum gpio_function gpio_get_function(uint gpio) {
+    return pads[gpio].function;
+}
+
+void gpio_set_dir(uint gpio, bool out) {
+    pads[gpio].sio_oe = out;
+    sim_gpio_refresh(gpio);
+}
+
+bool gpio_get_dir(uint gpio) {
+    return pads[gpio].sio_oe;
+}
+
+void gpio_put(uint gpio, bool value) {
+    pads[gpio].sio_out = value;
+    sim_gpio_refresh(gpio);
+}
+
+bool gpio_get(uint gpio) {
+    return compute_level(gpio);
+}
+
+bool gpio_get_out_level(uint gpio) {
+    return pads[gpio].sio_out;
+}
+
+void gpio_set_pulls(uint gpio, bool up, bool down) {
+    pads[gpio].pull_up = up;
+    pads[gpio].pull_down = down;
+    sim_gpio_refresh(gpio);
+}
+
+void gpio_pull_up(uint gpio) {
+    gpio_set_pulls(gpio, true, false);
+}
+
+void gpio_pull_down(uint gpio) {
+    gpio_set_pulls(gpio, false, true);
+}
+
+void gpio_disable_pulls(uint gpio) {
+    gpio_set_pulls(gpio, false, false);
+}
+
+void gpio_set_input_hysteresis_enabled(uint gpio, bool enabled) {
+    (void)gpio;
+    (void)enabled;
+}
+
+void gpio_acknowledge_irq(uint gpio, uint32_t event_mask) {
+    pads[gpio].intr &= ~(event_mask & EDGE_EVENTS);
+}
+
+void gpio_set_irq_enabled(uint gpio, uint32_t event_mask, bool enabled) {
+    sim_pad_t *pad = &pads[gpio];
+    uint core = sim_core_current();
+
+    // Stale edges are cleared first, as in the SDK
+    if (!pad->inte[core] && !pad->traced) sync_level(gpio);
+    gpio_acknowledge_irq(gpio, event_mask);
+    if (enabled) {
+        pad->inte[core] |= event_mask;
+    } else {
+        pad->inte[core] &= ~event_mask;
+    }
+}
+
+uint32_t gpio_get_irq_event_mask(uint gpio) {
+    return pad_events(gpio) & pads[gpio].inte[sim_core_current()];
+}
+
+static gpio_irq_callback_t gpio_callbacks[SIM_NUM_CORES];
+
+static void gpio_default_irq_handler(void) {
+    uint core = sim_core_current();
+    for (uint gpio = 0; gpio < SIM_NUM_GPIOS; gpio++) {
+        uint32_t events = gpio_get_irq_event_mask(gpio);
+        if (events) {
+            gpio_acknowledge_irq(gpio, events);
+            if (gpio_callbacks[core]) gpio_callbacks[core](gpio, events);
+        }
+    }
+}
+
+void gpio_set_irq_callback(gpio_irq_callback_t callback) {
+    static bool installed = false;
+    if (!installed) {
+        irq_add_shared_handler(IO_IRQ_BANK0, gpio_default_irq_handler, 0);
+        installed = true;
+    }
+    gpio_callbacks[sim_core_current()] = callback;
+}
+
+void gpio_set_irq_enabled_with_callback(uint gpio, uint32_t event_mask, bool enabled, gpio_irq_callback_t callback) {
+    gpio_set_irq_enabled(gpio, event_mask, enabled);
+    gpio_set_irq_callback(callback);
+    if (enabled) irq_set_enabled(IO_IRQ_BANK0, true);
+}
+
+void gpio_add_raw_irq_handler_masked(uint32_t gpio_mask, void (*handler)(void)) {
+    (void)gpio_mask;
+    irq_add_shared_handler(IO_IRQ_BANK0, handler, PICO_SHARED_IRQ_HANDLER_DEFAULT_ORDER_PRIORITY);
+}
+
+// ADC inputs
+
+void adc_gpio_init(uint gpio) {
+    pads[gpio].function = GPIO_FUNC_NULL;
+    pads[gpio].pull_up = false;
+    pads[gpio].pull_down = false;
+}
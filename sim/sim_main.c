@@ -0,0 +1,501 @@
+/**
+ * Host Simulator: entry point and stimulus scripts
+ *
+ * Usage: multimode_clock_sim [--until MS] [--uart0] [--uart1] [--uart0-out FILE] [--vcd FILE] [SCRIPT]
+ *
+ * A script is a list of "<time_ms> <action> [args]" lines ('#' starts a
+ * comment), applied at the given virtual time:
+ *
+ *   press <button>       Hold a button down (single_step, low_freq, high_freq,
+ *   release <button>     reset, power, or a GPIO number)
+ *   drive <gpio> <0|1|z> Drive a pad from outside, or release it
+ *   adc <0-4095> [noise] Set the potentiometer reading, with optional Gaussian
+ *                        noise (standard deviation in ADC counts)
+ *   uart <text>          Type a line on UART0 (a newline is appended)
+ *   uart1 <text>         Type a line on UART1
+ *   usb <text>           Type a line on USB CDC
+ *   bytes <hex>          Send raw bytes on UART0 (e.g. a binary control frame)
+ *   signal <gpio> <Hz> [duty%]  Drive a square wave into a pad (fractional
+ *                        hertz allowed, 50% duty by default)
+ *   signal <gpio> off    Stop the wave and release the pad
+ *   watch <gpio>         Start counting edges on a pad
+ *   edges <gpio>         Report edges and frequency since the watch
+ *   pulses <gpio>        Report the shortest HIGH and LOW since the watch
+ *   pair <gpio> <gpio>   Start timing two pads that must never be HIGH together
+ *   gaps                 Report the shortest time from each pad of the pair
+ *                        falling to the other rising, and any overlap
+ *   level <gpio>         Report a pad level
+ *   quit                 End the simulation
+ */
+
+#include "sim.h"
+#include "config.h"
+#include <ctype.h>
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+#include <time.h>
+
+#define SIM_MAX_SCRIPT_LINES 1024
+#define SIM_SCRIPT_LINE_LENGTH 256
+#define SIM_DEFAULT_UNTIL_MS 60000u
+#define SIM_MAX_SIGNALS 4
+
+int firmware_main(void);
+
+typedef struct {
+    uint64_t at_us;                     // Time at which to apply the line
+    char text[SIM_SCRIPT_LINE_LENGTH];  // Action and arguments
+    uint line_number;
+} script_line_t;
+
+typedef struct {
+    uint64_t rising;
+    uint64_t falling;
+    uint64_t first_rise;
+    uint64_t last_rise;
+    uint64_t last_edge_ps;
+    uint64_t shortest_ps[2];    // Shortest complete LOW and HIGH, 0 for none yet
+} edge_counter_t;
+
+typedef struct {
+    bool active;
+    uint gpio;
+    double start_ps;            // Rising edge of period 0
+    double period_ps;
+    double high_ps;
+    uint64_t period;            // Period of the next edge
+    bool next_level;            // Level the next edge drives
+} signal_t;
+
+// Two pads that must never be HIGH together (non-overlapping clock phases)
+typedef struct {
+    bool active;
+    uint gpio[2];
+    bool high[2];
+    bool fell[2];               // Fallen since the pair was started
+    uint64_t fell_ps[2];        // Last falling edge
+    uint64_t shortest_gap_ps[2];    // Shortest from gpio[i] falling to the other rising, 0 for none yet
+    uint64_t gaps;
+    uint64_t overlap_ps;        // Total time both were HIGH
+    uint64_t both_since_ps;
+} pair_t;
+
+static script_line_t script[SIM_MAX_SCRIPT_LINES];
+static signal_t signals[SIM_MAX_SIGNALS];
+static uint script_length = 0;
+static uint script_next = 0;
+static edge_counter_t edge_counters[SIM_NUM_GPIOS];
+static pair_t pair;
+
+static void report(const char *fmt, ...) __attribute__((format(printf, 1, 2)));
+
+static void report(const char *fmt, ...) {
+    va_list args;
+    fprintf(sim_console, "[sim %10.3f ms] ", (double)sim_cycles_to_us(sim_now()) / 1000.0);
+    va_start(args, fmt);
+    vfprintf(sim_console, fmt, args);
+    va_end(args);
+    fputc('\n', sim_console);
+}
+
+static void core0_entry(void) {
+    firmware_main();
+}
+
+// Edge counting
+
+static void time_pair(uint gpio, bool level, uint64_t ps) {
+    for (uint i = 0; i < 2; i++) {
+        if (!pair.active || pair.gpio[i] != gpio) continue;
+        uint other = 1 - i;
+        if (level && pair.high[other]) {
+            pair.both_since_ps = ps;
+        } else if (level && pair.fell[other]) {
+            uint64_t *shortest = &pair.shortest_gap_ps[other];
+            if (*shortest == 0 || ps - pair.fell_ps[other] < *shortest) {
+                *shortest = ps - pair.fell_ps[other];
+            }
+            pair.gaps++;
+        } else if (!level) {
+            if (pair.high[other]) pair.overlap_ps += ps - pair.both_since_ps;
+            pair.fell[i] = true;
+            pair.fell_ps[i] = ps;
+        }
+        pair.high[i] = level;
+    }
+}
+
+static void count_edge(uint gpio, bool level, uint64_t now) {
+    edge_counter_t *counter = &edge_counters[gpio];
+    uint64_t ps = sim_cycles_to_ps(now);
+
+    // The level before this edge held since the previous one; the half in
+    // progress at the watch is not a whole one
+    if (counter->rising + counter->falling > 0) {
+        uint64_t *shortest = &counter->shortest_ps[!level];
+        if (*shortest == 0 || ps - counter->last_edge_ps < *shortest) {
+            *shortest = ps - counter->last_edge_ps;
+        }
+    }
+    counter->last_edge_ps = ps;
+    time_pair(gpio, level, ps);
+
+    if (level) {
+        if (counter->rising == 0) counter->first_rise = now;
+        counter->last_rise = now;
+        counter->rising++;
+    } else {
+        counter->falling++;
+    }
+}
+
+static void report_edges(uint gpio) {
+    const edge_counter_t *counter = &edge_counters[gpio];
+    if (counter->rising >= 2) {
+        double span = (double)(sim_cycles_to_ps(counter->last_rise) - sim_cycles_to_ps(counter->first_rise)) / 1e12;
+        report("gpio %u: %llu rising, %llu falling, %.3f Hz", gpio,
+               (unsigned long long)counter->rising, (unsigned long long)counter->falling,
+               (double)(counter->rising - 1) / span);
+    } else {
+        report("gpio %u: %llu rising, %llu falling", gpio,
+               (unsigned long long)counter->rising, (unsigned long long)counter->falling);
+    }
+}
+
+static void report_pulses(uint gpio) {
+    const edge_counter_t *counter = &edge_counters[gpio];
+    report("gpio %u: shortest HIGH %.3f us, shortest LOW %.3f us", gpio,
+           (double)counter->shortest_ps[1] / 1e6, (double)counter->shortest_ps[0] / 1e6);
+}
+
+static void report_gaps(void) {
+    report("gpio %u/%u: %llu gaps, shortest %u to %u %.3f ns, %u to %u %.3f ns, overlap %.3f ns",
+           pair.gpio[0], pair.gpio[1], (unsigned long long)pair.gaps,
+           pair.gpio[0], pair.gpio[1], (double)pair.shortest_gap_ps[0] / 1e3,
+           pair.gpio[1], pair.gpio[0], (double)pair.shortest_gap_ps[1] / 1e3, (double)pair.overlap_ps / 1e3);
+}
+
+// Signal generators, timed in picoseconds so they keep their own frequency
+// whatever the system clock does
+
+static uint64_t signal_edge_cycle(const signal_t *g) {
+    double ps = g->start_ps + (double)g->period * g->period_ps + (g->next_level ? 0.0 : g->high_ps);
+    return sim_ps_to_cycles((uint64_t)(ps + 0.5));
+}
+
+static void signal_start(uint gpio, double hz, double duty) {
+    signal_t *g = NULL;
+    for (uint i = 0; i < SIM_MAX_SIGNALS && !g; i++) {
+        if (signals[i].active && signals[i].gpio == gpio) g = &signals[i];
+    }
+    for (uint i = 0; i < SIM_MAX_SIGNALS && !g; i++) {
+        if (!signals[i].active) g = &signals[i];
+    }
+    if (!g) {
+        fprintf(stderr, "sim: more than %u signals\n", SIM_MAX_SIGNALS);
+        exit(2);
+    }
+
+    *g = (signal_t){
+        .active = true,
+        .gpio = gpio,
+        .start_ps = (double)sim_cycles_to_ps(sim_now()),
+        .period_ps = 1e12 / hz,
+        .high_ps = 1e12 / hz * duty / 100.0,
+        .next_level = true,
+    };
+}
+
+static void signal_stop(uint gpio) {
+    for (uint i = 0; i < SIM_MAX_SIGNALS; i++) {
+        if (signals[i].active && signals[i].gpio == gpio) {
+            signals[i].active = false;
+            sim_gpio_drive(gpio, -1);
+        }
+    }
+}
+
+static uint64_t signal_next_event(void) {
+    uint64_t next = SIM_NEVER;
+    for (uint i = 0; i < SIM_MAX_SIGNALS; i++) {
+        if (!signals[i].active) continue;
+        uint64_t t = signal_edge_cycle(&signals[i]);
+        if (t < next) next = t;
+    }
+    return next;
+}
+
+static void signal_run_event(uint64_t now) {
+    for (uint i = 0; i < SIM_MAX_SIGNALS; i++) {
+        signal_t *g = &signals[i];
+        while (g->active && signal_edge_cycle(g) <= now) {
+            sim_gpio_drive(g->gpio, g->next_level);
+            if (!g->next_level) g->period++;
+            g->next_level = !g->next_level;
+        }
+    }
+}
+
+static const sim_agent_t signal_agent = {
+    .name = "signal",
+    .next_event = signal_next_event,
+    .run_event = signal_run_event,
+};
+
+// Script
+
+static int parse_pin(const char *name) {
+    static const struct { const char *name; int gpio; } buttons[] = {
+        { "single_step", BUTTON_SINGLE_STEP },
+        { "low_freq", BUTTON_LOW_FREQ },
+        { "high_freq", BUTTON_HIGH_FREQ },
+        { "reset", BUTTON_RESET },
+        { "power", BUTTON_POWER },
+        { "clock", CLOCK_OUTPUT },
+        { "reset_out", RESET_OUTPUT },
+        { "power_out", POWER_OUTPUT },
+        { "fault", SWEEP_FAULT_INPUT },
+        { "wait", WAIT_INPUT },
+        { "counter", FREQ_COUNTER_INPUT },
+        { "reference", REFERENCE_INPUT },
+        { "phi1", PHI1_OUTPUT },
+        { "phi2", PHI2_OUTPUT },
+        { "phi0_n", PHI0_N_OUTPUT },
+    };
+
+    if (!name) return -1;
+    for (uint i = 0; i < sizeof(buttons) / sizeof(buttons[0]); i++) {
+        if (strcasecmp(name, buttons[i].name) == 0) return buttons[i].gpio;
+    }
+
+    char *end;
+    long gpio = strtol(name, &end, 10);
+    if (*end || gpio < 0 || gpio >= SIM_NUM_GPIOS) return -1;
+    return (int)gpio;
+}
+
+static void run_line(const script_line_t *line) {
+    char text[SIM_SCRIPT_LINE_LENGTH];
+    strcpy(text, line->text);
+
+    char *rest = NULL;
+    char *action = strtok_r(text, " \t", &rest);
+    const char *arg = rest ? rest + strspn(rest, " \t") : "";
+    char *arg_copy = strdup(arg);
+    char *arg_rest = NULL;
+    int pin = parse_pin(strtok_r(arg_copy, " \t", &arg_rest));
+    char *arg2 = strtok_r(NULL, " \t", &arg_rest);
+
+    if (strcmp(action, "press") == 0 && pin >= 0) {
+        sim_gpio_drive((uint)pin, 0);
+    } else if (strcmp(action, "release") == 0 && pin >= 0) {
+        sim_gpio_drive((uint)pin, -1);
+    } else if (strcmp(action, "drive") == 0 && pin >= 0 && arg2) {
+        sim_gpio_drive((uint)pin, arg2[0] == 'z' ? -1 : atoi(arg2) != 0);
+    } else if (strcmp(action, "adc") == 0) {
+        sim_adc_set(0, (uint16_t)atoi(arg));
+        sim_adc_set_noise(0, arg2 ? (float)atof(arg2) : 0.0f);
+    } else if (strcmp(action, "uart") == 0 || strcmp(action, "uart1") == 0) {
+        char data[SIM_SCRIPT_LINE_LENGTH + 1];
+        snprintf(data, sizeof(data), "%s\n", arg);
+        sim_uart_inject(action[4] == '1' ? 1 : 0, data, (uint32_t)strlen(data));
+    } else if (strcmp(action, "usb") == 0) {
+        char data[SIM_SCRIPT_LINE_LENGTH + 1];
+        snprintf(data, sizeof(data), "%s\n", arg);
+        sim_usb_inject(data, (uint32_t)strlen(data));
+    } else if (strcmp(action, "bytes") == 0) {
+        char data[SIM_SCRIPT_LINE_LENGTH / 2];
+        uint32_t length = 0;
+        for (const char *p = arg; isxdigit((unsigned char)p[0]) && isxdigit((unsigned char)p[1]); p += 2) {
+            char pair[3] = { p[0], p[1], '\0' };
+            data[length++] = (char)strtoul(pair, NULL, 16);
+        }
+        sim_uart_inject(0, data, length);
+    } else if (strcmp(action, "signal") == 0 && pin >= 0 && arg2) {
+        char *duty = strtok_r(NULL, " \t", &arg_rest);
+        double hz = atof(arg2);
+        if (strcmp(arg2, "off") == 0) {
+            signal_stop((uint)pin);
+        } else if (hz > 0.0) {
+            signal_start((uint)pin, hz, duty ? atof(duty) : 50.0);
+        } else {
+            fprintf(stderr, "sim: script line %u: bad signal frequency\n", line->line_number);
+            exit(2);
+        }
+    } else if (strcmp(action, "watch") == 0 && pin >= 0) {
+        memset(&edge_counters[pin], 0, sizeof(edge_counters[pin]));
+        sim_gpio_watch((uint)pin, true);
+    } else if (strcmp(action, "edges") == 0 && pin >= 0) {
+        report_edges((uint)pin);
+    } else if (strcmp(action, "pulses") == 0 && pin >= 0) {
+        report_pulses((uint)pin);
+    } else if (strcmp(action, "pair") == 0 && pin >= 0 && parse_pin(arg2) >= 0) {
+        pair = (pair_t){ .active = true, .gpio = { (uint)pin, (uint)parse_pin(arg2) } };
+        for (uint i = 0; i < 2; i++) {
+            sim_gpio_watch(pair.gpio[i], true);
+            pair.high[i] = sim_gpio_level(pair.gpio[i]);
+        }
+        pair.both_since_ps = sim_cycles_to_ps(sim_now());
+    } else if (strcmp(action, "gaps") == 0 && pair.active) {
+        report_gaps();
+    } else if (strcmp(action, "level") == 0 && pin >= 0) {
+        report("gpio %u is %s", (uint)pin, sim_gpio_level((uint)pin) ? "HIGH" : "LOW");
+    } else if (strcmp(action, "quit") == 0) {
+        sim_stop();
+    } else {
+        fprintf(stderr, "sim: script line %u not understood: %s\n", line->line_number, line->text);
+        exit(2);
+    }
+    free(arg_copy);
+}
+
+static uint64_t script_next_event(void) {
+    // Converted when asked, so a system clock change cannot move a line
+    return script_next < script_length ? sim_us_to_cycles(script[script_next].at_us) : SIM_NEVER;
+}
+
+static void script_run_event(uint64_t now) {
+    while (script_next < script_length && sim_us_to_cycles(script[script_next].at_us) <= now) {
+        run_line(&script[script_next++]);
+    }
+}
+
+static const sim_agent_t script_agent = {
+    .name = "script",
+    .next_event = script_next_event,
+    .run_event = script_run_event,
+};
+
+// The run ends at a time rather than a cycle, which a retune would move
+static uint64_t end_us = 0;
+
+static uint64_t end_next_event(void) {
+    return sim_us_to_cycles(end_us);
+}
+
+static void end_run_event(uint64_t now) {
+    (void)now;
+    sim_stop();
+}
+
+static const sim_agent_t end_agent = {
+    .name = "end",
+    .next_event = end_next_event,
+    .run_event = end_run_event,
+};
+
+static void load_script(const char *path) {
+    FILE *f = strcmp(path, "-") == 0 ? stdin : fopen(path, "r");
+    if (!f) {
+        perror(path);
+        exit(2);
+    }
+
+    char buffer[SIM_SCRIPT_LINE_LENGTH];
+    uint line_number = 0;
+    uint64_t last = 0;
+    while (fgets(buffer, sizeof(buffer), f)) {
+        line_number++;
+        char *hash = strchr(buffer, '#');
+        if (hash) *hash = '\0';
+        buffer[strcspn(buffer, "\r\n")] = '\0';
+
+        char *end;
+        double ms = strtod(buffer, &end);
+        if (end == buffer) {
+            if (buffer[strspn(buffer, " \t")] == '\0') continue;
+            fprintf(stderr, "%s:%u: expected a time in milliseconds\n", path, line_number);
+            exit(2);
+        }
+        if (script_length == SIM_MAX_SCRIPT_LINES) {
+            fprintf(stderr, "%s: too many lines\n", path);
+            exit(2);
+        }
+
+        script_line_t *line = &script[script_length++];
+        line->at_us = (uint64_t)(ms * 1000.0 + 0.5);
+        if (line->at_us < last) {
+            fprintf(stderr, "%s:%u: times must not decrease\n", path, line_number);
+            exit(2);
+        }
+        last = line->at_us;
+        line->line_number = line_number;
+        snprintf(line->text, sizeof(line->text), "%s", end + strspn(end, " \t"));
+    }
+
+    if (f != stdin) fclose(f);
+}
+
+void sim_peripherals_init(void) {
+    sim_gpio_init();
+    sim_pwm_init();
+    sim_pio_init();
+    sim_dma_init();
+    sim_uart_init();
+    sim_register_agent(&script_agent);
+    sim_register_agent(&signal_agent);
+    sim_gpio_add_edge_hook(count_edge);
+}
+
+int main(int argc, char **argv) {
+    uint64_t until_ms = SIM_DEFAULT_UNTIL_MS;
+    const char *script_path = NULL;
+    const char *vcd_path = NULL;
+    bool echo_uart[2] = { false, false };
+    FILE *uart0_out = NULL;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--until") == 0 && i + 1 < argc) {
+            until_ms = strtoull(argv[++i], NULL, 10);
+        } else if (strcmp(argv[i], "--uart0") == 0 || strcmp(argv[i], "--uart1") == 0) {
+            echo_uart[argv[i][6] - '0'] = true;
+        } else if (strcmp(argv[i], "--uart0-out") == 0 && i + 1 < argc) {
+            uart0_out = fopen(argv[++i], "wb");
+            if (!uart0_out) {
+                perror(argv[i]);
+                return 2;
+            }
+        } else if (strcmp(argv[i], "--vcd") == 0 && i + 1 < argc) {
+            vcd_path = argv[++i];
+        } else if (argv[i][0] == '-' && argv[i][1] != '\0') {
+            fprintf(stderr, "usage: %s [--until MS] [--uart0] [--uart1] [--uart0-out FILE] [--vcd FILE] [SCRIPT]\n", argv[0]);
+            return 2;
+        } else {
+            script_path = argv[i];
+        }
+    }
+
+    sim_peripherals_init();
+    for (uint i = 0; i < 2; i++) {
+        sim_uart_set_echo(i, echo_uart[i]);
+    }
+    if (uart0_out) sim_uart_set_capture(0, uart0_out);
+    if (script_path) load_script(script_path);
+    if (vcd_path) sim_trace_start(vcd_path);
+
+    struct timespec start, end;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    end_us = until_ms * 1000u;
+    sim_register_agent(&end_agent);
+    uint64_t stopped = sim_core_run(core0_entry, SIM_NEVER);
+    clock_gettime(CLOCK_MONOTONIC, &end);
+
+    double host_s = (double)(end.tv_sec - start.tv_sec) + (double)(end.tv_nsec - start.tv_nsec) / 1e9;
+    double virtual_s = (double)sim_cycles_to_ps(stopped) / 1e12;
+    report("stopped after %.3f s virtual, %.3f s host (%.1fx)", virtual_s, host_s,
+           host_s > 0 ? virtual_s / host_s : 0.0);
+    for (uint i = 0; i < 2; i++) {
+        if (sim_uart_overruns(i)) {
+            report("uart%u lost %lu characters to receive FIFO overruns", i, (unsigned long)sim_uart_overruns(i));
+        }
+    }
+    if (sim_usb_overruns()) {
+        report("usb lost %lu characters the firmware never read", (unsigned long)sim_usb_overruns());
+    }
+    sim_trace_finish();
+    if (uart0_out) fclose(uart0_out);
+    return 0;
+}
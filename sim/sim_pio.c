@@ -0,0 +1,1033 @@
+/**
+ * Host Simulator: PIO blocks
+ *
+ * An instruction-level interpreter for both PIO blocks. State machines only
+ * produce events while they execute; a stalled machine sleeps until whatever
+ * it waits on changes (FIFO access, pin edge, IRQ flag). A `jmp x--`/`jmp y--`
+ * onto itself is a counted delay loop and is executed in a single step, and
+ * so is a `jmp pin` paired with a `jmp x--`/`jmp y--` that counts while the
+ * pin holds its level: that one runs until the pin changes.
+ */
+
+#include "sim.h"
+#include "pico/stdlib.h"
+#include "hardware/pio.h"
+#include "hardware/irq.h"
+#include "hardware/gpio.h"
+#include <stdio.h>
+#include <stdlib.h>
+
+#define PIO_FIFO_DEPTH 4
+
+// Cycles from a pin edge until a state machine sees it (input synchronizer)
+#define PIO_SYNC_CYCLES 2
+
+typedef enum {
+    STALL_NONE,
+    STALL_TX,           // PULL/OUT waiting for TX FIFO data
+    STALL_RX,           // PUSH/IN waiting for RX FIFO space
+    STALL_GPIO,         // WAIT on a pin
+    STALL_IRQ,          // WAIT irq or IRQ wait
+    STALL_DISABLED
+} stall_t;
+
+typedef struct {
+    uint32_t data[2 * PIO_FIFO_DEPTH];
+    uint head;
+    uint count;
+} pio_fifo_t;
+
+typedef struct {
+    uint32_t clkdiv;
+    uint32_t execctrl;
+    uint32_t shiftctrl;
+    uint32_t pinctrl;
+
+    bool enabled;
+    bool claimed;
+    uint8_t pc;
+    uint32_t x, y, isr, osr;
+    uint8_t isr_count;
+    uint8_t osr_count;
+    pio_fifo_t tx;
+    pio_fifo_t rx;
+
+    stall_t stall;
+    uint wait_gpio;             // Pin for STALL_GPIO
+    bool irq_wait_armed;        // IRQ wait has set its flag already
+    bool exec_pending;          // Forced instruction still to complete
+    uint16_t exec_instr;
+
+    uint64_t next256;           // Time of the next instruction, 1/256 cycles
+
+    // Counted delay loop executed in one step
+    bool loop_active;
+    uint64_t loop_start256;
+    uint64_t loop_step256;
+    uint32_t loop_count;        // Loop register value at loop_start256
+    uint8_t loop_pc;
+    bool loop_on_y;
+
+    // Pin poll loop: loop_pc is the `jmp pin`, the counting jump follows it
+    // and each iteration decrements the loop register once
+    bool pin_loop_active;
+    uint8_t pin_loop_count_pc;  // The counting jump
+    uint64_t pin_loop_count256; // Its offset within an iteration
+    uint pin_loop_gpio;
+} sim_sm_t;
+
+struct pio_inst {
+    uint index;
+    uint16_t instr_mem[PIO_INSTRUCTION_COUNT];
+    uint32_t used_mask;
+    sim_sm_t sm[NUM_PIO_STATE_MACHINES];
+    uint32_t pin_out;
+    uint32_t pin_oe;
+    uint8_t irq_flags;
+    uint32_t inte[2];
+};
+
+pio_hw_t sim_pio0_inst = { .index = 0 };
+pio_hw_t sim_pio1_inst = { .index = 1 };
+
+static pio_hw_t *const pios[NUM_PIOS] = { &sim_pio0_inst, &sim_pio1_inst };
+
+// FIFOs (joined FIFOs are 8 deep in one direction)
+
+static uint tx_depth(const sim_sm_t *sm) {
+    if (sm->shiftctrl & PIO_SM0_SHIFTCTRL_FJOIN_RX_BITS) return 0;
+    return (sm->shiftctrl & PIO_SM0_SHIFTCTRL_FJOIN_TX_BITS) ? 2 * PIO_FIFO_DEPTH : PIO_FIFO_DEPTH;
+}
+
+static uint rx_depth(const sim_sm_t *sm) {
+    if (sm->shiftctrl & PIO_SM0_SHIFTCTRL_FJOIN_TX_BITS) return 0;
+    return (sm->shiftctrl & PIO_SM0_SHIFTCTRL_FJOIN_RX_BITS) ? 2 * PIO_FIFO_DEPTH : PIO_FIFO_DEPTH;
+}
+
+static void fifo_push(pio_fifo_t *f, uint32_t value) {
+    f->data[(f->head + f->count) % (2 * PIO_FIFO_DEPTH)] = value;
+    f->count++;
+}
+
+static uint32_t fifo_pop(pio_fifo_t *f) {
+    uint32_t value = f->data[f->head];
+    f->head = (f->head + 1) % (2 * PIO_FIFO_DEPTH);
+    f->count--;
+    return value;
+}
+
+// Register fields
+
+static uint field(uint32_t reg, uint32_t bits, uint lsb) {
+    return (reg & bits) >> lsb;
+}
+
+static uint32_t div256(const sim_sm_t *sm) {
+    uint32_t div = sm->clkdiv >> PIO_SM0_CLKDIV_FRAC_LSB;
+    return div >= 256u ? div : 65536u * 256u;
+}
+
+static uint pull_threshold(const sim_sm_t *sm) {
+    uint t = field(sm->shiftctrl, PIO_SM0_SHIFTCTRL_PULL_THRESH_BITS, PIO_SM0_SHIFTCTRL_PULL_THRESH_LSB);
+    return t ? t : 32u;
+}
+
+static uint push_threshold(const sim_sm_t *sm) {
+    uint t = field(sm->shiftctrl, PIO_SM0_SHIFTCTRL_PUSH_THRESH_BITS, PIO_SM0_SHIFTCTRL_PUSH_THRESH_LSB);
+    return t ? t : 32u;
+}
+
+static uint8_t next_pc(const sim_sm_t *sm, uint8_t pc) {
+    uint top = field(sm->execctrl, PIO_SM0_EXECCTRL_WRAP_TOP_BITS, PIO_SM0_EXECCTRL_WRAP_TOP_LSB);
+    uint bottom = field(sm->execctrl, PIO_SM0_EXECCTRL_WRAP_BOTTOM_BITS, PIO_SM0_EXECCTRL_WRAP_BOTTOM_LSB);
+    return pc == top ? (uint8_t)bottom : (uint8_t)((pc + 1u) & 31u);
+}
+
+// Pins
+
+bool sim_pio_pad_output(uint pio_index, uint gpio, bool *level) {
+    const pio_hw_t *pio = pios[pio_index];
+    if (!(pio->pin_oe & (1u << gpio))) return false;
+    *level = (pio->pin_out >> gpio) & 1u;
+    return true;
+}
+
+static void write_pins(pio_hw_t *pio, uint32_t *reg, uint base, uint count, uint32_t values) {
+    uint32_t before = *reg;
+    for (uint i = 0; i < count; i++) {
+        uint pin = (base + i) & 31u;
+        if (values & (1u << i)) {
+            *reg |= 1u << pin;
+        } else {
+            *reg &= ~(1u << pin);
+        }
+    }
+
+    uint32_t changed = (before ^ *reg) & ((1u << SIM_NUM_GPIOS) - 1u);
+    enum gpio_function fn = pio->index ? GPIO_FUNC_PIO1 : GPIO_FUNC_PIO0;
+    for (uint gpio = 0; gpio < SIM_NUM_GPIOS; gpio++) {
+        if ((changed & (1u << gpio)) && gpio_get_function(gpio) == fn) {
+            sim_gpio_refresh(gpio);
+        }
+    }
+}
+
+static uint32_t read_pins(const sim_sm_t *sm) {
+    uint base = field(sm->pinctrl, PIO_SM0_PINCTRL_IN_BASE_BITS, PIO_SM0_PINCTRL_IN_BASE_LSB);
+    uint32_t value = 0;
+    for (uint i = 0; i < 32u; i++) {
+        uint pin = (base + i) & 31u;
+        if (pin < SIM_NUM_GPIOS && sim_gpio_level(pin)) value |= 1u << i;
+    }
+    return value;
+}
+
+// Interrupts
+
+static uint32_t pio_intr(const pio_hw_t *pio) {
+    uint32_t intr = (uint32_t)(pio->irq_flags & 0xfu) << 8;
+    for (uint i = 0; i < NUM_PIO_STATE_MACHINES; i++) {
+        const sim_sm_t *sm = &pio->sm[i];
+        if (sm->rx.count) intr |= 1u << i;
+        if (sm->tx.count < tx_depth(sm)) intr |= 1u << (4 + i);
+    }
+    return intr;
+}
+
+static bool pio0_irq0_asserted(uint core) { (void)core; return pio_intr(pio0) & pio0->inte[0]; }
+static bool pio0_irq1_asserted(uint core) { (void)core; return pio_intr(pio0) & pio0->inte[1]; }
+static bool pio1_irq0_asserted(uint core) { (void)core; return pio_intr(pio1) & pio1->inte[0]; }
+static bool pio1_irq1_asserted(uint core) { (void)core; return pio_intr(pio1) & pio1->inte[1]; }
+
+// Scheduling
+
+static void wake(sim_sm_t *sm, stall_t reason, uint64_t at) {
+    if (sm->stall != reason) return;
+    sm->stall = STALL_NONE;
+    if (sm->next256 < at * 256u) sm->next256 = at * 256u;
+}
+
+static void wake_all(pio_hw_t *pio, stall_t reason, uint64_t at) {
+    for (uint i = 0; i < NUM_PIO_STATE_MACHINES; i++) {
+        wake(&pio->sm[i], reason, at);
+    }
+}
+
+uint32_t sim_pio_wait_mask(void) {
+    uint32_t mask = 0;
+    for (uint p = 0; p < NUM_PIOS; p++) {
+        for (uint i = 0; i < NUM_PIO_STATE_MACHINES; i++) {
+            const sim_sm_t *sm = &pios[p]->sm[i];
+            if (sm->enabled && sm->stall == STALL_GPIO) mask |= 1u << sm->wait_gpio;
+            if (sm->enabled && sm->pin_loop_active) mask |= 1u << sm->pin_loop_gpio;
+        }
+    }
+    return mask;
+}
+
+static void sync_pin_loop(sim_sm_t *sm, uint64_t at256, bool resample);
+
+void sim_pio_gpio_changed(uint gpio) {
+    for (uint p = 0; p < NUM_PIOS; p++) {
+        for (uint i = 0; i < NUM_PIO_STATE_MACHINES; i++) {
+            sim_sm_t *sm = &pios[p]->sm[i];
+            if (sm->stall == STALL_GPIO && sm->wait_gpio == gpio) {
+                wake(sm, STALL_GPIO, sim_now() + PIO_SYNC_CYCLES);
+            }
+            if (sm->pin_loop_active && sm->pin_loop_gpio == gpio) {
+                // The first sample that can see the change tests the pin again
+                sync_pin_loop(sm, (sim_now() + PIO_SYNC_CYCLES) * 256u, true);
+            }
+        }
+    }
+}
+
+// Leave a pin poll loop at a time. With resample, stop at the next `jmp pin`
+// so it tests the pin itself; otherwise stop wherever the loop has got to.
+static void sync_pin_loop(sim_sm_t *sm, uint64_t at256, bool resample) {
+    if (!sm->pin_loop_active) return;
+    sm->pin_loop_active = false;
+
+    // Iteration k tests the pin at loop_start256 + k * loop_step256 and
+    // counts pin_loop_count256 later; the last one ends with the register at 0
+    uint64_t k = 0;
+    if (at256 > sm->loop_start256) {
+        k = (at256 - sm->loop_start256 + sm->loop_step256 - 1u) / sm->loop_step256;
+    }
+    bool at_count = false;
+    if (!resample && k > 0 &&
+        at256 <= sm->loop_start256 + (k - 1u) * sm->loop_step256 + sm->pin_loop_count256) {
+        k--;
+        at_count = true;
+    }
+    if (k > sm->loop_count) {
+        k = sm->loop_count;
+        at_count = false;
+    }
+
+    uint32_t *reg = sm->loop_on_y ? &sm->y : &sm->x;
+    *reg = sm->loop_count - (uint32_t)k;
+    sm->pc = at_count ? sm->pin_loop_count_pc : sm->loop_pc;
+    sm->next256 = sm->loop_start256 + k * sm->loop_step256 + (at_count ? sm->pin_loop_count256 : 0u);
+}
+
+// Bring a state machine inside a counted delay loop up to date before the
+// CPU looks at or changes it
+static void sync_loop(sim_sm_t *sm) {
+    sync_pin_loop(sm, sim_now() * 256u, false);
+    if (!sm->loop_active) return;
+    sm->loop_active = false;
+
+    // Iteration k of the loop executes at loop_start256 + k * loop_step256
+    uint64_t now256 = sim_now() * 256u;
+    uint64_t done = 0;
+    if (now256 >= sm->loop_start256) {
+        done = (now256 - sm->loop_start256) / sm->loop_step256 + 1u;
+        if (done > (uint64_t)sm->loop_count) return; // Loop already finished
+    }
+    sm->next256 = sm->loop_start256 + done * sm->loop_step256;
+    sm->loop_count -= (uint32_t)done;
+    sm->pc = sm->loop_pc;
+    if (sm->loop_on_y) {
+        sm->y = sm->loop_count;
+    } else {
+        sm->x = sm->loop_count;
+    }
+}
+
+// Execution
+
+static bool jmp_condition(sim_sm_t *sm, uint cond) {
+    switch (cond) {
+        case 0: return true;
+        case 1: return sm->x == 0;
+        case 2: return sm->x-- != 0;
+        case 3: return sm->y == 0;
+        case 4: return sm->y-- != 0;
+        case 5: return sm->x != sm->y;
+        case 6: {
+            uint pin = field(sm->execctrl, PIO_SM0_EXECCTRL_JMP_PIN_BITS, PIO_SM0_EXECCTRL_JMP_PIN_LSB);
+            return pin < SIM_NUM_GPIOS && sim_gpio_level(pin);
+        }
+        default: return sm->osr_count < pull_threshold(sm);
+    }
+}
+
+static uint irq_index(uint sm_num, uint index) {
+    if (index & 0x10u) {
+        return (index & 4u) | ((index + sm_num) & 3u);
+    }
+    return index & 7u;
+}
+
+static uint32_t mov_source(pio_hw_t *pio, sim_sm_t *sm, uint src) {
+    (void)pio;
+    switch (src) {
+        case 0: return read_pins(sm);
+        case 1: return sm->x;
+        case 2: return sm->y;
+        case 5: {
+            uint n = field(sm->execctrl, PIO_SM0_EXECCTRL_STATUS_N_BITS, PIO_SM0_EXECCTRL_STATUS_N_LSB);
+            bool rx = sm->execctrl & PIO_SM0_EXECCTRL_STATUS_SEL_BITS;
+            uint level = rx ? sm->rx.count : sm->tx.count;
+            return level < n ? 0xffffffffu : 0u;
+        }
+        case 6: return sm->isr;
+        case 7: return sm->osr;
+        default: return 0;
+    }
+}
+
+static uint32_t bit_reverse(uint32_t v) {
+    uint32_t r = 0;
+    for (uint i = 0; i < 32u; i++) {
+        r = (r << 1) | ((v >> i) & 1u);
+    }
+    return r;
+}
+
+static bool do_push(sim_sm_t *sm, bool block) {
+    if (sm->rx.count >= rx_depth(sm)) {
+        if (block) return false;
+    } else {
+        fifo_push(&sm->rx, sm->isr);
+    }
+    sm->isr = 0;
+    sm->isr_count = 0;
+    return true;
+}
+
+static bool do_pull(sim_sm_t *sm, bool block) {
+    if (sm->tx.count == 0) {
+        if (block) return false;
+        sm->osr = sm->x;
+    } else {
+        sm->osr = fifo_pop(&sm->tx);
+    }
+    sm->osr_count = 0;
+    return true;
+}
+
+static void shift_in(sim_sm_t *sm, uint32_t data, uint count) {
+    uint32_t mask = count == 32u ? 0xffffffffu : (1u << count) - 1u;
+    data &= mask;
+    if (sm->shiftctrl & PIO_SM0_SHIFTCTRL_IN_SHIFTDIR_BITS) {
+        sm->isr = count == 32u ? data : (sm->isr >> count) | (data << (32u - count));
+    } else {
+        sm->isr = count == 32u ? data : (sm->isr << count) | data;
+    }
+    sm->isr_count = (uint8_t)(sm->isr_count + count > 32u ? 32u : sm->isr_count + count);
+}
+
+static uint32_t shift_out(sim_sm_t *sm, uint count) {
+    uint32_t data;
+    if (sm->shiftctrl & PIO_SM0_SHIFTCTRL_OUT_SHIFTDIR_BITS) {
+        data = count == 32u ? sm->osr : sm->osr & ((1u << count) - 1u);
+        sm->osr = count == 32u ? 0 : sm->osr >> count;
+    } else {
+        data = count == 32u ? sm->osr : sm->osr >> (32u - count);
+        sm->osr = count == 32u ? 0 : sm->osr << count;
+    }
+    sm->osr_count = (uint8_t)(sm->osr_count + count > 32u ? 32u : sm->osr_count + count);
+    return data;
+}
+
+typedef enum {
+    EXEC_DONE,          // Advance to the next instruction
+    EXEC_JUMPED,        // PC already updated
+    EXEC_STALLED
+} exec_result_t;
+
+static exec_result_t execute(pio_hw_t *pio, uint sm_num, uint16_t instr);
+
+static exec_result_t exec_out_dest(pio_hw_t *pio, uint sm_num, uint dest, uint32_t data, uint count) {
+    sim_sm_t *sm = &pio->sm[sm_num];
+    uint out_base = field(sm->pinctrl, PIO_SM0_PINCTRL_OUT_BASE_BITS, PIO_SM0_PINCTRL_OUT_BASE_LSB);
+
+    switch (dest) {
+        case 0: write_pins(pio, &pio->pin_out, out_base, count, data); break;
+        case 1: sm->x = data; break;
+        case 2: sm->y = data; break;
+        case 4: write_pins(pio, &pio->pin_oe, out_base, count, data); break;
+        case 5: sm->pc = (uint8_t)(data & 31u); return EXEC_JUMPED;
+        case 6: sm->isr = data; sm->isr_count = (uint8_t)count; break;
+        case 7:
+            sm->exec_pending = true;
+            sm->exec_instr = (uint16_t)data;
+            break;
+        default: break;
+    }
+    return EXEC_DONE;
+}
+
+static exec_result_t execute(pio_hw_t *pio, uint sm_num, uint16_t instr) {
+    sim_sm_t *sm = &pio->sm[sm_num];
+    uint arg1 = (instr >> 5) & 7u;
+    uint arg2 = instr & 0x1fu;
+
+    switch (instr >> 13) {
+        case 0: // JMP
+            if (jmp_condition(sm, arg1)) {
+                sm->pc = (uint8_t)arg2;
+                return EXEC_JUMPED;
+            }
+            return EXEC_DONE;
+
+        case 1: { // WAIT
+            bool polarity = arg1 & 4u;
+            switch (arg1 & 3u) {
+                case 0:
+                case 1: {
+                    uint pin = arg2;
+                    if (arg1 & 1u) {
+                        uint base = field(sm->pinctrl, PIO_SM0_PINCTRL_IN_BASE_BITS, PIO_SM0_PINCTRL_IN_BASE_LSB);
+                        pin = (base + arg2) & 31u;
+                    }
+                    if (pin < SIM_NUM_GPIOS && sim_gpio_level(pin) == polarity) return EXEC_DONE;
+                    sm->stall = STALL_GPIO;
+                    sm->wait_gpio = pin;
+                    return EXEC_STALLED;
+                }
+                case 2: {
+                    uint flag = irq_index(sm_num, arg2);
+                    bool set = (pio->irq_flags >> flag) & 1u;
+                    if (set == polarity) {
+                        if (polarity) pio->irq_flags &= (uint8_t)~(1u << flag);
+                        wake_all(pio, STALL_IRQ, sim_now() + 1);
+                        return EXEC_DONE;
+                    }
+                    sm->stall = STALL_IRQ;
+                    return EXEC_STALLED;
+                }
+                default:
+                    return EXEC_DONE;
+            }
+        }
+
+        case 2: { // IN
+            uint count = arg2 ? arg2 : 32u;
+            bool autopush = sm->shiftctrl & PIO_SM0_SHIFTCTRL_AUTOPUSH_BITS;
+            if (autopush && sm->isr_count + count >= push_threshold(sm) && sm->rx.count >= rx_depth(sm)) {
+                sm->stall = STALL_RX;
+                return EXEC_STALLED;
+            }
+            shift_in(sm, mov_source(pio, sm, arg1), count);
+            if (autopush && sm->isr_count >= push_threshold(sm)) do_push(sm, true);
+            return EXEC_DONE;
+        }
+
+        case 3: { // OUT
+            uint count = arg2 ? arg2 : 32u;
+            bool autopull = sm->shiftctrl & PIO_SM0_SHIFTCTRL_AUTOPULL_BITS;
+            if (autopull && sm->osr_count >= pull_threshold(sm)) {
+                if (!do_pull(sm, true)) {
+                    sm->stall = STALL_TX;
+                    return EXEC_STALLED;
+                }
+            }
+            return exec_out_dest(pio, sm_num, arg1, shift_out(sm, count), count);
+        }
+
+        case 4: { // PUSH / PULL
+            bool if_flag = instr & 0x40u;
+            bool block = instr & 0x20u;
+            if (instr & 0x80u) {
+                if (if_flag && sm->osr_count < pull_threshold(sm)) return EXEC_DONE;
+                if (!do_pull(sm, block)) {
+                    sm->stall = STALL_TX;
+                    return EXEC_STALLED;
+                }
+            } else {
+                if (if_flag && sm->isr_count < push_threshold(sm)) return EXEC_DONE;
+                if (!do_push(sm, block)) {
+                    sm->stall = STALL_RX;
+                    return EXEC_STALLED;
+                }
+            }
+            return EXEC_DONE;
+        }
+
+        case 5: { // MOV
+            uint32_t data = mov_source(pio, sm, arg2 & 7u);
+            uint op = (arg2 >> 3) & 3u;
+            if (op == 1) data = ~data;
+            if (op == 2) data = bit_reverse(data);
+
+            uint out_base = field(sm->pinctrl, PIO_SM0_PINCTRL_OUT_BASE_BITS, PIO_SM0_PINCTRL_OUT_BASE_LSB);
+            uint out_count = field(sm->pinctrl, PIO_SM0_PINCTRL_OUT_COUNT_BITS, PIO_SM0_PINCTRL_OUT_COUNT_LSB);
+            switch (arg1) {
+                case 0: write_pins(pio, &pio->pin_out, out_base, out_count, data); break;
+                case 1: sm->x = data; break;
+                case 2: sm->y = data; break;
+                case 4:
+                    sm->exec_pending = true;
+                    sm->exec_instr = (uint16_t)data;
+                    break;
+                case 5: sm->pc = (uint8_t)(data & 31u); return EXEC_JUMPED;
+                case 6: sm->isr = data; sm->isr_count = 0; break;
+                case 7: sm->osr = data; sm->osr_count = 0; break;
+                default: break;
+            }
+            return EXEC_DONE;
+        }
+
+        case 6: { // IRQ
+            uint flag = irq_index(sm_num, arg2);
+            bool clear = arg1 & 2u;
+            bool wait = arg1 & 1u;
+            if (clear) {
+                pio->irq_flags &= (uint8_t)~(1u << flag);
+                wake_all(pio, STALL_IRQ, sim_now() + 1);
+                return EXEC_DONE;
+            }
+            if (!sm->irq_wait_armed) {
+                pio->irq_flags |= (uint8_t)(1u << flag);
+                wake_all(pio, STALL_IRQ, sim_now() + 1);
+            }
+            if (wait && ((pio->irq_flags >> flag) & 1u)) {
+                sm->irq_wait_armed = true;
+                sm->stall = STALL_IRQ;
+                return EXEC_STALLED;
+            }
+            sm->irq_wait_armed = false;
+            return EXEC_DONE;
+        }
+
+        default: { // SET
+            uint set_base = field(sm->pinctrl, PIO_SM0_PINCTRL_SET_BASE_BITS, PIO_SM0_PINCTRL_SET_BASE_LSB);
+            uint set_count = field(sm->pinctrl, PIO_SM0_PINCTRL_SET_COUNT_BITS, PIO_SM0_PINCTRL_SET_COUNT_LSB);
+            switch (arg1) {
+                case 0: write_pins(pio, &pio->pin_out, set_base, set_count, arg2); break;
+                case 1: sm->x = arg2; break;
+                case 2: sm->y = arg2; break;
+                case 4: write_pins(pio, &pio->pin_oe, set_base, set_count, arg2); break;
+                default: break;
+            }
+            return EXEC_DONE;
+        }
+    }
+}
+
+// Apply side-set and return the delay field of an instruction
+static uint apply_sideset(pio_hw_t *pio, sim_sm_t *sm, uint16_t instr) {
+    uint count = field(sm->pinctrl, PIO_SM0_PINCTRL_SIDESET_COUNT_BITS, PIO_SM0_PINCTRL_SIDESET_COUNT_LSB);
+    uint field_bits = (instr >> 8) & 0x1fu;
+    uint delay_bits = 5u - count;
+    uint delay = field_bits & ((1u << delay_bits) - 1u);
+
+    if (count) {
+        uint side = field_bits >> delay_bits;
+        uint side_bits = count;
+        bool apply = true;
+        if (sm->execctrl & PIO_SM0_EXECCTRL_SIDE_EN_BITS) {
+            side_bits = count - 1u;
+            apply = (side >> side_bits) & 1u;
+            side &= (1u << side_bits) - 1u;
+        }
+        if (apply && side_bits) {
+            uint base = field(sm->pinctrl, PIO_SM0_PINCTRL_SIDESET_BASE_BITS, PIO_SM0_PINCTRL_SIDESET_BASE_LSB);
+            uint32_t *reg = (sm->execctrl & PIO_SM0_EXECCTRL_SIDE_PINDIR_BITS) ? &pio->pin_oe : &pio->pin_out;
+            write_pins(pio, reg, base, side_bits, side);
+        }
+    }
+    return delay;
+}
+
+static uint instr_delay(const sim_sm_t *sm, uint16_t instr) {
+    uint count = field(sm->pinctrl, PIO_SM0_PINCTRL_SIDESET_COUNT_BITS, PIO_SM0_PINCTRL_SIDESET_COUNT_LSB);
+    return ((instr >> 8) & 0x1fu) & ((1u << (5u - count)) - 1u);
+}
+
+// A `jmp pin` whose path at the current level is a `jmp x--`/`jmp y--` that
+// comes straight back to it: skip ahead to the pin's next change (or to the
+// register reaching zero). Side-set is the same on every pass, so the
+// counting jump's is applied once here.
+static bool enter_pin_loop(pio_hw_t *pio, sim_sm_t *sm, uint16_t instr) {
+    if ((instr >> 13) != 0 || ((instr >> 5) & 7u) != 6) return false;
+    uint pin = field(sm->execctrl, PIO_SM0_EXECCTRL_JMP_PIN_BITS, PIO_SM0_EXECCTRL_JMP_PIN_LSB);
+    if (pin >= SIM_NUM_GPIOS) return false;
+
+    uint8_t count_pc = sim_gpio_level(pin) ? (uint8_t)(instr & 0x1fu) : next_pc(sm, sm->pc);
+    uint16_t count_instr = pio->instr_mem[count_pc];
+    uint cond = (count_instr >> 5) & 7u;
+    if ((count_instr >> 13) != 0 || (cond != 2 && cond != 4) || (count_instr & 0x1fu) != sm->pc) return false;
+
+    uint32_t reg = cond == 2 ? sm->x : sm->y;
+    if (reg == 0) return false;
+
+    apply_sideset(pio, sm, count_instr);
+    uint64_t test256 = (uint64_t)(1u + instr_delay(sm, instr)) * div256(sm);
+    sm->pin_loop_active = true;
+    sm->pin_loop_count_pc = count_pc;
+    sm->pin_loop_count256 = test256;
+    sm->pin_loop_gpio = pin;
+    sm->loop_start256 = sm->next256;
+    sm->loop_step256 = test256 + (uint64_t)(1u + instr_delay(sm, count_instr)) * div256(sm);
+    sm->loop_count = reg;
+    sm->loop_pc = sm->pc;
+    sm->loop_on_y = cond == 4;
+
+    // Unless the pin changes first, the loop ends at the test that finds
+    // the register at zero, and the counting jump then falls through
+    sm->next256 = sm->loop_start256 + (uint64_t)reg * sm->loop_step256;
+    if (cond == 2) {
+        sm->x = 0;
+    } else {
+        sm->y = 0;
+    }
+    return true;
+}
+
+// Execute one instruction (or a whole counted delay loop) of a state machine
+static void step(pio_hw_t *pio, uint sm_num) {
+    sim_sm_t *sm = &pio->sm[sm_num];
+    sm->pin_loop_active = false; // A pin poll loop runs out with the register at zero
+    bool forced = sm->exec_pending;
+    uint16_t instr = forced ? sm->exec_instr : pio->instr_mem[sm->pc];
+    uint delay = apply_sideset(pio, sm, instr);
+
+    // jmp x--/y-- onto itself: run every remaining iteration at once
+    uint cond = (instr >> 5) & 7u;
+    if (!forced && (instr >> 13) == 0 && (cond == 2 || cond == 4) && (instr & 0x1fu) == sm->pc) {
+        uint32_t *reg = cond == 2 ? &sm->x : &sm->y;
+        if (*reg != 0) {
+            sm->loop_active = true;
+            sm->loop_start256 = sm->next256;
+            sm->loop_step256 = (uint64_t)(1u + delay) * div256(sm);
+            sm->loop_count = *reg;
+            sm->loop_pc = sm->pc;
+            sm->loop_on_y = cond == 4;
+
+            sm->next256 += ((uint64_t)*reg + 1u) * sm->loop_step256;
+            *reg = 0xffffffffu;
+            sm->pc = next_pc(sm, sm->pc);
+            return;
+        }
+    }
+    sm->loop_active = false;
+
+    if (!forced && enter_pin_loop(pio, sm, instr)) return;
+
+    // OUT/MOV EXEC queue their instruction as a new forced instruction
+    sm->exec_pending = false;
+    exec_result_t result = execute(pio, sm_num, instr);
+    if (result == EXEC_STALLED) {
+        if (forced) {
+            sm->exec_pending = true;
+            sm->exec_instr = instr;
+        }
+        return;
+    }
+
+    if (result == EXEC_DONE && !forced) {
+        sm->pc = next_pc(sm, sm->pc);
+    }
+    sm->next256 += (uint64_t)(1u + delay) * div256(sm);
+}
+
+static uint64_t sm_next_event(const sim_sm_t *sm) {
+    if (!sm->enabled || sm->stall != STALL_NONE) return SIM_NEVER;
+    return (sm->next256 + 255u) / 256u;
+}
+
+static uint64_t pio_next_event(void) {
+    uint64_t next = SIM_NEVER;
+    for (uint p = 0; p < NUM_PIOS; p++) {
+        for (uint i = 0; i < NUM_PIO_STATE_MACHINES; i++) {
+            uint64_t t = sm_next_event(&pios[p]->sm[i]);
+            if (t < next) next = t;
+        }
+    }
+    return next;
+}
+
+static void pio_run_event(uint64_t now) {
+    for (uint p = 0; p < NUM_PIOS; p++) {
+        for (uint i = 0; i < NUM_PIO_STATE_MACHINES; i++) {
+            sim_sm_t *sm = &pios[p]->sm[i];
+            while (sm_next_event(sm) <= now) {
+                step(pios[p], i);
+            }
+        }
+    }
+}
+
+static const sim_agent_t pio_agent = {
+    .name = "pio",
+    .next_event = pio_next_event,
+    .run_event = pio_run_event,
+};
+
+void sim_pio_init(void) {
+    for (uint p = 0; p < NUM_PIOS; p++) {
+        for (uint i = 0; i < NUM_PIO_STATE_MACHINES; i++) {
+            pio_sm_config c = pio_get_default_sm_config();
+            pio_sm_set_config(pios[p], i, &c);
+        }
+    }
+    sim_register_agent(&pio_agent);
+    sim_register_irq_source(PIO0_IRQ_0, pio0_irq0_asserted);
+    sim_register_irq_source(PIO0_IRQ_1, pio0_irq1_asserted);
+    sim_register_irq_source(PIO1_IRQ_0, pio1_irq0_asserted);
+    sim_register_irq_source(PIO1_IRQ_1, pio1_irq1_asserted);
+}
+
+// SDK PIO API: instruction memory
+
+uint pio_get_index(PIO pio) {
+    return pio->index;
+}
+
+static int find_offset(PIO pio, const pio_program_t *program) {
+    uint32_t mask = (1u << program->length) - 1u;
+    if (program->origin >= 0) {
+        uint origin = (uint)program->origin;
+        if (origin + program->length > PIO_INSTRUCTION_COUNT) return -1;
+        return (pio->used_mask & (mask << origin)) ? -1 : (int)origin;
+    }
+    // Load as high as possible, as the SDK does
+    for (int offset = PIO_INSTRUCTION_COUNT - program->length; offset >= 0; offset--) {
+        if (!(pio->used_mask & (mask << offset))) return offset;
+    }
+    return -1;
+}
+
+bool pio_can_add_program(PIO pio, const pio_program_t *program) {
+    return find_offset(pio, program) >= 0;
+}
+
+void pio_add_program_at_offset(PIO pio, const pio_program_t *program, uint offset) {
+    for (uint i = 0; i < program->length; i++) {
+        uint16_t instr = program->instructions[i];
+        // JMP targets are relative to the program and relocated on load
+        pio->instr_mem[offset + i] = (instr >> 13) == 0 ? (uint16_t)(instr + offset) : instr;
+    }
+    pio->used_mask |= ((1u << program->length) - 1u) << offset;
+}
+
+uint pio_add_program(PIO pio, const pio_program_t *program) {
+    int offset = find_offset(pio, program);
+    if (offset < 0) {
+        fprintf(stderr, "sim: no program space on pio%u\n", pio->index);
+        exit(1);
+    }
+    pio_add_program_at_offset(pio, program, (uint)offset);
+    return (uint)offset;
+}
+
+void pio_remove_program(PIO pio, const pio_program_t *program, uint loaded_offset) {
+    pio->used_mask &= ~(((1u << program->length) - 1u) << loaded_offset);
+}
+
+void pio_clear_instruction_memory(PIO pio) {
+    pio->used_mask = 0;
+    for (uint i = 0; i < PIO_INSTRUCTION_COUNT; i++) {
+        pio->instr_mem[i] = pio_encode_jmp(i);
+    }
+}
+
+// SDK PIO API: state machines
+
+void pio_sm_claim(PIO pio, uint sm) {
+    pio->sm[sm].claimed = true;
+}
+
+int pio_claim_unused_sm(PIO pio, bool required) {
+    for (uint i = 0; i < NUM_PIO_STATE_MACHINES; i++) {
+        if (!pio->sm[i].claimed) {
+            pio->sm[i].claimed = true;
+            return (int)i;
+        }
+    }
+    if (required) {
+        fprintf(stderr, "sim: no free state machine on pio%u\n", pio->index);
+        exit(1);
+    }
+    return -1;
+}
+
+void pio_sm_unclaim(PIO pio, uint sm) {
+    pio->sm[sm].claimed = false;
+}
+
+bool pio_sm_is_claimed(PIO pio, uint sm) {
+    return pio->sm[sm].claimed;
+}
+
+void pio_gpio_init(PIO pio, uint pin) {
+    gpio_set_function(pin, pio->index ? GPIO_FUNC_PIO1 : GPIO_FUNC_PIO0);
+}
+
+void pio_sm_set_config(PIO pio, uint sm, const pio_sm_config *config) {
+    sim_sm_t *s = &pio->sm[sm];
+    sync_loop(s);
+    s->clkdiv = config->clkdiv;
+    s->execctrl = config->execctrl;
+    s->shiftctrl = config->shiftctrl;
+    s->pinctrl = config->pinctrl;
+}
+
+void pio_sm_init(PIO pio, uint sm, uint initial_pc, const pio_sm_config *config) {
+    pio_sm_set_enabled(pio, sm, false);
+    pio_sm_set_config(pio, sm, config);
+    pio_sm_clear_fifos(pio, sm);
+    pio_sm_restart(pio, sm);
+    pio_sm_clkdiv_restart(pio, sm);
+    pio_sm_exec(pio, sm, pio_encode_jmp(initial_pc));
+}
+
+void pio_sm_set_enabled(PIO pio, uint sm, bool enabled) {
+    sim_sm_t *s = &pio->sm[sm];
+    sync_loop(s);
+    if (enabled && !s->enabled) {
+        s->next256 = (sim_now() + 1u) * 256u;
+    }
+    s->enabled = enabled;
+}
+
+void pio_set_sm_mask_enabled(PIO pio, uint32_t mask, bool enabled) {
+    for (uint i = 0; i < NUM_PIO_STATE_MACHINES; i++) {
+        if (mask & (1u << i)) pio_sm_set_enabled(pio, i, enabled);
+    }
+}
+
+void pio_sm_restart(PIO pio, uint sm) {
+    sim_sm_t *s = &pio->sm[sm];
+    sync_loop(s);
+    s->isr = 0;
+    s->isr_count = 0;
+    s->osr_count = 32;
+    s->stall = STALL_NONE;
+    s->irq_wait_armed = false;
+    s->exec_pending = false;
+    if (s->next256 < sim_now() * 256u) s->next256 = sim_now() * 256u;
+}
+
+void pio_sm_clkdiv_restart(PIO pio, uint sm) {
+    (void)pio;
+    (void)sm;
+}
+
+void pio_sm_set_clkdiv_int_frac(PIO pio, uint sm, uint16_t div_int, uint8_t div_frac) {
+    sync_loop(&pio->sm[sm]);
+    pio->sm[sm].clkdiv = ((uint32_t)div_frac << PIO_SM0_CLKDIV_FRAC_LSB) | ((uint32_t)div_int << PIO_SM0_CLKDIV_INT_LSB);
+}
+
+void pio_sm_set_clkdiv(PIO pio, uint sm, float div) {
+    pio_sm_config c;
+    sm_config_set_clkdiv(&c, div);
+    sync_loop(&pio->sm[sm]);
+    pio->sm[sm].clkdiv = c.clkdiv;
+}
+
+void pio_sm_set_wrap(PIO pio, uint sm, uint wrap_target, uint wrap) {
+    pio_sm_config c = { .execctrl = pio->sm[sm].execctrl };
+    sm_config_set_wrap(&c, wrap_target, wrap);
+    pio->sm[sm].execctrl = c.execctrl;
+}
+
+void pio_sm_exec(PIO pio, uint sm, uint instr) {
+    sim_sm_t *s = &pio->sm[sm];
+    sync_loop(s);
+
+    // Forced instructions execute immediately; one that stalls completes
+    // later, from the state machine's own clock
+    s->stall = STALL_NONE;
+    s->exec_pending = false;
+    if (execute(pio, sm, (uint16_t)instr) == EXEC_STALLED) {
+        s->exec_pending = true;
+        s->exec_instr = (uint16_t)instr;
+    }
+    if (s->next256 < (sim_now() + 1u) * 256u) s->next256 = (sim_now() + 1u) * 256u;
+}
+
+bool pio_sm_is_exec_stalled(PIO pio, uint sm) {
+    return pio->sm[sm].exec_pending;
+}
+
+uint8_t pio_sm_get_pc(PIO pio, uint sm) {
+    sync_loop(&pio->sm[sm]);
+    return pio->sm[sm].pc;
+}
+
+// SDK PIO API: pins
+
+void pio_sm_set_pins(PIO pio, uint sm, uint32_t pin_values) {
+    (void)sm;
+    write_pins(pio, &pio->pin_out, 0, SIM_NUM_GPIOS, pin_values);
+}
+
+void pio_sm_set_pins_with_mask(PIO pio, uint sm, uint32_t pin_values, uint32_t pin_mask) {
+    (void)sm;
+    uint32_t values = (pio->pin_out & ~pin_mask) | (pin_values & pin_mask);
+    write_pins(pio, &pio->pin_out, 0, SIM_NUM_GPIOS, values);
+}
+
+void pio_sm_set_pindirs_with_mask(PIO pio, uint sm, uint32_t pin_dirs, uint32_t pin_mask) {
+    (void)sm;
+    uint32_t dirs = (pio->pin_oe & ~pin_mask) | (pin_dirs & pin_mask);
+    write_pins(pio, &pio->pin_oe, 0, SIM_NUM_GPIOS, dirs);
+}
+
+int pio_sm_set_consecutive_pindirs(PIO pio, uint sm, uint pin_base, uint pin_count, bool is_out) {
+    uint32_t mask = 0;
+    for (uint i = 0; i < pin_count; i++) {
+        mask |= 1u << ((pin_base + i) & 31u);
+    }
+    pio_sm_set_pindirs_with_mask(pio, sm, is_out ? mask : 0u, mask);
+    return 0;
+}
+
+// SDK PIO API: FIFOs
+
+void pio_sm_put(PIO pio, uint sm, uint32_t data) {
+    sim_sm_t *s = &pio->sm[sm];
+    if (s->tx.count < tx_depth(s)) {
+        fifo_push(&s->tx, data);
+        wake(s, STALL_TX, sim_now() + 1);
+    }
+}
+
+void pio_sm_put_blocking(PIO pio, uint sm, uint32_t data) {
+    while (pio_sm_is_tx_fifo_full(pio, sm)) {
+        tight_loop_contents();
+    }
+    pio_sm_put(pio, sm, data);
+}
+
+uint32_t pio_sm_get(PIO pio, uint sm) {
+    sim_sm_t *s = &pio->sm[sm];
+    if (s->rx.count == 0) return 0;
+    uint32_t data = fifo_pop(&s->rx);
+    wake(s, STALL_RX, sim_now() + 1);
+    return data;
+}
+
+uint32_t pio_sm_get_blocking(PIO pio, uint sm) {
+    while (pio_sm_is_rx_fifo_empty(pio, sm)) {
+        tight_loop_contents();
+    }
+    return pio_sm_get(pio, sm);
+}
+
+bool pio_sm_is_rx_fifo_full(PIO pio, uint sm) {
+    return pio->sm[sm].rx.count >= rx_depth(&pio->sm[sm]);
+}
+
+bool pio_sm_is_rx_fifo_empty(PIO pio, uint sm) {
+    return pio->sm[sm].rx.count == 0;
+}
+
+uint pio_sm_get_rx_fifo_level(PIO pio, uint sm) {
+    return pio->sm[sm].rx.count;
+}
+
+bool pio_sm_is_tx_fifo_full(PIO pio, uint sm) {
+    return pio->sm[sm].tx.count >= tx_depth(&pio->sm[sm]);
+}
+
+bool pio_sm_is_tx_fifo_empty(PIO pio, uint sm) {
+    return pio->sm[sm].tx.count == 0;
+}
+
+uint pio_sm_get_tx_fifo_level(PIO pio, uint sm) {
+    return pio->sm[sm].tx.count;
+}
+
+void pio_sm_clear_fifos(PIO pio, uint sm) {
+    sim_sm_t *s = &pio->sm[sm];
+    s->tx.count = 0;
+    s->rx.count = 0;
+    wake(s, STALL_RX, sim_now() + 1);
+}
+
+void pio_sm_drain_tx_fifo(PIO pio, uint sm) {
+    pio->sm[sm].tx.count = 0;
+}
+
+// SDK PIO API: interrupts
+
+void pio_set_irqn_source_enabled(PIO pio, uint irq_index, enum pio_interrupt_source source, bool enabled) {
+    if (enabled) {
+        pio->inte[irq_index] |= 1u << source;
+    } else {
+        pio->inte[irq_index] &= ~(1u << source);
+    }
+}
+
+void pio_set_irq0_source_enabled(PIO pio, enum pio_interrupt_source source, bool enabled) {
+    pio_set_irqn_source_enabled(pio, 0, source, enabled);
+}
+
+void pio_set_irq1_source_enabled(PIO pio, enum pio_interrupt_source source, bool enabled) {
+    pio_set_irqn_source_enabled(pio, 1, source, enabled);
+}
+
+bool pio_interrupt_get(PIO pio, uint pio_interrupt_num) {
+    return (pio->irq_flags >> pio_interrupt_num) & 1u;
+}
+
+void pio_interrupt_clear(PIO pio, uint pio_interrupt_num) {
+    pio->irq_flags &= (uint8_t)~(1u << pio_interrupt_num);
+    wake_all(pio, STALL_IRQ, sim_now() + 1);
+}
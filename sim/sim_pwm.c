@@ -0,0 +1,335 @@
+/**
+ * Host Simulator: PWM slices
+ *
+ * Counters are evaluated analytically from the time of their next increment,
+ * so a running slice costs nothing until something looks at it. Events are
+ * only produced at wraps that raise an enabled interrupt and at the edges of
+ * watched pads. A slice counting B-input edges advances from the pad's edge
+ * instead, and its B pin is an input.
+ */
+
+#include "sim.h"
+#include "hardware/pwm.h"
+#include "hardware/gpio.h"
+#include "hardware/irq.h"
+
+typedef struct {
+    bool enabled;
+    enum pwm_clkdiv_mode mode;
+    uint16_t div16;             // 8.4 fixed point divider
+    uint16_t top;               // Active TOP and CC
+    uint16_t cc[2];
+    uint16_t top_buffer;        // Written values, latched at the next wrap
+    uint16_t cc_buffer[2];
+    bool latch_pending;
+    uint16_t ctr;
+    uint64_t next16;            // Time of the next increment, in 1/16 cycles
+    uint32_t edges16;           // Edge modes: edges seen towards the next increment, in 1/16
+} sim_slice_t;
+
+static sim_slice_t slices[NUM_PWM_SLICES];
+pwm_hw_t sim_pwm_hw;
+static uint32_t pwm_intr = 0;
+static uint32_t pwm_inte = 0;
+
+static uint32_t div_sixteenths(const sim_slice_t *s) {
+    return s->div16 ? s->div16 : 4096u;
+}
+
+static uint32_t increments_to_wrap(const sim_slice_t *s) {
+    return s->ctr <= s->top ? (uint32_t)s->top - s->ctr + 1u : 65536u - s->ctr;
+}
+
+// Cycle of the k-th increment from now (k >= 1)
+static uint64_t increment_time(const sim_slice_t *s, uint64_t k) {
+    return (s->next16 + (k - 1) * div_sixteenths(s) + 15u) / 16u;
+}
+
+static bool counts_edges(const sim_slice_t *s) {
+    return s->mode == PWM_DIV_B_RISING || s->mode == PWM_DIV_B_FALLING;
+}
+
+static void wrap(uint slice_num) {
+    sim_slice_t *s = &slices[slice_num];
+    pwm_intr |= 1u << slice_num;
+    if (s->latch_pending) {
+        s->top = s->top_buffer;
+        s->cc[0] = s->cc_buffer[0];
+        s->cc[1] = s->cc_buffer[1];
+        s->latch_pending = false;
+    }
+}
+
+static void advance(uint slice_num, uint64_t now) {
+    sim_slice_t *s = &slices[slice_num];
+    if (!s->enabled || counts_edges(s) || s->next16 > now * 16u) return;
+
+    uint64_t n = (now * 16u - s->next16) / div_sixteenths(s) + 1u;
+    s->next16 += n * div_sixteenths(s);
+
+    uint64_t to_wrap = increments_to_wrap(s);
+    if (n < to_wrap) {
+        s->ctr = (uint16_t)(s->ctr + n);
+        return;
+    }
+
+    // At least one wrap: latch buffered values and raise the interrupt
+    n -= to_wrap;
+    wrap(slice_num);
+    s->ctr = (uint16_t)(n % ((uint32_t)s->top + 1u));
+}
+
+static void advance_all(void) {
+    for (uint i = 0; i < NUM_PWM_SLICES; i++) advance(i, sim_now());
+}
+
+static uint32_t slice_pad_mask(uint slice_num) {
+    uint32_t mask = 0;
+    for (uint gpio = slice_num * 2u; gpio < SIM_NUM_GPIOS; gpio += 16u) {
+        mask |= 3u << gpio;
+    }
+    return mask & ((1u << SIM_NUM_GPIOS) - 1u);
+}
+
+static void refresh_pads(uint slice_num) {
+    uint32_t mask = slice_pad_mask(slice_num);
+    for (uint gpio = 0; gpio < SIM_NUM_GPIOS; gpio++) {
+        if ((mask & (1u << gpio)) && gpio_get_function(gpio) == GPIO_FUNC_PWM) {
+            sim_gpio_refresh(gpio);
+        }
+    }
+}
+
+bool sim_pwm_pad_output(uint gpio, bool *level) {
+    uint slice_num = pwm_gpio_to_slice_num(gpio);
+    uint chan = pwm_gpio_to_channel(gpio);
+    if (chan == PWM_CHAN_B && slices[slice_num].mode != PWM_DIV_FREE_RUNNING) return false;
+    advance(slice_num, sim_now());
+    *level = slices[slice_num].ctr < slices[slice_num].cc[chan];
+    return true;
+}
+
+void sim_pwm_gpio_edge(uint gpio, bool level) {
+    if (gpio_get_function(gpio) != GPIO_FUNC_PWM || pwm_gpio_to_channel(gpio) != PWM_CHAN_B) return;
+    sim_slice_t *s = &slices[pwm_gpio_to_slice_num(gpio)];
+    if (!s->enabled || !counts_edges(s) || level != (s->mode == PWM_DIV_B_RISING)) return;
+
+    // The divider applies to edges as it does to cycles
+    s->edges16 += 16u;
+    if (s->edges16 < div_sixteenths(s)) return;
+    s->edges16 -= div_sixteenths(s);
+    if (s->ctr == s->top) {
+        s->ctr = 0;
+        wrap(pwm_gpio_to_slice_num(gpio));
+    } else {
+        s->ctr++;
+    }
+}
+
+static uint64_t slice_next_event(uint slice_num) {
+    const sim_slice_t *s = &slices[slice_num];
+    if (!s->enabled || counts_edges(s)) return SIM_NEVER;
+
+    uint64_t next = SIM_NEVER;
+    uint64_t wrap = increment_time(s, increments_to_wrap(s));
+    if ((pwm_inte & (1u << slice_num)) && !(pwm_intr & (1u << slice_num))) {
+        next = wrap;
+    }
+
+    uint32_t mask = slice_pad_mask(slice_num);
+    for (uint gpio = 0; gpio < SIM_NUM_GPIOS; gpio++) {
+        if (!(mask & (1u << gpio)) || gpio_get_function(gpio) != GPIO_FUNC_PWM || !sim_gpio_watched(gpio)) continue;
+
+        if (wrap < next) next = wrap;
+        uint16_t cc = s->cc[pwm_gpio_to_channel(gpio)];
+        if (s->ctr < cc && cc <= s->top) {
+            uint64_t fall = increment_time(s, (uint64_t)cc - s->ctr);
+            if (fall < next) next = fall;
+        }
+    }
+    return next;
+}
+
+static uint64_t pwm_next_event(void) {
+    uint64_t next = SIM_NEVER;
+    for (uint i = 0; i < NUM_PWM_SLICES; i++) {
+        uint64_t t = slice_next_event(i);
+        if (t < next) next = t;
+    }
+    return next;
+}
+
+static void pwm_run_event(uint64_t now) {
+    for (uint i = 0; i < NUM_PWM_SLICES; i++) {
+        if (slices[i].enabled) {
+            advance(i, now);
+            refresh_pads(i);
+        }
+    }
+}
+
+static bool pwm_irq_asserted(uint core) {
+    (void)core;
+    if (!pwm_inte) return false;
+    advance_all();
+    return (pwm_intr & pwm_inte) != 0;
+}
+
+static const sim_agent_t pwm_agent = {
+    .name = "pwm",
+    .next_event = pwm_next_event,
+    .run_event = pwm_run_event,
+};
+
+void sim_pwm_init(void) {
+    for (uint i = 0; i < NUM_PWM_SLICES; i++) {
+        slices[i] = (sim_slice_t){ .div16 = 16, .top = 0xffff, .top_buffer = 0xffff };
+    }
+    sim_pwm_hw.en = 0;
+    sim_register_agent(&pwm_agent);
+    sim_register_irq_source(PWM_IRQ_WRAP, pwm_irq_asserted);
+}
+
+// SDK PWM API
+
+pwm_config pwm_get_default_config(void) {
+    pwm_config c = { .div16 = 16, .top = 0xffff, .mode = PWM_DIV_FREE_RUNNING, .phase_correct = false };
+    return c;
+}
+
+void pwm_config_set_clkdiv_int_frac(pwm_config *c, uint8_t integer, uint8_t fract) {
+    c->div16 = (uint16_t)((integer << 4) | (fract & 0xfu));
+}
+
+void pwm_config_set_clkdiv_mode(pwm_config *c, enum pwm_clkdiv_mode mode) {
+    c->mode = mode;
+}
+
+void pwm_config_set_wrap(pwm_config *c, uint16_t wrap) {
+    c->top = wrap;
+}
+
+void pwm_init(uint slice_num, pwm_config *c, bool start) {
+    pwm_set_enabled(slice_num, false);
+    slices[slice_num].div16 = c->div16;
+    slices[slice_num].ctr = 0;
+    slices[slice_num].edges16 = 0;
+    pwm_set_clkdiv_mode(slice_num, c->mode);
+    pwm_set_wrap(slice_num, c->top);
+    pwm_set_both_levels(slice_num, 0, 0);
+    pwm_set_enabled(slice_num, start);
+}
+
+void pwm_set_clkdiv_int_frac(uint slice_num, uint8_t integer, uint8_t fract) {
+    sim_slice_t *s = &slices[slice_num];
+    uint64_t now = sim_now();
+    advance(slice_num, now);
+
+    // The divider takes effect immediately; an increment already due sooner
+    // than a full new divider period still happens on time
+    s->div16 = (uint16_t)((integer << 4) | (fract & 0xfu));
+    if (s->enabled && s->next16 > now * 16u + div_sixteenths(s)) {
+        s->next16 = now * 16u + div_sixteenths(s);
+    }
+}
+
+void pwm_set_clkdiv_mode(uint slice_num, enum pwm_clkdiv_mode mode) {
+    sim_slice_t *s = &slices[slice_num];
+    advance(slice_num, sim_now());
+    // PWM_DIV_B_HIGH is not modelled; such a slice counts like a free-running one
+    s->mode = mode;
+    if (s->enabled && !counts_edges(s)) s->next16 = sim_now() * 16u + div_sixteenths(s);
+    refresh_pads(slice_num);
+}
+
+void pwm_set_wrap(uint slice_num, uint16_t wrap) {
+    sim_slice_t *s = &slices[slice_num];
+    advance(slice_num, sim_now());
+    s->top_buffer = wrap;
+    if (s->enabled) {
+        s->latch_pending = true;
+    } else {
+        s->top = wrap;
+    }
+    refresh_pads(slice_num);
+}
+
+void pwm_set_chan_level(uint slice_num, uint chan, uint16_t level) {
+    sim_slice_t *s = &slices[slice_num];
+    advance(slice_num, sim_now());
+    s->cc_buffer[chan] = level;
+    if (s->enabled) {
+        s->latch_pending = true;
+    } else {
+        s->cc[chan] = level;
+    }
+    refresh_pads(slice_num);
+}
+
+void pwm_set_both_levels(uint slice_num, uint16_t level_a, uint16_t level_b) {
+    pwm_set_chan_level(slice_num, PWM_CHAN_A, level_a);
+    pwm_set_chan_level(slice_num, PWM_CHAN_B, level_b);
+}
+
+void pwm_set_gpio_level(uint gpio, uint16_t level) {
+    pwm_set_chan_level(pwm_gpio_to_slice_num(gpio), pwm_gpio_to_channel(gpio), level);
+}
+
+void pwm_set_counter(uint slice_num, uint16_t c) {
+    advance(slice_num, sim_now());
+    slices[slice_num].ctr = c;
+    refresh_pads(slice_num);
+}
+
+uint16_t pwm_get_counter(uint slice_num) {
+    advance(slice_num, sim_now());
+    return slices[slice_num].ctr;
+}
+
+void pwm_set_enabled(uint slice_num, bool enabled) {
+    sim_slice_t *s = &slices[slice_num];
+    uint64_t now = sim_now();
+
+    advance(slice_num, now);
+    if (enabled && !s->enabled) {
+        s->next16 = now * 16u + div_sixteenths(s);
+    }
+    s->enabled = enabled;
+    if (enabled) {
+        sim_pwm_hw.en |= 1u << slice_num;
+    } else {
+        sim_pwm_hw.en &= ~(1u << slice_num);
+    }
+    refresh_pads(slice_num);
+}
+
+void pwm_set_mask_enabled(uint32_t mask) {
+    for (uint i = 0; i < NUM_PWM_SLICES; i++) {
+        pwm_set_enabled(i, (mask >> i) & 1u);
+    }
+}
+
+void pwm_set_irq_enabled(uint slice_num, bool enabled) {
+    advance_all();
+    if (enabled) {
+        pwm_inte |= 1u << slice_num;
+    } else {
+        pwm_inte &= ~(1u << slice_num);
+    }
+}
+
+void pwm_set_irq_mask_enabled(uint32_t slice_mask, bool enabled) {
+    for (uint i = 0; i < NUM_PWM_SLICES; i++) {
+        if (slice_mask & (1u << i)) pwm_set_irq_enabled(i, enabled);
+    }
+}
+
+void pwm_clear_irq(uint slice_num) {
+    advance(slice_num, sim_now());
+    pwm_intr &= ~(1u << slice_num);
+}
+
+uint32_t pwm_get_irq_status_mask(void) {
+    advance_all();
+    return pwm_intr & pwm_inte;
+}
@@ -0,0 +1,75 @@
+/**
+ * Host Simulator: VCD trace of the clock, reset and power outputs
+ *
+ * Uses the firmware's trace recorder on the simulated pads, so every edge
+ * is captured at cycle resolution whichever engine (CPU, PWM or PIO)
+ * drives it. Edges are stamped in picoseconds, so the trace stays in real
+ * time when the firmware retunes the system clock.
+ */
+
+#include "sim.h"
+#include "config.h"
+#include "trace_recorder.h"
+#include <stdio.h>
+#include <stdlib.h>
+
+#define SIM_TRACE_BUFFER_SIZE (4u * 1024u * 1024u)
+
+static const uint trace_pins[] = { CLOCK_OUTPUT, RESET_OUTPUT, POWER_OUTPUT };
+static const char *const trace_names[] = { "clock", "reset", "power" };
+#define SIM_TRACE_CHANNELS (sizeof(trace_pins) / sizeof(trace_pins[0]))
+
+static trace_recorder_t recorder;
+static uint8_t *trace_buffer = NULL;
+static const char *trace_path = NULL;
+
+static void trace_edge(uint gpio, bool level, uint64_t now) {
+    for (uint i = 0; i < SIM_TRACE_CHANNELS; i++) {
+        if (trace_pins[i] == gpio) {
+            trace_recorder_edge(&recorder, (uint8_t)i, level, sim_cycles_to_ps(now));
+        }
+    }
+}
+
+static void write_file_text(void *context, const char *text) {
+    fputs(text, (FILE *)context);
+}
+
+void sim_trace_start(const char *path) {
+    uint8_t levels = 0;
+
+    trace_buffer = malloc(SIM_TRACE_BUFFER_SIZE);
+    if (!trace_buffer) {
+        perror("sim: trace buffer");
+        exit(2);
+    }
+    for (uint i = 0; i < SIM_TRACE_CHANNELS; i++) {
+        sim_gpio_watch(trace_pins[i], true);
+        levels |= (uint8_t)(sim_gpio_level(trace_pins[i]) << i);
+    }
+    trace_recorder_init(&recorder, trace_buffer, SIM_TRACE_BUFFER_SIZE, sim_cycles_to_ps(sim_now()), levels);
+    trace_path = path;
+    sim_gpio_add_edge_hook(trace_edge);
+}
+
+void sim_trace_finish(void) {
+    if (!trace_path) return;
+
+    FILE *f = fopen(trace_path, "w");
+    if (!f) {
+        perror(trace_path);
+        exit(2);
+    }
+    trace_vcd_format_t format = {
+        .names = trace_names,
+        .channel_count = SIM_TRACE_CHANNELS,
+        .tick_ps = 1,
+    };
+    trace_recorder_write_vcd(&recorder, &format, write_file_text, f);
+    fclose(f);
+
+    fprintf(sim_console, "[sim] wrote %llu edges to %s\n", (unsigned long long)trace_recorder_edges(&recorder), trace_path);
+    free(trace_buffer);
+    trace_buffer = NULL;
+    trace_path = NULL;
+}
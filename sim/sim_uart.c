@@ -0,0 +1,373 @@
+/**
+ * Host Simulator: UARTs and stdio
+ *
+ * Transmitted bytes are copied to the console only when echo is on, as
+ * they mirror the messages already printed through stdio. Injected bytes
+ * arrive one character time apart into a 32-entry receive FIFO.
+ *
+ * Firmware stdout is a stream that writes to the console and to each
+ * enabled stdio driver, like the SDK's stdio fan-out. The console stands
+ * in for USB CDC: the stdio_usb driver writes to it, and bytes typed for
+ * USB arrive at once with a USB interrupt to wake the firmware.
+ */
+
+#define _GNU_SOURCE     // fopencookie
+
+#include "sim.h"
+#include "pico/stdlib.h"
+#include "hardware/uart.h"
+#include "hardware/irq.h"
+#include "pico/stdio/driver.h"
+#include "pico/stdio_usb.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#define SIM_UART_FIFO_DEPTH 32
+#define SIM_UART_BACKLOG    4096
+
+struct uart_inst {
+    uint index;
+    uint baudrate;
+    bool fifo_enabled;
+    bool echo;
+    bool rx_irq_enabled;
+    bool tx_irq_enabled;
+    bool tx_line_start;
+    FILE *capture;
+
+    uint8_t rx_fifo[SIM_UART_FIFO_DEPTH];
+    uint rx_head;
+    uint rx_count;
+    uint32_t rx_overruns;
+
+    // Bytes still on the wire, delivered one character time apart
+    uint8_t backlog[SIM_UART_BACKLOG];
+    uint backlog_head;
+    uint backlog_count;
+    uint64_t next_arrival;
+};
+
+uart_inst_t sim_uart0_inst = { .index = 0, .baudrate = 115200, .fifo_enabled = true, .tx_line_start = true };
+uart_inst_t sim_uart1_inst = { .index = 1, .baudrate = 115200, .fifo_enabled = true, .tx_line_start = true };
+
+static uart_inst_t *const uarts[2] = { &sim_uart0_inst, &sim_uart1_inst };
+static uart_hw_t uart_hw[2];
+
+FILE *sim_console;
+static stdio_driver_t *stdio_drivers;
+
+static uint8_t usb_rx[SIM_UART_BACKLOG];
+static uint usb_rx_head;
+static uint usb_rx_count;
+static uint32_t usb_rx_overruns;
+static bool usb_irq_pending;
+
+static uint rx_depth(const uart_inst_t *uart) {
+    return uart->fifo_enabled ? SIM_UART_FIFO_DEPTH : 1u;
+}
+
+static uint64_t char_cycles(const uart_inst_t *uart) {
+    // 8N1: ten bit times per character
+    return ((uint64_t)sim_sys_hz() * 10u) / (uart->baudrate ? uart->baudrate : 1u);
+}
+
+static uint64_t uart_next_event(void) {
+    uint64_t next = SIM_NEVER;
+    for (uint i = 0; i < 2; i++) {
+        if (uarts[i]->backlog_count && uarts[i]->next_arrival < next) {
+            next = uarts[i]->next_arrival;
+        }
+    }
+    return next;
+}
+
+static void uart_run_event(uint64_t now) {
+    for (uint i = 0; i < 2; i++) {
+        uart_inst_t *uart = uarts[i];
+        while (uart->backlog_count && uart->next_arrival <= now) {
+            uint8_t c = uart->backlog[uart->backlog_head];
+            uart->backlog_head = (uart->backlog_head + 1) % SIM_UART_BACKLOG;
+            uart->backlog_count--;
+
+            if (uart->rx_count < rx_depth(uart)) {
+                uart->rx_fifo[(uart->rx_head + uart->rx_count) % SIM_UART_FIFO_DEPTH] = c;
+                uart->rx_count++;
+            } else {
+                uart->rx_overruns++;
+            }
+            uart->next_arrival += char_cycles(uart);
+        }
+    }
+}
+
+static bool uart0_irq_asserted(uint core) {
+    (void)core;
+    return (sim_uart0_inst.rx_irq_enabled && sim_uart0_inst.rx_count) || sim_uart0_inst.tx_irq_enabled;
+}
+
+static bool uart1_irq_asserted(uint core) {
+    (void)core;
+    return (sim_uart1_inst.rx_irq_enabled && sim_uart1_inst.rx_count) || sim_uart1_inst.tx_irq_enabled;
+}
+
+static bool usb_irq_asserted(uint core) {
+    (void)core;
+    return usb_irq_pending;
+}
+
+static void usb_irq(void) {
+    usb_irq_pending = false;
+}
+
+static const sim_agent_t uart_agent = {
+    .name = "uart",
+    .next_event = uart_next_event,
+    .run_event = uart_run_event,
+};
+
+static ssize_t stdout_write(void *cookie, const char *buf, size_t size) {
+    (void)cookie;
+    fwrite(buf, 1, size, sim_console);
+    for (stdio_driver_t *driver = stdio_drivers; driver; driver = driver->next) {
+        if (driver->out_chars) driver->out_chars(buf, (int)size);
+    }
+    return (ssize_t)size;
+}
+
+static void route_stdout(void) {
+    // Keep the terminal for the console and reports, then point stdout at
+    // the fan-out stream (unbuffered, as drivers see each printf at once)
+    fflush(stdout);
+    sim_console = fdopen(dup(fileno(stdout)), "w");
+    if (!sim_console) {
+        perror("sim: console");
+        exit(2);
+    }
+    setvbuf(sim_console, NULL, _IOLBF, 0);
+
+    stdout = fopencookie(NULL, "w", (cookie_io_functions_t){ .write = stdout_write });
+    if (!stdout) {
+        perror("sim: stdout");
+        exit(2);
+    }
+    setvbuf(stdout, NULL, _IONBF, 0);
+}
+
+void sim_uart_init(void) {
+    route_stdout();
+    sim_register_agent(&uart_agent);
+    sim_register_irq_source(UART0_IRQ, uart0_irq_asserted);
+    sim_register_irq_source(UART1_IRQ, uart1_irq_asserted);
+    sim_register_irq_source(USBCTRL_IRQ, usb_irq_asserted);
+}
+
+void sim_uart_inject(uint index, const char *data, uint32_t length) {
+    uart_inst_t *uart = uarts[index];
+    if (uart->backlog_count == 0) {
+        uart->next_arrival = sim_now() + char_cycles(uart);
+    }
+    for (uint32_t i = 0; i < length && uart->backlog_count < SIM_UART_BACKLOG; i++) {
+        uart->backlog[(uart->backlog_head + uart->backlog_count) % SIM_UART_BACKLOG] = (uint8_t)data[i];
+        uart->backlog_count++;
+    }
+}
+
+void sim_uart_set_echo(uint index, bool echo) {
+    uarts[index]->echo = echo;
+}
+
+void sim_uart_set_capture(uint index, FILE *file) {
+    uarts[index]->capture = file;
+}
+
+uint32_t sim_uart_overruns(uint index) {
+    return uarts[index]->rx_overruns;
+}
+
+void sim_usb_inject(const char *data, uint32_t length) {
+    for (uint32_t i = 0; i < length; i++) {
+        if (usb_rx_count == SIM_UART_BACKLOG) {
+            usb_rx_overruns++;
+            continue;
+        }
+        usb_rx[(usb_rx_head + usb_rx_count) % SIM_UART_BACKLOG] = (uint8_t)data[i];
+        usb_rx_count++;
+    }
+    usb_irq_pending = true;
+}
+
+uint32_t sim_usb_overruns(void) {
+    return usb_rx_overruns;
+}
+
+uint64_t sim_uart_char_cycles(uint index) {
+    return char_cycles(uarts[index]);
+}
+
+// SDK UART API
+
+uint uart_init(uart_inst_t *uart, uint baudrate) {
+    uart->baudrate = baudrate;
+    uart->fifo_enabled = true;
+    uart->rx_count = 0;
+    return baudrate;
+}
+
+void uart_deinit(uart_inst_t *uart) {
+    uart->rx_count = 0;
+}
+
+uint uart_set_baudrate(uart_inst_t *uart, uint baudrate) {
+    uart->baudrate = baudrate;
+    return baudrate;
+}
+
+void uart_set_format(uart_inst_t *uart, uint data_bits, uint stop_bits, uart_parity_t parity) {
+    (void)uart;
+    (void)data_bits;
+    (void)stop_bits;
+    (void)parity;
+}
+
+void uart_set_fifo_enabled(uart_inst_t *uart, bool enabled) {
+    uart->fifo_enabled = enabled;
+}
+
+void uart_set_irq_enables(uart_inst_t *uart, bool rx_has_data, bool tx_needs_data) {
+    uart->rx_irq_enabled = rx_has_data;
+    uart->tx_irq_enabled = tx_needs_data;
+}
+
+uint uart_get_index(uart_inst_t *uart) {
+    return uart->index;
+}
+
+uart_hw_t *uart_get_hw(uart_inst_t *uart) {
+    return &uart_hw[uart->index];
+}
+
+bool uart_is_writable(uart_inst_t *uart) {
+    (void)uart;
+    return true;
+}
+
+bool uart_is_readable(uart_inst_t *uart) {
+    return uart->rx_count != 0;
+}
+
+static void transmit(uart_inst_t *uart, char c) {
+    if (uart->capture) fputc(c, uart->capture);
+    if (!uart->echo) return;
+    // Prefix each line so it is told apart from stdio
+    if (uart->tx_line_start) fprintf(sim_console, "uart%u: ", uart->index);
+    fputc(c, sim_console);
+    uart->tx_line_start = c == '\n';
+}
+
+void sim_uart_transmit(uint index, uint8_t c) {
+    transmit(uarts[index], (char)c);
+}
+
+void uart_putc_raw(uart_inst_t *uart, char c) {
+    transmit(uart, c);
+}
+
+void uart_putc(uart_inst_t *uart, char c) {
+    transmit(uart, c);
+}
+
+void uart_puts(uart_inst_t *uart, const char *s) {
+    while (*s) {
+        transmit(uart, *s++);
+    }
+}
+
+void uart_write_blocking(uart_inst_t *uart, const uint8_t *src, size_t len) {
+    for (size_t i = 0; i < len; i++) {
+        uart_putc_raw(uart, (char)src[i]);
+    }
+}
+
+char uart_getc(uart_inst_t *uart) {
+    while (uart->rx_count == 0) {
+        sim_core_wait(uart_next_event(), false);
+    }
+    char c = (char)uart->rx_fifo[uart->rx_head];
+    uart->rx_head = (uart->rx_head + 1) % SIM_UART_FIFO_DEPTH;
+    uart->rx_count--;
+    return c;
+}
+
+void uart_read_blocking(uart_inst_t *uart, uint8_t *dst, size_t len) {
+    for (size_t i = 0; i < len; i++) {
+        dst[i] = (uint8_t)uart_getc(uart);
+    }
+}
+
+// stdio: output fans out to the console and enabled drivers; input
+// arrives through UART0
+
+bool stdio_init_all(void) {
+    // The USB interrupt is taken on the core that set up stdio
+    irq_set_exclusive_handler(USBCTRL_IRQ, usb_irq);
+    irq_set_enabled(USBCTRL_IRQ, true);
+    return true;
+}
+
+void stdio_set_driver_enabled(stdio_driver_t *driver, bool enabled) {
+    stdio_driver_t **link = &stdio_drivers;
+    while (*link && *link != driver) {
+        link = &(*link)->next;
+    }
+    if (enabled && !*link) {
+        driver->next = NULL;
+        *link = driver;
+    } else if (!enabled && *link) {
+        *link = driver->next;
+    }
+}
+
+void stdio_flush(void) {
+    fflush(stdout);
+    for (stdio_driver_t *driver = stdio_drivers; driver; driver = driver->next) {
+        if (driver->out_flush) driver->out_flush();
+    }
+}
+
+int getchar_timeout_us(uint32_t timeout_us) {
+    uint64_t deadline = sim_now() + sim_us_to_cycles(timeout_us);
+    while (!uart_is_readable(uart0)) {
+        if (sim_now() >= deadline) return PICO_ERROR_TIMEOUT;
+        uint64_t next = uart_next_event();
+        sim_core_wait(next < deadline ? next : deadline, false);
+    }
+    return (unsigned char)uart_getc(uart0);
+}
+
+// USB CDC
+
+static void stdio_usb_out_chars(const char *buf, int length) {
+    fwrite(buf, 1, (size_t)length, sim_console);
+}
+
+static int stdio_usb_in_chars(char *buf, int length) {
+    if (usb_rx_count == 0) return PICO_ERROR_NO_DATA;
+    int n = 0;
+    while (n < length && usb_rx_count) {
+        buf[n++] = (char)usb_rx[usb_rx_head];
+        usb_rx_head = (usb_rx_head + 1) % SIM_UART_BACKLOG;
+        usb_rx_count--;
+    }
+    return n;
+}
+
+stdio_driver_t stdio_usb = {
+    .out_chars = stdio_usb_out_chars,
+    .in_chars = stdio_usb_in_chars,
+};
+
+bool stdio_usb_connected(void) {
+    return true;
+}
@@ -0,0 +1,57 @@
+/**
+ * SPSC Queue Module for Multimode Clock Source
+ */
+
+#include "spsc_queue.h"
+
+// head and tail are free-running counters; the slot index is the counter
+// modulo the capacity. The producer publishes a slot with a release store of
+// head after filling it, and the consumer frees it with a release store of
+// tail after copying it out. Only 32-bit loads and stores are used, which are
+// atomic on both cores of the RP2040 (no exclusive-access instructions).
+
+_Static_assert((SPSC_QUEUE_CAPACITY & (SPSC_QUEUE_CAPACITY - 1)) == 0,
+               "SPSC_QUEUE_CAPACITY must be a power of two");
+
+void spsc_queue_init(spsc_queue_t *q) {
+    atomic_store_explicit(&q->head, 0, memory_order_relaxed);
+    atomic_store_explicit(&q->tail, 0, memory_order_relaxed);
+    q->dropped = 0;
+}
+
+bool spsc_queue_push(spsc_queue_t *q, const spsc_msg_t *msg) {
+    unsigned head = atomic_load_explicit(&q->head, memory_order_relaxed);
+    unsigned tail = atomic_load_explicit(&q->tail, memory_order_acquire);
+
+    if (head - tail >= SPSC_QUEUE_CAPACITY) {
+        q->dropped++;
+        return false;
+    }
+
+    q->slots[head & (SPSC_QUEUE_CAPACITY - 1)] = *msg;
+    atomic_store_explicit(&q->head, head + 1, memory_order_release);
+    return true;
+}
+
+bool spsc_queue_has_room(spsc_queue_t *q) {
+    unsigned head = atomic_load_explicit(&q->head, memory_order_relaxed);
+    unsigned tail = atomic_load_explicit(&q->tail, memory_order_acquire);
+    return head - tail < SPSC_QUEUE_CAPACITY;
+}
+
+bool spsc_queue_pop(spsc_queue_t *q, spsc_msg_t *msg) {
+    unsigned tail = atomic_load_explicit(&q->tail, memory_order_relaxed);
+    unsigned head = atomic_load_explicit(&q->head, memory_order_acquire);
+
+    if (head == tail) return false;
+
+    *msg = q->slots[tail & (SPSC_QUEUE_CAPACITY - 1)];
+    atomic_store_explicit(&q->tail, tail + 1, memory_order_release);
+    return true;
+}
+
+uint32_t spsc_queue_count(spsc_queue_t *q) {
+    unsigned head = atomic_load_explicit(&q->head, memory_order_acquire);
+    unsigned tail = atomic_load_explicit(&q->tail, memory_order_acquire);
+    return head - tail;
+}
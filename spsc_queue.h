@@ -0,0 +1,71 @@
+/**
+ * SPSC Queue Module for Multimode Clock Source
+ *
+ * Lock-free single-producer/single-consumer ring buffer of small messages,
+ * used to pass commands and telemetry between the two cores. Exactly one
+ * context may push and exactly one context may pop on a given queue.
+ */
+
+#ifndef SPSC_QUEUE_H
+#define SPSC_QUEUE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdatomic.h>
+
+// Queue capacity in messages (must be a power of two)
+#define SPSC_QUEUE_CAPACITY 32
+
+typedef struct {
+    uint8_t type;       // Message type (meaning defined by the user)
+    uint8_t aux;        // Small auxiliary value
+    uint32_t arg;       // Message argument
+} spsc_msg_t;
+
+typedef struct {
+    spsc_msg_t slots[SPSC_QUEUE_CAPACITY];
+    atomic_uint head;   // Next slot to write (written by producer only)
+    atomic_uint tail;   // Next slot to read (written by consumer only)
+    uint32_t dropped;   // Messages rejected because the queue was full
+} spsc_queue_t;
+
+/**
+ * Initialize an empty queue
+ * @param q Queue to initialize
+ */
+void spsc_queue_init(spsc_queue_t *q);
+
+/**
+ * Push a message (producer side, never blocks)
+ * @param q Queue
+ * @param msg Message to copy into the queue
+ * @return true if queued, false if the queue was full
+ */
+bool spsc_queue_push(spsc_queue_t *q, const spsc_msg_t *msg);
+
+/**
+ * Check for a free slot (producer side)
+ * Only the producer fills slots, so one found free stays free for its next
+ * push. Waiting on this instead of retrying a push keeps a wait out of the
+ * dropped count.
+ * @param q Queue
+ * @return true if a push would succeed
+ */
+bool spsc_queue_has_room(spsc_queue_t *q);
+
+/**
+ * Pop the oldest message (consumer side, never blocks)
+ * @param q Queue
+ * @param msg Receives the message
+ * @return true if a message was returned, false if the queue was empty
+ */
+bool spsc_queue_pop(spsc_queue_t *q, spsc_msg_t *msg);
+
+/**
+ * Get the number of messages waiting
+ * @param q Queue
+ * @return Messages currently queued
+ */
+uint32_t spsc_queue_count(spsc_queue_t *q);
+
+#endif // SPSC_QUEUE_H
@@ -4,90 +4,308 @@
 
 #include "status_display.h"
 #include "config.h"
+#include "uart_tx.h"
+#include "duty_cycle.h"
+#include "freq_counter.h"
+#include "discipline.h"
 #include "hardware/gpio.h"
+#include "hardware/clocks.h"
 #include <stdio.h>
+#include <string.h>
 
 // External function declarations
 extern clock_mode_t get_current_mode(void);
 extern bool get_single_step_active(void);
 extern uint32_t get_current_frequency(void);
+extern uint32_t get_current_millihz(void);
 extern bool get_uart_clock_running(void);
 extern uint32_t get_uart_set_frequency(void);
 extern bool get_uart_pwm_active(void);
+extern bool get_uart_burst_active(void);
+extern bool get_uart_sweep_active(void);
+extern uint32_t sweep_get_frequency(void);
+extern uint32_t sweep_get_step(void);
+extern uint32_t sweep_get_steps(void);
 extern bool get_clock_state(void);
 extern bool get_power_state(void);
+extern uint32_t pio_phase_get_dead_time(void);
+extern bool sys_clock_get_retune(void);
+extern uint32_t sys_clock_get_hz(void);
+extern duty_cycle_t get_clock_duty(void);
+extern void get_achieved_duty(duty_cycle_achieved_t *out);
+extern bool pio_clock_get_wait(void);
+extern uint32_t pio_clock_get_stretched_cycles(void);
+extern uint64_t get_uart_achieved_millihz(void);
 
 void status_display_init(void) {
     // No specific initialization needed for this module
 }
 
+// Duty cycle setting, and what it gives while a clock is running
+static void format_duty(char *buf, size_t size, clock_mode_t mode) {
+    duty_cycle_t duty = get_clock_duty();
+    int n = duty.kind == DUTY_CYCLE_WIDTH
+        ? snprintf(buf, size, "Duty Cycle: HIGH %lu ns", duty.value)
+        : snprintf(buf, size, "Duty Cycle: %lu.%02lu%%", duty.value / 100, duty.value % 100);
+    
+    bool running = mode == MODE_LOW_FREQ || mode == MODE_HIGH_FREQ ||
+                   (mode == MODE_UART_CONTROL && (get_uart_clock_running() || get_uart_burst_active() ||
+                                                    sweep_get_steps() > 0));
+    if (running && n > 0 && (size_t)n < size) {
+        duty_cycle_achieved_t achieved;
+        get_achieved_duty(&achieved);
+        n += snprintf(buf + n, size - (size_t)n, " (achieved %lu.%02lu%%, HIGH %lu ns)",
+                      achieved.ratio / 100, achieved.ratio % 100, achieved.width_ns);
+    }
+    if (n > 0 && (size_t)n < size - 1) {
+        buf[n] = '\n';
+        buf[n + 1] = '\0';
+    }
+}
+
+// Frequency the clock is running at, for checking the loopback (0 if none)
+static uint64_t output_millihz(clock_mode_t mode) {
+    if (mode == MODE_UART_CONTROL) {
+        if (get_uart_clock_running()) return get_uart_achieved_millihz();
+        return (uint64_t)sweep_get_frequency() * 1000u;
+    }
+    return mode == MODE_LOW_FREQ || mode == MODE_HIGH_FREQ ? get_current_millihz() : 0;
+}
+
+// Latest frequency counter reading, without a line end
+static void format_count(char *buf, size_t size) {
+    freq_counter_reading_t reading;
+    bool have = freq_counter_get_reading(&reading);
+    char where[16];
+    if (reading.input == FREQ_COUNTER_LOOPBACK) {
+        snprintf(where, sizeof(where), "loopback");
+    } else {
+        snprintf(where, sizeof(where), "GPIO %d", FREQ_COUNTER_INPUT);
+    }
+    
+    if (!have) {
+        snprintf(buf, size, "%s, measuring", where);
+        return;
+    }
+    if (!reading.signal) {
+        snprintf(buf, size, "%s, no signal", where);
+        return;
+    }
+    int n = snprintf(buf, size, "%s, %llu.%03llu Hz (%s, gate %lu.%03lu ms, resolution %lu.%03lu ppm)", where,
+                     reading.millihz / 1000, reading.millihz % 1000,
+                     reading.engine == FREQ_ENGINE_GATED ? "gated" : "reciprocal",
+                     reading.gate_us / 1000, reading.gate_us % 1000,
+                     reading.resolution_ppb / 1000, reading.resolution_ppb % 1000);
+    
+    uint64_t expected = output_millihz(get_current_mode());
+    if (reading.input != FREQ_COUNTER_LOOPBACK || expected == 0 || n <= 0 || (size_t)n >= size) return;
+    if (expected > (uint64_t)(clock_get_hz(clk_sys) / FREQ_COUNTER_RECIPROCAL_DIVISOR) * 1000u) {
+        snprintf(buf + n, size - (size_t)n, ", clock above loopback range: wire GPIO %d to GPIO %d",
+                 CLOCK_OUTPUT, FREQ_COUNTER_INPUT);
+        return;
+    }
+    // Below 1 kHz a millihertz is more than a ppm; both figures are rounded to one
+    int64_t diff = (int64_t)reading.millihz - (int64_t)expected;
+    if (expected < 1000000u && diff >= -1 && diff <= 1) {
+        snprintf(buf + n, size - (size_t)n, ", error within 1 mHz");
+        return;
+    }
+    int64_t ppb = (int64_t)((double)diff * 1e9 / (double)expected);
+    uint64_t abs_ppb = ppb < 0 ? (uint64_t)-ppb : (uint64_t)ppb;
+    snprintf(buf + n, size - (size_t)n, ", error %c%llu.%03llu ppm", ppb < 0 ? '-' : '+',
+             abs_ppb / 1000, abs_ppb % 1000);
+}
+
+// Signed parts per billion as ppm to three places
+static void format_ppb(char *buf, size_t size, int32_t ppb) {
+    uint32_t abs_ppb = ppb < 0 ? (uint32_t)-(int64_t)ppb : (uint32_t)ppb;
+    snprintf(buf, size, "%c%lu.%03lu ppm", ppb < 0 ? '-' : '+', abs_ppb / 1000, abs_ppb % 1000);
+}
+
+// Reference discipline state, without a line end
+static void format_reference(char *buf, size_t size) {
+    discipline_status_t status;
+    discipline_get_status(&status);
+    if (status.state == DISCIPLINE_OFF) {
+        snprintf(buf, size, "off");
+        return;
+    }
+    
+    // The crystal offset, and the system clock the engines solve against for it
+    char trim[40];
+    int t = snprintf(trim, sizeof(trim), "crystal ");
+    format_ppb(trim + t, sizeof(trim) - (size_t)t, status.trim_ppb);
+    t = (int)strlen(trim);
+    snprintf(trim + t, sizeof(trim) - (size_t)t, " (%lu Hz)", sys_clock_get_hz());
+    int n = snprintf(buf, size, "GPIO %d, %lu Hz, ", REFERENCE_INPUT, status.ref_hz);
+    if (n <= 0 || (size_t)n >= size) return;
+    switch (status.state) {
+        case DISCIPLINE_NO_REFERENCE:
+            snprintf(buf + n, size - (size_t)n, "no reference");
+            break;
+            
+        case DISCIPLINE_ACQUIRING:
+        case DISCIPLINE_LOCKED: {
+            uint32_t abs_ns = status.phase_ns < 0 ? (uint32_t)-(int64_t)status.phase_ns : (uint32_t)status.phase_ns;
+            snprintf(buf + n, size - (size_t)n, "%s, %s, phase %c%lu ns",
+                     status.state == DISCIPLINE_LOCKED ? "locked" : "acquiring", trim,
+                     status.phase_ns < 0 ? '-' : '+', abs_ns);
+            break;
+        }
+            
+        case DISCIPLINE_HOLDOVER:
+            snprintf(buf + n, size - (size_t)n, "reference lost, holding %s", trim);
+            break;
+            
+        case DISCIPLINE_MISMATCH:
+            snprintf(buf + n, size - (size_t)n, "not a %lu Hz reference, check the frequency set", status.ref_hz);
+            break;
+            
+        default:
+            break;
+    }
+}
+
+void print_discipline_state(void) {
+    char ref_str[128];
+    format_reference(ref_str, sizeof(ref_str));
+    printf("Reference: %s\n", ref_str);
+    uart_tx_puts(uart1, "Reference: ");
+    uart_tx_puts(uart1, ref_str);
+    uart_tx_puts(uart1, "\n");
+}
+
+void print_count_reading(uint32_t sequence) {
+    freq_counter_reading_t reading;
+    if (!freq_counter_get_reading(&reading) || reading.sequence != sequence) return;
+    
+    char count_str[160];
+    format_count(count_str, sizeof(count_str));
+    printf("Count: %s\n", count_str);
+    uart_tx_puts(uart1, "Count: ");
+    uart_tx_puts(uart1, count_str);
+    uart_tx_puts(uart1, "\n");
+}
+
 void print_status_to_uart1(void) {
     const char* status_header = "\n=== Clock Source Status ===\n";
     const char* status_footer = "===========================\n\n";
     
     // Send header
-    uart_puts(uart1, status_header);
+    uart_tx_puts(uart1, status_header);
     
     clock_mode_t current_mode = get_current_mode();
     
     switch (current_mode) {
         case MODE_SINGLE_STEP:
-            uart_puts(uart1, "Mode: Single Step\n");
+            uart_tx_puts(uart1, "Mode: Single Step\n");
             if (get_single_step_active()) {
-                uart_puts(uart1, "Status: Active\n");
+                uart_tx_puts(uart1, "Status: Active\n");
             } else {
-                uart_puts(uart1, "Status: Waiting for button press\n");
+                uart_tx_puts(uart1, "Status: Waiting for button press\n");
             }
             break;
             
         case MODE_LOW_FREQ:
-            uart_puts(uart1, "Mode: Low Frequency\n");
+            uart_tx_puts(uart1, "Mode: Low Frequency\n");
             // Format frequency string
             char freq_str[32];
-            snprintf(freq_str, sizeof(freq_str), "Frequency: %lu Hz\n", get_current_frequency());
-            uart_puts(uart1, freq_str);
+            snprintf(freq_str, sizeof(freq_str), "Frequency: %lu.%03lu Hz\n",
+                     get_current_millihz() / 1000, get_current_millihz() % 1000);
+            uart_tx_puts(uart1, freq_str);
             break;
             
         case MODE_HIGH_FREQ:
-            uart_puts(uart1, "Mode: High Frequency\n");
+            uart_tx_puts(uart1, "Mode: High Frequency\n");
             char hfreq_str[32];
-            snprintf(hfreq_str, sizeof(hfreq_str), "Frequency: %lu Hz (1MHz)\n", get_current_frequency());
-            uart_puts(uart1, hfreq_str);
+            snprintf(hfreq_str, sizeof(hfreq_str), "Frequency: %lu Hz\n", get_current_frequency());
+            uart_tx_puts(uart1, hfreq_str);
             break;
             
         case MODE_UART_CONTROL:
-            uart_puts(uart1, "Mode: UART Control\n");
+            uart_tx_puts(uart1, "Mode: UART Control\n");
             if (get_uart_clock_running() && get_uart_set_frequency() > 0) {
                 char ufreq_str[32];
                 snprintf(ufreq_str, sizeof(ufreq_str), "Frequency: %lu Hz\n", get_uart_set_frequency());
-                uart_puts(uart1, ufreq_str);
-                uart_puts(uart1, "Status: Running\n");
+                uart_tx_puts(uart1, ufreq_str);
+                uart_tx_puts(uart1, "Status: Running\n");
+            } else if (get_uart_burst_active()) {
+                uart_tx_puts(uart1, "Status: Burst\n");
+            } else if (sweep_get_steps() > 0) {
+                char sweep_str[48];
+                snprintf(sweep_str, sizeof(sweep_str), "Frequency: %lu Hz\n", sweep_get_frequency());
+                uart_tx_puts(uart1, sweep_str);
+                if (get_uart_sweep_active()) {
+                    snprintf(sweep_str, sizeof(sweep_str), "Status: Sweep step %lu of %lu\n",
+                             sweep_get_step() + 1, sweep_get_steps());
+                } else {
+                    snprintf(sweep_str, sizeof(sweep_str), "Status: Sweep done, holding\n");
+                }
+                uart_tx_puts(uart1, sweep_str);
             } else {
-                uart_puts(uart1, "Status: Stopped\n");
+                uart_tx_puts(uart1, "Status: Stopped\n");
             }
             break;
     }
     
     // Clock state
     if (current_mode == MODE_UART_CONTROL && get_uart_pwm_active()) {
-        uart_puts(uart1, "Clock State: PWM Active\n");
+        uart_tx_puts(uart1, "Clock State: PWM Active\n");
     } else if (current_mode == MODE_HIGH_FREQ) {
-        uart_puts(uart1, "Clock State: PWM Active\n");
+        uart_tx_puts(uart1, "Clock State: PWM Active\n");
     } else if (get_clock_state()) {
-        uart_puts(uart1, "Clock State: HIGH\n");
+        uart_tx_puts(uart1, "Clock State: HIGH\n");
     } else {
-        uart_puts(uart1, "Clock State: LOW\n");
+        uart_tx_puts(uart1, "Clock State: LOW\n");
     }
     
     // Power state
     if (get_power_state()) {
-        uart_puts(uart1, "Power State: ON\n");
+        uart_tx_puts(uart1, "Power State: ON\n");
     } else {
-        uart_puts(uart1, "Power State: OFF\n");
+        uart_tx_puts(uart1, "Power State: OFF\n");
+    }
+    
+    char duty_str[80];
+    format_duty(duty_str, sizeof(duty_str), current_mode);
+    uart_tx_puts(uart1, duty_str);
+    
+    char dead_str[40];
+    snprintf(dead_str, sizeof(dead_str), "Phase Dead Time: %lu ticks\n", pio_phase_get_dead_time());
+    uart_tx_puts(uart1, dead_str);
+    
+    char sys_str[48];
+    snprintf(sys_str, sizeof(sys_str), "System Clock: %lu kHz (retune %s)\n",
+             clock_get_hz(clk_sys) / 1000, sys_clock_get_retune() ? "on" : "off");
+    uart_tx_puts(uart1, sys_str);
+    
+    if (pio_clock_get_wait() || pio_clock_get_stretched_cycles() > 0) {
+        char wait_str[56];
+        snprintf(wait_str, sizeof(wait_str), "WAIT Input: %s, %lu cycles stretched\n",
+                 pio_clock_get_wait() ? "on" : "off", pio_clock_get_stretched_cycles());
+        uart_tx_puts(uart1, wait_str);
+    }
+    
+    if (freq_counter_get_input() != FREQ_COUNTER_OFF) {
+        char count_str[160];
+        format_count(count_str, sizeof(count_str));
+        uart_tx_puts(uart1, "Frequency Counter: ");
+        uart_tx_puts(uart1, count_str);
+        uart_tx_puts(uart1, "\n");
+    }
+    
+    discipline_status_t reference;
+    discipline_get_status(&reference);
+    if (reference.state != DISCIPLINE_OFF) {
+        char ref_str[128];
+        format_reference(ref_str, sizeof(ref_str));
+        uart_tx_puts(uart1, "Reference: ");
+        uart_tx_puts(uart1, ref_str);
+        uart_tx_puts(uart1, "\n");
     }
     
     // Send footer
-    uart_puts(uart1, status_footer);
+    uart_tx_puts(uart1, status_footer);
 }
 
 void print_status(void) {
@@ -103,12 +321,12 @@ void print_status(void) {
             
         case MODE_LOW_FREQ:
             printf("Mode: Low Frequency\n");
-            printf("Frequency: %lu Hz\n", get_current_frequency());
+            printf("Frequency: %lu.%03lu Hz\n", get_current_millihz() / 1000, get_current_millihz() % 1000);
             break;
             
         case MODE_HIGH_FREQ:
             printf("Mode: High Frequency\n");
-            printf("Frequency: %lu Hz (1MHz)\n", get_current_frequency());
+            printf("Frequency: %lu Hz\n", get_current_frequency());
             break;
             
         case MODE_UART_CONTROL:
@@ -116,6 +334,15 @@ void print_status(void) {
             if (get_uart_clock_running() && get_uart_set_frequency() > 0) {
                 printf("Frequency: %lu Hz\n", get_uart_set_frequency());
                 printf("Status: Running\n");
+            } else if (get_uart_burst_active()) {
+                printf("Status: Burst\n");
+            } else if (sweep_get_steps() > 0) {
+                printf("Frequency: %lu Hz\n", sweep_get_frequency());
+                if (get_uart_sweep_active()) {
+                    printf("Status: Sweep step %lu of %lu\n", sweep_get_step() + 1, sweep_get_steps());
+                } else {
+                    printf("Status: Sweep done, holding\n");
+                }
             } else {
                 printf("Status: Stopped\n");
             }
@@ -127,6 +354,30 @@ void print_status(void) {
            (current_mode == MODE_HIGH_FREQ) ? "PWM Active" :
            (get_clock_state() ? "HIGH" : "LOW"));
     printf("Power State: %s\n", get_power_state() ? "ON" : "OFF");
+    char duty_str[80];
+    format_duty(duty_str, sizeof(duty_str), current_mode);
+    printf("%s", duty_str);
+    printf("Phase Dead Time: %lu ticks\n", pio_phase_get_dead_time());
+    printf("System Clock: %lu kHz (retune %s)\n", clock_get_hz(clk_sys) / 1000, sys_clock_get_retune() ? "on" : "off");
+    if (pio_clock_get_wait() || pio_clock_get_stretched_cycles() > 0) {
+        printf("WAIT Input: %s, %lu cycles stretched\n", pio_clock_get_wait() ? "on" : "off",
+               pio_clock_get_stretched_cycles());
+    }
+    if (freq_counter_get_input() != FREQ_COUNTER_OFF) {
+        char count_str[160];
+        format_count(count_str, sizeof(count_str));
+        printf("Frequency Counter: %s\n", count_str);
+    }
+    discipline_status_t reference;
+    discipline_get_status(&reference);
+    if (reference.state != DISCIPLINE_OFF) {
+        char ref_str[128];
+        format_reference(ref_str, sizeof(ref_str));
+        printf("Reference: %s\n", ref_str);
+    }
+    if (uart_tx_dropped(uart0) || uart_tx_dropped(uart1)) {
+        printf("UART Dropped: %lu / %lu bytes\n", uart_tx_dropped(uart0), uart_tx_dropped(uart1));
+    }
     printf("===========================\n\n");
     
     // Also send status to second UART
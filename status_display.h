@@ -27,6 +27,20 @@ void print_status(void);
  */
 void print_status_to_uart1(void);
 
+/**
+ * Print a frequency counter reading to USB CDC and the secondary UART
+ * Loopback readings are compared with the frequency the clock is set to.
+ * @param sequence Reading to print; nothing is printed if a later one has
+ *                 replaced it (that one is printed in turn)
+ */
+void print_count_reading(uint32_t sequence);
+
+/**
+ * Print the reference discipline state to USB CDC and the secondary UART
+ * Called when the lock changes; prints the latest state.
+ */
+void print_discipline_state(void);
+
 /**
  * Update mode LEDs based on current mode
  */
@@ -0,0 +1,228 @@
+/**
+ * Sweep Module for Multimode Clock Source
+ */
+
+#include "sweep.h"
+#include "config.h"
+#include "clock_core.h"
+#include "clock_cache.h"
+#include "clock_generator.h"
+#include "pio_clock.h"
+#include "pwm_clock.h"
+#include "pwm_solver.h"
+#include "sys_clock.h"
+#include "hardware/gpio.h"
+#include "hardware/irq.h"
+#include "hardware/clocks.h"
+
+// One precomputed step: PWM slice settings, or a PIO period and HIGH time
+typedef struct {
+    uint32_t frequency;             // Requested frequency in Hz
+    union {
+        struct {
+            uint16_t div16;         // Divider in 1/16 steps (8.4 fixed point)
+            uint16_t wrap;
+            uint16_t level;
+        } pwm;
+        struct {
+            uint32_t period;        // System clock cycles
+            uint32_t high;
+        } pio;
+    };
+} sweep_step_t;
+
+// Sweep state (owned by core1, read by core0)
+static sweep_step_t steps[SWEEP_MAX_STEPS];
+static volatile uint32_t step_count = 0;
+static volatile uint32_t step_index = 0;
+static volatile sweep_state_t sweep_state = SWEEP_IDLE;
+static volatile sweep_engine_t sweep_engine = SWEEP_ENGINE_NONE;
+static uint64_t sweep_start_us = 0;
+static uint32_t sweep_dwell_us = 0;
+
+// Set by the fault interrupt; the step it interrupted is the one reported
+static volatile bool fault_pending = false;
+static volatile uint32_t fault_step = 0;
+
+static void sweep_fault_irq(void) {
+    uint32_t events = gpio_get_irq_event_mask(SWEEP_FAULT_INPUT) & GPIO_IRQ_EDGE_FALL;
+    if (!events) return;
+    gpio_acknowledge_irq(SWEEP_FAULT_INPUT, events);
+
+    // Freeze the sweep at once; the engine is stopped from the main loop
+    if (sweep_state == SWEEP_RUNNING && !fault_pending) {
+        fault_step = step_index;
+        fault_pending = true;
+    }
+}
+
+void sweep_init(void) {
+    step_count = 0;
+    step_index = 0;
+    sweep_state = SWEEP_IDLE;
+    sweep_engine = SWEEP_ENGINE_NONE;
+    fault_pending = false;
+
+    // Active LOW with a pull-up, so an open-drain fault line can share it
+    gpio_init(SWEEP_FAULT_INPUT);
+    gpio_set_dir(SWEEP_FAULT_INPUT, GPIO_IN);
+    gpio_pull_up(SWEEP_FAULT_INPUT);
+    gpio_add_raw_irq_handler_masked(1u << SWEEP_FAULT_INPUT, sweep_fault_irq);
+    gpio_set_irq_enabled(SWEEP_FAULT_INPUT, GPIO_IRQ_EDGE_FALL, true);
+    irq_set_enabled(IO_IRQ_BANK0, true);
+}
+
+sweep_engine_t sweep_engine_for(uint32_t sys_hz, uint32_t from, uint32_t to) {
+    uint32_t low = from < to ? from : to;
+    uint32_t high = from < to ? to : from;
+    pwm_solution_t solution;
+
+    // Switching engines mid-sweep would break phase, so one must cover both;
+    // only the PIO engine can hold the clock for WAIT
+    if (!pio_clock_get_wait() && pwm_solve(sys_hz, low, &solution) && pwm_solve(sys_hz, high, &solution)) {
+        return SWEEP_ENGINE_PWM;
+    }
+    if (low >= 1 && high <= sys_hz / PIO_CLOCK_PERIOD_MIN) {
+        return SWEEP_ENGINE_PIO;
+    }
+    return SWEEP_ENGINE_NONE;
+}
+
+static void apply_step(uint32_t index) {
+    const sweep_step_t *step = &steps[index];
+    step_index = index;
+
+    if (sweep_engine == SWEEP_ENGINE_PWM) {
+        // Retuned from the wrap interrupt once running
+        pwm_solution_t solution = {
+            .div_int = (uint8_t)(step->pwm.div16 >> 4),
+            .div_frac = (uint8_t)(step->pwm.div16 & 0xF),
+            .wrap = step->pwm.wrap,
+            .level = step->pwm.level,
+        };
+        pwm_clock_start(&solution);
+    } else {
+        // Picked up at the next falling edge
+        pio_clock_set_period(step->pio.period, step->pio.high);
+    }
+}
+
+bool sweep_start(const sweep_plan_t *plan, uint32_t dwell_us) {
+    uint32_t sys_hz = sys_clock_get_hz();
+    sweep_engine_t engine = sweep_engine_for(sys_hz, plan->from, plan->to);
+    if (engine == SWEEP_ENGINE_NONE || plan->steps < 2 || plan->steps > SWEEP_MAX_STEPS) return false;
+
+    // Solve every step now so that stepping is only register writes. The
+    // duty cycle reported is the first step's; later ones differ only by
+    // rounding
+    duty_cycle_achieved_t first_duty;
+    for (uint32_t i = 0; i < plan->steps; i++) {
+        duty_cycle_achieved_t achieved;
+        sweep_step_t *step = &steps[i];
+        step->frequency = sweep_plan_frequency(plan, i);
+        if (engine == SWEEP_ENGINE_PWM) {
+            pwm_solution_t solution;
+            if (!clock_cache_lookup_pwm(step->frequency, &solution)) {
+                pwm_solve(sys_hz, step->frequency, &solution);
+            }
+            clock_duty_pwm(&solution, &achieved);
+            step->pwm.div16 = (uint16_t)((solution.div_int << 4) | solution.div_frac);
+            step->pwm.wrap = solution.wrap;
+            step->pwm.level = solution.level;
+        } else {
+            step->pio.period = pio_clock_period(sys_hz, step->frequency);
+            step->pio.high = clock_duty_split(step->pio.period, PIO_CLOCK_HIGH_OVERHEAD, PIO_CLOCK_LOW_OVERHEAD,
+                                              sys_hz, 1, &achieved);
+        }
+        if (i == 0) first_duty = achieved;
+    }
+
+    step_count = plan->steps;
+    sweep_engine = engine;
+    sweep_dwell_us = dwell_us;
+    fault_pending = false;
+    sweep_state = SWEEP_RUNNING;
+    apply_step(0);
+    set_achieved_duty(&first_duty);
+    if (engine == SWEEP_ENGINE_PWM) {
+        gpio_put(LED_CLOCK_ACTIVITY, 1);
+    }
+    sweep_start_us = time_us_64();
+
+    // A fault already asserted stops the sweep before it gets anywhere
+    if (!gpio_get(SWEEP_FAULT_INPUT)) {
+        fault_step = 0;
+        fault_pending = true;
+    }
+    return true;
+}
+
+static void stop_engine(void) {
+    if (sweep_engine == SWEEP_ENGINE_PWM) {
+        // Stops at a LOW level and returns the GPIO to SIO
+        pwm_clock_stop();
+        gpio_put(LED_CLOCK_ACTIVITY, 0);
+    } else {
+        pio_clock_stop();
+    }
+    sweep_state = SWEEP_IDLE;
+    sweep_engine = SWEEP_ENGINE_NONE;
+}
+
+void sweep_update(void) {
+    if (sweep_state != SWEEP_RUNNING) return;
+
+    if (fault_pending) {
+        uint32_t frequency = steps[fault_step].frequency;
+        stop_engine();
+        clock_core_telemetry(CORE_TLM_SWEEP_ABORTED, SWEEP_ABORT_FAULT, frequency);
+        return;
+    }
+
+    // Steps are timed from the start, so late wakeups never add up; a step
+    // whose time has already passed is skipped
+    uint64_t due = (time_us_64() - sweep_start_us) / (sweep_dwell_us ? sweep_dwell_us : 1);
+    if (due >= step_count) {
+        sweep_state = SWEEP_HOLDING;
+        clock_core_telemetry(CORE_TLM_SWEEP_COMPLETE, 0, steps[step_count - 1].frequency);
+    } else if (due > step_index) {
+        apply_step((uint32_t)due);
+    }
+}
+
+bool sweep_next_deadline(uint64_t *deadline_us) {
+    if (sweep_state != SWEEP_RUNNING) return false;
+    *deadline_us = sweep_start_us + (uint64_t)(step_index + 1) * sweep_dwell_us;
+    return true;
+}
+
+void sweep_stop(void) {
+    if (sweep_state == SWEEP_IDLE) return;
+
+    bool running = sweep_state == SWEEP_RUNNING;
+    uint32_t frequency = steps[step_index].frequency;
+    stop_engine();
+    if (running) {
+        clock_core_telemetry(CORE_TLM_SWEEP_ABORTED, SWEEP_ABORT_COMMAND, frequency);
+    }
+}
+
+sweep_state_t sweep_get_state(void) {
+    return sweep_state;
+}
+
+sweep_engine_t sweep_get_engine(void) {
+    return sweep_engine;
+}
+
+uint32_t sweep_get_frequency(void) {
+    return sweep_state == SWEEP_IDLE ? 0 : steps[step_index].frequency;
+}
+
+uint32_t sweep_get_step(void) {
+    return step_index;
+}
+
+uint32_t sweep_get_steps(void) {
+    return sweep_state == SWEEP_IDLE ? 0 : step_count;
+}
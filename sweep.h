@@ -0,0 +1,116 @@
+/**
+ * Sweep Module for Multimode Clock Source
+ *
+ * This module ramps the clock from one frequency to another in steps of a
+ * fixed dwell, for finding the fastest clock a target still runs at. Every
+ * step is solved into engine settings before the first one runs, so a step
+ * only hands precomputed values to an engine, which retunes at its next
+ * cycle boundary without breaking phase. A sweep stays on one engine: the
+ * PWM slice when it covers both limits and WAIT is off, otherwise the PIO
+ * engine.
+ *
+ * SWEEP_FAULT_INPUT going LOW aborts a running sweep and stops the clock;
+ * the frequency of the step that was running is reported. A sweep that
+ * runs to the end holds its last frequency until the next clock command.
+ *
+ * The sweep runs on core1 (see clock_core.h), stepped from its timers.
+ */
+
+#ifndef SWEEP_H
+#define SWEEP_H
+
+#include "pico/stdlib.h"
+#include "sweep_plan.h"
+
+typedef enum {
+    SWEEP_IDLE,
+    SWEEP_RUNNING,          // Stepping
+    SWEEP_HOLDING           // Finished, the clock stays at the last step
+} sweep_state_t;
+
+typedef enum {
+    SWEEP_ENGINE_NONE,      // The limits need both engines
+    SWEEP_ENGINE_PWM,
+    SWEEP_ENGINE_PIO
+} sweep_engine_t;
+
+typedef enum {
+    SWEEP_ABORT_COMMAND,    // Another clock command
+    SWEEP_ABORT_FAULT       // SWEEP_FAULT_INPUT went LOW
+} sweep_abort_t;
+
+/**
+ * Initialize the sweep engine and its fault input (core1)
+ * The fault interrupt is taken on the calling core.
+ */
+void sweep_init(void);
+
+/**
+ * Choose the engine a sweep runs on
+ * @param sys_hz System clock frequency in Hz
+ * @param from First frequency in Hz
+ * @param to Last frequency in Hz
+ * @return SWEEP_ENGINE_PWM, SWEEP_ENGINE_PIO, or SWEEP_ENGINE_NONE if no
+ *         one engine reaches both
+ */
+sweep_engine_t sweep_engine_for(uint32_t sys_hz, uint32_t from, uint32_t to);
+
+/**
+ * Build the step table and start the first step (core1)
+ * The clock must be stopped; the duty cycle setting applies to every step.
+ * @param plan Sweep plan (plan->steps at most SWEEP_MAX_STEPS)
+ * @param dwell_us Time each step runs for in microseconds
+ * @return false if no one engine reaches both limits
+ */
+bool sweep_start(const sweep_plan_t *plan, uint32_t dwell_us);
+
+/**
+ * Move to the step due now, and act on a fault (core1, call from the main loop)
+ * Reports completion or a fault abort as telemetry.
+ */
+void sweep_update(void);
+
+/**
+ * Get the time sweep_update() next has work
+ * @param deadline_us Receives the time in microseconds since boot
+ * @return true while a sweep is running
+ */
+bool sweep_next_deadline(uint64_t *deadline_us);
+
+/**
+ * End a running or holding sweep and stop its engine (core1)
+ * A sweep still running is reported as aborted by a command.
+ */
+void sweep_stop(void);
+
+/**
+ * Get sweep state
+ * @return SWEEP_IDLE, SWEEP_RUNNING or SWEEP_HOLDING
+ */
+sweep_state_t sweep_get_state(void);
+
+/**
+ * Get the engine the sweep runs on
+ * @return Engine, SWEEP_ENGINE_NONE when idle
+ */
+sweep_engine_t sweep_get_engine(void);
+
+/**
+ * Get the frequency of the current step
+ * @return Frequency in Hz (0 when idle)
+ */
+uint32_t sweep_get_frequency(void);
+
+/**
+ * Get the current step
+ * @return Step index, from 0
+ */
+uint32_t sweep_get_step(void);
+
+/**
+ * Get the number of steps in the sweep
+ * @return Steps (0 when idle)
+ */
+uint32_t sweep_get_steps(void);
+
+#endif // SWEEP_H
@@ -0,0 +1,36 @@
+/**
+ * Sweep Plan Module for Multimode Clock Source
+ */
+
+#include "sweep_plan.h"
+#include <math.h>
+
+uint32_t sweep_plan_steps(uint32_t duration_ms, uint32_t dwell_ms, uint32_t max_steps) {
+    uint32_t steps = dwell_ms ? duration_ms / dwell_ms : max_steps;
+    if (steps < 2) steps = 2;
+    if (steps > max_steps) steps = max_steps;
+    return steps;
+}
+
+uint32_t sweep_plan_dwell_us(uint32_t duration_ms, uint32_t steps) {
+    return (uint32_t)(((uint64_t)duration_ms * 1000u) / (steps ? steps : 1));
+}
+
+uint32_t sweep_plan_frequency(const sweep_plan_t *plan, uint32_t step) {
+    uint32_t last = plan->steps - 1;
+    if (step >= last) return plan->to;
+    if (step == 0) return plan->from;
+
+    uint64_t f;
+    if (plan->shape == SWEEP_LOG) {
+        // The table is built once before the sweep starts, so the
+        // floating point cost is not paid per step
+        double ratio = (double)plan->to / (double)plan->from;
+        f = (uint64_t)llround((double)plan->from * pow(ratio, (double)step / (double)last));
+    } else if (plan->to >= plan->from) {
+        f = plan->from + ((uint64_t)(plan->to - plan->from) * step + last / 2) / last;
+    } else {
+        f = plan->from - ((uint64_t)(plan->from - plan->to) * step + last / 2) / last;
+    }
+    return f ? (uint32_t)f : 1;
+}
@@ -0,0 +1,55 @@
+/**
+ * Sweep Plan Module for Multimode Clock Source
+ *
+ * This module lays out a frequency sweep: how many steps a duration holds
+ * at a given dwell, and the frequency of each step on a linear or
+ * logarithmic ramp between two limits. It is a pure computation with no
+ * hardware access so it can run anywhere.
+ */
+
+#ifndef SWEEP_PLAN_H
+#define SWEEP_PLAN_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+typedef enum {
+    SWEEP_LINEAR,           // Same frequency difference between steps
+    SWEEP_LOG               // Same frequency ratio between steps
+} sweep_shape_t;
+
+typedef struct {
+    sweep_shape_t shape;
+    uint32_t from;          // First step in Hz
+    uint32_t to;            // Last step in Hz
+    uint32_t steps;         // Number of steps, at least 2
+} sweep_plan_t;
+
+/**
+ * Get the number of steps a sweep takes
+ * The dwell is stretched where the duration would need more than max_steps.
+ * @param duration_ms Sweep duration in milliseconds
+ * @param dwell_ms Time requested for each step in milliseconds (at least 1)
+ * @param max_steps Largest number of steps (at least 2)
+ * @return Steps, from 2 to max_steps
+ */
+uint32_t sweep_plan_steps(uint32_t duration_ms, uint32_t dwell_ms, uint32_t max_steps);
+
+/**
+ * Get the time each step runs for
+ * @param duration_ms Sweep duration in milliseconds
+ * @param steps Steps as returned by sweep_plan_steps()
+ * @return Dwell in microseconds, so that the steps fill the duration
+ */
+uint32_t sweep_plan_dwell_us(uint32_t duration_ms, uint32_t steps);
+
+/**
+ * Get the frequency of one step
+ * The first step is plan->from and the last exactly plan->to.
+ * @param plan Sweep plan
+ * @param step Step index (0 to plan->steps - 1)
+ * @return Frequency in Hz (at least 1)
+ */
+uint32_t sweep_plan_frequency(const sweep_plan_t *plan, uint32_t step);
+
+#endif // SWEEP_PLAN_H
@@ -0,0 +1,129 @@
+/**
+ * System Clock Module for Multimode Clock Source
+ */
+
+#include "sys_clock.h"
+#include "config.h"
+#include "pwm_solver.h"
+#include "clock_core.h"
+#include "hardware/clocks.h"
+#include "hardware/pll.h"
+
+_Static_assert(SYS_CLOCK_MIN_KHZ <= SYS_CLOCK_NOMINAL_KHZ && SYS_CLOCK_NOMINAL_KHZ <= SYS_CLOCK_MAX_KHZ,
+               "SYS_CLOCK_NOMINAL_KHZ must lie between SYS_CLOCK_MIN_KHZ and SYS_CLOCK_MAX_KHZ");
+
+static volatile bool retune_enabled = false;
+static volatile int32_t trim_ppb = 0;
+
+void sys_clock_init(void) {
+    // The USB PLL also clocks USB and the ADC and is never reprogrammed, so
+    // baud rates set from here on hold at any system clock
+    uint32_t usb_hz = clock_get_hz(clk_usb);
+    clock_configure(clk_peri, 0, CLOCKS_CLK_PERI_CTRL_AUXSRC_VALUE_CLKSRC_PLL_USB, usb_hz, usb_hz);
+    retune_enabled = false;
+    trim_ppb = 0;
+}
+
+bool sys_clock_exact(uint32_t sys_hz, uint32_t frequency, uint32_t min_ratio) {
+    if (frequency == 0 || sys_hz % frequency != 0) return false;
+
+    uint32_t ratio = sys_hz / frequency;
+    if (ratio < min_ratio) return false;
+
+    // Smallest integer divider first; it leaves the longest counter period
+    for (uint32_t div = 1; div <= PWM_SOLVER_DIV16_MAX >> 4; div++) {
+        if (ratio % div != 0) continue;
+        uint32_t period = ratio / div;
+        if (period < PWM_SOLVER_PERIOD_MIN) return false;
+        if (period <= PWM_SOLVER_PERIOD_MAX) return true;
+    }
+    return false;
+}
+
+bool sys_clock_valid(uint32_t khz) {
+    uint vco_freq, post_div1, post_div2;
+    return khz >= SYS_CLOCK_MIN_KHZ && khz <= SYS_CLOCK_MAX_KHZ &&
+           check_sys_clock_khz(khz, &vco_freq, &post_div1, &post_div2);
+}
+
+bool sys_clock_plan(uint32_t frequency, uint32_t min_ratio, uint32_t *khz) {
+    // Outwards from the nominal clock, above before below
+    for (uint32_t step = 0; step <= SYS_CLOCK_MAX_KHZ - SYS_CLOCK_MIN_KHZ; step++) {
+        for (int below = 0; below < 2; below++) {
+            if (below && (step == 0 || step > SYS_CLOCK_NOMINAL_KHZ - SYS_CLOCK_MIN_KHZ)) continue;
+            if (!below && step > SYS_CLOCK_MAX_KHZ - SYS_CLOCK_NOMINAL_KHZ) continue;
+
+            uint32_t candidate = below ? SYS_CLOCK_NOMINAL_KHZ - step : SYS_CLOCK_NOMINAL_KHZ + step;
+            if (sys_clock_exact(candidate * 1000u, frequency, min_ratio) && sys_clock_valid(candidate)) {
+                *khz = candidate;
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+bool sys_clock_retune_for(uint32_t frequency, uint32_t min_ratio, uint32_t *khz) {
+    if (!retune_enabled) return false;
+
+    uint32_t sys_hz = clock_get_hz(clk_sys);
+    if (sys_clock_exact(sys_hz, frequency, min_ratio)) return false;
+
+    if (!sys_clock_plan(frequency, min_ratio, khz)) {
+        // Nothing divides exactly; move only if the frequency is out of reach
+        if (frequency <= sys_hz / min_ratio) return false;
+        *khz = SYS_CLOCK_MAX_KHZ;
+    }
+    return *khz * 1000u != sys_hz;
+}
+
+bool sys_clock_set_khz(uint32_t khz) {
+    uint vco_freq, post_div1, post_div2;
+    if (khz < SYS_CLOCK_MIN_KHZ || khz > SYS_CLOCK_MAX_KHZ ||
+        !check_sys_clock_khz(khz, &vco_freq, &post_div1, &post_div2)) {
+        return false;
+    }
+    if (clock_get_hz(clk_sys) == khz * 1000u) return true;
+
+    // As set_sys_clock_khz(), except that clk_peri is left alone: it already
+    // runs from the USB PLL, and reconfiguring it would pause the UARTs
+    // mid-character. clk_sys runs from the USB PLL while the system PLL
+    // relocks.
+    uint32_t usb_hz = clock_get_hz(clk_usb);
+    clock_configure(clk_sys, CLOCKS_CLK_SYS_CTRL_SRC_VALUE_CLKSRC_CLK_SYS_AUX,
+                    CLOCKS_CLK_SYS_CTRL_AUXSRC_VALUE_CLKSRC_PLL_USB, usb_hz, usb_hz);
+    pll_init(pll_sys, 1, vco_freq, post_div1, post_div2);
+    clock_configure(clk_sys, CLOCKS_CLK_SYS_CTRL_SRC_VALUE_CLKSRC_CLK_SYS_AUX,
+                    CLOCKS_CLK_SYS_CTRL_AUXSRC_VALUE_CLKSRC_PLL_SYS, khz * 1000u, khz * 1000u);
+
+    clock_core_telemetry(CORE_TLM_SYS_CLOCK, 0, khz);
+    return true;
+}
+
+uint32_t sys_clock_max_frequency(uint32_t min_ratio) {
+    uint32_t sys_hz = retune_enabled ? SYS_CLOCK_MAX_KHZ * 1000u : clock_get_hz(clk_sys);
+    return sys_hz / min_ratio;
+}
+
+uint32_t sys_clock_get_hz(void) {
+    // The trim is a ratio of the crystal, so it holds at every system clock
+    int64_t hz = clock_get_hz(clk_sys);
+    int64_t correction = hz * trim_ppb;
+    return (uint32_t)(hz + (correction + (correction >= 0 ? 500000000 : -500000000)) / 1000000000);
+}
+
+void sys_clock_set_trim_ppb(int32_t ppb) {
+    trim_ppb = ppb;
+}
+
+int32_t sys_clock_get_trim_ppb(void) {
+    return trim_ppb;
+}
+
+void sys_clock_set_retune(bool enabled) {
+    retune_enabled = enabled;
+}
+
+bool sys_clock_get_retune(void) {
+    return retune_enabled;
+}
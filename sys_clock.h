@@ -0,0 +1,115 @@
+/**
+ * System Clock Module for Multimode Clock Source
+ *
+ * Every clock engine divides clk_sys, so a frequency comes out exactly only
+ * if clk_sys is a whole multiple of it. This module can re-plan clk_sys
+ * (SYS_CLOCK_MIN_KHZ to SYS_CLOCK_MAX_KHZ) so that it is. At boot clk_peri
+ * is moved to the USB PLL, and a retune only reprograms the system PLL, so
+ * UART baud rates and USB timing are the same at every system clock.
+ *
+ * Retuning is off by default. When it is on, the engines ask for a new
+ * system clock before they start (sys_clock_retune_for()).
+ *
+ * clk_sys is only as accurate as the crystal. The engines solve against
+ * sys_clock_get_hz(), which is clk_sys corrected by a trim that the
+ * reference discipline (discipline.h) measures; with no reference the trim
+ * is zero.
+ */
+
+#ifndef SYS_CLOCK_H
+#define SYS_CLOCK_H
+
+#include "pico/stdlib.h"
+
+/**
+ * Run clk_peri from the USB PLL (call first, before any UART is set up)
+ */
+void sys_clock_init(void);
+
+/**
+ * Check whether a system clock produces a frequency exactly
+ * Exact means a whole number of system clock cycles per output cycle,
+ * split into an integer PWM divider and counter period, so the PWM and
+ * burst engines both hit it without a fractional divider.
+ * @param sys_hz System clock in Hz
+ * @param frequency Output frequency in Hz
+ * @param min_ratio Fewest system clock cycles per output cycle the engine needs
+ * @return true if the frequency divides exactly
+ */
+bool sys_clock_exact(uint32_t sys_hz, uint32_t frequency, uint32_t min_ratio);
+
+/**
+ * Find the system clock closest to SYS_CLOCK_NOMINAL_KHZ that produces a
+ * frequency exactly and that the system PLL can make from the crystal
+ * @param frequency Output frequency in Hz
+ * @param min_ratio Fewest system clock cycles per output cycle the engine needs
+ * @param khz Receives the system clock in kHz
+ * @return true if one exists in SYS_CLOCK_MIN_KHZ to SYS_CLOCK_MAX_KHZ
+ */
+bool sys_clock_plan(uint32_t frequency, uint32_t min_ratio, uint32_t *khz);
+
+/**
+ * Decide whether an engine should retune clk_sys before it starts (core1)
+ * Asks for the exact plan if there is one; otherwise, only if the frequency
+ * is out of reach at the running clock, for SYS_CLOCK_MAX_KHZ.
+ * @param frequency Output frequency in Hz
+ * @param min_ratio Fewest system clock cycles per output cycle the engine needs
+ * @param khz Receives the system clock to switch to
+ * @return true if retuning is on and clk_sys should change
+ */
+bool sys_clock_retune_for(uint32_t frequency, uint32_t min_ratio, uint32_t *khz);
+
+/**
+ * Switch clk_sys (core1, with every clock engine stopped)
+ * The change is reported to core0 as telemetry.
+ * @param khz New system clock in kHz (see sys_clock_valid())
+ * @return true if clk_sys now runs at khz
+ */
+bool sys_clock_set_khz(uint32_t khz);
+
+/**
+ * Check that a system clock is in range and can be made by the system PLL
+ * @param khz System clock in kHz
+ * @return true if sys_clock_set_khz() would accept it
+ */
+bool sys_clock_valid(uint32_t khz);
+
+/**
+ * Get the highest frequency an engine can be asked for
+ * With retuning on, this is at SYS_CLOCK_MAX_KHZ, which a retune may select.
+ * @param min_ratio Fewest system clock cycles per output cycle the engine needs
+ * @return Frequency in Hz
+ */
+uint32_t sys_clock_max_frequency(uint32_t min_ratio);
+
+/**
+ * Get the system clock the engines solve against
+ * @return clk_sys in Hz, corrected by the trim and rounded
+ */
+uint32_t sys_clock_get_hz(void);
+
+/**
+ * Set how far the crystal is off (core1, then retune the running engines)
+ * @param ppb Offset in parts per billion, positive if clk_sys runs fast
+ */
+void sys_clock_set_trim_ppb(int32_t ppb);
+
+/**
+ * Get the trim the engines are solved against
+ * @return Offset in parts per billion
+ */
+int32_t sys_clock_get_trim_ppb(void);
+
+/**
+ * Turn retuning on or off
+ * @param enabled true to let the engines choose the system clock
+ */
+void sys_clock_set_retune(bool enabled);
+
+/**
+ * Get whether retuning is on
+ * @return true if the engines choose the system clock
+ */
+bool sys_clock_get_retune(void);
+
+#endif // SYS_CLOCK_H
@@ -0,0 +1,170 @@
+#!/usr/bin/env python3
+"""
+Binary control protocol loopback test for Multimode Clock Source
+
+Checks control_client.py against the firmware rather than against itself.
+The client's COBS and CRC are checked first: COBS round trips with zero
+runs and 254-byte blocks, and the CRC gives the CRC-16/CCITT-FALSE check
+value. Then frames encoded by the client are sent to the simulator with
+the script's "bytes" action, UART0's output is captured with --uart0-out,
+and the client's stream decoder must find a good reply to each request in
+order, among the menu text. A 200-frame burst sent back to back at full
+baud must be answered in full, with sequence numbers wrapping past 255,
+and a frame with a bad CRC must get no reply without upsetting the next.
+
+Usage:
+  control_loopback.py SIMULATOR
+"""
+
+import os
+import random
+import struct
+import subprocess
+import sys
+import tempfile
+
+sys.path.insert(0, os.path.join(os.path.dirname(os.path.abspath(__file__)), '..'))
+import control_client as client  # noqa: E402
+
+BURST_FRAMES = 200
+BURST_START_MS = 600
+FIRST_SEQ = 150     # So the burst wraps the sequence number
+
+# Requests the burst cycles through, all answered OK from any mode
+BURST_REQUESTS = [
+    ('ping',),
+    ('status',),
+    ('sysclk',),
+    ('deadtime', '4'),
+    ('duty', '25'),
+    ('count',),
+]
+
+
+def check_cobs(failures):
+    rng = random.Random(1)
+    cases = [b'', b'\x00', b'\x00\x00', b'\x01', bytes(range(1, 255)), bytes(range(1, 256)),
+             bytes(300), b'\x11\x00\x22\x00\x00\x33']
+    cases += [bytes(rng.choice((0, rng.randrange(256))) for _ in range(rng.randrange(600)))
+              for _ in range(2000)]
+    for data in cases:
+        encoded = client.cobs_encode(data)
+        if 0 in encoded:
+            failures.append(f'COBS left a zero in the encoding of {data[:16].hex()}...')
+        elif client.cobs_decode(encoded) != data:
+            failures.append(f'COBS round trip changed {data[:16].hex()}...')
+        elif len(encoded) > len(data) + 1 + len(data) // 254:
+            failures.append(f'COBS grew {len(data)} bytes to {len(encoded)}')
+    return len(cases)
+
+
+def check_crc(failures):
+    value = client.crc16(b'123456789')
+    if value != 0x29B1:
+        failures.append(f'CRC-16/CCITT-FALSE check value 0x{value:04X}, expected 0x29B1')
+    if client.crc16(b'') != 0xFFFF:
+        failures.append('CRC of nothing is not the initial value')
+
+    # A frame decodes to what was encoded; any flipped bit is rejected
+    frame = client.encode_frame(7, client.OPCODES['freq'], struct.pack('<I', 12345))
+    if client.decode_frame(frame[1:-1]) != (7, client.OPCODES['freq'], struct.pack('<I', 12345)):
+        failures.append('frame round trip changed the frame')
+    body = client.cobs_decode(frame[1:-1])
+    for bit in range(len(body) * 8):
+        corrupt = bytearray(body)
+        corrupt[bit // 8] ^= 1 << (bit % 8)
+        try:
+            client.decode_frame(client.cobs_encode(bytes(corrupt)))
+            failures.append(f'frame with bit {bit} flipped decoded')
+        except ValueError:
+            pass
+
+
+def request(seq, words):
+    opcode, payload = client.request_payload(*words)
+    return seq & 0xFF, opcode, client.encode_frame(seq, opcode, payload)
+
+
+def run_simulator(simulator, script_lines, until_ms):
+    with tempfile.TemporaryDirectory() as directory:
+        script = os.path.join(directory, 'loopback.sim')
+        capture = os.path.join(directory, 'uart0.bin')
+        with open(script, 'w') as f:
+            f.write('\n'.join(script_lines) + '\n')
+        run = subprocess.run([simulator, '--until', str(until_ms), '--uart0-out', capture, script],
+                             stdout=subprocess.PIPE, stderr=subprocess.STDOUT)
+        with open(capture, 'rb') as f:
+            return run, f.read()
+
+
+def check_loopback(simulator, failures):
+    script = []
+    expected = []
+
+    # One of each, well apart, then one the firmware must ignore
+    ping = request(1, ('ping',))
+    script.append(f'400 bytes {ping[2].hex()}')
+    expected.append(ping[:2])
+    corrupt = bytearray(request(2, ('status',))[2])
+    corrupt[-2] ^= 0x01
+    script.append(f'450 bytes {corrupt.hex()}')
+    status = request(3, ('status',))
+    script.append(f'500 bytes {status[2].hex()}')
+    expected.append(status[:2])
+
+    # The burst, queued on the wire at once
+    for n in range(BURST_FRAMES):
+        seq, opcode, frame = request(FIRST_SEQ + n, BURST_REQUESTS[n % len(BURST_REQUESTS)])
+        script.append(f'{BURST_START_MS} bytes {frame.hex()}')
+        expected.append((seq, opcode))
+
+    run, output = run_simulator(simulator, script, 2000)
+    if run.returncode != 0:
+        failures.append(f'simulator exited with status {run.returncode}')
+    for line in run.stdout.decode('utf-8', 'replace').splitlines():
+        if 'lost' in line:
+            failures.append('simulator: ' + line)
+
+    replies = []
+    for item in client.StreamDecoder().feed(output):
+        if item[0] == 'frame':
+            replies.append(item[1:])
+        elif item[0] == 'error':
+            failures.append('corrupt reply: ' + item[1])
+
+    if len(replies) != len(expected):
+        failures.append(f'{len(replies)} replies to {len(expected)} good requests')
+    for (seq, opcode), (reply_seq, reply_opcode, payload) in zip(expected, replies):
+        name = client.OPCODE_NAMES[opcode]
+        if (reply_seq, reply_opcode) != (seq, opcode | client.REPLY):
+            failures.append(f'{name} seq {seq}: reply seq {reply_seq} opcode 0x{reply_opcode:02X}')
+            break
+        if not payload or payload[0] != 0:
+            failures.append(f'{name} seq {seq}: ' + client.describe_reply(reply_opcode, payload))
+            continue
+        try:
+            client.describe_reply(reply_opcode, payload)
+        except (struct.error, IndexError) as e:
+            failures.append(f'{name} seq {seq}: reply payload {payload.hex()} does not decode: {e}')
+    return len(replies), len(output)
+
+
+def main():
+    if len(sys.argv) != 2:
+        print('usage: control_loopback.py SIMULATOR', file=sys.stderr)
+        return 2
+
+    failures = []
+    cases = check_cobs(failures)
+    check_crc(failures)
+    replies, captured = check_loopback(sys.argv[1], failures)
+
+    if failures:
+        print('\n'.join(failures))
+        return 1
+    print(f'{cases} COBS round trips, CRC check value 0x29B1, {replies} replies in {captured} bytes from UART0')
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
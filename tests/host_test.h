@@ -0,0 +1,67 @@
+/**
+ * Host Test Helpers for Multimode Clock Source
+ *
+ * A failed CHECK reports itself and the test carries on, so one run lists
+ * every mismatch; host_test_finish() turns the tally into the exit status
+ * ctest looks at. Tests that run firmware on the simulated cores set up the
+ * peripheral models with host_test_sim_init() first.
+ */
+
+#ifndef HOST_TEST_H
+#define HOST_TEST_H
+
+#include <stdio.h>
+#include <stdint.h>
+#include <time.h>
+#include "sim.h"
+
+// Reports past this many are only counted
+#define HOST_TEST_MAX_REPORTS 20
+
+static int host_test_failures = 0;
+
+#define CHECK(cond, ...) do { \
+        if (!(cond)) { \
+            if (host_test_failures++ < HOST_TEST_MAX_REPORTS) { \
+                fprintf(stderr, "%s:%d: %s: ", __FILE__, __LINE__, #cond); \
+                fprintf(stderr, __VA_ARGS__); \
+                fputc('\n', stderr); \
+            } \
+        } \
+    } while (0)
+
+/**
+ * Set up the peripheral models (no script, no edge counters)
+ */
+static inline void host_test_sim_init(void) {
+    sim_gpio_init();
+    sim_pwm_init();
+    sim_pio_init();
+    sim_dma_init();
+    sim_uart_init();
+}
+
+/**
+ * Host time in seconds, for benchmarks
+ */
+static inline double host_test_seconds(void) {
+    struct timespec t;
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return (double)t.tv_sec + (double)t.tv_nsec / 1e9;
+}
+
+/**
+ * Report the result
+ * @param name Test name
+ * @return Exit status: 0 if every check passed
+ */
+static inline int host_test_finish(const char *name) {
+    if (host_test_failures) {
+        fprintf(stderr, "%s: %d checks failed\n", name, host_test_failures);
+        return 1;
+    }
+    fprintf(stderr, "%s: passed\n", name);
+    return 0;
+}
+
+#endif // HOST_TEST_H
@@ -0,0 +1,127 @@
+#!/usr/bin/env python3
+"""
+Simulator script test runner for Multimode Clock Source
+
+Runs a script through the host simulator and checks its output against the
+expectations written in the script's comments:
+
+    # until: MS          Run limit in virtual milliseconds (--until)
+    # args: ARG...       Further simulator arguments
+    # expect: TEXT       A later output line contains TEXT; expectations are
+                         matched in order, each after the line of the last
+    # never: TEXT        No output line contains TEXT
+
+TEXT is literal, except that {LO..HI} matches a number from LO to HI
+(either bound may be left out) and {*} matches any text. The simulator's
+report prefix ("[sim ... ms] ") is part of the line, so TEXT may match
+anywhere in it.
+
+Usage:
+  sim_test.py SIMULATOR SCRIPT
+"""
+
+import re
+import subprocess
+import sys
+
+DIRECTIVE = re.compile(r'#\s*(until|args|expect|never):\s?(.*)$')
+PLACEHOLDER = re.compile(r'\{([-+0-9.eE]*)\.\.([-+0-9.eE]*)\}|\{\*\}')
+NUMBER = r'([-+]?\d+(?:\.\d+)?)'
+
+
+class Pattern:
+    """TEXT of an expect or never line, compiled with its number bounds."""
+
+    def __init__(self, text):
+        self.text = text
+        self.bounds = []
+        parts = []
+        position = 0
+        for m in PLACEHOLDER.finditer(text):
+            parts.append(re.escape(text[position:m.start()]))
+            if m.group(0) == '{*}':
+                parts.append('.*?')
+            else:
+                parts.append(NUMBER)
+                self.bounds.append((float(m.group(1)) if m.group(1) else None,
+                                    float(m.group(2)) if m.group(2) else None))
+            position = m.end()
+        parts.append(re.escape(text[position:]))
+        self.regex = re.compile(''.join(parts))
+
+    def matches(self, line):
+        for m in self.regex.finditer(line):
+            if all(in_bounds(float(value), bounds) for value, bounds in zip(m.groups(), self.bounds)):
+                return True
+        return False
+
+
+def in_bounds(value, bounds):
+    low, high = bounds
+    return (low is None or value >= low) and (high is None or value <= high)
+
+
+def read_directives(path):
+    until = None
+    args = []
+    expects = []
+    nevers = []
+    with open(path) as f:
+        for number, line in enumerate(f, 1):
+            m = DIRECTIVE.search(line)
+            if not m:
+                continue
+            kind, text = m.group(1), m.group(2).rstrip()
+            if kind == 'until':
+                until = text
+            elif kind == 'args':
+                args += text.split()
+            elif kind == 'expect':
+                expects.append((number, Pattern(text)))
+            else:
+                nevers.append((number, Pattern(text)))
+    return until, args, expects, nevers
+
+
+def main():
+    if len(sys.argv) != 3:
+        print('usage: sim_test.py SIMULATOR SCRIPT', file=sys.stderr)
+        return 2
+    simulator, script = sys.argv[1], sys.argv[2]
+    until, args, expects, nevers = read_directives(script)
+    if not expects:
+        print(f'{script}: no expectations', file=sys.stderr)
+        return 2
+
+    command = [simulator] + (['--until', until] if until else []) + args + [script]
+    run = subprocess.run(command, stdout=subprocess.PIPE, stderr=subprocess.STDOUT)
+    lines = run.stdout.decode('utf-8', 'replace').splitlines()
+
+    failures = []
+    if run.returncode != 0:
+        failures.append(f'simulator exited with status {run.returncode}')
+
+    position = 0
+    for number, pattern in expects:
+        found = next((i for i in range(position, len(lines)) if pattern.matches(lines[i])), None)
+        if found is None:
+            failures.append(f'line {number}: expected "{pattern.text}" after output line {position}')
+            break
+        position = found + 1
+
+    for number, pattern in nevers:
+        for i, line in enumerate(lines):
+            if pattern.matches(line):
+                failures.append(f'line {number}: output line {i + 1} has "{pattern.text}": {line}')
+
+    if failures:
+        print('\n'.join(lines))
+        print('----')
+        print('\n'.join(f'{script}: {failure}' for failure in failures))
+        return 1
+    print(f'{script}: {len(expects)} expectations met')
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
@@ -0,0 +1,119 @@
+/**
+ * Clock table test
+ *
+ * Checks the tables gen_clock_tables.py generated against the runtime code
+ * they stand in for: every PWM grid entry must be exactly what pwm_solve()
+ * returns, the grid must hold every log-spaced point up to its top, and
+ * every pot period must be what pio_clock_period_millihz() computes. A
+ * trimmed system clock must bypass the tables.
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <math.h>
+#include "host_test.h"
+#include "config.h"
+#include "clock_cache.h"
+#include "pio_clock.h"
+#include "pwm_solver.h"
+#include "sys_clock.h"
+
+static void check_grid(void) {
+    uint32_t expected = 0;
+    uint32_t previous = 0;
+
+    // The generator's points, in order: round(10^(step / per decade))
+    for (uint32_t step = 0; ; step++) {
+        uint32_t frequency = (uint32_t)llround(pow(10.0, (double)step / CLOCK_CACHE_GRID_PER_DECADE));
+        if (frequency > CLOCK_CACHE_GRID_MAX_HZ) break;
+        if (frequency < MIN_UART_FREQ || frequency == previous) continue;
+        previous = frequency;
+
+        pwm_solution_t solved;
+        if (!pwm_solve(CLOCK_CACHE_SYS_HZ, frequency, &solved)) continue;
+        if (expected >= clock_cache_pwm_grid_length) {
+            expected++;
+            continue;
+        }
+
+        const clock_cache_pwm_entry_t *entry = &clock_cache_pwm_grid[expected++];
+        CHECK(entry->frequency == frequency, "grid %u: %u Hz, expected %u Hz", expected - 1, entry->frequency,
+              frequency);
+        CHECK(entry->div_int == solved.div_int && entry->div_frac == solved.div_frac &&
+              entry->wrap == solved.wrap && entry->level == solved.level,
+              "%u Hz: table %u+%u/16 wrap %u level %u, pwm_solve %u+%u/16 wrap %u level %u", frequency,
+              entry->div_int, entry->div_frac, entry->wrap, entry->level,
+              solved.div_int, solved.div_frac, solved.wrap, solved.level);
+
+        // A lookup is the solver's answer, achieved frequency and error included
+        pwm_solution_t cached;
+        CHECK(clock_cache_lookup_pwm(frequency, &cached), "%u Hz: grid point missed", frequency);
+        CHECK(cached.achieved_millihz == solved.achieved_millihz && cached.error_ppb == solved.error_ppb,
+              "%u Hz: lookup %llu mHz %d ppb, pwm_solve %llu mHz %d ppb", frequency,
+              (unsigned long long)cached.achieved_millihz, cached.error_ppb,
+              (unsigned long long)solved.achieved_millihz, solved.error_ppb);
+
+        // Points this far up are never adjacent
+        pwm_solution_t missed;
+        CHECK(frequency < 1000 || !clock_cache_lookup_pwm(frequency + 1, &missed), "%u Hz: off-grid lookup hit",
+              frequency + 1);
+    }
+    CHECK(expected == clock_cache_pwm_grid_length, "grid holds %u entries, %u points up to %u Hz",
+          clock_cache_pwm_grid_length, expected, CLOCK_CACHE_GRID_MAX_HZ);
+    CHECK(clock_cache_pwm_grid_length <= CLOCK_CACHE_GRID_ENTRIES, "grid overflows %u entries",
+          CLOCK_CACHE_GRID_ENTRIES);
+    printf("%u grid entries match pwm_solve (%u to %u Hz)\n", clock_cache_pwm_grid_length,
+           clock_cache_pwm_grid[0].frequency, clock_cache_pwm_grid[clock_cache_pwm_grid_length - 1].frequency);
+}
+
+static void check_pot(void) {
+    CHECK(clock_cache_adc_millihz[0] == MIN_LOW_FREQ * 1000u, "adc 0: %u mHz", clock_cache_adc_millihz[0]);
+    CHECK(clock_cache_adc_millihz[CLOCK_CACHE_ADC_ENTRIES - 1] == MAX_LOW_FREQ_RANGE2 * 1000u, "adc %u: %u mHz",
+          CLOCK_CACHE_ADC_ENTRIES - 1, clock_cache_adc_millihz[CLOCK_CACHE_ADC_ENTRIES - 1]);
+
+    for (uint32_t adc = 0; adc < CLOCK_CACHE_ADC_ENTRIES; adc++) {
+        uint32_t millihz = clock_cache_adc_millihz[adc];
+        uint32_t period = pio_clock_period_millihz(CLOCK_CACHE_SYS_HZ, millihz);
+        CHECK(clock_cache_adc_period[adc] == period, "adc %u: table period %u, pio_clock_period_millihz %u", adc,
+              clock_cache_adc_period[adc], period);
+        if (adc > 0) {
+            CHECK(millihz >= clock_cache_adc_millihz[adc - 1], "adc %u: %u mHz below adc %u", adc, millihz, adc - 1);
+        }
+
+        // Positions between ADC values stay between their neighbours
+        for (uint32_t sub = 0; sub < CLOCK_CACHE_POT_SUBSTEPS && adc + 1 < CLOCK_CACHE_ADC_ENTRIES; sub++) {
+            uint16_t position = (uint16_t)(adc * CLOCK_CACHE_POT_SUBSTEPS + sub);
+            uint32_t value = clock_cache_pot_millihz(position);
+            CHECK(value >= millihz && value <= clock_cache_adc_millihz[adc + 1], "position %u: %u mHz", position,
+                  value);
+            uint32_t interpolated = clock_cache_pot_period(position);
+            CHECK(interpolated <= period && interpolated >= clock_cache_adc_period[adc + 1], "position %u: period %u",
+                  position, interpolated);
+        }
+    }
+    printf("%u pot periods match pio_clock_period_millihz\n", CLOCK_CACHE_ADC_ENTRIES);
+}
+
+static void check_trimmed(void) {
+    // A trimmed clock is solved afresh at its own rate
+    sys_clock_set_trim_ppb(20000);
+    uint32_t sys_hz = sys_clock_get_hz();
+    CHECK(!clock_cache_valid(), "tables used at %u Hz", sys_hz);
+
+    pwm_solution_t cached;
+    CHECK(!clock_cache_lookup_pwm(clock_cache_pwm_grid[0].frequency, &cached), "grid served at %u Hz", sys_hz);
+    uint16_t position = 2000 * CLOCK_CACHE_POT_SUBSTEPS;
+    CHECK(clock_cache_pot_period(position) == pio_clock_period_millihz(sys_hz, clock_cache_pot_millihz(position)),
+          "pot period not solved at %u Hz", sys_hz);
+    sys_clock_set_trim_ppb(0);
+    CHECK(clock_cache_valid(), "tables unused after the trim is cleared");
+}
+
+int main(void) {
+    CHECK(clock_cache_valid(), "tables built for %u Hz, clock runs at %u Hz", CLOCK_CACHE_SYS_HZ,
+          sys_clock_get_hz());
+    check_grid();
+    check_pot();
+    check_trimmed();
+    return host_test_finish("test_clock_cache");
+}
@@ -0,0 +1,404 @@
+/**
+ * Command table fuzz test and benchmark
+ *
+ * Runs the text command parser over the firmware's own command table.
+ * command_parse_number() is checked against a plain reference on random
+ * strings, which fits every value in 128 bits and so needs no saturation
+ * tricks; command_table_parse() is checked against a reference that splits
+ * the line and looks names up one by one, on random lines built from names,
+ * numbers, keywords and junk. Random bytes, with nothing after the line,
+ * must not upset it. Every name must be found, and no prefix or extension of
+ * one. Times lookup, number parsing and whole lines per call, against a
+ * linear search of the names.
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+#include "host_test.h"
+#include "command_table.h"
+#include "uart_control.h"
+
+#define NUMBER_CASES    2000000u
+#define LINE_CASES      1000000u
+#define BYTE_CASES      1000000u
+#define BENCH_ROUNDS    200000u
+
+// The firmware's own table (uart_control.c)
+static const command_t *commands;
+static uint32_t command_count;
+static const char *const *mode_names;    // Keywords of "mode", for random lines
+
+static command_table_t table;
+
+static uint64_t rng_state = 0x2545F4914F6CDD1Dull;
+
+static uint32_t rng(void) {
+    rng_state ^= rng_state << 13;
+    rng_state ^= rng_state >> 7;
+    rng_state ^= rng_state << 17;
+    return (uint32_t)(rng_state >> 32);
+}
+
+static uint32_t pick(uint32_t n) {
+    return rng() % n;
+}
+
+// Reference number parser: the grammar spelled out, the value worked out in
+// 128 bits (texts are kept short enough for that), then clamped
+static bool reference_number(const char *s, uint32_t length, uint32_t decimals, uint64_t *value) {
+    unsigned __int128 mantissa = 0;
+    int32_t exponent = (int32_t)decimals;
+    uint32_t digits = 0;
+    uint32_t i = 0;
+    bool point = false;
+
+    for (; i < length; i++) {
+        if (s[i] >= '0' && s[i] <= '9') {
+            mantissa = mantissa * 10 + (unsigned)(s[i] - '0');
+            digits++;
+            if (point) exponent--;
+        } else if (s[i] == '.' && !point) {
+            point = true;
+        } else {
+            break;
+        }
+    }
+    if (digits == 0) return false;
+    if (i < length) {
+        if (i + 1 != length) return false;
+        if (s[i] == 'k' || s[i] == 'K') exponent += 3;
+        else if (s[i] == 'M') exponent += 6;
+        else if (s[i] == 'G') exponent += 9;
+        else return false;
+    }
+
+    for (; exponent < 0; exponent++) {
+        if (mantissa % 10) return false;
+        mantissa /= 10;
+    }
+    for (; exponent > 0; exponent--) {
+        mantissa *= 10;
+    }
+    *value = mantissa > UINT64_MAX ? UINT64_MAX : (uint64_t)mantissa;
+    return true;
+}
+
+// Short texts that are mostly numbers, some nearly
+static uint32_t random_number_text(char *s) {
+    static const char others[] = "kKMGmg.x -+e";
+    uint32_t length = 0;
+    if (pick(4) == 0) {
+        // Anything from the alphabet
+        uint32_t n = pick(17);
+        for (uint32_t i = 0; i < n; i++) {
+            s[length++] = pick(3) ? (char)('0' + pick(10)) : others[pick(sizeof(others) - 1)];
+        }
+        return length;
+    }
+    uint32_t whole = pick(12);
+    uint32_t fraction = pick(3) ? 0 : pick(6);
+    for (uint32_t i = 0; i < whole; i++) s[length++] = (char)('0' + pick(10));
+    if (fraction || pick(8) == 0) s[length++] = '.';
+    for (uint32_t i = 0; i < fraction; i++) s[length++] = pick(2) ? '0' : (char)('0' + pick(10));
+    if (pick(3) == 0) s[length++] = "kKMG"[pick(4)];
+    return length;
+}
+
+static void test_numbers(void) {
+    static const struct {
+        const char *text;
+        uint32_t decimals;
+        bool ok;
+        uint64_t value;
+    } cases[] = {
+        { "250k", 0, true, 250000 }, { "1.5M", 0, true, 1500000 }, { "1.5k", 0, true, 1500 },
+        { "12.5", 2, true, 1250 }, { "0.01", 2, true, 1 }, { "99.99", 2, true, 9999 }, { ".5", 1, true, 5 },
+        { "5.", 0, true, 5 }, { "4G", 0, true, 4000000000ull }, { "1.2345k", 0, false, 0 },
+        { "0.001", 2, false, 0 }, { "1.50000", 1, true, 15 }, { "", 0, false, 0 }, { ".", 0, false, 0 },
+        { "k", 0, false, 0 }, { "1.2.3", 0, false, 0 }, { "1kk", 0, false, 0 }, { "1m", 0, false, 0 },
+        { "-5", 0, false, 0 }, { "1e3", 0, false, 0 }, { " 5", 0, false, 0 }, { "5 ", 0, false, 0 },
+        { "18446744073709551615", 0, true, UINT64_MAX }, { "99999999999999999999999", 0, true, UINT64_MAX },
+        { "99999999999999999999999.5", 0, true, UINT64_MAX }, { "20000000000G", 0, true, UINT64_MAX },
+        { "1.00000000000000000000000000", 0, true, 1 }, { "1.00000000000000000000000001", 0, false, 0 },
+        { "0000000000000000000000000007", 0, true, 7 },
+    };
+    for (uint32_t i = 0; i < sizeof(cases) / sizeof(cases[0]); i++) {
+        uint64_t value = 0;
+        bool ok = command_parse_number(cases[i].text, (uint32_t)strlen(cases[i].text), cases[i].decimals, &value);
+        CHECK(ok == cases[i].ok && (!ok || value == cases[i].value), "\"%s\" to %u decimals: %s %llu",
+              cases[i].text, cases[i].decimals, ok ? "ok" : "rejected", (unsigned long long)value);
+    }
+
+    uint32_t accepted = 0;
+    for (uint32_t n = 0; n < NUMBER_CASES; n++) {
+        char text[32];
+        uint32_t length = random_number_text(text);
+        uint32_t decimals = pick(4);
+        uint64_t value = 0, expected = 0;
+        bool ok = command_parse_number(text, length, decimals, &value);
+        bool expected_ok = reference_number(text, length, decimals, &expected);
+        CHECK(ok == expected_ok && (!ok || value == expected), "\"%.*s\" to %u decimals: %s %llu, expected %s %llu",
+              (int)length, text, decimals, ok ? "ok" : "rejected", (unsigned long long)value,
+              expected_ok ? "ok" : "rejected", (unsigned long long)expected);
+        if (ok) accepted++;
+    }
+    printf("%u random numbers, %u accepted\n", NUMBER_CASES, accepted);
+}
+
+// Reference line parser: split on spaces, find the name by linear search
+static command_result_t reference_parse(const char *line, uint32_t length, const command_t **command,
+                                        uint64_t values[COMMAND_MAX_ARGS], uint32_t *arg_index) {
+    const char *words[COMMAND_MAX_ARGS + 2];
+    uint32_t lengths[COMMAND_MAX_ARGS + 2];
+    uint32_t count = 0;
+    for (uint32_t i = 0; i < length; ) {
+        if (line[i] == ' ') {
+            i++;
+            continue;
+        }
+        uint32_t start = i;
+        while (i < length && line[i] != ' ') i++;
+        if (count == COMMAND_MAX_ARGS + 2) return COMMAND_UNKNOWN;  // More than any command takes
+        words[count] = &line[start];
+        lengths[count++] = i - start;
+    }
+    if (count == 0) return COMMAND_UNKNOWN;
+
+    const command_t *c = NULL;
+    for (uint32_t i = 0; i < command_count; i++) {
+        if (strlen(commands[i].name) == lengths[0] && memcmp(commands[i].name, words[0], lengths[0]) == 0) {
+            c = &commands[i];
+        }
+    }
+    if (!c) return COMMAND_UNKNOWN;
+
+    uint32_t takes = 0;
+    while (takes < COMMAND_MAX_ARGS && c->args[takes].type != COMMAND_ARG_NONE) takes++;
+    if (count - 1 > takes) return COMMAND_UNKNOWN;
+    *command = c;
+
+    for (uint32_t i = 0; i < COMMAND_MAX_ARGS; i++) {
+        const command_arg_t *arg = &c->args[i];
+        values[i] = 0;
+        if (i >= takes) continue;
+        *arg_index = i;
+        if (i + 1 >= count) {
+            values[i] = arg->default_value;
+            if (!arg->optional) return COMMAND_MISSING_ARG;
+            continue;
+        }
+        const char *word = words[i + 1];
+        uint32_t word_length = lengths[i + 1];
+        if (arg->type == COMMAND_ARG_KEYWORD) {
+            bool found = false;
+            for (uint32_t k = 0; arg->keywords[k] && !found; k++) {
+                if (strlen(arg->keywords[k]) == word_length && memcmp(arg->keywords[k], word, word_length) == 0) {
+                    values[i] = k;
+                    found = true;
+                }
+            }
+            if (!found) return COMMAND_BAD_ARG;
+        } else {
+            uint64_t n;
+            if (!reference_number(word, word_length, arg->decimals, &n)) return COMMAND_BAD_ARG;
+            if (n < arg->min || n > arg->max) return COMMAND_OUT_OF_RANGE;
+            values[i] = n;
+        }
+    }
+    return COMMAND_OK;
+}
+
+// Lines of names, numbers, keywords and junk with uneven spacing
+static uint32_t random_line(char *line) {
+    static const char *const junk[] = { "fre", "freqq", "FREQ", "stat", "resets", "on", "ON", "loop", "lin",
+                                        "log", "step", "uart", "x", "-5", "1e3", "1.2.3", "\t", "\x80", "off" };
+    uint32_t length = 0;
+    uint32_t words = pick(7);
+    for (uint32_t w = 0; w < words; w++) {
+        uint32_t spaces = w == 0 ? pick(3) : 1 + pick(2);
+        for (uint32_t i = 0; i < spaces; i++) line[length++] = ' ';
+        uint32_t kind = w == 0 ? pick(6) : pick(4);
+        if (kind == 0) {
+            length += random_number_text(&line[length]);
+        } else if (kind == 1) {
+            const char *word = junk[pick(sizeof(junk) / sizeof(junk[0]))];
+            memcpy(&line[length], word, strlen(word));
+            length += (uint32_t)strlen(word);
+        } else {
+            const char *word = commands[pick(command_count)].name;
+            if (w > 0 && pick(2)) word = mode_names[pick(4)];
+            memcpy(&line[length], word, strlen(word));
+            length += (uint32_t)strlen(word);
+        }
+    }
+    if (pick(4) == 0) line[length++] = ' ';
+    return length;
+}
+
+static void compare(const char *line, uint32_t length, uint32_t n) {
+    const command_t *command = NULL, *expected_command = NULL;
+    uint64_t values[COMMAND_MAX_ARGS] = { 0 }, expected_values[COMMAND_MAX_ARGS] = { 0 };
+    uint32_t bad = 0, expected_bad = 0;
+    command_result_t result = command_table_parse(&table, line, length, &command, values, &bad);
+    command_result_t expected = reference_parse(line, length, &expected_command, expected_values, &expected_bad);
+
+    CHECK(result == expected, "case %u \"%.*s\": result %d, expected %d", n, (int)length, line, result, expected);
+    if (result != expected) return;
+    if (result != COMMAND_UNKNOWN) {
+        CHECK(command == expected_command, "case %u \"%.*s\": command %s, expected %s", n, (int)length, line,
+              command ? command->name : "none", expected_command->name);
+    }
+    if (result == COMMAND_OK) {
+        CHECK(memcmp(values, expected_values, sizeof(values)) == 0, "case %u \"%.*s\": values %llu %llu %llu %llu",
+              n, (int)length, line, (unsigned long long)values[0], (unsigned long long)values[1],
+              (unsigned long long)values[2], (unsigned long long)values[3]);
+    } else if (result != COMMAND_UNKNOWN) {
+        CHECK(bad == expected_bad, "case %u \"%.*s\": argument %u at fault, expected %u", n, (int)length, line, bad,
+              expected_bad);
+    }
+}
+
+static void test_lines(void) {
+    uint32_t results[COMMAND_OUT_OF_RANGE + 1] = { 0 };
+    for (uint32_t n = 0; n < LINE_CASES; n++) {
+        char line[256];
+        uint32_t length = random_line(line);
+        compare(line, length, n);
+
+        const command_t *command;
+        uint64_t values[COMMAND_MAX_ARGS];
+        uint32_t bad;
+        results[command_table_parse(&table, line, length, &command, values, &bad)]++;
+    }
+    printf("%u random lines: %u ok, %u unknown, %u missing, %u bad, %u out of range\n", LINE_CASES,
+           results[COMMAND_OK], results[COMMAND_UNKNOWN], results[COMMAND_MISSING_ARG], results[COMMAND_BAD_ARG],
+           results[COMMAND_OUT_OF_RANGE]);
+}
+
+// Arbitrary bytes in a buffer of exactly the line's size
+static void test_bytes(void) {
+    for (uint32_t n = 0; n < BYTE_CASES; n++) {
+        uint32_t length = pick(40);
+        char *line = malloc(length ? length : 1);
+        for (uint32_t i = 0; i < length; i++) {
+            // Spaces and digits often enough to reach the argument parsing
+            uint32_t r = pick(8);
+            line[i] = r == 0 ? ' ' : r < 3 ? (char)('0' + pick(10)) : (char)pick(256);
+        }
+        // A known name in front half the time
+        if (length > 6 && pick(2)) memcpy(line, "burst ", 6);
+        compare(line, length, n);
+        free(line);
+    }
+    printf("%u random byte strings\n", BYTE_CASES);
+}
+
+static void test_names(void) {
+    uint32_t worst_probes = 0;
+    for (uint32_t i = 0; i < command_count; i++) {
+        const char *name = commands[i].name;
+        uint32_t length = (uint32_t)strlen(name);
+        CHECK(command_table_find(&table, name, length) == &commands[i], "%s not found", name);
+        for (uint32_t n = 0; n < length; n++) {
+            CHECK(command_table_find(&table, name, n) == NULL, "prefix \"%.*s\" of %s found", (int)n, name, name);
+        }
+        char longer[16];
+        snprintf(longer, sizeof(longer), "%sx", name);
+        CHECK(command_table_find(&table, longer, length + 1) == NULL, "%s found", longer);
+
+        // Slots from the home slot to the name's, as a lookup walks them
+        uint32_t h = 2166136261u;
+        for (uint32_t c = 0; c < length; c++) {
+            h ^= (uint8_t)name[c];
+            h *= 16777619u;
+        }
+        uint32_t slot = (h ^ (h >> 16)) & (COMMAND_TABLE_SLOTS - 1);
+        uint32_t probes = 1;
+        while (table.slots[slot] != i + 1) {
+            slot = (slot + 1) & (COMMAND_TABLE_SLOTS - 1);
+            probes++;
+        }
+        if (probes > worst_probes) worst_probes = probes;
+    }
+    printf("%u names in %u slots, longest lookup %u probes\n", (unsigned)command_count, COMMAND_TABLE_SLOTS,
+           worst_probes);
+}
+
+// Linear search, as a table without the hash index would do
+static const command_t *linear_find(const char *name, uint32_t length) {
+    for (uint32_t i = 0; i < command_count; i++) {
+        if (strncmp(commands[i].name, name, length) == 0 && commands[i].name[length] == '\0') return &commands[i];
+    }
+    return NULL;
+}
+
+static void benchmark(void) {
+    static const char *const lines[] = {
+        "freq 250k", "burst 12345 1M", "sweep 1k 100k 500 log", "duty 12.5", "status", "reset",
+        "mode uart", "stop", "sysclk 125000", "trace",
+    };
+    static const char *const numbers[] = { "250k", "1.5M", "12345", "12.5", "4G", "1000000" };
+    const uint32_t line_count = sizeof(lines) / sizeof(lines[0]);
+    const uint32_t number_count = sizeof(numbers) / sizeof(numbers[0]);
+    uint32_t lengths[sizeof(lines) / sizeof(lines[0])];
+    uint32_t name_lengths[sizeof(lines) / sizeof(lines[0])];
+    for (uint32_t i = 0; i < line_count; i++) {
+        lengths[i] = (uint32_t)strlen(lines[i]);
+        name_lengths[i] = (uint32_t)strcspn(lines[i], " ");
+    }
+    uintptr_t sink = 0;
+
+    double start = host_test_seconds();
+    for (uint32_t r = 0; r < BENCH_ROUNDS; r++) {
+        for (uint32_t i = 0; i < line_count; i++) {
+            sink += (uintptr_t)command_table_find(&table, lines[i], name_lengths[i]);
+        }
+    }
+    double hash_ns = (host_test_seconds() - start) * 1e9 / ((double)BENCH_ROUNDS * line_count);
+
+    start = host_test_seconds();
+    for (uint32_t r = 0; r < BENCH_ROUNDS; r++) {
+        for (uint32_t i = 0; i < line_count; i++) {
+            sink += (uintptr_t)linear_find(lines[i], name_lengths[i]);
+        }
+    }
+    double linear_ns = (host_test_seconds() - start) * 1e9 / ((double)BENCH_ROUNDS * line_count);
+
+    start = host_test_seconds();
+    for (uint32_t r = 0; r < BENCH_ROUNDS; r++) {
+        for (uint32_t i = 0; i < number_count; i++) {
+            uint64_t value;
+            sink += command_parse_number(numbers[i], (uint32_t)strlen(numbers[i]), r & 1, &value) ? value : 0;
+        }
+    }
+    double number_ns = (host_test_seconds() - start) * 1e9 / ((double)BENCH_ROUNDS * number_count);
+
+    start = host_test_seconds();
+    for (uint32_t r = 0; r < BENCH_ROUNDS; r++) {
+        for (uint32_t i = 0; i < line_count; i++) {
+            const command_t *command;
+            uint64_t values[COMMAND_MAX_ARGS];
+            uint32_t bad;
+            sink += command_table_parse(&table, lines[i], lengths[i], &command, values, &bad);
+        }
+    }
+    double line_ns = (host_test_seconds() - start) * 1e9 / ((double)BENCH_ROUNDS * line_count);
+
+    CHECK(sink != 0, "benchmark optimised away");
+    printf("name lookup: hash %.1f ns, linear search %.1f ns per call\n", hash_ns, linear_ns);
+    printf("number %.1f ns, whole line %.1f ns per call\n", number_ns, line_ns);
+}
+
+int main(void) {
+    commands = uart_control_commands(&command_count);
+    command_table_init(&table, commands, command_count);
+    mode_names = command_table_find(&table, "mode", 4)->args[0].keywords;
+    test_names();
+    test_numbers();
+    test_lines();
+    test_bytes();
+    benchmark();
+    return host_test_finish("test_command_table");
+}
@@ -0,0 +1,341 @@
+/**
+ * Control arbiter test
+ *
+ * Links the arbiter on its own, with the mode, clock core, UART clock, reset
+ * and power calls it makes replaced by stubs that count them, and moves time
+ * by hand. After a front-panel action every remote request from every port
+ * must be refused, changing nothing, until CONTROL_PANEL_HOLDOFF_MS has
+ * passed, and a second action must start the hold-off again. A held mode
+ * button must refuse them however long ago the last action was. Requests
+ * from UART0, UART1 and USB interleaved with each other, and with panel
+ * actions, must each run once and be credited to the port that made them.
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "host_test.h"
+#include "config.h"
+#include "control_arbiter.h"
+#include "button_handler.h"
+#include "clock_core.h"
+#include "power_control.h"
+#include "reset_control.h"
+#include "sys_clock.h"
+#include "uart_control.h"
+
+#define HOLDOFF_US  (CONTROL_PANEL_HOLDOFF_MS * 1000ull)
+
+// Stubs for everything the arbiter calls; calls counts the ones that
+// change the outputs
+
+static uint64_t now_us = 0;
+static bool button_held = false;
+static clock_mode_t mode = MODE_SINGLE_STEP;
+static bool power_state = false;
+static bool uart_running = false;
+static uint32_t uart_frequency = 0;
+static uint32_t calls = 0;
+static uint32_t mode_changes = 0;
+
+uint64_t time_us_64(void) {
+    return now_us;
+}
+
+bool any_button_pressed(void) {
+    return button_held;
+}
+
+clock_mode_t get_current_mode(void) {
+    return mode;
+}
+
+void set_mode(clock_mode_t new_mode) {
+    mode = new_mode;
+    mode_changes++;
+    calls++;
+}
+
+void clock_core_post(clock_core_cmd_t cmd, uint32_t arg) {
+    (void)cmd;
+    (void)arg;
+    calls++;
+}
+
+void clock_core_sync(void) {
+}
+
+bool get_reset_active(void) {
+    return false;
+}
+
+void set_power_state(bool state) {
+    power_state = state;
+    calls++;
+}
+
+bool get_power_state(void) {
+    return power_state;
+}
+
+void sys_clock_set_retune(bool enabled) {
+    (void)enabled;
+    calls++;
+}
+
+bool get_uart_clock_running(void) {
+    return uart_running;
+}
+
+uint32_t get_uart_set_frequency(void) {
+    return uart_frequency;
+}
+
+void uart_control_freq(uint32_t frequency) {
+    uart_frequency = frequency;
+    uart_running = true;
+    calls++;
+}
+
+void uart_control_stop(void) {
+    uart_running = false;
+    calls++;
+}
+
+void uart_control_burst(uint64_t cycles, uint32_t frequency) {
+    (void)cycles;
+    (void)frequency;
+    uart_running = false;
+    calls++;
+}
+
+void uart_control_sweep(const sweep_plan_t *plan, uint32_t dwell_us) {
+    (void)plan;
+    (void)dwell_us;
+    uart_running = false;
+    calls++;
+}
+
+bool uart_control_toggle(void) {
+    uart_running = false;
+    calls++;
+    return true;
+}
+
+// Every request a remote port can make
+
+static control_arbiter_result_t request_mode(control_source_t source) {
+    return control_arbiter_mode(source, MODE_LOW_FREQ);
+}
+
+static control_arbiter_result_t request_step(control_source_t source) {
+    return control_arbiter_step(source);
+}
+
+static control_arbiter_result_t request_freq(control_source_t source) {
+    return control_arbiter_freq(source, 1000);
+}
+
+static control_arbiter_result_t request_burst(control_source_t source) {
+    return control_arbiter_burst(source, 10, 1000);
+}
+
+static control_arbiter_result_t request_sweep(control_source_t source) {
+    static const sweep_plan_t plan = { 0 };
+    return control_arbiter_sweep(source, &plan, 1000);
+}
+
+static control_arbiter_result_t request_stop(control_source_t source) {
+    return control_arbiter_stop(source);
+}
+
+static control_arbiter_result_t request_toggle(control_source_t source) {
+    bool level;
+    return control_arbiter_toggle(source, &level);
+}
+
+static control_arbiter_result_t request_reset(control_source_t source) {
+    bool released;
+    return control_arbiter_reset(source, RESET_CYCLES, &released);
+}
+
+static control_arbiter_result_t request_power(control_source_t source) {
+    bool switched_mode;
+    return control_arbiter_power(source, !power_state, &switched_mode);
+}
+
+static control_arbiter_result_t request_dead_time(control_source_t source) {
+    return control_arbiter_dead_time(source, PHI_DEAD_TIME_TICKS);
+}
+
+static control_arbiter_result_t request_high_freq(control_source_t source) {
+    return control_arbiter_high_freq(source, 1000000);
+}
+
+static control_arbiter_result_t request_sys_clock(control_source_t source) {
+    return control_arbiter_sys_clock(source, 125000);
+}
+
+static control_arbiter_result_t request_duty(control_source_t source) {
+    return control_arbiter_duty(source, DUTY_CYCLE_RATIO, DUTY_CYCLE_SCALE / 2);
+}
+
+static control_arbiter_result_t request_wait(control_source_t source) {
+    return control_arbiter_wait(source, true);
+}
+
+typedef struct {
+    const char *name;
+    control_arbiter_result_t (*run)(control_source_t source);
+} request_t;
+
+static const request_t requests[] = {
+    { "mode", request_mode },
+    { "step", request_step },
+    { "freq", request_freq },
+    { "burst", request_burst },
+    { "sweep", request_sweep },
+    { "stop", request_stop },
+    { "toggle", request_toggle },
+    { "reset", request_reset },
+    { "power", request_power },
+    { "deadtime", request_dead_time },
+    { "highfreq", request_high_freq },
+    { "sysclock", request_sys_clock },
+    { "duty", request_duty },
+    { "wait", request_wait },
+};
+
+#define REQUEST_COUNT (sizeof(requests) / sizeof(requests[0]))
+
+static const control_source_t remote_sources[] = { CONTROL_SOURCE_UART0, CONTROL_SOURCE_UART1, CONTROL_SOURCE_USB };
+
+static void start(void) {
+    now_us = 1000000;
+    button_held = false;
+    mode = MODE_SINGLE_STEP;
+    power_state = false;
+    uart_running = false;
+    control_arbiter_init();
+}
+
+// Every request from every port must be refused without calling anything
+static void check_all_refused(const char *name) {
+    uint32_t before = calls;
+    for (uint32_t s = 0; s < 3; s++) {
+        for (uint32_t r = 0; r < REQUEST_COUNT; r++) {
+            control_arbiter_result_t result = requests[r].run(remote_sources[s]);
+            CHECK(result == CONTROL_ARBITER_PANEL_IN_USE, "%s: %s from %s accepted", name, requests[r].name,
+                  control_arbiter_source_name(remote_sources[s]));
+        }
+    }
+    CHECK(calls == before, "%s: refused requests made %u calls", name, calls - before);
+    CHECK(control_arbiter_last_source() == CONTROL_SOURCE_PANEL, "%s: last source is %s", name,
+          control_arbiter_source_name(control_arbiter_last_source()));
+}
+
+// One request must run, and be credited to its port
+static void check_accepted(const char *name, const request_t *request, control_source_t source) {
+    uint32_t before = calls;
+    control_arbiter_result_t result = request->run(source);
+    CHECK(result == CONTROL_ARBITER_OK, "%s: %s from %s refused", name, request->name,
+          control_arbiter_source_name(source));
+    CHECK(calls > before, "%s: %s from %s did nothing", name, request->name, control_arbiter_source_name(source));
+    CHECK(control_arbiter_last_source() == source, "%s: %s from %s credited to %s", name, request->name,
+          control_arbiter_source_name(source), control_arbiter_source_name(control_arbiter_last_source()));
+}
+
+// A panel action, then remote requests over the whole hold-off
+static void test_holdoff(void) {
+    start();
+    uint64_t pressed = now_us;
+    CHECK(control_arbiter_step(CONTROL_SOURCE_PANEL) == CONTROL_ARBITER_OK, "panel step refused");
+    check_all_refused("at the panel action");
+
+    now_us = pressed + HOLDOFF_US / 2;
+    check_all_refused("half way through the hold-off");
+
+    now_us = pressed + HOLDOFF_US - 1;
+    check_all_refused("last microsecond of the hold-off");
+
+    now_us = pressed + HOLDOFF_US;
+    check_accepted("hold-off over", &requests[2], CONTROL_SOURCE_UART1);
+    CHECK(mode == MODE_UART_CONTROL, "freq left the mode at %d", mode);
+
+    // The panel wins again at once, even over a running clock
+    now_us += 1000;
+    pressed = now_us;
+    CHECK(control_arbiter_mode(CONTROL_SOURCE_PANEL, MODE_HIGH_FREQ) == CONTROL_ARBITER_OK, "panel mode refused");
+    CHECK(mode == MODE_HIGH_FREQ, "panel mode change left the mode at %d", mode);
+    check_all_refused("after a panel mode change");
+
+    // A second action restarts the hold-off
+    now_us = pressed + HOLDOFF_US - 1000;
+    bool released;
+    CHECK(control_arbiter_reset(CONTROL_SOURCE_PANEL, RESET_CYCLES, &released) == CONTROL_ARBITER_OK,
+          "panel reset refused");
+    now_us = pressed + HOLDOFF_US;
+    check_all_refused("hold-off restarted");
+    now_us = pressed + 2 * HOLDOFF_US - 1000;
+    check_accepted("restarted hold-off over", &requests[5], CONTROL_SOURCE_USB);
+}
+
+// A mode button held down refuses remote requests however long it is held
+static void test_button_held(void) {
+    start();
+    CHECK(control_arbiter_step(CONTROL_SOURCE_PANEL) == CONTROL_ARBITER_OK, "panel step refused");
+    button_held = true;
+    now_us += 10 * HOLDOFF_US;
+    check_all_refused("button held");
+
+    // The panel itself still gets through
+    CHECK(control_arbiter_step(CONTROL_SOURCE_PANEL) == CONTROL_ARBITER_OK, "panel step refused with a button held");
+    button_held = false;
+    now_us += HOLDOFF_US;
+    check_accepted("button released", &requests[0], CONTROL_SOURCE_UART0);
+}
+
+// The three ports in turn, a request each, with the panel cutting in
+static void test_concurrent_sources(void) {
+    start();
+    now_us += HOLDOFF_US;
+    for (uint32_t r = 0; r < REQUEST_COUNT; r++) {
+        for (uint32_t s = 0; s < 3; s++) {
+            now_us += 10;
+            check_accepted("interleaved", &requests[(r + s) % REQUEST_COUNT], remote_sources[s]);
+        }
+    }
+
+    // Clock commands select UART Control Mode once, not once per port
+    mode = MODE_SINGLE_STEP;
+    uint32_t before = mode_changes;
+    for (uint32_t s = 0; s < 3; s++) {
+        check_accepted("clock commands", &requests[2], remote_sources[s]);
+    }
+    CHECK(mode_changes == before + 1, "three ports' freq changed the mode %u times", mode_changes - before);
+
+    // The panel between two ports' requests shuts out both
+    now_us += 10;
+    bool switched_mode;
+    CHECK(control_arbiter_power(CONTROL_SOURCE_PANEL, !power_state, &switched_mode) == CONTROL_ARBITER_OK,
+          "panel power refused");
+    uint64_t pressed = now_us;
+    for (uint32_t s = 0; s < 3; s++) {
+        now_us += 10;
+        CHECK(request_stop(remote_sources[s]) == CONTROL_ARBITER_PANEL_IN_USE, "stop from %s after the panel",
+              control_arbiter_source_name(remote_sources[s]));
+    }
+    CHECK(control_arbiter_last_source() == CONTROL_SOURCE_PANEL, "last source is %s",
+          control_arbiter_source_name(control_arbiter_last_source()));
+    now_us = pressed + HOLDOFF_US;
+    for (uint32_t s = 3; s-- > 0; ) {
+        check_accepted("after the panel", &requests[5], remote_sources[s]);
+    }
+}
+
+int main(void) {
+    test_holdoff();
+    test_button_held();
+    test_concurrent_sources();
+    CHECK(control_arbiter_source_name(CONTROL_SOURCE_COUNT)[0] == '?', "name for an unknown source");
+    return host_test_finish("test_control_arbiter");
+}
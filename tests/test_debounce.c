@@ -0,0 +1,151 @@
+/**
+ * Debounce trace replay test
+ *
+ * Replays recorded bounce traces through the debouncer the way
+ * update_button_state() drives it: edges are handled in passes, each fed
+ * with its own timestamp by debounce_feed(), then the debouncer is polled
+ * at the pass time. Every trace must give the same presses whether core0
+ * handles edges within a millisecond or only after being blocked for longer
+ * than the hold-off, end released, and still see the next press. Each trace
+ * is also run across the 32-bit timer wrap.
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include "host_test.h"
+#include "debounce.h"
+
+#define HOLDOFF_US  50000u
+
+typedef struct {
+    uint32_t time_us;
+    bool pressed;           // Line state after the edge
+} trace_edge_t;
+
+typedef struct {
+    const char *name;
+    const trace_edge_t *edges;
+    size_t count;
+    uint32_t presses;
+} trace_t;
+
+// A clean tap
+static const trace_edge_t clean[] = {
+    { 0, true }, { 200000, false },
+};
+
+// Contact bounce on both edges; the press is reported at its first edge
+static const trace_edge_t bouncy[] = {
+    { 0, true }, { 300, false }, { 700, true }, { 1200, false }, { 2000, true },
+    { 300000, false }, { 300400, true }, { 301000, false }, { 301300, true }, { 302000, false },
+};
+
+// A spurious edge just before the press (a bounce the interrupt saw as one
+// edge), so the press only settles after the hold-off; a clean release
+static const trace_edge_t late_press[] = {
+    { 0, false }, { 10000, true }, { 10500, false }, { 11000, true },
+    { 200000, false },
+};
+
+// The same with a bouncing release
+static const trace_edge_t late_press_bouncy[] = {
+    { 0, false }, { 10000, true }, { 10500, false }, { 11000, true },
+    { 200000, false }, { 200600, true }, { 201000, false },
+};
+
+// A second tap soon after the first settles, both bouncing
+static const trace_edge_t double_tap[] = {
+    { 0, true }, { 500, false }, { 900, true },
+    { 90000, false }, { 90400, true }, { 91000, false },
+    { 150000, true }, { 150300, false }, { 150800, true },
+    { 240000, false }, { 240200, true }, { 240900, false },
+};
+
+// A long hold with bounce mid-way
+static const trace_edge_t hold[] = {
+    { 0, true }, { 1000000, false }, { 1000200, true },
+    { 3000000, false }, { 3000500, true }, { 3001000, false },
+};
+
+#define TRACE(edges, presses) { #edges, edges, sizeof(edges) / sizeof(edges[0]), presses }
+
+static const trace_t traces[] = {
+    TRACE(clean, 1),
+    TRACE(bouncy, 1),
+    TRACE(late_press, 1),
+    TRACE(late_press_bouncy, 1),
+    TRACE(double_tap, 2),
+    TRACE(hold, 1),
+};
+
+typedef struct {
+    uint32_t presses;
+    bool pressed;
+} replay_result_t;
+
+// A release settling just before a press's edge is folded into the press,
+// as update_button_state() only looks for presses
+static void count(replay_result_t *r, debounce_event_t event) {
+    if (event == DEBOUNCE_PRESS) r->presses++;
+}
+
+// One pass of update_button_state(): queued edges, then a poll
+static void pass(debounce_t *d, const trace_t *trace, size_t *next, uint32_t base, uint32_t now,
+                 replay_result_t *r) {
+    while (*next < trace->count && trace->edges[*next].time_us <= now - base) {
+        const trace_edge_t *edge = &trace->edges[*next];
+        count(r, debounce_feed(d, edge->pressed, base + edge->time_us));
+        (*next)++;
+    }
+    count(r, debounce_poll(d, now));
+}
+
+// Replay a trace with passes every pass_us, starting at time base
+static replay_result_t replay(const trace_t *trace, uint32_t base, uint32_t pass_us) {
+    replay_result_t r = { 0, false };
+    debounce_t d;
+    debounce_init(&d, false, base, HOLDOFF_US);
+
+    uint32_t end = trace->edges[trace->count - 1].time_us + 2 * HOLDOFF_US;
+    size_t next = 0;
+    for (uint32_t t = pass_us; ; t += pass_us) {
+        uint32_t at = t < end ? t : end;
+        pass(&d, trace, &next, base, base + at, &r);
+        if (at == end) break;
+    }
+
+    r.pressed = d.pressed;
+
+    // The next clean tap is seen as one press, and released
+    uint32_t tap = end + 10000;
+    CHECK(debounce_feed(&d, true, base + tap) == DEBOUNCE_PRESS, "%s: next press missed", trace->name);
+    CHECK(debounce_feed(&d, false, base + tap + 100000) == DEBOUNCE_NONE, "%s: next release early", trace->name);
+    CHECK(debounce_poll(&d, base + tap + 100000 + HOLDOFF_US) == DEBOUNCE_RELEASE, "%s: next release missed",
+          trace->name);
+    return r;
+}
+
+int main(void) {
+    // Core0 handling edges at once, and blocked past the hold-off
+    static const uint32_t pass_intervals[] = { 1000, 20000, 75000, 500000, UINT32_MAX / 2 };
+    static const uint32_t bases[] = { 0, 0xFFFFFFFFu - 150000u };
+    uint32_t replays = 0;
+
+    for (size_t t = 0; t < sizeof(traces) / sizeof(traces[0]); t++) {
+        const trace_t *trace = &traces[t];
+        for (size_t b = 0; b < sizeof(bases) / sizeof(bases[0]); b++) {
+            for (size_t p = 0; p < sizeof(pass_intervals) / sizeof(pass_intervals[0]); p++) {
+                replay_result_t r = replay(trace, bases[b], pass_intervals[p]);
+                CHECK(r.presses == trace->presses, "%s, passes every %u us from %u: %u presses, expected %u",
+                      trace->name, pass_intervals[p], bases[b], r.presses, trace->presses);
+                CHECK(!r.pressed, "%s, passes every %u us from %u: left pressed", trace->name,
+                      pass_intervals[p], bases[b]);
+                replays++;
+            }
+        }
+    }
+
+    printf("%u replays of %u traces\n", replays, (unsigned)(sizeof(traces) / sizeof(traces[0])));
+    return host_test_finish("test_debounce");
+}
@@ -0,0 +1,255 @@
+/**
+ * Discipline loop test
+ *
+ * Runs the loop the way the discipline drives it, against a simulated
+ * crystal and a 1PPS reference: a gapless reciprocal count of system clock
+ * cycles per reference period, with Gaussian jitter on the reference edges,
+ * each reading fed with the trim the engines ran on during it. The first
+ * reading must start the loop at the crystal's offset. Lock must be
+ * reported exactly after DISCIPLINE_LOCK_READINGS readings in a row within
+ * DISCIPLINE_LOCK_NS, and once settled the loop must stay locked with the
+ * trim on the offset. A frequency step that gains more than
+ * DISCIPLINE_SLIP_NS in one reading must start the loop over, and a
+ * smaller one must be pulled in without. After a lost reference (no
+ * readings for DISCIPLINE_TIMEOUT_MS) the trim must be held, and the loop
+ * must relock without starting over. A reading beyond DISCIPLINE_MAX_PPM
+ * must be refused and leave the loop untouched.
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <math.h>
+#include "host_test.h"
+#include "config.h"
+#include "discipline_loop.h"
+
+#define SYS_HZ          125000000u
+#define REF_HZ          1u
+#define JITTER_NS       20.0        // Standard deviation of a reference edge
+#define LOCK_READINGS   (10u * DISCIPLINE_TIME_CONSTANT_S)  // Lock must come sooner
+#define SETTLE_READINGS (10u * DISCIPLINE_TIME_CONSTANT_S)  // For the first estimate's error to pull in
+#define STEADY_READINGS 1000u
+#define FIRST_TRIM_PPB  150         // First reading: two edges' jitter at four sigma, plus a cycle
+#define TRIM_PPB        8           // Settled trim against the crystal offset
+
+static uint64_t rng_state = 0x2545F4914F6CDD1Dull;
+
+static double uniform(void) {
+    rng_state ^= rng_state << 13;
+    rng_state ^= rng_state >> 7;
+    rng_state ^= rng_state << 17;
+    return ((double)(rng_state >> 11) + 0.5) / 9007199254740992.0;
+}
+
+static double gaussian(void) {
+    return sqrt(-2.0 * log(uniform())) * cos(2.0 * M_PI * uniform());
+}
+
+// The crystal and the reference counter. Cycles are counted from one
+// reference edge to the next without a gap, so rounding to whole cycles
+// never adds up over readings.
+typedef struct {
+    double crystal_ppm;         // Offset of clk_sys from SYS_HZ
+    uint32_t edges;             // Reference periods so far
+    double seconds;             // Reference time of the last edge
+    double sys_cycles;          // Clock cycles at the last edge, unrounded
+    uint64_t counted;           // Whole cycles at the last edge
+} bench_t;
+
+static discipline_loop_t loop;
+static bench_t bench;
+static int32_t trim_ppb;        // Trim the engines run on
+static uint32_t quiet;          // Readings in a row within DISCIPLINE_LOCK_NS, as seen here
+
+static void start(double crystal_ppm) {
+    discipline_loop_init(&loop);
+    bench = (bench_t){ .crystal_ppm = crystal_ppm };
+    trim_ppb = 0;
+    quiet = 0;
+}
+
+// Count the next reference period; each edge comes late or early by its
+// own jitter
+static uint64_t count_period(void) {
+    double edge = (double)++bench.edges / REF_HZ + JITTER_NS * 1e-9 * gaussian();
+    bench.sys_cycles += (edge - bench.seconds) * SYS_HZ * (1.0 + bench.crystal_ppm * 1e-6);
+    bench.seconds = edge;
+    uint64_t counted = (uint64_t)bench.sys_cycles;
+    uint64_t cycles = counted - bench.counted;
+    bench.counted = counted;
+    return cycles;
+}
+
+// One reading through the loop, as take_reading() does it. Lock must be
+// reported exactly when the last DISCIPLINE_LOCK_READINGS readings since
+// the loop started all had the phase within DISCIPLINE_LOCK_NS.
+static discipline_loop_result_t reading(const char *name) {
+    int64_t offset_ppt = discipline_loop_offset_ppt(SYS_HZ, REF_HZ, REF_HZ, count_period());
+    discipline_loop_result_t result = discipline_loop_update(&loop, offset_ppt, 1000000000ull, trim_ppb);
+    if (result == DISCIPLINE_LOOP_OUT_OF_RANGE) return result;
+
+    trim_ppb = discipline_loop_trim_ppb(&loop);
+    if (result == DISCIPLINE_LOOP_STARTED) {
+        quiet = 0;
+    } else if (llabs(loop.phase_ps) <= DISCIPLINE_LOCK_NS * 1000ll) {
+        quiet++;
+    } else {
+        quiet = 0;
+    }
+    CHECK(discipline_loop_locked(&loop) == (quiet >= DISCIPLINE_LOCK_READINGS), "%s: locked %d with %u quiet readings",
+          name, discipline_loop_locked(&loop), quiet);
+    return result;
+}
+
+// Readings with no slip in between
+static void track(const char *name, uint32_t readings) {
+    for (uint32_t n = 0; n < readings; n++) {
+        discipline_loop_result_t result = reading(name);
+        CHECK(result == DISCIPLINE_LOOP_TRACKING, "%s: reading %u gave %d", name, n, result);
+    }
+}
+
+// A lost reference: the counter starts again at the next edge, and the
+// phase with it
+static void lose_reference(uint32_t seconds) {
+    for (uint32_t i = 0; i < seconds; i++) count_period();
+    discipline_loop_restart(&loop);
+    quiet = 0;
+}
+
+// Readings until locked, all tracking
+static uint32_t readings_to_lock(const char *name) {
+    for (uint32_t n = 1; n <= LOCK_READINGS; n++) {
+        track(name, 1);
+        if (discipline_loop_locked(&loop)) return n;
+    }
+    CHECK(false, "%s: not locked after %u readings", name, LOCK_READINGS);
+    return LOCK_READINGS;
+}
+
+// The trim against the crystal offset, in ppb
+static int32_t trim_error_ppb(void) {
+    return trim_ppb - (int32_t)lround(bench.crystal_ppm * 1000.0);
+}
+
+// Settled: stays locked through the jitter with the trim on the offset
+static void check_steady(const char *name) {
+    track(name, SETTLE_READINGS);
+    int32_t worst_ppb = 0;
+    int64_t worst_ps = 0;
+    for (uint32_t n = 0; n < STEADY_READINGS; n++) {
+        CHECK(reading(name) == DISCIPLINE_LOOP_TRACKING && discipline_loop_locked(&loop), "%s: lost lock at reading %u",
+              name, n);
+        int32_t error = abs(trim_error_ppb());
+        if (error > worst_ppb) worst_ppb = error;
+        if (llabs(loop.phase_ps) > worst_ps) worst_ps = llabs(loop.phase_ps);
+    }
+    CHECK(worst_ppb <= TRIM_PPB, "%s: trim off by up to %d ppb", name, worst_ppb);
+    printf("%s: trim within %d ppb, phase within %.3f ns over %u readings\n", name, worst_ppb, worst_ps / 1000.0,
+           STEADY_READINGS);
+}
+
+static void test_offset_ppt(void) {
+    CHECK(discipline_loop_offset_ppt(SYS_HZ, 1, 1, SYS_HZ) == 0, "nominal clock not 0 ppt");
+    CHECK(discipline_loop_offset_ppt(SYS_HZ, 1, 1, SYS_HZ + 1250) == 10000000, "10 ppm fast gave %lld ppt",
+          (long long)discipline_loop_offset_ppt(SYS_HZ, 1, 1, SYS_HZ + 1250));
+    CHECK(discipline_loop_offset_ppt(SYS_HZ, 10000000, 10000000, SYS_HZ - 1) == -8000,
+          "one cycle slow in a second gave %lld ppt", (long long)discipline_loop_offset_ppt(SYS_HZ, 10000000,
+                                                                                              10000000, SYS_HZ - 1));
+}
+
+// First reading, lock and steady tracking, at offsets either side
+static void test_acquire(double crystal_ppm) {
+    char name[48];
+    snprintf(name, sizeof(name), "acquire at %+.3f ppm", crystal_ppm);
+    start(crystal_ppm);
+    CHECK(discipline_loop_trim_ppb(&loop) == 0 && !discipline_loop_locked(&loop), "%s: trim before a reading", name);
+
+    // The first reading is the estimate, to the count's resolution
+    CHECK(reading(name) == DISCIPLINE_LOOP_STARTED, "%s: first reading did not start the loop", name);
+    CHECK(abs(trim_error_ppb()) <= FIRST_TRIM_PPB, "%s: first trim off by %d ppb", name, trim_error_ppb());
+    CHECK(!discipline_loop_locked(&loop), "%s: locked on the first reading", name);
+
+    printf("%s: locked after %u more readings\n", name, readings_to_lock(name));
+    check_steady(name);
+}
+
+// Frequency steps, as from a knock or a draught on the crystal
+static void test_slip(void) {
+    start(-10.0);
+    reading("slip");
+    check_steady("slip");
+
+    // Half a ppm gains 500 ns a reading, and the phase stays inside
+    // DISCIPLINE_SLIP_NS while it is pulled in
+    bench.crystal_ppm += 0.5;
+    CHECK(reading("0.5 ppm step") == DISCIPLINE_LOOP_TRACKING, "0.5 ppm step started the loop over");
+    CHECK(!discipline_loop_locked(&loop), "still locked after a 0.5 ppm step");
+    track("0.5 ppm step", SETTLE_READINGS);
+    check_steady("after a 0.5 ppm step");
+
+    // 20 ppm is beyond DISCIPLINE_SLIP_NS: the reading becomes the estimate
+    bench.crystal_ppm += 20.0;
+    CHECK(reading("20 ppm step") == DISCIPLINE_LOOP_STARTED, "20 ppm step did not start the loop over");
+    CHECK(loop.phase_ps == 0 && !discipline_loop_locked(&loop), "slip kept the phase or the lock");
+    CHECK(abs(trim_error_ppb()) <= FIRST_TRIM_PPB, "trim off by %d ppb after the slip", trim_error_ppb());
+    printf("20 ppm step: relocked after %u readings\n", readings_to_lock("20 ppm step"));
+    check_steady("after a 20 ppm step");
+}
+
+// The reference goes away for longer than DISCIPLINE_TIMEOUT_MS
+static void test_holdover(void) {
+    start(37.5);
+    reading("holdover");
+    check_steady("before holdover");
+
+    int32_t held = trim_ppb;
+    lose_reference(60);
+    CHECK(discipline_loop_trim_ppb(&loop) == held, "holdover trim %d ppb, was %d ppb", discipline_loop_trim_ppb(&loop),
+          held);
+    CHECK(!discipline_loop_locked(&loop), "still locked in holdover");
+
+    // Still on frequency, so the loop picks up where it was and relocks as
+    // soon as it can
+    uint32_t readings = readings_to_lock("after holdover");
+    CHECK(readings == DISCIPLINE_LOCK_READINGS, "relocked after %u readings", readings);
+    check_steady("after holdover");
+}
+
+// A reference far off its set frequency, or a wrong one
+static void test_out_of_range(void) {
+    start(DISCIPLINE_MAX_PPM + 1.0);
+    CHECK(reading("out of range") == DISCIPLINE_LOOP_OUT_OF_RANGE, "%u ppm accepted", DISCIPLINE_MAX_PPM + 1);
+    CHECK(!loop.running && discipline_loop_trim_ppb(&loop) == 0, "refused first reading started the loop");
+
+    start(DISCIPLINE_MAX_PPM - 1.0);
+    CHECK(reading("in range") == DISCIPLINE_LOOP_STARTED, "%u ppm refused", DISCIPLINE_MAX_PPM - 1);
+
+    // Locked, then a reading from a wrong reference changes nothing
+    start(-50.0);
+    reading("out of range");
+    readings_to_lock("out of range");
+    discipline_loop_t before = loop;
+    int64_t wrong_ppt[] = { (DISCIPLINE_MAX_PPM + 1) * 1000000ll, -(DISCIPLINE_MAX_PPM + 1) * 1000000ll,
+                            1000000000000ll, -500000000000ll };
+    for (uint32_t i = 0; i < sizeof(wrong_ppt) / sizeof(wrong_ppt[0]); i++) {
+        CHECK(discipline_loop_update(&loop, wrong_ppt[i], 1000000000ull, trim_ppb) == DISCIPLINE_LOOP_OUT_OF_RANGE,
+              "%lld ppt accepted", (long long)wrong_ppt[i]);
+        CHECK(loop.running == before.running && loop.phase_ps == before.phase_ps &&
+              loop.frequency_ppt == before.frequency_ppt && loop.quiet == before.quiet,
+              "%lld ppt changed the loop", (long long)wrong_ppt[i]);
+    }
+    check_steady("after refused readings");
+}
+
+int main(void) {
+    test_offset_ppt();
+    test_acquire(10.0);
+    test_acquire(-123.456);
+    test_acquire(0.0);
+    test_slip();
+    test_holdover();
+    test_out_of_range();
+    return host_test_finish("test_discipline_loop");
+}
@@ -0,0 +1,355 @@
+/**
+ * Line assembler test
+ *
+ * Feeds a receive ring the way the UART interrupt does and takes lines out
+ * the way control_port.c does. CR, LF and CR LF must each end one line, even
+ * with the LF arriving later; backspace and DEL must edit the line and echo
+ * the erase; a line that wraps the end of the ring or was edited must be
+ * rebuilt, and any other handed over in place. Lines longer than the scratch
+ * buffer are cut short, and a line with no terminator is dropped before it
+ * fills the ring. A chunk into a nearly full ring keeps what fits and
+ * counts only the rest as dropped. Random scripts in random chunks are
+ * checked against a plain model of the editing, and a pasted script is
+ * pushed through at the firmware's ring and line sizes to time it against
+ * the UART's byte rate.
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include "host_test.h"
+#include "config.h"
+#include "byte_ring.h"
+#include "line_assembler.h"
+
+#define RING_SIZE       64u
+#define SCRATCH_SIZE    16u
+#define MAX_LINES       64u
+#define RANDOM_SCRIPTS  20000u
+#define PASTE_BYTES     (64u * 1024u * 1024u)
+#define FIFO_CHUNK      32u         // drain_fifo() writes at most this much at once
+
+typedef struct {
+    byte_ring_t ring;
+    uint8_t storage[UART_RX_BUFFER_SIZE];
+    line_assembler_t lines;
+    char scratch[UART_CMD_BUFFER_SIZE];
+    char echo[256];
+    uint32_t echo_length;
+    char got[MAX_LINES][UART_CMD_BUFFER_SIZE + 1];
+    bool in_place[MAX_LINES];
+    uint32_t count;
+} harness_t;
+
+static void echo(void *context, const char *text, uint32_t length) {
+    harness_t *h = context;
+    if (h->echo_length + length < sizeof(h->echo)) {
+        memcpy(&h->echo[h->echo_length], text, length);
+        h->echo_length += length;
+        h->echo[h->echo_length] = '\0';
+    }
+}
+
+static void setup(harness_t *h, uint32_t ring_size, uint32_t scratch_size) {
+    memset(h, 0, sizeof(*h));
+    byte_ring_init(&h->ring, h->storage, ring_size);
+    line_assembler_init(&h->lines, h->scratch, scratch_size);
+}
+
+// Take every ready line out, as poll_port() does
+static void drain(harness_t *h) {
+    const char *line;
+    uint32_t length;
+    while (line_assembler_next(&h->lines, &h->ring, echo, h, &line, &length)) {
+        if (h->count < MAX_LINES) {
+            memcpy(h->got[h->count], line, length);
+            h->got[h->count][length] = '\0';
+            h->in_place[h->count] = line != h->scratch;
+            h->count++;
+        }
+        line_assembler_release(&h->lines, &h->ring);
+    }
+}
+
+static void feed(harness_t *h, const char *text) {
+    CHECK(byte_ring_write(&h->ring, text, (uint32_t)strlen(text)), "ring full writing \"%s\"", text);
+    drain(h);
+}
+
+static void expect_lines(const harness_t *h, const char *what, const char *const *lines, uint32_t count) {
+    CHECK(h->count == count, "%s: %u lines, expected %u", what, h->count, count);
+    for (uint32_t i = 0; i < count && i < h->count; i++) {
+        CHECK(strcmp(h->got[i], lines[i]) == 0, "%s: line %u \"%s\", expected \"%s\"", what, i, h->got[i],
+              lines[i]);
+    }
+}
+
+#define EXPECT(h, what, ...) do { \
+        static const char *const lines_[] = { __VA_ARGS__ }; \
+        expect_lines(h, what, lines_, sizeof(lines_) / sizeof(lines_[0])); \
+    } while (0)
+
+static void test_terminators(void) {
+    harness_t h;
+    setup(&h, RING_SIZE, SCRATCH_SIZE);
+    feed(&h, "one\rtwo\nthree\r\n\r\nfour\n\n\rfive\r\r");
+    EXPECT(&h, "terminators", "one", "two", "three", "", "four", "", "", "five", "");
+    CHECK(byte_ring_used(&h.ring) == 0, "terminators: %u bytes left queued", byte_ring_used(&h.ring));
+
+    // The LF of a CR LF split across reads is still not a line
+    setup(&h, RING_SIZE, SCRATCH_SIZE);
+    feed(&h, "stop\r");
+    feed(&h, "\n");
+    feed(&h, "freq 1");
+    CHECK(!line_assembler_idle(&h.lines), "idle in the middle of a line");
+    feed(&h, "0\r");
+    feed(&h, "\nstatus\n");
+    EXPECT(&h, "split CR LF", "stop", "freq 10", "status");
+    CHECK(line_assembler_idle(&h.lines), "not idle between lines");
+    CHECK(h.in_place[0] && h.in_place[1] && h.in_place[2], "split CR LF: unedited line rebuilt");
+    CHECK(strcmp(h.echo, "stopfreq 10status") == 0, "split CR LF: echoed \"%s\"", h.echo);
+}
+
+static void test_editing(void) {
+    harness_t h;
+    setup(&h, RING_SIZE, SCRATCH_SIZE);
+    feed(&h, "dwelx\bl 5\r");
+    EXPECT(&h, "backspace", "dwell 5");
+    CHECK(!h.in_place[0], "backspace: edited line handed over in place");
+    CHECK(strcmp(h.echo, "dwelx\b \bl 5") == 0, "backspace: echoed \"%s\"", h.echo);
+
+    // Erasing past the start echoes nothing more; DEL erases too
+    setup(&h, RING_SIZE, SCRATCH_SIZE);
+    feed(&h, "ab\x7f\x7f\x7f" "c\n");
+    EXPECT(&h, "DEL", "c");
+    CHECK(strcmp(h.echo, "ab\b \b\b \bc") == 0, "DEL: echoed \"%s\"", h.echo);
+
+    // Other control characters are dropped without an echo
+    setup(&h, RING_SIZE, SCRATCH_SIZE);
+    feed(&h, "\x1b[Ast\top\n");
+    EXPECT(&h, "control characters", "[Astop");
+    CHECK(!h.in_place[0], "control characters: line handed over in place");
+    CHECK(strcmp(h.echo, "[Astop") == 0, "control characters: echoed \"%s\"", h.echo);
+
+    // A line erased to nothing is an empty line
+    setup(&h, RING_SIZE, SCRATCH_SIZE);
+    feed(&h, "x\b\r\n");
+    EXPECT(&h, "erased", "");
+}
+
+static void test_wrap(void) {
+    harness_t h;
+    setup(&h, RING_SIZE, SCRATCH_SIZE);
+
+    // Move the ring's tail 5 bytes short of its end
+    for (uint32_t i = 0; i < (RING_SIZE - 5) / 6; i++) {
+        feed(&h, "mode\r\n");
+    }
+    feed(&h, "abc\r\n");
+    CHECK(h.ring.tail == RING_SIZE - 5, "tail at %u, expected %u", (unsigned)h.ring.tail, RING_SIZE - 5u);
+    uint32_t before = h.count;
+
+    // Written in pieces, as the interrupt would, across the end
+    feed(&h, "freq");
+    feed(&h, " 1000");
+    feed(&h, "\n");
+    feed(&h, "stop\n");
+    CHECK(h.count == before + 2, "wrap: %u lines, expected %u", h.count - before, 2);
+    CHECK(strcmp(h.got[before], "freq 1000") == 0, "wrap: \"%s\"", h.got[before]);
+    CHECK(!h.in_place[before], "wrapped line handed over in place");
+    CHECK(strcmp(h.got[before + 1], "stop") == 0 && h.in_place[before + 1], "after wrap: \"%s\", in place %d",
+          h.got[before + 1], h.in_place[before + 1]);
+
+    // A line ending at the last byte, its terminator past the end, is
+    // still handed over in place
+    setup(&h, RING_SIZE, SCRATCH_SIZE);
+    for (uint32_t i = 0; i < 8; i++) {
+        feed(&h, "status\n");
+    }
+    feed(&h, "x\n");
+    feed(&h, "status");
+    feed(&h, "\n");
+    CHECK(h.count == 10 && strcmp(h.got[9], "status") == 0 && h.in_place[9],
+          "terminator past the end: %u lines, last \"%s\"", h.count, h.got[h.count - 1]);
+}
+
+static void test_overlong(void) {
+    harness_t h;
+
+    // Past the scratch buffer: kept up to its size, rest dropped unechoed
+    setup(&h, RING_SIZE, SCRATCH_SIZE);
+    feed(&h, "0123456789abcdefXYZW\nmenu\n");
+    EXPECT(&h, "truncated", "0123456789abcdef", "menu");
+    CHECK(!h.in_place[0], "truncated line handed over in place");
+    CHECK(strcmp(h.echo, "0123456789abcdefmenu") == 0, "truncated: echoed \"%s\"", h.echo);
+
+    // Backspace still works on a full line
+    setup(&h, RING_SIZE, SCRATCH_SIZE);
+    feed(&h, "0123456789abcdefXY\b!\n");
+    EXPECT(&h, "truncated edit", "0123456789abcde!");
+
+    // Past half the ring with no terminator: the whole line goes, and its
+    // CR LF does not make an empty line
+    setup(&h, RING_SIZE, SCRATCH_SIZE);
+    feed(&h, "aaaaaaaaaaaaaaaaaaaaaaaa");
+    feed(&h, "aaaaaaaaaaaaaaaaaaaaaaaa");
+    CHECK(byte_ring_used(&h.ring) < RING_SIZE / 2, "overlong line holds %u bytes of the ring",
+          byte_ring_used(&h.ring));
+    CHECK(!line_assembler_idle(&h.lines), "idle while discarding");
+    feed(&h, "aaaaaaaaaaaaaaaaaaaaaaaa");
+    feed(&h, "aaaa\r");
+    feed(&h, "\nstop\r\n");
+    EXPECT(&h, "discarded", "stop");
+    CHECK(h.ring.dropped == 0, "discarded: %u bytes dropped by the ring", h.ring.dropped);
+}
+
+// A FIFO chunk into a nearly full ring: what fits is kept, and only the
+// rest is counted as dropped
+static void test_full_ring(void) {
+    harness_t h;
+    setup(&h, RING_SIZE, SCRATCH_SIZE);
+    const char *held = "status\r\nstatus\r\nstatus\r\nstatus\r\nstatus\r\nstatus\r\n";
+    CHECK(byte_ring_write_some(&h.ring, held, 48) == 48, "48 bytes into an empty ring");
+    const char *chunk = "stop\r\nfreq 1000\r\nfreq 2000\r\nmenu\r\n";
+    uint32_t taken = byte_ring_write_some(&h.ring, chunk, FIFO_CHUNK);
+    CHECK(taken == RING_SIZE - 48, "chunk into %u free bytes: %u taken", RING_SIZE - 48, taken);
+    CHECK(h.ring.dropped == FIFO_CHUNK - taken && h.ring.dropped_writes == 1,
+          "%u bytes in %u writes dropped, expected %u in 1", h.ring.dropped, h.ring.dropped_writes, FIFO_CHUNK - taken);
+    CHECK(byte_ring_write_some(&h.ring, "\n", 1) == 0 && h.ring.dropped == FIFO_CHUNK - taken + 1,
+          "byte into a full ring: %u dropped", h.ring.dropped);
+    drain(&h);
+    EXPECT(&h, "full ring", "status", "status", "status", "status", "status", "status", "stop", "freq 1000");
+}
+
+static uint32_t rng_state = 2463534242u;
+
+static uint32_t rng(void) {
+    rng_state ^= rng_state << 13;
+    rng_state ^= rng_state >> 17;
+    rng_state ^= rng_state << 5;
+    return rng_state;
+}
+
+// Random lines of printable characters, edits and stray control bytes,
+// ended by CR, LF or CR LF and fed in random pieces
+static void test_random(void) {
+    static const char alphabet[] = "abcdefghijklmnopqrstuvwxyz0123456789 .kM\b\x7f\x01\t";
+    static const char *const ends[] = { "\r", "\n", "\r\n" };
+    uint32_t lines = 0;
+
+    for (uint32_t script = 0; script < RANDOM_SCRIPTS; script++) {
+        harness_t h;
+        setup(&h, RING_SIZE, SCRATCH_SIZE);
+
+        char raw[512];
+        char expected[MAX_LINES][SCRATCH_SIZE + 1];
+        uint32_t raw_length = 0;
+        uint32_t count = 1 + rng() % 12;
+        for (uint32_t n = 0; n < count; n++) {
+            // Short enough to stay clear of the overlong-line discard
+            uint32_t chars = rng() % (RING_SIZE / 2 - 4);
+            uint32_t length = 0;
+            for (uint32_t i = 0; i < chars; i++) {
+                char c = alphabet[rng() % (sizeof(alphabet) - 1)];
+                raw[raw_length++] = c;
+                if (c == '\b' || c == '\x7f') {
+                    if (length > 0) length--;
+                } else if (c >= 32 && c < 127 && length < SCRATCH_SIZE) {
+                    expected[n][length++] = c;
+                }
+            }
+            expected[n][length] = '\0';
+
+            // An empty line after a CR needs a CR of its own: its LF would
+            // be taken as the second half of a CR LF
+            bool after_cr = raw_length > 0 && raw[raw_length - 1] == '\r';
+            const char *end = chars == 0 && after_cr ? ends[0] : ends[rng() % 3];
+            memcpy(&raw[raw_length], end, strlen(end));
+            raw_length += (uint32_t)strlen(end);
+        }
+
+        for (uint32_t offset = 0; offset < raw_length; ) {
+            uint32_t piece = 1 + rng() % 24;
+            if (piece > raw_length - offset) piece = raw_length - offset;
+            CHECK(byte_ring_write(&h.ring, &raw[offset], piece), "script %u: ring full", script);
+            offset += piece;
+            drain(&h);
+        }
+
+        CHECK(h.count == count, "script %u: %u lines, expected %u", script, h.count, count);
+        for (uint32_t n = 0; n < count && n < h.count; n++) {
+            CHECK(strcmp(h.got[n], expected[n]) == 0, "script %u line %u: \"%s\", expected \"%s\"", script, n,
+                  h.got[n], expected[n]);
+        }
+        CHECK(byte_ring_used(&h.ring) == 0 && line_assembler_idle(&h.lines), "script %u: bytes left over",
+              script);
+        lines += count;
+    }
+    printf("%u random scripts, %u lines\n", RANDOM_SCRIPTS, lines);
+}
+
+// A pasted script at the firmware's sizes, written in FIFO-sized chunks by
+// the "interrupt" and taken out after each one. Every line must come out
+// intact with nothing dropped.
+static void test_paste(void) {
+    static const char script[] =
+        "mode uart\r\n"
+        "freq 1M\r\n"
+        "duty 25\r\n"
+        "burst 12345 250k\r\n"
+        "sweep 1k 100k 500 log\r\n"
+        "dwell 20\r\n"
+        "reset 8\r\n"
+        "status\r\n";
+    static harness_t h;
+    setup(&h, UART_RX_BUFFER_SIZE, UART_CMD_BUFFER_SIZE);
+
+    const uint32_t script_length = sizeof(script) - 1;
+    uint32_t position = 0;
+    uint32_t lines = 0;
+    uint32_t bad = 0;
+    uint64_t checksum = 0;
+    const char *line;
+    uint32_t length;
+
+    double start = host_test_seconds();
+    for (uint32_t sent = 0; sent < PASTE_BYTES; sent += FIFO_CHUNK) {
+        char chunk[FIFO_CHUNK];
+        for (uint32_t i = 0; i < FIFO_CHUNK; i++) {
+            chunk[i] = script[position];
+            position = position + 1 == script_length ? 0 : position + 1;
+        }
+        byte_ring_write_some(&h.ring, chunk, FIFO_CHUNK);
+
+        while (line_assembler_next(&h.lines, &h.ring, NULL, NULL, &line, &length)) {
+            // Each line must be the next one of the script
+            const char *expected = &script[checksum % script_length];
+            uint32_t expected_length = (uint32_t)(strchr(expected, '\r') - expected);
+            if (length != expected_length || memcmp(line, expected, length) != 0) bad++;
+            checksum = (checksum + expected_length + 2) % script_length;
+            lines++;
+            line_assembler_release(&h.lines, &h.ring);
+        }
+    }
+    double elapsed = host_test_seconds() - start;
+
+    CHECK(bad == 0, "paste: %u of %u lines garbled", bad, lines);
+    CHECK(h.ring.dropped == 0, "paste: %u bytes dropped", h.ring.dropped);
+    CHECK(lines >= PASTE_BYTES / script_length * 8, "paste: %u lines", lines);
+
+    double bytes_per_second = PASTE_BYTES / elapsed;
+    double uart_bytes_per_second = UART_BAUD_RATE / 10.0;
+    printf("paste: %u lines, %.1f MB/s, %.0fx the UART at %u baud\n", lines, bytes_per_second / 1e6,
+           bytes_per_second / uart_bytes_per_second, UART_BAUD_RATE);
+}
+
+int main(void) {
+    test_terminators();
+    test_editing();
+    test_wrap();
+    test_overlong();
+    test_full_ring();
+    test_random();
+    test_paste();
+    return host_test_finish("test_line_assembler");
+}
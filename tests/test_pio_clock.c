@@ -0,0 +1,145 @@
+/**
+ * PIO clock engine edge timing test
+ *
+ * Runs the PIO program on the simulated PIO block and times every edge it
+ * puts on CLOCK_OUTPUT while the knob sweeps all ADC values, retuning in
+ * place as update_low_frequency() does. Each setting's steady cycle must
+ * last exactly the table's period split by the duty cycle, come within the
+ * period's rounding of calculate_frequency_from_pot(), and no half across a
+ * retune may be shorter than the same half of the old or new setting. A
+ * stop in a HIGH half must return at once and still let the half end.
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <math.h>
+#include "host_test.h"
+#include "config.h"
+#include "pio_clock.h"
+#include "clock_cache.h"
+#include "clock_generator.h"
+#include "sys_clock.h"
+
+static uint32_t rising_edges = 0;
+static uint64_t last_rise = 0;
+static uint64_t last_fall = 0;
+static uint64_t last_period = 0;        // Rising edge to rising edge
+static uint64_t last_high = 0;
+static uint64_t shortest_high = UINT64_MAX;
+static uint64_t shortest_low = UINT64_MAX;
+
+static void time_edge(uint gpio, bool level, uint64_t now) {
+    if (gpio != CLOCK_OUTPUT) return;
+
+    if (level) {
+        if (rising_edges > 0 && last_fall > last_rise) {
+            uint64_t low = now - last_fall;
+            if (low < shortest_low) shortest_low = low;
+            last_period = now - last_rise;
+        }
+        last_rise = now;
+        rising_edges++;
+    } else if (rising_edges > 0) {
+        last_high = now - last_rise;
+        if (last_high < shortest_high) shortest_high = last_high;
+        last_fall = now;
+    }
+}
+
+static void wait_rising_edges(uint32_t count, uint32_t period) {
+    uint32_t target = rising_edges + count;
+    while (rising_edges < target) {
+        sim_core_wait(sim_now() + period / 4 + 1, false);
+    }
+}
+
+static void test_core0(void) {
+    uint32_t sys_hz = sys_clock_get_hz();
+    uint32_t old_high = 0;
+    uint32_t old_low = 0;
+    double worst_error = 0;
+    uint16_t worst_adc = 0;
+    duty_cycle_achieved_t achieved;
+
+    CHECK(clock_cache_valid(), "tables not built for %u Hz", sys_hz);
+    pio_clock_init();
+
+    for (uint32_t adc = 0; adc < CLOCK_CACHE_ADC_ENTRIES; adc++) {
+        uint16_t position = (uint16_t)(adc * CLOCK_CACHE_POT_SUBSTEPS);
+        uint32_t period = clock_cache_pot_period(position);
+        uint32_t high = clock_duty_split(period, PIO_CLOCK_HIGH_OVERHEAD, PIO_CLOCK_LOW_OVERHEAD, sys_hz, 1, &achieved);
+        uint32_t low = period - high;
+
+        shortest_high = UINT64_MAX;
+        shortest_low = UINT64_MAX;
+        pio_clock_set_period(period, high);
+
+        // The new pair starts at the next falling edge, or the one after if
+        // it arrived while the program was loading; the third cycle is steady
+        wait_rising_edges(3, period);
+        CHECK(last_period == period, "adc %u: period %llu cycles, set %u", adc,
+              (unsigned long long)last_period, period);
+        CHECK(last_high == high, "adc %u: HIGH %llu cycles, set %u", adc,
+              (unsigned long long)last_high, high);
+
+        // Retuning never produces a runt half
+        if (adc > 0) {
+            uint32_t min_high = high < old_high ? high : old_high;
+            uint32_t min_low = low < old_low ? low : old_low;
+            CHECK(shortest_high >= min_high, "adc %u: HIGH half of %llu cycles, min(old, new) %u", adc,
+                  (unsigned long long)shortest_high, min_high);
+            CHECK(shortest_low >= min_low, "adc %u: LOW half of %llu cycles, min(old, new) %u", adc,
+                  (unsigned long long)shortest_low, min_low);
+        }
+        old_high = high;
+        old_low = low;
+
+        // Whole cycles round the frequency by up to half a cycle, and the
+        // knob's frequency is rounded to whole hertz
+        uint32_t requested = calculate_frequency_from_pot((uint16_t)adc);
+        double exact = clock_cache_pot_millihz(position) / 1000.0;
+        double measured = (double)sys_hz / (double)last_period;
+        double tolerance = fmax(measured, exact) * 0.5 / (double)last_period + 1e-9;
+        double error = fabs(measured - exact);
+        CHECK(error <= tolerance, "adc %u: %.4f Hz, table %.3f Hz", adc, measured, exact);
+        CHECK(fabs(measured - (double)requested) <= tolerance + 0.5, "adc %u: %.4f Hz, requested %u Hz", adc,
+              measured, requested);
+        if (error / exact > worst_error) {
+            worst_error = error / exact;
+            worst_adc = (uint16_t)adc;
+        }
+    }
+
+    // A stop in a HIGH half lets it end, without waiting, and the state
+    // machine lets go of the pin at the next update after its deadline
+    uint32_t period = clock_cache_pot_period(0);
+    uint32_t high = clock_duty_split(period, PIO_CLOCK_HIGH_OVERHEAD, PIO_CLOCK_LOW_OVERHEAD, sys_hz, 1, &achieved);
+    pio_clock_set_period(period, high);
+    wait_rising_edges(3, period);
+    sim_core_wait(sim_now() + period / 16 + 1, false);
+    CHECK(sim_gpio_level(CLOCK_OUTPUT), "output LOW a sixteenth into the HIGH half");
+    uint64_t stopped_at = sim_now();
+    pio_clock_stop();
+    CHECK(sim_now() - stopped_at < period / 16, "stop waited %llu cycles",
+          (unsigned long long)(sim_now() - stopped_at));
+    uint64_t deadline;
+    while (pio_clock_next_deadline(&deadline)) {
+        sim_core_wait(sim_us_to_cycles(deadline), false);
+        pio_clock_update();
+    }
+    CHECK(last_high == high, "HIGH half of %llu cycles cut by the stop, set %u",
+          (unsigned long long)last_high, high);
+    CHECK(!sim_gpio_level(CLOCK_OUTPUT), "output HIGH after stop");
+    CHECK(gpio_get_function(CLOCK_OUTPUT) == GPIO_FUNC_SIO, "pin still held after stop");
+
+    printf("%u settings, %u cycles, worst error %.1f ppm at adc %u (%u Hz)\n", CLOCK_CACHE_ADC_ENTRIES,
+           rising_edges, worst_error * 1e6, worst_adc, calculate_frequency_from_pot(worst_adc));
+}
+
+int main(void) {
+    host_test_sim_init();
+    sim_gpio_watch(CLOCK_OUTPUT, true);
+    sim_gpio_add_edge_hook(time_edge);
+    sim_core_run(test_core0, SIM_NEVER);
+    return host_test_finish("test_pio_clock");
+}
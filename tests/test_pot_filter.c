@@ -0,0 +1,180 @@
+/**
+ * Potentiometer filter noise test
+ *
+ * Feeds the filter blocks of synthetic ADC samples, a knob position plus
+ * Gaussian noise, with the firmware's block size, IIR weight and hysteresis.
+ * A knob left alone must never retune the clock once settled, at positions
+ * between ADC codes too, and the filtered value must resolve the knob to
+ * 14 bits. A real move must be followed promptly and in one direction, and
+ * both end stops must stay reachable through the noise.
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <math.h>
+#include "host_test.h"
+#include "config.h"
+#include "pot_filter.h"
+#include "pot_sampler.h"
+
+#define STEADY_POLLS    20000u      // 20 s at one poll per millisecond
+#define SETTLE_POLLS    200u
+#define FOLLOW_POLLS    50u         // A step must be followed this quickly
+
+static uint64_t rng_state = 0x9E3779B97F4A7C15ull;
+
+static double uniform(void) {
+    rng_state ^= rng_state << 13;
+    rng_state ^= rng_state >> 7;
+    rng_state ^= rng_state << 17;
+    return ((double)(rng_state >> 11) + 0.5) / 9007199254740992.0;
+}
+
+// Box-Muller; one of the pair is enough here
+static double gaussian(void) {
+    return sqrt(-2.0 * log(uniform())) * cos(2.0 * M_PI * uniform());
+}
+
+static uint16_t sample(double knob, double sigma) {
+    double value = round(knob + sigma * gaussian());
+    if (value < 0) value = 0;
+    if (value > 4095) value = 4095;
+    return (uint16_t)value;
+}
+
+// Sum of one ring of samples, as pot_sampler_sum() returns it
+static uint32_t block(double knob, double sigma) {
+    uint32_t sum = 0;
+    for (uint32_t i = 0; i < POT_SAMPLE_COUNT; i++) {
+        sum += sample(knob, sigma);
+    }
+    return sum;
+}
+
+static void init(pot_filter_t *f, double knob, double sigma) {
+    pot_filter_init(f, block(knob, sigma), POT_SAMPLE_COUNT, POT_FILTER_IIR_SHIFT, POT_HYSTERESIS);
+}
+
+// A knob left alone: no retunes after settling, and the output and the
+// filtered value stay close to the knob
+static void test_steady(double knob, double sigma) {
+    pot_filter_t f;
+    init(&f, knob, sigma);
+    for (uint32_t i = 0; i < SETTLE_POLLS; i++) {
+        pot_filter_update(&f, block(knob, sigma), POT_SAMPLE_COUNT);
+    }
+
+    uint32_t retunes = 0;
+    uint32_t raw_flaps = 0;
+    uint16_t raw_last = sample(knob, sigma);
+    double sum = 0, sum_squares = 0;
+    for (uint32_t i = 0; i < STEADY_POLLS; i++) {
+        if (pot_filter_update(&f, block(knob, sigma), POT_SAMPLE_COUNT)) retunes++;
+        double filtered = f.average / 256.0;
+        sum += filtered;
+        sum_squares += filtered * filtered;
+
+        // What one adc_read() per poll would have done
+        uint16_t raw = sample(knob, sigma);
+        if (raw != raw_last) raw_flaps++;
+        raw_last = raw;
+    }
+
+    double mean = sum / STEADY_POLLS;
+    double rms = sqrt(fmax(sum_squares / STEADY_POLLS - mean * mean, 0.0));
+    double bits = POT_FILTER_BITS - log2(fmax(rms, 1.0 / 64) * sqrt(12.0));
+    double target = knob * 4.0;
+    double end_stop = POT_HYSTERESIS;
+    double expected = target <= end_stop ? 0 : target >= POT_FILTER_MAX - end_stop ? POT_FILTER_MAX : target;
+
+    CHECK(retunes == 0, "knob %.2f, noise %.1f: %u retunes in %u polls", knob, sigma, retunes, STEADY_POLLS);
+    CHECK(fabs(pot_filter_value(&f) - expected) <= POT_HYSTERESIS + 4, "knob %.2f, noise %.1f: output %u, expected %.0f",
+          knob, sigma, pot_filter_value(&f), expected);
+    if (sigma <= 4.0 && knob >= 3 * sigma && knob <= 4095 - 3 * sigma) {
+        CHECK(fabs(mean - target) <= 1.0, "knob %.2f, noise %.1f: filtered mean %.3f, expected %.3f", knob, sigma,
+              mean, target);
+        CHECK(rms < 1.0, "knob %.2f, noise %.1f: filtered value wanders %.3f steps rms", knob, sigma, rms);
+    }
+    printf("knob %7.2f, noise %4.1f counts: %u retunes (single reads change %u times), %.2f steps rms, %.1f bits\n",
+           knob, sigma, retunes, raw_flaps, rms, bits);
+}
+
+// A knob turned from one place to another: followed within FOLLOW_POLLS,
+// never backwards, and settled within the band of the new place
+static void test_step(double from, double to, double sigma) {
+    pot_filter_t f;
+    init(&f, from, sigma);
+    for (uint32_t i = 0; i < SETTLE_POLLS; i++) {
+        pot_filter_update(&f, block(from, sigma), POT_SAMPLE_COUNT);
+    }
+
+    uint32_t retunes = 0;
+    uint32_t followed_at = 0;
+    bool backwards = false;
+    uint16_t last = pot_filter_value(&f);
+    double target = to * 4.0;
+    for (uint32_t i = 1; i <= SETTLE_POLLS; i++) {
+        if (pot_filter_update(&f, block(to, sigma), POT_SAMPLE_COUNT)) {
+            retunes++;
+            uint16_t value = pot_filter_value(&f);
+            if ((to > from && value < last) || (to < from && value > last)) backwards = true;
+            last = value;
+        }
+        if (!followed_at && fabs(pot_filter_value(&f) - target) <= POT_HYSTERESIS + 4) followed_at = i;
+    }
+
+    CHECK(followed_at > 0 && followed_at <= FOLLOW_POLLS, "%.0f to %.0f: followed after %u polls", from, to,
+          followed_at);
+    CHECK(!backwards, "%.0f to %.0f: output moved backwards", from, to);
+    printf("knob %.0f to %.0f, noise %.1f counts: %u retunes, within the band after %u ms\n", from, to, sigma,
+           retunes, followed_at);
+}
+
+// A slow sweep across the whole range: the output only ever climbs, by at
+// least the hysteresis except at the end stop, and reaches both ends
+static void test_sweep(double sigma) {
+    pot_filter_t f;
+    init(&f, 0, sigma);
+    for (uint32_t i = 0; i < SETTLE_POLLS; i++) {
+        pot_filter_update(&f, block(0, sigma), POT_SAMPLE_COUNT);
+    }
+    CHECK(pot_filter_value(&f) == 0, "noise %.1f: output %u at the bottom end stop", sigma, pot_filter_value(&f));
+
+    const uint32_t polls = 4000;    // Four seconds end to end
+    uint32_t retunes = 0;
+    uint16_t last = pot_filter_value(&f);
+    for (uint32_t i = 0; i <= polls + SETTLE_POLLS; i++) {
+        double knob = i < polls ? 4095.0 * i / polls : 4095.0;
+        if (!pot_filter_update(&f, block(knob, sigma), POT_SAMPLE_COUNT)) continue;
+        uint16_t value = pot_filter_value(&f);
+        retunes++;
+        CHECK(value > last, "noise %.1f, knob %.1f: output fell from %u to %u", sigma, knob, last, value);
+        CHECK(value - last > POT_HYSTERESIS || value == POT_FILTER_MAX, "noise %.1f, knob %.1f: retune of %u steps",
+              sigma, knob, value - last);
+        last = value;
+    }
+    CHECK(pot_filter_value(&f) == POT_FILTER_MAX, "noise %.1f: output %u at the top end stop", sigma,
+          pot_filter_value(&f));
+    printf("sweep end to end, noise %.1f counts: %u retunes\n", sigma, retunes);
+}
+
+int main(void) {
+    static const double noise[] = { 0.5, 2.0, 4.0, 8.0 };
+    // End stops, whole codes and codes and a half, where a single read flaps
+    static const double knobs[] = { 0, 1, 819, 1000.5, 2047.5, 3000.25, 4094, 4095 };
+
+    for (uint32_t n = 0; n < sizeof(noise) / sizeof(noise[0]); n++) {
+        for (uint32_t k = 0; k < sizeof(knobs) / sizeof(knobs[0]); k++) {
+            test_steady(knobs[k], noise[n]);
+        }
+    }
+
+    test_step(1000, 1010, 4.0);
+    test_step(1010, 1000, 4.0);
+    test_step(500, 3500, 4.0);
+    test_step(3500, 500, 4.0);
+    test_sweep(2.0);
+    test_sweep(8.0);
+
+    return host_test_finish("test_pot_filter");
+}
@@ -0,0 +1,120 @@
+/**
+ * Potentiometer taper benchmark
+ *
+ * Compares the generated pot table with the integer mapping it replaced:
+ * two linear segments in whole hertz, whose PIO period then needs a 64-bit
+ * division. With POT_TAPER_LINEAR every ADC value must give that mapping's
+ * frequency and period exactly; with POT_TAPER_LOG the table must climb
+ * from end to end by the same ratio per step. tests.cmake builds it once
+ * per taper, each with its own generated table. Times both paths from ADC
+ * value to period and reports the coarsest step of each taper. A host
+ * divides 64 bits in one instruction, so the timing here is a floor for
+ * the baseline; the Cortex-M0+ divides in software.
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <math.h>
+#include "host_test.h"
+#include "config.h"
+#include "clock_cache.h"
+#include "clock_generator.h"
+#include "pio_clock.h"
+
+#define BENCH_ROUNDS 2000u      // Passes over all 4096 ADC values
+#define RANGE1_ADC   ((uint16_t)(4095 * POT_RANGE1_PERCENT + 0.5f))    // 819 as shipped
+#define RANGE2_ADC   ((uint16_t)(4095 * POT_RANGE2_PERCENT + 0.5f))    // 3276 as shipped
+
+// The mapping before the table, as it was
+static uint32_t baseline_frequency(uint16_t adc_value) {
+    if (adc_value <= RANGE1_ADC) {
+        return MIN_LOW_FREQ + ((adc_value * (MAX_LOW_FREQ_RANGE1 - MIN_LOW_FREQ)) / RANGE1_ADC);
+    } else {
+        uint16_t scaled_adc = adc_value - RANGE1_ADC;
+        return MAX_LOW_FREQ_RANGE1 + ((scaled_adc * (MAX_LOW_FREQ_RANGE2 - MAX_LOW_FREQ_RANGE1)) / RANGE2_ADC);
+    }
+}
+
+static uint32_t baseline_period(uint16_t adc_value) {
+    return pio_clock_period_millihz(CLOCK_CACHE_SYS_HZ, (uint64_t)baseline_frequency(adc_value) * 1000u);
+}
+
+static uint32_t table_period(uint16_t adc_value) {
+    return clock_cache_pot_period((uint16_t)(adc_value * CLOCK_CACHE_POT_SUBSTEPS));
+}
+
+// Nanoseconds per call over every ADC value
+static double time_per_call(uint32_t (*map)(uint16_t), uint32_t *checksum) {
+    uint32_t sum = 0;
+    double start = host_test_seconds();
+    for (uint32_t round = 0; round < BENCH_ROUNDS; round++) {
+        for (uint32_t adc = 0; adc < CLOCK_CACHE_ADC_ENTRIES; adc++) {
+            sum += map((uint16_t)adc);
+        }
+    }
+    double elapsed = host_test_seconds() - start;
+    *checksum = sum;
+    return elapsed * 1e9 / ((double)BENCH_ROUNDS * CLOCK_CACHE_ADC_ENTRIES);
+}
+
+// Largest ratio between the frequencies of adjacent ADC values
+static double coarsest_step(uint32_t (*millihz)(uint16_t), uint16_t *at) {
+    double worst = 0;
+    for (uint32_t adc = 1; adc < CLOCK_CACHE_ADC_ENTRIES; adc++) {
+        double step = (double)millihz((uint16_t)adc) / (double)millihz((uint16_t)(adc - 1)) - 1.0;
+        if (step > worst) {
+            worst = step;
+            *at = (uint16_t)adc;
+        }
+    }
+    return worst;
+}
+
+static uint32_t baseline_millihz(uint16_t adc_value) {
+    return baseline_frequency(adc_value) * 1000u;
+}
+
+static uint32_t table_millihz(uint16_t adc_value) {
+    return clock_cache_adc_millihz[adc_value];
+}
+
+int main(void) {
+    CHECK(clock_cache_valid(), "tables not built for the running system clock");
+
+    for (uint32_t adc = 0; adc < CLOCK_CACHE_ADC_ENTRIES; adc++) {
+#if POT_TAPER == POT_TAPER_LINEAR
+        CHECK(calculate_frequency_from_pot((uint16_t)adc) == baseline_frequency((uint16_t)adc),
+              "adc %u: %u Hz, baseline %u Hz", adc, calculate_frequency_from_pot((uint16_t)adc),
+              baseline_frequency((uint16_t)adc));
+        CHECK(table_period((uint16_t)adc) == baseline_period((uint16_t)adc), "adc %u: period %u, baseline %u", adc,
+              table_period((uint16_t)adc), baseline_period((uint16_t)adc));
+#else
+        double ratio = pow((double)MAX_LOW_FREQ_RANGE2 / MIN_LOW_FREQ, 1.0 / (CLOCK_CACHE_ADC_ENTRIES - 1));
+        double expected = MIN_LOW_FREQ * 1000.0 * pow(ratio, adc);
+        CHECK(fabs(clock_cache_adc_millihz[adc] - expected) <= 0.5, "adc %u: %u mHz, log taper %.3f mHz", adc,
+              clock_cache_adc_millihz[adc], expected);
+#endif
+    }
+    CHECK(baseline_frequency(0) * 1000u == clock_cache_adc_millihz[0], "bottom end moved");
+    CHECK(baseline_frequency(CLOCK_CACHE_ADC_ENTRIES - 1) * 1000u ==
+          clock_cache_adc_millihz[CLOCK_CACHE_ADC_ENTRIES - 1], "top end moved");
+
+    uint32_t baseline_sum, table_sum;
+    double baseline_ns = time_per_call(baseline_period, &baseline_sum);
+    double table_ns = time_per_call(table_period, &table_sum);
+#if POT_TAPER == POT_TAPER_LINEAR
+    CHECK(baseline_sum == table_sum, "benchmark checksums differ");
+#endif
+
+    uint16_t baseline_at = 0, table_at = 0;
+    double baseline_step = coarsest_step(baseline_millihz, &baseline_at);
+    double table_step = coarsest_step(table_millihz, &table_at);
+
+    printf("taper: %s\n", POT_TAPER == POT_TAPER_LOG ? "log" : "linear");
+    printf("ADC value to PIO period: baseline %.2f ns, table %.2f ns per call (%.1fx)\n", baseline_ns, table_ns,
+           baseline_ns / table_ns);
+    printf("coarsest step: baseline %.2f%% at adc %u (%u Hz), table %.2f%% at adc %u (%.3f Hz)\n",
+           baseline_step * 100, baseline_at, baseline_frequency(baseline_at), table_step * 100, table_at,
+           clock_cache_adc_millihz[table_at] / 1000.0);
+    return host_test_finish("test_pot_taper");
+}
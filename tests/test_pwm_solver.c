@@ -0,0 +1,124 @@
+/**
+ * PWM solver sweep test
+ *
+ * Solves frequencies from 1 Hz to 1 MHz at the nominal system clock: every
+ * whole hertz below 1 kHz and in the top percent, where the error peaks,
+ * and 0.1% steps between. Each solution must describe itself consistently,
+ * beat the period rounding of a plain divide-by-one counter wherever one
+ * reaches, and, on a log-spaced sample, match an exhaustive search over
+ * every divider. Reports the worst error and the mean and slowest call.
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <math.h>
+#include "host_test.h"
+#include "pwm_solver.h"
+
+#define SYS_HZ          125000000u
+#define SWEEP_MAX       1000000u
+#define SWEEP_DENSE_LOW 1000u       // Every whole hertz below this
+#define SWEEP_DENSE_HIGH 990000u    // and from this up
+#define SAMPLES_PER_DECADE 200
+
+// Lowest frequency a slice reaches: largest divider, longest period
+static uint32_t lowest_frequency(uint32_t sys_hz) {
+    uint64_t ticks = (uint64_t)PWM_SOLVER_DIV16_MAX * PWM_SOLVER_PERIOD_MAX;
+    return (uint32_t)((16ull * sys_hz + ticks - 1) / ticks);
+}
+
+// Smallest relative error of any divider and period, by brute force
+static double exhaustive_error(uint32_t sys_hz, uint32_t frequency) {
+    double best = INFINITY;
+    for (uint32_t div16 = PWM_SOLVER_DIV16_MIN; div16 <= PWM_SOLVER_DIV16_MAX; div16++) {
+        double exact = 16.0 * sys_hz / ((double)div16 * frequency);
+        for (int64_t period = (int64_t)exact - 1; period <= (int64_t)exact + 2; period++) {
+            if (period < PWM_SOLVER_PERIOD_MIN || period > PWM_SOLVER_PERIOD_MAX) continue;
+            double produced = 16.0 * sys_hz / ((double)div16 * (double)period);
+            double error = fabs(produced - frequency) / frequency;
+            if (error < best) best = error;
+        }
+    }
+    return best;
+}
+
+static uint32_t next_frequency(uint32_t frequency) {
+    if (frequency < SWEEP_DENSE_LOW || frequency >= SWEEP_DENSE_HIGH) return frequency + 1;
+    return frequency + frequency / 1000;
+}
+
+static double solution_error(uint32_t sys_hz, uint32_t frequency, const pwm_solution_t *s) {
+    uint32_t div16 = ((uint32_t)s->div_int << 4) | s->div_frac;
+    double produced = 16.0 * sys_hz / ((double)div16 * ((double)s->wrap + 1));
+    return fabs(produced - frequency) / frequency;
+}
+
+int main(void) {
+    uint32_t lowest = lowest_frequency(SYS_HZ);
+    uint32_t worst_frequency = 0;
+    double worst_error = 0;
+    uint32_t swept = 0;
+    double total_time = 0;
+    double slowest_time = 0;
+    uint32_t slowest_frequency = 0;
+
+    for (uint32_t frequency = 1; frequency <= SWEEP_MAX; frequency = next_frequency(frequency)) {
+        swept++;
+        pwm_solution_t s;
+        double start = host_test_seconds();
+        bool ok = pwm_solve(SYS_HZ, frequency, &s);
+        double elapsed = host_test_seconds() - start;
+        total_time += elapsed;
+        if (elapsed > slowest_time) {
+            slowest_time = elapsed;
+            slowest_frequency = frequency;
+        }
+        CHECK(ok == (frequency >= lowest), "%u Hz: solvable %d, lowest %u Hz", frequency, ok, lowest);
+        if (!ok) continue;
+
+        uint32_t div16 = ((uint32_t)s.div_int << 4) | s.div_frac;
+        uint64_t ticks = (uint64_t)div16 * ((uint64_t)s.wrap + 1);
+        CHECK(div16 >= PWM_SOLVER_DIV16_MIN && div16 <= PWM_SOLVER_DIV16_MAX, "%u Hz: divider %u/16",
+              frequency, div16);
+        CHECK(s.wrap + 1u >= PWM_SOLVER_PERIOD_MIN, "%u Hz: wrap %u", frequency, s.wrap);
+        CHECK(s.level == (s.wrap + 1u) / 2, "%u Hz: level %u for wrap %u", frequency, s.level, s.wrap);
+        CHECK(s.achieved_millihz == (16000ull * SYS_HZ + ticks / 2) / ticks, "%u Hz: achieved %llu mHz",
+              frequency, (unsigned long long)s.achieved_millihz);
+        CHECK(s.error_ppb == pwm_solver_error_ppb(16ull * SYS_HZ, ticks, frequency), "%u Hz: error %d ppb",
+              frequency, s.error_ppb);
+
+        // Never worse than rounding the period of an undivided counter
+        double error = solution_error(SYS_HZ, frequency, &s);
+        double period = (double)SYS_HZ / frequency;
+        if (period <= PWM_SOLVER_PERIOD_MAX) {
+            double bound = 0.5 / floor(period) + 1e-12;
+            CHECK(error <= bound, "%u Hz: error %.3g, divide-by-one bound %.3g", frequency, error, bound);
+        }
+        if (error > worst_error) {
+            worst_error = error;
+            worst_frequency = frequency;
+        }
+    }
+
+    // No divider/period pair anywhere is closer
+    uint32_t sampled = 0;
+    for (uint32_t i = 0; ; i++) {
+        uint32_t frequency = (uint32_t)llround(pow(10.0, (double)i / SAMPLES_PER_DECADE));
+        if (frequency > SWEEP_MAX) break;
+        if (frequency < lowest) continue;
+
+        pwm_solution_t s;
+        if (!pwm_solve(SYS_HZ, frequency, &s)) continue;
+        double error = solution_error(SYS_HZ, frequency, &s);
+        double best = exhaustive_error(SYS_HZ, frequency);
+        CHECK(error <= best * (1 + 1e-9) + 1e-15, "%u Hz: error %.6g, exhaustive search %.6g", frequency,
+              error, best);
+        sampled++;
+    }
+
+    printf("%u frequencies swept (slices reach %u Hz and up), %u checked exhaustively\n", swept, lowest, sampled);
+    printf("worst error %.3f ppm at %u Hz\n", worst_error * 1e6, worst_frequency);
+    printf("%.2f us per solve, slowest %.2f us at %u Hz\n", total_time * 1e6 / swept, slowest_time * 1e6,
+           slowest_frequency);
+    return host_test_finish("test_pwm_solver");
+}
@@ -0,0 +1,198 @@
+/**
+ * Reset pulse count test
+ *
+ * Runs the whole firmware on the simulated cores and presses buttons and
+ * types commands at it on a timeline, counting the rising edges of
+ * CLOCK_OUTPUT while RESET_OUTPUT is LOW. A pulse must end on exactly its
+ * Nth rising edge in every mode: Single Step, Low and High Frequency, a
+ * UART-controlled clock and a burst. A pulse that cannot finish must still
+ * end: waiting on a stopped UART clock for RESET_STALL_MS, on a second reset
+ * from a port or the button, and on a mode change.
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include "host_test.h"
+#include "config.h"
+
+#define END_MS      8600u
+#define MAX_PULSES  16
+
+int firmware_main(void);
+
+typedef enum { PRESS, RELEASE, USB, ADC } action_kind_t;
+
+typedef struct {
+    uint32_t at_ms;
+    action_kind_t kind;
+    uint gpio;                  // PRESS and RELEASE
+    const char *text;           // USB line
+    uint16_t adc;               // ADC
+} action_t;
+
+#define TAP(ms, button) { ms, PRESS, button, NULL, 0 }, { ms + 30, RELEASE, button, NULL, 0 }
+#define TYPE(ms, line) { ms, USB, 0, line, 0 }
+
+static const action_t timeline[] = {
+    { 0, ADC, 0, NULL, 2000 },
+
+    // Single Step: twelve presses make six rising edges
+    TYPE(300, "reset"),
+    TAP(400, BUTTON_SINGLE_STEP), TAP(500, BUTTON_SINGLE_STEP), TAP(600, BUTTON_SINGLE_STEP),
+    TAP(700, BUTTON_SINGLE_STEP), TAP(800, BUTTON_SINGLE_STEP), TAP(900, BUTTON_SINGLE_STEP),
+    TAP(1000, BUTTON_SINGLE_STEP), TAP(1100, BUTTON_SINGLE_STEP), TAP(1200, BUTTON_SINGLE_STEP),
+    TAP(1300, BUTTON_SINGLE_STEP), TAP(1400, BUTTON_SINGLE_STEP), TAP(1500, BUTTON_SINGLE_STEP),
+
+    // Low and High Frequency from the button, leaving the fast clock soon
+    TAP(2000, BUTTON_LOW_FREQ),
+    TAP(2300, BUTTON_RESET),
+    TAP(2600, BUTTON_HIGH_FREQ),
+    TAP(2700, BUTTON_RESET),
+    TAP(2800, BUTTON_SINGLE_STEP),
+
+    // Remote requests once the panel's hold-off has passed
+    TYPE(5000, "mode high"),
+    TYPE(5100, "reset 1000"),
+    TYPE(5200, "freq 1M"),
+    TYPE(5300, "reset 12345"),
+    TYPE(5400, "stop"),
+    TYPE(5500, "reset 3"),
+    TYPE(5600, "burst 5 1k"),
+
+    // A stopped clock: released after RESET_STALL_MS
+    TYPE(5800, "reset"),
+
+    // A second reset releases the pulse
+    TYPE(7000, "reset 5"),
+    TYPE(7200, "reset"),
+
+    // So does a mode change
+    TYPE(7400, "freq 10"),
+    TYPE(7500, "reset 100"),
+    TYPE(7700, "mode low"),
+
+    // And the button
+    TAP(8000, BUTTON_SINGLE_STEP),
+    TAP(8200, BUTTON_RESET),
+    TAP(8400, BUTTON_RESET),
+};
+
+typedef struct {
+    const char *what;
+    uint32_t cycles;            // Requested
+    bool complete;              // Ends on its last edge rather than released
+    uint32_t min_ms;            // Length when released
+    uint32_t max_ms;
+} expected_pulse_t;
+
+static const expected_pulse_t expected[] = {
+    { "Single Step", 6, true, 0, 0 },
+    { "Low Frequency", 6, true, 0, 0 },
+    { "High Frequency", 6, true, 0, 0 },
+    { "High Frequency, reset 1000", 1000, true, 0, 0 },
+    { "UART 1 MHz", 12345, true, 0, 0 },
+    { "burst", 3, true, 0, 0 },
+    { "stopped clock", RESET_CYCLES, false, RESET_STALL_MS - 1, RESET_STALL_MS + 5 },
+    { "second reset", 5, false, 195, 205 },
+    { "mode change", 100, false, 195, 205 },
+    { "second button press", RESET_CYCLES, false, 150, 250 },
+};
+
+typedef struct {
+    uint64_t start;
+    uint64_t end;
+    uint32_t edges;
+} pulse_t;
+
+static pulse_t pulses[MAX_PULSES];
+static uint32_t pulse_count = 0;
+static bool in_pulse = false;
+static uint32_t next_action = 0;
+
+static void count_edge(uint gpio, bool level, uint64_t now) {
+    if (gpio == RESET_OUTPUT) {
+        if (!level && !in_pulse && pulse_count < MAX_PULSES) {
+            in_pulse = true;
+            pulses[pulse_count] = (pulse_t){ now, 0, 0 };
+        } else if (level && in_pulse) {
+            in_pulse = false;
+            pulses[pulse_count++].end = now;
+        }
+    } else if (gpio == CLOCK_OUTPUT && level && in_pulse) {
+        pulses[pulse_count].edges++;
+    }
+}
+
+static uint64_t timeline_next_event(void) {
+    if (next_action < sizeof(timeline) / sizeof(timeline[0])) {
+        return sim_us_to_cycles(timeline[next_action].at_ms * 1000ull);
+    }
+    return sim_us_to_cycles(END_MS * 1000ull);
+}
+
+static void timeline_run_event(uint64_t now) {
+    while (next_action < sizeof(timeline) / sizeof(timeline[0]) &&
+           sim_us_to_cycles(timeline[next_action].at_ms * 1000ull) <= now) {
+        const action_t *a = &timeline[next_action++];
+        switch (a->kind) {
+            case PRESS:
+                sim_gpio_drive(a->gpio, 0);
+                break;
+            case RELEASE:
+                sim_gpio_drive(a->gpio, -1);
+                break;
+            case USB: {
+                char line[64];
+                snprintf(line, sizeof(line), "%s\n", a->text);
+                sim_usb_inject(line, (uint32_t)strlen(line));
+                break;
+            }
+            case ADC:
+                sim_adc_set(0, a->adc);
+                break;
+        }
+    }
+    if (next_action == sizeof(timeline) / sizeof(timeline[0]) && now >= sim_us_to_cycles(END_MS * 1000ull)) {
+        sim_stop();
+    }
+}
+
+static const sim_agent_t timeline_agent = {
+    .name = "timeline",
+    .next_event = timeline_next_event,
+    .run_event = timeline_run_event,
+};
+
+static void core0_entry(void) {
+    firmware_main();
+}
+
+int main(void) {
+    host_test_sim_init();
+    sim_register_agent(&timeline_agent);
+    sim_gpio_watch(CLOCK_OUTPUT, true);
+    sim_gpio_watch(RESET_OUTPUT, true);
+    sim_gpio_add_edge_hook(count_edge);
+    sim_core_run(core0_entry, SIM_NEVER);
+
+    const uint32_t expected_count = sizeof(expected) / sizeof(expected[0]);
+    CHECK(!in_pulse, "reset still LOW at the end");
+    CHECK(pulse_count == expected_count, "%u pulses, expected %u", pulse_count, expected_count);
+
+    for (uint32_t i = 0; i < pulse_count && i < expected_count; i++) {
+        const expected_pulse_t *e = &expected[i];
+        const pulse_t *p = &pulses[i];
+        double ms = (double)sim_cycles_to_us(p->end - p->start) / 1000.0;
+        if (e->complete) {
+            CHECK(p->edges == e->cycles, "%s: released after %u rising edges, requested %u", e->what, p->edges,
+                  e->cycles);
+        } else {
+            CHECK(p->edges < e->cycles, "%s: ran to its last edge", e->what);
+            CHECK(ms >= e->min_ms && ms <= e->max_ms, "%s: released after %.3f ms, expected %u to %u ms", e->what,
+                  ms, e->min_ms, e->max_ms);
+        }
+        printf("%s: %u rising edges in %.3f ms\n", e->what, p->edges, ms);
+    }
+    return host_test_finish("test_reset_pulse");
+}
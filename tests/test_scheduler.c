@@ -0,0 +1,211 @@
+/**
+ * Scheduler test
+ *
+ * Drives the deadline heap from a virtual clock the way the tickless loops
+ * do: sleep to the next deadline, collect every expired timer, re-arm. A
+ * timer must fire exactly at its deadline, never before, and expired timers
+ * must come out earliest first. Random arm, move and cancel sequences are
+ * checked against a plain array of deadlines, and periodic timers re-armed
+ * from their own deadline must not drift.
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "host_test.h"
+#include "scheduler.h"
+
+#define RANDOM_STEPS    200000u
+#define PERIODIC_FIRES  100000u
+
+// Reference model: a deadline per id, or none
+typedef struct {
+    bool armed[SCHEDULER_MAX_TIMERS];
+    uint64_t deadline_us[SCHEDULER_MAX_TIMERS];
+} model_t;
+
+static uint32_t rng_state = 12345;
+
+static uint32_t rng(void) {
+    rng_state ^= rng_state << 13;
+    rng_state ^= rng_state >> 17;
+    rng_state ^= rng_state << 5;
+    return rng_state;
+}
+
+// Earliest armed id in the model, lowest id on a tie
+static bool model_earliest(const model_t *m, uint8_t *id) {
+    bool found = false;
+    for (uint8_t i = 0; i < SCHEDULER_MAX_TIMERS; i++) {
+        if (m->armed[i] && (!found || m->deadline_us[i] < m->deadline_us[*id])) {
+            *id = i;
+            found = true;
+        }
+    }
+    return found;
+}
+
+static void check_matches(const scheduler_t *s, const model_t *m, uint32_t step) {
+    for (uint8_t id = 0; id < SCHEDULER_MAX_TIMERS; id++) {
+        CHECK(scheduler_is_armed(s, id) == m->armed[id], "step %u: timer %u armed %d, expected %d", step, id,
+              scheduler_is_armed(s, id), m->armed[id]);
+    }
+
+    uint8_t earliest = 0;
+    uint64_t deadline = 0;
+    bool any = model_earliest(m, &earliest);
+    CHECK(scheduler_next_deadline(s, &deadline) == any, "step %u: next deadline %s", step,
+          any ? "missing" : "with nothing armed");
+    if (any) {
+        CHECK(deadline == m->deadline_us[earliest], "step %u: next deadline %llu, expected %llu", step,
+              (unsigned long long)deadline, (unsigned long long)m->deadline_us[earliest]);
+    }
+}
+
+// Random arms, moves and cancels; the clock jumps to the next deadline or
+// short of it, and every pop is checked against the model
+static void test_random(void) {
+    scheduler_t s;
+    model_t m = { { false }, { 0 } };
+    uint64_t now = 0;
+    uint32_t fired = 0;
+    scheduler_init(&s);
+
+    for (uint32_t step = 0; step < RANDOM_STEPS; step++) {
+        uint32_t r = rng();
+        uint8_t id = (uint8_t)(r % SCHEDULER_MAX_TIMERS);
+        switch ((r >> 8) % 4) {
+            case 0:
+            case 1: {
+                // Deadlines in the past, now, and ahead; ties are common
+                uint64_t deadline = now + (rng() % 2000) - 100;
+                if (deadline > now + 2000) deadline = now;
+                scheduler_arm(&s, id, deadline);
+                m.armed[id] = true;
+                m.deadline_us[id] = deadline;
+                break;
+            }
+            case 2:
+                scheduler_cancel(&s, id);
+                m.armed[id] = false;
+                break;
+            default: {
+                uint64_t next;
+                if (scheduler_next_deadline(&s, &next) && next > now) {
+                    // Sometimes wake early, as an event would
+                    now = (rng() & 1) ? now + (next - now) / 2 : next;
+                }
+                uint8_t popped;
+                uint64_t previous = 0;
+                while (scheduler_pop_expired(&s, now, &popped)) {
+                    CHECK(m.armed[popped], "step %u: timer %u popped but not armed", step, popped);
+                    CHECK(m.deadline_us[popped] <= now, "step %u: timer %u popped at %llu, due %llu", step,
+                          popped, (unsigned long long)now, (unsigned long long)m.deadline_us[popped]);
+                    CHECK(m.deadline_us[popped] >= previous, "step %u: timer %u popped out of order", step, popped);
+                    previous = m.deadline_us[popped];
+                    m.armed[popped] = false;
+                    fired++;
+                }
+                uint8_t late = 0;
+                CHECK(!model_earliest(&m, &late) || m.deadline_us[late] > now, "step %u: timer %u due %llu left at %llu",
+                      step, late, (unsigned long long)m.deadline_us[late], (unsigned long long)now);
+                break;
+            }
+        }
+        check_matches(&s, &m, step);
+    }
+    printf("%u random steps, %u timers fired\n", RANDOM_STEPS, fired);
+}
+
+// Periodic timers of coprime periods sleep straight to each deadline: every
+// fire lands exactly on a multiple of its period
+static void test_periodic(void) {
+    static const uint64_t periods[] = { 1000, 1300, 7919, 10000, 250000, 2000000 };
+    const uint8_t timers = sizeof(periods) / sizeof(periods[0]);
+    uint32_t fires[sizeof(periods) / sizeof(periods[0])] = { 0 };
+    scheduler_t s;
+    scheduler_init(&s);
+
+    for (uint8_t id = 0; id < timers; id++) {
+        scheduler_arm(&s, id, periods[id]);
+    }
+
+    uint64_t now = 0;
+    uint32_t total = 0;
+    uint32_t wakes = 0;
+    while (total < PERIODIC_FIRES) {
+        uint64_t deadline;
+        if (!scheduler_next_deadline(&s, &deadline)) break;
+        CHECK(deadline >= now, "deadline %llu behind the clock at %llu", (unsigned long long)deadline,
+              (unsigned long long)now);
+        now = deadline;
+        wakes++;
+
+        // Nothing is due a microsecond early
+        uint8_t id;
+        CHECK(!scheduler_pop_expired(&s, now - 1, &id), "timer %u fired before %llu", id, (unsigned long long)now);
+
+        while (scheduler_pop_expired(&s, now, &id)) {
+            fires[id]++;
+            total++;
+            CHECK(now == fires[id] * periods[id], "timer %u fire %u at %llu, due %llu", id, fires[id],
+                  (unsigned long long)now, (unsigned long long)(fires[id] * periods[id]));
+            scheduler_arm(&s, id, now + periods[id]);
+        }
+    }
+
+    // Each timer fired as often as its period allows up to the last wake
+    for (uint8_t id = 0; id < timers; id++) {
+        CHECK(fires[id] == now / periods[id], "timer %u: %u fires by %llu us, expected %llu", id, fires[id],
+              (unsigned long long)now, (unsigned long long)(now / periods[id]));
+    }
+    printf("%u periodic fires in %u wakes over %.3f s of virtual time\n", total, wakes, now / 1e6);
+}
+
+// Arming an armed timer moves it either way; cancelling keeps the rest
+static void test_move_cancel(void) {
+    scheduler_t s;
+    uint64_t deadline;
+    uint8_t id;
+    scheduler_init(&s);
+
+    CHECK(!scheduler_next_deadline(&s, &deadline), "deadline with nothing armed");
+    CHECK(!scheduler_pop_expired(&s, UINT64_MAX, &id), "pop with nothing armed");
+
+    for (uint8_t i = 0; i < SCHEDULER_MAX_TIMERS; i++) {
+        scheduler_arm(&s, i, 1000u * (i + 1));
+    }
+    scheduler_arm(&s, 7, 500);
+    CHECK(scheduler_next_deadline(&s, &deadline) && deadline == 500, "moved earlier: next %llu",
+          (unsigned long long)deadline);
+    scheduler_arm(&s, 7, 9000);
+    CHECK(scheduler_next_deadline(&s, &deadline) && deadline == 1000, "moved later: next %llu",
+          (unsigned long long)deadline);
+
+    scheduler_cancel(&s, 0);
+    scheduler_cancel(&s, 0);
+    CHECK(!scheduler_is_armed(&s, 0), "cancelled timer still armed");
+    CHECK(scheduler_next_deadline(&s, &deadline) && deadline == 2000, "after cancel: next %llu",
+          (unsigned long long)deadline);
+
+    // Ids out of range are ignored
+    scheduler_arm(&s, SCHEDULER_MAX_TIMERS, 1);
+    scheduler_cancel(&s, SCHEDULER_MAX_TIMERS);
+    CHECK(!scheduler_is_armed(&s, SCHEDULER_MAX_TIMERS), "id out of range armed");
+    CHECK(s.count == SCHEDULER_MAX_TIMERS - 1, "%u timers armed, expected %u", s.count, SCHEDULER_MAX_TIMERS - 1);
+
+    uint64_t previous = 0;
+    uint8_t popped = 0;
+    while (scheduler_pop_expired(&s, UINT64_MAX, &id)) {
+        CHECK(s.deadline_us[id] >= previous, "timer %u popped out of order", id);
+        previous = s.deadline_us[id];
+        popped++;
+    }
+    CHECK(popped == SCHEDULER_MAX_TIMERS - 1, "%u timers popped, expected %u", popped, SCHEDULER_MAX_TIMERS - 1);
+}
+
+int main(void) {
+    test_move_cancel();
+    test_periodic();
+    test_random();
+    return host_test_finish("test_scheduler");
+}
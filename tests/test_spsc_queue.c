@@ -0,0 +1,111 @@
+/**
+ * SPSC queue stress test
+ *
+ * A producer and a consumer thread hammer one queue the way core0 and core1
+ * share the command and telemetry queues. Every message must arrive once,
+ * intact and in order. A producer that waits for room, as clock_core_post()
+ * does, must leave the dropped count at zero however long the consumer
+ * stalls; one that pushes without waiting must have every failed push
+ * counted.
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <pthread.h>
+#include <sched.h>
+#include "host_test.h"
+#include "spsc_queue.h"
+
+#define STRESS_MESSAGES 1000000u
+#define STALL_EVERY     100000u     // Consumer yields for a while this often
+
+typedef struct {
+    spsc_queue_t queue;
+    bool wait_for_room;
+    uint32_t failed_pushes;         // Producer only
+    uint32_t received;              // Consumer only
+    uint32_t out_of_order;          // Consumer only
+} stress_t;
+
+static spsc_msg_t message(uint32_t i) {
+    spsc_msg_t msg = { .type = (uint8_t)i, .aux = (uint8_t)(i >> 8), .arg = i };
+    return msg;
+}
+
+static void *producer(void *arg) {
+    stress_t *s = arg;
+    for (uint32_t i = 0; i < STRESS_MESSAGES; i++) {
+        spsc_msg_t msg = message(i);
+        if (s->wait_for_room) {
+            while (!spsc_queue_has_room(&s->queue)) {
+                sched_yield();
+            }
+            if (!spsc_queue_push(&s->queue, &msg)) s->failed_pushes++;
+        } else {
+            while (!spsc_queue_push(&s->queue, &msg)) {
+                s->failed_pushes++;
+                sched_yield();
+            }
+        }
+    }
+    return NULL;
+}
+
+static void *consumer(void *arg) {
+    stress_t *s = arg;
+    while (s->received < STRESS_MESSAGES) {
+        spsc_msg_t msg;
+        if (!spsc_queue_pop(&s->queue, &msg)) {
+            sched_yield(); // Lets the producer in on a single host CPU
+            continue;
+        }
+
+        spsc_msg_t expected = message(s->received);
+        if (msg.type != expected.type || msg.aux != expected.aux || msg.arg != expected.arg) {
+            s->out_of_order++;
+        }
+        s->received++;
+
+        // Stand in for core1 busy in an engine stop
+        if (s->received % STALL_EVERY == 0) {
+            for (int i = 0; i < 1000; i++) sched_yield();
+        }
+    }
+    return NULL;
+}
+
+static void run(bool wait_for_room) {
+    static stress_t s;
+    spsc_queue_init(&s.queue);
+    s.wait_for_room = wait_for_room;
+    s.failed_pushes = 0;
+    s.received = 0;
+    s.out_of_order = 0;
+
+    double start = host_test_seconds();
+    pthread_t threads[2];
+    pthread_create(&threads[0], NULL, consumer, &s);
+    pthread_create(&threads[1], NULL, producer, &s);
+    pthread_join(threads[1], NULL);
+    pthread_join(threads[0], NULL);
+    double elapsed = host_test_seconds() - start;
+
+    const char *name = wait_for_room ? "waiting producer" : "retrying producer";
+    CHECK(s.received == STRESS_MESSAGES, "%s: %u of %u messages received", name, s.received, STRESS_MESSAGES);
+    CHECK(s.out_of_order == 0, "%s: %u messages out of order or corrupted", name, s.out_of_order);
+    CHECK(spsc_queue_count(&s.queue) == 0, "%s: %u messages left over", name, spsc_queue_count(&s.queue));
+    if (wait_for_room) {
+        CHECK(s.failed_pushes == 0, "%s: %u pushes failed after room was found", name, s.failed_pushes);
+        CHECK(s.queue.dropped == 0, "%s: %u counted as dropped", name, s.queue.dropped);
+    } else {
+        CHECK(s.queue.dropped == s.failed_pushes, "%s: %u counted as dropped, %u pushes failed", name,
+              s.queue.dropped, s.failed_pushes);
+    }
+    printf("%s: %u messages in %.3f s, %u full-queue retries\n", name, s.received, elapsed, s.failed_pushes);
+}
+
+int main(void) {
+    run(true);
+    run(false);
+    return host_test_finish("test_spsc_queue");
+}
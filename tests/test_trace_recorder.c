@@ -0,0 +1,249 @@
+/**
+ * Trace recorder test
+ *
+ * Records edges into a buffer of TRACE_BUFFER_SIZE bytes with microsecond
+ * ticks, as the output trace does, then parses the VCD it writes and
+ * compares every change with the edges fed in. TRACE_EDGES edges whose
+ * gaps are all just under TRACE_EDGE_MAX_US, the worst case the buffer is
+ * sized for, must all be kept, and one more must drop only the oldest. A
+ * realistic mix of scripted single steps, button presses, reset pulses,
+ * power switching and a steady clock, more than TRACE_EDGES edges in all,
+ * must lose nothing either.
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+#include "host_test.h"
+#include "config.h"
+#include "trace_recorder.h"
+
+#define CHANNELS 3
+
+typedef struct {
+    uint64_t time;
+    uint8_t channel;
+    bool level;
+} edge_t;
+
+static uint8_t buffer[TRACE_BUFFER_SIZE];
+static trace_recorder_t recorder;
+
+// Edges fed to the recorder, in order
+static edge_t *edges;
+static uint32_t edge_count;
+static uint32_t edge_capacity;
+static uint64_t now;
+static uint8_t levels;
+
+static uint32_t rng_state = 2463534242u;
+
+static uint32_t rng(void) {
+    rng_state ^= rng_state << 13;
+    rng_state ^= rng_state >> 17;
+    rng_state ^= rng_state << 5;
+    return rng_state;
+}
+
+static uint32_t pick(uint32_t n) {
+    return rng() % n;
+}
+
+static void start(uint64_t time, uint8_t initial_levels) {
+    now = time;
+    levels = initial_levels;
+    edge_count = 0;
+    trace_recorder_init(&recorder, buffer, sizeof(buffer), now, levels);
+}
+
+// Toggle a channel delta ticks after the previous edge
+static void toggle(uint8_t channel, uint64_t delta) {
+    if (edge_count == edge_capacity) {
+        edge_capacity = edge_capacity ? 2 * edge_capacity : 65536;
+        edges = realloc(edges, edge_capacity * sizeof(edge_t));
+    }
+    now += delta;
+    levels ^= (uint8_t)(1u << channel);
+    bool level = (levels >> channel) & 1u;
+    edges[edge_count++] = (edge_t){ .time = now, .channel = channel, .level = level };
+    CHECK(trace_recorder_edge(&recorder, channel, level, now), "edge %u not taken", edge_count);
+}
+
+// VCD text, collected from the writer
+
+static char *vcd;
+static size_t vcd_length;
+static size_t vcd_capacity;
+
+static void collect(void *context, const char *text) {
+    (void)context;
+    size_t length = strlen(text);
+    if (vcd_length + length + 1 > vcd_capacity) {
+        vcd_capacity = 2 * (vcd_length + length + 1);
+        vcd = realloc(vcd, vcd_capacity);
+    }
+    memcpy(&vcd[vcd_length], text, length + 1);
+    vcd_length += length;
+}
+
+// Parse the dump and compare it with edges[first..]
+static void check_vcd(const char *name, uint32_t first, uint64_t dropped) {
+    static const char *const names[CHANNELS] = { "clock", "reset", "power" };
+    trace_vcd_format_t format = { .names = names, .channel_count = CHANNELS, .tick_ps = 1000000 };
+    vcd_length = 0;
+    trace_recorder_write_vcd(&recorder, &format, collect, NULL);
+
+    // Levels just before the first edge held
+    uint8_t expected_levels = levels;
+    for (uint32_t i = edge_count; i-- > first; ) {
+        expected_levels ^= (uint8_t)(1u << edges[i].channel);
+    }
+
+    unsigned long long header_edges = 0, header_dropped = 0;
+    bool timescale = false, dumpvars = false, in_dumpvars = false;
+    char ids[CHANNELS] = { 0 };
+    uint64_t time = 0;
+    uint8_t dump_levels = 0;
+    uint32_t next = first;
+    bool ok = true;
+
+    for (char *line = vcd; ok && *line; ) {
+        char *end = strchr(line, '\n');
+        CHECK(end, "%s: unterminated line \"%s\"", name, line);
+        if (!end) break;
+        *end = '\0';
+
+        char id;
+        char var_name[16];
+        if (strncmp(line, "$comment", 8) == 0) {
+            sscanf(line, "$comment %llu edges, %llu dropped $end", &header_edges, &header_dropped);
+        } else if (strcmp(line, "$timescale 1us $end") == 0) {
+            timescale = true;
+        } else if (sscanf(line, "$var wire 1 %c %15s $end", &id, var_name) == 2) {
+            for (uint8_t c = 0; c < CHANNELS; c++) {
+                if (strcmp(var_name, names[c]) == 0) ids[c] = id;
+            }
+        } else if (strcmp(line, "$dumpvars") == 0) {
+            dumpvars = in_dumpvars = true;
+        } else if (strcmp(line, "$end") == 0) {
+            in_dumpvars = false;
+        } else if (line[0] == '#') {
+            time = strtoull(&line[1], NULL, 10);
+        } else if ((line[0] == '0' || line[0] == '1') && line[2] == '\0') {
+            int channel = -1;
+            for (uint8_t c = 0; c < CHANNELS; c++) {
+                if (ids[c] == line[1]) channel = c;
+            }
+            CHECK(channel >= 0, "%s: unknown signal in \"%s\"", name, line);
+            if (channel < 0) break;
+            bool level = line[0] == '1';
+            if (in_dumpvars) {
+                dump_levels |= (uint8_t)(level << channel);
+            } else if (next == edge_count) {
+                CHECK(false, "%s: change \"%s\" at %llu after the last edge", name, line, (unsigned long long)time);
+                ok = false;
+            } else {
+                const edge_t *e = &edges[next];
+                ok = time == e->time && channel == e->channel && level == e->level;
+                CHECK(ok, "%s: change %u is %d%s at %llu, expected %d%s at %llu", name, next - first, level,
+                      names[channel], (unsigned long long)time, e->level, names[e->channel],
+                      (unsigned long long)e->time);
+                next++;
+            }
+        }
+        line = end + 1;
+    }
+
+    CHECK(timescale, "%s: no 1us timescale", name);
+    CHECK(dumpvars && dump_levels == expected_levels, "%s: initial levels %x, expected %x", name, dump_levels,
+          expected_levels);
+    CHECK(next == edge_count, "%s: %u of %u changes in the VCD", name, next - first, edge_count - first);
+    CHECK(header_edges == edge_count - first && header_dropped == dropped, "%s: header says %llu edges, %llu dropped",
+          name, header_edges, header_dropped);
+    printf("%s: %u edges in %u bytes, %zu bytes of VCD\n", name, edge_count - first, recorder.used, vcd_length);
+}
+
+// Every gap as long as one entry of TRACE_EDGE_BYTES can hold
+static void test_worst_case(void) {
+    start(1000, 0);
+    uint64_t before[2] = { 0 };
+    for (uint32_t i = 0; i < TRACE_EDGES; i++) {
+        uint8_t channel = (uint8_t)pick(CHANNELS);
+        uint64_t delta = TRACE_EDGE_MAX_US - 1 - pick(TRACE_EDGE_MAX_US / 4);
+
+        // A gap repeated from two edges back would start a run
+        if (i >= 2 && edges[i - 2].channel == channel && delta == before[0]) delta--;
+        before[0] = before[1];
+        before[1] = delta;
+        toggle(channel, delta);
+    }
+    CHECK(recorder.dropped == 0, "worst case: %llu edges dropped", (unsigned long long)recorder.dropped);
+    CHECK(recorder.used == TRACE_BUFFER_SIZE, "worst case: %u bytes used", recorder.used);
+    check_vcd("worst case", 0, 0);
+
+    // The buffer is full, so the next edge (a gap no earlier edge had, so
+    // not a run) drops exactly the oldest
+    toggle(0, TRACE_EDGE_MAX_US / 2);
+    CHECK(recorder.dropped == 1, "one more edge: %llu dropped", (unsigned long long)recorder.dropped);
+    check_vcd("one more edge", 1, 1);
+}
+
+// Single steps from a script over a serial port: a command every few
+// hundred microseconds to a few milliseconds, sometimes a reset with them
+static void scripted_steps(uint32_t steps) {
+    for (uint32_t i = 0; i < steps; i++) {
+        toggle(0, 90 + pick(4000));
+        if (pick(200) == 0) {
+            toggle(1, pick(3));             // Reset pulse starts with an edge
+            for (uint32_t n = 0; n < 8; n++) toggle(0, 90 + pick(4000));
+            toggle(1, 20 + pick(200));      // Ends when core1 notices the count
+        }
+    }
+}
+
+// Single steps by hand: debounced presses a tenth of a second or more apart
+static void button_steps(uint32_t steps) {
+    for (uint32_t i = 0; i < steps; i++) {
+        toggle(0, 100000 + pick(TRACE_EDGE_MAX_US - 100000));
+    }
+}
+
+// A clock run by the CPU: the same two gaps over and over
+static void steady_clock(uint32_t cycles, uint32_t half_us) {
+    for (uint32_t i = 0; i < cycles; i++) {
+        toggle(0, half_us);
+        toggle(0, half_us);
+    }
+}
+
+static void test_realistic(void) {
+    start(5000000, 1u << 2);    // Power already on
+    while (edge_count < TRACE_EDGES + TRACE_EDGES / 4) {
+        switch (pick(6)) {
+            case 0:
+                button_steps(1 + pick(20));
+                break;
+            case 1:
+                steady_clock(1 + pick(2000), 1 + pick(500));
+                break;
+            case 2:
+                toggle(2, 200000 + pick(TRACE_EDGE_MAX_US - 200000));   // Power cycled
+                toggle(2, 1000 + pick(100000));
+                break;
+            default:
+                scripted_steps(1 + pick(500));
+                break;
+        }
+    }
+    CHECK(recorder.dropped == 0, "realistic: %llu edges dropped", (unsigned long long)recorder.dropped);
+    check_vcd("realistic", 0, 0);
+}
+
+int main(void) {
+    test_worst_case();
+    test_realistic();
+    free(edges);
+    free(vcd);
+    return host_test_finish("test_trace_recorder");
+}
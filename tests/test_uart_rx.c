@@ -0,0 +1,114 @@
+/**
+ * UART receive throughput test
+ *
+ * Runs the whole firmware on the simulated cores and pastes a long command
+ * script into UART0 back to back at full baud rate, far more than the
+ * receive ring holds, while each command's reply is several times longer
+ * than the command. Every line must run, in order, with no byte lost in the
+ * FIFO or the ring. Lines end in CR, LF or CR LF and some are edited with
+ * backspace, as typed or pasted from a terminal. Replies are read from the
+ * console, which unlike the UART's transmit ring never drops.
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include <stdlib.h>
+#include "host_test.h"
+#include "config.h"
+#include "uart_rx.h"
+
+#define LINES           1500u
+#define START_MS        300u
+#define SETTLE_MS       100u        // After the last byte for the last reply
+#define CHUNK           1024u       // Bytes handed to the wire at once
+
+int firmware_main(void);
+
+static char script[LINES * 16];
+static uint32_t script_length = 0;
+static uint32_t sent = 0;
+static uint64_t next_chunk = 0;
+static uint64_t end_cycles = 0;
+static uint32_t ring_peak = 0;
+
+static void build_script(void) {
+    static const char *const ends[] = { "\r", "\n", "\r\n" };
+    for (uint32_t n = 1; n <= LINES; n++) {
+        const char *typed = n % 7 == 0 ? "dwelx\bl" : "dwell";
+        script_length += (uint32_t)sprintf(&script[script_length], "%s %u%s", typed, n, ends[n % 3]);
+    }
+}
+
+// Keeps the wire busy: the next chunk goes on before the last has arrived
+static uint64_t paste_next_event(void) {
+    uint64_t tick = sim_now() + sim_us_to_cycles(1000);
+    if (sent < script_length && next_chunk < tick) return next_chunk;
+    return end_cycles && end_cycles < tick ? end_cycles : tick;
+}
+
+static void paste_run_event(uint64_t now) {
+    uint32_t used = byte_ring_used(uart_rx_ring(uart0));
+    if (used > ring_peak) ring_peak = used;
+
+    if (sent < script_length && now >= next_chunk) {
+        uint32_t length = script_length - sent < CHUNK ? script_length - sent : CHUNK;
+        sim_uart_inject(0, &script[sent], length);
+        sent += length;
+        next_chunk = now + (CHUNK - 64) * sim_uart_char_cycles(0);
+        if (sent == script_length) {
+            end_cycles = now + length * sim_uart_char_cycles(0) + sim_us_to_cycles(SETTLE_MS * 1000ull);
+        }
+    }
+    if (end_cycles && now >= end_cycles) sim_stop();
+}
+
+static const sim_agent_t paste_agent = {
+    .name = "paste",
+    .next_event = paste_next_event,
+    .run_event = paste_run_event,
+};
+
+static void core0_entry(void) {
+    firmware_main();
+}
+
+int main(void) {
+    build_script();
+    host_test_sim_init();
+
+    // Keep the firmware's console output to read the replies back
+    FILE *console = tmpfile();
+    CHECK(console != NULL, "no temporary file for the console");
+    if (!console) return host_test_finish("test_uart_rx");
+    FILE *terminal = sim_console;
+    sim_console = console;
+
+    next_chunk = sim_us_to_cycles(START_MS * 1000ull);
+    sim_register_agent(&paste_agent);
+    sim_core_run(core0_entry, SIM_NEVER);
+    sim_console = terminal;
+
+    uint32_t replies = 0;
+    uint32_t out_of_order = 0;
+    char text[256];
+    rewind(console);
+    while (fgets(text, sizeof(text), console)) {
+        const char *reply = strstr(text, "Sweep dwell set to ");
+        if (!reply) continue;
+        uint32_t value = (uint32_t)strtoul(reply + strlen("Sweep dwell set to "), NULL, 10);
+        if (value != replies + 1) out_of_order++;
+        replies++;
+    }
+    fclose(console);
+
+    double seconds = (double)sim_cycles_to_us(script_length * sim_uart_char_cycles(0)) / 1e6;
+    CHECK(sent == script_length, "pasted %u of %u bytes", sent, script_length);
+    CHECK(replies == LINES, "%u replies to %u lines", replies, LINES);
+    CHECK(out_of_order == 0, "%u replies out of order", out_of_order);
+    CHECK(sim_uart_overruns(0) == 0, "%u bytes overran the receive FIFO", sim_uart_overruns(0));
+    CHECK(uart_rx_dropped(uart0) == 0, "%u bytes dropped by the receive ring", uart_rx_dropped(uart0));
+    printf("%u lines, %u bytes in %.3f s at %u baud; receive ring peaked at %u of %u bytes\n", LINES, script_length,
+           seconds, UART_BAUD_RATE, ring_peak, UART_RX_BUFFER_SIZE);
+    return host_test_finish("test_uart_rx");
+}
@@ -0,0 +1,151 @@
+/**
+ * UART transmit overflow test
+ *
+ * Runs the transmit rings and their DMA channels on the simulated cores and
+ * writes far more than UART_TX_BUFFER_SIZE to UART0, first all at once and
+ * then steadily faster than the line can carry it. Every write must return
+ * without virtual time passing. A write that does not fit must be dropped
+ * whole and its bytes counted exactly, and every write that was queued must
+ * reach the wire complete and in order. UART1 must be unaffected.
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+#include "host_test.h"
+#include "config.h"
+#include "uart_tx.h"
+
+#define BURST_BYTES     (3u * UART_TX_BUFFER_SIZE)
+#define STEADY_MS       500u
+#define STEADY_GAP_US   100u        // A message this often is several times the baud rate
+#define DRAIN_LIMIT_MS  1000u
+
+typedef struct {
+    char *sent;                 // Queued messages, as they must leave the wire
+    uint32_t sent_length;
+    uint32_t sent_capacity;
+    uint32_t writes;
+    uint32_t refused;           // Writes dropped
+    uint32_t refused_bytes;
+    uint32_t blocked;           // Writes during which virtual time passed
+} log_t;
+
+static log_t uart0_log;
+static log_t uart1_log;
+static uint32_t burst_queued;
+static uint64_t drain_us;
+
+static void write_message(uart_inst_t *uart, log_t *log, const char *text) {
+    uint32_t length = (uint32_t)strlen(text);
+    uint64_t before = sim_now();
+    bool queued = uart_tx_write(uart, text, length);
+    if (sim_now() != before) log->blocked++;
+    log->writes++;
+
+    if (!queued) {
+        log->refused++;
+        log->refused_bytes += length;
+        return;
+    }
+    if (log->sent_length + length > log->sent_capacity) {
+        log->sent_capacity = 2 * (log->sent_length + length);
+        log->sent = realloc(log->sent, log->sent_capacity);
+    }
+    memcpy(&log->sent[log->sent_length], text, length);
+    log->sent_length += length;
+}
+
+// Status-like lines of varying length, numbered so a lost or repeated one
+// shows
+static void next_message(char *text, size_t size, uint32_t n) {
+    static const char *const padding = "................................................";
+    snprintf(text, size, "message %u: state %u%.*s\n", n, n * 7919u % 1000u, (int)(n * 13u % 48u), padding);
+}
+
+// Wait for both rings to empty
+static void drain(void) {
+    uint64_t start = time_us_64();
+    while (uart_tx_free(uart0) < UART_TX_BUFFER_SIZE || uart_tx_free(uart1) < UART_TX_BUFFER_SIZE) {
+        if (time_us_64() - start > DRAIN_LIMIT_MS * 1000ull) break;
+        sleep_ms(1);
+    }
+    drain_us = time_us_64() - start;
+}
+
+static void core0_entry(void) {
+    uart_init(uart0, UART_BAUD_RATE);
+    uart_init(uart1, UART1_BAUD_RATE);
+    uart_tx_init();
+    char text[96];
+    uint32_t n = 0;
+
+    // Everything at once: the ring fills and the rest is dropped
+    uint32_t attempted = 0;
+    while (attempted < BURST_BYTES) {
+        next_message(text, sizeof(text), n++);
+        attempted += (uint32_t)strlen(text);
+        write_message(uart0, &uart0_log, text);
+    }
+    burst_queued = uart0_log.sent_length;
+    write_message(uart1, &uart1_log, "uart1 still has room\n");
+    drain();
+
+    // Faster than the line for a while, with UART1 well within its own
+    uint64_t end = time_us_64() + STEADY_MS * 1000ull;
+    for (uint32_t i = 0; time_us_64() < end; i++) {
+        next_message(text, sizeof(text), n++);
+        write_message(uart0, &uart0_log, text);
+        if (i % 100 == 0) write_message(uart1, &uart1_log, text);
+        sleep_us(STEADY_GAP_US);
+    }
+    drain();
+}
+
+// The wire must carry exactly the queued messages
+static void check_wire(const char *name, FILE *wire, const log_t *log) {
+    rewind(wire);
+    char *received = malloc(log->sent_length + 1);
+    size_t length = fread(received, 1, log->sent_length + 1, wire);
+    CHECK(length == log->sent_length, "%s: %zu bytes on the wire, %u queued", name, length, log->sent_length);
+
+    size_t same = 0;
+    while (same < length && same < log->sent_length && received[same] == log->sent[same]) same++;
+    CHECK(same == log->sent_length, "%s: wire differs from the queued messages at byte %zu", name, same);
+    free(received);
+}
+
+int main(void) {
+    host_test_sim_init();
+    FILE *wire0 = tmpfile();
+    FILE *wire1 = tmpfile();
+    CHECK(wire0 && wire1, "no temporary files for the wires");
+    if (!wire0 || !wire1) return host_test_finish("test_uart_tx");
+    sim_uart_set_capture(0, wire0);
+    sim_uart_set_capture(1, wire1);
+    sim_core_run(core0_entry, SIM_NEVER);
+    sim_uart_set_capture(0, NULL);
+    sim_uart_set_capture(1, NULL);
+
+    CHECK(uart0_log.blocked == 0 && uart1_log.blocked == 0, "%u writes waited", uart0_log.blocked + uart1_log.blocked);
+    CHECK(burst_queued > UART_TX_BUFFER_SIZE - 96 && burst_queued <= UART_TX_BUFFER_SIZE,
+          "burst: %u bytes queued into a %u-byte ring", burst_queued, UART_TX_BUFFER_SIZE);
+    CHECK(uart0_log.refused > 0, "uart0: nothing dropped");
+    CHECK(uart_tx_dropped(uart0) == uart0_log.refused_bytes, "uart0: %u bytes counted as dropped, %u refused",
+          uart_tx_dropped(uart0), uart0_log.refused_bytes);
+    CHECK(uart_tx_free(uart0) == UART_TX_BUFFER_SIZE, "uart0: %u bytes never sent",
+          UART_TX_BUFFER_SIZE - uart_tx_free(uart0));
+    CHECK(uart1_log.refused == 0 && uart_tx_dropped(uart1) == 0, "uart1: %u writes dropped", uart1_log.refused);
+    check_wire("uart0", wire0, &uart0_log);
+    check_wire("uart1", wire1, &uart1_log);
+
+    printf("uart0: %u of %u writes queued, %u bytes sent and %u dropped; last drain %.3f ms\n",
+           uart0_log.writes - uart0_log.refused, uart0_log.writes, uart0_log.sent_length, uart0_log.refused_bytes,
+           drain_us / 1000.0);
+    fclose(wire0);
+    fclose(wire1);
+    free(uart0_log.sent);
+    free(uart1_log.sent);
+    return host_test_finish("test_uart_tx");
+}
@@ -0,0 +1,68 @@
+# Host tests, built with the simulator (run with ctest)
+#
+# Unit tests are programs in tests/ linked against the simulator library;
+# a test passes when it exits with status 0. Simulator scripts in
+# tests/sim/ carry their own expectations, which tests/sim_test.py checks
+# against the simulator's output.
+
+enable_testing()
+
+set(TEST_DIR ${CMAKE_CURRENT_SOURCE_DIR}/tests)
+
+# add_host_test(<name> <sources>...): one test program per source set
+function(add_host_test name)
+    add_executable(${name} ${ARGN})
+    target_link_libraries(${name} PRIVATE multimode_sim)
+    target_include_directories(${name} PRIVATE ${TEST_DIR})
+    set_target_properties(${name} PROPERTIES C_STANDARD 11 C_EXTENSIONS ON)
+    add_test(NAME ${name} COMMAND ${name})
+endfunction()
+
+file(GLOB SIM_TEST_SCRIPTS CONFIGURE_DEPENDS ${TEST_DIR}/sim/*.sim)
+foreach(script ${SIM_TEST_SCRIPTS})
+    get_filename_component(name ${script} NAME_WE)
+    add_test(NAME sim_${name}
+            COMMAND ${Python3_EXECUTABLE} ${TEST_DIR}/sim_test.py
+                    $<TARGET_FILE:multimode_clock_sim> ${script})
+endforeach()
+
+# Binary protocol: control_client.py's frames through the simulator's UART0
+add_test(NAME control_loopback
+        COMMAND ${Python3_EXECUTABLE} ${TEST_DIR}/control_loopback.py
+                $<TARGET_FILE:multimode_clock_sim>)
+
+add_host_test(test_pio_clock ${TEST_DIR}/test_pio_clock.c)
+add_host_test(test_pwm_solver ${TEST_DIR}/test_pwm_solver.c)
+add_host_test(test_clock_cache ${TEST_DIR}/test_clock_cache.c)
+add_host_test(test_debounce ${TEST_DIR}/test_debounce.c)
+add_host_test(test_scheduler ${TEST_DIR}/test_scheduler.c)
+add_host_test(test_reset_pulse ${TEST_DIR}/test_reset_pulse.c)
+add_host_test(test_pot_filter ${TEST_DIR}/test_pot_filter.c)
+add_host_test(test_line_assembler ${TEST_DIR}/test_line_assembler.c)
+add_host_test(test_uart_rx ${TEST_DIR}/test_uart_rx.c)
+add_host_test(test_uart_tx ${TEST_DIR}/test_uart_tx.c)
+add_host_test(test_command_table ${TEST_DIR}/test_command_table.c)
+add_host_test(test_trace_recorder ${TEST_DIR}/test_trace_recorder.c)
+add_host_test(test_control_arbiter ${TEST_DIR}/test_control_arbiter.c)
+add_host_test(test_discipline_loop ${TEST_DIR}/test_discipline_loop.c)
+
+# Built once per taper, each linked with its own pot table in place of the
+# library's (the one config.h selects)
+foreach(taper linear log)
+    string(TOUPPER ${taper} TAPER)
+    add_custom_command(
+            OUTPUT ${CMAKE_CURRENT_BINARY_DIR}/clock_tables_${taper}.c
+            COMMAND ${Python3_EXECUTABLE} ${CMAKE_CURRENT_SOURCE_DIR}/gen_clock_tables.py
+                    --source-dir ${CMAKE_CURRENT_SOURCE_DIR} --pot-taper ${taper}
+                    --output ${CMAKE_CURRENT_BINARY_DIR}/clock_tables_${taper}.c
+            DEPENDS gen_clock_tables.py config.h pio_clock.h clock_cache.h
+            )
+    add_host_test(test_pot_taper_${taper} ${TEST_DIR}/test_pot_taper.c
+                  ${CMAKE_CURRENT_BINARY_DIR}/clock_tables_${taper}.c)
+    target_compile_definitions(test_pot_taper_${taper} PRIVATE POT_TAPER=POT_TAPER_${TAPER})
+endforeach()
+
+# Runs the queue between two host threads standing in for the cores
+find_package(Threads REQUIRED)
+add_host_test(test_spsc_queue ${TEST_DIR}/test_spsc_queue.c)
+target_link_libraries(test_spsc_queue PRIVATE Threads::Threads)
@@ -0,0 +1,249 @@
+/**
+ * Trace Recorder Module for Multimode Clock Source
+ */
+
+#include "trace_recorder.h"
+#include <stdio.h>
+
+// Entry layout: varint (7 bits per byte, least significant group first) of
+// (payload << 2) | code. Codes 0-2 are an edge on that channel with the
+// payload as its delta; code 3 is a run entry whose payload counts repeats
+// of the two edges before it.
+#define TRACE_RUN_CODE      3u
+#define TRACE_VARINT_MAX    10
+
+static uint32_t encode_varint(uint64_t value, uint8_t *out) {
+    uint32_t n = 0;
+    do {
+        uint8_t byte = value & 0x7f;
+        value >>= 7;
+        out[n++] = byte | (value ? 0x80 : 0);
+    } while (value);
+    return n;
+}
+
+static uint64_t decode_varint(const trace_recorder_t *t, uint32_t offset, uint32_t *length) {
+    uint64_t value = 0;
+    uint32_t n = 0;
+    uint8_t byte;
+    do {
+        byte = t->buffer[(t->head + offset + n) % t->size];
+        value |= (uint64_t)(byte & 0x7f) << (7 * n);
+        n++;
+    } while (byte & 0x80);
+    *length = n;
+    return value;
+}
+
+static void push_history(trace_edge_t *history, uint8_t channel, uint64_t delta) {
+    history[0] = history[1];
+    history[1].channel = channel;
+    history[1].delta = delta;
+}
+
+// Drop the oldest entry, folding it into the origin state
+static void evict(trace_recorder_t *t) {
+    uint32_t length;
+    uint64_t value = decode_varint(t, 0, &length);
+    uint8_t code = value & 3u;
+    uint64_t payload = value >> 2;
+
+    if (code == TRACE_RUN_CODE) {
+        const trace_edge_t *h = t->origin_history;
+        t->origin_time += payload * (h[0].delta + h[1].delta);
+        if (payload & 1u) {
+            t->origin_levels ^= (uint8_t)((1u << h[0].channel) ^ (1u << h[1].channel));
+        }
+        t->edges -= 2u * payload;
+        t->dropped += 2u * payload;
+    } else {
+        t->origin_time += payload;
+        t->origin_levels ^= (uint8_t)(1u << code);
+        push_history(t->origin_history, code, payload);
+        t->edges--;
+        t->dropped++;
+    }
+
+    t->head = (t->head + length) % t->size;
+    t->used -= length;
+}
+
+static void append(trace_recorder_t *t, uint64_t value) {
+    uint8_t bytes[TRACE_VARINT_MAX];
+    uint32_t length = encode_varint(value, bytes);
+
+    while (t->size - t->used < length) {
+        evict(t);
+    }
+    for (uint32_t i = 0; i < length; i++) {
+        t->buffer[(t->head + t->used + i) % t->size] = bytes[i];
+    }
+    t->used += length;
+}
+
+static void append_edge(trace_recorder_t *t, uint8_t channel, uint64_t delta) {
+    append(t, (delta << 2) | channel);
+    push_history(t->history, channel, delta);
+    if (t->history_count < 2) t->history_count++;
+}
+
+// Write out a pending run, and the first half of a repeat if one was seen
+static void flush_run(trace_recorder_t *t) {
+    if (t->run_count) {
+        append(t, ((uint64_t)t->run_count << 2) | TRACE_RUN_CODE);
+        t->run_count = 0;
+    }
+    if (t->run_half) {
+        t->run_half = false;
+        append_edge(t, t->history[0].channel, t->history[0].delta);
+    }
+}
+
+void trace_recorder_init(trace_recorder_t *t, uint8_t *buffer, uint32_t size, uint64_t now, uint8_t levels) {
+    *t = (trace_recorder_t){
+        .buffer = buffer,
+        .size = size,
+        .origin_time = now,
+        .origin_levels = levels,
+        .last_time = now,
+        .levels = levels,
+    };
+}
+
+bool trace_recorder_edge(trace_recorder_t *t, uint8_t channel, bool level, uint64_t now) {
+    uint8_t bit = (uint8_t)(1u << channel);
+    if (channel >= TRACE_RECORDER_MAX_CHANNELS || ((t->levels & bit) != 0) == level) return false;
+
+    // A late timestamp is recorded at the time of the previous edge
+    uint64_t delta = 0;
+    if (now > t->last_time) {
+        delta = now - t->last_time;
+        t->last_time = now;
+    }
+    t->levels ^= bit;
+    t->edges++;
+
+    // Extend a run while the edges keep repeating the last two written
+    if (t->history_count == 2) {
+        const trace_edge_t *expect = &t->history[t->run_half ? 1 : 0];
+        if (expect->channel == channel && expect->delta == delta && t->run_count < UINT32_MAX / 2) {
+            if (t->run_half) {
+                t->run_count++;
+            }
+            t->run_half = !t->run_half;
+            return true;
+        }
+        flush_run(t);
+    }
+
+    append_edge(t, channel, delta);
+    return true;
+}
+
+uint64_t trace_recorder_edges(const trace_recorder_t *t) {
+    return t->edges;
+}
+
+// VCD output
+
+typedef struct {
+    const trace_vcd_format_t *format;
+    trace_write_fn write;
+    void *context;
+    uint64_t multiplier;        // VCD time units per tick
+    uint64_t time;
+    uint64_t written_time;
+    bool time_written;
+    uint8_t levels;
+    trace_edge_t history[2];
+} vcd_writer_t;
+
+static void vcd_edge(vcd_writer_t *w, uint8_t channel, uint64_t delta) {
+    char text[48];
+
+    w->time += delta;
+    w->levels ^= (uint8_t)(1u << channel);
+    push_history(w->history, channel, delta);
+
+    if (!w->time_written || w->time != w->written_time) {
+        snprintf(text, sizeof(text), "#%llu\n", (unsigned long long)(w->time * w->multiplier));
+        w->write(w->context, text);
+        w->written_time = w->time;
+        w->time_written = true;
+    }
+    snprintf(text, sizeof(text), "%c%c\n", (w->levels >> channel) & 1u ? '1' : '0', '!' + channel);
+    w->write(w->context, text);
+}
+
+static void vcd_run(vcd_writer_t *w, uint64_t count) {
+    for (uint64_t i = 0; i < count; i++) {
+        trace_edge_t first = w->history[0];
+        trace_edge_t second = w->history[1];
+        vcd_edge(w, first.channel, first.delta);
+        vcd_edge(w, second.channel, second.delta);
+    }
+}
+
+void trace_recorder_write_vcd(const trace_recorder_t *t, const trace_vcd_format_t *format,
+                              trace_write_fn write, void *context) {
+    vcd_writer_t w = {
+        .format = format,
+        .write = write,
+        .context = context,
+        .time = t->origin_time,
+        .levels = t->origin_levels,
+        .history = { t->origin_history[0], t->origin_history[1] },
+    };
+    char text[96];
+
+    const char *timescale = "1ps";
+    w.multiplier = format->tick_ps;
+    if (format->tick_ps % 1000000u == 0) {
+        timescale = "1us";
+        w.multiplier = format->tick_ps / 1000000u;
+    } else if (format->tick_ps % 1000u == 0) {
+        timescale = "1ns";
+        w.multiplier = format->tick_ps / 1000u;
+    }
+
+    write(context, "$version Multimode Clock Source trace $end\n");
+    snprintf(text, sizeof(text), "$comment %llu edges, %llu dropped $end\n",
+             (unsigned long long)t->edges, (unsigned long long)t->dropped);
+    write(context, text);
+    snprintf(text, sizeof(text), "$timescale %s $end\n", timescale);
+    write(context, text);
+    write(context, "$scope module multimode_clock $end\n");
+    for (uint8_t i = 0; i < format->channel_count; i++) {
+        snprintf(text, sizeof(text), "$var wire 1 %c %s $end\n", '!' + i, format->names[i]);
+        write(context, text);
+    }
+    write(context, "$upscope $end\n$enddefinitions $end\n");
+
+    snprintf(text, sizeof(text), "#%llu\n$dumpvars\n", (unsigned long long)(w.time * w.multiplier));
+    write(context, text);
+    for (uint8_t i = 0; i < format->channel_count; i++) {
+        snprintf(text, sizeof(text), "%c%c\n", (w.levels >> i) & 1u ? '1' : '0', '!' + i);
+        write(context, text);
+    }
+    write(context, "$end\n");
+    w.written_time = w.time;
+    w.time_written = true;
+
+    // Stored entries, then the run still held in the recorder
+    uint32_t offset = 0;
+    while (offset < t->used) {
+        uint32_t length;
+        uint64_t value = decode_varint(t, offset, &length);
+        offset += length;
+
+        if ((value & 3u) == TRACE_RUN_CODE) {
+            vcd_run(&w, value >> 2);
+        } else {
+            vcd_edge(&w, (uint8_t)(value & 3u), value >> 2);
+        }
+    }
+    vcd_run(&w, t->run_count);
+    if (t->run_half) {
+        vcd_edge(&w, w.history[0].channel, w.history[0].delta);
+    }
+}
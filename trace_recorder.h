@@ -0,0 +1,100 @@
+/**
+ * Trace Recorder Module for Multimode Clock Source
+ *
+ * Records timestamped edges of a few digital lines into a RAM ring buffer and
+ * writes them out as a Value Change Dump (VCD) for GTKWave. It is a pure
+ * data structure with no hardware access, shared by the on-target output
+ * trace and the host simulator.
+ *
+ * Storage is delta encoded. Each edge is a varint holding the ticks since
+ * the previous edge and the channel; the level is implied, as every edge
+ * toggles its channel. A periodic waveform collapses into run entries that
+ * repeat the previous two edges, so a steady clock costs a few bytes no
+ * matter how long it runs. When the buffer is full the oldest entries are
+ * dropped.
+ */
+
+#ifndef TRACE_RECORDER_H
+#define TRACE_RECORDER_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// Channels per recorder (two bits of each entry select the channel; the
+// fourth code marks a run entry)
+#define TRACE_RECORDER_MAX_CHANNELS 3
+
+typedef struct {
+    uint8_t channel;
+    uint64_t delta;             // Ticks since the previous edge
+} trace_edge_t;
+
+typedef struct {
+    uint8_t *buffer;
+    uint32_t size;
+    uint32_t head;              // Oldest stored byte
+    uint32_t used;              // Bytes stored
+
+    // State just before the oldest stored entry
+    uint64_t origin_time;
+    uint8_t origin_levels;
+    trace_edge_t origin_history[2];
+
+    // State after the newest edge
+    uint64_t last_time;
+    uint8_t levels;             // Bit n is the level of channel n
+    trace_edge_t history[2];    // Last two edges written, oldest first
+    uint8_t history_count;
+
+    // Repeats of history[] not yet written to the buffer
+    uint32_t run_count;
+    bool run_half;              // First edge of one more repeat seen
+
+    uint64_t edges;             // Edges held (buffer and pending run)
+    uint64_t dropped;           // Edges lost to make room
+} trace_recorder_t;
+
+typedef struct {
+    const char *const *names;   // Signal name per channel
+    uint8_t channel_count;
+    uint32_t tick_ps;           // Length of a tick in picoseconds
+} trace_vcd_format_t;
+
+typedef void (*trace_write_fn)(void *context, const char *text);
+
+/**
+ * Initialize an empty recorder
+ * @param t Recorder
+ * @param buffer Storage for encoded edges
+ * @param size Size of buffer in bytes
+ * @param now Start time in ticks
+ * @param levels Initial level of each channel (bit n is channel n)
+ */
+void trace_recorder_init(trace_recorder_t *t, uint8_t *buffer, uint32_t size, uint64_t now, uint8_t levels);
+
+/**
+ * Record the level of a channel
+ * @param t Recorder
+ * @param channel Channel number (below TRACE_RECORDER_MAX_CHANNELS)
+ * @param level New level
+ * @param now Time in ticks (not earlier than the previous edge)
+ * @return true if this was an edge, false if the level did not change
+ */
+bool trace_recorder_edge(trace_recorder_t *t, uint8_t channel, bool level, uint64_t now);
+
+/**
+ * Number of edges currently held
+ */
+uint64_t trace_recorder_edges(const trace_recorder_t *t);
+
+/**
+ * Write the recorded edges as a VCD file
+ * @param t Recorder
+ * @param format Signal names and timebase
+ * @param write Called with successive pieces of the file
+ * @param context Passed through to write
+ */
+void trace_recorder_write_vcd(const trace_recorder_t *t, const trace_vcd_format_t *format,
+                              trace_write_fn write, void *context);
+
+#endif // TRACE_RECORDER_H
@@ -4,280 +4,705 @@
 
 #include "uart_control.h"
 #include "config.h"
+#include "button_handler.h"
+#include "clock_generator.h"
+#include "pwm_solver.h"
+#include "duty_cycle.h"
+#include "pio_clock.h"
+#include "pio_phase.h"
+#include "clock_cache.h"
+#include "sys_clock.h"
+#include "pwm_clock.h"
+#include "sweep.h"
+#include "freq_counter.h"
+#include "discipline.h"
+#include "pio_counter.h"
+#include "clock_core.h"
+#include "output_trace.h"
+#include "command_table.h"
+#include "status_display.h"
 #include "hardware/gpio.h"
+#include "hardware/clocks.h"
 #include <stdio.h>
-#include <stdlib.h>
-#include <string.h>
 
 // UART control state variables
 static bool uart_clock_running = false;
 static uint32_t uart_set_frequency = 0;
-static char uart_cmd_buffer[UART_CMD_BUFFER_SIZE];
-static uint8_t uart_cmd_index = 0;
-static uint32_t uart_menu_timeout = 0;
-static bool uart_pwm_active = false;
+static command_table_t uart_command_table;
+static control_source_t command_source = CONTROL_SOURCE_UART0;   // Port of the running command
+static volatile bool uart_pwm_active = false;          // Engine state, owned by core1
+static volatile uint64_t uart_achieved_millihz = 0;
+static volatile int32_t uart_error_ppb = 0;
+static uint32_t uart_burst_last_cycle = 0;             // Owned by core1
+static uint32_t uart_engine_frequency = 0;             // Running "freq" clock, owned by core1
+static uint32_t sweep_dwell_ms = SWEEP_DWELL_DEFAULT_MS;
 
 // Hardware timer variables (legacy - kept for compatibility)
 static alarm_id_t uart_alarm_id = 0;
 static bool uart_timer_active = false;
 
-// External function declarations
-extern void set_mode(clock_mode_t mode);
-extern clock_mode_t get_previous_mode(void);
-extern void print_status(void);
-extern void start_reset_pulse(void);
-extern bool get_reset_active(void);
-extern void set_power_state(bool state);
-extern bool get_power_state(void);
-extern void toggle_clock_output(void);
-extern bool get_clock_state(void);
-extern void set_clock_output(bool state);
-extern bool any_button_pressed(void);
+// Report a request the arbiter turned down; true if it was carried out
+static bool accepted(control_arbiter_result_t result) {
+    if (result == CONTROL_ARBITER_PANEL_IN_USE) {
+        printf("Front panel in use - command ignored\n");
+    }
+    return result == CONTROL_ARBITER_OK;
+}
+
+// Text command handlers; values are the parsed arguments (0 if none)
+
+static void command_stop(const uint64_t *values) {
+    (void)values;
+    if (accepted(control_arbiter_stop(command_source))) {
+        printf("Clock stopped\n");
+    }
+}
+
+static void command_toggle(const uint64_t *values) {
+    (void)values;
+    bool level;
+    if (accepted(control_arbiter_toggle(command_source, &level))) {
+        printf("Clock toggled to %s\n", level ? "HIGH" : "LOW");
+    }
+}
+
+// System clock cycles per output cycle for each engine at its fastest
+#define PWM_MIN_RATIO   PWM_SOLVER_PERIOD_MIN
+#define BURST_MIN_RATIO (2 * PIO_BURST_HALF_OVERHEAD)
+#define WAIT_MIN_RATIO  PIO_CLOCK_PERIOD_MIN
+
+// Refuse a frequency the engine cannot reach; true if it can
+static bool reachable(uint32_t frequency, uint32_t min_ratio) {
+    uint32_t max = sys_clock_max_frequency(min_ratio);
+    if (frequency <= max) return true;
+    printf("Invalid frequency. Highest is %lu Hz (sys_clk/%lu)%s\n", max, min_ratio,
+           sys_clock_get_retune() ? "" : "; 'retune on' lets the system clock rise");
+    return false;
+}
+
+static void print_millihz(uint64_t millihz) {
+    printf("%llu.%03llu Hz", millihz / 1000, millihz % 1000);
+}
+
+static void print_achieved(uint32_t frequency, uint32_t min_ratio) {
+    int32_t ppb = uart_error_ppb;
+    uint32_t abs_ppb = ppb < 0 ? (uint32_t)-ppb : (uint32_t)ppb;
+    printf("Achieved ");
+    print_millihz(uart_achieved_millihz);
+    printf(" (error %c%lu.%03lu ppm)\n", ppb < 0 ? '-' : '+', abs_ppb / 1000, abs_ppb % 1000);
+    
+    // A fractional divider is exact on average only, so offer the
+    // whole-cycle frequencies either side where they are far apart
+    uint32_t sys_hz = clock_get_hz(clk_sys);
+    uint32_t ratio = sys_hz / frequency;
+    if (ratio > PWM_SOLVER_PERIOD_MAX || sys_clock_exact(sys_hz, frequency, min_ratio)) return;
+    printf("Nearest exact at %lu kHz: ", sys_hz / 1000);
+    print_millihz((uint64_t)sys_hz * 1000ull / ratio);
+    printf(" (sys_clk/%lu) and ", ratio);
+    print_millihz((uint64_t)sys_hz * 1000ull / (ratio + 1));
+    printf(" (sys_clk/%lu)\n", ratio + 1);
+}
+
+static void print_duty(void) {
+    duty_cycle_achieved_t achieved;
+    get_achieved_duty(&achieved);
+    printf("Duty cycle %lu.%02lu%%, HIGH %lu ns (%lu steps per period)\n",
+           achieved.ratio / 100, achieved.ratio % 100, achieved.width_ns, achieved.steps);
+}
+
+static void command_freq(const uint64_t *values) {
+    uint32_t freq = (uint32_t)values[0];
+    uint32_t min_ratio = get_uart_freq_min_ratio();
+    if (!reachable(freq, min_ratio)) return;
+    if (!accepted(control_arbiter_freq(command_source, freq))) return;
+    printf("Frequency set to %lu Hz and running\n", freq);
+    print_achieved(freq, min_ratio);
+    print_duty();
+}
+
+static void command_burst(const uint64_t *values) {
+    uint64_t cycles = values[0];
+    uint32_t freq = (uint32_t)values[1];
+    if (!reachable(freq, BURST_MIN_RATIO)) return;
+    if (!accepted(control_arbiter_burst(command_source, cycles, freq))) return;
+    printf("Burst of %llu cycles at %lu Hz started\n", cycles, freq);
+    print_achieved(freq, BURST_MIN_RATIO);
+    print_duty();
+}
+
+// Say why no one engine covers a sweep
+static void print_sweep_engines(void) {
+    uint32_t sys_hz = clock_get_hz(clk_sys);
+    if (pio_clock_get_wait()) {
+        printf("With WAIT on a sweep runs on the PIO engine, from 1 Hz to %lu Hz\n", sys_hz / PIO_CLOCK_PERIOD_MIN);
+        return;
+    }
+    printf("A sweep stays on one engine: PWM from %lu Hz to %lu Hz, or PIO from 1 Hz to %lu Hz\n",
+           (uint32_t)((16ull * sys_hz + (uint64_t)PWM_SOLVER_DIV16_MAX * PWM_SOLVER_PERIOD_MAX - 1) /
+                      ((uint64_t)PWM_SOLVER_DIV16_MAX * PWM_SOLVER_PERIOD_MAX)),
+           sys_hz / PWM_MIN_RATIO, sys_hz / PIO_CLOCK_PERIOD_MIN);
+}
+
+static void command_sweep(const uint64_t *values) {
+    sweep_plan_t plan = {
+        .shape = values[3] ? SWEEP_LOG : SWEEP_LINEAR,
+        .from = (uint32_t)values[0],
+        .to = (uint32_t)values[1],
+    };
+    uint32_t duration_ms = (uint32_t)values[2];
+    if (plan.from == plan.to) {
+        printf("Sweep limits must differ; use freq for a fixed frequency\n");
+        return;
+    }
+    if (sweep_engine_for(clock_get_hz(clk_sys), plan.from, plan.to) == SWEEP_ENGINE_NONE) {
+        print_sweep_engines();
+        return;
+    }
+    plan.steps = sweep_plan_steps(duration_ms, sweep_dwell_ms, SWEEP_MAX_STEPS);
+    uint32_t dwell_us = sweep_plan_dwell_us(duration_ms, plan.steps);
+    if (!accepted(control_arbiter_sweep(command_source, &plan, dwell_us))) return;
+    printf("Sweeping %lu Hz to %lu Hz (%s) over %lu ms: %lu steps of %lu.%03lu ms\n", plan.from, plan.to,
+           plan.shape == SWEEP_LOG ? "log" : "linear", duration_ms, plan.steps, dwell_us / 1000, dwell_us % 1000);
+}
+
+static void command_dwell(const uint64_t *values) {
+    sweep_dwell_ms = (uint32_t)values[0];
+    printf("Sweep dwell set to %lu ms per step\n", sweep_dwell_ms);
+}
+
+static void command_hfreq(const uint64_t *values) {
+    uint32_t freq = (uint32_t)values[0];
+    if (!reachable(freq, PWM_MIN_RATIO)) return;
+    if (!accepted(control_arbiter_high_freq(command_source, freq))) return;
+    bool running = get_current_mode() == MODE_HIGH_FREQ;
+    printf("High Frequency mode set to %lu Hz%s\n", freq, running ? " and running" : "");
+    if (running) print_duty();
+}
+
+// Report the duty cycle a setting gave, if a clock is running to show it
+static void print_running_duty(void) {
+    clock_mode_t mode = get_current_mode();
+    if (mode == MODE_LOW_FREQ || mode == MODE_HIGH_FREQ ||
+        (mode == MODE_UART_CONTROL && uart_clock_running)) {
+        print_duty();
+    }
+}
+
+static void command_duty(const uint64_t *values) {
+    uint32_t duty = (uint32_t)values[0];
+    if (!accepted(control_arbiter_duty(command_source, DUTY_CYCLE_RATIO, duty))) return;
+    printf("Duty cycle set to %lu.%02lu%%\n", duty / 100, duty % 100);
+    print_running_duty();
+}
+
+static void command_width(const uint64_t *values) {
+    uint32_t ns = (uint32_t)values[0];
+    if (!accepted(control_arbiter_duty(command_source, DUTY_CYCLE_WIDTH, ns))) return;
+    printf("Pulse width set to %lu ns\n", ns);
+    print_running_duty();
+}
+
+static void show_sys_clock(void) {
+    uint32_t sys_hz = clock_get_hz(clk_sys);
+    printf("System clock: %lu.%03lu MHz (retune %s)\n", sys_hz / 1000000, sys_hz / 1000 % 1000,
+           sys_clock_get_retune() ? "on" : "off");
+    
+    // Exact frequencies are sys_clk/N; the steps are coarsest at the top
+    printf("Exact frequencies are sys_clk/N, from N = %u (PWM) or %u (burst):\n", PWM_MIN_RATIO, BURST_MIN_RATIO);
+    for (uint32_t n = PWM_MIN_RATIO; n <= BURST_MIN_RATIO; n++) {
+        printf("  /%-2lu ", n);
+        print_millihz((uint64_t)sys_hz * 1000ull / n);
+        printf("\n");
+    }
+}
+
+static void command_sysclk(const uint64_t *values) {
+    uint32_t khz = (uint32_t)values[0];
+    if (khz == 0) {
+        show_sys_clock();
+        return;
+    }
+    if (!sys_clock_valid(khz)) {
+        printf("The system PLL cannot make %lu kHz from the crystal\n", khz);
+        return;
+    }
+    if (!accepted(control_arbiter_sys_clock(command_source, khz))) return;
+    printf("System clock set to %lu kHz, retune off\n", khz);
+}
+
+static void command_retune(const uint64_t *values) {
+    sys_clock_set_retune(values[0] != 0);
+    printf("System clock retune %s\n", values[0] ? "on" : "off");
+}
+
+static void command_wait(const uint64_t *values) {
+    bool on = values[0] != 0;
+    if (!accepted(control_arbiter_wait(command_source, on))) return;
+    if (on) {
+        printf("WAIT on: the clock holds HIGH while GPIO %d is LOW (PIO engine, up to %lu Hz)\n",
+               WAIT_INPUT, clock_get_hz(clk_sys) / WAIT_MIN_RATIO);
+    } else {
+        printf("WAIT off\n");
+    }
+    printf("Stretched cycles: %lu\n", pio_clock_get_stretched_cycles());
+}
+
+static void command_count(const uint64_t *values) {
+    freq_counter_input_t input = (freq_counter_input_t)values[0];
+    uart_control_count(input);
+    if (input == FREQ_COUNTER_PIN) {
+        printf("Counting GPIO %d against the system clock; readings follow as they complete\n", FREQ_COUNTER_INPUT);
+    } else if (input == FREQ_COUNTER_LOOPBACK) {
+        printf("Counting the clock output (GPIO %d) in loopback, up to %lu Hz\n", CLOCK_OUTPUT,
+               clock_get_hz(clk_sys) / FREQ_COUNTER_RECIPROCAL_DIVISOR);
+    } else {
+        printf("Frequency counter off\n");
+    }
+}
+
+static void command_ref(const uint64_t *values) {
+    uint32_t ref_hz = (uint32_t)values[0];
+    uint32_t max_hz = clock_get_hz(clk_sys) / PIO_COUNTER_PERIOD_MIN;
+    if (ref_hz > max_hz) {
+        printf("The reference counter follows up to %lu Hz at this system clock\n", max_hz);
+        return;
+    }
+    uart_control_reference(ref_hz);
+    if (ref_hz == 0) {
+        printf("Reference discipline off; the clock runs from the crystal\n");
+    } else {
+        printf("Disciplining to %lu Hz on GPIO %d; lock changes follow as they happen\n", ref_hz, REFERENCE_INPUT);
+    }
+}
+
+static void command_deadtime(const uint64_t *values) {
+    uint32_t ticks = (uint32_t)values[0];
+    if (!accepted(control_arbiter_dead_time(command_source, ticks))) return;
+    printf("Phase dead time set to %lu ticks (%llu ns)\n", ticks,
+           (uint64_t)ticks * 1000000000ull / clock_get_hz(clk_sys));
+}
+
+static void command_reset(const uint64_t *values) {
+    uint32_t cycles = (uint32_t)values[0];
+    bool released;
+    if (!accepted(control_arbiter_reset(command_source, cycles, &released))) return;
+    if (released) {
+        printf("Reset pulse released via %s\n", control_arbiter_source_name(command_source));
+    } else {
+        printf("Reset pulse initiated via %s (%lu cycles)\n", control_arbiter_source_name(command_source), cycles);
+    }
+}
+
+static void command_power(const uint64_t *values) {
+    bool on = values[0] != 0;
+    bool switched_mode;
+    if (!accepted(control_arbiter_power(command_source, on, &switched_mode))) return;
+    printf("Power turned %s\n", on ? "ON" : "OFF");
+    if (switched_mode) {
+        printf("Automatically switched to Mode 1 (Single Step)\n");
+    }
+}
+
+static void command_mode(const uint64_t *values) {
+    accepted(control_arbiter_mode(command_source, (clock_mode_t)values[0]));
+}
+
+static void command_menu(const uint64_t *values) {
+    (void)values;
+    show_uart_menu();
+}
+
+static void command_status(const uint64_t *values) {
+    (void)values;
+    print_status();
+}
+
+static void command_trace(const uint64_t *values) {
+    (void)values;
+    // Save everything between the markers as a .vcd file
+    printf("--- VCD begin ---\n");
+    output_trace_dump();
+    printf("--- VCD end ---\n");
+}
+
+static const char *const power_states[] = { "off", "on", NULL };
+static const char *const retune_states[] = { "off", "on", NULL };
+static const char *const wait_states[] = { "off", "on", NULL };
+static const char *const count_inputs[] = { "off", "on", "loop", NULL };  // In freq_counter_input_t order
+static const char *const sweep_shapes[] = { "lin", "log", NULL };   // In sweep_shape_t order
+
+// In clock_mode_t order
+static const char *const mode_names[] = { "step", "low", "high", "uart", NULL };
+
+// Menu order; names are looked up through the hash index, not this order
+static const command_t uart_commands[] = {
+    { "stop",   NULL,     "Stop the clock",
+      { { .type = COMMAND_ARG_NONE } }, command_stop },
+    { "toggle", NULL,     "Toggle clock state once",
+      { { .type = COMMAND_ARG_NONE } }, command_toggle },
+    { "freq",   "<Hz>",   "Set frequency (1Hz to sys_clk/2, e.g. 250k or 1.5k) and run",
+      { { .type = COMMAND_ARG_NUMBER, .min = MIN_UART_FREQ, .max = MAX_UART_FREQ,
+          .what = "frequency", .unit = "Hz" } }, command_freq },
+    { "burst",  "<N> <Hz>", "Run exactly N clock cycles (up to 4G) at up to sys_clk/8",
+      { { .type = COMMAND_ARG_NUMBER, .min = 1, .max = MAX_BURST_CYCLES, .what = "cycle count" },
+        { .type = COMMAND_ARG_NUMBER, .min = MIN_UART_FREQ, .max = MAX_UART_FREQ,
+          .what = "frequency", .unit = "Hz" } }, command_burst },
+    { "sweep",  "<Hz> <Hz> <ms> [lin|log]", "Ramp the clock between two frequencies",
+      { { .type = COMMAND_ARG_NUMBER, .min = MIN_UART_FREQ, .max = MAX_UART_FREQ,
+          .what = "start frequency", .unit = "Hz" },
+        { .type = COMMAND_ARG_NUMBER, .min = MIN_UART_FREQ, .max = MAX_UART_FREQ,
+          .what = "end frequency", .unit = "Hz" },
+        { .type = COMMAND_ARG_NUMBER, .min = SWEEP_DURATION_MIN_MS, .max = SWEEP_DURATION_MAX_MS,
+          .what = "duration", .unit = "ms" },
+        { .type = COMMAND_ARG_KEYWORD, .optional = true, .keywords = sweep_shapes,
+          .what = "sweep shape" } }, command_sweep },
+    { "dwell",  "<ms>",   "Set the time each sweep step runs",
+      { { .type = COMMAND_ARG_NUMBER, .min = 1, .max = SWEEP_DWELL_MAX_MS,
+          .what = "dwell", .unit = "ms" } }, command_dwell },
+    { "deadtime", "<ticks>", "Set phi1/phi2 dead time in system clock ticks (3 to 10000)",
+      { { .type = COMMAND_ARG_NUMBER, .min = PHI_DEAD_TIME_MIN, .max = PHI_DEAD_TIME_MAX,
+          .what = "dead time", .unit = "ticks" } }, command_deadtime },
+    { "duty",   "<%>",    "Set duty cycle in percent (0.01 to 99.99, e.g. 25 or 12.5)",
+      { { .type = COMMAND_ARG_NUMBER, .decimals = 2, .min = DUTY_CYCLE_MIN, .max = DUTY_CYCLE_MAX,
+          .what = "duty cycle", .unit = "%" } }, command_duty },
+    { "width",  "<ns>",   "Set a fixed HIGH pulse width instead (e.g. 100 or 1.5k)",
+      { { .type = COMMAND_ARG_NUMBER, .min = PULSE_WIDTH_MIN_NS, .max = PULSE_WIDTH_MAX_NS,
+          .what = "pulse width", .unit = "ns" } }, command_width },
+    { "hfreq",  "<Hz>",   "Set High Frequency mode output (1kHz to sys_clk/2)",
+      { { .type = COMMAND_ARG_NUMBER, .min = MIN_HIGH_FREQ, .max = MAX_UART_FREQ,
+          .what = "frequency", .unit = "Hz" } }, command_hfreq },
+    { "sysclk", "[kHz]",  "Show the system clock, or set it (100000 to 133000)",
+      { { .type = COMMAND_ARG_NUMBER, .optional = true, .min = SYS_CLOCK_MIN_KHZ, .max = SYS_CLOCK_MAX_KHZ,
+          .what = "system clock", .unit = "kHz" } }, command_sysclk },
+    { "retune", "on|off", "Let freq, burst and hfreq pick an exact system clock",
+      { { .type = COMMAND_ARG_KEYWORD, .keywords = retune_states, .what = "retune state" } }, command_retune },
+    { "wait",   "on|off", "Hold the clock HIGH while the WAIT input is LOW",
+      { { .type = COMMAND_ARG_KEYWORD, .keywords = wait_states, .what = "wait state" } }, command_wait },
+    { "count",  "on|off|loop", "Measure the counter input, or the clock itself, against sys_clk",
+      { { .type = COMMAND_ARG_KEYWORD, .keywords = count_inputs, .what = "counter input" } }, command_count },
+    { "ref",    "<Hz>",   "Trim the clock to a reference on GPIO 28 (1 for 1PPS, up to 10M; 0 off)",
+      { { .type = COMMAND_ARG_NUMBER, .min = 0, .max = DISCIPLINE_REF_MAX_HZ,
+          .what = "reference frequency", .unit = "Hz" } }, command_ref },
+    { "reset",  "[N]",    "Trigger reset pulse of N clock cycles, or release one",
+      { { .type = COMMAND_ARG_NUMBER, .optional = true, .min = 1, .max = MAX_RESET_CYCLES,
+          .default_value = RESET_CYCLES, .what = "cycle count" } }, command_reset },
+    { "power",  "on|off", "Turn power ON or OFF",
+      { { .type = COMMAND_ARG_KEYWORD, .keywords = power_states, .what = "power state" } }, command_power },
+    { "mode",   "<name>", "Select mode: step, low, high or uart",
+      { { .type = COMMAND_ARG_KEYWORD, .keywords = mode_names, .what = "mode" } }, command_mode },
+    { "menu",   NULL,     "Show this menu again",
+      { { .type = COMMAND_ARG_NONE } }, command_menu },
+    { "status", NULL,     "Show current status",
+      { { .type = COMMAND_ARG_NONE } }, command_status },
+    { "trace",  NULL,     "Dump output trace as VCD",
+      { { .type = COMMAND_ARG_NONE } }, command_trace },
+};
+
+_Static_assert(sizeof(uart_commands) / sizeof(uart_commands[0]) < COMMAND_TABLE_SLOTS / 2,
+               "Too many commands for the hash index; raise COMMAND_TABLE_SLOTS");
+
+const command_t *uart_control_commands(uint32_t *count) {
+    *count = sizeof(uart_commands) / sizeof(uart_commands[0]);
+    return uart_commands;
+}
 
 void uart_control_init(void) {
     uart_clock_running = false;
     uart_set_frequency = 0;
-    uart_cmd_index = 0;
-    uart_menu_timeout = 0;
+    command_table_init(&uart_command_table, uart_commands, sizeof(uart_commands) / sizeof(uart_commands[0]));
+    command_source = CONTROL_SOURCE_UART0;
     uart_pwm_active = false;
+    uart_achieved_millihz = 0;
+    uart_error_ppb = 0;
+    sweep_dwell_ms = SWEEP_DWELL_DEFAULT_MS;
     uart_timer_active = false;
     uart_alarm_id = 0;
 }
 
 void handle_uart_control(void) {
-    // Check for button press to exit UART mode
-    if (any_button_pressed()) {
+    // A new button press returns to the previous mode (a button still held
+    // from the 3-second entry hold does not count)
+    if (any_button_press_pending()) {
         clock_mode_t prev_mode = get_previous_mode();
         printf("Button pressed - returning to %s mode\n", 
                prev_mode == MODE_SINGLE_STEP ? "Single Step" :
                prev_mode == MODE_LOW_FREQ ? "Low Frequency" : "High Frequency");
-        set_mode(prev_mode);
-        return;
-    }
-    
-    // Check for timeout
-    if (to_ms_since_boot(get_absolute_time()) > uart_menu_timeout) {
-        clock_mode_t prev_mode = get_previous_mode();
-        printf("UART menu timeout - returning to %s mode\n",
-               prev_mode == MODE_SINGLE_STEP ? "Single Step" :
-               prev_mode == MODE_LOW_FREQ ? "Low Frequency" : "High Frequency");
-        set_mode(prev_mode);
-        return;
-    }
-    
-    // Check for UART input
-    while (uart_is_readable(uart0)) {
-        char c = uart_getc(uart0);
-        
-        // Reset timeout on any input
-        uart_menu_timeout = to_ms_since_boot(get_absolute_time()) + UART_MENU_TIMEOUT_MS;
-        
-        if (c == '\r' || c == '\n') {
-            if (uart_cmd_index > 0) {
-                uart_cmd_buffer[uart_cmd_index] = '\0';
-                printf("\n"); // New line after command
-                process_uart_command(uart_cmd_buffer);
-                uart_cmd_index = 0;
-            } else {
-                printf("Cmd> "); // Show prompt for empty commands
-            }
-        } else if (c == '\b' || c == 127) { // Backspace or DEL
-            if (uart_cmd_index > 0) {
-                uart_cmd_index--;
-                printf("\b \b"); // Erase character from terminal
-            }
-        } else if (uart_cmd_index < UART_CMD_BUFFER_SIZE - 1 && c >= 32 && c < 127) {
-            // Printable ASCII characters only
-            uart_cmd_buffer[uart_cmd_index++] = c;
-            printf("%c", c); // Echo character
-        }
-        // Ignore other control characters
+        control_arbiter_mode(CONTROL_SOURCE_PANEL, prev_mode);
     }
 }
 
 void show_uart_menu(void) {
     printf("\n=== UART Control Mode ===\n");
     printf("Commands:\n");
-    printf("  stop      - Stop the clock\n");
-    printf("  toggle    - Toggle clock state once\n");
-    printf("  freq <Hz> - Set frequency (1Hz to 1MHz) and run\n");
-    printf("  reset     - Trigger reset pulse (6 clock cycles)\n");
-    printf("  power on  - Turn power ON\n");
-    printf("  power off - Turn power OFF\n");
-    printf("  menu      - Show this menu again\n");
-    printf("  status    - Show current status\n");
-    printf("\nPress any button to return to previous mode\n");
-    printf("Mode will timeout after 30 seconds of inactivity\n");
+    for (uint32_t i = 0; i < uart_command_table.count; i++) {
+        const command_t *c = &uart_command_table.commands[i];
+        char syntax[32];
+        snprintf(syntax, sizeof(syntax), "%s%s%s", c->name, c->usage ? " " : "", c->usage ? c->usage : "");
+        printf("  %-16s - %s", syntax, c->help);
+        for (uint32_t a = 0; a < COMMAND_MAX_ARGS; a++) {
+            if (c->args[a].optional && c->args[a].default_value) printf(" (default %llu)", c->args[a].default_value);
+        }
+        printf("\n");
+    }
+    printf("\nCommands are taken on UART0, UART1 and USB in every mode\n");
+    printf("Press any button to return to previous mode\n");
     printf("\nCmd> ");
 }
 
-void process_uart_command(const char* cmd) {
-    // Trim leading/trailing whitespace and convert to lowercase for comparison
-    while (*cmd == ' ') cmd++; // Skip leading spaces
+// UART Control Mode actions, requested through the control arbiter
+
+void uart_control_freq(uint32_t frequency) {
+    uart_set_frequency = frequency;
+    clock_core_post(CORE_CMD_UART_FREQ, frequency);
+    clock_core_sync(); // Achieved frequency is reported by core1
+    uart_clock_running = true;
+}
+
+void uart_control_stop(void) {
+    clock_core_post(CORE_CMD_UART_STOP, 0);
+    clock_core_sync();
+    uart_clock_running = false;
+}
+
+void uart_control_burst(uint64_t cycles, uint32_t frequency) {
+    // The frequency goes first; the count starts the burst
+    clock_core_post(CORE_CMD_BURST_FREQ, frequency);
+    clock_core_post(CORE_CMD_BURST, (uint32_t)(cycles - 1));
+    clock_core_sync(); // Achieved frequency is reported by core1
+    uart_clock_running = false; // A burst is not a running clock
+}
+
+void uart_control_sweep(const sweep_plan_t *plan, uint32_t dwell_us) {
+    // The plan goes first; the step count starts the sweep
+    clock_core_post(CORE_CMD_SWEEP_FROM, plan->from);
+    clock_core_post(CORE_CMD_SWEEP_TO, plan->to);
+    clock_core_post(CORE_CMD_SWEEP_SHAPE, plan->shape);
+    clock_core_post(CORE_CMD_SWEEP_DWELL, dwell_us);
+    clock_core_post(CORE_CMD_SWEEP, plan->steps);
+    clock_core_sync();
+    uart_clock_running = false; // A sweep is not a running clock
+}
+
+void uart_control_count(freq_counter_input_t input) {
+    // Measuring changes no output, so it needs no arbitration
+    clock_core_post(CORE_CMD_COUNT, input);
+    clock_core_sync();
+}
+
+void uart_control_reference(uint32_t ref_hz) {
+    // A trim moves the output by parts per million, as a retune does, so
+    // it needs no arbitration
+    clock_core_post(CORE_CMD_REFERENCE, ref_hz);
+    clock_core_sync();
+}
+
+bool uart_control_toggle(void) {
+    clock_core_post(CORE_CMD_UART_TOGGLE, 0); // Stops any running engine first
+    clock_core_sync();
+    uart_clock_running = false; // Stop any running frequency
+    return get_clock_state();
+}
+
+// A number argument as it would be typed, with its unit
+static void print_arg_value(const command_arg_t *arg, uint64_t value) {
+    uint64_t scale = 1;
+    for (uint32_t i = 0; i < arg->decimals; i++) scale *= 10;
+    printf("%llu", value / scale);
+    if (arg->decimals) printf(".%0*llu", (int)arg->decimals, value % scale);
+    if (arg->unit) printf(" %s", arg->unit);
+}
+
+void process_uart_command(control_source_t source, const char* cmd, uint32_t length) {
+    // Trim leading/trailing spaces
+    while (length > 0 && *cmd == ' ') {
+        cmd++;
+        length--;
+    }
+    while (length > 0 && cmd[length - 1] == ' ') length--;
     
-    if (strcmp(cmd, "stop") == 0) {
-        stop_uart_frequency();
-        uart_clock_running = false;
-        set_clock_output(false);
-        printf("Clock stopped\n");
-        
-    } else if (strcmp(cmd, "toggle") == 0) {
-        stop_uart_frequency(); // Stop any running PWM or timer
-        toggle_clock_output();
-        printf("Clock toggled to %s\n", get_clock_state() ? "HIGH" : "LOW");
-        uart_clock_running = false; // Stop any running frequency
-        
-    } else if (strncmp(cmd, "freq ", 5) == 0) {
-        const char* freq_str = cmd + 5;
-        // Skip any spaces after "freq"
-        while (*freq_str == ' ') freq_str++;
-        
-        if (strlen(freq_str) == 0) {
-            printf("Missing frequency value. Usage: freq <Hz>\n");
-            return;
-        }
-        
-        char* endptr;
-        long freq_long = strtol(freq_str, &endptr, 10);
-        
-        // Check if conversion was successful and value is within range
-        if (endptr == freq_str || *endptr != '\0') {
-            printf("Invalid frequency format. Use numbers only.\n");
-        } else if (freq_long < MIN_UART_FREQ || freq_long > MAX_UART_FREQ) {
-            printf("Invalid frequency. Range: %d Hz to %d Hz\n", MIN_UART_FREQ, MAX_UART_FREQ);
-        } else {
-            uint32_t freq = (uint32_t)freq_long;
-            uart_set_frequency = freq;
-            start_uart_frequency(freq);
-            uart_clock_running = true;
-            printf("Frequency set to %lu Hz and running\n", freq);
-        }
-        
-    } else if (strcmp(cmd, "menu") == 0) {
-        show_uart_menu();
-        
-    } else if (strcmp(cmd, "status") == 0) {
-        print_status();
-        
-    } else if (strcmp(cmd, "reset") == 0) {
-        if (!get_reset_active()) {
-            start_reset_pulse();
-            printf("Reset pulse initiated via UART\n");
-        } else {
-            printf("Reset pulse already active\n");
-        }
-        
-    } else if (strcmp(cmd, "power on") == 0) {
-        bool old_power_state = get_power_state();
-        set_power_state(true);
-        printf("Power turned ON\n");
-        
-        // If power just turned ON (OFF->ON transition), switch to Mode 1
-        if (!old_power_state && get_power_state()) {
-            set_mode(MODE_SINGLE_STEP);
-            printf("Automatically switched to Mode 1 (Single Step)\n");
+    const command_t *command = NULL;
+    uint64_t values[COMMAND_MAX_ARGS];
+    uint32_t bad = 0;
+    command_source = source;
+    
+    switch (length == 0 ? COMMAND_OK : command_table_parse(&uart_command_table, cmd, length, &command, values, &bad)) {
+        case COMMAND_OK:
+            if (command) command->handler(values);  // Empty command does nothing
+            break;
+        case COMMAND_MISSING_ARG:
+            printf("Missing %s value. Usage: %s %s\n", command->args[bad].what, command->name, command->usage);
+            break;
+        case COMMAND_BAD_ARG:
+            if (command->args[bad].type == COMMAND_ARG_NUMBER) {
+                printf("Invalid %s format. Use a number, optionally with a k or M suffix.\n", command->args[bad].what);
+            } else {
+                printf("Invalid %s. Usage: %s %s\n", command->args[bad].what, command->name, command->usage);
+            }
+            break;
+        case COMMAND_OUT_OF_RANGE: {
+            const command_arg_t *arg = &command->args[bad];
+            printf("Invalid %s. Range: ", arg->what);
+            print_arg_value(arg, arg->min);
+            printf(" to ");
+            print_arg_value(arg, arg->max);
+            printf("\n");
+            break;
         }
-        
-    } else if (strcmp(cmd, "power off") == 0) {
-        set_power_state(false);
-        printf("Power turned OFF\n");
-        
-    } else if (strlen(cmd) == 0) {
-        // Empty command, do nothing
-        
-    } else {
-        printf("Unknown command: %s\n", cmd);
-        printf("Type 'menu' for help\n");
+        case COMMAND_UNKNOWN:
+            printf("Unknown command: %.*s\n", (int)length, cmd);
+            printf("Type 'menu' for help\n");
+            break;
     }
     
     printf("Cmd> ");
 }
 
+static void stop_uart_pio(void) {
+    if (pio_clock_is_running()) {
+        pio_clock_stop();
+    }
+}
+
 void start_uart_frequency(uint32_t frequency) {
-    stop_uart_frequency(); // Stop any existing timer or PWM
+    if (frequency == 0 || frequency > MAX_UART_FREQ) {
+        stop_uart_frequency();
+        return;
+    }
+    if (pio_clock_burst_active() || sweep_get_state() != SWEEP_IDLE) {
+        stop_uart_frequency(); // Reports a burst or sweep as aborted
+    }
     
-    if (frequency > 0 && frequency <= MAX_UART_FREQ) {
+    // A new system clock needs the engines stopped; they start again on it
+    uint32_t khz;
+    if (sys_clock_retune_for(frequency, get_uart_freq_min_ratio(), &khz)) {
+        stop_uart_frequency();
+        sys_clock_set_khz(khz);
+    }
+    
+    // A running engine is retuned in place at its next cycle boundary. Only
+    // the PIO engine can hold the clock for WAIT.
+    if (pio_clock_get_wait()) {
+        stop_uart_pwm();
+    } else {
         start_uart_pwm(frequency);
     }
+    
+    // Frequencies below the PWM divider range, and any with WAIT on, run on
+    // the PIO engine
+    if (!uart_pwm_active) {
+        uint32_t sys_hz = sys_clock_get_hz();
+        uint32_t period = pio_clock_period(sys_hz, frequency);
+        duty_cycle_achieved_t achieved;
+        uint32_t high = clock_duty_split(period, PIO_CLOCK_HIGH_OVERHEAD, PIO_CLOCK_LOW_OVERHEAD, sys_hz, 1,
+                                         &achieved);
+        pio_clock_set_period(period, high);
+        set_achieved_duty(&achieved);
+        uart_achieved_millihz = pio_clock_get_achieved_millihz();
+        uart_error_ppb = pwm_solver_error_ppb(sys_hz, period, frequency);
+    }
+    uart_engine_frequency = frequency;
+}
+
+void retune_uart_frequency(void) {
+    if (uart_engine_frequency != 0) {
+        start_uart_frequency(uart_engine_frequency);
+    }
+}
+
+void start_uart_burst(uint32_t frequency, uint32_t last_cycle) {
+    stop_uart_frequency();
+    set_clock_output(false);
+    
+    uint32_t khz;
+    if (sys_clock_retune_for(frequency, BURST_MIN_RATIO, &khz)) {
+        sys_clock_set_khz(khz);
+    }
+    
+    // Every cycle is counted by the PIO state machine, at any frequency
+    uint32_t sys_hz = sys_clock_get_hz();
+    uint32_t period = pio_clock_burst_period(sys_hz, frequency);
+    duty_cycle_achieved_t achieved;
+    uint32_t high = clock_duty_split(period, PIO_BURST_HALF_OVERHEAD, PIO_BURST_HALF_OVERHEAD, sys_hz, 1,
+                                     &achieved);
+    pio_clock_burst(period, high, last_cycle);
+    set_achieved_duty(&achieved);
+    uart_burst_last_cycle = last_cycle;
+    uart_achieved_millihz = pio_clock_burst_millihz(sys_hz, period);
+    uart_error_ppb = pwm_solver_error_ppb(sys_hz, period, frequency);
+}
+
+void start_uart_sweep(const sweep_plan_t *plan, uint32_t dwell_us) {
+    stop_uart_frequency();
+    set_clock_output(false);
+    
+    // The system clock stays as it is: the steps span a range, so there is
+    // no one clock that divides them all exactly
+    sweep_start(plan, dwell_us);
+}
+
+void update_uart_burst(void) {
+    if (pio_clock_take_burst_complete()) {
+        // The state machine holds the clock LOW; hand the pin back
+        stop_uart_pio();
+        clock_core_telemetry(CORE_TLM_BURST_COMPLETE, 0, uart_burst_last_cycle);
+    }
 }
 
 void stop_uart_frequency(void) {
+    // A burst that just finished is reported as complete, not aborted
+    update_uart_burst();
+    if (pio_clock_burst_active()) {
+        clock_core_telemetry(CORE_TLM_BURST_ABORTED, 0, uart_burst_last_cycle);
+    }
+    
+    // A sweep stops its own engine, reporting where it got to
+    sweep_stop();
+    uart_engine_frequency = 0;
+    
     // Stop hardware timer if active
     if (uart_timer_active && uart_alarm_id > 0) {
         cancel_alarm(uart_alarm_id);
         uart_timer_active = false;
         uart_alarm_id = 0;
     }
-    // Stop PWM if active
+    // Stop PWM or PIO engine if active
     stop_uart_pwm();
+    stop_uart_pio();
 }
 
 void start_uart_pwm(uint32_t frequency) {
-    stop_uart_pwm(); // Stop any existing PWM
-    
-    if (frequency > 0 && frequency <= MAX_UART_FREQ) {
-        // Set GPIO function to PWM
-        gpio_set_function(CLOCK_OUTPUT, GPIO_FUNC_PWM);
-        
-        // Get PWM slice for this GPIO
-        uint slice_num = pwm_gpio_to_slice_num(CLOCK_OUTPUT);
-        
-        // Calculate PWM parameters for the desired frequency
-        // System clock is typically 125MHz
-        // We want: PWM_freq = sys_clock / (divider * (wrap + 1))
-        // For 50% duty cycle, we set level = wrap / 2
-        
-        float sys_clock = 125000000.0f; // 125MHz system clock
-        float target_freq = (float)frequency;
-        
-        // Start with a reasonable wrap value to get good resolution
-        uint16_t wrap = 1000; // This gives us good resolution for duty cycle
-        float divider = sys_clock / (target_freq * (wrap + 1));
-        
-        // If divider is too high, reduce wrap and recalculate
-        if (divider > 255.0f) {
-            wrap = (uint16_t)(sys_clock / (target_freq * 255.0f)) - 1;
-            if (wrap < 1) wrap = 1;
-            divider = sys_clock / (target_freq * (wrap + 1));
-        }
-        
-        // If divider is too low (less than 1), increase wrap and recalculate
-        if (divider < 1.0f) {
-            wrap = (uint16_t)(sys_clock / target_freq) - 1;
-            if (wrap > 65535) wrap = 65535; // Max 16-bit value
-            divider = 1.0f; // Minimum divider
-        }
-        
-        // Ensure minimum wrap for 50% duty cycle
-        if (wrap < 2) wrap = 2;
-        
-        // Set PWM configuration
-        pwm_set_clkdiv(slice_num, divider);
-        pwm_set_wrap(slice_num, wrap);
+    // Grid frequencies come straight from flash, anything else is solved
+    pwm_solution_t solution;
+    if (frequency > 0 && frequency <= MAX_UART_FREQ &&
+        (clock_cache_lookup_pwm(frequency, &solution) ||
+         pwm_solve(sys_clock_get_hz(), frequency, &solution))) {
+        // PWM_freq = sys_clock / ((div_int + div_frac / 16) * (wrap + 1)),
+        // with the divider/wrap pair chosen by the solver for lowest error
+        // and, among equals, the largest wrap for the finest duty cycle.
+        // If PWM is already running the change is latched at a cycle boundary.
+        duty_cycle_achieved_t achieved;
+        clock_duty_pwm(&solution, &achieved);
         
-        // Set 50% duty cycle
-        uint16_t duty_level = wrap / 2;
-        uint channel = pwm_gpio_to_channel(CLOCK_OUTPUT);
-        pwm_set_chan_level(slice_num, channel, duty_level);
-        
-        // Enable PWM
-        pwm_set_enabled(slice_num, true);
+        // Switching over from the PIO engine stops it at a LOW level first;
+        // a fresh slice starts with its LOW half once the pin is free
+        stop_uart_pio();
+        pwm_clock_start(&solution);
+        set_achieved_duty(&achieved);
         uart_pwm_active = true;
+        uart_achieved_millihz = solution.achieved_millihz;
+        uart_error_ppb = solution.error_ppb;
         
         // Set clock activity LED on
         gpio_put(LED_CLOCK_ACTIVITY, 1);
+    } else {
+        stop_uart_pwm();
     }
 }
 
 void stop_uart_pwm(void) {
     if (uart_pwm_active) {
-        uint slice_num = pwm_gpio_to_slice_num(CLOCK_OUTPUT);
-        pwm_set_enabled(slice_num, false);
-        
-        // Reset GPIO function back to SIO (software controlled)
-        gpio_set_function(CLOCK_OUTPUT, GPIO_FUNC_SIO);
-        gpio_set_dir(CLOCK_OUTPUT, GPIO_OUT);
-        gpio_put(CLOCK_OUTPUT, 0);
+        // Stops at a LOW level and returns the GPIO to SIO
+        pwm_clock_stop();
         
         uart_pwm_active = false;
         gpio_put(LED_CLOCK_ACTIVITY, 0);
@@ -292,17 +717,32 @@ uint32_t get_uart_set_frequency(void) {
     return uart_set_frequency;
 }
 
+bool get_uart_burst_active(void) {
+    return pio_clock_burst_active();
+}
+
+bool get_uart_sweep_active(void) {
+    return sweep_get_state() == SWEEP_RUNNING;
+}
+
+uint32_t get_uart_freq_min_ratio(void) {
+    return pio_clock_get_wait() ? WAIT_MIN_RATIO : PWM_MIN_RATIO;
+}
+
 bool get_uart_pwm_active(void) {
-    return uart_pwm_active;
+    return uart_pwm_active || sweep_get_engine() == SWEEP_ENGINE_PWM;
 }
 
-void set_uart_menu_timeout(uint32_t timeout_ms) {
-    uart_menu_timeout = to_ms_since_boot(get_absolute_time()) + timeout_ms;
+uint64_t get_uart_achieved_millihz(void) {
+    return uart_achieved_millihz;
+}
+
+int32_t get_uart_error_ppb(void) {
+    return uart_error_ppb;
 }
 
 void reset_uart_control_state(void) {
     uart_clock_running = false;
     uart_set_frequency = 0;
-    uart_cmd_index = 0;
-    stop_uart_frequency();
+    // The engines themselves are stopped on core1 by the mode change
 }
\ No newline at end of file
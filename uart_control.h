@@ -13,6 +13,10 @@
 #include "hardware/uart.h"
 #include "hardware/timer.h"
 #include "hardware/pwm.h"
+#include "control_arbiter.h"
+#include "sweep_plan.h"
+#include "freq_counter.h"
+#include "command_table.h"
 
 /**
  * Initialize UART control module
@@ -21,7 +25,7 @@ void uart_control_init(void);
 
 /**
  * Handle UART control mode processing
- * Checks for button presses, timeouts, and processes UART commands
+ * A button press returns to the previous mode; there is no timeout.
  */
 void handle_uart_control(void);
 
@@ -31,24 +35,117 @@ void handle_uart_control(void);
 void show_uart_menu(void);
 
 /**
- * Process a UART command string
- * @param cmd Command string to process
+ * Process a text command (in any mode)
+ * @param source Port the command came from, passed to the control arbiter
+ * @param cmd Command text (need not be null-terminated)
+ * @param length Length of the command in characters
  */
-void process_uart_command(const char* cmd);
+void process_uart_command(control_source_t source, const char* cmd, uint32_t length);
 
 /**
- * Start UART-controlled frequency generation
- * @param frequency Frequency in Hz (10Hz to 1MHz)
+ * Get the text command table, in menu order
+ * @param count Receives the number of commands
+ * @return The commands process_uart_command() looks names up in
+ */
+const command_t *uart_control_commands(uint32_t *count);
+
+/**
+ * Run the clock at a frequency in UART Control Mode
+ * Call through control_arbiter_freq(), which selects the mode first.
+ * Returns once core1 has applied it; see get_uart_achieved_millihz().
+ * @param frequency Frequency in Hz (MIN_UART_FREQ to MAX_UART_FREQ)
+ */
+void uart_control_freq(uint32_t frequency);
+
+/**
+ * Stop the clock in UART Control Mode
+ */
+void uart_control_stop(void);
+
+/**
+ * Run a burst of exactly N clock cycles in UART Control Mode
+ * Call through control_arbiter_burst(), which selects the mode first.
+ * Returns once core1 has started it; completion is reported later by
+ * clock_core_service().
+ * @param cycles Number of cycles (1 to MAX_BURST_CYCLES)
+ * @param frequency Frequency in Hz (MIN_UART_FREQ to MAX_UART_FREQ)
+ */
+void uart_control_burst(uint64_t cycles, uint32_t frequency);
+
+/**
+ * Ramp the clock between two frequencies in UART Control Mode
+ * Call through control_arbiter_sweep(), which selects the mode first.
+ * Returns once core1 has started it; completion or an abort is reported
+ * later by clock_core_service().
+ * @param plan Sweep plan (limits on one engine, see sweep_engine_for())
+ * @param dwell_us Time each step runs for in microseconds
+ */
+void uart_control_sweep(const sweep_plan_t *plan, uint32_t dwell_us);
+
+/**
+ * Measure FREQ_COUNTER_INPUT or the clock output, or stop measuring, in any mode
+ * Returns once core1 has applied it; readings are printed as they complete.
+ * @param input FREQ_COUNTER_OFF, FREQ_COUNTER_PIN or FREQ_COUNTER_LOOPBACK
+ */
+void uart_control_count(freq_counter_input_t input);
+
+/**
+ * Discipline the clock to a reference on REFERENCE_INPUT, or stop, in any mode
+ * Returns once core1 has applied it; changes of lock are printed as they happen.
+ * @param ref_hz Reference frequency in Hz (up to DISCIPLINE_REF_MAX_HZ), 0 for off
+ */
+void uart_control_reference(uint32_t ref_hz);
+
+/**
+ * Toggle the clock once in UART Control Mode (stops a running clock)
+ * @return New clock level
+ */
+bool uart_control_toggle(void);
+
+/**
+ * Start UART-controlled frequency generation (core1)
+ * A running clock is retuned without stopping or glitching.
+ * @param frequency Frequency in Hz (1Hz to 1MHz)
  */
 void start_uart_frequency(uint32_t frequency);
 
 /**
- * Stop UART-controlled frequency generation
+ * Stop UART-controlled frequency generation (core1)
+ * A burst in progress is abandoned and reported as aborted.
  */
 void stop_uart_frequency(void);
 
+/**
+ * Retune a running UART-controlled clock for a new trim (core1)
+ * A burst or sweep keeps the trim it started with.
+ */
+void retune_uart_frequency(void);
+
+/**
+ * Start a burst, stopping any running clock first (core1)
+ * @param frequency Frequency in Hz (1Hz to 1MHz)
+ * @param last_cycle Number of cycles minus one
+ */
+void start_uart_burst(uint32_t frequency, uint32_t last_cycle);
+
+/**
+ * Start a sweep, stopping any running clock first (core1)
+ * @param plan Sweep plan
+ * @param dwell_us Time each step runs for in microseconds
+ */
+void start_uart_sweep(const sweep_plan_t *plan, uint32_t dwell_us);
+
+/**
+ * Report a finished burst and release the clock pin (core1)
+ * Call on every core1 loop pass; the completion interrupt wakes the core.
+ */
+void update_uart_burst(void);
+
 /**
  * Start UART PWM output
+ * Divider and wrap are solved for the lowest error against the trimmed
+ * system clock; frequencies below the PWM range leave PWM inactive.
+ * If PWM is already running it is retuned at the next cycle boundary.
  * @param frequency Frequency in Hz for PWM output
  */
 void start_uart_pwm(uint32_t frequency);
@@ -70,20 +167,45 @@ bool get_uart_clock_running(void);
  */
 uint32_t get_uart_set_frequency(void);
 
+/**
+ * Get burst state
+ * @return true while a burst is emitting cycles
+ */
+bool get_uart_burst_active(void);
+
+/**
+ * Get sweep state
+ * @return true while a sweep is stepping
+ */
+bool get_uart_sweep_active(void);
+
+/**
+ * Get the fewest system clock cycles per period "freq" can run at
+ * @return PWM_SOLVER_PERIOD_MIN, or PIO_CLOCK_PERIOD_MIN with WAIT on
+ */
+uint32_t get_uart_freq_min_ratio(void);
+
 /**
  * Get UART PWM active state
- * @return true if UART PWM is active
+ * @return true if UART PWM is active, for a running clock or a sweep
  */
 bool get_uart_pwm_active(void);
 
 /**
- * Set UART menu timeout
- * @param timeout_ms Timeout in milliseconds from now
+ * Get frequency actually produced for the last "freq" command
+ * @return Achieved frequency in millihertz
+ */
+uint64_t get_uart_achieved_millihz(void);
+
+/**
+ * Get error of the last "freq" command relative to the request
+ * @return Signed error in parts per billion
  */
-void set_uart_menu_timeout(uint32_t timeout_ms);
+int32_t get_uart_error_ppb(void);
 
 /**
  * Reset UART control state (for mode switching)
+ * Clears command state only; the mode change stops the engines on core1.
  */
 void reset_uart_control_state(void);
 
@@ -0,0 +1,70 @@
+/**
+ * UART Receive Module for Multimode Clock Source
+ */
+
+#include "uart_rx.h"
+#include "config.h"
+#include "hardware/irq.h"
+#include "hardware/sync.h"
+
+_Static_assert((UART_RX_BUFFER_SIZE & (UART_RX_BUFFER_SIZE - 1)) == 0,
+               "UART_RX_BUFFER_SIZE must be a power of two");
+
+typedef struct {
+    uart_inst_t *uart;
+    byte_ring_t ring;
+    uint8_t buffer[UART_RX_BUFFER_SIZE];
+} uart_rx_port_t;
+
+static uart_rx_port_t rx_ports[2];
+
+static void drain_fifo(uart_rx_port_t *port) {
+    // Move the FIFO in chunks; of a chunk that does not fit, only the bytes
+    // past the free space are counted as dropped
+    uint8_t chunk[32];
+    uint32_t length = 0;
+    while (uart_is_readable(port->uart)) {
+        chunk[length++] = (uint8_t)uart_getc(port->uart);
+        if (length == sizeof(chunk)) {
+            byte_ring_write_some(&port->ring, chunk, length);
+            length = 0;
+        }
+    }
+    if (length) byte_ring_write_some(&port->ring, chunk, length);
+}
+
+static void uart0_rx_irq(void) {
+    drain_fifo(&rx_ports[0]);
+    __sev();
+}
+
+static void uart1_rx_irq(void) {
+    drain_fifo(&rx_ports[1]);
+    __sev();
+}
+
+void uart_rx_init(void) {
+    uart_inst_t *const uarts[2] = { uart0, uart1 };
+    const uint irqs[2] = { UART0_IRQ, UART1_IRQ };
+    const irq_handler_t handlers[2] = { uart0_rx_irq, uart1_rx_irq };
+    
+    for (uint i = 0; i < 2; i++) {
+        uart_rx_port_t *port = &rx_ports[i];
+        port->uart = uarts[i];
+        byte_ring_init(&port->ring, port->buffer, sizeof(port->buffer));
+        
+        // RX interrupt at FIFO half full, plus the receive timeout for the
+        // tail of a burst
+        irq_set_exclusive_handler(irqs[i], handlers[i]);
+        irq_set_enabled(irqs[i], true);
+        uart_set_irq_enables(port->uart, true, false);
+    }
+}
+
+byte_ring_t *uart_rx_ring(uart_inst_t *uart) {
+    return &rx_ports[uart_get_index(uart)].ring;
+}
+
+uint32_t uart_rx_dropped(uart_inst_t *uart) {
+    return rx_ports[uart_get_index(uart)].ring.dropped;
+}
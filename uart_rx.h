@@ -0,0 +1,40 @@
+/**
+ * UART Receive Module for Multimode Clock Source
+ *
+ * This module drains each hardware UART's receive FIFO from its interrupt
+ * into a ring buffer, so input keeps arriving at full baud rate while the
+ * main loop is busy printing. Bytes that find the ring full are dropped
+ * and counted. The interrupt also signals an event, so a core sleeping in
+ * __wfe() wakes to read the new input.
+ */
+
+#ifndef UART_RX_H
+#define UART_RX_H
+
+#include "pico/stdlib.h"
+#include "hardware/uart.h"
+#include "byte_ring.h"
+
+/**
+ * Initialize receive rings and interrupts for UART0 and UART1
+ * (call after both UARTs are initialized)
+ * The interrupts are taken on the calling core, which must be the only
+ * core reading the rings.
+ */
+void uart_rx_init(void);
+
+/**
+ * Get a UART's receive ring (the caller is its only consumer)
+ * @param uart UART
+ * @return Receive ring
+ */
+byte_ring_t *uart_rx_ring(uart_inst_t *uart);
+
+/**
+ * Get the number of bytes dropped because a receive ring was full
+ * @param uart UART
+ * @return Bytes dropped since initialization
+ */
+uint32_t uart_rx_dropped(uart_inst_t *uart);
+
+#endif // UART_RX_H
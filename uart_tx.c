@@ -0,0 +1,136 @@
+/**
+ * UART Transmit Module for Multimode Clock Source
+ */
+
+#include "uart_tx.h"
+#include "config.h"
+#include "byte_ring.h"
+#include "pico/stdio/driver.h"
+#include "hardware/dma.h"
+#include "hardware/irq.h"
+#include "hardware/sync.h"
+#include <string.h>
+
+_Static_assert((UART_TX_BUFFER_SIZE & (UART_TX_BUFFER_SIZE - 1)) == 0,
+               "UART_TX_BUFFER_SIZE must be a power of two");
+
+typedef struct {
+    uart_inst_t *uart;
+    byte_ring_t ring;
+    uint8_t buffer[UART_TX_BUFFER_SIZE];
+    uint dma_channel;
+    volatile uint32_t in_flight;    // Bytes handed to the DMA channel
+} uart_tx_port_t;
+
+static uart_tx_port_t tx_ports[2];
+static bool tx_ready = false;
+
+static uart_tx_port_t *port_for(uart_inst_t *uart) {
+    return &tx_ports[uart_get_index(uart)];
+}
+
+// Hand the next contiguous block to the DMA channel if it is idle.
+// Runs with the DMA interrupt masked or from the interrupt itself.
+static void start_next_block(uart_tx_port_t *port) {
+    if (port->in_flight) return;
+    
+    const uint8_t *data;
+    uint32_t length = byte_ring_peek(&port->ring, &data);
+    if (length == 0) return;
+    
+    port->in_flight = length;
+    dma_channel_set_read_addr(port->dma_channel, data, false);
+    dma_channel_set_trans_count(port->dma_channel, length, true);
+}
+
+static void uart_tx_dma_irq(void) {
+    for (uint i = 0; i < 2; i++) {
+        uart_tx_port_t *port = &tx_ports[i];
+        if (dma_channel_get_irq0_status(port->dma_channel)) {
+            dma_channel_acknowledge_irq0(port->dma_channel);
+            byte_ring_consume(&port->ring, port->in_flight);
+            port->in_flight = 0;
+            start_next_block(port);
+        }
+    }
+}
+
+static void stdio_uart0_tx_out_chars(const char *buf, int length) {
+    uart_tx_write(uart0, buf, (uint32_t)length);
+}
+
+static void stdio_uart1_tx_out_chars(const char *buf, int length) {
+    uart_tx_write(uart1, buf, (uint32_t)length);
+}
+
+static stdio_driver_t stdio_uart_tx[2] = {
+    {
+        .out_chars = stdio_uart0_tx_out_chars,
+#if PICO_STDIO_ENABLE_CRLF_SUPPORT
+        .crlf_enabled = PICO_STDIO_DEFAULT_CRLF,
+#endif
+    },
+    {
+        .out_chars = stdio_uart1_tx_out_chars,
+#if PICO_STDIO_ENABLE_CRLF_SUPPORT
+        .crlf_enabled = PICO_STDIO_DEFAULT_CRLF,
+#endif
+    },
+};
+
+void uart_tx_init(void) {
+    uart_inst_t *const uarts[2] = { uart0, uart1 };
+    
+    for (uint i = 0; i < 2; i++) {
+        uart_tx_port_t *port = &tx_ports[i];
+        port->uart = uarts[i];
+        port->in_flight = 0;
+        byte_ring_init(&port->ring, port->buffer, sizeof(port->buffer));
+        
+        // Bytes to the data register, paced by the TX FIFO having room
+        port->dma_channel = (uint)dma_claim_unused_channel(true);
+        dma_channel_config config = dma_channel_get_default_config(port->dma_channel);
+        channel_config_set_transfer_data_size(&config, DMA_SIZE_8);
+        channel_config_set_read_increment(&config, true);
+        channel_config_set_write_increment(&config, false);
+        channel_config_set_dreq(&config, uart_get_dreq(port->uart, true));
+        dma_channel_configure(port->dma_channel, &config, &uart_get_hw(port->uart)->dr, port->buffer, 0, false);
+        dma_channel_set_irq0_enabled(port->dma_channel, true);
+    }
+    
+    irq_add_shared_handler(DMA_IRQ_0, uart_tx_dma_irq, PICO_SHARED_IRQ_HANDLER_DEFAULT_ORDER_PRIORITY);
+    irq_set_enabled(DMA_IRQ_0, true);
+    tx_ready = true;
+    
+    stdio_set_driver_enabled(&stdio_uart_tx[0], true);
+}
+
+bool uart_tx_write(uart_inst_t *uart, const void *data, uint32_t length) {
+    if (!tx_ready) return false;
+    
+    uart_tx_port_t *port = port_for(uart);
+    if (!byte_ring_write(&port->ring, data, length)) return false;
+    
+    // Kick the channel unless a block is already in flight; the completion
+    // interrupt must not run in between
+    uint32_t irq_state = save_and_disable_interrupts();
+    start_next_block(port);
+    restore_interrupts(irq_state);
+    return true;
+}
+
+bool uart_tx_puts(uart_inst_t *uart, const char *s) {
+    return uart_tx_write(uart, s, (uint32_t)strlen(s));
+}
+
+uint32_t uart_tx_free(uart_inst_t *uart) {
+    return byte_ring_free(&port_for(uart)->ring);
+}
+
+uint32_t uart_tx_dropped(uart_inst_t *uart) {
+    return port_for(uart)->ring.dropped;
+}
+
+stdio_driver_t *uart_tx_stdio_driver(uart_inst_t *uart) {
+    return &stdio_uart_tx[uart_get_index(uart)];
+}
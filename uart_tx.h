@@ -0,0 +1,68 @@
+/**
+ * UART Transmit Module for Multimode Clock Source
+ *
+ * This module gives each hardware UART a transmit ring drained by a DMA
+ * channel, so writing status text costs a memory copy instead of waiting
+ * for the line. Writes never block; when a ring is full the write is
+ * dropped and counted. stdout is routed through the UART0 ring by a stdio
+ * driver (USB CDC output keeps its own buffering in the SDK).
+ *
+ * Each ring has a single producer: only core0 writes, as core1 reports
+ * through the clock core telemetry queue.
+ */
+
+#ifndef UART_TX_H
+#define UART_TX_H
+
+#include "pico/stdlib.h"
+#include "pico/stdio/driver.h"
+#include "hardware/uart.h"
+
+/**
+ * Initialize transmit rings and DMA channels for UART0 and UART1
+ * and route stdout to UART0 (call after both UARTs are initialized)
+ * The DMA completion interrupt is taken on the calling core.
+ */
+void uart_tx_init(void);
+
+/**
+ * Queue bytes for transmission (never blocks)
+ * @param uart UART to send on
+ * @param data Bytes to send
+ * @param length Number of bytes
+ * @return true if queued, false if dropped because the ring was full
+ */
+bool uart_tx_write(uart_inst_t *uart, const void *data, uint32_t length);
+
+/**
+ * Queue a string for transmission (never blocks)
+ * @param uart UART to send on
+ * @param s Null-terminated string
+ * @return true if queued, false if dropped because the ring was full
+ */
+bool uart_tx_puts(uart_inst_t *uart, const char *s);
+
+/**
+ * Get the space left in a transmit ring
+ * @param uart UART
+ * @return Largest write that would currently be queued
+ */
+uint32_t uart_tx_free(uart_inst_t *uart);
+
+/**
+ * Get the number of bytes dropped because a transmit ring was full
+ * @param uart UART
+ * @return Bytes dropped since initialization
+ */
+uint32_t uart_tx_dropped(uart_inst_t *uart);
+
+/**
+ * Get the stdio driver that writes to a UART's ring
+ * The UART0 driver is enabled by uart_tx_init(); others can be enabled
+ * with stdio_set_driver_enabled() to copy stdout to their UART.
+ * @param uart UART
+ * @return stdio driver
+ */
+stdio_driver_t *uart_tx_stdio_driver(uart_inst_t *uart);
+
+#endif // UART_TX_H